@@ -20,10 +20,12 @@ define EREADER_BUILD_CMDS
 		-C $(@D)
 endef
 
-# Install binary to /usr/bin
+# Install binary to /usr/bin and create the font directory (.erf files
+# made with tools/bdf2erf go in /usr/share/ereader/fonts)
 define EREADER_INSTALL_TARGET_CMDS
 	$(INSTALL) -D -m 0755 $(@D)/ereader \
 		$(TARGET_DIR)/usr/bin/ereader
+	mkdir -p $(TARGET_DIR)/usr/share/ereader/fonts
 endef
 
 # Install init script for automatic startup
@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+#
+# gen-html-entities.py - Generate the HTML5 named entity table
+#
+# Writes src/ereader/formats/html_entities.h: every HTML5 named character
+# reference (from Python's html.entities.html5) in a perfect hash table
+# (hash and displace), so the EPUB text extractor can decode an entity with
+# two hashes and one compare.
+#
+# The hash must match html_entity_hash() in src/ereader/formats/html_text.c:
+# FNV-1a over the name (without '&' and ';'), starting from 2166136261 ^ seed.
+#
+# Usage: ./gen-html-entities.py [output.h]
+#
+
+import html.entities
+import os
+import sys
+
+FNV_OFFSET = 2166136261
+FNV_PRIME = 16777619
+LOAD_FACTOR = 0.85
+BUCKET_SIZE = 4          # Average names per displacement bucket
+
+LICENSE = """ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project"""
+
+
+def fnv1a(name, seed):
+    h = FNV_OFFSET ^ seed
+    for b in name.encode():
+        h ^= b
+        h = (h * FNV_PRIME) & 0xFFFFFFFF
+    return h
+
+
+def c_string(data):
+    return '"' + ''.join('\\x%02x' % b if b >= 0x80 or b < 0x20 or b in (0x22, 0x5C)
+                         else chr(b) for b in data) + '"'
+
+
+def build_table(names):
+    slots = int(len(names) / LOAD_FACTOR) + 1
+    buckets = len(names) // BUCKET_SIZE + 1
+
+    members = [[] for _ in range(buckets)]
+    for name in names:
+        members[fnv1a(name, 0) % buckets].append(name)
+
+    table = [None] * slots
+    displacement = [0] * buckets
+
+    # Place the largest buckets first, while the table is emptiest
+    for b in sorted(range(buckets), key=lambda b: -len(members[b])):
+        if not members[b]:
+            continue
+        for seed in range(1, 65536):
+            positions = [fnv1a(name, seed) % slots for name in members[b]]
+            if len(set(positions)) == len(positions) and all(table[p] is None for p in positions):
+                break
+        else:
+            sys.exit("gen-html-entities: no displacement found for bucket %d" % b)
+        displacement[b] = seed
+        for name, p in zip(members[b], positions):
+            table[p] = name
+
+    return table, displacement
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    output = sys.argv[1] if len(sys.argv) > 1 else os.path.join(
+        here, '..', 'src', 'ereader', 'formats', 'html_entities.h')
+
+    entities = html.entities.html5
+    names = sorted(k[:-1] for k in entities if k.endswith(';'))
+    legacy = sorted(k for k in entities if not k.endswith(';'))
+    table, displacement = build_table(names)
+    longest = max(len(n) for n in names)
+
+    out = []
+    out.append('/*')
+    out.append(' * html_entities.h - HTML5 Named Character References')
+    out.append(' *')
+    out.append(' * Generated by scripts/gen-html-entities.py; do not edit.')
+    out.append(' *')
+    out.append(' * %d names in a perfect hash table of %d slots: a name hashed with seed 0'
+               % (len(names), len(table)))
+    out.append(' * picks a displacement bucket, and hashed again with that bucket\'s seed')
+    out.append(' * picks its slot. Only html_text.c includes this file.')
+    out.append(' *')
+    out.append(LICENSE)
+    out.append(' */')
+    out.append('')
+    out.append('#ifndef HTML_ENTITIES_H')
+    out.append('#define HTML_ENTITIES_H')
+    out.append('')
+    out.append('#include <stdint.h>')
+    out.append('')
+    out.append('#define HTML_ENTITY_SLOTS       %d' % len(table))
+    out.append('#define HTML_ENTITY_BUCKETS     %d' % len(displacement))
+    out.append('#define HTML_ENTITY_NAME_MAX    %d   /* Longest name, without \'&\' and \';\' */'
+               % longest)
+    out.append('#define HTML_ENTITY_LEGACY      %d' % len(legacy))
+    out.append('')
+    out.append('typedef struct {')
+    out.append('    const char *name;          /* Name without \'&\' and \';\' (NULL = empty slot) */')
+    out.append('    char utf8[7];              /* Replacement text, UTF-8 (null-terminated) */')
+    out.append('    uint8_t name_length;')
+    out.append('} html_entity_t;')
+    out.append('')
+    out.append('static const uint16_t html_entity_displacement[HTML_ENTITY_BUCKETS] = {')
+    for i in range(0, len(displacement), 12):
+        out.append('    ' + ', '.join('%d' % d for d in displacement[i:i + 12]) + ',')
+    out.append('};')
+    out.append('')
+    out.append('static const html_entity_t html_entity_table[HTML_ENTITY_SLOTS] = {')
+    for name in table:
+        if name is None:
+            out.append('    { 0 },')
+        else:
+            value = entities[name + ';'].encode()
+            out.append('    { "%s", %s, %d },' % (name, c_string(value), len(name)))
+    out.append('};')
+    out.append('')
+    out.append('/* Names also recognized without the closing \';\' (sorted, for bsearch) */')
+    out.append('static const char *const html_entity_legacy[HTML_ENTITY_LEGACY] = {')
+    for i in range(0, len(legacy), 8):
+        out.append('    ' + ' '.join('"%s",' % n for n in legacy[i:i + 8]))
+    out.append('};')
+    out.append('')
+    out.append('#endif /* HTML_ENTITIES_H */')
+
+    with open(output, 'w') as f:
+        f.write('\n'.join(out) + '\n')
+
+
+if __name__ == '__main__':
+    main()
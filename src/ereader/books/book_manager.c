@@ -26,7 +26,10 @@
  */
 
 #include "book_manager.h"
+#include "collation.h"
+#include "library_filter.h"
 #include "../formats/format_interface.h"
+#include "../formats/txt_gz.h"
 #include "../ui/ui_components.h"
 #include "../rendering/text_renderer.h"
 #include "../rendering/framebuffer.h"
@@ -34,37 +37,104 @@
 #include <stdio.h>
 #include <string.h>
 #include <dirent.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <errno.h>
 #include <ctype.h>
+#include <pthread.h>
 
 /*
  * Internal helper functions
  */
 
-/* Compare function for qsort - alphabetical by filename */
+/* List and key of the order qsort() is sorting (qsort has no context argument) */
+static const book_list_t *sort_list;
+static book_sort_key_t sort_list_key;
+static const int *sort_list_rank;        /* Position of each record in the title order */
+
+/* Compare two records by the field a sort key lists them by (0 if equal) */
+static int book_compare_field(const book_list_t *list, const book_record_t *book_a,
+                              const book_record_t *book_b, book_sort_key_t key) {
+    int cmp = 0;
+
+    switch (key) {
+        case BOOK_SORT_AUTHOR:
+            /* Books without an author go last */
+            cmp = (book_a->author_key == 0) - (book_b->author_key == 0);
+            if (cmp == 0 && book_a->author_key != book_b->author_key) {
+                cmp = strcmp(list->strings + book_a->author_key,
+                             list->strings + book_b->author_key);
+            }
+            break;
+        case BOOK_SORT_ADDED:
+            cmp = (book_a->added < book_b->added) - (book_a->added > book_b->added);
+            break;
+        case BOOK_SORT_LAST_READ:
+            cmp = (book_a->last_read < book_b->last_read) - (book_a->last_read > book_b->last_read);
+            break;
+        case BOOK_SORT_FORMAT:
+            cmp = (int)book_a->format - (int)book_b->format;
+            break;
+        case BOOK_SORT_TITLE:
+        default:
+            break;
+    }
+    return cmp;
+}
+
+/* Compare two records of a list in the order of a sort key
+ * Ties fall back to the title key and then the filename, which is unique */
+static int book_compare(const book_list_t *list, int a, int b, book_sort_key_t key) {
+    const book_record_t *book_a = &list->records[a];
+    const book_record_t *book_b = &list->records[b];
+
+    int cmp = book_compare_field(list, book_a, book_b, key);
+    if (cmp == 0) {
+        cmp = strcmp(list->strings + book_a->title_key, list->strings + book_b->title_key);
+    }
+    if (cmp == 0) {
+        cmp = strcmp(list->strings + book_a->filename, list->strings + book_b->filename);
+    }
+    return cmp;
+}
+
+/* Compare function for qsort - list positions in the order of sort_list_key */
 static int compare_books(const void *a, const void *b) {
-    const book_metadata_t *book_a = (const book_metadata_t *)a;
-    const book_metadata_t *book_b = (const book_metadata_t *)b;
-    return strcasecmp(book_a->filename, book_b->filename);
+    return book_compare(sort_list, *(const int *)a, *(const int *)b, sort_list_key);
 }
 
-/* Compare function for qsort - alphabetical by filename for bookmarks */
-static int compare_bookmarks(const void *a, const void *b) {
-    const bookmark_t *bm_a = (const bookmark_t *)a;
-    const bookmark_t *bm_b = (const bookmark_t *)b;
-    return strcasecmp(bm_a->filename, bm_b->filename);
+/* Compare function for qsort - as compare_books(), with the title and
+ * filename tie-break read from sort_list_rank */
+static int compare_books_ranked(const void *a, const void *b) {
+    int record_a = *(const int *)a;
+    int record_b = *(const int *)b;
+
+    int cmp = book_compare_field(sort_list, &sort_list->records[record_a],
+                                 &sort_list->records[record_b], sort_list_key);
+    if (cmp == 0) {
+        cmp = sort_list_rank[record_a] - sort_list_rank[record_b];
+    }
+    return cmp;
 }
 
-/* Resize book list capacity */
+/* Resize book list capacity (records and orders together) */
 static int book_list_resize(book_list_t *list, int new_capacity) {
-    book_metadata_t *new_books = realloc(list->books,
-                                         new_capacity * sizeof(book_metadata_t));
-    if (!new_books) {
+    book_record_t *new_records = realloc(list->records,
+                                         (size_t)new_capacity * sizeof(book_record_t));
+    if (!new_records) {
         return BOOK_ERROR_OUT_OF_MEMORY;
     }
-    list->books = new_books;
+    list->records = new_records;
+
+    for (int key = 0; key < BOOK_SORT_COUNT; key++) {
+        int *new_order = realloc(list->orders[key], (size_t)new_capacity * sizeof(int));
+        if (!new_order) {
+            return BOOK_ERROR_OUT_OF_MEMORY;
+        }
+        list->orders[key] = new_order;
+    }
+    list->order = list->orders[list->sort_key];
     list->capacity = new_capacity;
     return BOOK_SUCCESS;
 }
@@ -76,9 +146,664 @@ static int bookmark_list_resize(bookmark_list_t *list, int new_capacity) {
     if (!new_bookmarks) {
         return BOOK_ERROR_OUT_OF_MEMORY;
     }
-    list->bookmarks = new_bookmarks;
-    list->capacity = new_capacity;
-    return BOOK_SUCCESS;
+    list->bookmarks = new_bookmarks;
+    list->capacity = new_capacity;
+    return BOOK_SUCCESS;
+}
+
+/*
+ * String Arena
+ * Every string of a list, NUL-terminated and back to back. Records refer
+ * to them by offset, so the arena can grow with realloc(). Strings that
+ * book_list_update_file() replaces stay behind until the next scan.
+ */
+
+/* Get a string of a list by offset */
+static inline const char* list_string(const book_list_t *list, uint32_t offset) {
+    return list->strings + offset;
+}
+
+/* Copy length bytes of text into the arena
+ * @param out: Offset of the copy (0 for an empty string)
+ */
+static int list_store(book_list_t *list, const char *text, size_t length, uint32_t *out) {
+    if (length == 0) {
+        *out = 0;
+        return BOOK_SUCCESS;
+    }
+    if (length >= UINT32_MAX - list->strings_used) {
+        return BOOK_ERROR_TOO_LARGE;  /* Offsets are 32-bit */
+    }
+
+    size_t needed = list->strings_used + length + 1;
+    if (needed > list->strings_size) {
+        size_t new_size = list->strings_size * 2;
+        if (new_size < needed) {
+            new_size = needed;
+        }
+        char *strings = realloc(list->strings, new_size);
+        if (!strings) {
+            return BOOK_ERROR_OUT_OF_MEMORY;
+        }
+        list->strings = strings;
+        list->strings_size = new_size;
+    }
+
+    memcpy(list->strings + list->strings_used, text, length);
+    list->strings[list->strings_used + length] = '\0';
+    *out = (uint32_t)list->strings_used;
+    list->strings_used = needed;
+    return BOOK_SUCCESS;
+}
+
+/* FNV-1a hash of a string */
+static uint32_t string_hash(const char *text) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    return hash;
+}
+
+/* Rebuild the author table with a new number of slots (a power of two) */
+static int list_resize_authors(book_list_t *list, size_t slots) {
+    uint32_t *table = calloc(slots, sizeof(uint32_t));
+    if (!table) {
+        return BOOK_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (size_t i = 0; i < list->author_slots; i++) {
+        uint32_t offset = list->authors[i];
+        if (offset != 0) {
+            size_t slot = string_hash(list_string(list, offset)) & (slots - 1);
+            while (table[slot] != 0) {
+                slot = (slot + 1) & (slots - 1);
+            }
+            table[slot] = offset;
+        }
+    }
+
+    free(list->authors);
+    list->authors = table;
+    list->author_slots = slots;
+    return BOOK_SUCCESS;
+}
+
+/* Store an author once, however many books share it
+ * @param out: Offset of the author's string
+ */
+static int list_intern_author(book_list_t *list, const char *author, uint32_t *out) {
+    if (author[0] == '\0') {
+        *out = 0;
+        return BOOK_SUCCESS;
+    }
+
+    /* Keep the table at most 3/4 full so probe runs stay short */
+    if ((list->author_count + 1) * 4 > list->author_slots * 3) {
+        int result = list_resize_authors(list, list->author_slots ? list->author_slots * 2 : 64);
+        if (result != BOOK_SUCCESS) {
+            return result;
+        }
+    }
+
+    size_t mask = list->author_slots - 1;
+    size_t slot = string_hash(author) & mask;
+    while (list->authors[slot] != 0) {
+        if (strcmp(list_string(list, list->authors[slot]), author) == 0) {
+            *out = list->authors[slot];
+            return BOOK_SUCCESS;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    int result = list_store(list, author, strlen(author), out);
+    if (result == BOOK_SUCCESS) {
+        list->authors[slot] = *out;
+        list->author_count++;
+    }
+    return result;
+}
+
+/*
+ * Lookup Tables
+ * Book and bookmark lists find an entry by filename through a book_table_t.
+ * Slots hold the book ID as well, so a probe compares strings only when
+ * the IDs match.
+ */
+
+/* Filename of an entry of the list a table indexes */
+typedef const char* (*table_name_fn)(const void *owner, int entry);
+
+/* Rebuild a table with a number of slots (a power of two), dropping tombstones */
+static int table_resize(book_table_t *table, size_t size) {
+    book_slot_t *slots = malloc(size * sizeof(book_slot_t));
+    if (!slots) {
+        return BOOK_ERROR_OUT_OF_MEMORY;
+    }
+    for (size_t i = 0; i < size; i++) {
+        slots[i].entry = BOOK_TABLE_EMPTY;
+    }
+
+    for (size_t i = 0; i < table->size; i++) {
+        if (table->slots[i].entry >= 0) {
+            size_t slot = table->slots[i].id & (size - 1);
+            while (slots[slot].entry != BOOK_TABLE_EMPTY) {
+                slot = (slot + 1) & (size - 1);
+            }
+            slots[slot] = table->slots[i];
+        }
+    }
+
+    free(table->slots);
+    table->slots = slots;
+    table->size = size;
+    table->used = table->count;
+    return BOOK_SUCCESS;
+}
+
+/* Forget every entry, keeping the slots */
+static void table_clear(book_table_t *table) {
+    for (size_t i = 0; i < table->size; i++) {
+        table->slots[i].entry = BOOK_TABLE_EMPTY;
+    }
+    table->count = 0;
+    table->used = 0;
+}
+
+/* Find the entry with a filename
+ * @return: Entry index, or -1 if absent
+ */
+static int table_find(const book_table_t *table, const char *filename,
+                      table_name_fn name, const void *owner) {
+    if (table->size == 0) {
+        return -1;
+    }
+
+    uint32_t id = book_id(filename);
+    size_t mask = table->size - 1;
+    for (size_t slot = id & mask; table->slots[slot].entry != BOOK_TABLE_EMPTY;
+         slot = (slot + 1) & mask) {
+        const book_slot_t *entry = &table->slots[slot];
+        if (entry->id == id && entry->entry >= 0 &&
+            strcmp(name(owner, entry->entry), filename) == 0) {
+            return entry->entry;
+        }
+    }
+    return -1;
+}
+
+/* Add an entry that is not in the table yet */
+static int table_insert(book_table_t *table, uint32_t id, int entry) {
+    /* Keep a quarter of the slots empty so probe runs stay short; grow if
+     * the live entries need it, otherwise just sweep out the tombstones */
+    if ((table->used + 1) * 4 > table->size * 3) {
+        size_t size = table->size ? table->size : 64;
+        while ((table->count + 1) * 2 > size) {
+            size *= 2;
+        }
+        int result = table_resize(table, size);
+        if (result != BOOK_SUCCESS) {
+            return result;
+        }
+    }
+
+    size_t mask = table->size - 1;
+    size_t slot = id & mask;
+    while (table->slots[slot].entry >= 0) {
+        slot = (slot + 1) & mask;
+    }
+    if (table->slots[slot].entry == BOOK_TABLE_EMPTY) {
+        table->used++;
+    }
+    table->slots[slot].id = id;
+    table->slots[slot].entry = entry;
+    table->count++;
+    return BOOK_SUCCESS;
+}
+
+/* Find the slot of an entry (NULL if it is not in the table) */
+static book_slot_t* table_slot(const book_table_t *table, uint32_t id, int entry) {
+    if (table->size == 0) {
+        return NULL;
+    }
+
+    size_t mask = table->size - 1;
+    for (size_t slot = id & mask; table->slots[slot].entry != BOOK_TABLE_EMPTY;
+         slot = (slot + 1) & mask) {
+        if (table->slots[slot].entry == entry) {
+            return &table->slots[slot];
+        }
+    }
+    return NULL;
+}
+
+/* Remove an entry, leaving a tombstone */
+static void table_remove(book_table_t *table, uint32_t id, int entry) {
+    book_slot_t *slot = table_slot(table, id, entry);
+    if (slot) {
+        slot->entry = BOOK_TABLE_REMOVED;
+        table->count--;
+    }
+}
+
+/* Note that an entry moved to another index of its list */
+static void table_move(book_table_t *table, uint32_t id, int from, int to) {
+    book_slot_t *slot = table_slot(table, id, from);
+    if (slot) {
+        slot->entry = to;
+    }
+}
+
+/* Filename of a book list record */
+static const char* record_name(const void *owner, int entry) {
+    const book_list_t *list = (const book_list_t *)owner;
+    return list_string(list, list->records[entry].filename);
+}
+
+/* Filename of a bookmark */
+static const char* bookmark_name(const void *owner, int entry) {
+    return ((const bookmark_list_t *)owner)->bookmarks[entry].filename;
+}
+
+/* Find the record of a filename (-1 if it is not listed) */
+static int book_list_find_record(const book_list_t *list, const char *filename) {
+    return table_find(&list->paths, filename, record_name, list);
+}
+
+/* Find the bookmark of a filename (-1 if there is none) */
+static int bookmark_find(const bookmark_list_t *list, const char *filename) {
+    return table_find(&list->table, filename, bookmark_name, list);
+}
+
+/* Append an empty bookmark for a filename that has none
+ * @return: The bookmark, or NULL if out of memory
+ */
+static bookmark_t* bookmark_list_append(bookmark_list_t *list, const char *filename) {
+    if (list->count >= list->capacity &&
+        bookmark_list_resize(list, list->capacity * 2) != BOOK_SUCCESS) {
+        return NULL;
+    }
+
+    bookmark_t *bm = &list->bookmarks[list->count];
+    strncpy(bm->filename, filename, MAX_FILENAME_LENGTH - 1);
+    bm->filename[MAX_FILENAME_LENGTH - 1] = '\0';
+    if (table_insert(&list->table, book_id(bm->filename), list->count) != BOOK_SUCCESS) {
+        return NULL;
+    }
+    list->count++;
+    return bm;
+}
+
+/* Forget every book and string, keeping the allocations */
+static void list_clear(book_list_t *list) {
+    list->count = 0;
+    list->strings_used = 1;  /* strings[0] is the empty string */
+    list->author_count = 0;
+    if (list->authors) {
+        memset(list->authors, 0, list->author_slots * sizeof(uint32_t));
+    }
+    table_clear(&list->paths);
+}
+
+/*
+ * Book Records
+ */
+
+/* Store a record's title and author; an empty title means the file's basename */
+static int book_record_store_text(book_list_t *list, book_record_t *book,
+                                  const char *title, const char *author) {
+    const char *filename = list_string(list, book->filename);
+    const char *basename = book_basename(filename);
+    int result = BOOK_SUCCESS;
+
+    if (title[0] == '\0' || strcmp(title, basename) == 0) {
+        book->title = book->filename + (uint32_t)(basename - filename);
+    } else {
+        result = list_store(list, title, strlen(title), &book->title);
+    }
+    if (result == BOOK_SUCCESS) {
+        result = list_intern_author(list, author, &book->author);
+    }
+    return result;
+}
+
+/* Set a record's title and author along with their sort keys
+ * A book titled by its file sorts by the basename without its extension */
+static int book_record_set_text(book_list_t *list, book_record_t *book,
+                                const char *title, const char *author) {
+    char name[MAX_FILENAME_LENGTH];
+    char key[COLLATION_KEY_MAX];
+
+    int result = book_record_store_text(list, book, title, author);
+    if (result != BOOK_SUCCESS) {
+        return result;
+    }
+
+    const char *sort_title = list_string(list, book->title);
+    if (book->title >= book->filename &&
+        book->title < book->filename + strlen(list_string(list, book->filename))) {
+        snprintf(name, sizeof(name), "%s", sort_title);
+        char *extension = strrchr(name, '.');
+        if (extension && extension != name) {
+            *extension = '\0';
+        }
+        sort_title = name;
+    }
+
+    size_t length = collation_key(sort_title, COLLATION_TITLE, key);
+    result = list_store(list, key, length, &book->title_key);
+    if (result == BOOK_SUCCESS) {
+        collation_key(list_string(list, book->author), COLLATION_AUTHOR, key);
+        result = list_intern_author(list, key, &book->author_key);
+    }
+    return result;
+}
+
+/* Append a book at the end of the list and of each order, titled by its
+ * basename; the caller sets its text and, once the orders are sorted,
+ * moves it into place
+ * @return: Its record index, or a negative error code
+ */
+static int book_list_append(book_list_t *list, const char *filename, int64_t size,
+                            int64_t modified, book_format_type_t format) {
+    if (list->count == list->capacity &&
+        book_list_resize(list, list->capacity * 2) != BOOK_SUCCESS) {
+        fprintf(stderr, "book_list_append: Failed to resize list\n");
+        return BOOK_ERROR_OUT_OF_MEMORY;
+    }
+
+    book_record_t *book = &list->records[list->count];
+    int result = list_store(list, filename, strlen(filename), &book->filename);
+    if (result == BOOK_SUCCESS) {
+        result = table_insert(&list->paths, book_id(filename), list->count);
+    }
+    if (result != BOOK_SUCCESS) {
+        fprintf(stderr, "book_list_append: Failed to store %s\n", filename);
+        return result;
+    }
+    book->size = size;
+    book->modified = modified;
+    book->added = modified;
+    book->last_read = 0;
+    book->format = (uint8_t)format;
+    book->title = book->filename + (uint32_t)(book_basename(filename) - filename);
+    book->author = 0;
+    book->title_key = 0;
+    book->author_key = 0;
+
+    for (int key = 0; key < BOOK_SORT_COUNT; key++) {
+        list->orders[key][list->count] = list->count;
+    }
+    return list->count++;
+}
+
+/* Build the full path of a record */
+static int book_record_path(const book_list_t *list, const book_record_t *book,
+                            char *out, size_t out_size) {
+    const char *filename = list_string(list, book->filename);
+    int length = (list->books_dir[0] == '\0')
+        ? snprintf(out, out_size, "%s", filename)
+        : snprintf(out, out_size, "%s/%s", list->books_dir, filename);
+    return (length >= 0 && (size_t)length < out_size) ? BOOK_SUCCESS : BOOK_ERROR_INVALID_PATH;
+}
+
+/* Get the record at a list position (NULL if out of range) */
+static const book_record_t* book_list_record(const book_list_t *list, int index) {
+    if (!list || index < 0 || index >= list->count) {
+        return NULL;
+    }
+    return &list->records[list->order[index]];
+}
+
+/* Whether title and author are read from the book itself */
+static bool book_format_has_metadata(book_format_type_t format) {
+    return format == BOOK_FORMAT_EPUB || format == BOOK_FORMAT_PDF || format == BOOK_FORMAT_ERB;
+}
+
+/* Read title and author from the book itself (EPUB/PDF/ERB formats)
+ * @return: true if metadata was read
+ */
+static bool book_read_metadata(const char *filepath, book_format_type_t format,
+                               format_metadata_t *metadata) {
+    if (!book_format_has_metadata(format)) {
+        return false;
+    }
+
+    const book_format_interface_t *interface = format_get_interface(format);
+    return format_read_metadata(interface, filepath, metadata) == FORMAT_SUCCESS;
+}
+
+/*
+ * Sort Orders
+ * Each sort key has an array of records in its order. A scan sorts them
+ * once; afterwards a changed book is taken out of each by binary search
+ * on its old keys and put back the same way on its new ones.
+ */
+
+/* Find where a record goes in an order of count positions (lower bound) */
+static int order_bound(const book_list_t *list, book_sort_key_t key, int record, int count) {
+    const int *order = list->orders[key];
+    int low = 0, high = count;
+
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (book_compare(list, order[mid], record, key) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* Find the position of a record in an order of count positions (-1 if absent) */
+static int order_find(const book_list_t *list, book_sort_key_t key, int record, int count) {
+    const int *order = list->orders[key];
+
+    int pos = order_bound(list, key, record, count);
+    if (pos < count && order[pos] == record) {
+        return pos;
+    }
+
+    /* Not where its keys say; look everywhere rather than lose it */
+    for (pos = 0; pos < count; pos++) {
+        if (order[pos] == record) {
+            return pos;
+        }
+    }
+    return -1;
+}
+
+/* Insert a record into an order of count positions (room for one more) */
+static void order_insert(book_list_t *list, book_sort_key_t key, int record, int count) {
+    int *order = list->orders[key];
+    int pos = order_bound(list, key, record, count);
+
+    memmove(&order[pos + 1], &order[pos], (size_t)(count - pos) * sizeof(int));
+    order[pos] = record;
+}
+
+/* Remove a record from an order of count positions */
+static void order_remove(book_list_t *list, book_sort_key_t key, int record, int count) {
+    int *order = list->orders[key];
+    int pos = order_find(list, key, record, count);
+
+    if (pos >= 0) {
+        memmove(&order[pos], &order[pos + 1], (size_t)(count - pos - 1) * sizeof(int));
+    }
+}
+
+/* Sort an order from scratch
+ * @param rank: Position of each record in the sorted title order, to break
+ *              ties without comparing strings (NULL to compare them)
+ */
+static void order_build(book_list_t *list, book_sort_key_t key, const int *rank) {
+    int *order = list->orders[key];
+
+    for (int i = 0; i < list->count; i++) {
+        order[i] = i;
+    }
+    if (list->count > 1) {
+        sort_list = list;
+        sort_list_key = key;
+        sort_list_rank = rank;
+        qsort(order, list->count, sizeof(int), rank ? compare_books_ranked : compare_books);
+    }
+}
+
+/* Get the position of each record in the title order (NULL if out of memory) */
+static int* order_title_rank(const book_list_t *list) {
+    int *rank = malloc((size_t)(list->count > 0 ? list->count : 1) * sizeof(int));
+    if (rank) {
+        for (int i = 0; i < list->count; i++) {
+            rank[list->orders[BOOK_SORT_TITLE][i]] = i;
+        }
+    }
+    return rank;
+}
+
+/* Sort every order from scratch: titles first, then the others with the
+ * title order as their tie-break */
+static void order_build_all(book_list_t *list) {
+    order_build(list, BOOK_SORT_TITLE, NULL);
+
+    int *rank = order_title_rank(list);
+    for (int key = BOOK_SORT_TITLE + 1; key < BOOK_SORT_COUNT; key++) {
+        order_build(list, (book_sort_key_t)key, rank);
+    }
+    free(rank);
+}
+
+/*
+ * Library Index
+ * Metadata of every scanned book, kept in LIBRARY_INDEX_FILE so a rescan
+ * only opens books that are new or changed since the last one
+ */
+
+/* Copy an index field, up to the next tab or end of line */
+static char* index_field(char *line, char *out, size_t out_size) {
+    size_t length = strcspn(line, "\t\r\n");
+    if (out) {
+        size_t copy = length < out_size - 1 ? length : out_size - 1;
+        memcpy(out, line, copy);
+        out[copy] = '\0';
+    }
+    return line[length] == '\t' ? line + length + 1 : NULL;
+}
+
+/* Write a title or author, with the separators the index uses turned into spaces */
+static void index_write_text(FILE *f, const char *text) {
+    for (const char *p = text; *p; p++) {
+        fputc(*p == '\t' || *p == '\r' || *p == '\n' ? ' ' : *p, f);
+    }
+}
+
+/* Load the library index into a list of full paths (a missing index is empty) */
+static void library_index_load(book_list_t *index, const char *filepath) {
+    char line[MAX_BOOK_PATH + 2 * 256 + 96];
+    char path[MAX_BOOK_PATH];
+    char title[256];
+    char author[256];
+    char number[32];
+    FILE *f;
+
+    list_clear(index);
+    index->books_dir[0] = '\0';
+    f = fopen(filepath, "r");
+    if (!f) {
+        if (errno != ENOENT) {
+            fprintf(stderr, "library_index_load: Failed to open %s: %s\n",
+                    filepath, strerror(errno));
+        }
+        return;
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        /* Skip comments and empty lines */
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\0') {
+            continue;
+        }
+
+        /* Parse: filepath<TAB>size<TAB>mtime<TAB>title<TAB>author[<TAB>added] */
+        char *next = index_field(line, path, sizeof(path));
+        next = next ? index_field(next, number, sizeof(number)) : NULL;
+        int64_t size = strtoll(number, NULL, 10);
+        next = next ? index_field(next, number, sizeof(number)) : NULL;
+        int64_t modified = strtoll(number, NULL, 10);
+        next = next ? index_field(next, title, sizeof(title)) : NULL;
+        if (!next) {
+            fprintf(stderr, "library_index_load: Skipping malformed entry\n");
+            continue;
+        }
+        next = index_field(next, author, sizeof(author));
+        int64_t added = modified;  /* Indexes written before books had one */
+        if (next) {
+            index_field(next, number, sizeof(number));
+            added = strtoll(number, NULL, 10);
+        }
+
+        int record = book_list_append(index, path, size, modified, BOOK_FORMAT_UNKNOWN);
+        if (record < 0) {
+            break;
+        }
+        index->records[record].added = added;
+        book_record_store_text(index, &index->records[record], title, author);
+    }
+
+    fclose(f);
+}
+
+/* Find a full path in the loaded index (NULL if absent) */
+static const book_record_t* library_index_find(const book_list_t *index, const char *filepath) {
+    int record = book_list_find_record(index, filepath);
+    return record >= 0 ? &index->records[record] : NULL;
+}
+
+/* Write the library index, replacing the old one in a single rename */
+static void library_index_save(const book_list_t *list, const char *filepath) {
+    char temp_path[MAX_BOOK_PATH + 8];
+    char path[MAX_BOOK_PATH];
+    FILE *f;
+
+    /* Create directory if it doesn't exist */
+    char dir[MAX_BOOK_PATH];
+    strncpy(dir, filepath, MAX_BOOK_PATH - 1);
+    dir[MAX_BOOK_PATH - 1] = '\0';
+    char *last_slash = strrchr(dir, '/');
+    if (last_slash) {
+        *last_slash = '\0';
+        mkdir(dir, 0755);
+    }
+
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", filepath);
+    f = fopen(temp_path, "w");
+    if (!f) {
+        fprintf(stderr, "library_index_save: Failed to open %s: %s\n",
+                temp_path, strerror(errno));
+        return;
+    }
+
+    fprintf(f, "# E-Reader Library Index\n");
+    fprintf(f, "# Format: filepath<TAB>size<TAB>mtime<TAB>title<TAB>author<TAB>added\n");
+
+    for (int i = 0; i < list->count; i++) {
+        const book_record_t *book = &list->records[list->order[i]];
+        if (book_record_path(list, book, path, sizeof(path)) != BOOK_SUCCESS ||
+            strpbrk(path, "\t\r\n")) {
+            continue;  /* Cannot be stored; rescanned each time */
+        }
+        fprintf(f, "%s\t%lld\t%lld\t", path, (long long)book->size, (long long)book->modified);
+        index_write_text(f, list_string(list, book->title));
+        fputc('\t', f);
+        index_write_text(f, list_string(list, book->author));
+        fprintf(f, "\t%lld\n", (long long)book->added);
+    }
+
+    if (fclose(f) != 0 || rename(temp_path, filepath) != 0) {
+        fprintf(stderr, "library_index_save: Failed to write %s: %s\n",
+                filepath, strerror(errno));
+        unlink(temp_path);
+    }
 }
 
 /*
@@ -86,189 +811,419 @@ static int bookmark_list_resize(bookmark_list_t *list, int new_capacity) {
  */
 
 book_list_t* book_list_create(void) {
-    book_list_t *list = malloc(sizeof(book_list_t));
+    book_list_t *list = calloc(1, sizeof(book_list_t));
     if (!list) {
         return NULL;
     }
 
-    list->count = 0;
     list->capacity = 32;  /* Initial capacity */
-    list->books = malloc(list->capacity * sizeof(book_metadata_t));
+    list->records = malloc(list->capacity * sizeof(book_record_t));
+    for (int key = 0; key < BOOK_SORT_COUNT; key++) {
+        list->orders[key] = malloc(list->capacity * sizeof(int));
+        if (!list->orders[key]) {
+            book_list_free(list);
+            return NULL;
+        }
+    }
+    list->sort_key = BOOK_SORT_TITLE;
+    list->order = list->orders[list->sort_key];
+    list->strings_size = 4096;
+    list->strings = malloc(list->strings_size);
 
-    if (!list->books) {
-        free(list);
+    if (!list->records || !list->strings) {
+        book_list_free(list);
         return NULL;
     }
+    list->strings[0] = '\0';
+    list->strings_used = 1;
 
     return list;
 }
 
 void book_list_free(book_list_t *list) {
     if (list) {
-        free(list->books);
+        free(list->records);
+        for (int key = 0; key < BOOK_SORT_COUNT; key++) {
+            free(list->orders[key]);
+        }
+        free(list->strings);
+        free(list->authors);
+        free(list->paths.slots);
+        library_filter_free(list->filter);
         free(list);
     }
 }
 
-int book_list_scan(book_list_t *list, const char *books_dir, void *fb_ptr) {
-    DIR *dir;
-    struct dirent *entry;
-    struct stat st;
-    char filepath[MAX_BOOK_PATH];
-    framebuffer_t *fb = (framebuffer_t *)fb_ptr;
-    progress_bar_t progress;
-    int total_files = 0;
-    int processed_files = 0;
-    bool show_progress = (fb != NULL);
+/*
+ * Library Scan
+ * The books tree is walked once. Books the index covers are complete as
+ * soon as they are found; the others are queued and their metadata read
+ * afterwards by a small worker pool, so a rescan costs one stat per file
+ * plus one open per new or changed book.
+ */
 
-    /* Reset the list */
-    list->count = 0;
+/* State of one walk over the books tree */
+typedef struct {
+    book_list_t *list;
+    const book_list_t *index;            /* Previous scan, by full path (may be NULL) */
+    int *pending;                        /* Records of books to open */
+    int pending_count;
+    int pending_capacity;
+    int index_hits;
+    int64_t added;                       /* Time books new to the index were added (0 = their mtime) */
+    bool failed;                         /* Out of memory; stop walking */
+} scan_state_t;
+
+/* Books shared out to the metadata workers
+ * The lock covers the list as well: records take their strings from the
+ * arena, which moves when it grows */
+typedef struct {
+    book_list_t *list;
+    const int *pending;
+    int count;
+    int next;                            /* Next pending book to claim */
+    int done;                            /* Books finished */
+    pthread_mutex_t lock;
+} scan_pool_t;
+
+/* Milliseconds on the monotonic clock */
+static uint64_t scan_time_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
 
-    /* Open directory */
-    dir = opendir(books_dir);
-    if (!dir) {
-        fprintf(stderr, "book_list_scan: Failed to open directory %s: %s\n",
-                books_dir, strerror(errno));
-        return BOOK_ERROR_INVALID_PATH;
+/* Add a found book, with its metadata from the index or queued for reading */
+static void scan_add_book(scan_state_t *scan, const char *filename, const char *filepath,
+                          const struct stat *st, book_format_type_t format) {
+    book_list_t *list = scan->list;
+
+    int record = book_list_append(list, filename, st->st_size, st->st_mtime, format);
+    if (record < 0) {
+        scan->failed = true;
+        return;
+    }
+    book_record_t *book = &list->records[record];
+
+    /* Unchanged since the last scan: reuse its metadata */
+    const book_record_t *indexed = scan->index ? library_index_find(scan->index, filepath) : NULL;
+    if (indexed) {
+        book->added = indexed->added;
+    } else if (scan->added) {
+        book->added = scan->added;
+    }
+    if (indexed && indexed->size == book->size && indexed->modified == book->modified) {
+        book_record_set_text(list, book, list_string(scan->index, indexed->title),
+                             list_string(scan->index, indexed->author));
+        scan->index_hits++;
+        return;
     }
 
-    /* First pass: Count total potential book files */
-    if (show_progress) {
-        while ((entry = readdir(dir)) != NULL) {
-            /* Skip hidden files and directories */
-            if (entry->d_name[0] == '.') {
-                continue;
-            }
+    /* Text books have no metadata to read */
+    if (!book_format_has_metadata(format)) {
+        book_record_set_text(list, book, "", "");
+        return;
+    }
 
-            /* Check if file is a supported format */
-            book_format_type_t format = format_detect_type(entry->d_name);
-            if (format != BOOK_FORMAT_UNKNOWN) {
-                total_files++;
-            }
+    if (scan->pending_count == scan->pending_capacity) {
+        int capacity = scan->pending_capacity ? scan->pending_capacity * 2 : 64;
+        int *pending = realloc(scan->pending, (size_t)capacity * sizeof(int));
+        if (!pending) {
+            /* No queue: read it now */
+            format_metadata_t metadata;
+            bool found = book_read_metadata(filepath, format, &metadata);
+            book_record_set_text(list, book, found ? metadata.title : "",
+                                 found ? metadata.author : "");
+            return;
         }
+        scan->pending = pending;
+        scan->pending_capacity = capacity;
+    }
+    scan->pending[scan->pending_count++] = record;
+}
 
-        /* Rewind directory for second pass */
-        rewinddir(dir);
+/* Walk one folder of the books tree
+ * @param relative: Folder path below books_dir ("" for books_dir itself)
+ * @param depth: Folder level (0 for books_dir)
+ */
+static int scan_directory(scan_state_t *scan, const char *books_dir, const char *relative,
+                          int depth) {
+    char dirpath[MAX_BOOK_PATH];
+    char filepath[MAX_BOOK_PATH];
+    char filename[MAX_FILENAME_LENGTH];
+    struct dirent *entry;
+    struct stat st;
 
-        /* Initialize progress bar if we have files to scan */
-        if (total_files > 0) {
-            progress_bar_init(&progress, 60, 140, 280, true);
-            progress_bar_set_value(&progress, 0, total_files);
-        }
+    if (relative[0] == '\0') {
+        snprintf(dirpath, sizeof(dirpath), "%s", books_dir);
+    } else {
+        snprintf(dirpath, sizeof(dirpath), "%s/%s", books_dir, relative);
     }
 
-    /* Scan for supported book files (.txt, .epub, .pdf) */
-    while ((entry = readdir(dir)) != NULL) {
-        book_format_type_t format;
+    DIR *dir = opendir(dirpath);
+    if (!dir) {
+        fprintf(stderr, "book_list_scan: Failed to open directory %s: %s\n",
+                dirpath, strerror(errno));
+        return BOOK_ERROR_INVALID_PATH;
+    }
+    int fd = dirfd(dir);
 
+    while (!scan->failed && (entry = readdir(dir)) != NULL) {
         /* Skip hidden files and directories */
         if (entry->d_name[0] == '.') {
             continue;
         }
 
-        /* Check if file is a supported format */
-        format = format_detect_type(entry->d_name);
-        if (format == BOOK_FORMAT_UNKNOWN) {
+        int name_length = relative[0] == '\0'
+            ? snprintf(filename, sizeof(filename), "%s", entry->d_name)
+            : snprintf(filename, sizeof(filename), "%s/%s", relative, entry->d_name);
+        int path_length = snprintf(filepath, sizeof(filepath), "%s/%s", dirpath, entry->d_name);
+        if (name_length < 0 || (size_t)name_length >= sizeof(filename) ||
+            path_length < 0 || (size_t)path_length >= sizeof(filepath)) {
+            fprintf(stderr, "book_list_scan: Skipping %s/%s: path too long\n",
+                    dirpath, entry->d_name);
             continue;
         }
 
-        /* Build full path */
-        snprintf(filepath, sizeof(filepath), "%s/%s", books_dir, entry->d_name);
+        book_format_type_t format = format_detect_type(entry->d_name);
+        if (format == BOOK_FORMAT_UNKNOWN) {
+            /* Descend into subfolders; symlinked folders are not followed, so
+             * the walk cannot loop */
+            bool is_dir = (entry->d_type == DT_DIR);
+            if (entry->d_type == DT_UNKNOWN) {
+                is_dir = fstatat(fd, entry->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0 &&
+                         S_ISDIR(st.st_mode);
+            }
+            if (is_dir && depth < BOOK_SCAN_MAX_DEPTH) {
+                scan_directory(scan, books_dir, filename, depth + 1);
+            }
+            continue;
+        }
 
-        /* Get file stats */
-        if (stat(filepath, &st) != 0) {
+        /* Stat relative to the open folder, without resolving the full path */
+        if (fstatat(fd, entry->d_name, &st, 0) != 0) {
             fprintf(stderr, "book_list_scan: stat failed for %s: %s\n",
                     filepath, strerror(errno));
-            if (show_progress) processed_files++;
             continue;
         }
 
-        /* Skip directories */
-        if (S_ISDIR(st.st_mode)) {
-            if (show_progress) processed_files++;
+        /* Skip directories and other non-files */
+        if (!S_ISREG(st.st_mode)) {
             continue;
         }
 
         /* Skip empty files */
         if (st.st_size == 0) {
             fprintf(stderr, "book_list_scan: Skipping empty file %s\n", filepath);
-            if (show_progress) processed_files++;
             continue;
         }
 
-        /* Check if we need to resize */
-        if (list->count >= list->capacity) {
-            int new_capacity = list->capacity * 2;
-            if (new_capacity > MAX_BOOKS) {
-                new_capacity = MAX_BOOKS;
-            }
-            if (list->count >= new_capacity) {
-                fprintf(stderr, "book_list_scan: Maximum book limit reached (%d)\n",
-                        MAX_BOOKS);
-                break;
-            }
-            if (book_list_resize(list, new_capacity) != BOOK_SUCCESS) {
-                fprintf(stderr, "book_list_scan: Failed to resize list\n");
-                break;
-            }
+        scan_add_book(scan, filename, filepath, &st, format);
+    }
+
+    closedir(dir);
+    return BOOK_SUCCESS;
+}
+
+/* Claim the next pending book, copying out what is needed to read it
+ * @return: Record of the book, or -1 when none are left
+ */
+static int scan_pool_claim(scan_pool_t *pool, char *filepath, book_format_type_t *format) {
+    int job = -1;
+
+    pthread_mutex_lock(&pool->lock);
+    while (job < 0 && pool->next < pool->count) {
+        int record = pool->pending[pool->next++];
+        const book_record_t *book = &pool->list->records[record];
+        if (book_record_path(pool->list, book, filepath, MAX_BOOK_PATH) == BOOK_SUCCESS) {
+            *format = (book_format_type_t)book->format;
+            job = record;
+        } else {
+            book_record_set_text(pool->list, &pool->list->records[record], "", "");
+            pool->done++;
         }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return job;
+}
 
-        /* Add to list */
-        book_metadata_t *book = &list->books[list->count];
-        strncpy(book->filename, entry->d_name, MAX_FILENAME_LENGTH - 1);
-        book->filename[MAX_FILENAME_LENGTH - 1] = '\0';
-        strncpy(book->filepath, filepath, MAX_BOOK_PATH - 1);
-        book->filepath[MAX_BOOK_PATH - 1] = '\0';
-        book->size = st.st_size;
-        book->modified = st.st_mtime;
-        book->bookmark_page = 0;  /* Will be updated from bookmarks */
-        book->format = format;    /* Store detected format */
-
-        /* Initialize metadata fields with defaults */
-        strncpy(book->title, entry->d_name, 255);
-        book->title[255] = '\0';
-        book->author[0] = '\0';
-
-        /* Try to extract metadata for EPUB/PDF formats */
-        if (format == BOOK_FORMAT_EPUB || format == BOOK_FORMAT_PDF) {
-            const book_format_interface_t *interface = format_get_interface(format);
-            if (interface && interface->open && interface->get_metadata && interface->close) {
-                format_handle_t handle = interface->open(filepath);
-                if (handle) {
-                    format_metadata_t metadata;
-                    if (interface->get_metadata(handle, &metadata) == FORMAT_SUCCESS) {
-                        /* Copy title if available and non-empty */
-                        if (metadata.title[0] != '\0') {
-                            strncpy(book->title, metadata.title, 255);
-                            book->title[255] = '\0';
-                        }
-                        /* Copy author if available */
-                        if (metadata.author[0] != '\0') {
-                            strncpy(book->author, metadata.author, 255);
-                            book->author[255] = '\0';
-                        }
-                    }
-                    interface->close(handle);
-                }
-            }
+/* Store the metadata read for a claimed book (NULL if none) and count it done */
+static int scan_pool_finish(scan_pool_t *pool, int job, const format_metadata_t *metadata) {
+    pthread_mutex_lock(&pool->lock);
+    book_record_set_text(pool->list, &pool->list->records[job],
+                         metadata ? metadata->title : "", metadata ? metadata->author : "");
+    int done = ++pool->done;
+    pthread_mutex_unlock(&pool->lock);
+    return done;
+}
+
+/* Metadata worker thread */
+static void* scan_worker(void *arg) {
+    scan_pool_t *pool = (scan_pool_t *)arg;
+    char filepath[MAX_BOOK_PATH];
+    book_format_type_t format;
+    format_metadata_t metadata;
+    int job;
+
+    while ((job = scan_pool_claim(pool, filepath, &format)) >= 0) {
+        bool found = book_read_metadata(filepath, format, &metadata);
+        scan_pool_finish(pool, job, found ? &metadata : NULL);
+    }
+    return NULL;
+}
+
+/* Draw the scan progress screen */
+static void scan_show_progress(framebuffer_t *fb, progress_bar_t *progress, int done, int total) {
+    progress_bar_set_value(progress, done, total);
+    fb_clear(fb, COLOR_WHITE);
+    text_render_string(fb, 100, 100, "Scanning library...", COLOR_BLACK);
+    progress_bar_render(progress, fb);
+    /* Note: Caller should handle display refresh */
+}
+
+/* Read the metadata of every queued book
+ * One worker per CPU (up to BOOK_SCAN_MAX_WORKERS), the calling thread being
+ * one of them, so a single-core device reads them all in line. Only the
+ * calling thread draws progress, at most every BOOK_SCAN_PROGRESS_MS.
+ */
+static void scan_read_metadata(const scan_state_t *scan, framebuffer_t *fb) {
+    pthread_t threads[BOOK_SCAN_MAX_WORKERS - 1];
+    scan_pool_t pool;
+    progress_bar_t progress;
+    char filepath[MAX_BOOK_PATH];
+    book_format_type_t format;
+    format_metadata_t metadata;
+    int started = 0;
+    int job;
+
+    if (scan->pending_count == 0) {
+        return;
+    }
+
+    pool.list = scan->list;
+    pool.pending = scan->pending;
+    pool.count = scan->pending_count;
+    pool.next = 0;
+    pool.done = 0;
+    pthread_mutex_init(&pool.lock, NULL);
+
+    long workers = sysconf(_SC_NPROCESSORS_ONLN);
+    if (workers > BOOK_SCAN_MAX_WORKERS) {
+        workers = BOOK_SCAN_MAX_WORKERS;
+    }
+    if (workers > pool.count) {
+        workers = pool.count;
+    }
+    while (started < workers - 1 &&
+           pthread_create(&threads[started], NULL, scan_worker, &pool) == 0) {
+        started++;
+    }
+
+    uint64_t last_shown = 0;
+    if (fb) {
+        progress_bar_init(&progress, 60, 140, 280, true);
+        scan_show_progress(fb, &progress, 0, pool.count);
+        last_shown = scan_time_ms();
+    }
+
+    while ((job = scan_pool_claim(&pool, filepath, &format)) >= 0) {
+        bool found = book_read_metadata(filepath, format, &metadata);
+        int done = scan_pool_finish(&pool, job, found ? &metadata : NULL);
+
+        /* Redraws are slow on e-paper: limit them by time, not by book */
+        if (fb && scan_time_ms() - last_shown >= BOOK_SCAN_PROGRESS_MS) {
+            scan_show_progress(fb, &progress, done, pool.count);
+            last_shown = scan_time_ms();
         }
+    }
+
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_mutex_destroy(&pool.lock);
 
-        list->count++;
+    if (fb) {
+        scan_show_progress(fb, &progress, pool.count, pool.count);
+    }
+}
 
-        /* Update progress bar (only every 3 files to reduce e-paper refreshes) */
-        if (show_progress && total_files > 0) {
-            processed_files++;
-            if (processed_files % 3 == 0 || processed_files == total_files) {
-                progress_bar_set_value(&progress, processed_files, total_files);
-                fb_clear(fb, COLOR_WHITE);
-                text_render_string(fb, 100, 100, "Scanning library...", COLOR_BLACK);
-                progress_bar_render(&progress, fb);
-                /* Note: Caller should handle display refresh */
-            }
+/* Copy out the reading times of a list's books (NULL if none were read)
+ * They are not in the index, so a rescan takes them from the old list */
+static bookmark_list_t* scan_save_last_read(const book_list_t *list) {
+    bookmark_list_t *read = NULL;
+
+    for (int i = 0; i < list->count; i++) {
+        const book_record_t *book = &list->records[i];
+        if (book->last_read == 0) {
+            continue;
+        }
+        if (!read && !(read = bookmark_list_create())) {
+            return NULL;
         }
+
+        bookmark_t *bm = bookmark_list_append(read, list_string(list, book->filename));
+        if (!bm) {
+            break;
+        }
+        bm->page = 0;
+        bm->timestamp = (time_t)book->last_read;
+        bm->offset = -1;
     }
+    return read;
+}
 
-    closedir(dir);
+int book_list_scan(book_list_t *list, const char *books_dir, void *fb_ptr) {
+    framebuffer_t *fb = (framebuffer_t *)fb_ptr;
+    scan_state_t scan;
+
+    /* Reset the list */
+    bookmark_list_t *read = scan_save_last_read(list);
+    list_clear(list);
+    library_filter_free(list->filter);
+    list->filter = NULL;
+    strncpy(list->books_dir, books_dir, MAX_BOOK_PATH - 1);
+    list->books_dir[MAX_BOOK_PATH - 1] = '\0';
+
+    memset(&scan, 0, sizeof(scan));
+    scan.list = list;
+
+    /* Metadata from the previous scan */
+    book_list_t *index = book_list_create();
+    if (index) {
+        library_index_load(index, LIBRARY_INDEX_FILE);
+    }
+    scan.index = index;
+
+    /* Books the index has not seen were added now, unless there is no
+     * index yet to have seen them */
+    if (index && index->count > 0) {
+        scan.added = (int64_t)time(NULL);
+    }
+
+    /* Find the books; a subfolder that cannot be read is only skipped */
+    if (scan_directory(&scan, books_dir, "", 0) != BOOK_SUCCESS) {
+        book_list_free(index);
+        bookmark_list_free(read);
+        return BOOK_ERROR_INVALID_PATH;
+    }
+
+    /* Open the new and changed ones */
+    scan_read_metadata(&scan, fb);
+    free(scan.pending);
+
+    /* Sort every order once, now that all keys are known */
+    order_build_all(list);
+    if (read) {
+        book_list_apply_bookmarks(list, read);
+        bookmark_list_free(read);
+    }
+
+    /* Rewrite the index if any book was added, changed or removed */
+    if (!index || scan.index_hits != list->count || index->count != list->count) {
+        library_index_save(list, LIBRARY_INDEX_FILE);
+    }
+    book_list_free(index);
+    list->filter = library_filter_open(list);
 
     if (list->count == 0) {
         return BOOK_ERROR_NO_BOOKS;
@@ -277,31 +1232,208 @@ int book_list_scan(book_list_t *list, const char *books_dir, void *fb_ptr) {
     return BOOK_SUCCESS;
 }
 
-void book_list_sort(book_list_t *list) {
-    if (list && list->count > 0) {
-        qsort(list->books, list->count, sizeof(book_metadata_t), compare_books);
+void book_list_sort(book_list_t *list, book_sort_key_t key) {
+    if (list && key >= 0 && key < BOOK_SORT_COUNT) {
+        list->sort_key = key;
+        list->order = list->orders[key];
     }
 }
 
-book_metadata_t* book_list_get(book_list_t *list, int index) {
-    if (!list || index < 0 || index >= list->count) {
-        return NULL;
+const char* book_sort_key_name(book_sort_key_t key) {
+    switch (key) {
+        case BOOK_SORT_TITLE:     return "Title";
+        case BOOK_SORT_AUTHOR:    return "Author";
+        case BOOK_SORT_ADDED:     return "Added";
+        case BOOK_SORT_LAST_READ: return "Last Read";
+        case BOOK_SORT_FORMAT:    return "Format";
+        default:                  return "Unknown";
+    }
+}
+
+int book_list_set_last_read(book_list_t *list, const char *filename, time_t when) {
+    int record = list ? book_list_find_record(list, filename) : -1;
+    if (record < 0) {
+        return BOOK_ERROR_NOT_FOUND;
+    }
+
+    order_remove(list, BOOK_SORT_LAST_READ, record, list->count);
+    list->records[record].last_read = (int64_t)when;
+    order_insert(list, BOOK_SORT_LAST_READ, record, list->count - 1);
+    return BOOK_SUCCESS;
+}
+
+void book_list_apply_bookmarks(book_list_t *list, const bookmark_list_t *bookmarks) {
+    if (!list || !bookmarks || list->count == 0 || bookmarks->count == 0) {
+        return;
+    }
+
+    for (int i = 0; i < bookmarks->count; i++) {
+        int record = book_list_find_record(list, bookmarks->bookmarks[i].filename);
+        if (record >= 0) {
+            list->records[record].last_read = (int64_t)bookmarks->bookmarks[i].timestamp;
+        }
+    }
+
+    int *rank = order_title_rank(list);
+    order_build(list, BOOK_SORT_LAST_READ, rank);
+    free(rank);
+}
+
+int book_list_get_count(const book_list_t *list) {
+    return list ? list->count : 0;
+}
+
+int book_list_get(const book_list_t *list, int index, book_metadata_t *out) {
+    const book_record_t *book = book_list_record(list, index);
+    if (!book || !out) {
+        return BOOK_ERROR_NOT_FOUND;
+    }
+
+    strncpy(out->filename, list_string(list, book->filename), MAX_FILENAME_LENGTH - 1);
+    out->filename[MAX_FILENAME_LENGTH - 1] = '\0';
+    if (book_record_path(list, book, out->filepath, sizeof(out->filepath)) != BOOK_SUCCESS) {
+        out->filepath[0] = '\0';
     }
-    return &list->books[index];
+    out->size = (long)book->size;
+    out->modified = (time_t)book->modified;
+    out->bookmark_page = 0;  /* Will be updated from bookmarks */
+    out->format = (book_format_type_t)book->format;
+    strncpy(out->title, list_string(list, book->title), sizeof(out->title) - 1);
+    out->title[sizeof(out->title) - 1] = '\0';
+    strncpy(out->author, list_string(list, book->author), sizeof(out->author) - 1);
+    out->author[sizeof(out->author) - 1] = '\0';
+    return BOOK_SUCCESS;
 }
 
-int book_list_find(book_list_t *list, const char *filename) {
+const char* book_list_get_filename(const book_list_t *list, int index) {
+    const book_record_t *book = book_list_record(list, index);
+    return book ? list_string(list, book->filename) : "";
+}
+
+const char* book_list_get_title(const book_list_t *list, int index) {
+    const book_record_t *book = book_list_record(list, index);
+    return book ? list_string(list, book->title) : "";
+}
+
+const char* book_list_get_author(const book_list_t *list, int index) {
+    const book_record_t *book = book_list_record(list, index);
+    return book ? list_string(list, book->author) : "";
+}
+
+book_format_type_t book_list_get_format(const book_list_t *list, int index) {
+    const book_record_t *book = book_list_record(list, index);
+    return book ? (book_format_type_t)book->format : BOOK_FORMAT_UNKNOWN;
+}
+
+int book_list_find(const book_list_t *list, const char *filename) {
     if (!list || !filename) {
         return -1;
     }
 
-    for (int i = 0; i < list->count; i++) {
-        if (strcmp(list->books[i].filename, filename) == 0) {
-            return i;
+    int record = book_list_find_record(list, filename);
+    return record >= 0 ? book_list_record_index(list, record) : -1;
+}
+
+int book_list_record_index(const book_list_t *list, int record) {
+    if (!list || record < 0 || record >= list->count) {
+        return -1;
+    }
+    return order_find(list, list->sort_key, record, list->count);
+}
+
+int book_list_update_file(book_list_t *list, const char *books_dir, const char *filename) {
+    char filepath[MAX_BOOK_PATH];
+    struct stat st;
+
+    if (!list || !books_dir || !filename) {
+        return BOOK_ERROR_INVALID_PATH;
+    }
+
+    /* Same rules as book_list_scan(): no hidden file or folder on the way */
+    book_format_type_t format = format_detect_type(filename);
+    if (format == BOOK_FORMAT_UNKNOWN || filename[0] == '.' || strstr(filename, "/.")) {
+        return BOOK_ERROR_INVALID_PATH;
+    }
+    int length = snprintf(filepath, sizeof(filepath), "%s/%s", books_dir, filename);
+    if (length < 0 || (size_t)length >= sizeof(filepath)) {
+        return BOOK_ERROR_INVALID_PATH;
+    }
+    if (stat(filepath, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+        book_list_remove_file(list, filename);
+        return BOOK_ERROR_NOT_FOUND;
+    }
+    if (list->books_dir[0] == '\0') {
+        strncpy(list->books_dir, books_dir, MAX_BOOK_PATH - 1);
+    }
+
+    int record = book_list_find_record(list, filename);
+    if (record < 0) {
+        record = book_list_append(list, filename, st.st_size, st.st_mtime, format);
+        if (record < 0) {
+            return record;
+        }
+        list->records[record].added = (int64_t)time(NULL);
+    } else {
+        book_record_t *book = &list->records[record];
+        if (book->size == st.st_size && book->modified == st.st_mtime) {
+            return BOOK_SUCCESS;  /* Unchanged */
+        }
+
+        /* Its keys may change: take it out of the orders until they are set */
+        for (int key = 0; key < BOOK_SORT_COUNT; key++) {
+            order_remove(list, (book_sort_key_t)key, record, list->count);
         }
+        library_filter_book_changed(list->filter, record);
+        book->size = st.st_size;
+        book->modified = st.st_mtime;
+        book->format = (uint8_t)format;
     }
 
-    return -1;
+    format_metadata_t metadata;
+    bool found = book_read_metadata(filepath, format, &metadata);
+    int result = book_record_set_text(list, &list->records[record],
+                                      found ? metadata.title : "", found ? metadata.author : "");
+
+    for (int key = 0; key < BOOK_SORT_COUNT; key++) {
+        order_insert(list, (book_sort_key_t)key, record, list->count - 1);
+    }
+    return result;
+}
+
+int book_list_remove_file(book_list_t *list, const char *filename) {
+    int record = (list && filename) ? book_list_find_record(list, filename) : -1;
+    if (record < 0) {
+        return BOOK_ERROR_NOT_FOUND;
+    }
+
+    /* Keep the order of the rest so menu positions stay put */
+    table_remove(&list->paths, book_id(filename), record);
+    for (int key = 0; key < BOOK_SORT_COUNT; key++) {
+        order_remove(list, (book_sort_key_t)key, record, list->count);
+    }
+    list->count--;
+
+    /* Move the last record into the freed slot; it is found in each order
+     * by its keys, which do not change */
+    if (record != list->count) {
+        for (int key = 0; key < BOOK_SORT_COUNT; key++) {
+            int pos = order_find(list, (book_sort_key_t)key, list->count, list->count);
+            if (pos >= 0) {
+                list->orders[key][pos] = record;
+            }
+        }
+        table_move(&list->paths, book_id(record_name(list, list->count)), list->count, record);
+        list->records[record] = list->records[list->count];
+    }
+    library_filter_book_removed(list->filter, record, list->count);
+    return BOOK_SUCCESS;
+}
+
+void book_list_save_index(book_list_t *list) {
+    if (list) {
+        library_index_save(list, LIBRARY_INDEX_FILE);
+        library_filter_refresh(list);
+    }
 }
 
 /*
@@ -335,10 +1467,6 @@ int book_validate(const char *filepath, long *out_size) {
         return BOOK_ERROR_EMPTY_FILE;
     }
 
-    if (st.st_size > MAX_BOOK_SIZE) {
-        return BOOK_ERROR_TOO_LARGE;
-    }
-
     if (out_size) {
         *out_size = st.st_size;
     }
@@ -347,61 +1475,62 @@ int book_validate(const char *filepath, long *out_size) {
 }
 
 book_t* book_load(const char *filepath) {
-    FILE *f;
     book_t *book;
-    long size;
-    size_t bytes_read;
-    int validation_result;
+    int result;
 
     /* Validate file */
-    validation_result = book_validate(filepath, &size);
-    if (validation_result != BOOK_SUCCESS) {
+    result = book_validate(filepath, NULL);
+    if (result != BOOK_SUCCESS) {
         fprintf(stderr, "book_load: Validation failed for %s: %s\n",
-                filepath, book_error_string(validation_result));
-        return NULL;
-    }
-
-    /* Open file */
-    f = fopen(filepath, "r");
-    if (!f) {
-        fprintf(stderr, "book_load: Failed to open %s: %s\n",
-                filepath, strerror(errno));
+                filepath, book_error_string(result));
         return NULL;
     }
 
     /* Allocate book structure */
-    book = malloc(sizeof(book_t));
+    book = calloc(1, sizeof(book_t));
     if (!book) {
         fprintf(stderr, "book_load: Failed to allocate book structure\n");
-        fclose(f);
-        return NULL;
-    }
-
-    /* Allocate text buffer */
-    book->text = malloc(size + 1);
-    if (!book->text) {
-        fprintf(stderr, "book_load: Failed to allocate %ld bytes for text\n", size);
-        free(book);
-        fclose(f);
         return NULL;
     }
 
-    /* Read file content */
-    bytes_read = fread(book->text, 1, size, f);
-    fclose(f);
+    /* Compressed TXT is read through its format too, a block at a time */
+    book_format_type_t format = format_detect_type(filepath);
+    if (format != BOOK_FORMAT_UNKNOWN &&
+        (format != BOOK_FORMAT_TXT || txt_gz_is_gz_file(filepath))) {
+        /* Open through the format; text is extracted as the reader reaches it */
+        const book_format_interface_t *interface = format_get_interface(format);
+        format_handle_t handle = interface ? interface->open(filepath) : NULL;
+        if (!handle) {
+            fprintf(stderr, "book_load: Failed to open %s\n", filepath);
+            free(book);
+            return NULL;
+        }
 
-    if (bytes_read != (size_t)size) {
-        fprintf(stderr, "book_load: Read error: expected %ld bytes, got %zu\n",
-                size, bytes_read);
-        free(book->text);
-        free(book);
-        return NULL;
+        size_t length;
+        result = format_get_length(interface, handle, &length);
+        if (result != FORMAT_SUCCESS) {
+            fprintf(stderr, "book_load: Failed to load %s: %s\n",
+                    filepath, format_error_string(result));
+            interface->close(handle);
+            free(book);
+            return NULL;
+        }
+        book->format = interface;
+        book->handle = handle;
+        book->text_length = length;
+    } else {
+        /* Map file content, converting it to UTF-8 only if needed */
+        result = charset_load_file(filepath, &book->source);
+        if (result != FORMAT_SUCCESS) {
+            fprintf(stderr, "book_load: Failed to load %s: %s\n",
+                    filepath, format_error_string(result));
+            free(book);
+            return NULL;
+        }
+        book->text = book->source.text;
+        book->text_length = book->source.length;
     }
 
-    /* Null-terminate */
-    book->text[size] = '\0';
-    book->text_length = size;
-
     /* Extract filename */
     const char *basename = book_basename(filepath);
     strncpy(book->filename, basename, MAX_FILENAME_LENGTH - 1);
@@ -412,7 +1541,10 @@ book_t* book_load(const char *filepath) {
 
 void book_unload(book_t *book) {
     if (book) {
-        free(book->text);
+        if (book->handle) {
+            book->format->close(book->handle);
+        }
+        charset_text_free(&book->source);
         free(book);
     }
 }
@@ -422,7 +1554,7 @@ void book_unload(book_t *book) {
  */
 
 bookmark_list_t* bookmark_list_create(void) {
-    bookmark_list_t *list = malloc(sizeof(bookmark_list_t));
+    bookmark_list_t *list = calloc(1, sizeof(bookmark_list_t));
     if (!list) {
         return NULL;
     }
@@ -442,17 +1574,20 @@ bookmark_list_t* bookmark_list_create(void) {
 void bookmark_list_free(bookmark_list_t *list) {
     if (list) {
         free(list->bookmarks);
+        free(list->table.slots);
         free(list);
     }
 }
 
 int bookmark_list_load(bookmark_list_t *list, const char *filepath) {
     FILE *f;
-    char line[512];
+    char line[MAX_FILENAME_LENGTH + 96];
+    char number[32];
     int line_num = 0;
 
     /* Reset list */
     list->count = 0;
+    table_clear(&list->table);
 
     /* Open file */
     f = fopen(filepath, "r");
@@ -475,14 +1610,31 @@ int bookmark_list_load(bookmark_list_t *list, const char *filepath) {
             continue;
         }
 
-        /* Parse CSV: filename,page,timestamp */
         char filename[MAX_FILENAME_LENGTH];
         int page;
         long timestamp;
+        long offset = -1;
 
-        int fields = sscanf(line, "%255[^,],%d,%ld", filename, &page, &timestamp);
-
-        if (fields != 3) {
+        if (strchr(line, '\t')) {
+            /* Parse: filename<TAB>page<TAB>timestamp<TAB>offset */
+            if (strcspn(line, "\t") >= sizeof(filename)) {
+                fprintf(stderr, "bookmark_list_load: Filename too long at line %d\n", line_num);
+                continue;
+            }
+            char *next = index_field(line, filename, sizeof(filename));
+            next = next ? index_field(next, number, sizeof(number)) : NULL;
+            page = (int)strtol(number, NULL, 10);
+            next = next ? index_field(next, number, sizeof(number)) : NULL;
+            timestamp = strtol(number, NULL, 10);
+            if (!next) {
+                fprintf(stderr, "bookmark_list_load: Parse error at line %d\n", line_num);
+                continue;
+            }
+            index_field(next, number, sizeof(number));
+            offset = strtol(number, NULL, 10);
+        } else if (sscanf(line, "%255[^,],%d,%ld,%ld", filename, &page, &timestamp,
+                          &offset) < 3) {
+            /* Files written before folders were scanned: filename,page,timestamp[,offset] */
             fprintf(stderr, "bookmark_list_load: Parse error at line %d\n", line_num);
             continue;
         }
@@ -494,23 +1646,17 @@ int bookmark_list_load(bookmark_list_t *list, const char *filepath) {
             continue;
         }
 
-        /* Check if we need to resize */
-        if (list->count >= list->capacity) {
-            int new_capacity = list->capacity * 2;
-            if (bookmark_list_resize(list, new_capacity) != BOOK_SUCCESS) {
-                fprintf(stderr, "bookmark_list_load: Failed to resize list\n");
-                break;
-            }
+        /* Add bookmark (a later line for the same book replaces it) */
+        int existing = bookmark_find(list, filename);
+        bookmark_t *bm = existing >= 0 ? &list->bookmarks[existing]
+                                       : bookmark_list_append(list, filename);
+        if (!bm) {
+            fprintf(stderr, "bookmark_list_load: Failed to resize list\n");
+            break;
         }
-
-        /* Add bookmark */
-        bookmark_t *bm = &list->bookmarks[list->count];
-        strncpy(bm->filename, filename, MAX_FILENAME_LENGTH - 1);
-        bm->filename[MAX_FILENAME_LENGTH - 1] = '\0';
         bm->page = page;
         bm->timestamp = (time_t)timestamp;
-
-        list->count++;
+        bm->offset = offset;
     }
 
     fclose(f);
@@ -544,48 +1690,38 @@ int bookmark_list_save(bookmark_list_t *list, const char *filepath) {
 
     /* Write header */
     fprintf(f, "# E-Reader Bookmarks File\n");
-    fprintf(f, "# Format: filename,page_number,last_read_timestamp\n");
+    fprintf(f, "# Format: filename<TAB>page_number<TAB>last_read_timestamp<TAB>text_offset\n");
 
-    /* Write bookmarks */
+    /* Write bookmarks (filenames are relative paths and may hold commas) */
     for (int i = 0; i < list->count; i++) {
         bookmark_t *bm = &list->bookmarks[i];
-        fprintf(f, "%s,%d,%ld\n", bm->filename, bm->page, (long)bm->timestamp);
+        if (strpbrk(bm->filename, "\t\r\n")) {
+            continue;  /* Cannot be stored */
+        }
+        fprintf(f, "%s\t%d\t%ld\t%ld\n", bm->filename, bm->page, (long)bm->timestamp,
+                bm->offset);
     }
 
     fclose(f);
     return BOOK_SUCCESS;
 }
 
-int bookmark_update(bookmark_list_t *list, const char *filename, int page) {
+int bookmark_update(bookmark_list_t *list, const char *filename, int page, long offset) {
     if (!list || !filename || page < 0) {
         return BOOK_ERROR_INVALID_PATH;
     }
 
-    /* Search for existing bookmark */
-    for (int i = 0; i < list->count; i++) {
-        if (strcmp(list->bookmarks[i].filename, filename) == 0) {
-            /* Update existing bookmark */
-            list->bookmarks[i].page = page;
-            list->bookmarks[i].timestamp = time(NULL);
-            return BOOK_SUCCESS;
-        }
-    }
-
-    /* Bookmark not found - create new one */
-    if (list->count >= list->capacity) {
-        int new_capacity = list->capacity * 2;
-        if (bookmark_list_resize(list, new_capacity) != BOOK_SUCCESS) {
-            return BOOK_ERROR_OUT_OF_MEMORY;
-        }
+    /* Update the existing bookmark, or create a new one */
+    int existing = bookmark_find(list, filename);
+    bookmark_t *bm = existing >= 0 ? &list->bookmarks[existing]
+                                   : bookmark_list_append(list, filename);
+    if (!bm) {
+        return BOOK_ERROR_OUT_OF_MEMORY;
     }
 
-    bookmark_t *bm = &list->bookmarks[list->count];
-    strncpy(bm->filename, filename, MAX_FILENAME_LENGTH - 1);
-    bm->filename[MAX_FILENAME_LENGTH - 1] = '\0';
     bm->page = page;
     bm->timestamp = time(NULL);
-    list->count++;
-
+    bm->offset = offset;
     return BOOK_SUCCESS;
 }
 
@@ -594,13 +1730,17 @@ int bookmark_get(bookmark_list_t *list, const char *filename) {
         return -1;
     }
 
-    for (int i = 0; i < list->count; i++) {
-        if (strcmp(list->bookmarks[i].filename, filename) == 0) {
-            return list->bookmarks[i].page;
-        }
+    int i = bookmark_find(list, filename);
+    return i >= 0 ? list->bookmarks[i].page : -1;
+}
+
+long bookmark_get_offset(bookmark_list_t *list, const char *filename) {
+    if (!list || !filename) {
+        return -1;
     }
 
-    return -1;  /* Not found */
+    int i = bookmark_find(list, filename);
+    return i >= 0 ? list->bookmarks[i].offset : -1;
 }
 
 int bookmark_remove(bookmark_list_t *list, const char *filename) {
@@ -608,24 +1748,30 @@ int bookmark_remove(bookmark_list_t *list, const char *filename) {
         return BOOK_ERROR_INVALID_PATH;
     }
 
-    for (int i = 0; i < list->count; i++) {
-        if (strcmp(list->bookmarks[i].filename, filename) == 0) {
-            /* Remove by shifting subsequent bookmarks */
-            for (int j = i; j < list->count - 1; j++) {
-                list->bookmarks[j] = list->bookmarks[j + 1];
-            }
-            list->count--;
-            return BOOK_SUCCESS;
-        }
+    int i = bookmark_find(list, filename);
+    if (i < 0) {
+        return BOOK_ERROR_NOT_FOUND;
     }
 
-    return BOOK_ERROR_NOT_FOUND;
+    /* Leave a tombstone and move the last bookmark into the gap */
+    int last = list->count - 1;
+    table_remove(&list->table, book_id(filename), i);
+    if (i != last) {
+        table_move(&list->table, book_id(list->bookmarks[last].filename), last, i);
+        list->bookmarks[i] = list->bookmarks[last];
+    }
+    list->count--;
+    return BOOK_SUCCESS;
 }
 
 /*
  * Utility Functions
  */
 
+uint32_t book_id(const char *filename) {
+    return string_hash(filename);
+}
+
 const char* book_error_string(book_error_t error) {
     switch (error) {
         case BOOK_SUCCESS:
@@ -31,16 +31,21 @@
 
 #include <stdint.h>
 #include <time.h>
+#include "../formats/charset.h"
 
 /*
  * Configuration constants
  */
 #define MAX_FILENAME_LENGTH 256
 #define MAX_BOOK_PATH 512
-#define MAX_BOOKS 1000
-#define MAX_BOOK_SIZE (10 * 1024 * 1024)  /* 10MB limit for Phase 03 */
+#define BOOK_SCAN_MAX_DEPTH 8          /* Folder levels below BOOKS_DIR that are scanned */
+#define BOOK_SCAN_MAX_WORKERS 4        /* Threads reading book metadata during a scan */
+#define BOOK_SCAN_PROGRESS_MS 500      /* Shortest interval between progress redraws */
 #define BOOKS_DIR "/books"
 #define BOOKMARKS_FILE "/etc/ereader/bookmarks.txt"
+#ifndef LIBRARY_INDEX_FILE
+#define LIBRARY_INDEX_FILE "/etc/ereader/library.idx"
+#endif
 
 /*
  * Book format type (forward declaration from format_interface.h)
@@ -49,15 +54,30 @@ typedef enum {
     BOOK_FORMAT_UNKNOWN = 0,
     BOOK_FORMAT_TXT,
     BOOK_FORMAT_EPUB,
-    BOOK_FORMAT_PDF
+    BOOK_FORMAT_PDF,
+    BOOK_FORMAT_ERB
 } book_format_type_t;
 
+/*
+ * Library sort orders
+ * Each has its own persistent order array; ties are broken by title and
+ * then filename, so every order is total
+ */
+typedef enum {
+    BOOK_SORT_TITLE = 0,                 /* Title, ignoring a leading article */
+    BOOK_SORT_AUTHOR,                    /* Author's last name, then title; no author last */
+    BOOK_SORT_ADDED,                     /* Newest in the library first */
+    BOOK_SORT_LAST_READ,                 /* Most recently opened first; unread last */
+    BOOK_SORT_FORMAT,                    /* Format, then title */
+    BOOK_SORT_COUNT
+} book_sort_key_t;
+
 /*
  * Book metadata structure
- * Stores information about a single book file without loading the full content
+ * Self-contained copy of one book of a list, filled by book_list_get()
  */
 typedef struct {
-    char filename[MAX_FILENAME_LENGTH];  /* Basename of the file (e.g., "book.txt") */
+    char filename[MAX_FILENAME_LENGTH];  /* Path below the books directory (e.g., "Author/book.txt") */
     char filepath[MAX_BOOK_PATH];        /* Full path to the file */
     long size;                           /* File size in bytes */
     time_t modified;                     /* Last modification time */
@@ -67,24 +87,87 @@ typedef struct {
     char author[256];                    /* Author name (extracted from metadata, empty if N/A) */
 } book_metadata_t;
 
+/*
+ * Lookup table
+ * Open-addressing hash table from a book's ID (book_id() of its filename)
+ * to an entry of a book or bookmark list. A removed entry leaves a
+ * tombstone that later inserts reuse; the table is rebuilt without them
+ * when live entries and tombstones fill three quarters of it.
+ */
+#define BOOK_TABLE_EMPTY   (-1)          /* Slot never used (ends a probe) */
+#define BOOK_TABLE_REMOVED (-2)          /* Tombstone of a removed entry */
+
+typedef struct {
+    uint32_t id;                         /* Book ID of the entry */
+    int32_t entry;                       /* Entry index, BOOK_TABLE_EMPTY or BOOK_TABLE_REMOVED */
+} book_slot_t;
+
+typedef struct {
+    book_slot_t *slots;
+    size_t size;                         /* Slots (a power of two, or 0) */
+    size_t count;                        /* Live entries */
+    size_t used;                         /* Live entries and tombstones */
+} book_table_t;
+
+/*
+ * Book record
+ * Fixed-size list entry; its strings are offsets into the list's string
+ * arena (offset 0 is the empty string). A title equal to the file's
+ * basename points into the filename, and each author and author key is
+ * stored once. The keys are collation_key()s, built when the text is set.
+ */
+typedef struct {
+    int64_t size;                        /* File size in bytes */
+    int64_t modified;                    /* Last modification time */
+    int64_t added;                       /* When the book was first found */
+    int64_t last_read;                   /* When the book was last opened (0 = never) */
+    uint32_t filename;                   /* Path below the books directory */
+    uint32_t title;                      /* Book title (or the file's basename) */
+    uint32_t author;                     /* Interned author name */
+    uint32_t title_key;                  /* Sort key of the title */
+    uint32_t author_key;                 /* Interned sort key of the author */
+    uint8_t format;                      /* book_format_type_t */
+} book_record_t;
+
 /*
  * Book list structure
- * Contains all discovered books in the library
+ * Contains all discovered books in the library, about 56 bytes of record,
+ * 20 of orders and 8-16 of path table per book plus their strings
  */
+struct library_filter;
+
 typedef struct {
-    book_metadata_t *books;              /* Array of book metadata */
+    book_record_t *records;              /* Books, in no particular order */
+    int *orders[BOOK_SORT_COUNT];        /* Record of each list position, per sort key */
+    int *order;                          /* Order of the current sort key */
+    book_sort_key_t sort_key;            /* Current sort key */
     int count;                           /* Number of books in the list */
-    int capacity;                        /* Allocated capacity */
+    int capacity;                        /* Allocated records and positions */
+    char *strings;                       /* String arena */
+    size_t strings_used;
+    size_t strings_size;
+    uint32_t *authors;                   /* Interned authors: open-addressing table of arena offsets */
+    size_t author_slots;                 /* Table size (a power of two, or 0) */
+    size_t author_count;
+    book_table_t paths;                  /* Record of each filename */
+    char books_dir[MAX_BOOK_PATH];       /* Directory the filenames are below ("" = absolute) */
+    struct library_filter *filter;       /* Title and author index (library_filter.h; NULL until scanned) */
 } book_list_t;
 
 /*
  * Loaded book structure
- * Contains the full text content of a book currently being read
+ * TXT books hold their full text; other formats stay open behind their
+ * format handle and supply text in chunks (format_chunk_at())
  */
+struct book_format_interface;
+
 typedef struct {
     char filename[MAX_FILENAME_LENGTH];  /* Book filename */
-    char *text;                          /* Full text content (null-terminated) */
+    const char *text;                    /* Full text content (UTF-8, null-terminated; NULL if chunked) */
     size_t text_length;                  /* Length of text in bytes */
+    charset_text_t source;               /* Mapped or converted storage behind text */
+    const struct book_format_interface *format;  /* Format supplying chunks (NULL for TXT) */
+    void *handle;                        /* Open format handle (NULL for TXT) */
 } book_t;
 
 /*
@@ -95,6 +178,7 @@ typedef struct {
     char filename[MAX_FILENAME_LENGTH];  /* Book filename */
     int page;                            /* Last read page (0-based) */
     time_t timestamp;                    /* When this position was saved */
+    long offset;                         /* Text offset of the page's first character (-1 if unknown) */
 } bookmark_t;
 
 /*
@@ -105,6 +189,7 @@ typedef struct {
     bookmark_t *bookmarks;               /* Array of bookmarks */
     int count;                           /* Number of bookmarks */
     int capacity;                        /* Allocated capacity */
+    book_table_t table;                  /* Bookmark of each filename */
 } bookmark_list_t;
 
 /*
@@ -131,33 +216,98 @@ book_list_t* book_list_create(void);
 /* Free a book list */
 void book_list_free(book_list_t *list);
 
-/* Scan the books directory and populate the list
+/* Scan the books directory and its subfolders and populate the list
+ * The tree is walked once, up to BOOK_SCAN_MAX_DEPTH folders deep, skipping
+ * hidden entries. Metadata of books whose path, size and mtime match
+ * LIBRARY_INDEX_FILE is taken from the index; only new or changed books are
+ * opened, on up to BOOK_SCAN_MAX_WORKERS threads (one per CPU), and the
+ * index is rewritten when anything differed. Every sort order is built
+ * once at the end; reading times of listed books are kept. The filter
+ * index is mapped from LIBRARY_FILTER_FILE or built anew.
  * @param list: Book list to populate
  * @param books_dir: Directory to scan
  * @param fb: Optional framebuffer for progress display (can be NULL)
  */
 int book_list_scan(book_list_t *list, const char *books_dir, void *fb);
 
-/* Sort books alphabetically by filename */
-void book_list_sort(book_list_t *list);
+/* Switch the sort order
+ * The orders are kept up to date as books change, so this moves nothing.
+ * @param key: Sort key to list by
+ */
+void book_list_sort(book_list_t *list, book_sort_key_t key);
+
+/* Get the name of a sort key for display (e.g., "Title") */
+const char* book_sort_key_name(book_sort_key_t key);
 
-/* Get book metadata by index */
-book_metadata_t* book_list_get(book_list_t *list, int index);
+/* Record when a book was opened, moving it in the last read order only
+ * @param filename: Path below the books directory
+ * @param when: Time it was opened
+ * @return: BOOK_SUCCESS, or BOOK_ERROR_NOT_FOUND if it is not listed
+ */
+int book_list_set_last_read(book_list_t *list, const char *filename, time_t when);
 
-/* Find book by filename */
-int book_list_find(book_list_t *list, const char *filename);
+/* Take the reading time of each listed book from its bookmark */
+void book_list_apply_bookmarks(book_list_t *list, const bookmark_list_t *bookmarks);
+
+/* Get the number of books in the list */
+int book_list_get_count(const book_list_t *list);
+
+/* Copy a book out of the list
+ * @param index: List position (0-based)
+ * @param out: Filled with the book's metadata and full path
+ * @return: BOOK_SUCCESS, or BOOK_ERROR_NOT_FOUND if index is out of range
+ */
+int book_list_get(const book_list_t *list, int index, book_metadata_t *out);
+
+/* Get one field of a book without copying it
+ * The strings stay valid until the list is next changed; an index out of
+ * range gives "" (BOOK_FORMAT_UNKNOWN for the format).
+ */
+const char* book_list_get_filename(const book_list_t *list, int index);
+const char* book_list_get_title(const book_list_t *list, int index);
+const char* book_list_get_author(const book_list_t *list, int index);
+book_format_type_t book_list_get_format(const book_list_t *list, int index);
+
+/* Find book by filename (its path below the books directory)
+ * @return: List position, or -1 if it is not listed
+ */
+int book_list_find(const book_list_t *list, const char *filename);
+
+/* Get the list position of a record (-1 if it is not listed) */
+int book_list_record_index(const book_list_t *list, int record);
+
+/* Add or refresh one book after its file changed
+ * Only this file is examined; its metadata is read from the book when it is
+ * new or its size or mtime changed, and it moves to its place in each
+ * sort order by binary search. A file that is gone, empty or not a book
+ * is removed from the list instead.
+ * @param list: Book list to update
+ * @param books_dir: Books directory
+ * @param filename: Path of the changed file below books_dir
+ * @return: BOOK_SUCCESS if listed, BOOK_ERROR_NOT_FOUND if removed or absent,
+ *          other error code otherwise
+ */
+int book_list_update_file(book_list_t *list, const char *books_dir, const char *filename);
+
+/* Remove a book by filename, keeping the order of the others */
+int book_list_remove_file(book_list_t *list, const char *filename);
+
+/* Write the list to LIBRARY_INDEX_FILE, so the next scan reuses its metadata,
+ * rebuilding the filter index too if many books changed since it was built */
+void book_list_save_index(book_list_t *list);
 
 /*
  * Book Loading and Unloading
  */
 
-/* Load a book's full text into memory */
+/* Load a book: TXT text as UTF-8 (mapped read-only unless converted),
+ * other formats opened for chunked reading without extracting anything */
 book_t* book_load(const char *filepath);
 
-/* Unload a book and free its memory */
+/* Unload a book and release its text or format handle */
 void book_unload(book_t *book);
 
-/* Check if a book file is valid (exists, readable, not too large) */
+/* Check if a book file is valid (exists, readable, not empty) */
 int book_validate(const char *filepath, long *out_size);
 
 /*
@@ -176,19 +326,30 @@ int bookmark_list_load(bookmark_list_t *list, const char *filepath);
 /* Save bookmarks to file */
 int bookmark_list_save(bookmark_list_t *list, const char *filepath);
 
-/* Update or create a bookmark for a book */
-int bookmark_update(bookmark_list_t *list, const char *filename, int page);
+/* Update or create a bookmark for a book
+ * @param offset: Text offset of the page's first character (-1 if unknown)
+ */
+int bookmark_update(bookmark_list_t *list, const char *filename, int page, long offset);
 
 /* Get bookmark page for a book (returns -1 if not found) */
 int bookmark_get(bookmark_list_t *list, const char *filename);
 
-/* Remove a bookmark */
+/* Get bookmark text offset for a book (returns -1 if not found or unknown) */
+long bookmark_get_offset(bookmark_list_t *list, const char *filename);
+
+/* Remove a bookmark
+ * The last bookmark takes its place, so the order of the others may change.
+ */
 int bookmark_remove(bookmark_list_t *list, const char *filename);
 
 /*
  * Utility Functions
  */
 
+/* Get the stable ID of a book: a hash of its filename, by which the book
+ * list and the bookmarks look it up */
+uint32_t book_id(const char *filename);
+
 /* Get a human-readable error message for an error code */
 const char* book_error_string(book_error_t error);
 
@@ -0,0 +1,209 @@
+/*
+ * collation.c - Sort Keys for Book Titles and Authors
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include "collation.h"
+#include "../rendering/utf8.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Longest folded text a key is built from */
+#define COLLATION_FOLD_MAX 256
+
+/* fold_char() result for characters that separate words */
+#define FOLD_SEPARATOR (-1)
+
+/* Base letters of U+00C0 to U+017F. Upper case stands for a letter pair
+ * ('A' = "ae", 'I' = "ij", 'O' = "oe", 'S' = "ss", 'T' = "th") and '-'
+ * for a symbol. */
+static const char latin_fold[] =
+    "aaaaaaAceeeeiiii" "dnooooo-ouuuuyTS"   /* U+00C0 */
+    "aaaaaaAceeeeiiii" "dnooooo-ouuuuyTy"   /* U+00E0 */
+    "aaaaaaccccccccdd" "ddeeeeeeeeeegggg"   /* U+0100 */
+    "gggghhhhiiiiiiii" "iiIIjjkkklllllll"   /* U+0120 */
+    "lllnnnnnnnnnoooo" "ooOOrrrrrrssssss"   /* U+0140 */
+    "ssttttttuuuuuuuu" "uuuuwwyyyzzzzzzs";  /* U+0160 */
+
+/* Articles a title key skips (followed by a space in folded text) */
+static const char *const title_articles[] = { "the ", "an ", "a " };
+
+/*
+ * Internal helpers
+ */
+
+/**
+ * Fold one character
+ * @param cp: Codepoint
+ * @param out: Output buffer with room for UTF8_MAX_BYTES
+ * @return: Bytes written, 0 for a character that is dropped, or
+ *          FOLD_SEPARATOR for one that separates words
+ */
+static int fold_char(uint32_t cp, char *out) {
+    if (cp < 0x80) {
+        if ((cp >= 'a' && cp <= 'z') || (cp >= '0' && cp <= '9')) {
+            out[0] = (char)cp;
+            return 1;
+        }
+        if (cp >= 'A' && cp <= 'Z') {
+            out[0] = (char)(cp - 'A' + 'a');
+            return 1;
+        }
+        return (cp == '\'' || cp == '`') ? 0 : FOLD_SEPARATOR;
+    }
+
+    if (cp >= 0xC0 && cp <= 0x17F) {
+        char base = latin_fold[cp - 0xC0];
+        switch (base) {
+            case '-': return FOLD_SEPARATOR;
+            case 'A': memcpy(out, "ae", 2); return 2;
+            case 'I': memcpy(out, "ij", 2); return 2;
+            case 'O': memcpy(out, "oe", 2); return 2;
+            case 'S': memcpy(out, "ss", 2); return 2;
+            case 'T': memcpy(out, "th", 2); return 2;
+            default:  out[0] = base; return 1;
+        }
+    }
+
+    /* Quotes typed as apostrophes ("Don’t") */
+    if (cp == 0x2018 || cp == 0x2019 || cp == 0xB4) {
+        return 0;
+    }
+
+    /* Latin-1 symbols, general and CJK punctuation */
+    if (cp < 0xC0 || (cp >= 0x2000 && cp <= 0x206F) || (cp >= 0x3000 && cp <= 0x303F) ||
+        cp == UTF8_REPLACEMENT) {
+        return FOLD_SEPARATOR;
+    }
+
+    /* Greek and Cyrillic capitals */
+    if ((cp >= 0x391 && cp <= 0x3A9) || (cp >= 0x410 && cp <= 0x42F)) {
+        cp += 0x20;
+    } else if (cp >= 0x400 && cp <= 0x40F) {
+        cp += 0x50;
+    }
+    return (int)utf8_encode(cp, out);
+}
+
+/**
+ * Skip a leading article of a folded title, unless it is the whole title
+ */
+static const char* skip_article(const char *folded) {
+    for (size_t i = 0; i < sizeof(title_articles) / sizeof(title_articles[0]); i++) {
+        size_t length = strlen(title_articles[i]);
+        if (strncmp(folded, title_articles[i], length) == 0) {
+            return folded + length;
+        }
+    }
+    return folded;
+}
+
+/**
+ * Copy folded text into a key, prefixing each run of digits with its length
+ * (leading zeros dropped) so numbers compare by value
+ */
+static size_t encode_digits(const char *src, char *out) {
+    size_t length = 0;
+
+    while (*src && length < COLLATION_KEY_MAX - 1) {
+        if (*src < '0' || *src > '9') {
+            out[length++] = *src++;
+            continue;
+        }
+
+        while (src[0] == '0' && src[1] >= '0' && src[1] <= '9') {
+            src++;
+        }
+        size_t digits = 0;
+        while (src[digits] >= '0' && src[digits] <= '9') {
+            digits++;
+        }
+
+        /* '1'..'9' and beyond; every prefix sorts before the letters */
+        out[length++] = (char)('0' + (digits < 40 ? digits : 40));
+        while (digits-- > 0 && length < COLLATION_KEY_MAX - 1) {
+            out[length++] = *src++;
+        }
+    }
+
+    out[length] = '\0';
+    return length;
+}
+
+/*
+ * Public Functions
+ */
+
+size_t collation_fold(const char *text, char *out, size_t out_size) {
+    char folded[UTF8_MAX_BYTES];
+    size_t length = 0;
+    bool space = false;
+    uint32_t cp;
+
+    while (*text) {
+        text += utf8_decode(text, SIZE_MAX, &cp);
+
+        int bytes = fold_char(cp, folded);
+        if (bytes == FOLD_SEPARATOR) {
+            space = (length > 0);
+            continue;
+        }
+        if (bytes == 0) {
+            continue;
+        }
+
+        if (length + (space ? 1 : 0) + (size_t)bytes >= out_size) {
+            break;
+        }
+        if (space) {
+            out[length++] = ' ';
+            space = false;
+        }
+        memcpy(out + length, folded, (size_t)bytes);
+        length += (size_t)bytes;
+    }
+
+    out[length] = '\0';
+    return length;
+}
+
+size_t collation_key(const char *text, collation_kind_t kind, char *out) {
+    char folded[COLLATION_FOLD_MAX];
+    char rotated[COLLATION_FOLD_MAX];
+    const char *start = folded;
+
+    collation_fold(text, folded, sizeof(folded));
+
+    if (kind == COLLATION_TITLE) {
+        start = skip_article(folded);
+    } else if (kind == COLLATION_AUTHOR && !strchr(text, ',')) {
+        /* "Jane Austen" sorts as "austen jane" */
+        const char *last = strrchr(folded, ' ');
+        if (last) {
+            snprintf(rotated, sizeof(rotated), "%s %.*s", last + 1, (int)(last - folded), folded);
+            start = rotated;
+        }
+    }
+
+    return encode_digits(start, out);
+}
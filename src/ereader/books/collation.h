@@ -0,0 +1,73 @@
+/*
+ * collation.h - Sort Keys for Book Titles and Authors
+ *
+ * The library is sorted by comparing byte strings built once per book,
+ * so sorting never looks at case, accents or punctuation again. A key is
+ * the text folded to lowercase with Latin accents removed ("Émile" and
+ * "emile" are equal, "ß" is "ss"), punctuation turned into single spaces
+ * and apostrophes dropped. Runs of digits are prefixed with their length,
+ * so "Part 2" sorts before "Part 10". Title keys skip a leading "The",
+ * "A" or "An"; author keys put the last name first unless the name
+ * already reads "Last, First".
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef COLLATION_H
+#define COLLATION_H
+
+#include <stddef.h>
+
+/* Longest key kept, terminator included; longer texts compare on their
+ * first COLLATION_KEY_MAX - 1 bytes and then on the book's filename */
+#define COLLATION_KEY_MAX 48
+
+/*
+ * Kind of text a key is built from
+ */
+typedef enum {
+    COLLATION_TEXT,                /* Plain text */
+    COLLATION_TITLE,               /* Leading article ignored */
+    COLLATION_AUTHOR               /* Last name first */
+} collation_kind_t;
+
+/**
+ * Fold text for matching and sorting
+ * Lowercase, Latin accents removed, words separated by single spaces with
+ * none leading or trailing. Characters outside Latin, Greek and Cyrillic
+ * are kept as they are. Output is cut at a character boundary.
+ * @param text: UTF-8 text (NUL-terminated)
+ * @param out: Output buffer
+ * @param out_size: Size of out (at least 1)
+ * @return: Length of the folded text
+ */
+size_t collation_fold(const char *text, char *out, size_t out_size);
+
+/**
+ * Build the sort key of a text
+ * Keys compare with strcmp() in the order the library lists them.
+ * @param text: UTF-8 text (NUL-terminated)
+ * @param kind: What the text is
+ * @param out: Output buffer of COLLATION_KEY_MAX bytes
+ * @return: Length of the key (0 for text without letters or digits)
+ */
+size_t collation_key(const char *text, collation_kind_t kind, char *out);
+
+#endif /* COLLATION_H */
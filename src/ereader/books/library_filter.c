@@ -0,0 +1,943 @@
+/*
+ * library_filter.c - Title and Author Filter Index
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include "library_filter.h"
+#include "collation.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define FILTER_MAGIC      "ERLIBFLT"
+#define FILTER_VERSION    1
+#define FILTER_FIELD_MAX  256                                 /* Folded title or author */
+#define FILTER_TEXT_MAX   (2 * FILTER_FIELD_MAX + 4)          /* " title\n author" */
+#define FILTER_GRAMS_MAX  (2 * FILTER_TEXT_MAX)               /* Grams of one text */
+#define FILTER_WORDS_MAX  (LIBRARY_FILTER_QUERY_MAX / 2)      /* Words of one query */
+
+/*
+ * On-Disk Layout (native byte order; the index never leaves the device)
+ */
+
+typedef struct filter_header {
+    char magic[8];                     /* FILTER_MAGIC */
+    uint32_t version;                  /* FILTER_VERSION */
+    uint32_t doc_count;
+    uint32_t gram_count;
+    uint32_t postings_size;
+    uint32_t text_size;
+    uint32_t reserved;
+} filter_header_t;
+
+typedef struct filter_doc {
+    uint64_t key;                      /* filter_book_key() of the book */
+    uint32_t text;                     /* Offset of its folded text */
+    uint32_t reserved;
+} filter_doc_t;
+
+typedef struct filter_gram {
+    uint32_t gram;                     /* Three bytes, the last 0 for a word's first letter */
+    uint32_t postings;                 /* Offset of its postings; the next gram's ends them */
+} filter_gram_t;                       /* gram_count of them, then one ending the last */
+
+/* Slot of the gram table used while building */
+typedef struct {
+    uint32_t gram;                     /* 0 = free */
+    uint32_t size;                     /* Bytes of postings */
+    int last;                          /* Last doc added (-1 = none) */
+    uint32_t cursor;                   /* Where the next posting goes */
+} gram_slot_t;
+
+typedef struct {
+    gram_slot_t *slots;
+    size_t mask;                       /* Slot count - 1 (a power of two) */
+    size_t used;
+} gram_table_t;
+
+/*
+ * Book Text
+ */
+
+/* FNV-1a hash of a string, continuing from hash */
+static uint64_t filter_hash(uint64_t hash, const char *text) {
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        hash = (hash ^ *p) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/* Key of a book: its path, title and author; a doc whose key matches a
+ * record holds that record's text */
+static uint64_t filter_book_key(const book_list_t *list, int record) {
+    const book_record_t *book = &list->records[record];
+    uint64_t hash = 14695981039346656037ULL;
+
+    hash = filter_hash(hash, list->strings + book->filename);
+    hash = (hash ^ 0x1F) * 1099511628211ULL;
+    hash = filter_hash(hash, list->strings + book->title);
+    hash = (hash ^ 0x1F) * 1099511628211ULL;
+    return filter_hash(hash, list->strings + book->author);
+}
+
+/* Fold a book's title and author into " title\n author" (no author, no
+ * second line); a book titled by its file is matched without the extension
+ * @param out: FILTER_TEXT_MAX bytes
+ * @return: Length of the text
+ */
+static size_t filter_book_text(const book_list_t *list, int record, char *out) {
+    const book_record_t *book = &list->records[record];
+    const char *filename = list->strings + book->filename;
+    const char *title = list->strings + book->title;
+    const char *author = list->strings + book->author;
+    char name[MAX_FILENAME_LENGTH];
+    size_t length = 0;
+
+    if (book->title >= book->filename && book->title < book->filename + strlen(filename)) {
+        snprintf(name, sizeof(name), "%s", title);
+        char *extension = strrchr(name, '.');
+        if (extension && extension != name) {
+            *extension = '\0';
+        }
+        title = name;
+    }
+
+    out[length++] = ' ';
+    length += collation_fold(title, out + length, FILTER_FIELD_MAX);
+    if (author[0] != '\0') {
+        out[length++] = '\n';
+        out[length++] = ' ';
+        length += collation_fold(author, out + length, FILTER_FIELD_MAX);
+    }
+    return length;
+}
+
+/* Code of the three bytes at p */
+static inline uint32_t gram_code(const char *p) {
+    return ((uint32_t)(unsigned char)p[0] << 16) | ((uint32_t)(unsigned char)p[1] << 8) |
+           (uint32_t)(unsigned char)p[2];
+}
+
+/* List the grams of a folded text: every three bytes within a line, and
+ * the first byte of every word after its space (the third byte 0)
+ * @param out: FILTER_GRAMS_MAX entries
+ * @return: Number of grams (repeats included)
+ */
+static int text_grams(const char *text, size_t length, uint32_t *out) {
+    int count = 0;
+
+    for (size_t i = 0; i + 1 < length; i++) {
+        if (text[i] == ' ' && text[i + 1] != '\n') {
+            out[count++] = ((uint32_t)' ' << 16) | ((uint32_t)(unsigned char)text[i + 1] << 8);
+        }
+        if (i + 2 < length && text[i] != '\n' && text[i + 1] != '\n' && text[i + 2] != '\n') {
+            out[count++] = gram_code(text + i);
+        }
+    }
+    return count;
+}
+
+/*
+ * Postings
+ * Docs in ascending order, each stored as its distance from the one before
+ * (from -1 for the first) in 7-bit groups, low first, the high bit set on
+ * all but the last group
+ */
+
+static int varint_length(uint32_t value) {
+    int length = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        length++;
+    }
+    return length;
+}
+
+static int varint_write(uint8_t *out, uint32_t value) {
+    int length = 0;
+    while (value >= 0x80) {
+        out[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[length++] = (uint8_t)value;
+    return length;
+}
+
+/* Read the next doc of postings
+ * @param doc: Previous doc on entry (UINT32_MAX before the first), next on return
+ * @return: false at the end (or on a damaged value)
+ */
+static inline bool postings_next(const uint8_t **p, const uint8_t *end, uint32_t *doc) {
+    uint32_t delta = 0;
+
+    for (int shift = 0; *p < end && shift <= 28; shift += 7) {
+        uint8_t byte = *(*p)++;
+        delta |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *doc += delta;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Decode postings into docs (below doc_count)
+ * @return: Number of docs
+ */
+static int postings_decode(const uint8_t *p, const uint8_t *end, uint32_t doc_count, int *out) {
+    uint32_t doc = UINT32_MAX;
+    int count = 0;
+
+    while (postings_next(&p, end, &doc) && doc < doc_count) {
+        out[count++] = (int)doc;
+    }
+    return count;
+}
+
+/* Keep the docs (ascending) that also appear in postings
+ * @return: Number kept
+ */
+static int postings_intersect(int *docs, int count, const uint8_t *p, const uint8_t *end) {
+    uint32_t doc = UINT32_MAX;
+    int kept = 0;
+    int i = 0;
+
+    while (i < count && postings_next(&p, end, &doc)) {
+        while (i < count && (uint32_t)docs[i] < doc) {
+            i++;
+        }
+        if (i < count && (uint32_t)docs[i] == doc) {
+            docs[kept++] = docs[i++];
+        }
+    }
+    return kept;
+}
+
+/*
+ * Index Layout
+ */
+
+/* Point a filter at an index in file layout and check its sections
+ * @return: true if the layout is sound
+ */
+static bool filter_attach(library_filter_t *filter, char *data, size_t size) {
+    const filter_header_t *header = (const filter_header_t *)data;
+
+    if (size < sizeof(filter_header_t) ||
+        memcmp(header->magic, FILTER_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != FILTER_VERSION || header->doc_count > INT_MAX ||
+        header->text_size == 0) {
+        return false;
+    }
+
+    uint64_t docs_size = (uint64_t)header->doc_count * sizeof(filter_doc_t);
+    uint64_t grams_size = ((uint64_t)header->gram_count + 1) * sizeof(filter_gram_t);
+    if (sizeof(filter_header_t) + docs_size + grams_size +
+        header->postings_size + header->text_size != size) {
+        return false;
+    }
+
+    filter->data = data;
+    filter->data_size = size;
+    filter->header = header;
+    filter->docs = (const filter_doc_t *)(data + sizeof(filter_header_t));
+    filter->grams = (const filter_gram_t *)((const char *)filter->docs + docs_size);
+    filter->postings = (const uint8_t *)filter->grams + grams_size;
+    filter->texts = (const char *)filter->postings + header->postings_size;
+
+    /* Grams ascending, their postings in order and inside the section */
+    const filter_gram_t *grams = filter->grams;
+    if (grams[0].postings != 0 || grams[header->gram_count].postings != header->postings_size) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header->gram_count; i++) {
+        if (grams[i].postings > grams[i + 1].postings ||
+            (i > 0 && grams[i].gram <= grams[i - 1].gram)) {
+            return false;
+        }
+    }
+
+    /* Texts start inside the section, which ends with a terminator */
+    if (filter->texts[header->text_size - 1] != '\0') {
+        return false;
+    }
+    for (uint32_t i = 0; i < header->doc_count; i++) {
+        if (filter->docs[i].text >= header->text_size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Allocate the record and doc tables and the query scratch
+ * Every record and doc starts out unmatched. */
+static int filter_alloc_tables(library_filter_t *filter, int record_count) {
+    int doc_count = (int)filter->header->doc_count;
+
+    filter->doc_record = malloc((size_t)(doc_count > 0 ? doc_count : 1) * sizeof(int));
+    filter->candidates = malloc((size_t)(doc_count > 0 ? doc_count : 1) * sizeof(int));
+    filter->record_doc = malloc((size_t)(record_count > 0 ? record_count : 1) * sizeof(int));
+    if (!filter->doc_record || !filter->candidates || !filter->record_doc) {
+        return BOOK_ERROR_OUT_OF_MEMORY;
+    }
+
+    memset(filter->doc_record, 0xFF, (size_t)doc_count * sizeof(int));
+    memset(filter->record_doc, 0xFF, (size_t)record_count * sizeof(int));
+    filter->record_count = record_count;
+    filter->covered = 0;
+    return BOOK_SUCCESS;
+}
+
+/* Find a gram (NULL if no book has it) */
+static const filter_gram_t* filter_find_gram(const library_filter_t *filter, uint32_t gram) {
+    int low = 0, high = (int)filter->header->gram_count - 1;
+
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        if (filter->grams[mid].gram == gram) {
+            return &filter->grams[mid];
+        }
+        if (filter->grams[mid].gram < gram) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Building
+ */
+
+/* Find a gram's slot, adding it if new (NULL if out of memory) */
+static gram_slot_t* gram_table_get(gram_table_t *table, uint32_t gram) {
+    size_t slot = (gram * 2654435761u) & table->mask;
+    while (table->slots[slot].gram != 0) {
+        if (table->slots[slot].gram == gram) {
+            return &table->slots[slot];
+        }
+        slot = (slot + 1) & table->mask;
+    }
+
+    /* Keep the table at most 3/4 full so probe runs stay short */
+    if ((table->used + 1) * 4 > (table->mask + 1) * 3) {
+        size_t slots = (table->mask + 1) * 2;
+        gram_slot_t *grown = calloc(slots, sizeof(gram_slot_t));
+        if (!grown) {
+            return NULL;
+        }
+        for (size_t i = 0; i <= table->mask; i++) {
+            if (table->slots[i].gram != 0) {
+                size_t to = (table->slots[i].gram * 2654435761u) & (slots - 1);
+                while (grown[to].gram != 0) {
+                    to = (to + 1) & (slots - 1);
+                }
+                grown[to] = table->slots[i];
+            }
+        }
+        free(table->slots);
+        table->slots = grown;
+        table->mask = slots - 1;
+
+        slot = (gram * 2654435761u) & table->mask;
+        while (table->slots[slot].gram != 0) {
+            slot = (slot + 1) & table->mask;
+        }
+    }
+
+    table->slots[slot].gram = gram;
+    table->slots[slot].last = -1;
+    table->used++;
+    return &table->slots[slot];
+}
+
+/* Compare function for qsort - (gram << 32 | slot) pairs */
+static int compare_grams(const void *a, const void *b) {
+    uint64_t ga = *(const uint64_t *)a;
+    uint64_t gb = *(const uint64_t *)b;
+    return (ga > gb) - (ga < gb);
+}
+
+/* Build the index of every book of a list (NULL if out of memory) */
+static library_filter_t* filter_build(const book_list_t *list) {
+    int count = list->count;
+    uint32_t grams[FILTER_GRAMS_MAX];
+    gram_table_t table = { NULL, 4095, 0 };
+    uint32_t *text_offsets = malloc((size_t)(count > 0 ? count : 1) * sizeof(uint32_t));
+    size_t text_size = 1;  /* Offset 0 is the empty text */
+    size_t text_capacity = 4096;
+    char *texts = malloc(text_capacity);
+    uint64_t *sorted = NULL;
+    library_filter_t *filter = NULL;
+    char *data = NULL;
+
+    table.slots = calloc(table.mask + 1, sizeof(gram_slot_t));
+    if (!text_offsets || !texts || !table.slots) {
+        goto fail;
+    }
+    texts[0] = '\0';
+
+    /* Fold every book and count the postings of each gram */
+    for (int doc = 0; doc < count; doc++) {
+        if (text_size + FILTER_TEXT_MAX > text_capacity) {
+            char *grown = realloc(texts, text_capacity * 2);
+            if (!grown) {
+                goto fail;
+            }
+            texts = grown;
+            text_capacity *= 2;
+        }
+
+        size_t length = filter_book_text(list, doc, texts + text_size);
+        int gram_count = text_grams(texts + text_size, length, grams);
+        text_offsets[doc] = (uint32_t)text_size;
+        text_size += length + 1;
+
+        for (int i = 0; i < gram_count; i++) {
+            gram_slot_t *slot = gram_table_get(&table, grams[i]);
+            if (!slot) {
+                goto fail;
+            }
+            if (slot->last != doc) {
+                slot->size += (uint32_t)varint_length((uint32_t)(doc - slot->last));
+                slot->last = doc;
+            }
+        }
+    }
+    if (text_size > UINT32_MAX) {
+        goto fail;
+    }
+
+    /* Lay the grams out in ascending order */
+    sorted = malloc((table.used > 0 ? table.used : 1) * sizeof(uint64_t));
+    if (!sorted) {
+        goto fail;
+    }
+    size_t gram_count = 0;
+    for (size_t i = 0; i <= table.mask; i++) {
+        if (table.slots[i].gram != 0) {
+            sorted[gram_count++] = ((uint64_t)table.slots[i].gram << 32) | i;
+        }
+    }
+    qsort(sorted, gram_count, sizeof(uint64_t), compare_grams);
+
+    uint64_t postings_size = 0;
+    for (size_t i = 0; i < gram_count; i++) {
+        gram_slot_t *slot = &table.slots[(uint32_t)sorted[i]];
+        slot->cursor = (uint32_t)postings_size;
+        slot->last = -1;
+        postings_size += slot->size;
+        if (postings_size > UINT32_MAX) {
+            goto fail;
+        }
+    }
+
+    size_t docs_size = (size_t)count * sizeof(filter_doc_t);
+    size_t grams_size = (gram_count + 1) * sizeof(filter_gram_t);
+    size_t size = sizeof(filter_header_t) + docs_size + grams_size + postings_size + text_size;
+    data = malloc(size);
+    filter = calloc(1, sizeof(library_filter_t));
+    if (!data || !filter) {
+        goto fail;
+    }
+
+    filter_header_t *header = (filter_header_t *)data;
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, FILTER_MAGIC, sizeof(header->magic));
+    header->version = FILTER_VERSION;
+    header->doc_count = (uint32_t)count;
+    header->gram_count = (uint32_t)gram_count;
+    header->postings_size = (uint32_t)postings_size;
+    header->text_size = (uint32_t)text_size;
+
+    filter_doc_t *docs = (filter_doc_t *)(data + sizeof(filter_header_t));
+    filter_gram_t *gram_table = (filter_gram_t *)((char *)docs + docs_size);
+    uint8_t *postings = (uint8_t *)gram_table + grams_size;
+    for (int doc = 0; doc < count; doc++) {
+        docs[doc].key = filter_book_key(list, doc);
+        docs[doc].text = text_offsets[doc];
+        docs[doc].reserved = 0;
+    }
+    for (size_t i = 0; i < gram_count; i++) {
+        gram_table[i].gram = (uint32_t)(sorted[i] >> 32);
+        gram_table[i].postings = table.slots[(uint32_t)sorted[i]].cursor;
+    }
+    gram_table[gram_count].gram = 0;
+    gram_table[gram_count].postings = (uint32_t)postings_size;
+    memcpy(postings + postings_size, texts, text_size);
+
+    /* Write the postings, each doc once per gram */
+    for (int doc = 0; doc < count; doc++) {
+        const char *text = texts + text_offsets[doc];
+        int text_gram_count = text_grams(text, strlen(text), grams);
+        for (int i = 0; i < text_gram_count; i++) {
+            gram_slot_t *slot = gram_table_get(&table, grams[i]);
+            if (slot->last != doc) {
+                slot->cursor += (uint32_t)varint_write(postings + slot->cursor,
+                                                       (uint32_t)(doc - slot->last));
+                slot->last = doc;
+            }
+        }
+    }
+
+    if (!filter_attach(filter, data, size) || filter_alloc_tables(filter, count) != BOOK_SUCCESS) {
+        goto fail;
+    }
+    for (int doc = 0; doc < count; doc++) {
+        filter->doc_record[doc] = doc;
+        filter->record_doc[doc] = doc;
+    }
+    filter->covered = count;
+
+    free(sorted);
+    free(table.slots);
+    free(texts);
+    free(text_offsets);
+    return filter;
+
+fail:
+    fprintf(stderr, "library_filter: Out of memory building the index\n");
+    if (filter) {
+        filter->data = data;
+        library_filter_free(filter);
+    } else {
+        free(data);
+    }
+    free(sorted);
+    free(table.slots);
+    free(texts);
+    free(text_offsets);
+    return NULL;
+}
+
+/*
+ * Persistence
+ */
+
+/* Write an index to LIBRARY_FILTER_FILE, replacing the old one in a single rename */
+static void filter_save(const library_filter_t *filter) {
+    char temp_path[MAX_BOOK_PATH + 8];
+    FILE *f;
+
+    /* Create directory if it doesn't exist */
+    char dir[MAX_BOOK_PATH];
+    strncpy(dir, LIBRARY_FILTER_FILE, MAX_BOOK_PATH - 1);
+    dir[MAX_BOOK_PATH - 1] = '\0';
+    char *last_slash = strrchr(dir, '/');
+    if (last_slash) {
+        *last_slash = '\0';
+        mkdir(dir, 0755);
+    }
+
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", LIBRARY_FILTER_FILE);
+    f = fopen(temp_path, "wb");
+    if (!f) {
+        fprintf(stderr, "library_filter: Failed to open %s: %s\n", temp_path, strerror(errno));
+        return;
+    }
+
+    size_t written = fwrite(filter->data, 1, filter->data_size, f);
+    if (fclose(f) != 0 || written != filter->data_size || rename(temp_path, LIBRARY_FILTER_FILE) != 0) {
+        fprintf(stderr, "library_filter: Failed to write %s: %s\n",
+                LIBRARY_FILTER_FILE, strerror(errno));
+        unlink(temp_path);
+    }
+}
+
+/* Map LIBRARY_FILTER_FILE and match its docs to the list's records by key
+ * (NULL if there is no usable index) */
+static library_filter_t* filter_load(const book_list_t *list) {
+    struct stat st;
+
+    int fd = open(LIBRARY_FILTER_FILE, O_RDONLY);
+    if (fd < 0) {
+        if (errno != ENOENT) {
+            fprintf(stderr, "library_filter: Failed to open %s: %s\n",
+                    LIBRARY_FILTER_FILE, strerror(errno));
+        }
+        return NULL;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    char *map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+
+    library_filter_t *filter = calloc(1, sizeof(library_filter_t));
+    if (!filter) {
+        munmap(map, size);
+        return NULL;
+    }
+    filter->mapped = true;
+    if (!filter_attach(filter, map, size)) {
+        fprintf(stderr, "library_filter: Discarding damaged index %s\n", LIBRARY_FILTER_FILE);
+        filter->data = map;
+        filter->data_size = size;
+        library_filter_free(filter);
+        return NULL;
+    }
+
+    /* Docs by key, in an open-addressing table of doc numbers */
+    int doc_count = (int)filter->header->doc_count;
+    size_t slots = 64;
+    while (slots < (size_t)doc_count * 2) {
+        slots *= 2;
+    }
+    int *table = malloc(slots * sizeof(int));
+    if (!table || filter_alloc_tables(filter, list->count) != BOOK_SUCCESS) {
+        free(table);
+        library_filter_free(filter);
+        return NULL;
+    }
+    memset(table, 0xFF, slots * sizeof(int));
+    for (int doc = 0; doc < doc_count; doc++) {
+        size_t slot = (size_t)filter->docs[doc].key & (slots - 1);
+        while (table[slot] >= 0) {
+            slot = (slot + 1) & (slots - 1);
+        }
+        table[slot] = doc;
+    }
+
+    for (int record = 0; record < list->count; record++) {
+        uint64_t key = filter_book_key(list, record);
+        for (size_t slot = (size_t)key & (slots - 1); table[slot] >= 0; slot = (slot + 1) & (slots - 1)) {
+            int doc = table[slot];
+            if (filter->docs[doc].key == key && filter->doc_record[doc] < 0) {
+                filter->doc_record[doc] = record;
+                filter->record_doc[record] = doc;
+                filter->covered++;
+                break;
+            }
+        }
+    }
+    free(table);
+    return filter;
+}
+
+/* Books outside the index plus docs no longer in the list */
+static int filter_changed(const library_filter_t *filter, int record_count) {
+    return (record_count - filter->covered) + ((int)filter->header->doc_count - filter->covered);
+}
+
+/*
+ * Matching
+ */
+
+/* Split a query into the patterns a book's text must contain: each folded
+ * word after a space, so that it matches the start of a word
+ * @return: Number of patterns
+ */
+static int query_patterns(const char *query, char patterns[][LIBRARY_FILTER_QUERY_MAX + 1]) {
+    char folded[LIBRARY_FILTER_QUERY_MAX];
+    int count = 0;
+
+    collation_fold(query, folded, sizeof(folded));
+    for (char *word = strtok(folded, " "); word && count < FILTER_WORDS_MAX; word = strtok(NULL, " ")) {
+        snprintf(patterns[count++], LIBRARY_FILTER_QUERY_MAX + 1, " %s", word);
+    }
+    return count;
+}
+
+/* Whether a folded text contains every pattern */
+static bool text_matches(const char *text, char patterns[][LIBRARY_FILTER_QUERY_MAX + 1], int count) {
+    for (int i = 0; i < count; i++) {
+        if (!strstr(text, patterns[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Match one record, from its doc if it has one and its own text if not */
+static bool filter_match_record(const book_list_t *list, int record,
+                                char patterns[][LIBRARY_FILTER_QUERY_MAX + 1], int count) {
+    const library_filter_t *filter = list->filter;
+    char text[FILTER_TEXT_MAX];
+
+    int doc = (filter && record < filter->record_count) ? filter->record_doc[record] : -1;
+    if (doc >= 0) {
+        return text_matches(filter->texts + filter->docs[doc].text, patterns, count);
+    }
+    filter_book_text(list, record, text);
+    return text_matches(text, patterns, count);
+}
+
+/* Make room in the scratch arrays for a list's records */
+static bool filter_reserve(library_filter_t *filter, int record_count) {
+    if (record_count <= filter->scratch_capacity) {
+        return true;
+    }
+
+    int capacity = record_count + record_count / 4;
+    int *matches = realloc(filter->matches, (size_t)capacity * sizeof(int));
+    if (matches) {
+        filter->matches = matches;
+    }
+    uint32_t *marks = realloc(filter->marks, (size_t)(capacity + 31) / 32 * sizeof(uint32_t));
+    if (marks) {
+        filter->marks = marks;
+    }
+    if (!matches || !marks) {
+        return false;
+    }
+    filter->scratch_capacity = capacity;
+    return true;
+}
+
+/* Find the records of docs that contain every pattern
+ * Each pattern contributes the postings of its rarest gram; the docs in
+ * all of them are checked against the patterns unless those grams are the
+ * patterns themselves.
+ * @param out: Matching records
+ * @return: Number of records
+ */
+static int filter_match_docs(library_filter_t *filter,
+                             char patterns[][LIBRARY_FILTER_QUERY_MAX + 1], int count, int *out) {
+    const uint8_t *starts[FILTER_WORDS_MAX];
+    const uint8_t *ends[FILTER_WORDS_MAX];
+    bool exact = true;
+
+    for (int i = 0; i < count; i++) {
+        const char *pattern = patterns[i];
+        size_t length = strlen(pattern);
+        const filter_gram_t *rarest = NULL;
+
+        if (length == 2) {
+            /* Space and one byte: the word's first letter */
+            rarest = filter_find_gram(filter, gram_code(pattern) & ~0xFFu);
+        }
+        for (size_t j = 0; j + 3 <= length; j++) {
+            const filter_gram_t *gram = filter_find_gram(filter, gram_code(pattern + j));
+            if (!gram) {
+                return 0;  /* No doc has it */
+            }
+            if (!rarest || gram[1].postings - gram[0].postings < rarest[1].postings - rarest[0].postings) {
+                rarest = gram;
+            }
+        }
+        if (!rarest) {
+            return 0;
+        }
+        exact = exact && length <= 3;
+
+        /* Keep the postings sorted by size, smallest first */
+        int j = i;
+        while (j > 0 && ends[j - 1] - starts[j - 1] > (ptrdiff_t)(rarest[1].postings - rarest[0].postings)) {
+            starts[j] = starts[j - 1];
+            ends[j] = ends[j - 1];
+            j--;
+        }
+        starts[j] = filter->postings + rarest[0].postings;
+        ends[j] = filter->postings + rarest[1].postings;
+    }
+
+    int found = postings_decode(starts[0], ends[0], filter->header->doc_count, filter->candidates);
+    for (int i = 1; i < count && found > 0; i++) {
+        found = postings_intersect(filter->candidates, found, starts[i], ends[i]);
+    }
+
+    int matched = 0;
+    for (int i = 0; i < found; i++) {
+        int doc = filter->candidates[i];
+        int record = filter->doc_record[doc];
+        if (record >= 0 &&
+            (exact || text_matches(filter->texts + filter->docs[doc].text, patterns, count))) {
+            out[matched++] = record;
+        }
+    }
+    return matched;
+}
+
+/* Compare function for qsort - list positions */
+static int compare_positions(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+/*
+ * Public Functions
+ */
+
+library_filter_t* library_filter_open(const book_list_t *list) {
+    if (!list) {
+        return NULL;
+    }
+
+    library_filter_t *filter = filter_load(list);
+    if (filter && filter_changed(filter, list->count) <= LIBRARY_FILTER_REBUILD) {
+        return filter;
+    }
+    library_filter_free(filter);
+
+    filter = filter_build(list);
+    if (filter) {
+        filter_save(filter);
+    }
+    return filter;
+}
+
+void library_filter_free(library_filter_t *filter) {
+    if (!filter) {
+        return;
+    }
+
+    if (filter->mapped) {
+        munmap(filter->data, filter->data_size);
+    } else {
+        free(filter->data);
+    }
+    free(filter->doc_record);
+    free(filter->record_doc);
+    free(filter->candidates);
+    free(filter->matches);
+    free(filter->marks);
+    free(filter);
+}
+
+void library_filter_refresh(book_list_t *list) {
+    if (!list || (list->filter && filter_changed(list->filter, list->count) <= LIBRARY_FILTER_REBUILD)) {
+        return;
+    }
+
+    library_filter_t *filter = filter_build(list);
+    if (filter) {
+        library_filter_free(list->filter);
+        list->filter = filter;
+        filter_save(filter);
+    }
+}
+
+void library_filter_book_changed(library_filter_t *filter, int record) {
+    if (!filter || record < 0 || record >= filter->record_count) {
+        return;
+    }
+
+    int doc = filter->record_doc[record];
+    if (doc >= 0) {
+        filter->doc_record[doc] = -1;
+        filter->record_doc[record] = -1;
+        filter->covered--;
+    }
+}
+
+void library_filter_book_removed(library_filter_t *filter, int record, int last) {
+    if (!filter || record < 0 || record >= filter->record_count) {
+        return;
+    }
+
+    library_filter_book_changed(filter, record);
+    if (last != record && last < filter->record_count) {
+        int doc = filter->record_doc[last];
+        filter->record_doc[record] = doc;
+        filter->record_doc[last] = -1;
+        if (doc >= 0) {
+            filter->doc_record[doc] = record;
+        }
+    }
+}
+
+int library_filter_query(book_list_t *list, const char *query,
+                         const int *within, int within_count, int *out) {
+    char patterns[FILTER_WORDS_MAX][LIBRARY_FILTER_QUERY_MAX + 1];
+    int found = 0;
+
+    if (!list || !out) {
+        return 0;
+    }
+
+    int count = query ? query_patterns(query, patterns) : 0;
+    if (count == 0) {
+        for (int i = 0; i < list->count; i++) {
+            out[i] = i;
+        }
+        return list->count;
+    }
+
+    /* Few books to look among, or no index: check each one */
+    library_filter_t *filter = list->filter;
+    if (!filter || (within && within_count <= LIBRARY_FILTER_DIRECT_MAX) ||
+        !filter_reserve(filter, list->count)) {
+        int total = within ? within_count : list->count;
+        for (int i = 0; i < total; i++) {
+            int index = within ? within[i] : i;
+            if (index >= 0 && index < list->count &&
+                filter_match_record(list, list->order[index], patterns, count)) {
+                out[found++] = index;
+            }
+        }
+        return found;
+    }
+
+    /* Books in the index by their postings, the others by their text */
+    int *matches = filter->matches;
+    int matched = filter_match_docs(filter, patterns, count, matches);
+    int indexed = list->count < filter->record_count ? list->count : filter->record_count;
+    int loose = indexed - filter->covered;
+    for (int record = 0; record < indexed && loose > 0; record++) {
+        if (filter->record_doc[record] < 0) {
+            loose--;
+            if (filter_match_record(list, record, patterns, count)) {
+                matches[matched++] = record;
+            }
+        }
+    }
+    for (int record = indexed; record < list->count; record++) {
+        if (filter_match_record(list, record, patterns, count)) {
+            matches[matched++] = record;
+        }
+    }
+
+    /* Into list order: a few are looked up, many are picked out of the order */
+    if (matched < list->count / 32) {
+        for (int i = 0; i < matched; i++) {
+            int index = book_list_record_index(list, matches[i]);
+            if (index >= 0) {
+                out[found++] = index;
+            }
+        }
+        qsort(out, found, sizeof(int), compare_positions);
+        return found;
+    }
+
+    memset(filter->marks, 0, (size_t)(list->count + 31) / 32 * sizeof(uint32_t));
+    for (int i = 0; i < matched; i++) {
+        filter->marks[matches[i] / 32] |= 1u << (matches[i] % 32);
+    }
+    for (int index = 0; index < list->count; index++) {
+        int record = list->order[index];
+        if ((filter->marks[record / 32] >> (record % 32)) & 1u) {
+            out[found++] = index;
+        }
+    }
+    return found;
+}
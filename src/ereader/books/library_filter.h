@@ -0,0 +1,136 @@
+/*
+ * library_filter.h - Title and Author Filter Index
+ *
+ * Narrows the library to the books whose title or author contains what
+ * the reader typed, quickly enough to run on every keystroke. Titles and
+ * authors are folded as collation_fold() does (case, accents and
+ * punctuation ignored) and every three-byte run of the folded text is
+ * indexed, along with the first letter of each word:
+ *
+ *   header     magic, version, section sizes
+ *   docs       one per book: hash of its path, title and author, text offset
+ *   grams      trigram codes in ascending order, each with its postings offset
+ *   postings   per trigram, the books containing it as delta-coded varints
+ *   texts      folded " title\n author" of each book, NUL-terminated
+ *
+ * The index is built along with the library metadata and written to
+ * LIBRARY_FILTER_FILE, which the next scan maps back in when it still
+ * describes the books found. Books changed or added since are not in the
+ * index and are checked against each query directly until there are
+ * LIBRARY_FILTER_REBUILD of them, when the index is built again.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef LIBRARY_FILTER_H
+#define LIBRARY_FILTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "book_manager.h"
+
+#ifndef LIBRARY_FILTER_FILE
+#define LIBRARY_FILTER_FILE "/etc/ereader/library.flt"   /* Beside LIBRARY_INDEX_FILE */
+#endif
+
+#define LIBRARY_FILTER_QUERY_MAX   64     /* Longest query, terminator included */
+#define LIBRARY_FILTER_REBUILD     256    /* Books outside the index before it is rebuilt */
+#define LIBRARY_FILTER_DIRECT_MAX  2048   /* Previous matches checked one by one rather
+                                           * than through the postings */
+
+/*
+ * Filter index of a book list
+ * Docs are the books the index was built from; a book changed or added
+ * since has no doc and is matched from its text instead.
+ */
+typedef struct library_filter {
+    char *data;                      /* Index in file layout (mapped or allocated) */
+    size_t data_size;
+    bool mapped;                     /* data is a read-only mapping of LIBRARY_FILTER_FILE */
+    const struct filter_header *header;
+    const struct filter_doc *docs;
+    const struct filter_gram *grams;
+    const uint8_t *postings;
+    const char *texts;
+    int *doc_record;                 /* Record of each doc (-1 once it is gone or changed) */
+    int *record_doc;                 /* Doc of each record when built (-1 = none) */
+    int record_count;                /* Records record_doc covers */
+    int covered;                     /* Records that have a doc */
+    int *candidates;                 /* Scratch: docs of a query (doc_count) */
+    int *matches;                    /* Scratch: matching records */
+    uint32_t *marks;                 /* Scratch: matching records, one bit each */
+    int scratch_capacity;            /* Records matches and marks have room for */
+} library_filter_t;
+
+/**
+ * Set up the filter index of a freshly scanned list
+ * Maps LIBRARY_FILTER_FILE when it still covers all but a few of the
+ * books; otherwise builds the index and writes it.
+ * @param list: Scanned book list
+ * @return: Index, or NULL if out of memory (queries then check every book)
+ */
+library_filter_t* library_filter_open(const book_list_t *list);
+
+/**
+ * Free a filter index
+ * @param filter: Index (NULL is ignored)
+ */
+void library_filter_free(library_filter_t *filter);
+
+/**
+ * Rebuild and write the index if too many books changed since it was built
+ * @param list: Book list; list->filter is replaced
+ */
+void library_filter_refresh(book_list_t *list);
+
+/**
+ * Note that a record's title or author may have changed
+ * @param filter: Index (NULL is ignored)
+ * @param record: Record of the book
+ */
+void library_filter_book_changed(library_filter_t *filter, int record);
+
+/**
+ * Note that a record was removed and the last record moved into its slot
+ * @param filter: Index (NULL is ignored)
+ * @param record: Record removed
+ * @param last: Record moved into its slot (equal to record if none moved)
+ */
+void library_filter_book_removed(library_filter_t *filter, int record, int last);
+
+/**
+ * Find the books matching a query
+ * Every word of the folded query must start a word of the book's folded
+ * title or author ("jan aus" finds "Jane Austen"), so a longer query only
+ * ever narrows the matches. Results are list positions in the list's
+ * current order.
+ * @param list: Book list
+ * @param query: UTF-8 text typed by the reader
+ * @param within: List positions to look among (NULL for the whole list),
+ *                such as the matches of a shorter query this one extends
+ * @param within_count: Number of positions in within
+ * @param out: Room for list->count positions (may be within)
+ * @return: Number of matches (the whole list for an empty query)
+ */
+int library_filter_query(book_list_t *list, const char *query,
+                         const int *within, int within_count, int *out);
+
+#endif /* LIBRARY_FILTER_H */
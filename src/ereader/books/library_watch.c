@@ -0,0 +1,280 @@
+/*
+ * library_watch.c - Live Library Updates
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include "library_watch.h"
+#include "../formats/format_interface.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/inotify.h>
+
+/* A book is listed once its copy is closed or it is moved in; a new
+ * hard link only produces IN_CREATE. A folder's own removal or renaming
+ * ends its watch. */
+#define LIBRARY_WATCH_MASK (IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | \
+                            IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR)
+
+/*
+ * Internal helpers
+ */
+
+/* Watch one folder, then the subfolders the scan would descend into */
+static void watch_add_tree(library_watch_t *watch, const char *relative, int depth) {
+    char dirpath[MAX_BOOK_PATH];
+    char child[MAX_FILENAME_LENGTH];
+
+    int length = relative[0] == '\0'
+        ? snprintf(dirpath, sizeof(dirpath), "%s", watch->books_dir)
+        : snprintf(dirpath, sizeof(dirpath), "%s/%s", watch->books_dir, relative);
+    if (length < 0 || (size_t)length >= sizeof(dirpath)) {
+        return;  /* Too long to be scanned */
+    }
+
+    if (watch->dir_count == watch->dir_capacity) {
+        int capacity = watch->dir_capacity ? watch->dir_capacity * 2 : 16;
+        library_watch_dir_t *dirs = realloc(watch->dirs, (size_t)capacity * sizeof(*dirs));
+        if (!dirs) {
+            fprintf(stderr, "library_watch: Out of memory watching %s\n", dirpath);
+            return;
+        }
+        watch->dirs = dirs;
+        watch->dir_capacity = capacity;
+    }
+
+    int wd = inotify_add_watch(watch->fd, dirpath, LIBRARY_WATCH_MASK);
+    if (wd < 0) {
+        fprintf(stderr, "library_watch: Cannot watch %s: %s\n", dirpath, strerror(errno));
+        return;
+    }
+    library_watch_dir_t *dir = &watch->dirs[watch->dir_count++];
+    dir->wd = wd;
+    strncpy(dir->path, relative, MAX_FILENAME_LENGTH - 1);
+    dir->path[MAX_FILENAME_LENGTH - 1] = '\0';
+
+    if (depth >= BOOK_SCAN_MAX_DEPTH) {
+        return;
+    }
+
+    /* Same folders as book_list_scan(): not hidden, not symlinked */
+    DIR *d = opendir(dirpath);
+    if (!d) {
+        return;
+    }
+    struct dirent *entry;
+    while ((entry = readdir(d)) != NULL) {
+        if (entry->d_name[0] == '.' || format_detect_type(entry->d_name) != BOOK_FORMAT_UNKNOWN) {
+            continue;
+        }
+        bool is_dir = (entry->d_type == DT_DIR);
+        if (entry->d_type == DT_UNKNOWN) {
+            struct stat st;
+            is_dir = fstatat(dirfd(d), entry->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0 &&
+                     S_ISDIR(st.st_mode);
+        }
+        length = relative[0] == '\0'
+            ? snprintf(child, sizeof(child), "%s", entry->d_name)
+            : snprintf(child, sizeof(child), "%s/%s", relative, entry->d_name);
+        if (is_dir && length > 0 && (size_t)length < sizeof(child)) {
+            watch_add_tree(watch, child, depth + 1);
+        }
+    }
+    closedir(d);
+}
+
+/* Drop every folder watch and watch the tree as it is now */
+static void watch_reset(library_watch_t *watch) {
+    for (int i = 0; i < watch->dir_count; i++) {
+        inotify_rm_watch(watch->fd, watch->dirs[i].wd);  /* Fails harmlessly if gone */
+    }
+    watch->dir_count = 0;
+    watch_add_tree(watch, "", 0);
+}
+
+/* Find a watched folder by its watch descriptor */
+static const library_watch_dir_t* watch_find_dir(const library_watch_t *watch, int wd) {
+    for (int i = 0; i < watch->dir_count; i++) {
+        if (watch->dirs[i].wd == wd) {
+            return &watch->dirs[i];
+        }
+    }
+    return NULL;
+}
+
+/* Note a changed file in a watched folder, once however many events it had */
+static void watch_mark(library_watch_t *watch, const library_watch_dir_t *dir, const char *name) {
+    char filename[MAX_FILENAME_LENGTH];
+
+    if (name[0] == '.' || format_detect_type(name) == BOOK_FORMAT_UNKNOWN) {
+        return;
+    }
+    int length = dir->path[0] == '\0'
+        ? snprintf(filename, sizeof(filename), "%s", name)
+        : snprintf(filename, sizeof(filename), "%s/%s", dir->path, name);
+    if (length < 0 || (size_t)length >= sizeof(filename)) {
+        return;  /* Too long to be listed */
+    }
+
+    for (int i = 0; i < watch->pending_count; i++) {
+        if (strcmp(watch->pending[i], filename) == 0) {
+            return;
+        }
+    }
+    memcpy(watch->pending[watch->pending_count], filename, (size_t)length + 1);
+    watch->pending_count++;
+}
+
+/* Bring each noted file's entry up to date with what is on disk now */
+static int watch_apply(library_watch_t *watch, book_list_t *list) {
+    int changes = 0;
+
+    for (int i = 0; i < watch->pending_count; i++) {
+        bool listed = book_list_find(list, watch->pending[i]) >= 0;
+        int result = book_list_update_file(list, watch->books_dir, watch->pending[i]);
+        if (result == BOOK_SUCCESS || (listed && result == BOOK_ERROR_NOT_FOUND)) {
+            changes++;
+        }
+    }
+    watch->pending_count = 0;
+    return changes;
+}
+
+/*
+ * Library Watch
+ */
+
+library_watch_t* library_watch_create(const char *books_dir) {
+    if (!books_dir) {
+        return NULL;
+    }
+
+    library_watch_t *watch = calloc(1, sizeof(library_watch_t));
+    if (!watch) {
+        fprintf(stderr, "library_watch_create: Failed to allocate watch\n");
+        return NULL;
+    }
+    strncpy(watch->books_dir, books_dir, MAX_BOOK_PATH - 1);
+
+    watch->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watch->fd < 0) {
+        fprintf(stderr, "library_watch_create: inotify unavailable: %s\n", strerror(errno));
+        free(watch);
+        return NULL;
+    }
+
+    watch_add_tree(watch, "", 0);
+    if (watch->dir_count == 0) {
+        close(watch->fd);
+        free(watch->dirs);
+        free(watch);
+        return NULL;
+    }
+
+    return watch;
+}
+
+void library_watch_free(library_watch_t *watch) {
+    if (watch) {
+        close(watch->fd);
+        free(watch->dirs);
+        free(watch);
+    }
+}
+
+int library_watch_get_fd(const library_watch_t *watch) {
+    return watch ? watch->fd : -1;
+}
+
+int library_watch_process(library_watch_t *watch, book_list_t *list) {
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    bool rescan = false;
+    int changes = 0;
+
+    if (!watch || !list) {
+        return 0;
+    }
+
+    for (;;) {
+        ssize_t length = read(watch->fd, buffer, sizeof(buffer));
+        if (length < 0 && errno == EINTR) {
+            continue;
+        }
+        if (length <= 0) {
+            if (length < 0 && errno != EAGAIN) {
+                fprintf(stderr, "library_watch_process: read failed: %s\n", strerror(errno));
+            }
+            break;
+        }
+
+        const struct inotify_event *event;
+        for (char *p = buffer; p < buffer + length; p += sizeof(struct inotify_event) + event->len) {
+            event = (const struct inotify_event *)p;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                /* Events were lost: only a scan can tell what changed */
+                rescan = true;
+                continue;
+            }
+
+            /* Events of watches dropped by an earlier reset are stale */
+            const library_watch_dir_t *dir = watch_find_dir(watch, event->wd);
+            if (!dir) {
+                continue;
+            }
+
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                /* A watched folder is gone or moved */
+                rescan = true;
+            } else if (event->len > 0 && (event->mask & IN_ISDIR)) {
+                /* A folder came or went, perhaps with books in it */
+                if (event->name[0] != '.') {
+                    rescan = true;
+                }
+            } else if (event->len > 0) {
+                watch_mark(watch, dir, event->name);
+                if (watch->pending_count == LIBRARY_WATCH_MAX_PENDING) {
+                    changes += watch_apply(watch, list);
+                }
+            }
+        }
+    }
+
+    if (rescan) {
+        watch->pending_count = 0;
+        watch_reset(watch);
+        /* The scan takes unchanged books from the index and rewrites it */
+        book_list_scan(list, watch->books_dir, NULL);
+        return 1;
+    }
+
+    changes += watch_apply(watch, list);
+    if (changes > 0) {
+        book_list_save_index(list);
+    }
+    return changes;
+}
@@ -0,0 +1,96 @@
+/*
+ * library_watch.h - Live Library Updates
+ *
+ * Watches the books directory with inotify so the book list follows
+ * files being copied, deleted or renamed while the device runs. Each
+ * change touches only the affected book: copying one book onto a
+ * library of thousands opens that one book and nothing else. The
+ * descriptor is polled by the main loop alongside the buttons.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef LIBRARY_WATCH_H
+#define LIBRARY_WATCH_H
+
+#include "book_manager.h"
+
+/* Distinct files collected from one read of events before they are applied */
+#define LIBRARY_WATCH_MAX_PENDING 64
+
+/*
+ * Watched folder (books_dir and each subfolder the scan descends into)
+ */
+typedef struct {
+    int wd;                          /* inotify watch */
+    char path[MAX_FILENAME_LENGTH];  /* Folder below books_dir ("" for books_dir) */
+} library_watch_dir_t;
+
+/*
+ * Library Watch
+ */
+typedef struct {
+    int fd;                          /* inotify descriptor */
+    char books_dir[MAX_BOOK_PATH];   /* Directory being watched */
+    library_watch_dir_t *dirs;       /* Watched folders, books_dir first (none once it is gone) */
+    int dir_count;
+    int dir_capacity;
+    char pending[LIBRARY_WATCH_MAX_PENDING][MAX_FILENAME_LENGTH];  /* Files to update */
+    int pending_count;
+} library_watch_t;
+
+/**
+ * Start watching a books directory and its subfolders
+ * @param books_dir: Directory to watch
+ * @return: Watch, or NULL if inotify is unavailable (the library then only
+ *          changes on a rescan)
+ * @note: Caller must free with library_watch_free()
+ */
+library_watch_t* library_watch_create(const char *books_dir);
+
+/**
+ * Stop watching and free the watch
+ * @param watch: Watch (NULL is ignored)
+ */
+void library_watch_free(library_watch_t *watch);
+
+/**
+ * Get the descriptor to poll; it is readable when changes are pending
+ * @param watch: Watch
+ * @return: File descriptor, or -1 if watch is NULL
+ */
+int library_watch_get_fd(const library_watch_t *watch);
+
+/**
+ * Apply pending changes to a book list
+ * Created, written, deleted and renamed files are passed to
+ * book_list_update_file() once each. If the event queue overflowed, or a
+ * folder was added, removed or replaced, the folders are watched afresh and
+ * the library rescanned instead. The library index is rewritten when
+ * anything changed.
+ * List positions, and strings got from the list, change when books are
+ * added or removed; callers keep a book by its filename.
+ * @param watch: Watch
+ * @param list: Book list to update
+ * @return: Number of files changed (a rescan counts as one; 0 if none)
+ */
+int library_watch_process(library_watch_t *watch, book_list_t *list);
+
+#endif /* LIBRARY_WATCH_H */
@@ -121,6 +121,7 @@ typedef struct {
     void *book_list;        /* book_list_t* from book_manager.h */
     void *current_book;     /* book_t* from book_manager.h */
     void *bookmarks;        /* bookmark_list_t* from book_manager.h */
+    void *library_watch;    /* library_watch_t* from library_watch.h (NULL if unavailable) */
 
     /* UI state */
     void *menu_state;       /* menu_state_t* from menu.h */
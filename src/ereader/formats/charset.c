@@ -0,0 +1,294 @@
+/*
+ * charset.c - Text Encoding Detection and Conversion Implementation
+ *
+ * Detection costs one word-at-a-time UTF-8 validation pass for UTF-8 and
+ * ASCII files, which then render straight from the file mapping. Only a
+ * file that fails validation is scanned again, byte by byte.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include "charset.h"
+#include "format_interface.h"
+#include "../rendering/utf8.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef unsigned long word_t;
+
+#define WORD_BYTES  sizeof(word_t)
+#define LOWS        ((word_t)-1 / 0xFF)           /* 0x0101...01 */
+#define HIGHS       (LOWS * 0x80)                 /* 0x8080...80 */
+
+/* Damaged UTF-8 still counts as UTF-8 with this many good sequences per bad byte */
+#define UTF8_MIN_GOOD_PER_BAD 4
+
+/*
+ * Detection
+ */
+
+/* Recognize BOM-less UTF-16 by the NUL half of each ASCII character */
+static int sniff_utf16(const unsigned char *p, size_t length, charset_t *out) {
+    size_t n = (length < CHARSET_UTF16_SNIFF ? length : CHARSET_UTF16_SNIFF) & ~(size_t)1;
+    size_t pairs = n / 2;
+    size_t even_zeros = 0, odd_zeros = 0;
+
+    if (pairs < 2) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < n; i += 2) {
+        even_zeros += (p[i] == 0);
+        odd_zeros += (p[i + 1] == 0);
+    }
+
+    if (odd_zeros * 2 >= pairs && even_zeros * 8 <= odd_zeros) {
+        *out = CHARSET_UTF16LE;
+        return 1;
+    }
+    if (even_zeros * 2 >= pairs && odd_zeros * 8 <= even_zeros) {
+        *out = CHARSET_UTF16BE;
+        return 1;
+    }
+    return 0;
+}
+
+charset_t charset_detect(const char *data, size_t length, size_t *bom_length) {
+    const unsigned char *p = (const unsigned char *)data;
+    charset_t charset;
+    size_t bom = 0;
+
+    /* Byte order marks */
+    if (length >= 3 && p[0] == 0xEF && p[1] == 0xBB && p[2] == 0xBF) {
+        bom = 3;
+        charset = CHARSET_UTF8;
+    } else if (length >= 2 && p[0] == 0xFF && p[1] == 0xFE) {
+        bom = 2;
+        charset = CHARSET_UTF16LE;
+    } else if (length >= 2 && p[0] == 0xFE && p[1] == 0xFF) {
+        bom = 2;
+        charset = CHARSET_UTF16BE;
+    } else if (!sniff_utf16(p, length, &charset)) {
+        charset = CHARSET_UTF8;
+
+        size_t i = utf8_valid_prefix(data, length);
+        if (i < length) {
+            /* Not clean UTF-8: weigh good sequences against bad bytes */
+            size_t good = 0, bad = 0, c1 = 0;
+
+            for (size_t j = 0; j < i; j++) {
+                good += (p[j] >= 0xC0);     /* Lead bytes of the valid prefix */
+            }
+
+            while (i < length) {
+                if (p[i] < 0x80) {
+                    i++;
+                    continue;
+                }
+                uint32_t cp;
+                size_t step = utf8_decode(data + i, length - i, &cp);
+                if (step > 1) {
+                    good++;
+                } else {
+                    bad++;
+                    c1 += (p[i] <= 0x9F);
+                }
+                i += step;
+            }
+
+            if (good < bad * UTF8_MIN_GOOD_PER_BAD) {
+                /* C1 controls never occur in Latin-1 text; in CP1252 they are punctuation */
+                charset = c1 ? CHARSET_CP1252 : CHARSET_LATIN1;
+            }
+        }
+    }
+
+    if (bom_length) {
+        *bom_length = bom;
+    }
+    return charset;
+}
+
+const char* charset_name(charset_t charset) {
+    switch (charset) {
+        case CHARSET_UTF8:
+            return "UTF-8";
+        case CHARSET_LATIN1:
+            return "ISO-8859-1";
+        case CHARSET_CP1252:
+            return "CP1252";
+        case CHARSET_UTF16LE:
+            return "UTF-16LE";
+        case CHARSET_UTF16BE:
+            return "UTF-16BE";
+        default:
+            return "Unknown";
+    }
+}
+
+/*
+ * Conversion
+ */
+
+/* Append one codepoint, or only count it when dst is NULL */
+static inline size_t emit(uint32_t cp, char *dst, size_t n) {
+    return dst ? utf8_encode(cp, dst + n) : utf8_encoded_length(cp);
+}
+
+static size_t convert_8bit(const unsigned char *p, size_t length, int cp1252, char *dst) {
+    size_t i = 0, n = 0;
+
+    while (i < length) {
+        /* Copy runs of ASCII (other than NUL) a word at a time */
+        for (; i + WORD_BYTES <= length; i += WORD_BYTES, n += WORD_BYTES) {
+            word_t w;
+            memcpy(&w, p + i, WORD_BYTES);
+            if ((w & HIGHS) || ((w - LOWS) & ~w & HIGHS)) break;
+            if (dst) memcpy(dst + n, &w, WORD_BYTES);
+        }
+        if (i == length) {
+            break;
+        }
+
+        unsigned char c = p[i++];
+        if (c == 0) {
+            continue;
+        }
+        uint32_t cp = cp1252 ? charset_decode_cp1252(c) : c;
+        n += emit(cp, dst, n);
+    }
+
+    return n;
+}
+
+static size_t convert_utf16(const unsigned char *p, size_t length, int big_endian, char *dst) {
+    size_t i = 0, n = 0;
+
+    while (i + 1 < length) {
+        uint32_t u = big_endian ? ((uint32_t)p[i] << 8 | p[i + 1])
+                                : ((uint32_t)p[i + 1] << 8 | p[i]);
+        i += 2;
+
+        if (u >= 0xD800 && u <= 0xDBFF && i + 1 < length) {
+            uint32_t lo = big_endian ? ((uint32_t)p[i] << 8 | p[i + 1])
+                                     : ((uint32_t)p[i + 1] << 8 | p[i]);
+            if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                u = 0x10000 + ((u - 0xD800) << 10) + (lo - 0xDC00);
+                i += 2;
+            }
+        }
+        if (u >= 0xD800 && u <= 0xDFFF) {
+            u = UTF8_REPLACEMENT;       /* Unpaired surrogate */
+        } else if (u == 0) {
+            continue;
+        }
+        n += emit(u, dst, n);
+    }
+
+    if (i < length) {
+        n += emit(UTF8_REPLACEMENT, dst, n);    /* Odd trailing byte */
+    }
+
+    return n;
+}
+
+size_t charset_to_utf8(charset_t charset, const char *src, size_t length, char *dst) {
+    const unsigned char *p = (const unsigned char *)src;
+
+    switch (charset) {
+        case CHARSET_LATIN1:
+            return convert_8bit(p, length, 0, dst);
+        case CHARSET_CP1252:
+            return convert_8bit(p, length, 1, dst);
+        case CHARSET_UTF16LE:
+            return convert_utf16(p, length, 0, dst);
+        case CHARSET_UTF16BE:
+            return convert_utf16(p, length, 1, dst);
+        case CHARSET_UTF8:
+        default:
+            if (dst) memcpy(dst, src, length);
+            return length;
+    }
+}
+
+/*
+ * Loading
+ */
+
+int charset_load_file(const char *filepath, charset_text_t *out) {
+    const char *map;
+    size_t length, map_size, bom;
+    int result;
+
+    if (!out) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+    memset(out, 0, sizeof(charset_text_t));
+
+    result = format_map_text(filepath, &map, &length, &map_size);
+    if (result != FORMAT_SUCCESS) {
+        return result;
+    }
+
+    out->charset = charset_detect(map, length, &bom);
+
+    if (out->charset == CHARSET_UTF8) {
+        /* Render straight from the mapping */
+        out->text = map + bom;
+        out->length = length - bom;
+        out->map = map;
+        out->map_size = map_size;
+    } else {
+        /* Conversion at most triples the size (one byte to U+0800-U+FFFF) */
+        if (length > (SIZE_MAX - 1) / 3) {
+            format_unmap_text(map, map_size);
+            return FORMAT_ERROR_TOO_LARGE;
+        }
+
+        size_t size = charset_to_utf8(out->charset, map + bom, length - bom, NULL);
+        out->buffer = malloc(size + 1);
+        if (!out->buffer) {
+            format_unmap_text(map, map_size);
+            return FORMAT_ERROR_OUT_OF_MEMORY;
+        }
+        charset_to_utf8(out->charset, map + bom, length - bom, out->buffer);
+        out->buffer[size] = '\0';
+        format_unmap_text(map, map_size);
+
+        out->text = out->buffer;
+        out->length = size;
+    }
+
+    if (out->length == 0) {
+        charset_text_free(out);
+        return FORMAT_ERROR_NO_CONTENT;
+    }
+
+    return FORMAT_SUCCESS;
+}
+
+void charset_text_free(charset_text_t *text) {
+    if (text) {
+        format_unmap_text(text->map, text->map_size);
+        free(text->buffer);
+        memset(text, 0, sizeof(charset_text_t));
+    }
+}
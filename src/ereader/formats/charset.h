@@ -0,0 +1,124 @@
+/*
+ * charset.h - Text Encoding Detection and Conversion
+ *
+ * Plain text books arrive as UTF-8, Latin-1, CP1252 or UTF-16. The
+ * renderer works in UTF-8, so text files are sniffed once at open time and
+ * converted only when they are not UTF-8 already.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef CHARSET_H
+#define CHARSET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Text Encodings
+ */
+typedef enum {
+    CHARSET_UTF8 = 0,          /* UTF-8 (includes plain ASCII) */
+    CHARSET_LATIN1,            /* ISO-8859-1 */
+    CHARSET_CP1252,            /* Windows-1252 */
+    CHARSET_UTF16LE,
+    CHARSET_UTF16BE
+} charset_t;
+
+/* Bytes sniffed for NUL patterns when a file has no UTF-16 BOM */
+#define CHARSET_UTF16_SNIFF 512
+
+/*
+ * Loaded Text
+ * UTF-8 text of a file, either mapped directly or converted into a buffer
+ */
+typedef struct {
+    const char *text;          /* UTF-8 text (null-terminated) */
+    size_t length;             /* Length of text in bytes */
+    charset_t charset;         /* Encoding the file was stored in */
+    const char *map;           /* File mapping (NULL once converted) */
+    size_t map_size;           /* Size of the file mapping */
+    char *buffer;              /* Converted text (NULL when text is mapped) */
+} charset_text_t;
+
+/**
+ * Detect the encoding of a byte range
+ * A BOM decides outright. Otherwise the range is validated as UTF-8 a
+ * word at a time; only text that is not UTF-8 is examined further, for
+ * the C1 bytes that tell CP1252 from Latin-1.
+ * @param data: Bytes to examine
+ * @param length: Number of bytes
+ * @param bom_length: Output length of the byte order mark (0 if none, may be NULL)
+ * @return: Detected encoding
+ */
+charset_t charset_detect(const char *data, size_t length, size_t *bom_length);
+
+/**
+ * Convert text to UTF-8
+ * Call once with dst NULL to size the output, then again to write it.
+ * Malformed input becomes U+FFFD; NUL characters are dropped.
+ * @param charset: Encoding of src (BOM already stripped)
+ * @param src: Text to convert
+ * @param length: Number of bytes in src
+ * @param dst: Output buffer, or NULL to measure only
+ * @return: Number of UTF-8 bytes (excluding any terminator)
+ */
+size_t charset_to_utf8(charset_t charset, const char *src, size_t length, char *dst);
+
+/**
+ * Decode one Windows-1252 byte
+ * @param c: Byte to decode
+ * @return: Unicode codepoint (U+FFFD for the five unassigned C1 bytes)
+ */
+static inline uint32_t charset_decode_cp1252(unsigned char c) {
+    /* 0x80-0x9F (the rest of the upper half matches Latin-1) */
+    static const uint16_t c1[32] = {
+        0x20AC, 0xFFFD, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+        0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0xFFFD, 0x017D, 0xFFFD,
+        0xFFFD, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+        0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0xFFFD, 0x017E, 0x0178
+    };
+    return (c >= 0x80 && c <= 0x9F) ? c1[c - 0x80] : c;
+}
+
+/**
+ * Get encoding name
+ * @param charset: Encoding
+ * @return: Name such as "UTF-8" or "CP1252"
+ */
+const char* charset_name(charset_t charset);
+
+/**
+ * Load a text file as UTF-8
+ * The file is mapped; UTF-8 files are used in place (minus any BOM), other
+ * encodings are converted into a heap buffer and the mapping released.
+ * @param filepath: Path to text file
+ * @param out: Output text (release with charset_text_free())
+ * @return: FORMAT_SUCCESS on success, format error code otherwise
+ */
+int charset_load_file(const char *filepath, charset_text_t *out);
+
+/**
+ * Release text loaded with charset_load_file()
+ * @param text: Loaded text (fields are cleared)
+ */
+void charset_text_free(charset_text_t *text);
+
+#endif /* CHARSET_H */
@@ -27,44 +27,23 @@
  */
 
 #include "epub_reader.h"
+#include "html_text.h"
+#include "text_cache.h"
 #include <stdlib.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <strings.h>
 #include <ctype.h>
+#include <sys/stat.h>
 #include <zip.h>
 #include <libxml/parser.h>
 #include <libxml/tree.h>
 #include <libxml/xpath.h>
+#include <libxml/xmlreader.h>
 
-/*
- * Internal Helper Structures
- */
-
-/* HTML entity mapping for common entities */
-typedef struct {
-    const char *entity;
-    const char *replacement;
-} html_entity_map_t;
-
-/* Common HTML entities we need to handle */
-static const html_entity_map_t html_entities[] = {
-    {"&amp;", "&"},
-    {"&lt;", "<"},
-    {"&gt;", ">"},
-    {"&quot;", "\""},
-    {"&#39;", "'"},
-    {"&apos;", "'"},
-    {"&nbsp;", " "},
-    {"&mdash;", "—"},
-    {"&ndash;", "–"},
-    {"&ldquo;", """},
-    {"&rdquo;", """},
-    {"&lsquo;", "'"},
-    {"&rsquo;", "'"},
-    {"&hellip;", "…"},
-    {NULL, NULL}
-};
+/* Bytes inflated per zip_fread() when streaming a chapter */
+#define EPUB_READ_CHUNK (16 * 1024)
 
 /*
  * Internal Helper Functions
@@ -118,105 +97,126 @@ static char* zip_read_file(zip_t *zip, const char *filename, size_t *out_size) {
     return buffer;
 }
 
-/* Strip HTML tags and extract text content */
-static int strip_html_tags(const char *html, size_t html_length,
-                          char **out_text, size_t *out_length) {
-    char *text;
-    size_t text_pos = 0;
-    size_t i = 0;
-    int in_tag = 0;
-    int in_script = 0;
-    int in_style = 0;
+/* Inflate a chapter chunk by chunk straight through the HTML converter */
+static int read_chapter_text(zip_t *zip, const char *href,
+                             char *out, size_t capacity, size_t *out_length) {
+    char buffer[EPUB_READ_CHUNK];
+    html_text_t converter;
+    zip_file_t *file;
+    zip_int64_t bytes_read;
 
-    /* Allocate output buffer (same size as input is maximum needed) */
-    text = malloc(html_length + 1);
-    if (!text) {
-        return EPUB_ERROR_OUT_OF_MEMORY;
+    file = zip_fopen(zip, href, 0);
+    if (!file) {
+        fprintf(stderr, "epub: Failed to open file in ZIP: %s\n", href);
+        return EPUB_ERROR_READ_FAILED;
     }
 
-    /* Parse HTML and extract text */
-    while (i < html_length) {
-        /* Check for <script> and <style> tags */
-        if (!in_tag && i + 8 < html_length) {
-            if (strncasecmp(&html[i], "<script", 7) == 0 &&
-                (html[i+7] == '>' || html[i+7] == ' ')) {
-                in_script = 1;
-                in_tag = 1;
-                i++;
-                continue;
-            }
-            if (strncasecmp(&html[i], "<style", 6) == 0 &&
-                (html[i+6] == '>' || html[i+6] == ' ')) {
-                in_style = 1;
-                in_tag = 1;
-                i++;
-                continue;
-            }
-        }
+    html_text_init(&converter, out, capacity);
+    while ((bytes_read = zip_fread(file, buffer, sizeof(buffer))) > 0) {
+        html_text_feed(&converter, buffer, (size_t)bytes_read);
+    }
+    zip_fclose(file);
 
-        /* Check for closing script/style tags */
-        if ((in_script || in_style) && i + 9 < html_length) {
-            if (in_script && strncasecmp(&html[i], "</script>", 9) == 0) {
-                in_script = 0;
-                i += 9;
-                continue;
-            }
-            if (in_style && strncasecmp(&html[i], "</style>", 8) == 0) {
-                in_style = 0;
-                i += 8;
-                continue;
-            }
-        }
+    *out_length = html_text_finish(&converter);
+    if (bytes_read < 0) {
+        fprintf(stderr, "epub: Read error in %s\n", href);
+        return EPUB_ERROR_READ_FAILED;
+    }
+    if (converter.truncated) {
+        fprintf(stderr, "epub: Text of %s cut short to %zu bytes\n", href, capacity);
+    }
 
-        /* Skip content inside script/style tags */
-        if (in_script || in_style) {
-            i++;
-            continue;
-        }
+    return EPUB_SUCCESS;
+}
 
-        /* Handle tag start */
-        if (html[i] == '<') {
-            in_tag = 1;
-
-            /* Add space before block-level tags for word separation */
-            if (i + 2 < html_length) {
-                if (html[i+1] == 'p' || html[i+1] == 'P' ||
-                    html[i+1] == 'h' || html[i+1] == 'H' ||
-                    (html[i+1] == 'b' && html[i+2] == 'r') ||
-                    (html[i+1] == 'd' && html[i+2] == 'i' && html[i+3] == 'v')) {
-                    if (text_pos > 0 && text[text_pos - 1] != '\n' && text[text_pos - 1] != ' ') {
-                        text[text_pos++] = '\n';
-                    }
-                }
-            }
-            i++;
+/* Give each chapter its span of the book text from the ZIP directory */
+static void epub_assign_spans(epub_book_t *book) {
+    zip_t *zip = (zip_t *)book->zip_handle;
+    size_t offset = 0;
+
+    for (int i = 0; i < book->chapter_count; i++) {
+        epub_chapter_t *chapter = &book->chapters[i];
+        zip_stat_t stat;
+
+        chapter->text_offset = offset;
+        chapter->text_span = 0;
+
+        if (chapter->href[0] == '\0' || zip_stat(zip, chapter->href, 0, &stat) != 0 ||
+            !(stat.valid & ZIP_STAT_SIZE)) {
+            fprintf(stderr, "epub: Skipping missing chapter %d (%s)\n", i, chapter->href);
             continue;
         }
-
-        /* Handle tag end */
-        if (html[i] == '>') {
-            in_tag = 0;
-            i++;
+        if (stat.size > EPUB_MAX_TEXT_SIZE) {
+            fprintf(stderr, "epub: Skipping oversized chapter %d (%s)\n", i, chapter->href);
             continue;
         }
 
-        /* Skip tag content */
-        if (in_tag) {
-            i++;
-            continue;
+        chapter->text_span = stat.size;
+        offset += chapter->text_span;
+    }
+
+    book->text_length = offset;
+}
+
+/* Reuse the book's text cache entry if its chunks still match the spans, or start one */
+static void epub_attach_text_cache(epub_book_t *book) {
+    text_cache_t *cache = text_cache_open(book->filepath);
+
+    if (cache && text_cache_chunk_count(cache) == book->chapter_count) {
+        int i;
+        for (i = 0; i < book->chapter_count; i++) {
+            if (text_cache_chunk_length(cache, i) != book->chapters[i].text_span) {
+                break;
+            }
         }
+        if (i == book->chapter_count) {
+            book->text_cache = cache;
+            return;
+        }
+    }
+    text_cache_close(cache);
 
-        /* Copy text content */
-        text[text_pos++] = html[i];
-        i++;
+    size_t *spans = malloc(book->chapter_count * sizeof(size_t));
+    if (!spans) {
+        return;
     }
+    for (int i = 0; i < book->chapter_count; i++) {
+        spans[i] = book->chapters[i].text_span;
+    }
+    book->text_cache = text_cache_create(book->filepath, spans, book->chapter_count);
+    free(spans);
+}
 
-    /* Null-terminate */
-    text[text_pos] = '\0';
+/* Free the loaded text of one chapter (mapped text just stays in the cache file) */
+static void epub_unload_chapter(epub_book_t *book, epub_chapter_t *chapter) {
+    if (chapter->text_mapped) {
+        chapter->text = NULL;
+        chapter->text_length = 0;
+        chapter->text_mapped = 0;
+    } else if (chapter->text) {
+        free(chapter->text);
+        chapter->text = NULL;
+        chapter->text_length = 0;
+        book->cache_bytes -= chapter->text_span;
+    }
+}
 
-    *out_text = text;
-    *out_length = text_pos;
-    return EPUB_SUCCESS;
+/* Unload least recently used chapters until incoming more bytes fit the budget */
+static void epub_cache_evict(epub_book_t *book, size_t incoming) {
+    while (book->cache_bytes + incoming > EPUB_CHAPTER_CACHE_SIZE) {
+        epub_chapter_t *oldest = NULL;
+        for (int i = 0; i < book->chapter_count; i++) {
+            epub_chapter_t *chapter = &book->chapters[i];
+            if (chapter->text && !chapter->text_mapped &&
+                (!oldest || chapter->last_used < oldest->last_used)) {
+                oldest = chapter;
+            }
+        }
+        if (!oldest) {
+            break;
+        }
+        epub_unload_chapter(book, oldest);
+    }
 }
 
 /*
@@ -271,6 +271,10 @@ int epub_is_epub_file(const char *filename) {
  * Core EPUB Functions Implementation
  */
 
+void epub_init(void) {
+    xmlInitParser();
+}
+
 int epub_validate(const char *filepath) {
     zip_t *zip;
     zip_error_t error;
@@ -350,10 +354,11 @@ int epub_parse_container(void *zip_handle, char *opf_path, size_t opf_path_size)
 
     if (xpath_obj && xpath_obj->nodesetval && xpath_obj->nodesetval->nodeNr > 0) {
         xmlNodePtr node = xpath_obj->nodesetval->nodeTab[0];
-        const char *path = (const char *)xmlNodeGetContent(node);
+        xmlChar *path = xmlNodeGetContent(node);
         if (path) {
-            strncpy(opf_path, path, opf_path_size - 1);
+            strncpy(opf_path, (const char *)path, opf_path_size - 1);
             opf_path[opf_path_size - 1] = '\0';
+            xmlFree(path);
             result = EPUB_SUCCESS;
         }
     }
@@ -373,100 +378,301 @@ int epub_parse_container(void *zip_handle, char *opf_path, size_t opf_path_size)
     return EPUB_SUCCESS;
 }
 
-int epub_parse_opf(void *zip_handle, const char *opf_path, epub_book_t *book) {
-    zip_t *zip = (zip_t *)zip_handle;
-    char *opf_xml;
-    size_t xml_size;
-    xmlDocPtr doc;
-    xmlXPathContextPtr xpath_ctx;
-    xmlXPathObjectPtr xpath_obj;
-    int result = EPUB_ERROR_PARSE_ERROR;
+/*
+ * OPF Package Parsing
+ *
+ * The OPF is read with libxml2's streaming reader straight out of the ZIP:
+ * one pass collects the metadata, the manifest (indexed by item ID in an
+ * open-addressing hash table) and the spine's idrefs, and no document tree
+ * is ever built. Metadata-only reads stop at </metadata>.
+ */
 
-    /* Read OPF file */
-    opf_xml = zip_read_file(zip, opf_path, &xml_size);
-    if (!opf_xml) {
-        return EPUB_ERROR_MISSING_OPF;
+#define OPF_NS_DC "http://purl.org/dc/elements/1.1/"
+
+/* Manifest item */
+typedef struct {
+    xmlChar *id;
+    xmlChar *href;
+    xmlChar *media_type;
+} opf_item_t;
+
+/* Manifest items, plus spine idrefs in reading order */
+typedef struct {
+    opf_item_t *items;
+    int item_count;
+    int item_capacity;
+    int *slots;                 /* Hash index: item index + 1, 0 = empty */
+    size_t slot_mask;           /* Slot count - 1 (a power of two) */
+    xmlChar **spine;
+    int spine_count;
+    int spine_capacity;
+} opf_package_t;
+
+static uint32_t opf_hash(const xmlChar *s) {
+    uint32_t h = 2166136261u;
+    while (*s) {
+        h ^= *s++;
+        h *= 16777619u;
     }
+    return h;
+}
 
-    /* Parse XML */
-    doc = xmlReadMemory(opf_xml, xml_size, opf_path, NULL, 0);
-    free(opf_xml);
+static void opf_package_free(opf_package_t *pkg) {
+    for (int i = 0; i < pkg->item_count; i++) {
+        xmlFree(pkg->items[i].id);
+        xmlFree(pkg->items[i].href);
+        xmlFree(pkg->items[i].media_type);
+    }
+    for (int i = 0; i < pkg->spine_count; i++) {
+        xmlFree(pkg->spine[i]);
+    }
+    free(pkg->items);
+    free(pkg->slots);
+    free(pkg->spine);
+}
 
-    if (!doc) {
-        fprintf(stderr, "epub_parse_opf: Failed to parse %s\n", opf_path);
-        return EPUB_ERROR_PARSE_ERROR;
+/* Build the ID index once every item is known (the first of duplicate IDs wins) */
+static int opf_index_manifest(opf_package_t *pkg) {
+    size_t slot_count = 16;
+    while (slot_count < (size_t)pkg->item_count * 2) {
+        slot_count *= 2;
     }
 
-    /* Create XPath context */
-    xpath_ctx = xmlXPathNewContext(doc);
-    if (!xpath_ctx) {
-        xmlFreeDoc(doc);
-        return EPUB_ERROR_PARSE_ERROR;
+    pkg->slots = calloc(slot_count, sizeof(int));
+    if (!pkg->slots) {
+        return EPUB_ERROR_OUT_OF_MEMORY;
     }
+    pkg->slot_mask = slot_count - 1;
 
-    /* Register OPF namespace */
-    xmlXPathRegisterNs(xpath_ctx, BAD_CAST "opf",
-                      BAD_CAST "http://www.idpf.org/2007/opf");
-    xmlXPathRegisterNs(xpath_ctx, BAD_CAST "dc",
-                      BAD_CAST "http://purl.org/dc/elements/1.1/");
+    for (int i = 0; i < pkg->item_count; i++) {
+        size_t slot = opf_hash(pkg->items[i].id) & pkg->slot_mask;
+        while (pkg->slots[slot] != 0) {
+            if (xmlStrEqual(pkg->items[pkg->slots[slot] - 1].id, pkg->items[i].id)) {
+                break;
+            }
+            slot = (slot + 1) & pkg->slot_mask;
+        }
+        if (pkg->slots[slot] == 0) {
+            pkg->slots[slot] = i + 1;
+        }
+    }
 
-    /* Extract metadata - title */
-    xpath_obj = xmlXPathEvalExpression(BAD_CAST "//dc:title", xpath_ctx);
-    if (xpath_obj && xpath_obj->nodesetval && xpath_obj->nodesetval->nodeNr > 0) {
-        xmlNodePtr node = xpath_obj->nodesetval->nodeTab[0];
-        xmlChar *content = xmlNodeGetContent(node);
-        if (content) {
-            strncpy(book->metadata.title, (const char *)content, 255);
-            book->metadata.title[255] = '\0';
-            xmlFree(content);
+    return EPUB_SUCCESS;
+}
+
+static const opf_item_t* opf_find_item(const opf_package_t *pkg, const xmlChar *id) {
+    size_t slot = opf_hash(id) & pkg->slot_mask;
+    while (pkg->slots[slot] != 0) {
+        const opf_item_t *item = &pkg->items[pkg->slots[slot] - 1];
+        if (xmlStrEqual(item->id, id)) {
+            return item;
         }
+        slot = (slot + 1) & pkg->slot_mask;
     }
-    if (xpath_obj) xmlXPathFreeObject(xpath_obj);
+    return NULL;
+}
 
-    /* Extract metadata - author */
-    xpath_obj = xmlXPathEvalExpression(BAD_CAST "//dc:creator", xpath_ctx);
-    if (xpath_obj && xpath_obj->nodesetval && xpath_obj->nodesetval->nodeNr > 0) {
-        xmlNodePtr node = xpath_obj->nodesetval->nodeTab[0];
-        xmlChar *content = xmlNodeGetContent(node);
-        if (content) {
-            strncpy(book->metadata.author, (const char *)content, 255);
-            book->metadata.author[255] = '\0';
-            xmlFree(content);
+/* Add a manifest item; takes ownership of the attribute strings */
+static int opf_add_item(opf_package_t *pkg, xmlChar *id, xmlChar *href, xmlChar *media_type) {
+    if (!id || !href) {
+        xmlFree(id);
+        xmlFree(href);
+        xmlFree(media_type);
+        return EPUB_SUCCESS;        /* Not a usable item */
+    }
+
+    if (pkg->item_count == pkg->item_capacity) {
+        int capacity = pkg->item_capacity ? pkg->item_capacity * 2 : 64;
+        opf_item_t *items = realloc(pkg->items, capacity * sizeof(opf_item_t));
+        if (!items) {
+            xmlFree(id);
+            xmlFree(href);
+            xmlFree(media_type);
+            return EPUB_ERROR_OUT_OF_MEMORY;
         }
+        pkg->items = items;
+        pkg->item_capacity = capacity;
     }
-    if (xpath_obj) xmlXPathFreeObject(xpath_obj);
 
-    /* Extract metadata - language */
-    xpath_obj = xmlXPathEvalExpression(BAD_CAST "//dc:language", xpath_ctx);
-    if (xpath_obj && xpath_obj->nodesetval && xpath_obj->nodesetval->nodeNr > 0) {
-        xmlNodePtr node = xpath_obj->nodesetval->nodeTab[0];
-        xmlChar *content = xmlNodeGetContent(node);
-        if (content) {
-            strncpy(book->metadata.language, (const char *)content, 15);
-            book->metadata.language[15] = '\0';
-            xmlFree(content);
+    opf_item_t *item = &pkg->items[pkg->item_count++];
+    item->id = id;
+    item->href = href;
+    item->media_type = media_type;
+    return EPUB_SUCCESS;
+}
+
+/* Add a spine idref; takes ownership of the string */
+static int opf_add_itemref(opf_package_t *pkg, xmlChar *idref) {
+    if (!idref) {
+        return EPUB_SUCCESS;
+    }
+    if (pkg->spine_count >= EPUB_MAX_CHAPTERS) {
+        xmlFree(idref);
+        return EPUB_SUCCESS;
+    }
+
+    if (pkg->spine_count == pkg->spine_capacity) {
+        int capacity = pkg->spine_capacity ? pkg->spine_capacity * 2 : 64;
+        xmlChar **spine = realloc(pkg->spine, capacity * sizeof(xmlChar *));
+        if (!spine) {
+            xmlFree(idref);
+            return EPUB_ERROR_OUT_OF_MEMORY;
         }
+        pkg->spine = spine;
+        pkg->spine_capacity = capacity;
     }
-    if (xpath_obj) xmlXPathFreeObject(xpath_obj);
 
-    /* Build manifest map (id -> href) - simplified, just store in chapters for now */
-    /* Extract spine (reading order) */
-    xpath_obj = xmlXPathEvalExpression(BAD_CAST "//opf:spine/opf:itemref/@idref", xpath_ctx);
+    pkg->spine[pkg->spine_count++] = idref;
+    return EPUB_SUCCESS;
+}
+
+/* Copy the text of the current element into a field, if the field is still empty */
+static void opf_read_field(xmlTextReaderPtr reader, char *field, size_t field_size) {
+    if (field[0] != '\0') {
+        return;
+    }
+    xmlChar *content = xmlTextReaderReadString(reader);
+    if (content) {
+        strncpy(field, (const char *)content, field_size - 1);
+        field[field_size - 1] = '\0';
+        xmlFree(content);
+    }
+}
 
-    if (!xpath_obj || !xpath_obj->nodesetval || xpath_obj->nodesetval->nodeNr == 0) {
+/* Feed the streaming reader from an open ZIP entry */
+static int opf_zip_read(void *context, char *buffer, int length) {
+    zip_int64_t n = zip_fread((zip_file_t *)context, buffer, length);
+    return n < 0 ? -1 : (int)n;
+}
+
+static int opf_zip_close(void *context) {
+    zip_fclose((zip_file_t *)context);
+    return 0;
+}
+
+/**
+ * Parse an OPF file in one streaming pass
+ * @param zip: Open archive
+ * @param opf_path: Path to the OPF in the archive
+ * @param metadata: Output metadata
+ * @param pkg: Output manifest and spine, or NULL to stop after <metadata>
+ * @return: EPUB_SUCCESS on success, error code on failure
+ */
+static int opf_parse(zip_t *zip, const char *opf_path, epub_metadata_t *metadata,
+                     opf_package_t *pkg) {
+    zip_file_t *file;
+    xmlTextReaderPtr reader;
+    int in_metadata = 0, in_manifest = 0, in_spine = 0;
+    int result = EPUB_SUCCESS;
+    int status;
+
+    file = zip_fopen(zip, opf_path, 0);
+    if (!file) {
+        fprintf(stderr, "epub: File not found in ZIP: %s\n", opf_path);
+        return EPUB_ERROR_MISSING_OPF;
+    }
+
+    /* The reader owns the ZIP entry from here and closes it when freed */
+    reader = xmlReaderForIO(opf_zip_read, opf_zip_close, file, opf_path, NULL, XML_PARSE_NONET);
+    if (!reader) {
+        fprintf(stderr, "epub_parse_opf: Failed to parse %s\n", opf_path);
+        return EPUB_ERROR_PARSE_ERROR;
+    }
+
+    while ((status = xmlTextReaderRead(reader)) == 1 && result == EPUB_SUCCESS) {
+        int type = xmlTextReaderNodeType(reader);
+        const char *name = (const char *)xmlTextReaderConstLocalName(reader);
+
+        if (type == XML_READER_TYPE_END_ELEMENT) {
+            if (strcmp(name, "metadata") == 0) {
+                in_metadata = 0;
+                if (!pkg) {
+                    break;          /* Metadata is all that was asked for */
+                }
+            } else if (strcmp(name, "manifest") == 0) {
+                in_manifest = 0;
+            } else if (strcmp(name, "spine") == 0) {
+                break;              /* Nothing after the spine is needed */
+            }
+            continue;
+        }
+        if (type != XML_READER_TYPE_ELEMENT) {
+            continue;
+        }
+
+        int empty = xmlTextReaderIsEmptyElement(reader);
+        if (in_metadata) {
+            const xmlChar *ns = xmlTextReaderConstNamespaceUri(reader);
+            if (!ns || !xmlStrEqual(ns, BAD_CAST OPF_NS_DC)) {
+                continue;
+            }
+            if (strcmp(name, "title") == 0) {
+                opf_read_field(reader, metadata->title, sizeof(metadata->title));
+            } else if (strcmp(name, "creator") == 0) {
+                opf_read_field(reader, metadata->author, sizeof(metadata->author));
+            } else if (strcmp(name, "language") == 0) {
+                opf_read_field(reader, metadata->language, sizeof(metadata->language));
+            } else if (strcmp(name, "identifier") == 0) {
+                opf_read_field(reader, metadata->identifier, sizeof(metadata->identifier));
+            }
+        } else if (in_manifest) {
+            if (strcmp(name, "item") == 0) {
+                result = opf_add_item(pkg,
+                                      xmlTextReaderGetAttribute(reader, BAD_CAST "id"),
+                                      xmlTextReaderGetAttribute(reader, BAD_CAST "href"),
+                                      xmlTextReaderGetAttribute(reader, BAD_CAST "media-type"));
+            }
+        } else if (in_spine) {
+            if (strcmp(name, "itemref") == 0) {
+                result = opf_add_itemref(pkg, xmlTextReaderGetAttribute(reader, BAD_CAST "idref"));
+            }
+        } else if (strcmp(name, "metadata") == 0) {
+            in_metadata = !empty;
+        } else if (pkg && strcmp(name, "manifest") == 0) {
+            in_manifest = !empty;
+        } else if (pkg && strcmp(name, "spine") == 0) {
+            in_spine = !empty;
+        }
+    }
+
+    xmlFreeTextReader(reader);
+
+    if (status < 0 && result == EPUB_SUCCESS) {
+        fprintf(stderr, "epub_parse_opf: Failed to parse %s\n", opf_path);
+        result = EPUB_ERROR_PARSE_ERROR;
+    }
+    return result;
+}
+
+/* Chapters can be read from XHTML/HTML (or untyped) items only */
+static int opf_item_is_text(const opf_item_t *item) {
+    const char *type = (const char *)item->media_type;
+    return !type || strstr(type, "html") != NULL || strstr(type, "xml") != NULL;
+}
+
+int epub_parse_opf(void *zip_handle, const char *opf_path, epub_book_t *book) {
+    opf_package_t pkg;
+    int result;
+
+    memset(&pkg, 0, sizeof(pkg));
+    result = opf_parse((zip_t *)zip_handle, opf_path, &book->metadata, &pkg);
+    if (result == EPUB_SUCCESS) {
+        result = opf_index_manifest(&pkg);
+    }
+    if (result != EPUB_SUCCESS) {
+        opf_package_free(&pkg);
+        return result;
+    }
+
+    if (pkg.spine_count == 0) {
         fprintf(stderr, "epub_parse_opf: No spine items found\n");
-        xmlXPathFreeContext(xpath_ctx);
-        xmlFreeDoc(doc);
+        opf_package_free(&pkg);
         return EPUB_ERROR_NO_CONTENT;
     }
 
-    /* Allocate chapter array */
-    int spine_count = xpath_obj->nodesetval->nodeNr;
-    book->chapters = calloc(spine_count, sizeof(epub_chapter_t));
+    book->chapters = calloc(pkg.spine_count, sizeof(epub_chapter_t));
     if (!book->chapters) {
-        xmlXPathFreeObject(xpath_obj);
-        xmlXPathFreeContext(xpath_ctx);
-        xmlFreeDoc(doc);
+        opf_package_free(&pkg);
         return EPUB_ERROR_OUT_OF_MEMORY;
     }
 
@@ -479,45 +685,27 @@ int epub_parse_opf(void *zip_handle, const char *opf_path, epub_book_t *book) {
         opf_dir[dir_len] = '\0';
     }
 
-    /* Process each spine item */
-    for (int i = 0; i < spine_count && i < EPUB_MAX_CHAPTERS; i++) {
-        xmlNodePtr node = xpath_obj->nodesetval->nodeTab[i];
-        xmlChar *idref = xmlNodeGetContent(node);
-
-        if (idref) {
-            /* Store ID */
-            strncpy(book->chapters[i].id, (const char *)idref, 127);
-            book->chapters[i].id[127] = '\0';
-
-            /* Find corresponding manifest item */
-            char xpath_query[512];
-            snprintf(xpath_query, sizeof(xpath_query),
-                    "//opf:manifest/opf:item[@id='%s']/@href", (const char *)idref);
-
-            xmlXPathObjectPtr href_obj = xmlXPathEvalExpression(
-                BAD_CAST xpath_query, xpath_ctx);
-
-            if (href_obj && href_obj->nodesetval && href_obj->nodesetval->nodeNr > 0) {
-                xmlNodePtr href_node = href_obj->nodesetval->nodeTab[0];
-                xmlChar *href = xmlNodeGetContent(href_node);
-                if (href) {
-                    /* Construct full path relative to OPF directory */
-                    snprintf(book->chapters[i].href, EPUB_MAX_PATH_LENGTH,
-                            "%s%s", opf_dir, (const char *)href);
-                    xmlFree(href);
-                }
-            }
-
-            if (href_obj) xmlXPathFreeObject(href_obj);
-            xmlFree(idref);
-            book->chapter_count++;
+    /* Resolve the spine against the manifest index */
+    for (int i = 0; i < pkg.spine_count; i++) {
+        const opf_item_t *item = opf_find_item(&pkg, pkg.spine[i]);
+        if (!item) {
+            fprintf(stderr, "epub_parse_opf: Spine item %s is not in the manifest\n",
+                    (const char *)pkg.spine[i]);
+            continue;
         }
+        if (!opf_item_is_text(item)) {
+            fprintf(stderr, "epub_parse_opf: Skipping %s spine item %s\n",
+                    (const char *)item->media_type, (const char *)item->id);
+            continue;
+        }
+
+        epub_chapter_t *chapter = &book->chapters[book->chapter_count++];
+        strncpy(chapter->id, (const char *)item->id, sizeof(chapter->id) - 1);
+        chapter->id[sizeof(chapter->id) - 1] = '\0';
+        snprintf(chapter->href, EPUB_MAX_PATH_LENGTH, "%s%s", opf_dir, (const char *)item->href);
     }
 
-    /* Cleanup */
-    xmlXPathFreeObject(xpath_obj);
-    xmlXPathFreeContext(xpath_ctx);
-    xmlFreeDoc(doc);
+    opf_package_free(&pkg);
 
     if (book->chapter_count == 0) {
         free(book->chapters);
@@ -528,6 +716,32 @@ int epub_parse_opf(void *zip_handle, const char *opf_path, epub_book_t *book) {
     return EPUB_SUCCESS;
 }
 
+int epub_read_metadata(const char *filepath, epub_metadata_t *metadata) {
+    char opf_path[EPUB_MAX_PATH_LENGTH];
+    zip_t *zip;
+    int error;
+    int result;
+
+    if (!filepath || !metadata) {
+        return EPUB_ERROR_NOT_FOUND;
+    }
+    memset(metadata, 0, sizeof(*metadata));
+
+    zip = zip_open(filepath, ZIP_RDONLY, &error);
+    if (!zip) {
+        fprintf(stderr, "epub_read_metadata: Failed to open %s\n", filepath);
+        return EPUB_ERROR_CORRUPT_ZIP;
+    }
+
+    result = epub_parse_container(zip, opf_path, sizeof(opf_path));
+    if (result == EPUB_SUCCESS) {
+        result = opf_parse(zip, opf_path, metadata, NULL);
+    }
+
+    zip_close(zip);
+    return result;
+}
+
 epub_book_t* epub_open(const char *filepath) {
     epub_book_t *book;
     zip_t *zip;
@@ -579,6 +793,17 @@ epub_book_t* epub_open(const char *filepath) {
         return NULL;
     }
 
+    /* Lay out chapter spans; no chapter is inflated until it is read */
+    epub_assign_spans(book);
+    if (book->text_length == 0) {
+        fprintf(stderr, "epub_open: No readable chapters in %s\n", filepath);
+        epub_close(book);
+        return NULL;
+    }
+
+    /* Chapters read before come back from the text cache */
+    epub_attach_text_cache(book);
+
     return book;
 }
 
@@ -590,11 +815,16 @@ void epub_close(epub_book_t *book) {
     /* Free chapters */
     if (book->chapters) {
         for (int i = 0; i < book->chapter_count; i++) {
-            free(book->chapters[i].text);
+            if (!book->chapters[i].text_mapped) {
+                free(book->chapters[i].text);
+            }
         }
         free(book->chapters);
     }
 
+    /* Unmap cached text (after the chapters that point into it) */
+    text_cache_close((text_cache_t *)book->text_cache);
+
     /* Free full text */
     free(book->full_text);
 
@@ -606,195 +836,183 @@ void epub_close(epub_book_t *book) {
     free(book);
 }
 
-int epub_decode_entities(const char *text, size_t text_length,
-                        char **out_text, size_t *out_length) {
-    char *decoded;
-    size_t decoded_pos = 0;
-    size_t i = 0;
-
-    /* Allocate output buffer (same size is maximum) */
-    decoded = malloc(text_length + 1);
-    if (!decoded) {
-        return EPUB_ERROR_OUT_OF_MEMORY;
-    }
-
-    while (i < text_length) {
-        /* Check for entity */
-        if (text[i] == '&') {
-            int entity_found = 0;
-
-            /* Check named entities */
-            for (int j = 0; html_entities[j].entity != NULL; j++) {
-                size_t entity_len = strlen(html_entities[j].entity);
-                if (i + entity_len <= text_length &&
-                    strncmp(&text[i], html_entities[j].entity, entity_len) == 0) {
-                    /* Replace entity */
-                    const char *replacement = html_entities[j].replacement;
-                    while (*replacement) {
-                        decoded[decoded_pos++] = *replacement++;
-                    }
-                    i += entity_len;
-                    entity_found = 1;
-                    break;
-                }
-            }
-
-            /* Check numeric entities &#123; or &#xAB; */
-            if (!entity_found && i + 3 < text_length && text[i+1] == '#') {
-                int value = 0;
-                size_t entity_end = i + 2;
-                int is_hex = (text[i+2] == 'x' || text[i+2] == 'X');
-
-                if (is_hex) {
-                    entity_end++;
-                }
-
-                /* Parse number */
-                while (entity_end < text_length && text[entity_end] != ';') {
-                    char c = text[entity_end];
-                    if (is_hex) {
-                        if (c >= '0' && c <= '9') {
-                            value = value * 16 + (c - '0');
-                        } else if (c >= 'a' && c <= 'f') {
-                            value = value * 16 + (c - 'a' + 10);
-                        } else if (c >= 'A' && c <= 'F') {
-                            value = value * 16 + (c - 'A' + 10);
-                        } else {
-                            break;
-                        }
-                    } else {
-                        if (c >= '0' && c <= '9') {
-                            value = value * 10 + (c - '0');
-                        } else {
-                            break;
-                        }
-                    }
-                    entity_end++;
-                }
-
-                if (entity_end < text_length && text[entity_end] == ';' && value > 0 && value < 128) {
-                    /* Replace with ASCII character */
-                    decoded[decoded_pos++] = (char)value;
-                    i = entity_end + 1;
-                    entity_found = 1;
-                }
-            }
-
-            /* If no entity found, copy & as-is */
-            if (!entity_found) {
-                decoded[decoded_pos++] = text[i++];
-            }
-        } else {
-            /* Regular character */
-            decoded[decoded_pos++] = text[i++];
-        }
-    }
-
-    decoded[decoded_pos] = '\0';
-    *out_text = decoded;
-    *out_length = decoded_pos;
-    return EPUB_SUCCESS;
-}
-
 int epub_extract_html_text(const char *html, size_t html_length,
                            char **out_text, size_t *out_length) {
-    char *stripped_text;
-    size_t stripped_length;
-    int result;
+    html_text_t converter;
+    char *text;
 
-    /* Strip HTML tags */
-    result = strip_html_tags(html, html_length, &stripped_text, &stripped_length);
-    if (result != EPUB_SUCCESS) {
-        return result;
+    /* Text never outgrows its markup except through &nGt; or &nLt;, which the converter clips */
+    text = malloc(html_length + 1);
+    if (!text) {
+        return EPUB_ERROR_OUT_OF_MEMORY;
     }
 
-    /* Decode HTML entities */
-    result = epub_decode_entities(stripped_text, stripped_length, out_text, out_length);
-    free(stripped_text);
+    html_text_init(&converter, text, html_length);
+    html_text_feed(&converter, html, html_length);
+    *out_length = html_text_finish(&converter);
+    text[*out_length] = '\0';
+    *out_text = text;
 
-    return result;
+    return EPUB_SUCCESS;
 }
 
 int epub_extract_text(epub_book_t *book) {
-    size_t total_text_size = 0;
-    char *full_text;
+    char *full_text = NULL;
     size_t full_text_pos = 0;
+    size_t capacity = 0;
     zip_t *zip;
 
     if (!book || !book->zip_handle) {
         return EPUB_ERROR_INVALID_FORMAT;
     }
+    if (book->full_text) {
+        return EPUB_SUCCESS;
+    }
 
     zip = (zip_t *)book->zip_handle;
 
-    /* First pass: extract text from each chapter and calculate total size */
+    /* Convert each chapter straight into the full text buffer */
     for (int i = 0; i < book->chapter_count; i++) {
         epub_chapter_t *chapter = &book->chapters[i];
 
-        /* Read chapter HTML */
-        size_t html_size;
-        char *html = zip_read_file(zip, chapter->href, &html_size);
-        if (!html) {
-            fprintf(stderr, "epub_extract_text: Failed to read chapter %d (%s)\n",
-                    i, chapter->href);
+        if (chapter->text_span == 0) {
             continue;
         }
 
-        /* Extract text from HTML */
-        char *chapter_text;
-        size_t chapter_text_length;
-        int result = epub_extract_html_text(html, html_size,
-                                           &chapter_text, &chapter_text_length);
-        free(html);
+        /* Reserve room for a "\n\n" separator and the whole span */
+        size_t needed = full_text_pos + 2 + chapter->text_span + 1;
+        if (needed > capacity) {
+            size_t new_capacity = capacity ? capacity * 2 : book->text_length + 1;
+            if (new_capacity < needed) new_capacity = needed;
+            char *grown = realloc(full_text, new_capacity);
+            if (!grown) {
+                free(full_text);
+                return EPUB_ERROR_OUT_OF_MEMORY;
+            }
+            full_text = grown;
+            capacity = new_capacity;
+        }
 
-        if (result != EPUB_SUCCESS) {
-            fprintf(stderr, "epub_extract_text: Failed to extract text from chapter %d\n", i);
+        /* Separator before every chapter but the first */
+        size_t start = full_text_pos > 0 ? full_text_pos + 2 : 0;
+        size_t chapter_text_length;
+        if (read_chapter_text(zip, chapter->href, &full_text[start], chapter->text_span,
+                              &chapter_text_length) != EPUB_SUCCESS) {
+            fprintf(stderr, "epub_extract_text: Failed to read chapter %d (%s)\n",
+                    i, chapter->href);
+            continue;
+        }
+        if (chapter_text_length == 0) {
             continue;
         }
+        if (start + chapter_text_length + 1 > EPUB_MAX_TEXT_SIZE) {
+            free(full_text);
+            return EPUB_ERROR_TOO_LARGE;
+        }
 
-        /* Store chapter text */
-        chapter->text = chapter_text;
-        chapter->text_length = chapter_text_length;
-        total_text_size += chapter_text_length + 2;  /* +2 for "\n\n" separator */
+        if (start > 0) {
+            full_text[full_text_pos] = '\n';
+            full_text[full_text_pos + 1] = '\n';
+        }
+        full_text_pos = start + chapter_text_length;
     }
 
-    if (total_text_size == 0) {
+    if (full_text_pos == 0) {
+        free(full_text);
         return EPUB_ERROR_NO_CONTENT;
     }
 
-    if (total_text_size > EPUB_MAX_TEXT_SIZE) {
-        return EPUB_ERROR_TOO_LARGE;
+    full_text[full_text_pos] = '\0';
+
+    book->full_text = full_text;
+    book->full_text_length = full_text_pos;
+
+    return EPUB_SUCCESS;
+}
+
+int epub_load_chapter(epub_book_t *book, int index) {
+    if (!book || !book->zip_handle || index < 0 || index >= book->chapter_count) {
+        return EPUB_ERROR_INVALID_FORMAT;
+    }
+
+    epub_chapter_t *chapter = &book->chapters[index];
+    chapter->last_used = ++book->cache_clock;
+    if (chapter->text) {
+        return EPUB_SUCCESS;
     }
+    if (chapter->text_span == 0) {
+        return EPUB_ERROR_NO_CONTENT;
+    }
+
+    /* Extracted before: map it from the text cache, no inflating */
+    text_cache_t *cache = (text_cache_t *)book->text_cache;
+    size_t length;
+    const char *cached = text_cache_chunk(cache, index, &length);
+    if (cached) {
+        chapter->text = (char *)cached;
+        chapter->text_length = length;
+        chapter->text_mapped = 1;
+        return EPUB_SUCCESS;
+    }
+
+    /* Make room first so the old chapters are gone before the new one inflates */
+    epub_cache_evict(book, chapter->text_span);
 
-    /* Allocate full text buffer */
-    full_text = malloc(total_text_size + 1);
-    if (!full_text) {
+    char *text = malloc(chapter->text_span + 1);
+    if (!text) {
         return EPUB_ERROR_OUT_OF_MEMORY;
     }
 
-    /* Concatenate all chapter texts */
-    for (int i = 0; i < book->chapter_count; i++) {
-        epub_chapter_t *chapter = &book->chapters[i];
-        if (chapter->text && chapter->text_length > 0) {
-            memcpy(&full_text[full_text_pos], chapter->text, chapter->text_length);
-            full_text_pos += chapter->text_length;
-
-            /* Add chapter separator */
-            if (i < book->chapter_count - 1) {
-                full_text[full_text_pos++] = '\n';
-                full_text[full_text_pos++] = '\n';
-            }
-        }
+    /* Convert into the span; a chapter that fails to read stays blank */
+    int read_result = read_chapter_text((zip_t *)book->zip_handle, chapter->href, text,
+                                        chapter->text_span, &length);
+    if (read_result != EPUB_SUCCESS) {
+        fprintf(stderr, "epub_load_chapter: Failed to read chapter %d (%s)\n",
+                index, chapter->href);
+        length = 0;
     }
 
-    full_text[full_text_pos] = '\0';
+    /* Pad the rest of the span */
+    memset(text + length, '\n', chapter->text_span - length);
+    text[chapter->text_span] = '\0';
+
+    /* Keep it for next time and read it back from the mapping, off the heap */
+    if (read_result == EPUB_SUCCESS &&
+        text_cache_fill(cache, index, text, length) == 0) {
+        free(text);
+        chapter->text = (char *)text_cache_chunk(cache, index, NULL);
+        chapter->text_length = length;
+        chapter->text_mapped = 1;
+        return EPUB_SUCCESS;
+    }
 
-    book->full_text = full_text;
-    book->full_text_length = full_text_pos;
+    chapter->text = text;
+    chapter->text_length = length;
+    book->cache_bytes += chapter->text_span;
 
     return EPUB_SUCCESS;
 }
 
+int epub_find_chapter(epub_book_t *book, size_t offset) {
+    if (!book || book->chapter_count == 0 || offset >= book->text_length) {
+        return -1;
+    }
+
+    /* Last chapter starting at or before offset (empty chapters share the next one's offset) */
+    int lo = 0;
+    int hi = book->chapter_count - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (book->chapters[mid].text_offset <= offset) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    return lo;
+}
+
 epub_chapter_t* epub_get_chapter(epub_book_t *book, int index) {
     if (!book || index < 0 || index >= book->chapter_count) {
         return NULL;
@@ -872,6 +1090,20 @@ static int epub_interface_get_text(format_handle_t handle, const char **out_text
     return epub_to_format_error(result);
 }
 
+/* Copy EPUB metadata into the generic structure (page count and size left 0) */
+static void epub_copy_metadata(const epub_metadata_t *epub, format_metadata_t *metadata) {
+    memset(metadata, 0, sizeof(format_metadata_t));
+
+    strncpy(metadata->title, epub->title, sizeof(metadata->title) - 1);
+    metadata->title[sizeof(metadata->title) - 1] = '\0';
+
+    strncpy(metadata->author, epub->author, sizeof(metadata->author) - 1);
+    metadata->author[sizeof(metadata->author) - 1] = '\0';
+
+    strncpy(metadata->language, epub->language, sizeof(metadata->language) - 1);
+    metadata->language[sizeof(metadata->language) - 1] = '\0';
+}
+
 static int epub_interface_get_metadata(format_handle_t handle, format_metadata_t *metadata) {
     epub_book_t *book = (epub_book_t*)handle;
 
@@ -879,23 +1111,32 @@ static int epub_interface_get_metadata(format_handle_t handle, format_metadata_t
         return FORMAT_ERROR_INVALID_FORMAT;
     }
 
-    memset(metadata, 0, sizeof(format_metadata_t));
+    /* Page count not available until pagination */
+    epub_copy_metadata(&book->metadata, metadata);
 
-    /* Copy metadata from EPUB */
-    strncpy(metadata->title, book->metadata.title, sizeof(metadata->title) - 1);
-    metadata->title[sizeof(metadata->title) - 1] = '\0';
+    /* File size - approximate from the uncompressed chapter sizes */
+    metadata->file_size = book->text_length;
 
-    strncpy(metadata->author, book->metadata.author, sizeof(metadata->author) - 1);
-    metadata->author[sizeof(metadata->author) - 1] = '\0';
+    return FORMAT_SUCCESS;
+}
 
-    strncpy(metadata->language, book->metadata.language, sizeof(metadata->language) - 1);
-    metadata->language[sizeof(metadata->language) - 1] = '\0';
+static int epub_interface_read_metadata(const char *filepath, format_metadata_t *metadata) {
+    epub_metadata_t epub;
+    struct stat st;
 
-    /* Page count not available until pagination */
-    metadata->page_count = 0;
+    if (!metadata) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
 
-    /* File size - approximate from full text length */
-    metadata->file_size = book->full_text_length;
+    int result = epub_read_metadata(filepath, &epub);
+    if (result != EPUB_SUCCESS) {
+        return epub_to_format_error(result);
+    }
+
+    epub_copy_metadata(&epub, metadata);
+    if (stat(filepath, &st) == 0) {
+        metadata->file_size = st.st_size;
+    }
 
     return FORMAT_SUCCESS;
 }
@@ -906,6 +1147,42 @@ static int epub_interface_get_page_count(format_handle_t handle) {
     return -1;
 }
 
+static int epub_interface_get_length(format_handle_t handle, size_t *out_length) {
+    epub_book_t *book = (epub_book_t*)handle;
+
+    if (!book || !out_length) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    *out_length = book->text_length;
+    return FORMAT_SUCCESS;
+}
+
+/* Each chapter's span is one chunk, extracted when first asked for */
+static int epub_interface_chunk_at(format_handle_t handle, size_t offset, format_chunk_t *chunk) {
+    epub_book_t *book = (epub_book_t*)handle;
+
+    if (!book || !chunk) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    int index = epub_find_chapter(book, offset);
+    if (index < 0) {
+        return FORMAT_ERROR_NO_CONTENT;
+    }
+
+    int result = epub_load_chapter(book, index);
+    if (result != EPUB_SUCCESS) {
+        return epub_to_format_error(result);
+    }
+
+    epub_chapter_t *chapter = &book->chapters[index];
+    chunk->text = chapter->text;
+    chunk->offset = chapter->text_offset;
+    chunk->length = chapter->text_span;
+    return FORMAT_SUCCESS;
+}
+
 /*
  * Format Interface Definition
  */
@@ -919,5 +1196,8 @@ const book_format_interface_t epub_format_interface = {
     .extract_text = epub_interface_extract_text,
     .get_text = epub_interface_get_text,
     .get_metadata = epub_interface_get_metadata,
-    .get_page_count = epub_interface_get_page_count
+    .read_metadata = epub_interface_read_metadata,
+    .get_page_count = epub_interface_get_page_count,
+    .get_length = epub_interface_get_length,
+    .chunk_at = epub_interface_chunk_at
 };
@@ -38,6 +38,7 @@
 #define EPUB_MAX_PATH_LENGTH 512
 #define EPUB_MAX_CHAPTERS 500
 #define EPUB_MAX_TEXT_SIZE (20 * 1024 * 1024)  /* 20MB max extracted text */
+#define EPUB_CHAPTER_CACHE_SIZE (2 * 1024 * 1024)  /* Resident chapter text budget */
 
 /*
  * Error Codes
@@ -59,12 +60,21 @@ typedef enum {
 /*
  * EPUB Chapter Structure
  * Represents a single chapter/spine item in reading order
+ *
+ * Each chapter owns text_span bytes of the book text, starting at
+ * text_offset. The span is the chapter's uncompressed HTML size, known from
+ * the ZIP directory without inflating anything, and stripped text never
+ * needs more; the rest of the span is padded with newlines.
  */
 typedef struct {
     char id[128];                      /* Manifest item ID */
     char href[EPUB_MAX_PATH_LENGTH];   /* Path to chapter file in ZIP */
-    char *text;                        /* Extracted plain text (NULL until extracted) */
+    char *text;                        /* Text padded to text_span bytes (NULL until loaded) */
     size_t text_length;                /* Length of extracted text */
+    size_t text_offset;                /* Offset of this chapter in the book text */
+    size_t text_span;                  /* Bytes of book text reserved for this chapter */
+    unsigned long last_used;           /* LRU stamp of the loaded text */
+    int text_mapped;                   /* Text points into the text cache, not the heap */
 } epub_chapter_t;
 
 /*
@@ -87,15 +97,25 @@ typedef struct {
     epub_metadata_t metadata;            /* Book metadata */
     epub_chapter_t *chapters;            /* Array of chapters in reading order */
     int chapter_count;                   /* Number of chapters */
+    size_t text_length;                  /* Length of the book text (sum of chapter spans) */
+    size_t cache_bytes;                  /* Bytes of chapter text currently loaded */
+    unsigned long cache_clock;           /* LRU clock for chapter text */
     char *full_text;                     /* All extracted text concatenated */
     size_t full_text_length;             /* Total text length */
     void *zip_handle;                    /* Internal: libzip handle */
+    void *text_cache;                    /* Internal: text_cache_t of this book (may be NULL) */
 } epub_book_t;
 
 /*
  * Core EPUB Functions
  */
 
+/**
+ * Initialize libxml2 once, before EPUBs are read from several threads
+ * (the library scan reads metadata on a worker pool)
+ */
+void epub_init(void);
+
 /**
  * Validate an EPUB file (check if it's a valid ZIP with EPUB structure)
  * @param filepath: Path to EPUB file
@@ -111,6 +131,16 @@ int epub_validate(const char *filepath);
  */
 epub_book_t* epub_open(const char *filepath);
 
+/**
+ * Read an EPUB's metadata without opening the book
+ * Parses the OPF only up to the end of <metadata>; the manifest, spine and
+ * chapters are never looked at.
+ * @param filepath: Path to EPUB file
+ * @param metadata: Output metadata (fields missing from the OPF are empty)
+ * @return: EPUB_SUCCESS on success, error code on failure
+ */
+int epub_read_metadata(const char *filepath, epub_metadata_t *metadata);
+
 /**
  * Close EPUB book and free all associated memory
  * @param book: EPUB book structure to free
@@ -123,9 +153,31 @@ void epub_close(epub_book_t *book);
  * and concatenates into book->full_text
  * @param book: EPUB book structure
  * @return: EPUB_SUCCESS on success, error code on failure
+ * @note: Only needed for the whole text at once; readers that page through
+ *        the book should use epub_load_chapter() instead
  */
 int epub_extract_text(epub_book_t *book);
 
+/**
+ * Load the text of one chapter into its span
+ * Chapters are extracted on first use and kept in an LRU cache of
+ * EPUB_CHAPTER_CACHE_SIZE bytes; loading one may evict others, but never
+ * the chapter being loaded.
+ * @param book: EPUB book structure
+ * @param index: Chapter index (0-based)
+ * @return: EPUB_SUCCESS on success, error code on failure
+ * @note: A chapter that cannot be read loads as blank text
+ */
+int epub_load_chapter(epub_book_t *book, int index);
+
+/**
+ * Find the chapter holding an offset of the book text
+ * @param book: EPUB book structure
+ * @param offset: Byte offset within the book text
+ * @return: Chapter index, or -1 if offset is past the end
+ */
+int epub_find_chapter(epub_book_t *book, size_t offset);
+
 /**
  * Get chapter by index
  * @param book: EPUB book structure
@@ -177,6 +229,8 @@ int epub_parse_container(void *zip_handle, char *opf_path, size_t opf_path_size)
 
 /**
  * Parse content.opf to extract metadata and reading order
+ * The manifest is indexed by item ID in one streaming pass over the OPF,
+ * then each spine idref is resolved with a hash lookup.
  * @param zip_handle: libzip handle
  * @param opf_path: Path to content.opf in ZIP
  * @param book: EPUB book structure to populate
@@ -185,7 +239,8 @@ int epub_parse_container(void *zip_handle, char *opf_path, size_t opf_path_size)
 int epub_parse_opf(void *zip_handle, const char *opf_path, epub_book_t *book);
 
 /**
- * Extract text from a single XHTML/HTML chapter
+ * Extract text from a single XHTML/HTML chapter held in memory
+ * Chapters inside the book are streamed through html_text.h instead.
  * @param html: HTML/XHTML content
  * @param html_length: Length of HTML content
  * @param out_text: Output buffer for plain text (allocated by function)
@@ -196,16 +251,4 @@ int epub_parse_opf(void *zip_handle, const char *opf_path, epub_book_t *book);
 int epub_extract_html_text(const char *html, size_t html_length,
                            char **out_text, size_t *out_length);
 
-/**
- * Decode HTML entities in text (e.g., &amp; &lt; &gt; &#39; etc.)
- * @param text: Input text with entities
- * @param text_length: Length of input text
- * @param out_text: Output buffer (allocated by function)
- * @param out_length: Output length
- * @return: EPUB_SUCCESS on success, error code on failure
- * @note: Caller must free out_text
- */
-int epub_decode_entities(const char *text, size_t text_length,
-                         char **out_text, size_t *out_length);
-
 #endif /* EPUB_READER_H */
@@ -0,0 +1,343 @@
+/*
+ * erb_reader.c - Precompiled E-Reader Book Format Implementation
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include "erb_reader.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Internal helpers
+ */
+
+/**
+ * Check the fields of a header that do not need the rest of the file
+ */
+static int check_header(const erb_header_t *header) {
+    if (memcmp(header->magic, ERB_MAGIC, sizeof(header->magic)) != 0) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+    if (header->version != ERB_VERSION) {
+        return FORMAT_ERROR_UNSUPPORTED;
+    }
+    if (header->text_length == 0) {
+        return FORMAT_ERROR_NO_CONTENT;
+    }
+    if (header->text_length > ERB_MAX_TEXT_SIZE) {
+        return FORMAT_ERROR_TOO_LARGE;
+    }
+    return FORMAT_SUCCESS;
+}
+
+/**
+ * Check that a section of count items of size bytes lies in the file
+ */
+static int section_fits(size_t file_size, uint32_t offset, uint32_t count, size_t size) {
+    return offset % 4 == 0 && offset <= file_size &&
+           (uint64_t)count * size <= (uint64_t)(file_size - offset);
+}
+
+/**
+ * Get a string from the string table ("" for a bad offset)
+ */
+static const char* erb_string(const erb_book_t *book, uint32_t offset) {
+    return offset < book->header->string_size ? book->strings + offset : "";
+}
+
+/**
+ * Check every section of a mapped file
+ */
+static int check_file(erb_book_t *book) {
+    const erb_header_t *h = book->header;
+    size_t size = book->file_size;
+
+    int result = check_header(h);
+    if (result != FORMAT_SUCCESS) {
+        return result;
+    }
+
+    if (h->file_size != size ||
+        !section_fits(size, h->chapter_offset, h->chapter_count, sizeof(erb_chapter_t)) ||
+        !section_fits(size, h->layout_offset, h->layout_count, sizeof(erb_layout_t)) ||
+        !section_fits(size, h->string_offset, h->string_size, 1) ||
+        h->text_offset > size || (uint64_t)h->text_length + 1 > size - h->text_offset) {
+        return FORMAT_ERROR_CORRUPT_FILE;
+    }
+
+    /* Strings start with "" and end with a terminator; text ends with '\0' */
+    book->strings = book->map + h->string_offset;
+    book->text = book->map + h->text_offset;
+    if (h->string_size == 0 || book->strings[0] != '\0' ||
+        book->strings[h->string_size - 1] != '\0' || book->text[h->text_length] != '\0') {
+        return FORMAT_ERROR_CORRUPT_FILE;
+    }
+
+    /* Chapters tile the text */
+    book->chapters = (const erb_chapter_t*)(book->map + h->chapter_offset);
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < h->chapter_count; i++) {
+        if (book->chapters[i].text_offset != offset || book->chapters[i].text_length == 0) {
+            return FORMAT_ERROR_CORRUPT_FILE;
+        }
+        offset += book->chapters[i].text_length;
+    }
+    if (h->chapter_count > 0 && offset != h->text_length) {
+        return FORMAT_ERROR_CORRUPT_FILE;
+    }
+
+    book->layouts = (const erb_layout_t*)(book->map + h->layout_offset);
+    return FORMAT_SUCCESS;
+}
+
+/*
+ * Core ERB Functions
+ */
+
+int erb_validate(const char *filepath) {
+    erb_header_t header;
+    struct stat st;
+
+    if (!filepath) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    int fd = open(filepath, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return (errno == ENOENT) ? FORMAT_ERROR_NOT_FOUND : FORMAT_ERROR_READ_FAILED;
+    }
+
+    int result = FORMAT_SUCCESS;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        result = FORMAT_ERROR_INVALID_FORMAT;
+    } else if (read(fd, &header, sizeof(header)) != (ssize_t)sizeof(header)) {
+        result = FORMAT_ERROR_INVALID_FORMAT;
+    } else {
+        result = check_header(&header);
+        if (result == FORMAT_SUCCESS && header.file_size != (uint64_t)st.st_size) {
+            result = FORMAT_ERROR_CORRUPT_FILE;
+        }
+    }
+
+    close(fd);
+    return result;
+}
+
+erb_book_t* erb_open(const char *filepath) {
+    if (!filepath) {
+        return NULL;
+    }
+
+    erb_book_t *book = calloc(1, sizeof(erb_book_t));
+    if (!book) {
+        fprintf(stderr, "erb_open: Failed to allocate book structure\n");
+        return NULL;
+    }
+    strncpy(book->filepath, filepath, sizeof(book->filepath) - 1);
+
+    /* The whole file is mapped; nothing is read or copied */
+    int result = format_map_text(filepath, &book->map, &book->file_size, &book->map_size);
+    if (result == FORMAT_SUCCESS) {
+        if (book->file_size < sizeof(erb_header_t)) {
+            result = FORMAT_ERROR_INVALID_FORMAT;
+        } else {
+            book->header = (const erb_header_t*)book->map;
+            result = check_file(book);
+        }
+    }
+
+    if (result != FORMAT_SUCCESS) {
+        fprintf(stderr, "erb_open: Cannot read %s: %s\n", filepath, format_error_string(result));
+        erb_close(book);
+        return NULL;
+    }
+
+    return book;
+}
+
+void erb_close(erb_book_t *book) {
+    if (book) {
+        format_unmap_text(book->map, book->map_size);
+        free(book);
+    }
+}
+
+int erb_get_metadata(erb_book_t *book, format_metadata_t *metadata) {
+    if (!book || !metadata) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    memset(metadata, 0, sizeof(format_metadata_t));
+    strncpy(metadata->title, erb_string(book, book->header->title), sizeof(metadata->title) - 1);
+    strncpy(metadata->author, erb_string(book, book->header->author), sizeof(metadata->author) - 1);
+    strncpy(metadata->language, erb_string(book, book->header->language),
+            sizeof(metadata->language) - 1);
+
+    /* Page count depends on the reader's geometry */
+    metadata->page_count = 0;
+    metadata->file_size = (long)book->header->file_size;
+
+    return FORMAT_SUCCESS;
+}
+
+int erb_get_page_table(erb_book_t *book, uint32_t layout_key,
+                       const uint32_t **out_table, int *out_page_count) {
+    if (!book || !out_table || !out_page_count) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    for (uint32_t i = 0; i < book->header->layout_count; i++) {
+        const erb_layout_t *layout = &book->layouts[i];
+        if (layout->key != layout_key) {
+            continue;
+        }
+        if (layout->page_count == 0 || layout->page_count > INT32_MAX / 3 ||
+            !section_fits(book->file_size, layout->table_offset,
+                          layout->page_count * 3, sizeof(uint32_t))) {
+            return FORMAT_ERROR_CORRUPT_FILE;
+        }
+        *out_table = (const uint32_t*)(book->map + layout->table_offset);
+        *out_page_count = (int)layout->page_count;
+        return FORMAT_SUCCESS;
+    }
+
+    return FORMAT_ERROR_NO_CONTENT;
+}
+
+/*
+ * Format Interface Implementation
+ * Wrappers that convert between void* handles and erb_book_t*
+ */
+
+static int erb_interface_validate(const char *filepath) {
+    return erb_validate(filepath);
+}
+
+static format_handle_t erb_interface_open(const char *filepath) {
+    return (format_handle_t)erb_open(filepath);
+}
+
+static void erb_interface_close(format_handle_t handle) {
+    erb_close((erb_book_t*)handle);
+}
+
+static int erb_interface_extract_text(format_handle_t handle) {
+    /* The text is in the file as it will be read */
+    return handle ? FORMAT_SUCCESS : FORMAT_ERROR_INVALID_FORMAT;
+}
+
+static int erb_interface_get_text(format_handle_t handle, const char **out_text, size_t *out_length) {
+    erb_book_t *book = (erb_book_t*)handle;
+
+    if (!book || !out_text || !out_length) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    *out_text = book->text;
+    *out_length = book->header->text_length;
+    return FORMAT_SUCCESS;
+}
+
+static int erb_interface_get_metadata(format_handle_t handle, format_metadata_t *metadata) {
+    return erb_get_metadata((erb_book_t*)handle, metadata);
+}
+
+static int erb_interface_get_page_count(format_handle_t handle) {
+    /* Page count depends on the reader's geometry */
+    (void)handle;
+    return -1;
+}
+
+static int erb_interface_get_length(format_handle_t handle, size_t *out_length) {
+    erb_book_t *book = (erb_book_t*)handle;
+
+    if (!book || !out_length) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    *out_length = book->header->text_length;
+    return FORMAT_SUCCESS;
+}
+
+static int erb_interface_chunk_at(format_handle_t handle, size_t offset, format_chunk_t *chunk) {
+    erb_book_t *book = (erb_book_t*)handle;
+
+    if (!book || !chunk) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+    if (offset >= book->header->text_length) {
+        return FORMAT_ERROR_NO_CONTENT;
+    }
+
+    if (book->header->chapter_count == 0) {
+        /* No chapter table: the text is a single chunk */
+        chunk->text = book->text;
+        chunk->offset = 0;
+        chunk->length = book->header->text_length;
+        return FORMAT_SUCCESS;
+    }
+
+    /* Binary search for the chapter containing offset */
+    uint32_t low = 0, high = book->header->chapter_count - 1;
+    while (low < high) {
+        uint32_t mid = low + (high - low + 1) / 2;
+        if (book->chapters[mid].text_offset <= offset) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+
+    const erb_chapter_t *chapter = &book->chapters[low];
+    chunk->text = book->text + chapter->text_offset;
+    chunk->offset = chapter->text_offset;
+    chunk->length = chapter->text_length;
+    return FORMAT_SUCCESS;
+}
+
+static int erb_interface_get_page_table(format_handle_t handle, uint32_t layout_key,
+                                        const uint32_t **out_table, int *out_page_count) {
+    return erb_get_page_table((erb_book_t*)handle, layout_key, out_table, out_page_count);
+}
+
+/*
+ * Format Interface Definition
+ */
+const book_format_interface_t erb_format_interface = {
+    .type = BOOK_FORMAT_ERB,
+    .name = "Precompiled Book",
+    .extension = ERB_EXTENSION,
+    .validate = erb_interface_validate,
+    .open = erb_interface_open,
+    .close = erb_interface_close,
+    .extract_text = erb_interface_extract_text,
+    .get_text = erb_interface_get_text,
+    .get_metadata = erb_interface_get_metadata,
+    .get_page_count = erb_interface_get_page_count,
+    .get_length = erb_interface_get_length,
+    .chunk_at = erb_interface_chunk_at,
+    .get_page_table = erb_interface_get_page_table
+};
@@ -0,0 +1,161 @@
+/*
+ * erb_reader.h - Precompiled E-Reader Book Format (.erb)
+ *
+ * An .erb file is a book converted on the host (tools/erbconv) into the
+ * form the reader works with, so that opening it on the device costs one
+ * mmap() and no extraction or parsing:
+ *
+ *   header        erb_header_t: magic, version, section offsets, metadata
+ *   chapters      erb_chapter_t[]: text span and title of each chapter
+ *   layouts       erb_layout_t[]: one page table per standard geometry
+ *   page tables   per layout, page_count rows of (start, end, line count)
+ *   strings       metadata and chapter titles, NUL-terminated, from offset 0 = ""
+ *   text          normalized UTF-8 text of all chapters, then one '\0'
+ *
+ * Every field is a little-endian uint32_t and every section starts on a
+ * 4-byte boundary, so the structures below are used straight from the
+ * mapping. Chapters are the chunks of the book text (pages never span
+ * two). A page table is used when its key equals text_layout_key() of the
+ * reader's geometry; any other geometry is laid out as usual.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef ERB_READER_H
+#define ERB_READER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "format_interface.h"
+
+/*
+ * File Layout (shared with tools/erbconv.c)
+ */
+#define ERB_MAGIC           "ERBK"
+#define ERB_VERSION         1
+#define ERB_EXTENSION       ".erb"
+#define ERB_MAX_TEXT_SIZE   0x7FFFFFFFu   /* Pagination offsets are ints */
+#define ERB_TITLE_MAX       80            /* Longest chapter title, in bytes */
+
+/* File header */
+typedef struct {
+    char magic[4];             /* ERB_MAGIC */
+    uint32_t version;          /* ERB_VERSION */
+    uint32_t file_size;        /* Size of the whole file */
+    uint32_t source_format;    /* book_format_type_t of the converted book */
+    uint32_t text_offset;      /* Book text, followed by one '\0' */
+    uint32_t text_length;      /* Text length in bytes (without the '\0') */
+    uint32_t chapter_offset;   /* erb_chapter_t[chapter_count] */
+    uint32_t chapter_count;
+    uint32_t layout_offset;    /* erb_layout_t[layout_count] */
+    uint32_t layout_count;
+    uint32_t string_offset;    /* String table */
+    uint32_t string_size;
+    uint32_t title;            /* String table offsets */
+    uint32_t author;
+    uint32_t language;
+    uint32_t source_name;      /* File name of the converted book */
+} erb_header_t;
+
+/* Chapter (chapters tile the text in order) */
+typedef struct {
+    uint32_t text_offset;      /* Offset of the chapter in the book text */
+    uint32_t text_length;      /* Length of the chapter text */
+    uint32_t title;            /* String table offset of the title ("" if none) */
+} erb_chapter_t;
+
+/* Precomputed layout */
+typedef struct {
+    uint32_t key;              /* text_layout_key() of the geometry */
+    uint32_t page_count;
+    uint32_t table_offset;     /* page_count rows of 3 uint32_t */
+    uint8_t font_size;         /* Settings the geometry came from (informational) */
+    uint8_t line_spacing;
+    uint8_t margins;
+    uint8_t reserved;
+} erb_layout_t;
+
+/*
+ * ERB Book Structure
+ * Pointers into the read-only mapping of the file
+ */
+typedef struct {
+    char filepath[512];                /* Path to ERB file */
+    const char *map;                   /* File mapping */
+    size_t map_size;                   /* Size of the mapping */
+    size_t file_size;                  /* Size of the file */
+    const erb_header_t *header;
+    const erb_chapter_t *chapters;
+    const erb_layout_t *layouts;
+    const char *strings;
+    const char *text;                  /* Book text (null-terminated) */
+} erb_book_t;
+
+/*
+ * Core ERB Functions
+ */
+
+/**
+ * Validate an ERB file (header only)
+ * @param filepath: Path to ERB file
+ * @return: FORMAT_SUCCESS on valid file, error code otherwise
+ */
+int erb_validate(const char *filepath);
+
+/**
+ * Open an ERB file by mapping it
+ * @param filepath: Path to ERB file
+ * @return: Pointer to erb_book_t structure, or NULL on error
+ * @note: Caller must free with erb_close()
+ */
+erb_book_t* erb_open(const char *filepath);
+
+/**
+ * Close an ERB book and unmap the file
+ * @param book: ERB book structure to free
+ */
+void erb_close(erb_book_t *book);
+
+/**
+ * Get metadata from an ERB book
+ * @param book: ERB book structure
+ * @param metadata: Output metadata structure
+ * @return: FORMAT_SUCCESS
+ */
+int erb_get_metadata(erb_book_t *book, format_metadata_t *metadata);
+
+/**
+ * Find the page table for a layout
+ * @param book: ERB book structure
+ * @param layout_key: text_layout_key() of the reader's geometry
+ * @param out_table: Output page_count rows of (start offset, end offset, line count)
+ * @param out_page_count: Output number of pages
+ * @return: FORMAT_SUCCESS if found, FORMAT_ERROR_NO_CONTENT otherwise
+ */
+int erb_get_page_table(erb_book_t *book, uint32_t layout_key,
+                       const uint32_t **out_table, int *out_page_count);
+
+/*
+ * Format Interface
+ * External interface definition for format registry
+ */
+extern const book_format_interface_t erb_format_interface;
+
+#endif /* ERB_READER_H */
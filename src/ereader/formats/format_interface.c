@@ -29,25 +29,34 @@
 #include "txt_reader.h"
 #include "epub_reader.h"
 #include "pdf_reader.h"
+#include <stdio.h>
+#include <stdint.h>
 #include <string.h>
 #include <strings.h>
 #include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 /*
  * Format Registry
  * Array of all registered format interfaces
  */
-static const book_format_interface_t *format_registry[4] = {
+static const book_format_interface_t *format_registry[5] = {
     NULL,  /* BOOK_FORMAT_UNKNOWN */
     NULL,  /* BOOK_FORMAT_TXT - will be set in format_init() */
     NULL,  /* BOOK_FORMAT_EPUB - will be set in format_init() */
-    NULL   /* BOOK_FORMAT_PDF - will be set in format_init() */
+    NULL,  /* BOOK_FORMAT_PDF - will be set in format_init() */
+    NULL   /* BOOK_FORMAT_ERB - will be set in format_init() */
 };
 
-/* External format interfaces (defined in txt_reader.c, epub_reader.c, pdf_reader.c) */
+/* External format interfaces (defined in txt_reader.c, epub_reader.c, pdf_reader.c, erb_reader.c) */
 extern const book_format_interface_t txt_format_interface;
 extern const book_format_interface_t epub_format_interface;
 extern const book_format_interface_t pdf_format_interface;
+extern const book_format_interface_t erb_format_interface;
 
 /*
  * Format Registry Functions
@@ -58,11 +67,15 @@ int format_init(void) {
     format_registry[BOOK_FORMAT_TXT] = &txt_format_interface;
     format_registry[BOOK_FORMAT_EPUB] = &epub_format_interface;
     format_registry[BOOK_FORMAT_PDF] = &pdf_format_interface;
+    format_registry[BOOK_FORMAT_ERB] = &erb_format_interface;
+
+    /* Metadata is read from several threads during a library scan */
+    epub_init();
     return FORMAT_SUCCESS;
 }
 
 const book_format_interface_t* format_get_interface(book_format_type_t type) {
-    if (type <= BOOK_FORMAT_UNKNOWN || type > BOOK_FORMAT_PDF) {
+    if (type <= BOOK_FORMAT_UNKNOWN || type > BOOK_FORMAT_ERB) {
         return NULL;
     }
     return format_registry[type];
@@ -85,12 +98,14 @@ book_format_type_t format_detect_type(const char *filename) {
     }
 
     /* Check each format (case-insensitive) */
-    if (strcasecmp(ext, ".txt") == 0) {
+    if (strcasecmp(ext, ".txt") == 0 || txt_gz_is_gz_file(filename)) {
         return BOOK_FORMAT_TXT;
     } else if (strcasecmp(ext, ".epub") == 0) {
         return BOOK_FORMAT_EPUB;
     } else if (strcasecmp(ext, ".pdf") == 0) {
         return BOOK_FORMAT_PDF;
+    } else if (strcasecmp(ext, ".erb") == 0) {
+        return BOOK_FORMAT_ERB;
     }
 
     return BOOK_FORMAT_UNKNOWN;
@@ -104,6 +119,8 @@ const char* format_get_type_name(book_format_type_t type) {
             return "EPUB";
         case BOOK_FORMAT_PDF:
             return "PDF";
+        case BOOK_FORMAT_ERB:
+            return "ERB";
         case BOOK_FORMAT_UNKNOWN:
         default:
             return "Unknown";
@@ -118,6 +135,8 @@ char format_get_type_indicator(book_format_type_t type) {
             return 'E';
         case BOOK_FORMAT_PDF:
             return 'P';
+        case BOOK_FORMAT_ERB:
+            return 'B';
         case BOOK_FORMAT_UNKNOWN:
         default:
             return '?';
@@ -153,3 +172,217 @@ const char* format_error_string(format_error_t error) {
             return "Unknown error";
     }
 }
+
+/*
+ * Metadata
+ */
+
+int format_read_metadata(const book_format_interface_t *interface, const char *filepath,
+                         format_metadata_t *metadata) {
+    if (!interface || !filepath || !metadata) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    if (interface->read_metadata) {
+        return interface->read_metadata(filepath, metadata);
+    }
+    if (!interface->open || !interface->get_metadata || !interface->close) {
+        return FORMAT_ERROR_UNSUPPORTED;
+    }
+
+    format_handle_t handle = interface->open(filepath);
+    if (!handle) {
+        return FORMAT_ERROR_READ_FAILED;
+    }
+    int result = interface->get_metadata(handle, metadata);
+    interface->close(handle);
+    return result;
+}
+
+/*
+ * Random-Access Text
+ */
+
+/* Whole text of a format without chunk_at(), extracting it if needed */
+static int format_whole_text(const book_format_interface_t *interface, format_handle_t handle,
+                             const char **out_text, size_t *out_length) {
+    if (interface->get_text(handle, out_text, out_length) == FORMAT_SUCCESS) {
+        return FORMAT_SUCCESS;
+    }
+
+    int result = interface->extract_text(handle);
+    if (result != FORMAT_SUCCESS) {
+        return result;
+    }
+    return interface->get_text(handle, out_text, out_length);
+}
+
+int format_get_length(const book_format_interface_t *interface, format_handle_t handle,
+                      size_t *out_length) {
+    if (!interface || !handle || !out_length) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    if (interface->get_length) {
+        return interface->get_length(handle, out_length);
+    }
+
+    const char *text;
+    return format_whole_text(interface, handle, &text, out_length);
+}
+
+int format_chunk_at(const book_format_interface_t *interface, format_handle_t handle,
+                    size_t offset, format_chunk_t *chunk) {
+    if (!interface || !handle || !chunk) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    if (interface->chunk_at) {
+        return interface->chunk_at(handle, offset, chunk);
+    }
+
+    const char *text;
+    size_t length;
+    int result = format_whole_text(interface, handle, &text, &length);
+    if (result != FORMAT_SUCCESS) {
+        return result;
+    }
+    if (offset >= length) {
+        return FORMAT_ERROR_NO_CONTENT;
+    }
+
+    chunk->text = text;
+    chunk->offset = 0;
+    chunk->length = length;
+    return FORMAT_SUCCESS;
+}
+
+int format_get_page_table(const book_format_interface_t *interface, format_handle_t handle,
+                          uint32_t layout_key, const uint32_t **out_table,
+                          int *out_page_count) {
+    if (!interface || !handle || !out_table || !out_page_count) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    if (!interface->get_page_table) {
+        return FORMAT_ERROR_NO_CONTENT;
+    }
+    return interface->get_page_table(handle, layout_key, out_table, out_page_count);
+}
+
+int format_read_range(const book_format_interface_t *interface, format_handle_t handle,
+                      size_t offset, char *buffer, size_t length, size_t *out_read) {
+    size_t copied = 0;
+
+    if (!buffer || !out_read) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    while (copied < length) {
+        format_chunk_t chunk;
+        int result = format_chunk_at(interface, handle, offset + copied, &chunk);
+        if (result == FORMAT_ERROR_NO_CONTENT) {
+            break;          /* End of text */
+        }
+        if (result != FORMAT_SUCCESS) {
+            return result;
+        }
+
+        size_t start = offset + copied - chunk.offset;
+        size_t n = chunk.length - start;
+        if (n > length - copied) {
+            n = length - copied;
+        }
+        if (chunk.text) {
+            memcpy(buffer + copied, chunk.text + start, n);
+        } else {
+            memset(buffer + copied, '\n', n);
+        }
+        copied += n;
+    }
+
+    *out_read = copied;
+    return FORMAT_SUCCESS;
+}
+
+/*
+ * Mapped Text Files
+ */
+
+int format_map_text(const char *filepath, const char **out_text,
+                    size_t *out_length, size_t *out_map_size) {
+    struct stat st;
+    int fd;
+
+    if (!filepath || !out_text || !out_length || !out_map_size) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    fd = open(filepath, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return (errno == ENOENT) ? FORMAT_ERROR_NOT_FOUND : FORMAT_ERROR_READ_FAILED;
+    }
+
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return FORMAT_ERROR_READ_FAILED;
+    }
+    if (!S_ISREG(st.st_mode)) {
+        close(fd);
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return FORMAT_ERROR_NO_CONTENT;
+    }
+
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    if ((uintmax_t)st.st_size > SIZE_MAX - 2 * page) {
+        close(fd);
+        return FORMAT_ERROR_TOO_LARGE;
+    }
+    size_t length = (size_t)st.st_size;
+
+    /*
+     * Reserve whole pages plus at least one byte of zeroes, then map the
+     * file over the start of the reservation. Bytes past EOF in the file's
+     * last page read as zero, and the anonymous tail covers the case where
+     * the file ends exactly on a page boundary, so text[length] == '\0'.
+     */
+    size_t map_size = (length / page + 1) * page;
+    char *base = mmap(NULL, map_size, PROT_READ,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return (errno == ENOMEM) ? FORMAT_ERROR_TOO_LARGE : FORMAT_ERROR_OUT_OF_MEMORY;
+    }
+
+    int flags = MAP_PRIVATE | MAP_FIXED;
+#ifdef MAP_POPULATE
+    /* The whole book is paginated right after opening; fault it in up front */
+    if (length <= FORMAT_MAP_POPULATE_LIMIT) {
+        flags |= MAP_POPULATE;
+    }
+#endif
+    if (mmap(base, length, PROT_READ, flags, fd, 0) == MAP_FAILED) {
+        fprintf(stderr, "format_map_text: mmap failed for %s: %s\n",
+                filepath, strerror(errno));
+        munmap(base, map_size);
+        close(fd);
+        return FORMAT_ERROR_READ_FAILED;
+    }
+    close(fd);
+
+    madvise(base, length, MADV_SEQUENTIAL);
+
+    *out_text = base;
+    *out_length = length;
+    *out_map_size = map_size;
+    return FORMAT_SUCCESS;
+}
+
+void format_unmap_text(const char *text, size_t map_size) {
+    if (text) {
+        munmap((void *)text, map_size);
+    }
+}
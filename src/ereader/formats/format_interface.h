@@ -40,7 +40,8 @@ typedef enum {
     BOOK_FORMAT_UNKNOWN = 0,
     BOOK_FORMAT_TXT,
     BOOK_FORMAT_EPUB,
-    BOOK_FORMAT_PDF
+    BOOK_FORMAT_PDF,
+    BOOK_FORMAT_ERB
 } book_format_type_t;
 
 /*
@@ -77,6 +78,18 @@ typedef struct {
  */
 typedef void* format_handle_t;
 
+/*
+ * Text Chunk
+ * A contiguous piece of a book's text (a chapter, a PDF page, a whole TXT file).
+ * A blank chunk has no text and stands for length bytes of whitespace, such as
+ * the unused room a PDF page reserves after its text.
+ */
+typedef struct {
+    const char *text;          /* Chunk text (owned by handle, not null-terminated; NULL if blank) */
+    size_t offset;             /* Offset of text[0] within the whole book text */
+    size_t length;             /* Length of the chunk in bytes */
+} format_chunk_t;
+
 /*
  * Book Format Interface
  * Function pointer table for format-specific operations
@@ -135,6 +148,16 @@ typedef struct book_format_interface {
      */
     int (*get_metadata)(format_handle_t handle, format_metadata_t *metadata);
 
+    /*
+     * Read metadata without opening the book (optional; NULL falls back to
+     * open/get_metadata/close)
+     * Lets a library scan skip everything open() prepares for reading.
+     * @param filepath: Path to book file
+     * @param metadata: Output metadata structure
+     * @return: FORMAT_SUCCESS on success, error code on failure
+     */
+    int (*read_metadata)(const char *filepath, format_metadata_t *metadata);
+
     /*
      * Get page count
      * @param handle: Format-specific book handle
@@ -143,6 +166,42 @@ typedef struct book_format_interface {
      */
     int (*get_page_count)(format_handle_t handle);
 
+    /*
+     * Random-access text (optional; NULL falls back to extract_text/get_text)
+     * Chunks tile the book text without gaps, so a format can produce them
+     * lazily and readers only pay for the chunks they touch.
+     */
+
+    /*
+     * Get total text length
+     * @param handle: Format-specific book handle
+     * @param out_length: Output length of the whole book text in bytes
+     * @return: FORMAT_SUCCESS on success, error code on failure
+     */
+    int (*get_length)(format_handle_t handle, size_t *out_length);
+
+    /*
+     * Get the chunk containing an offset
+     * @param handle: Format-specific book handle
+     * @param offset: Byte offset within the book text
+     * @param chunk: Output chunk (valid until the next chunk_at() call or close)
+     * @return: FORMAT_SUCCESS on success, FORMAT_ERROR_NO_CONTENT past the end
+     */
+    int (*chunk_at)(format_handle_t handle, size_t offset, format_chunk_t *chunk);
+
+    /*
+     * Get a precomputed page table (optional; NULL if the format has none)
+     * @param handle: Format-specific book handle
+     * @param layout_key: text_layout_key() of the geometry being laid out
+     * @param out_table: Output page_count rows of (start offset, end offset,
+     *                   line count), owned by handle
+     * @param out_page_count: Output number of pages
+     * @return: FORMAT_SUCCESS if the book has a table for layout_key,
+     *          FORMAT_ERROR_NO_CONTENT otherwise
+     */
+    int (*get_page_table)(format_handle_t handle, uint32_t layout_key,
+                          const uint32_t **out_table, int *out_page_count);
+
 } book_format_interface_t;
 
 /*
@@ -173,7 +232,7 @@ const char* format_get_type_name(book_format_type_t type);
 /**
  * Get format type indicator character for UI display
  * @param type: Format type
- * @return: Single character indicator ('T', 'E', 'P', '?')
+ * @return: Single character indicator ('T', 'E', 'P', 'B', '?')
  */
 char format_get_type_indicator(book_format_type_t type);
 
@@ -191,6 +250,101 @@ int format_is_supported(const char *filename);
  */
 const char* format_error_string(format_error_t error);
 
+/**
+ * Read a book's metadata for listing
+ * Uses read_metadata() when the format has it, otherwise opens the book.
+ * @param interface: Format interface
+ * @param filepath: Path to book file
+ * @param metadata: Output metadata structure
+ * @return: FORMAT_SUCCESS on success, error code otherwise
+ */
+int format_read_metadata(const book_format_interface_t *interface, const char *filepath,
+                         format_metadata_t *metadata);
+
+/*
+ * Random-Access Text
+ * Work with every format: formats without chunk_at() are served as one
+ * chunk holding the text from get_text(), extracted on first use.
+ */
+
+/**
+ * Get total text length of an open book
+ * @param interface: Format interface
+ * @param handle: Book handle from interface->open()
+ * @param out_length: Output length in bytes
+ * @return: FORMAT_SUCCESS on success, error code otherwise
+ */
+int format_get_length(const book_format_interface_t *interface, format_handle_t handle,
+                      size_t *out_length);
+
+/**
+ * Get the chunk of an open book containing an offset
+ * @param interface: Format interface
+ * @param handle: Book handle from interface->open()
+ * @param offset: Byte offset within the book text
+ * @param chunk: Output chunk (valid until the next call for this handle)
+ * @return: FORMAT_SUCCESS on success, FORMAT_ERROR_NO_CONTENT past the end
+ */
+int format_chunk_at(const book_format_interface_t *interface, format_handle_t handle,
+                    size_t offset, format_chunk_t *chunk);
+
+/**
+ * Get the precomputed page table of an open book for a layout
+ * @param interface: Format interface
+ * @param handle: Book handle from interface->open()
+ * @param layout_key: text_layout_key() of the geometry being laid out
+ * @param out_table: Output page_count rows of (start offset, end offset, line count)
+ * @param out_page_count: Output number of pages
+ * @return: FORMAT_SUCCESS if there is one, FORMAT_ERROR_NO_CONTENT otherwise
+ */
+int format_get_page_table(const book_format_interface_t *interface, format_handle_t handle,
+                          uint32_t layout_key, const uint32_t **out_table,
+                          int *out_page_count);
+
+/**
+ * Copy a range of an open book's text
+ * The range may span chunks; it is cut short at the end of the text.
+ * @param interface: Format interface
+ * @param handle: Book handle from interface->open()
+ * @param offset: Byte offset within the book text
+ * @param buffer: Output buffer
+ * @param length: Number of bytes wanted
+ * @param out_read: Output number of bytes copied
+ * @return: FORMAT_SUCCESS on success, error code otherwise
+ */
+int format_read_range(const book_format_interface_t *interface, format_handle_t handle,
+                      size_t offset, char *buffer, size_t length, size_t *out_read);
+
+/*
+ * Mapped Text Files
+ */
+
+/* Files up to this size are pre-faulted when mapped (MAP_POPULATE) */
+#define FORMAT_MAP_POPULATE_LIMIT (16 * 1024 * 1024)
+
+/**
+ * Map a text file read-only into memory
+ * The page cache backs the text directly; nothing is copied to the heap.
+ * The mapping always extends past the last byte, so the text is
+ * null-terminated like a malloc'd buffer would be.
+ * @param filepath: Path to file
+ * @param out_text: Output pointer to mapped text (release with format_unmap_text())
+ * @param out_length: Output length of text in bytes
+ * @param out_map_size: Output size of the mapping, for format_unmap_text()
+ * @return: FORMAT_SUCCESS on success, error code otherwise
+ * @note: The text must not be written to; truncating the file while it is
+ *        mapped makes reads past the new end fault
+ */
+int format_map_text(const char *filepath, const char **out_text,
+                    size_t *out_length, size_t *out_map_size);
+
+/**
+ * Unmap text mapped with format_map_text()
+ * @param text: Mapped text (NULL is ignored)
+ * @param map_size: Mapping size returned by format_map_text()
+ */
+void format_unmap_text(const char *text, size_t map_size);
+
 /**
  * Initialize format system
  * Registers all available format handlers
@@ -0,0 +1,2616 @@
+/*
+ * html_entities.h - HTML5 Named Character References
+ *
+ * Generated by scripts/gen-html-entities.py; do not edit.
+ *
+ * 2125 names in a perfect hash table of 2501 slots: a name hashed with seed 0
+ * picks a displacement bucket, and hashed again with that bucket's seed
+ * picks its slot. Only html_text.c includes this file.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef HTML_ENTITIES_H
+#define HTML_ENTITIES_H
+
+#include <stdint.h>
+
+#define HTML_ENTITY_SLOTS       2501
+#define HTML_ENTITY_BUCKETS     532
+#define HTML_ENTITY_NAME_MAX    31   /* Longest name, without '&' and ';' */
+#define HTML_ENTITY_LEGACY      106
+
+typedef struct {
+    const char *name;          /* Name without '&' and ';' (NULL = empty slot) */
+    char utf8[7];              /* Replacement text, UTF-8 (null-terminated) */
+    uint8_t name_length;
+} html_entity_t;
+
+static const uint16_t html_entity_displacement[HTML_ENTITY_BUCKETS] = {
+    13, 71, 4, 11, 6, 39, 1, 20, 2, 23, 46, 24,
+    1, 35, 7, 10, 15, 95, 74, 19, 69, 9, 6, 1,
+    1, 97, 1, 3, 150, 17, 51, 2, 3, 1, 1, 47,
+    1, 38, 26, 24, 1, 20, 7, 2, 17, 60, 0, 7,
+    3, 1, 49, 3, 1, 7, 2, 70, 1, 1, 2, 10,
+    6, 8, 51, 115, 70, 22, 24, 42, 7, 5, 103, 16,
+    0, 27, 6, 4, 65, 1, 3, 22, 1, 10, 1, 1,
+    1, 6, 2, 20, 24, 3, 66, 20, 23, 12, 14, 3,
+    1, 0, 3, 3, 9, 5, 13, 24, 1, 52, 8, 1,
+    2, 1, 55, 2, 38, 5, 5, 35, 14, 2, 13, 8,
+    149, 1, 18, 69, 14, 15, 11, 0, 21, 10, 67, 50,
+    4, 33, 5, 6, 2, 2, 27, 2, 88, 15, 43, 1,
+    28, 1, 5, 26, 4, 50, 13, 3, 6, 5, 29, 1,
+    3, 16, 6, 52, 8, 2, 10, 4, 127, 21, 59, 2,
+    17, 136, 36, 3, 51, 36, 6, 4, 2, 1, 2, 1,
+    5, 3, 14, 37, 22, 121, 11, 3, 1, 90, 1, 30,
+    8, 1, 65, 1, 3, 71, 17, 72, 5, 18, 117, 3,
+    2, 2, 6, 6, 11, 102, 2, 4, 76, 18, 1, 3,
+    3, 10, 63, 31, 10, 1, 3, 34, 9, 2, 153, 4,
+    78, 3, 5, 1, 6, 27, 5, 1, 8, 47, 58, 1,
+    59, 54, 81, 12, 1, 36, 3, 3, 3, 1, 3, 49,
+    36, 11, 68, 37, 11, 55, 4, 1, 13, 1, 1, 16,
+    8, 17, 1, 7, 2, 6, 87, 41, 12, 2, 10, 17,
+    71, 1, 4, 10, 24, 7, 3, 59, 40, 52, 74, 114,
+    15, 19, 119, 56, 2, 56, 107, 8, 3, 6, 25, 7,
+    7, 29, 144, 4, 73, 0, 5, 74, 6, 51, 15, 147,
+    90, 10, 5, 1, 75, 9, 92, 161, 4, 22, 119, 120,
+    43, 135, 48, 17, 95, 23, 7, 151, 39, 11, 13, 51,
+    71, 3, 30, 7, 8, 110, 39, 147, 4, 5, 1, 70,
+    52, 6, 8, 64, 1, 178, 98, 117, 28, 8, 14, 64,
+    65, 9, 67, 9, 5, 3, 280, 64, 23, 17, 35, 73,
+    29, 0, 92, 74, 54, 45, 5, 35, 72, 28, 6, 154,
+    19, 11, 87, 1, 18, 124, 2, 3, 3, 1, 70, 60,
+    114, 26, 1, 25, 44, 145, 49, 1, 83, 2, 44, 69,
+    3, 23, 4, 99, 20, 28, 1, 18, 15, 4, 3, 2,
+    5, 2, 2, 1, 68, 72, 18, 1, 4, 2, 212, 62,
+    6, 3, 61, 8, 1, 2, 2, 55, 42, 33, 3, 28,
+    397, 9, 198, 80, 205, 9, 2, 25, 92, 96, 20, 3,
+    135, 33, 64, 1, 64, 63, 7, 1, 60, 152, 22, 61,
+    8, 3, 8, 80, 17, 39, 16, 368, 129, 3, 15, 69,
+    27, 44, 36, 13, 76, 6, 1, 186, 15, 16, 23, 10,
+    90, 0, 28, 92, 16, 308, 10, 103, 19, 3, 4, 36,
+    108, 61, 5, 29, 18, 2, 47, 1, 53, 5, 2, 5,
+    22, 16, 270, 17, 1, 9, 0, 15, 70, 5, 35, 3,
+    7, 5, 29, 3,
+};
+
+static const html_entity_t html_entity_table[HTML_ENTITY_SLOTS] = {
+    { "nsupE", "\xe2\xab\x86\xcc\xb8", 5 },
+    { "LeftArrow", "\xe2\x86\x90", 9 },
+    { 0 },
+    { 0 },
+    { "rbarr", "\xe2\xa4\x8d", 5 },
+    { "njcy", "\xd1\x9a", 4 },
+    { "NoBreak", "\xe2\x81\xa0", 7 },
+    { "LJcy", "\xd0\x89", 4 },
+    { "Gcedil", "\xc4\xa2", 6 },
+    { 0 },
+    { 0 },
+    { "ReverseEquilibrium", "\xe2\x87\x8b", 18 },
+    { "DownArrowUpArrow", "\xe2\x87\xb5", 16 },
+    { "iprod", "\xe2\xa8\xbc", 5 },
+    { "uharl", "\xe2\x86\xbf", 5 },
+    { "Rho", "\xce\xa1", 3 },
+    { "gtreqqless", "\xe2\xaa\x8c", 10 },
+    { "ufr", "\xf0\x9d\x94\xb2", 3 },
+    { "nearhk", "\xe2\xa4\xa4", 6 },
+    { "rightarrow", "\xe2\x86\x92", 10 },
+    { "Not", "\xe2\xab\xac", 3 },
+    { "flat", "\xe2\x99\xad", 4 },
+    { "ltcc", "\xe2\xaa\xa6", 4 },
+    { "lcy", "\xd0\xbb", 3 },
+    { 0 },
+    { 0 },
+    { "times", "\xc3\x97", 5 },
+    { "ExponentialE", "\xe2\x85\x87", 12 },
+    { "NotPrecedesSlantEqual", "\xe2\x8b\xa0", 21 },
+    { "nrightarrow", "\xe2\x86\x9b", 11 },
+    { "DoubleContourIntegral", "\xe2\x88\xaf", 21 },
+    { "boxHu", "\xe2\x95\xa7", 5 },
+    { "otimes", "\xe2\x8a\x97", 6 },
+    { "DoubleDot", "\xc2\xa8", 9 },
+    { "Upsi", "\xcf\x92", 4 },
+    { "curlyeqprec", "\xe2\x8b\x9e", 11 },
+    { "iogon", "\xc4\xaf", 5 },
+    { "VeryThinSpace", "\xe2\x80\x8a", 13 },
+    { "THORN", "\xc3\x9e", 5 },
+    { 0 },
+    { "iff", "\xe2\x87\x94", 3 },
+    { "subseteqq", "\xe2\xab\x85", 9 },
+    { "nesear", "\xe2\xa4\xa8", 6 },
+    { "Sscr", "\xf0\x9d\x92\xae", 4 },
+    { "centerdot", "\xc2\xb7", 9 },
+    { "Lsh", "\xe2\x86\xb0", 3 },
+    { "larrsim", "\xe2\xa5\xb3", 7 },
+    { "rlm", "\xe2\x80\x8f", 3 },
+    { "congdot", "\xe2\xa9\xad", 7 },
+    { "bigtriangledown", "\xe2\x96\xbd", 15 },
+    { "angmsdaf", "\xe2\xa6\xad", 8 },
+    { "gamma", "\xce\xb3", 5 },
+    { "ogt", "\xe2\xa7\x81", 3 },
+    { 0 },
+    { "DownRightVectorBar", "\xe2\xa5\x97", 18 },
+    { "GT", ">", 2 },
+    { "submult", "\xe2\xab\x81", 7 },
+    { "timesb", "\xe2\x8a\xa0", 6 },
+    { "and", "\xe2\x88\xa7", 3 },
+    { "simdot", "\xe2\xa9\xaa", 6 },
+    { "olcir", "\xe2\xa6\xbe", 5 },
+    { "map", "\xe2\x86\xa6", 3 },
+    { "ntriangleleft", "\xe2\x8b\xaa", 13 },
+    { "empty", "\xe2\x88\x85", 5 },
+    { "gcirc", "\xc4\x9d", 5 },
+    { "PartialD", "\xe2\x88\x82", 8 },
+    { "hksearow", "\xe2\xa4\xa5", 8 },
+    { "rcy", "\xd1\x80", 3 },
+    { "ropf", "\xf0\x9d\x95\xa3", 4 },
+    { "swarrow", "\xe2\x86\x99", 7 },
+    { 0 },
+    { "supplus", "\xe2\xab\x80", 7 },
+    { "ggg", "\xe2\x8b\x99", 3 },
+    { "nvgt", ">\xe2\x83\x92", 4 },
+    { "hellip", "\xe2\x80\xa6", 6 },
+    { "ddarr", "\xe2\x87\x8a", 5 },
+    { "suplarr", "\xe2\xa5\xbb", 7 },
+    { "scpolint", "\xe2\xa8\x93", 8 },
+    { "Dstrok", "\xc4\x90", 6 },
+    { 0 },
+    { "aogon", "\xc4\x85", 5 },
+    { "sccue", "\xe2\x89\xbd", 5 },
+    { "vdash", "\xe2\x8a\xa2", 5 },
+    { "Imacr", "\xc4\xaa", 5 },
+    { "rdquo", "\xe2\x80\x9d", 5 },
+    { "beta", "\xce\xb2", 4 },
+    { 0 },
+    { "lang", "\xe2\x9f\xa8", 4 },
+    { "sect", "\xc2\xa7", 4 },
+    { "bscr", "\xf0\x9d\x92\xb7", 4 },
+    { "prnE", "\xe2\xaa\xb5", 4 },
+    { 0 },
+    { "cirfnint", "\xe2\xa8\x90", 8 },
+    { "trianglerighteq", "\xe2\x8a\xb5", 15 },
+    { "IOcy", "\xd0\x81", 4 },
+    { "uHar", "\xe2\xa5\xa3", 4 },
+    { "boxdR", "\xe2\x95\x92", 5 },
+    { "ouml", "\xc3\xb6", 4 },
+    { "xvee", "\xe2\x8b\x81", 4 },
+    { "Aogon", "\xc4\x84", 5 },
+    { 0 },
+    { "Gcirc", "\xc4\x9c", 5 },
+    { "dArr", "\xe2\x87\x93", 4 },
+    { "compfn", "\xe2\x88\x98", 6 },
+    { "eparsl", "\xe2\xa7\xa3", 6 },
+    { "lap", "\xe2\xaa\x85", 3 },
+    { "nu", "\xce\xbd", 2 },
+    { "nlarr", "\xe2\x86\x9a", 5 },
+    { "ucy", "\xd1\x83", 3 },
+    { "Dot", "\xc2\xa8", 3 },
+    { "nLl", "\xe2\x8b\x98\xcc\xb8", 3 },
+    { "laemptyv", "\xe2\xa6\xb4", 8 },
+    { 0 },
+    { "Lcy", "\xd0\x9b", 3 },
+    { "drcorn", "\xe2\x8c\x9f", 6 },
+    { "prnsim", "\xe2\x8b\xa8", 6 },
+    { "UpArrowBar", "\xe2\xa4\x92", 10 },
+    { "backepsilon", "\xcf\xb6", 11 },
+    { "Assign", "\xe2\x89\x94", 6 },
+    { "bowtie", "\xe2\x8b\x88", 6 },
+    { "eDot", "\xe2\x89\x91", 4 },
+    { "Wedge", "\xe2\x8b\x80", 5 },
+    { "olt", "\xe2\xa7\x80", 3 },
+    { "bcy", "\xd0\xb1", 3 },
+    { "lHar", "\xe2\xa5\xa2", 4 },
+    { "eqslantless", "\xe2\xaa\x95", 11 },
+    { "ssetmn", "\xe2\x88\x96", 6 },
+    { "nvrArr", "\xe2\xa4\x83", 6 },
+    { 0 },
+    { "ltdot", "\xe2\x8b\x96", 5 },
+    { "plusdo", "\xe2\x88\x94", 6 },
+    { "nvlArr", "\xe2\xa4\x82", 6 },
+    { 0 },
+    { "Prime", "\xe2\x80\xb3", 5 },
+    { "jmath", "\xc8\xb7", 5 },
+    { "Sqrt", "\xe2\x88\x9a", 4 },
+    { 0 },
+    { "dtdot", "\xe2\x8b\xb1", 5 },
+    { "angmsdaa", "\xe2\xa6\xa8", 8 },
+    { "zcaron", "\xc5\xbe", 6 },
+    { "PrecedesTilde", "\xe2\x89\xbe", 13 },
+    { 0 },
+    { "bump", "\xe2\x89\x8e", 4 },
+    { 0 },
+    { "aopf", "\xf0\x9d\x95\x92", 4 },
+    { "bemptyv", "\xe2\xa6\xb0", 7 },
+    { "dollar", "$", 6 },
+    { "lvnE", "\xe2\x89\xa8\xef\xb8\x80", 4 },
+    { "boxVR", "\xe2\x95\xa0", 5 },
+    { "cwconint", "\xe2\x88\xb2", 8 },
+    { "crarr", "\xe2\x86\xb5", 5 },
+    { 0 },
+    { "prop", "\xe2\x88\x9d", 4 },
+    { "mfr", "\xf0\x9d\x94\xaa", 3 },
+    { "OverBracket", "\xe2\x8e\xb4", 11 },
+    { "Jukcy", "\xd0\x84", 5 },
+    { "NotLeftTriangleBar", "\xe2\xa7\x8f\xcc\xb8", 18 },
+    { "frac16", "\xe2\x85\x99", 6 },
+    { 0 },
+    { "Gdot", "\xc4\xa0", 4 },
+    { 0 },
+    { 0 },
+    { "LongLeftRightArrow", "\xe2\x9f\xb7", 18 },
+    { 0 },
+    { "rAarr", "\xe2\x87\x9b", 5 },
+    { "sup2", "\xc2\xb2", 4 },
+    { "rbrace", "}", 6 },
+    { "tridot", "\xe2\x97\xac", 6 },
+    { "ShortRightArrow", "\xe2\x86\x92", 15 },
+    { "Xscr", "\xf0\x9d\x92\xb3", 4 },
+    { "kgreen", "\xc4\xb8", 6 },
+    { "nsmid", "\xe2\x88\xa4", 5 },
+    { "Egrave", "\xc3\x88", 6 },
+    { "lescc", "\xe2\xaa\xa8", 5 },
+    { "mapstodown", "\xe2\x86\xa7", 10 },
+    { "bsolhsub", "\xe2\x9f\x88", 8 },
+    { "plusacir", "\xe2\xa8\xa3", 8 },
+    { 0 },
+    { 0 },
+    { "pointint", "\xe2\xa8\x95", 8 },
+    { "Epsilon", "\xce\x95", 7 },
+    { "Mscr", "\xe2\x84\xb3", 4 },
+    { "boxHd", "\xe2\x95\xa4", 5 },
+    { "topfork", "\xe2\xab\x9a", 7 },
+    { 0 },
+    { "NotGreaterSlantEqual", "\xe2\xa9\xbe\xcc\xb8", 20 },
+    { "backprime", "\xe2\x80\xb5", 9 },
+    { "Mu", "\xce\x9c", 2 },
+    { "phmmat", "\xe2\x84\xb3", 6 },
+    { "gEl", "\xe2\xaa\x8c", 3 },
+    { "RightTeeArrow", "\xe2\x86\xa6", 13 },
+    { 0 },
+    { "Umacr", "\xc5\xaa", 5 },
+    { "circleddash", "\xe2\x8a\x9d", 11 },
+    { "ee", "\xe2\x85\x87", 2 },
+    { "TildeEqual", "\xe2\x89\x83", 10 },
+    { "boxdl", "\xe2\x94\x90", 5 },
+    { "tshcy", "\xd1\x9b", 5 },
+    { "rArr", "\xe2\x87\x92", 4 },
+    { "vnsub", "\xe2\x8a\x82\xe2\x83\x92", 5 },
+    { "GreaterSlantEqual", "\xe2\xa9\xbe", 17 },
+    { "qfr", "\xf0\x9d\x94\xae", 3 },
+    { "Integral", "\xe2\x88\xab", 8 },
+    { "supnE", "\xe2\xab\x8c", 5 },
+    { "leg", "\xe2\x8b\x9a", 3 },
+    { "vBarv", "\xe2\xab\xa9", 5 },
+    { "angsph", "\xe2\x88\xa2", 6 },
+    { "forkv", "\xe2\xab\x99", 5 },
+    { "darr", "\xe2\x86\x93", 4 },
+    { "smallsetminus", "\xe2\x88\x96", 13 },
+    { "rHar", "\xe2\xa5\xa4", 4 },
+    { "seswar", "\xe2\xa4\xa9", 6 },
+    { "upsi", "\xcf\x85", 4 },
+    { "bumpe", "\xe2\x89\x8f", 5 },
+    { "larr", "\xe2\x86\x90", 4 },
+    { 0 },
+    { 0 },
+    { "latail", "\xe2\xa4\x99", 6 },
+    { 0 },
+    { "kscr", "\xf0\x9d\x93\x80", 4 },
+    { "comp", "\xe2\x88\x81", 4 },
+    { "nrarr", "\xe2\x86\x9b", 5 },
+    { "Aring", "\xc3\x85", 5 },
+    { "sqsupseteq", "\xe2\x8a\x92", 10 },
+    { 0 },
+    { 0 },
+    { "efr", "\xf0\x9d\x94\xa2", 3 },
+    { "bull", "\xe2\x80\xa2", 4 },
+    { "larrhk", "\xe2\x86\xa9", 6 },
+    { "ntrianglerighteq", "\xe2\x8b\xad", 16 },
+    { "imped", "\xc6\xb5", 5 },
+    { "nap", "\xe2\x89\x89", 3 },
+    { "twoheadleftarrow", "\xe2\x86\x9e", 16 },
+    { "trpezium", "\xe2\x8f\xa2", 8 },
+    { "notinva", "\xe2\x88\x89", 7 },
+    { "Bcy", "\xd0\x91", 3 },
+    { "ultri", "\xe2\x97\xb8", 5 },
+    { "Vdash", "\xe2\x8a\xa9", 5 },
+    { "perp", "\xe2\x8a\xa5", 4 },
+    { "nLtv", "\xe2\x89\xaa\xcc\xb8", 4 },
+    { 0 },
+    { 0 },
+    { "NotGreaterLess", "\xe2\x89\xb9", 14 },
+    { "excl", "!", 4 },
+    { "boxhd", "\xe2\x94\xac", 5 },
+    { "supe", "\xe2\x8a\x87", 4 },
+    { "radic", "\xe2\x88\x9a", 5 },
+    { "bigtriangleup", "\xe2\x96\xb3", 13 },
+    { "hercon", "\xe2\x8a\xb9", 6 },
+    { 0 },
+    { "subsub", "\xe2\xab\x95", 6 },
+    { "SquareIntersection", "\xe2\x8a\x93", 18 },
+    { "UnionPlus", "\xe2\x8a\x8e", 9 },
+    { "caret", "\xe2\x81\x81", 5 },
+    { "vee", "\xe2\x88\xa8", 3 },
+    { "alefsym", "\xe2\x84\xb5", 7 },
+    { 0 },
+    { "Uparrow", "\xe2\x87\x91", 7 },
+    { "notinvc", "\xe2\x8b\xb6", 7 },
+    { "lAarr", "\xe2\x87\x9a", 5 },
+    { "checkmark", "\xe2\x9c\x93", 9 },
+    { "notniva", "\xe2\x88\x8c", 7 },
+    { 0 },
+    { "iiiint", "\xe2\xa8\x8c", 6 },
+    { "Proportional", "\xe2\x88\x9d", 12 },
+    { 0 },
+    { "oror", "\xe2\xa9\x96", 4 },
+    { "rdquor", "\xe2\x80\x9d", 6 },
+    { "Downarrow", "\xe2\x87\x93", 9 },
+    { "iexcl", "\xc2\xa1", 5 },
+    { "isins", "\xe2\x8b\xb4", 5 },
+    { "downdownarrows", "\xe2\x87\x8a", 14 },
+    { "becaus", "\xe2\x88\xb5", 6 },
+    { "gesdotol", "\xe2\xaa\x84", 8 },
+    { "nvap", "\xe2\x89\x8d\xe2\x83\x92", 4 },
+    { "oast", "\xe2\x8a\x9b", 4 },
+    { 0 },
+    { "nleqq", "\xe2\x89\xa6\xcc\xb8", 5 },
+    { "ETH", "\xc3\x90", 3 },
+    { "Mellintrf", "\xe2\x84\xb3", 9 },
+    { "Jcirc", "\xc4\xb4", 5 },
+    { "prsim", "\xe2\x89\xbe", 5 },
+    { "NotLessEqual", "\xe2\x89\xb0", 12 },
+    { "vfr", "\xf0\x9d\x94\xb3", 3 },
+    { "xodot", "\xe2\xa8\x80", 5 },
+    { "sub", "\xe2\x8a\x82", 3 },
+    { "LeftVector", "\xe2\x86\xbc", 10 },
+    { "rfloor", "\xe2\x8c\x8b", 6 },
+    { "DoubleLongLeftArrow", "\xe2\x9f\xb8", 19 },
+    { "micro", "\xc2\xb5", 5 },
+    { "isinv", "\xe2\x88\x88", 5 },
+    { "ngtr", "\xe2\x89\xaf", 4 },
+    { "lnapprox", "\xe2\xaa\x89", 8 },
+    { 0 },
+    { "straightphi", "\xcf\x95", 11 },
+    { "eogon", "\xc4\x99", 5 },
+    { "circledast", "\xe2\x8a\x9b", 10 },
+    { "CHcy", "\xd0\xa7", 4 },
+    { "acute", "\xc2\xb4", 5 },
+    { "rightrightarrows", "\xe2\x87\x89", 16 },
+    { "semi", ";", 4 },
+    { "zdot", "\xc5\xbc", 4 },
+    { "boxvl", "\xe2\x94\xa4", 5 },
+    { 0 },
+    { "imagline", "\xe2\x84\x90", 8 },
+    { "nvDash", "\xe2\x8a\xad", 6 },
+    { "operp", "\xe2\xa6\xb9", 5 },
+    { "SuchThat", "\xe2\x88\x8b", 8 },
+    { "raquo", "\xc2\xbb", 5 },
+    { "SOFTcy", "\xd0\xac", 6 },
+    { 0 },
+    { "Tfr", "\xf0\x9d\x94\x97", 3 },
+    { "DoubleLeftArrow", "\xe2\x87\x90", 15 },
+    { "dscr", "\xf0\x9d\x92\xb9", 4 },
+    { "subplus", "\xe2\xaa\xbf", 7 },
+    { "qscr", "\xf0\x9d\x93\x86", 4 },
+    { "Atilde", "\xc3\x83", 6 },
+    { "uopf", "\xf0\x9d\x95\xa6", 4 },
+    { 0 },
+    { "sup", "\xe2\x8a\x83", 3 },
+    { 0 },
+    { "nLt", "\xe2\x89\xaa\xe2\x83\x92", 3 },
+    { 0 },
+    { "bbrktbrk", "\xe2\x8e\xb6", 8 },
+    { "nlE", "\xe2\x89\xa6\xcc\xb8", 3 },
+    { 0 },
+    { "lnE", "\xe2\x89\xa8", 3 },
+    { 0 },
+    { "ddagger", "\xe2\x80\xa1", 7 },
+    { "DotDot", "\xe2\x83\x9c", 6 },
+    { "nleq", "\xe2\x89\xb0", 4 },
+    { "amp", "&", 3 },
+    { "vscr", "\xf0\x9d\x93\x8b", 4 },
+    { "Jopf", "\xf0\x9d\x95\x81", 4 },
+    { 0 },
+    { "erDot", "\xe2\x89\x93", 5 },
+    { "leq", "\xe2\x89\xa4", 3 },
+    { "doteq", "\xe2\x89\x90", 5 },
+    { "spades", "\xe2\x99\xa0", 6 },
+    { 0 },
+    { "Darr", "\xe2\x86\xa1", 4 },
+    { 0 },
+    { "NotRightTriangleEqual", "\xe2\x8b\xad", 21 },
+    { "Oopf", "\xf0\x9d\x95\x86", 4 },
+    { "boxVl", "\xe2\x95\xa2", 5 },
+    { 0 },
+    { "gjcy", "\xd1\x93", 4 },
+    { "natural", "\xe2\x99\xae", 7 },
+    { "image", "\xe2\x84\x91", 5 },
+    { "TildeFullEqual", "\xe2\x89\x85", 14 },
+    { "plus", "+", 4 },
+    { "SquareSupersetEqual", "\xe2\x8a\x92", 19 },
+    { "dot", "\xcb\x99", 3 },
+    { "SquareSubset", "\xe2\x8a\x8f", 12 },
+    { "yacute", "\xc3\xbd", 6 },
+    { "les", "\xe2\xa9\xbd", 3 },
+    { "Gt", "\xe2\x89\xab", 2 },
+    { "notindot", "\xe2\x8b\xb5\xcc\xb8", 8 },
+    { "angle", "\xe2\x88\xa0", 5 },
+    { "mcomma", "\xe2\xa8\xa9", 6 },
+    { "fallingdotseq", "\xe2\x89\x92", 13 },
+    { "sup1", "\xc2\xb9", 4 },
+    { "imagpart", "\xe2\x84\x91", 8 },
+    { "cemptyv", "\xe2\xa6\xb2", 7 },
+    { "fjlig", "fj", 5 },
+    { "verbar", "|", 6 },
+    { "plusb", "\xe2\x8a\x9e", 5 },
+    { "cupbrcap", "\xe2\xa9\x88", 8 },
+    { 0 },
+    { "Yacute", "\xc3\x9d", 6 },
+    { 0 },
+    { 0 },
+    { 0 },
+    { "csube", "\xe2\xab\x91", 5 },
+    { "iiota", "\xe2\x84\xa9", 5 },
+    { "RightUpTeeVector", "\xe2\xa5\x9c", 16 },
+    { 0 },
+    { "mopf", "\xf0\x9d\x95\x9e", 4 },
+    { "LeftTriangleEqual", "\xe2\x8a\xb4", 17 },
+    { "rightarrowtail", "\xe2\x86\xa3", 14 },
+    { "Tscr", "\xf0\x9d\x92\xaf", 4 },
+    { "bigsqcup", "\xe2\xa8\x86", 8 },
+    { "sqcups", "\xe2\x8a\x94\xef\xb8\x80", 6 },
+    { "lrm", "\xe2\x80\x8e", 3 },
+    { "rbrkslu", "\xe2\xa6\x90", 7 },
+    { "frac25", "\xe2\x85\x96", 6 },
+    { "lsquo", "\xe2\x80\x98", 5 },
+    { "leftthreetimes", "\xe2\x8b\x8b", 14 },
+    { "SubsetEqual", "\xe2\x8a\x86", 11 },
+    { "Backslash", "\xe2\x88\x96", 9 },
+    { "loz", "\xe2\x97\x8a", 3 },
+    { "emsp", "\xe2\x80\x83", 4 },
+    { "sime", "\xe2\x89\x83", 4 },
+    { "cupdot", "\xe2\x8a\x8d", 6 },
+    { 0 },
+    { "Dscr", "\xf0\x9d\x92\x9f", 4 },
+    { "gtrapprox", "\xe2\xaa\x86", 9 },
+    { "xlArr", "\xe2\x9f\xb8", 5 },
+    { "Theta", "\xce\x98", 5 },
+    { "euml", "\xc3\xab", 4 },
+    { "ecirc", "\xc3\xaa", 5 },
+    { "otimesas", "\xe2\xa8\xb6", 8 },
+    { 0 },
+    { "TSHcy", "\xd0\x8b", 5 },
+    { "Product", "\xe2\x88\x8f", 7 },
+    { "ccedil", "\xc3\xa7", 6 },
+    { "RightDownVectorBar", "\xe2\xa5\x95", 18 },
+    { "NonBreakingSpace", "\xc2\xa0", 16 },
+    { "brvbar", "\xc2\xa6", 6 },
+    { "iacute", "\xc3\xad", 6 },
+    { "dzigrarr", "\xe2\x9f\xbf", 8 },
+    { "Gfr", "\xf0\x9d\x94\x8a", 3 },
+    { "DownLeftRightVector", "\xe2\xa5\x90", 19 },
+    { "Jsercy", "\xd0\x88", 6 },
+    { "Lacute", "\xc4\xb9", 6 },
+    { "npre", "\xe2\xaa\xaf\xcc\xb8", 4 },
+    { "nsucc", "\xe2\x8a\x81", 5 },
+    { "kcedil", "\xc4\xb7", 6 },
+    { "rlarr", "\xe2\x87\x84", 5 },
+    { 0 },
+    { "barvee", "\xe2\x8a\xbd", 6 },
+    { "longleftarrow", "\xe2\x9f\xb5", 13 },
+    { "kjcy", "\xd1\x9c", 4 },
+    { "LeftDoubleBracket", "\xe2\x9f\xa6", 17 },
+    { "triplus", "\xe2\xa8\xb9", 7 },
+    { "leftleftarrows", "\xe2\x87\x87", 14 },
+    { "iquest", "\xc2\xbf", 6 },
+    { "cularr", "\xe2\x86\xb6", 6 },
+    { 0 },
+    { "Zeta", "\xce\x96", 4 },
+    { "lozf", "\xe2\xa7\xab", 4 },
+    { "gnsim", "\xe2\x8b\xa7", 5 },
+    { "LessEqualGreater", "\xe2\x8b\x9a", 16 },
+    { "LessTilde", "\xe2\x89\xb2", 9 },
+    { "bottom", "\xe2\x8a\xa5", 6 },
+    { "varsubsetneqq", "\xe2\xab\x8b\xef\xb8\x80", 13 },
+    { "nparallel", "\xe2\x88\xa6", 9 },
+    { "lesdotor", "\xe2\xaa\x83", 8 },
+    { "rbrack", "]", 6 },
+    { "coloneq", "\xe2\x89\x94", 7 },
+    { "dtrif", "\xe2\x96\xbe", 5 },
+    { "cuvee", "\xe2\x8b\x8e", 5 },
+    { 0 },
+    { "oline", "\xe2\x80\xbe", 5 },
+    { "uharr", "\xe2\x86\xbe", 5 },
+    { "RightAngleBracket", "\xe2\x9f\xa9", 17 },
+    { "grave", "`", 5 },
+    { "iukcy", "\xd1\x96", 5 },
+    { "leqq", "\xe2\x89\xa6", 4 },
+    { "mstpos", "\xe2\x88\xbe", 6 },
+    { "simlE", "\xe2\xaa\x9f", 5 },
+    { "nequiv", "\xe2\x89\xa2", 6 },
+    { 0 },
+    { "Because", "\xe2\x88\xb5", 7 },
+    { "eopf", "\xf0\x9d\x95\x96", 4 },
+    { "Tstrok", "\xc5\xa6", 6 },
+    { "nsubset", "\xe2\x8a\x82\xe2\x83\x92", 7 },
+    { "tosa", "\xe2\xa4\xa9", 4 },
+    { "vopf", "\xf0\x9d\x95\xa7", 4 },
+    { "udhar", "\xe2\xa5\xae", 5 },
+    { "supedot", "\xe2\xab\x84", 7 },
+    { "chi", "\xcf\x87", 3 },
+    { "qint", "\xe2\xa8\x8c", 4 },
+    { "Gopf", "\xf0\x9d\x94\xbe", 4 },
+    { "aelig", "\xc3\xa6", 5 },
+    { "divide", "\xc3\xb7", 6 },
+    { "lurdshar", "\xe2\xa5\x8a", 8 },
+    { "gl", "\xe2\x89\xb7", 2 },
+    { "block", "\xe2\x96\x88", 5 },
+    { "target", "\xe2\x8c\x96", 6 },
+    { 0 },
+    { "cupor", "\xe2\xa9\x85", 5 },
+    { "incare", "\xe2\x84\x85", 6 },
+    { "gdot", "\xc4\xa1", 4 },
+    { "hearts", "\xe2\x99\xa5", 6 },
+    { "lsh", "\xe2\x86\xb0", 3 },
+    { "NotSuperset", "\xe2\x8a\x83\xe2\x83\x92", 11 },
+    { 0 },
+    { 0 },
+    { "Phi", "\xce\xa6", 3 },
+    { "Omacr", "\xc5\x8c", 5 },
+    { "iiint", "\xe2\x88\xad", 5 },
+    { 0 },
+    { 0 },
+    { "succapprox", "\xe2\xaa\xb8", 10 },
+    { "hslash", "\xe2\x84\x8f", 6 },
+    { "urcrop", "\xe2\x8c\x8e", 6 },
+    { "QUOT", "\x22", 4 },
+    { "check", "\xe2\x9c\x93", 5 },
+    { "ogon", "\xcb\x9b", 4 },
+    { 0 },
+    { "Ll", "\xe2\x8b\x98", 2 },
+    { 0 },
+    { "sc", "\xe2\x89\xbb", 2 },
+    { "urtri", "\xe2\x97\xb9", 5 },
+    { 0 },
+    { "tscy", "\xd1\x86", 4 },
+    { "minusdu", "\xe2\xa8\xaa", 7 },
+    { "lozenge", "\xe2\x97\x8a", 7 },
+    { "Ucirc", "\xc3\x9b", 5 },
+    { "NotLessGreater", "\xe2\x89\xb8", 14 },
+    { 0 },
+    { "top", "\xe2\x8a\xa4", 3 },
+    { 0 },
+    { "notnivc", "\xe2\x8b\xbd", 7 },
+    { "hkswarow", "\xe2\xa4\xa6", 8 },
+    { "varpropto", "\xe2\x88\x9d", 9 },
+    { "Emacr", "\xc4\x92", 5 },
+    { "LeftVectorBar", "\xe2\xa5\x92", 13 },
+    { "LeftRightArrow", "\xe2\x86\x94", 14 },
+    { "boxDr", "\xe2\x95\x93", 5 },
+    { "Wcirc", "\xc5\xb4", 5 },
+    { "nedot", "\xe2\x89\x90\xcc\xb8", 5 },
+    { "tritime", "\xe2\xa8\xbb", 7 },
+    { "telrec", "\xe2\x8c\x95", 6 },
+    { "olarr", "\xe2\x86\xba", 5 },
+    { "Sfr", "\xf0\x9d\x94\x96", 3 },
+    { "Oscr", "\xf0\x9d\x92\xaa", 4 },
+    { "ne", "\xe2\x89\xa0", 2 },
+    { "ReverseElement", "\xe2\x88\x8b", 14 },
+    { "blk12", "\xe2\x96\x92", 5 },
+    { "Bfr", "\xf0\x9d\x94\x85", 3 },
+    { 0 },
+    { "eta", "\xce\xb7", 3 },
+    { 0 },
+    { "ddotseq", "\xe2\xa9\xb7", 7 },
+    { 0 },
+    { "glj", "\xe2\xaa\xa4", 3 },
+    { 0 },
+    { 0 },
+    { "bumpeq", "\xe2\x89\x8f", 6 },
+    { "Congruent", "\xe2\x89\xa1", 9 },
+    { 0 },
+    { "circlearrowright", "\xe2\x86\xbb", 16 },
+    { "nless", "\xe2\x89\xae", 5 },
+    { 0 },
+    { "Rcedil", "\xc5\x96", 6 },
+    { "pertenk", "\xe2\x80\xb1", 7 },
+    { "omacr", "\xc5\x8d", 5 },
+    { "lceil", "\xe2\x8c\x88", 5 },
+    { "Yscr", "\xf0\x9d\x92\xb4", 4 },
+    { "dotminus", "\xe2\x88\xb8", 8 },
+    { "uogon", "\xc5\xb3", 5 },
+    { "larrbfs", "\xe2\xa4\x9f", 7 },
+    { "boxvH", "\xe2\x95\xaa", 5 },
+    { 0 },
+    { "nesim", "\xe2\x89\x82\xcc\xb8", 5 },
+    { "lrarr", "\xe2\x87\x86", 5 },
+    { "boxHD", "\xe2\x95\xa6", 5 },
+    { "igrave", "\xc3\xac", 6 },
+    { "Xopf", "\xf0\x9d\x95\x8f", 4 },
+    { "TRADE", "\xe2\x84\xa2", 5 },
+    { "sdotb", "\xe2\x8a\xa1", 5 },
+    { "ap", "\xe2\x89\x88", 2 },
+    { "RightCeiling", "\xe2\x8c\x89", 12 },
+    { "NotTildeEqual", "\xe2\x89\x84", 13 },
+    { "nLeftarrow", "\xe2\x87\x8d", 10 },
+    { "ruluhar", "\xe2\xa5\xa8", 7 },
+    { "subsup", "\xe2\xab\x93", 6 },
+    { "RightDoubleBracket", "\xe2\x9f\xa7", 18 },
+    { "notni", "\xe2\x88\x8c", 5 },
+    { "DDotrahd", "\xe2\xa4\x91", 8 },
+    { "NotSquareSubset", "\xe2\x8a\x8f\xcc\xb8", 15 },
+    { 0 },
+    { "VerticalLine", "|", 12 },
+    { 0 },
+    { "VerticalSeparator", "\xe2\x9d\x98", 17 },
+    { "sigmaf", "\xcf\x82", 6 },
+    { "rfr", "\xf0\x9d\x94\xaf", 3 },
+    { "backsim", "\xe2\x88\xbd", 7 },
+    { "eg", "\xe2\xaa\x9a", 2 },
+    { "varpi", "\xcf\x96", 5 },
+    { "gel", "\xe2\x8b\x9b", 3 },
+    { 0 },
+    { 0 },
+    { 0 },
+    { 0 },
+    { "NotNestedGreaterGreater", "\xe2\xaa\xa2\xcc\xb8", 23 },
+    { "lsimg", "\xe2\xaa\x8f", 5 },
+    { "pm", "\xc2\xb1", 2 },
+    { "RuleDelayed", "\xe2\xa7\xb4", 11 },
+    { "Ascr", "\xf0\x9d\x92\x9c", 4 },
+    { "chcy", "\xd1\x87", 4 },
+    { "SmallCircle", "\xe2\x88\x98", 11 },
+    { "leqslant", "\xe2\xa9\xbd", 8 },
+    { "LowerLeftArrow", "\xe2\x86\x99", 14 },
+    { "succnapprox", "\xe2\xaa\xba", 11 },
+    { "Element", "\xe2\x88\x88", 7 },
+    { "varsupsetneq", "\xe2\x8a\x8b\xef\xb8\x80", 12 },
+    { 0 },
+    { "Rrightarrow", "\xe2\x87\x9b", 11 },
+    { 0 },
+    { "intlarhk", "\xe2\xa8\x97", 8 },
+    { "Rcaron", "\xc5\x98", 6 },
+    { "nsc", "\xe2\x8a\x81", 3 },
+    { "DownTeeArrow", "\xe2\x86\xa7", 12 },
+    { "angzarr", "\xe2\x8d\xbc", 7 },
+    { "lE", "\xe2\x89\xa6", 2 },
+    { "Yfr", "\xf0\x9d\x94\x9c", 3 },
+    { "ratio", "\xe2\x88\xb6", 5 },
+    { "rightleftharpoons", "\xe2\x87\x8c", 17 },
+    { "gesles", "\xe2\xaa\x94", 6 },
+    { "triminus", "\xe2\xa8\xba", 8 },
+    { "Hcirc", "\xc4\xa4", 5 },
+    { "vartriangleleft", "\xe2\x8a\xb2", 15 },
+    { "ulcorner", "\xe2\x8c\x9c", 8 },
+    { "Cfr", "\xe2\x84\xad", 3 },
+    { "DoubleUpDownArrow", "\xe2\x87\x95", 17 },
+    { "clubs", "\xe2\x99\xa3", 5 },
+    { "uml", "\xc2\xa8", 3 },
+    { "capcup", "\xe2\xa9\x87", 6 },
+    { "rlhar", "\xe2\x87\x8c", 5 },
+    { 0 },
+    { "gtquest", "\xe2\xa9\xbc", 7 },
+    { "intercal", "\xe2\x8a\xba", 8 },
+    { "luruhar", "\xe2\xa5\xa6", 7 },
+    { 0 },
+    { "mapstoleft", "\xe2\x86\xa4", 10 },
+    { "measuredangle", "\xe2\x88\xa1", 13 },
+    { "middot", "\xc2\xb7", 6 },
+    { "smte", "\xe2\xaa\xac", 4 },
+    { "uArr", "\xe2\x87\x91", 4 },
+    { "zwnj", "\xe2\x80\x8c", 4 },
+    { "boxhU", "\xe2\x95\xa8", 5 },
+    { "lrhar", "\xe2\x87\x8b", 5 },
+    { "rightharpoonup", "\xe2\x87\x80", 14 },
+    { "Iopf", "\xf0\x9d\x95\x80", 4 },
+    { "easter", "\xe2\xa9\xae", 6 },
+    { "Ubrcy", "\xd0\x8e", 5 },
+    { "orarr", "\xe2\x86\xbb", 5 },
+    { 0 },
+    { "Equal", "\xe2\xa9\xb5", 5 },
+    { "NotSubset", "\xe2\x8a\x82\xe2\x83\x92", 9 },
+    { "ocirc", "\xc3\xb4", 5 },
+    { "uparrow", "\xe2\x86\x91", 7 },
+    { 0 },
+    { "squ", "\xe2\x96\xa1", 3 },
+    { "ngeqslant", "\xe2\xa9\xbe\xcc\xb8", 9 },
+    { "OpenCurlyQuote", "\xe2\x80\x98", 14 },
+    { "oplus", "\xe2\x8a\x95", 5 },
+    { 0 },
+    { "gtrsim", "\xe2\x89\xb3", 6 },
+    { 0 },
+    { "angmsdag", "\xe2\xa6\xae", 8 },
+    { "ltri", "\xe2\x97\x83", 4 },
+    { "boxv", "\xe2\x94\x82", 4 },
+    { "ring", "\xcb\x9a", 4 },
+    { "npart", "\xe2\x88\x82\xcc\xb8", 5 },
+    { "epsiv", "\xcf\xb5", 5 },
+    { "colon", ":", 5 },
+    { "notinvb", "\xe2\x8b\xb7", 7 },
+    { "tdot", "\xe2\x83\x9b", 4 },
+    { "Subset", "\xe2\x8b\x90", 6 },
+    { "nRightarrow", "\xe2\x87\x8f", 11 },
+    { "Rightarrow", "\xe2\x87\x92", 10 },
+    { "LeftTee", "\xe2\x8a\xa3", 7 },
+    { "Kcedil", "\xc4\xb6", 6 },
+    { "fpartint", "\xe2\xa8\x8d", 8 },
+    { "TScy", "\xd0\xa6", 4 },
+    { "NotPrecedesEqual", "\xe2\xaa\xaf\xcc\xb8", 16 },
+    { "xfr", "\xf0\x9d\x94\xb5", 3 },
+    { "bigcup", "\xe2\x8b\x83", 6 },
+    { "solbar", "\xe2\x8c\xbf", 6 },
+    { "sacute", "\xc5\x9b", 6 },
+    { "quest", "?", 5 },
+    { "Fouriertrf", "\xe2\x84\xb1", 10 },
+    { 0 },
+    { "sfrown", "\xe2\x8c\xa2", 6 },
+    { "heartsuit", "\xe2\x99\xa5", 9 },
+    { "tstrok", "\xc5\xa7", 6 },
+    { "questeq", "\xe2\x89\x9f", 7 },
+    { 0 },
+    { "xwedge", "\xe2\x8b\x80", 6 },
+    { 0 },
+    { "nlt", "\xe2\x89\xae", 3 },
+    { "npr", "\xe2\x8a\x80", 3 },
+    { "iscr", "\xf0\x9d\x92\xbe", 4 },
+    { "Rsh", "\xe2\x86\xb1", 3 },
+    { "GJcy", "\xd0\x83", 4 },
+    { "Wopf", "\xf0\x9d\x95\x8e", 4 },
+    { "UpTee", "\xe2\x8a\xa5", 5 },
+    { "otilde", "\xc3\xb5", 6 },
+    { "UpperLeftArrow", "\xe2\x86\x96", 14 },
+    { "Uuml", "\xc3\x9c", 4 },
+    { "cscr", "\xf0\x9d\x92\xb8", 4 },
+    { "smile", "\xe2\x8c\xa3", 5 },
+    { "searhk", "\xe2\xa4\xa5", 6 },
+    { 0 },
+    { "Auml", "\xc3\x84", 4 },
+    { "real", "\xe2\x84\x9c", 4 },
+    { "planckh", "\xe2\x84\x8e", 7 },
+    { "or", "\xe2\x88\xa8", 2 },
+    { "prE", "\xe2\xaa\xb3", 3 },
+    { "SquareUnion", "\xe2\x8a\x94", 11 },
+    { "nwarrow", "\xe2\x86\x96", 7 },
+    { "prod", "\xe2\x88\x8f", 4 },
+    { "late", "\xe2\xaa\xad", 4 },
+    { 0 },
+    { 0 },
+    { "Sup", "\xe2\x8b\x91", 3 },
+    { "nsup", "\xe2\x8a\x85", 4 },
+    { "ltimes", "\xe2\x8b\x89", 6 },
+    { "VerticalTilde", "\xe2\x89\x80", 13 },
+    { "circledR", "\xc2\xae", 8 },
+    { "natur", "\xe2\x99\xae", 5 },
+    { "CircleDot", "\xe2\x8a\x99", 9 },
+    { "DoubleRightArrow", "\xe2\x87\x92", 16 },
+    { "larrb", "\xe2\x87\xa4", 5 },
+    { "Nacute", "\xc5\x83", 6 },
+    { "rdca", "\xe2\xa4\xb7", 4 },
+    { 0 },
+    { 0 },
+    { "fork", "\xe2\x8b\x94", 4 },
+    { "RightVectorBar", "\xe2\xa5\x93", 14 },
+    { "scnap", "\xe2\xaa\xba", 5 },
+    { "Jcy", "\xd0\x99", 3 },
+    { "Sigma", "\xce\xa3", 5 },
+    { "ubrcy", "\xd1\x9e", 5 },
+    { "Tilde", "\xe2\x88\xbc", 5 },
+    { "UpperRightArrow", "\xe2\x86\x97", 15 },
+    { "equals", "=", 6 },
+    { "rarrhk", "\xe2\x86\xaa", 6 },
+    { 0 },
+    { "Laplacetrf", "\xe2\x84\x92", 10 },
+    { "subne", "\xe2\x8a\x8a", 5 },
+    { "ofcir", "\xe2\xa6\xbf", 5 },
+    { "gnap", "\xe2\xaa\x8a", 4 },
+    { "NotHumpDownHump", "\xe2\x89\x8e\xcc\xb8", 15 },
+    { "utilde", "\xc5\xa9", 6 },
+    { "NotNestedLessLess", "\xe2\xaa\xa1\xcc\xb8", 17 },
+    { "yen", "\xc2\xa5", 3 },
+    { "ubreve", "\xc5\xad", 6 },
+    { "lsqb", "[", 4 },
+    { 0 },
+    { 0 },
+    { "preccurlyeq", "\xe2\x89\xbc", 11 },
+    { "uscr", "\xf0\x9d\x93\x8a", 4 },
+    { "malt", "\xe2\x9c\xa0", 4 },
+    { "timesbar", "\xe2\xa8\xb1", 8 },
+    { "harr", "\xe2\x86\x94", 4 },
+    { "mid", "\xe2\x88\xa3", 3 },
+    { "par", "\xe2\x88\xa5", 3 },
+    { "leftrightsquigarrow", "\xe2\x86\xad", 19 },
+    { "xcup", "\xe2\x8b\x83", 4 },
+    { "rceil", "\xe2\x8c\x89", 5 },
+    { "nbump", "\xe2\x89\x8e\xcc\xb8", 5 },
+    { "amacr", "\xc4\x81", 5 },
+    { 0 },
+    { "nvHarr", "\xe2\xa4\x84", 6 },
+    { "Xi", "\xce\x9e", 2 },
+    { "bkarow", "\xe2\xa4\x8d", 6 },
+    { "succsim", "\xe2\x89\xbf", 7 },
+    { 0 },
+    { "vBar", "\xe2\xab\xa8", 4 },
+    { 0 },
+    { "NotExists", "\xe2\x88\x84", 9 },
+    { "rmoust", "\xe2\x8e\xb1", 6 },
+    { "Kscr", "\xf0\x9d\x92\xa6", 4 },
+    { "complement", "\xe2\x88\x81", 10 },
+    { "xopf", "\xf0\x9d\x95\xa9", 4 },
+    { "xi", "\xce\xbe", 2 },
+    { "leftharpoondown", "\xe2\x86\xbd", 15 },
+    { "swarr", "\xe2\x86\x99", 5 },
+    { "OverBrace", "\xe2\x8f\x9e", 9 },
+    { "xotime", "\xe2\xa8\x82", 6 },
+    { "nleftarrow", "\xe2\x86\x9a", 10 },
+    { "nspar", "\xe2\x88\xa6", 5 },
+    { "quatint", "\xe2\xa8\x96", 7 },
+    { "Union", "\xe2\x8b\x83", 5 },
+    { "Uogon", "\xc5\xb2", 5 },
+    { "dscy", "\xd1\x95", 4 },
+    { "supne", "\xe2\x8a\x8b", 5 },
+    { "RoundImplies", "\xe2\xa5\xb0", 12 },
+    { "srarr", "\xe2\x86\x92", 5 },
+    { 0 },
+    { "pluscir", "\xe2\xa8\xa2", 7 },
+    { "frac78", "\xe2\x85\x9e", 6 },
+    { "Oslash", "\xc3\x98", 6 },
+    { 0 },
+    { 0 },
+    { "tcaron", "\xc5\xa5", 6 },
+    { "lnsim", "\xe2\x8b\xa6", 5 },
+    { "racute", "\xc5\x95", 6 },
+    { "omicron", "\xce\xbf", 7 },
+    { "trie", "\xe2\x89\x9c", 4 },
+    { "thickapprox", "\xe2\x89\x88", 11 },
+    { 0 },
+    { "Ifr", "\xe2\x84\x91", 3 },
+    { "UnderBar", "_", 8 },
+    { "Eopf", "\xf0\x9d\x94\xbc", 4 },
+    { "curlyvee", "\xe2\x8b\x8e", 8 },
+    { "varnothing", "\xe2\x88\x85", 10 },
+    { "fnof", "\xc6\x92", 4 },
+    { "angmsdah", "\xe2\xa6\xaf", 8 },
+    { "aacute", "\xc3\xa1", 6 },
+    { "TripleDot", "\xe2\x83\x9b", 9 },
+    { "strns", "\xc2\xaf", 5 },
+    { "rightharpoondown", "\xe2\x87\x81", 16 },
+    { 0 },
+    { "Rfr", "\xe2\x84\x9c", 3 },
+    { "sube", "\xe2\x8a\x86", 4 },
+    { 0 },
+    { 0 },
+    { 0 },
+    { "profsurf", "\xe2\x8c\x93", 8 },
+    { "lat", "\xe2\xaa\xab", 3 },
+    { "eacute", "\xc3\xa9", 6 },
+    { "models", "\xe2\x8a\xa7", 6 },
+    { "Xfr", "\xf0\x9d\x94\x9b", 3 },
+    { "xhArr", "\xe2\x9f\xba", 5 },
+    { "NegativeVeryThinSpace", "\xe2\x80\x8b", 21 },
+    { "subnE", "\xe2\xab\x8b", 5 },
+    { "LeftTriangleBar", "\xe2\xa7\x8f", 15 },
+    { "lrcorner", "\xe2\x8c\x9f", 8 },
+    { "swnwar", "\xe2\xa4\xaa", 6 },
+    { "ensp", "\xe2\x80\x82", 4 },
+    { "divideontimes", "\xe2\x8b\x87", 13 },
+    { "rhov", "\xcf\xb1", 4 },
+    { "Pcy", "\xd0\x9f", 3 },
+    { "dcy", "\xd0\xb4", 3 },
+    { "pscr", "\xf0\x9d\x93\x85", 4 },
+    { "gfr", "\xf0\x9d\x94\xa4", 3 },
+    { "PrecedesSlantEqual", "\xe2\x89\xbc", 18 },
+    { "Hopf", "\xe2\x84\x8d", 4 },
+    { "udarr", "\xe2\x87\x85", 5 },
+    { "nsimeq", "\xe2\x89\x84", 6 },
+    { "varphi", "\xcf\x95", 6 },
+    { 0 },
+    { "ic", "\xe2\x81\xa3", 2 },
+    { "prcue", "\xe2\x89\xbc", 5 },
+    { "squarf", "\xe2\x96\xaa", 6 },
+    { "apos", "'", 4 },
+    { "lbrke", "\xe2\xa6\x8b", 5 },
+    { "percnt", "%", 6 },
+    { "sharp", "\xe2\x99\xaf", 5 },
+    { "lmidot", "\xc5\x80", 6 },
+    { "scirc", "\xc5\x9d", 5 },
+    { "thetasym", "\xcf\x91", 8 },
+    { 0 },
+    { "Efr", "\xf0\x9d\x94\x88", 3 },
+    { "rangle", "\xe2\x9f\xa9", 6 },
+    { "ngeqq", "\xe2\x89\xa7\xcc\xb8", 5 },
+    { "squf", "\xe2\x96\xaa", 4 },
+    { "NegativeThinSpace", "\xe2\x80\x8b", 17 },
+    { "jopf", "\xf0\x9d\x95\x9b", 4 },
+    { "period", ".", 6 },
+    { "tbrk", "\xe2\x8e\xb4", 4 },
+    { "loarr", "\xe2\x87\xbd", 5 },
+    { "numero", "\xe2\x84\x96", 6 },
+    { "midcir", "\xe2\xab\xb0", 6 },
+    { 0 },
+    { "ufisht", "\xe2\xa5\xbe", 6 },
+    { "gtcir", "\xe2\xa9\xba", 5 },
+    { 0 },
+    { "andv", "\xe2\xa9\x9a", 4 },
+    { "NotTilde", "\xe2\x89\x81", 8 },
+    { "nsucceq", "\xe2\xaa\xb0\xcc\xb8", 7 },
+    { "lesseqqgtr", "\xe2\xaa\x8b", 10 },
+    { "digamma", "\xcf\x9d", 7 },
+    { "lowast", "\xe2\x88\x97", 6 },
+    { "bepsi", "\xcf\xb6", 5 },
+    { 0 },
+    { 0 },
+    { "LessLess", "\xe2\xaa\xa1", 8 },
+    { 0 },
+    { "UnderParenthesis", "\xe2\x8f\x9d", 16 },
+    { "Iacute", "\xc3\x8d", 6 },
+    { "Beta", "\xce\x92", 4 },
+    { "Diamond", "\xe2\x8b\x84", 7 },
+    { "rightthreetimes", "\xe2\x8b\x8c", 15 },
+    { 0 },
+    { 0 },
+    { "Popf", "\xe2\x84\x99", 4 },
+    { 0 },
+    { "Vee", "\xe2\x8b\x81", 3 },
+    { "Leftrightarrow", "\xe2\x87\x94", 14 },
+    { "nsubseteqq", "\xe2\xab\x85\xcc\xb8", 10 },
+    { "odblac", "\xc5\x91", 6 },
+    { 0 },
+    { "DoubleLongRightArrow", "\xe2\x9f\xb9", 20 },
+    { "GreaterEqualLess", "\xe2\x8b\x9b", 16 },
+    { "bigoplus", "\xe2\xa8\x81", 8 },
+    { "swarhk", "\xe2\xa4\xa6", 6 },
+    { "caps", "\xe2\x88\xa9\xef\xb8\x80", 4 },
+    { 0 },
+    { "capbrcup", "\xe2\xa9\x89", 8 },
+    { "lbbrk", "\xe2\x9d\xb2", 5 },
+    { "LeftFloor", "\xe2\x8c\x8a", 9 },
+    { "NotLeftTriangleEqual", "\xe2\x8b\xac", 20 },
+    { "rbrksld", "\xe2\xa6\x8e", 7 },
+    { "SucceedsSlantEqual", "\xe2\x89\xbd", 18 },
+    { "rarrpl", "\xe2\xa5\x85", 6 },
+    { "timesd", "\xe2\xa8\xb0", 6 },
+    { "lthree", "\xe2\x8b\x8b", 6 },
+    { "angmsdab", "\xe2\xa6\xa9", 8 },
+    { "precapprox", "\xe2\xaa\xb7", 10 },
+    { "lessapprox", "\xe2\xaa\x85", 10 },
+    { "LeftTriangle", "\xe2\x8a\xb2", 12 },
+    { "lnap", "\xe2\xaa\x89", 4 },
+    { "mDDot", "\xe2\x88\xba", 5 },
+    { 0 },
+    { 0 },
+    { "boxHU", "\xe2\x95\xa9", 5 },
+    { "rBarr", "\xe2\xa4\x8f", 5 },
+    { "lt", "<", 2 },
+    { 0 },
+    { 0 },
+    { 0 },
+    { "frac23", "\xe2\x85\x94", 6 },
+    { "equiv", "\xe2\x89\xa1", 5 },
+    { "Iota", "\xce\x99", 4 },
+    { "copy", "\xc2\xa9", 4 },
+    { "Lcedil", "\xc4\xbb", 6 },
+    { "sqcup", "\xe2\x8a\x94", 5 },
+    { "star", "\xe2\x98\x86", 4 },
+    { "triangleright", "\xe2\x96\xb9", 13 },
+    { "robrk", "\xe2\x9f\xa7", 5 },
+    { "Ncy", "\xd0\x9d", 3 },
+    { "nvge", "\xe2\x89\xa5\xe2\x83\x92", 4 },
+    { "bigstar", "\xe2\x98\x85", 7 },
+    { "Tab", "\x09", 3 },
+    { "gtdot", "\xe2\x8b\x97", 5 },
+    { "cacute", "\xc4\x87", 6 },
+    { "rsh", "\xe2\x86\xb1", 3 },
+    { 0 },
+    { "straightepsilon", "\xcf\xb5", 15 },
+    { 0 },
+    { "exist", "\xe2\x88\x83", 5 },
+    { "eDDot", "\xe2\xa9\xb7", 5 },
+    { 0 },
+    { 0 },
+    { "ENG", "\xc5\x8a", 3 },
+    { 0 },
+    { "lobrk", "\xe2\x9f\xa6", 5 },
+    { "sopf", "\xf0\x9d\x95\xa4", 4 },
+    { 0 },
+    { "jfr", "\xf0\x9d\x94\xa7", 3 },
+    { 0 },
+    { 0 },
+    { "Aacute", "\xc3\x81", 6 },
+    { 0 },
+    { "int", "\xe2\x88\xab", 3 },
+    { "phi", "\xcf\x86", 3 },
+    { "ndash", "\xe2\x80\x93", 5 },
+    { "lesdot", "\xe2\xa9\xbf", 6 },
+    { "ncedil", "\xc5\x86", 6 },
+    { "order", "\xe2\x84\xb4", 5 },
+    { "vsupne", "\xe2\x8a\x8b\xef\xb8\x80", 6 },
+    { "varkappa", "\xcf\xb0", 8 },
+    { 0 },
+    { "Agrave", "\xc3\x80", 6 },
+    { "starf", "\xe2\x98\x85", 5 },
+    { "Kappa", "\xce\x9a", 5 },
+    { "sim", "\xe2\x88\xbc", 3 },
+    { "bsime", "\xe2\x8b\x8d", 5 },
+    { "rightsquigarrow", "\xe2\x86\x9d", 15 },
+    { "softcy", "\xd1\x8c", 6 },
+    { "boxminus", "\xe2\x8a\x9f", 8 },
+    { "varrho", "\xcf\xb1", 6 },
+    { "emsp14", "\xe2\x80\x85", 6 },
+    { "Qopf", "\xe2\x84\x9a", 4 },
+    { "jcy", "\xd0\xb9", 3 },
+    { "therefore", "\xe2\x88\xb4", 9 },
+    { 0 },
+    { "nsupe", "\xe2\x8a\x89", 5 },
+    { "gsiml", "\xe2\xaa\x90", 5 },
+    { 0 },
+    { "xcirc", "\xe2\x97\xaf", 5 },
+    { "DoubleRightTee", "\xe2\x8a\xa8", 14 },
+    { "Fscr", "\xe2\x84\xb1", 4 },
+    { "lfisht", "\xe2\xa5\xbc", 6 },
+    { "CenterDot", "\xc2\xb7", 9 },
+    { "rsqb", "]", 4 },
+    { "LessSlantEqual", "\xe2\xa9\xbd", 14 },
+    { "Lcaron", "\xc4\xbd", 6 },
+    { "Iscr", "\xe2\x84\x90", 4 },
+    { "parallel", "\xe2\x88\xa5", 8 },
+    { "capcap", "\xe2\xa9\x8b", 6 },
+    { "cir", "\xe2\x97\x8b", 3 },
+    { "Itilde", "\xc4\xa8", 6 },
+    { "supseteq", "\xe2\x8a\x87", 8 },
+    { "gtreqless", "\xe2\x8b\x9b", 9 },
+    { 0 },
+    { "nis", "\xe2\x8b\xbc", 3 },
+    { "nsime", "\xe2\x89\x84", 5 },
+    { "circledcirc", "\xe2\x8a\x9a", 11 },
+    { "propto", "\xe2\x88\x9d", 6 },
+    { 0 },
+    { "precnapprox", "\xe2\xaa\xb9", 11 },
+    { "succcurlyeq", "\xe2\x89\xbd", 11 },
+    { "lAtail", "\xe2\xa4\x9b", 6 },
+    { 0 },
+    { 0 },
+    { "triangle", "\xe2\x96\xb5", 8 },
+    { "boxtimes", "\xe2\x8a\xa0", 8 },
+    { "uhblk", "\xe2\x96\x80", 5 },
+    { "nexist", "\xe2\x88\x84", 6 },
+    { "nfr", "\xf0\x9d\x94\xab", 3 },
+    { "urcorner", "\xe2\x8c\x9d", 8 },
+    { "Bopf", "\xf0\x9d\x94\xb9", 4 },
+    { "triangleq", "\xe2\x89\x9c", 9 },
+    { "dzcy", "\xd1\x9f", 4 },
+    { "Vert", "\xe2\x80\x96", 4 },
+    { "nbumpe", "\xe2\x89\x8f\xcc\xb8", 6 },
+    { "Uacute", "\xc3\x9a", 6 },
+    { 0 },
+    { "horbar", "\xe2\x80\x95", 6 },
+    { 0 },
+    { 0 },
+    { "RightDownVector", "\xe2\x87\x82", 15 },
+    { "LeftDownTeeVector", "\xe2\xa5\xa1", 17 },
+    { "nrarrc", "\xe2\xa4\xb3\xcc\xb8", 6 },
+    { "UpEquilibrium", "\xe2\xa5\xae", 13 },
+    { "nwarhk", "\xe2\xa4\xa3", 6 },
+    { 0 },
+    { "Utilde", "\xc5\xa8", 6 },
+    { "blk14", "\xe2\x96\x91", 5 },
+    { "dotplus", "\xe2\x88\x94", 7 },
+    { "thksim", "\xe2\x88\xbc", 6 },
+    { 0 },
+    { "not", "\xc2\xac", 3 },
+    { "Afr", "\xf0\x9d\x94\x84", 3 },
+    { "sqsub", "\xe2\x8a\x8f", 5 },
+    { "sqsup", "\xe2\x8a\x90", 5 },
+    { 0 },
+    { "rho", "\xcf\x81", 3 },
+    { "wp", "\xe2\x84\x98", 2 },
+    { "triangledown", "\xe2\x96\xbf", 12 },
+    { 0 },
+    { "rppolint", "\xe2\xa8\x92", 8 },
+    { "mapsto", "\xe2\x86\xa6", 6 },
+    { "ldsh", "\xe2\x86\xb2", 4 },
+    { "xlarr", "\xe2\x9f\xb5", 5 },
+    { "Hfr", "\xe2\x84\x8c", 3 },
+    { "gtcc", "\xe2\xaa\xa7", 4 },
+    { "lharu", "\xe2\x86\xbc", 5 },
+    { "ncongdot", "\xe2\xa9\xad\xcc\xb8", 8 },
+    { "planck", "\xe2\x84\x8f", 6 },
+    { 0 },
+    { "djcy", "\xd1\x92", 4 },
+    { "ordf", "\xc2\xaa", 4 },
+    { 0 },
+    { 0 },
+    { "NotCongruent", "\xe2\x89\xa2", 12 },
+    { "Icy", "\xd0\x98", 3 },
+    { "xnis", "\xe2\x8b\xbb", 4 },
+    { 0 },
+    { "boxvr", "\xe2\x94\x9c", 5 },
+    { "eng", "\xc5\x8b", 3 },
+    { "rarrfs", "\xe2\xa4\x9e", 6 },
+    { "Gcy", "\xd0\x93", 3 },
+    { "el", "\xe2\xaa\x99", 2 },
+    { "curvearrowleft", "\xe2\x86\xb6", 14 },
+    { "xsqcup", "\xe2\xa8\x86", 6 },
+    { "dopf", "\xf0\x9d\x95\x95", 4 },
+    { "nabla", "\xe2\x88\x87", 5 },
+    { 0 },
+    { "Rscr", "\xe2\x84\x9b", 4 },
+    { "CirclePlus", "\xe2\x8a\x95", 10 },
+    { "euro", "\xe2\x82\xac", 4 },
+    { 0 },
+    { "reg", "\xc2\xae", 3 },
+    { "bne", "=\xe2\x83\xa5", 3 },
+    { "ycy", "\xd1\x8b", 3 },
+    { "SHCHcy", "\xd0\xa9", 6 },
+    { "lesg", "\xe2\x8b\x9a\xef\xb8\x80", 4 },
+    { "RBarr", "\xe2\xa4\x90", 5 },
+    { "curren", "\xc2\xa4", 6 },
+    { "ii", "\xe2\x85\x88", 2 },
+    { "nshortmid", "\xe2\x88\xa4", 9 },
+    { "boxVh", "\xe2\x95\xab", 5 },
+    { "nsccue", "\xe2\x8b\xa1", 6 },
+    { "emacr", "\xc4\x93", 5 },
+    { "ldquor", "\xe2\x80\x9e", 6 },
+    { "xdtri", "\xe2\x96\xbd", 5 },
+    { "lhard", "\xe2\x86\xbd", 5 },
+    { "eqslantgtr", "\xe2\xaa\x96", 10 },
+    { "ltcir", "\xe2\xa9\xb9", 5 },
+    { "orv", "\xe2\xa9\x9b", 3 },
+    { "blk34", "\xe2\x96\x93", 5 },
+    { "lcedil", "\xc4\xbc", 6 },
+    { "lcub", "{", 4 },
+    { 0 },
+    { "rarrtl", "\xe2\x86\xa3", 6 },
+    { 0 },
+    { "NotRightTriangle", "\xe2\x8b\xab", 16 },
+    { "VerticalBar", "\xe2\x88\xa3", 11 },
+    { "updownarrow", "\xe2\x86\x95", 11 },
+    { 0 },
+    { 0 },
+    { 0 },
+    { "forall", "\xe2\x88\x80", 6 },
+    { 0 },
+    { "Ofr", "\xf0\x9d\x94\x92", 3 },
+    { "supsetneq", "\xe2\x8a\x8b", 9 },
+    { "aleph", "\xe2\x84\xb5", 5 },
+    { "Succeeds", "\xe2\x89\xbb", 8 },
+    { 0 },
+    { 0 },
+    { "jsercy", "\xd1\x98", 6 },
+    { 0 },
+    { "doteqdot", "\xe2\x89\x91", 8 },
+    { "NotSucceedsTilde", "\xe2\x89\xbf\xcc\xb8", 16 },
+    { "Fcy", "\xd0\xa4", 3 },
+    { "boxhD", "\xe2\x95\xa5", 5 },
+    { "nhpar", "\xe2\xab\xb2", 5 },
+    { "Racute", "\xc5\x94", 6 },
+    { "Wscr", "\xf0\x9d\x92\xb2", 4 },
+    { "Kcy", "\xd0\x9a", 3 },
+    { "jscr", "\xf0\x9d\x92\xbf", 4 },
+    { "GreaterLess", "\xe2\x89\xb7", 11 },
+    { "scsim", "\xe2\x89\xbf", 5 },
+    { "cupcap", "\xe2\xa9\x86", 6 },
+    { "MinusPlus", "\xe2\x88\x93", 9 },
+    { "elsdot", "\xe2\xaa\x97", 6 },
+    { "nrtrie", "\xe2\x8b\xad", 6 },
+    { "pound", "\xc2\xa3", 5 },
+    { "boxbox", "\xe2\xa7\x89", 6 },
+    { "Lmidot", "\xc4\xbf", 6 },
+    { "InvisibleTimes", "\xe2\x81\xa2", 14 },
+    { "erarr", "\xe2\xa5\xb1", 5 },
+    { 0 },
+    { 0 },
+    { "mlcp", "\xe2\xab\x9b", 4 },
+    { "hopf", "\xf0\x9d\x95\x99", 4 },
+    { "half", "\xc2\xbd", 4 },
+    { "simeq", "\xe2\x89\x83", 5 },
+    { "rpargt", "\xe2\xa6\x94", 6 },
+    { 0 },
+    { "REG", "\xc2\xae", 3 },
+    { "boxUR", "\xe2\x95\x9a", 5 },
+    { "hookrightarrow", "\xe2\x86\xaa", 14 },
+    { "rtrif", "\xe2\x96\xb8", 5 },
+    { "nbsp", "\xc2\xa0", 4 },
+    { "supdot", "\xe2\xaa\xbe", 6 },
+    { "between", "\xe2\x89\xac", 7 },
+    { "nvle", "\xe2\x89\xa4\xe2\x83\x92", 4 },
+    { "ges", "\xe2\xa9\xbe", 3 },
+    { "DoubleDownArrow", "\xe2\x87\x93", 15 },
+    { 0 },
+    { "YIcy", "\xd0\x87", 4 },
+    { "dagger", "\xe2\x80\xa0", 6 },
+    { "DiacriticalTilde", "\xcb\x9c", 16 },
+    { "searrow", "\xe2\x86\x98", 7 },
+    { "permil", "\xe2\x80\xb0", 6 },
+    { "capand", "\xe2\xa9\x84", 6 },
+    { "IEcy", "\xd0\x95", 4 },
+    { "Igrave", "\xc3\x8c", 6 },
+    { "HumpEqual", "\xe2\x89\x8f", 9 },
+    { "LeftRightVector", "\xe2\xa5\x8e", 15 },
+    { "clubsuit", "\xe2\x99\xa3", 8 },
+    { "frac45", "\xe2\x85\x98", 6 },
+    { "IJlig", "\xc4\xb2", 5 },
+    { "Kfr", "\xf0\x9d\x94\x8e", 3 },
+    { "CupCap", "\xe2\x89\x8d", 6 },
+    { "gt", ">", 2 },
+    { "subsetneq", "\xe2\x8a\x8a", 9 },
+    { "Hscr", "\xe2\x84\x8b", 4 },
+    { "sqsubset", "\xe2\x8a\x8f", 8 },
+    { 0 },
+    { "OverBar", "\xe2\x80\xbe", 7 },
+    { "acirc", "\xc3\xa2", 5 },
+    { "itilde", "\xc4\xa9", 6 },
+    { "scnsim", "\xe2\x8b\xa9", 6 },
+    { 0 },
+    { "succ", "\xe2\x89\xbb", 4 },
+    { "Topf", "\xf0\x9d\x95\x8b", 4 },
+    { 0 },
+    { "vartheta", "\xcf\x91", 8 },
+    { "sqsube", "\xe2\x8a\x91", 6 },
+    { "Im", "\xe2\x84\x91", 2 },
+    { "simrarr", "\xe2\xa5\xb2", 7 },
+    { "ngsim", "\xe2\x89\xb5", 5 },
+    { "rsaquo", "\xe2\x80\xba", 6 },
+    { "rect", "\xe2\x96\xad", 4 },
+    { "vrtri", "\xe2\x8a\xb3", 5 },
+    { "geqq", "\xe2\x89\xa7", 4 },
+    { "zopf", "\xf0\x9d\x95\xab", 4 },
+    { "rarrbfs", "\xe2\xa4\xa0", 7 },
+    { "nvsim", "\xe2\x88\xbc\xe2\x83\x92", 5 },
+    { "frac13", "\xe2\x85\x93", 6 },
+    { 0 },
+    { "lbrace", "{", 6 },
+    { "lesdoto", "\xe2\xaa\x81", 7 },
+    { "Ubreve", "\xc5\xac", 6 },
+    { "race", "\xe2\x88\xbd\xcc\xb1", 4 },
+    { 0 },
+    { "gcy", "\xd0\xb3", 3 },
+    { "Vvdash", "\xe2\x8a\xaa", 6 },
+    { "yscr", "\xf0\x9d\x93\x8e", 4 },
+    { "uuml", "\xc3\xbc", 4 },
+    { "nleqslant", "\xe2\xa9\xbd\xcc\xb8", 9 },
+    { "copysr", "\xe2\x84\x97", 6 },
+    { "yicy", "\xd1\x97", 4 },
+    { "cuepr", "\xe2\x8b\x9e", 5 },
+    { 0 },
+    { "Zcaron", "\xc5\xbd", 6 },
+    { "lg", "\xe2\x89\xb6", 2 },
+    { "smid", "\xe2\x88\xa3", 4 },
+    { "LessFullEqual", "\xe2\x89\xa6", 13 },
+    { "bigcirc", "\xe2\x97\xaf", 7 },
+    { "bfr", "\xf0\x9d\x94\x9f", 3 },
+    { "rbbrk", "\xe2\x9d\xb3", 5 },
+    { "triangleleft", "\xe2\x97\x83", 12 },
+    { "mnplus", "\xe2\x88\x93", 6 },
+    { "lesssim", "\xe2\x89\xb2", 7 },
+    { "rsquor", "\xe2\x80\x99", 6 },
+    { "ifr", "\xf0\x9d\x94\xa6", 3 },
+    { "HilbertSpace", "\xe2\x84\x8b", 12 },
+    { "Abreve", "\xc4\x82", 6 },
+    { "sqsupe", "\xe2\x8a\x92", 6 },
+    { 0 },
+    { "ShortDownArrow", "\xe2\x86\x93", 14 },
+    { "NestedGreaterGreater", "\xe2\x89\xab", 20 },
+    { "DScy", "\xd0\x85", 4 },
+    { 0 },
+    { "leftarrowtail", "\xe2\x86\xa2", 13 },
+    { "ZeroWidthSpace", "\xe2\x80\x8b", 14 },
+    { "bNot", "\xe2\xab\xad", 4 },
+    { "CloseCurlyQuote", "\xe2\x80\x99", 15 },
+    { "Ncaron", "\xc5\x87", 6 },
+    { "nexists", "\xe2\x88\x84", 7 },
+    { 0 },
+    { "MediumSpace", "\xe2\x81\x9f", 11 },
+    { "rarrap", "\xe2\xa5\xb5", 6 },
+    { "Nscr", "\xf0\x9d\x92\xa9", 4 },
+    { 0 },
+    { "macr", "\xc2\xaf", 4 },
+    { "nharr", "\xe2\x86\xae", 5 },
+    { "NotGreaterGreater", "\xe2\x89\xab\xcc\xb8", 17 },
+    { 0 },
+    { "niv", "\xe2\x88\x8b", 3 },
+    { "wr", "\xe2\x89\x80", 2 },
+    { "hairsp", "\xe2\x80\x8a", 6 },
+    { "Scy", "\xd0\xa1", 3 },
+    { "emsp13", "\xe2\x80\x84", 6 },
+    { 0 },
+    { "Otimes", "\xe2\xa8\xb7", 6 },
+    { "shy", "\xc2\xad", 3 },
+    { "isindot", "\xe2\x8b\xb5", 7 },
+    { "angmsdae", "\xe2\xa6\xac", 8 },
+    { "ape", "\xe2\x89\x8a", 3 },
+    { "ograve", "\xc3\xb2", 6 },
+    { "NotElement", "\xe2\x88\x89", 10 },
+    { "ImaginaryI", "\xe2\x85\x88", 10 },
+    { "roarr", "\xe2\x87\xbe", 5 },
+    { 0 },
+    { "boxDL", "\xe2\x95\x97", 5 },
+    { "sqsubseteq", "\xe2\x8a\x91", 10 },
+    { "ni", "\xe2\x88\x8b", 2 },
+    { "Ecy", "\xd0\xad", 3 },
+    { "Omega", "\xce\xa9", 5 },
+    { "it", "\xe2\x81\xa2", 2 },
+    { "zeetrf", "\xe2\x84\xa8", 6 },
+    { "leftrightarrows", "\xe2\x87\x86", 15 },
+    { "umacr", "\xc5\xab", 5 },
+    { "vert", "|", 4 },
+    { 0 },
+    { "tprime", "\xe2\x80\xb4", 6 },
+    { "dd", "\xe2\x85\x86", 2 },
+    { "Rang", "\xe2\x9f\xab", 4 },
+    { "Dcaron", "\xc4\x8e", 6 },
+    { "lowbar", "_", 6 },
+    { "Fopf", "\xf0\x9d\x94\xbd", 4 },
+    { "daleth", "\xe2\x84\xb8", 6 },
+    { "nearr", "\xe2\x86\x97", 5 },
+    { "ltrif", "\xe2\x97\x82", 5 },
+    { "LeftUpDownVector", "\xe2\xa5\x91", 16 },
+    { "ange", "\xe2\xa6\xa4", 4 },
+    { "LeftUpVectorBar", "\xe2\xa5\x98", 15 },
+    { "nsubE", "\xe2\xab\x85\xcc\xb8", 5 },
+    { 0 },
+    { "Dcy", "\xd0\x94", 3 },
+    { "notin", "\xe2\x88\x89", 5 },
+    { "CircleTimes", "\xe2\x8a\x97", 11 },
+    { 0 },
+    { "NegativeMediumSpace", "\xe2\x80\x8b", 19 },
+    { "equivDD", "\xe2\xa9\xb8", 7 },
+    { "bsolb", "\xe2\xa7\x85", 5 },
+    { "KHcy", "\xd0\xa5", 4 },
+    { "eqcirc", "\xe2\x89\x96", 6 },
+    { "ApplyFunction", "\xe2\x81\xa1", 13 },
+    { "upuparrows", "\xe2\x87\x88", 10 },
+    { "cirmid", "\xe2\xab\xaf", 6 },
+    { "lharul", "\xe2\xa5\xaa", 6 },
+    { "AElig", "\xc3\x86", 5 },
+    { 0 },
+    { "ldca", "\xe2\xa4\xb6", 4 },
+    { "larrlp", "\xe2\x86\xab", 6 },
+    { "RightFloor", "\xe2\x8c\x8b", 10 },
+    { "LongRightArrow", "\xe2\x9f\xb6", 14 },
+    { "supsim", "\xe2\xab\x88", 6 },
+    { "pi", "\xcf\x80", 2 },
+    { 0 },
+    { "Barwed", "\xe2\x8c\x86", 6 },
+    { 0 },
+    { 0 },
+    { "gneq", "\xe2\xaa\x88", 4 },
+    { "RightUpVectorBar", "\xe2\xa5\x94", 16 },
+    { 0 },
+    { "af", "\xe2\x81\xa1", 2 },
+    { "gescc", "\xe2\xaa\xa9", 5 },
+    { "RightTriangle", "\xe2\x8a\xb3", 13 },
+    { "hardcy", "\xd1\x8a", 6 },
+    { "hookleftarrow", "\xe2\x86\xa9", 13 },
+    { "Jscr", "\xf0\x9d\x92\xa5", 4 },
+    { "mapstoup", "\xe2\x86\xa5", 8 },
+    { "ssmile", "\xe2\x8c\xa3", 6 },
+    { "ord", "\xe2\xa9\x9d", 3 },
+    { "ast", "*", 3 },
+    { "frac38", "\xe2\x85\x9c", 6 },
+    { "Lstrok", "\xc5\x81", 6 },
+    { "SucceedsTilde", "\xe2\x89\xbf", 13 },
+    { 0 },
+    { "odot", "\xe2\x8a\x99", 4 },
+    { "xuplus", "\xe2\xa8\x84", 6 },
+    { "NotCupCap", "\xe2\x89\xad", 9 },
+    { "gg", "\xe2\x89\xab", 2 },
+    { "shcy", "\xd1\x88", 4 },
+    { "vcy", "\xd0\xb2", 3 },
+    { "nsupset", "\xe2\x8a\x83\xe2\x83\x92", 7 },
+    { "sigmav", "\xcf\x82", 6 },
+    { "llcorner", "\xe2\x8c\x9e", 8 },
+    { "Sacute", "\xc5\x9a", 6 },
+    { 0 },
+    { 0 },
+    { "Leftarrow", "\xe2\x87\x90", 9 },
+    { "DownTee", "\xe2\x8a\xa4", 7 },
+    { 0 },
+    { "Cap", "\xe2\x8b\x92", 3 },
+    { "rotimes", "\xe2\xa8\xb5", 7 },
+    { "Otilde", "\xc3\x95", 6 },
+    { "ccaps", "\xe2\xa9\x8d", 5 },
+    { 0 },
+    { "scy", "\xd1\x81", 3 },
+    { "larrtl", "\xe2\x86\xa2", 6 },
+    { 0 },
+    { "nlArr", "\xe2\x87\x8d", 5 },
+    { "die", "\xc2\xa8", 3 },
+    { "Ycy", "\xd0\xab", 3 },
+    { 0 },
+    { "plustwo", "\xe2\xa8\xa7", 7 },
+    { "pitchfork", "\xe2\x8b\x94", 9 },
+    { "DownLeftVector", "\xe2\x86\xbd", 14 },
+    { "abreve", "\xc4\x83", 6 },
+    { "csub", "\xe2\xab\x8f", 4 },
+    { "NotGreater", "\xe2\x89\xaf", 10 },
+    { "rarrw", "\xe2\x86\x9d", 5 },
+    { "rcub", "}", 4 },
+    { 0 },
+    { "plusdu", "\xe2\xa8\xa5", 6 },
+    { "rationals", "\xe2\x84\x9a", 9 },
+    { "gammad", "\xcf\x9d", 6 },
+    { "Qfr", "\xf0\x9d\x94\x94", 3 },
+    { "boxVH", "\xe2\x95\xac", 5 },
+    { "nsub", "\xe2\x8a\x84", 4 },
+    { "dash", "\xe2\x80\x90", 4 },
+    { "esdot", "\xe2\x89\x90", 5 },
+    { "Jfr", "\xf0\x9d\x94\x8d", 3 },
+    { "qprime", "\xe2\x81\x97", 6 },
+    { "nleftrightarrow", "\xe2\x86\xae", 15 },
+    { "NotSupersetEqual", "\xe2\x8a\x89", 16 },
+    { "complexes", "\xe2\x84\x82", 9 },
+    { "elinters", "\xe2\x8f\xa7", 8 },
+    { "shortmid", "\xe2\x88\xa3", 8 },
+    { "thorn", "\xc3\xbe", 5 },
+    { "NewLine", "\x0a", 7 },
+    { "rharul", "\xe2\xa5\xac", 6 },
+    { "lmoustache", "\xe2\x8e\xb0", 10 },
+    { 0 },
+    { "Bscr", "\xe2\x84\xac", 4 },
+    { "UpDownArrow", "\xe2\x86\x95", 11 },
+    { "ropar", "\xe2\xa6\x86", 5 },
+    { "rtrie", "\xe2\x8a\xb5", 5 },
+    { "CapitalDifferentialD", "\xe2\x85\x85", 20 },
+    { 0 },
+    { "duarr", "\xe2\x87\xb5", 5 },
+    { "NotGreaterTilde", "\xe2\x89\xb5", 15 },
+    { "ccirc", "\xc4\x89", 5 },
+    { "nVdash", "\xe2\x8a\xae", 6 },
+    { "Del", "\xe2\x88\x87", 3 },
+    { "NotVerticalBar", "\xe2\x88\xa4", 14 },
+    { "scnE", "\xe2\xaa\xb6", 4 },
+    { "DownArrowBar", "\xe2\xa4\x93", 12 },
+    { "trisb", "\xe2\xa7\x8d", 5 },
+    { "dstrok", "\xc4\x91", 6 },
+    { "toea", "\xe2\xa4\xa8", 4 },
+    { "succneqq", "\xe2\xaa\xb6", 8 },
+    { "EqualTilde", "\xe2\x89\x82", 10 },
+    { "NotLessTilde", "\xe2\x89\xb4", 12 },
+    { "Square", "\xe2\x96\xa1", 6 },
+    { "Ccirc", "\xc4\x88", 5 },
+    { "epsi", "\xce\xb5", 4 },
+    { "yfr", "\xf0\x9d\x94\xb6", 3 },
+    { "TildeTilde", "\xe2\x89\x88", 10 },
+    { "utdot", "\xe2\x8b\xb0", 5 },
+    { "uacute", "\xc3\xba", 6 },
+    { "kcy", "\xd0\xba", 3 },
+    { "NotSucceeds", "\xe2\x8a\x81", 11 },
+    { "bcong", "\xe2\x89\x8c", 5 },
+    { "NotLeftTriangle", "\xe2\x8b\xaa", 15 },
+    { 0 },
+    { "cups", "\xe2\x88\xaa\xef\xb8\x80", 4 },
+    { "Pi", "\xce\xa0", 2 },
+    { "leftrightharpoons", "\xe2\x87\x8b", 17 },
+    { "upsih", "\xcf\x92", 5 },
+    { 0 },
+    { "emptyv", "\xe2\x88\x85", 6 },
+    { "geq", "\xe2\x89\xa5", 3 },
+    { 0 },
+    { "roang", "\xe2\x9f\xad", 5 },
+    { "lBarr", "\xe2\xa4\x8e", 5 },
+    { "ZHcy", "\xd0\x96", 4 },
+    { "mho", "\xe2\x84\xa7", 3 },
+    { "lbarr", "\xe2\xa4\x8c", 5 },
+    { 0 },
+    { 0 },
+    { "Pfr", "\xf0\x9d\x94\x93", 3 },
+    { "bullet", "\xe2\x80\xa2", 6 },
+    { "vsubnE", "\xe2\xab\x8b\xef\xb8\x80", 6 },
+    { "NotLessSlantEqual", "\xe2\xa9\xbd\xcc\xb8", 17 },
+    { 0 },
+    { "expectation", "\xe2\x84\xb0", 11 },
+    { "agrave", "\xc3\xa0", 6 },
+    { "Oacute", "\xc3\x93", 6 },
+    { "hscr", "\xf0\x9d\x92\xbd", 4 },
+    { "Ropf", "\xe2\x84\x9d", 4 },
+    { "bprime", "\xe2\x80\xb5", 6 },
+    { "SupersetEqual", "\xe2\x8a\x87", 13 },
+    { "geqslant", "\xe2\xa9\xbe", 8 },
+    { "fopf", "\xf0\x9d\x95\x97", 4 },
+    { 0 },
+    { "leftrightarrow", "\xe2\x86\x94", 14 },
+    { "rtri", "\xe2\x96\xb9", 4 },
+    { "Nopf", "\xe2\x84\x95", 4 },
+    { "rdldhar", "\xe2\xa5\xa9", 7 },
+    { "drbkarow", "\xe2\xa4\x90", 8 },
+    { "rarrc", "\xe2\xa4\xb3", 5 },
+    { "qopf", "\xf0\x9d\x95\xa2", 4 },
+    { "kappav", "\xcf\xb0", 6 },
+    { "dlcrop", "\xe2\x8c\x8d", 6 },
+    { "Scirc", "\xc5\x9c", 5 },
+    { 0 },
+    { "hyphen", "\xe2\x80\x90", 6 },
+    { "dwangle", "\xe2\xa6\xa6", 7 },
+    { "bot", "\xe2\x8a\xa5", 3 },
+    { "LeftAngleBracket", "\xe2\x9f\xa8", 16 },
+    { "in", "\xe2\x88\x88", 2 },
+    { "cent", "\xc2\xa2", 4 },
+    { "Cconint", "\xe2\x88\xb0", 7 },
+    { "lbrkslu", "\xe2\xa6\x8d", 7 },
+    { "diamondsuit", "\xe2\x99\xa6", 11 },
+    { "LeftDownVector", "\xe2\x87\x83", 14 },
+    { "gnapprox", "\xe2\xaa\x8a", 8 },
+    { "Longleftrightarrow", "\xe2\x9f\xba", 18 },
+    { "setminus", "\xe2\x88\x96", 8 },
+    { "ContourIntegral", "\xe2\x88\xae", 15 },
+    { "Exists", "\xe2\x88\x83", 6 },
+    { "Pr", "\xe2\xaa\xbb", 2 },
+    { "ntlg", "\xe2\x89\xb8", 4 },
+    { "Ugrave", "\xc3\x99", 6 },
+    { 0 },
+    { "nhArr", "\xe2\x87\x8e", 5 },
+    { "xrarr", "\xe2\x9f\xb6", 5 },
+    { "frown", "\xe2\x8c\xa2", 5 },
+    { 0 },
+    { "prurel", "\xe2\x8a\xb0", 6 },
+    { "asymp", "\xe2\x89\x88", 5 },
+    { "lessgtr", "\xe2\x89\xb6", 7 },
+    { "rangd", "\xe2\xa6\x92", 5 },
+    { "Vopf", "\xf0\x9d\x95\x8d", 4 },
+    { "Escr", "\xe2\x84\xb0", 4 },
+    { "DoubleLongLeftRightArrow", "\xe2\x9f\xba", 24 },
+    { 0 },
+    { "Lt", "\xe2\x89\xaa", 2 },
+    { "uplus", "\xe2\x8a\x8e", 5 },
+    { "Edot", "\xc4\x96", 4 },
+    { "dotsquare", "\xe2\x8a\xa1", 9 },
+    { "longrightarrow", "\xe2\x9f\xb6", 14 },
+    { "lbrksld", "\xe2\xa6\x8f", 7 },
+    { "Lleftarrow", "\xe2\x87\x9a", 10 },
+    { "scE", "\xe2\xaa\xb4", 3 },
+    { "downarrow", "\xe2\x86\x93", 9 },
+    { "nwnear", "\xe2\xa4\xa7", 6 },
+    { "jukcy", "\xd1\x94", 5 },
+    { "intcal", "\xe2\x8a\xba", 6 },
+    { "COPY", "\xc2\xa9", 4 },
+    { "Sub", "\xe2\x8b\x90", 3 },
+    { "Pscr", "\xf0\x9d\x92\xab", 4 },
+    { "lfloor", "\xe2\x8c\x8a", 6 },
+    { "Cdot", "\xc4\x8a", 4 },
+    { 0 },
+    { "Kopf", "\xf0\x9d\x95\x82", 4 },
+    { "cedil", "\xc2\xb8", 5 },
+    { "square", "\xe2\x96\xa1", 6 },
+    { "AMP", "&", 3 },
+    { "ldrushar", "\xe2\xa5\x8b", 8 },
+    { "curlyeqsucc", "\xe2\x8b\x9f", 11 },
+    { "Colone", "\xe2\xa9\xb4", 6 },
+    { 0 },
+    { "SquareSubsetEqual", "\xe2\x8a\x91", 17 },
+    { "rsquo", "\xe2\x80\x99", 5 },
+    { 0 },
+    { "glE", "\xe2\xaa\x92", 3 },
+    { 0 },
+    { "Vscr", "\xf0\x9d\x92\xb1", 4 },
+    { "Lambda", "\xce\x9b", 6 },
+    { "rtriltri", "\xe2\xa7\x8e", 8 },
+    { "napos", "\xc5\x89", 5 },
+    { 0 },
+    { "lEg", "\xe2\xaa\x8b", 3 },
+    { "div", "\xc3\xb7", 3 },
+    { "Dashv", "\xe2\xab\xa4", 5 },
+    { 0 },
+    { 0 },
+    { "Tcedil", "\xc5\xa2", 6 },
+    { 0 },
+    { "DD", "\xe2\x85\x85", 2 },
+    { "npreceq", "\xe2\xaa\xaf\xcc\xb8", 7 },
+    { "fltns", "\xe2\x96\xb1", 5 },
+    { "uuarr", "\xe2\x87\x88", 5 },
+    { "xmap", "\xe2\x9f\xbc", 4 },
+    { "twixt", "\xe2\x89\xac", 5 },
+    { "RightArrowBar", "\xe2\x87\xa5", 13 },
+    { "Ncedil", "\xc5\x85", 6 },
+    { "ThinSpace", "\xe2\x80\x89", 9 },
+    { "prnap", "\xe2\xaa\xb9", 5 },
+    { 0 },
+    { "dblac", "\xcb\x9d", 5 },
+    { "ecy", "\xd1\x8d", 3 },
+    { "phone", "\xe2\x98\x8e", 5 },
+    { 0 },
+    { "realine", "\xe2\x84\x9b", 7 },
+    { "nge", "\xe2\x89\xb1", 3 },
+    { "mumap", "\xe2\x8a\xb8", 5 },
+    { "orderof", "\xe2\x84\xb4", 7 },
+    { "rnmid", "\xe2\xab\xae", 5 },
+    { 0 },
+    { 0 },
+    { "blacktriangle", "\xe2\x96\xb4", 13 },
+    { "GreaterGreater", "\xe2\xaa\xa2", 14 },
+    { "diams", "\xe2\x99\xa6", 5 },
+    { 0 },
+    { "rAtail", "\xe2\xa4\x9c", 6 },
+    { 0 },
+    { "hArr", "\xe2\x87\x94", 4 },
+    { "blacktriangleright", "\xe2\x96\xb8", 18 },
+    { "Lang", "\xe2\x9f\xaa", 4 },
+    { "nvltrie", "\xe2\x8a\xb4\xe2\x83\x92", 7 },
+    { "nGg", "\xe2\x8b\x99\xcc\xb8", 3 },
+    { 0 },
+    { "infin", "\xe2\x88\x9e", 5 },
+    { "DiacriticalAcute", "\xc2\xb4", 16 },
+    { "curarrm", "\xe2\xa4\xbc", 7 },
+    { "UpTeeArrow", "\xe2\x86\xa5", 10 },
+    { "epar", "\xe2\x8b\x95", 4 },
+    { 0 },
+    { "harrw", "\xe2\x86\xad", 5 },
+    { "Iukcy", "\xd0\x86", 5 },
+    { "hoarr", "\xe2\x87\xbf", 5 },
+    { 0 },
+    { 0 },
+    { "Coproduct", "\xe2\x88\x90", 9 },
+    { "orslope", "\xe2\xa9\x97", 7 },
+    { "acy", "\xd0\xb0", 3 },
+    { "Tcy", "\xd0\xa2", 3 },
+    { "ctdot", "\xe2\x8b\xaf", 5 },
+    { "Copf", "\xe2\x84\x82", 4 },
+    { "cross", "\xe2\x9c\x97", 5 },
+    { "boxDl", "\xe2\x95\x96", 5 },
+    { "Wfr", "\xf0\x9d\x94\x9a", 3 },
+    { "quaternions", "\xe2\x84\x8d", 11 },
+    { "iota", "\xce\xb9", 4 },
+    { "simne", "\xe2\x89\x86", 5 },
+    { "boxdL", "\xe2\x95\x95", 5 },
+    { "Chi", "\xce\xa7", 3 },
+    { 0 },
+    { "lvertneqq", "\xe2\x89\xa8\xef\xb8\x80", 9 },
+    { "because", "\xe2\x88\xb5", 7 },
+    { "sstarf", "\xe2\x8b\x86", 6 },
+    { "reals", "\xe2\x84\x9d", 5 },
+    { "oelig", "\xc5\x93", 5 },
+    { "ffllig", "\xef\xac\x84", 6 },
+    { "NotTildeFullEqual", "\xe2\x89\x87", 17 },
+    { "ucirc", "\xc3\xbb", 5 },
+    { "sung", "\xe2\x99\xaa", 4 },
+    { "Proportion", "\xe2\x88\xb7", 10 },
+    { "subset", "\xe2\x8a\x82", 6 },
+    { "PlusMinus", "\xc2\xb1", 9 },
+    { "leftarrow", "\xe2\x86\x90", 9 },
+    { 0 },
+    { 0 },
+    { "commat", "@", 6 },
+    { 0 },
+    { "csup", "\xe2\xab\x90", 4 },
+    { "Larr", "\xe2\x86\x9e", 4 },
+    { "alpha", "\xce\xb1", 5 },
+    { "omega", "\xcf\x89", 5 },
+    { "sext", "\xe2\x9c\xb6", 4 },
+    { "RightVector", "\xe2\x87\x80", 11 },
+    { "Implies", "\xe2\x87\x92", 7 },
+    { "angrtvb", "\xe2\x8a\xbe", 7 },
+    { 0 },
+    { "Iuml", "\xc3\x8f", 4 },
+    { "weierp", "\xe2\x84\x98", 6 },
+    { "kfr", "\xf0\x9d\x94\xa8", 3 },
+    { "smashp", "\xe2\xa8\xb3", 6 },
+    { "slarr", "\xe2\x86\x90", 5 },
+    { 0 },
+    { "conint", "\xe2\x88\xae", 6 },
+    { "varepsilon", "\xcf\xb5", 10 },
+    { "piv", "\xcf\x96", 3 },
+    { "NotSucceedsSlantEqual", "\xe2\x8b\xa1", 21 },
+    { "Ycirc", "\xc5\xb6", 5 },
+    { "simplus", "\xe2\xa8\xa4", 7 },
+    { "Intersection", "\xe2\x8b\x82", 12 },
+    { "Map", "\xe2\xa4\x85", 3 },
+    { "multimap", "\xe2\x8a\xb8", 8 },
+    { "sfr", "\xf0\x9d\x94\xb0", 3 },
+    { "RightArrowLeftArrow", "\xe2\x87\x84", 19 },
+    { "longleftrightarrow", "\xe2\x9f\xb7", 18 },
+    { 0 },
+    { "Idot", "\xc4\xb0", 4 },
+    { "hstrok", "\xc4\xa7", 6 },
+    { "inodot", "\xc4\xb1", 6 },
+    { "profalar", "\xe2\x8c\xae", 8 },
+    { "LongLeftArrow", "\xe2\x9f\xb5", 13 },
+    { "ohm", "\xce\xa9", 3 },
+    { "eqsim", "\xe2\x89\x82", 5 },
+    { "varr", "\xe2\x86\x95", 4 },
+    { "ocir", "\xe2\x8a\x9a", 4 },
+    { "blank", "\xe2\x90\xa3", 5 },
+    { "wedge", "\xe2\x88\xa7", 5 },
+    { "RightTriangleBar", "\xe2\xa7\x90", 16 },
+    { "Icirc", "\xc3\x8e", 5 },
+    { "larrpl", "\xe2\xa4\xb9", 6 },
+    { "asympeq", "\xe2\x89\x8d", 7 },
+    { "gtrarr", "\xe2\xa5\xb8", 6 },
+    { "lrhard", "\xe2\xa5\xad", 6 },
+    { "pluse", "\xe2\xa9\xb2", 5 },
+    { "phiv", "\xcf\x95", 4 },
+    { "marker", "\xe2\x96\xae", 6 },
+    { "gesdoto", "\xe2\xaa\x82", 7 },
+    { "Acirc", "\xc3\x82", 5 },
+    { "RightTriangleEqual", "\xe2\x8a\xb5", 18 },
+    { 0 },
+    { "quot", "\x22", 4 },
+    { "downharpoonright", "\xe2\x87\x82", 16 },
+    { "odiv", "\xe2\xa8\xb8", 4 },
+    { "UpArrowDownArrow", "\xe2\x87\x85", 16 },
+    { "roplus", "\xe2\xa8\xae", 6 },
+    { "Uarr", "\xe2\x86\x9f", 4 },
+    { "acd", "\xe2\x88\xbf", 3 },
+    { "nrarrw", "\xe2\x86\x9d\xcc\xb8", 6 },
+    { 0 },
+    { "NotLessLess", "\xe2\x89\xaa\xcc\xb8", 11 },
+    { "NotHumpEqual", "\xe2\x89\x8f\xcc\xb8", 12 },
+    { 0 },
+    { "eqcolon", "\xe2\x89\x95", 7 },
+    { 0 },
+    { "cong", "\xe2\x89\x85", 4 },
+    { "apid", "\xe2\x89\x8b", 4 },
+    { "LeftCeiling", "\xe2\x8c\x88", 11 },
+    { "DoubleVerticalBar", "\xe2\x88\xa5", 17 },
+    { "naturals", "\xe2\x84\x95", 8 },
+    { "varsubsetneq", "\xe2\x8a\x8a\xef\xb8\x80", 12 },
+    { "Gscr", "\xf0\x9d\x92\xa2", 4 },
+    { "twoheadrightarrow", "\xe2\x86\xa0", 17 },
+    { 0 },
+    { "ldquo", "\xe2\x80\x9c", 5 },
+    { "escr", "\xe2\x84\xaf", 4 },
+    { "boxUr", "\xe2\x95\x99", 5 },
+    { "Zcy", "\xd0\x97", 3 },
+    { "gvertneqq", "\xe2\x89\xa9\xef\xb8\x80", 9 },
+    { "simg", "\xe2\xaa\x9e", 4 },
+    { "yopf", "\xf0\x9d\x95\xaa", 4 },
+    { "ecolon", "\xe2\x89\x95", 6 },
+    { "andand", "\xe2\xa9\x95", 6 },
+    { "zfr", "\xf0\x9d\x94\xb7", 3 },
+    { 0 },
+    { "biguplus", "\xe2\xa8\x84", 8 },
+    { "lpar", "(", 4 },
+    { "Longrightarrow", "\xe2\x9f\xb9", 14 },
+    { 0 },
+    { "NotRightTriangleBar", "\xe2\xa7\x90\xcc\xb8", 19 },
+    { "ugrave", "\xc3\xb9", 6 },
+    { "boxvR", "\xe2\x95\x9e", 5 },
+    { "Cup", "\xe2\x8b\x93", 3 },
+    { "Yopf", "\xf0\x9d\x95\x90", 4 },
+    { "boxDR", "\xe2\x95\x94", 5 },
+    { "Lscr", "\xe2\x84\x92", 4 },
+    { "realpart", "\xe2\x84\x9c", 8 },
+    { "tilde", "\xcb\x9c", 5 },
+    { "llarr", "\xe2\x87\x87", 5 },
+    { "rightleftarrows", "\xe2\x87\x84", 15 },
+    { "HARDcy", "\xd0\xaa", 6 },
+    { "minusb", "\xe2\x8a\x9f", 6 },
+    { 0 },
+    { "ThickSpace", "\xe2\x81\x9f\xe2\x80\x8a", 10 },
+    { "Ecaron", "\xc4\x9a", 6 },
+    { "wedbar", "\xe2\xa9\x9f", 6 },
+    { 0 },
+    { "Odblac", "\xc5\x90", 6 },
+    { "OElig", "\xc5\x92", 5 },
+    { "suphsub", "\xe2\xab\x97", 7 },
+    { "minus", "\xe2\x88\x92", 5 },
+    { "csupe", "\xe2\xab\x92", 5 },
+    { "ltlarr", "\xe2\xa5\xb6", 6 },
+    { 0 },
+    { 0 },
+    { "nscr", "\xf0\x9d\x93\x83", 4 },
+    { "diam", "\xe2\x8b\x84", 4 },
+    { "thetav", "\xcf\x91", 6 },
+    { "backsimeq", "\xe2\x8b\x8d", 9 },
+    { "DownRightVector", "\xe2\x87\x81", 15 },
+    { 0 },
+    { "FilledVerySmallSquare", "\xe2\x96\xaa", 21 },
+    { "rdsh", "\xe2\x86\xb3", 4 },
+    { "circ", "\xcb\x86", 4 },
+    { 0 },
+    { "bsim", "\xe2\x88\xbd", 4 },
+    { "ang", "\xe2\x88\xa0", 3 },
+    { "doublebarwedge", "\xe2\x8c\x86", 14 },
+    { "RightUpVector", "\xe2\x86\xbe", 13 },
+    { "puncsp", "\xe2\x80\x88", 6 },
+    { "ominus", "\xe2\x8a\x96", 6 },
+    { "vellip", "\xe2\x8b\xae", 6 },
+    { "gne", "\xe2\xaa\x88", 3 },
+    { 0 },
+    { 0 },
+    { "lscr", "\xf0\x9d\x93\x81", 4 },
+    { "sqcaps", "\xe2\x8a\x93\xef\xb8\x80", 6 },
+    { "Tau", "\xce\xa4", 3 },
+    { 0 },
+    { 0 },
+    { "iopf", "\xf0\x9d\x95\x9a", 4 },
+    { "gscr", "\xe2\x84\x8a", 4 },
+    { "lneq", "\xe2\xaa\x87", 4 },
+    { "Re", "\xe2\x84\x9c", 2 },
+    { "boxh", "\xe2\x94\x80", 4 },
+    { "cdot", "\xc4\x8b", 4 },
+    { "intprod", "\xe2\xa8\xbc", 7 },
+    { 0 },
+    { "DiacriticalDoubleAcute", "\xcb\x9d", 22 },
+    { 0 },
+    { "Poincareplane", "\xe2\x84\x8c", 13 },
+    { "coprod", "\xe2\x88\x90", 6 },
+    { "eqvparsl", "\xe2\xa7\xa5", 8 },
+    { "fscr", "\xf0\x9d\x92\xbb", 4 },
+    { "Gamma", "\xce\x93", 5 },
+    { "boxul", "\xe2\x94\x98", 5 },
+    { "npar", "\xe2\x88\xa6", 4 },
+    { "FilledSmallSquare", "\xe2\x97\xbc", 17 },
+    { "copf", "\xf0\x9d\x95\x94", 4 },
+    { "nparsl", "\xe2\xab\xbd\xe2\x83\xa5", 6 },
+    { "neArr", "\xe2\x87\x97", 5 },
+    { "nwarr", "\xe2\x86\x96", 5 },
+    { "circlearrowleft", "\xe2\x86\xba", 15 },
+    { "blacksquare", "\xe2\x96\xaa", 11 },
+    { "odash", "\xe2\x8a\x9d", 5 },
+    { "LowerRightArrow", "\xe2\x86\x98", 15 },
+    { "infintie", "\xe2\xa7\x9d", 8 },
+    { "boxur", "\xe2\x94\x94", 5 },
+    { "thinsp", "\xe2\x80\x89", 6 },
+    { "udblac", "\xc5\xb1", 6 },
+    { 0 },
+    { "angmsdac", "\xe2\xa6\xaa", 8 },
+    { "siml", "\xe2\xaa\x9d", 4 },
+    { "backcong", "\xe2\x89\x8c", 8 },
+    { "Cayleys", "\xe2\x84\xad", 7 },
+    { "boxplus", "\xe2\x8a\x9e", 7 },
+    { "Dfr", "\xf0\x9d\x94\x87", 3 },
+    { "searr", "\xe2\x86\x98", 5 },
+    { "diamond", "\xe2\x8b\x84", 7 },
+    { "els", "\xe2\xaa\x95", 3 },
+    { "setmn", "\xe2\x88\x96", 5 },
+    { "dashv", "\xe2\x8a\xa3", 5 },
+    { "cudarrr", "\xe2\xa4\xb5", 7 },
+    { "wfr", "\xf0\x9d\x94\xb4", 3 },
+    { "rtimes", "\xe2\x8b\x8a", 6 },
+    { "lmoust", "\xe2\x8e\xb0", 6 },
+    { "smt", "\xe2\xaa\xaa", 3 },
+    { "RightUpDownVector", "\xe2\xa5\x8f", 17 },
+    { "rcedil", "\xc5\x97", 6 },
+    { "lates", "\xe2\xaa\xad\xef\xb8\x80", 5 },
+    { "Euml", "\xc3\x8b", 4 },
+    { "plusmn", "\xc2\xb1", 6 },
+    { "Delta", "\xce\x94", 5 },
+    { 0 },
+    { "lrtri", "\xe2\x8a\xbf", 5 },
+    { "NotGreaterEqual", "\xe2\x89\xb1", 15 },
+    { "frac56", "\xe2\x85\x9a", 6 },
+    { 0 },
+    { "LeftArrowBar", "\xe2\x87\xa4", 12 },
+    { "maltese", "\xe2\x9c\xa0", 7 },
+    { "Gbreve", "\xc4\x9e", 6 },
+    { "ljcy", "\xd1\x99", 4 },
+    { "EmptyVerySmallSquare", "\xe2\x96\xab", 20 },
+    { "Amacr", "\xc4\x80", 5 },
+    { "harrcir", "\xe2\xa5\x88", 7 },
+    { "NotReverseElement", "\xe2\x88\x8c", 17 },
+    { "vangrt", "\xe2\xa6\x9c", 6 },
+    { 0 },
+    { "auml", "\xc3\xa4", 4 },
+    { "nldr", "\xe2\x80\xa5", 4 },
+    { "subsetneqq", "\xe2\xab\x8b", 10 },
+    { "szlig", "\xc3\x9f", 5 },
+    { "cire", "\xe2\x89\x97", 4 },
+    { "bigcap", "\xe2\x8b\x82", 6 },
+    { "Eta", "\xce\x97", 3 },
+    { "nGt", "\xe2\x89\xab\xe2\x83\x92", 3 },
+    { "gesdot", "\xe2\xaa\x80", 6 },
+    { "Cacute", "\xc4\x86", 6 },
+    { "preceq", "\xe2\xaa\xaf", 6 },
+    { 0 },
+    { "frac18", "\xe2\x85\x9b", 6 },
+    { "parsl", "\xe2\xab\xbd", 5 },
+    { "profline", "\xe2\x8c\x92", 8 },
+    { "colone", "\xe2\x89\x94", 6 },
+    { "ulcorn", "\xe2\x8c\x9c", 6 },
+    { "dharl", "\xe2\x87\x83", 5 },
+    { "iuml", "\xc3\xaf", 4 },
+    { "NotLess", "\xe2\x89\xae", 7 },
+    { "lsaquo", "\xe2\x80\xb9", 6 },
+    { "bumpE", "\xe2\xaa\xae", 5 },
+    { "cuwed", "\xe2\x8b\x8f", 5 },
+    { "DifferentialD", "\xe2\x85\x86", 13 },
+    { "ngt", "\xe2\x89\xaf", 3 },
+    { "ohbar", "\xe2\xa6\xb5", 5 },
+    { "subrarr", "\xe2\xa5\xb9", 7 },
+    { "lagran", "\xe2\x84\x92", 6 },
+    { 0 },
+    { 0 },
+    { "YAcy", "\xd0\xaf", 4 },
+    { "pr", "\xe2\x89\xba", 2 },
+    { "nltri", "\xe2\x8b\xaa", 5 },
+    { "atilde", "\xc3\xa3", 6 },
+    { "ShortLeftArrow", "\xe2\x86\x90", 14 },
+    { "lacute", "\xc4\xba", 6 },
+    { "lparlt", "\xe2\xa6\x93", 6 },
+    { "NotPrecedes", "\xe2\x8a\x80", 11 },
+    { "topcir", "\xe2\xab\xb1", 6 },
+    { "prime", "\xe2\x80\xb2", 5 },
+    { "bigodot", "\xe2\xa8\x80", 7 },
+    { "range", "\xe2\xa6\xa5", 5 },
+    { "Hacek", "\xcb\x87", 5 },
+    { 0 },
+    { "sum", "\xe2\x88\x91", 3 },
+    { "npolint", "\xe2\xa8\x94", 7 },
+    { "nsupseteqq", "\xe2\xab\x86\xcc\xb8", 10 },
+    { "supsub", "\xe2\xab\x94", 6 },
+    { 0 },
+    { 0 },
+    { "nopf", "\xf0\x9d\x95\x9f", 4 },
+    { "UnderBracket", "\xe2\x8e\xb5", 12 },
+    { "sdot", "\xe2\x8b\x85", 4 },
+    { "Ograve", "\xc3\x92", 6 },
+    { 0 },
+    { "tint", "\xe2\x88\xad", 4 },
+    { "NotEqual", "\xe2\x89\xa0", 8 },
+    { "Ocirc", "\xc3\x94", 5 },
+    { 0 },
+    { "bopf", "\xf0\x9d\x95\x93", 4 },
+    { 0 },
+    { 0 },
+    { 0 },
+    { "bnot", "\xe2\x8c\x90", 4 },
+    { 0 },
+    { "hamilt", "\xe2\x84\x8b", 6 },
+    { "topf", "\xf0\x9d\x95\xa5", 4 },
+    { "oint", "\xe2\x88\xae", 4 },
+    { "ecir", "\xe2\x89\x96", 4 },
+    { "approxeq", "\xe2\x89\x8a", 8 },
+    { "nsim", "\xe2\x89\x81", 4 },
+    { "nsube", "\xe2\x8a\x88", 5 },
+    { 0 },
+    { "rcaron", "\xc5\x99", 6 },
+    { "NestedLessLess", "\xe2\x89\xaa", 14 },
+    { "looparrowleft", "\xe2\x86\xab", 13 },
+    { 0 },
+    { "curvearrowright", "\xe2\x86\xb7", 15 },
+    { 0 },
+    { "notnivb", "\xe2\x8b\xbe", 7 },
+    { "afr", "\xf0\x9d\x94\x9e", 3 },
+    { 0 },
+    { "nearrow", "\xe2\x86\x97", 7 },
+    { "xscr", "\xf0\x9d\x93\x8d", 4 },
+    { 0 },
+    { "DJcy", "\xd0\x82", 4 },
+    { "oslash", "\xc3\xb8", 6 },
+    { "VDash", "\xe2\x8a\xab", 5 },
+    { "Vfr", "\xf0\x9d\x94\x99", 3 },
+    { "DiacriticalGrave", "`", 16 },
+    { "sigma", "\xcf\x83", 5 },
+    { "ac", "\xe2\x88\xbe", 2 },
+    { "DownBreve", "\xcc\x91", 9 },
+    { "DownLeftVectorBar", "\xe2\xa5\x96", 17 },
+    { "beth", "\xe2\x84\xb6", 4 },
+    { "nisd", "\xe2\x8b\xba", 4 },
+    { 0 },
+    { "langd", "\xe2\xa6\x91", 5 },
+    { 0 },
+    { "imath", "\xc4\xb1", 5 },
+    { "male", "\xe2\x99\x82", 4 },
+    { "scaron", "\xc5\xa1", 6 },
+    { "blacklozenge", "\xe2\xa7\xab", 12 },
+    { "egs", "\xe2\xaa\x96", 3 },
+    { "Ouml", "\xc3\x96", 4 },
+    { "ShortUpArrow", "\xe2\x86\x91", 12 },
+    { "gsime", "\xe2\xaa\x8e", 5 },
+    { "hcirc", "\xc4\xa5", 5 },
+    { "efDot", "\xe2\x89\x92", 5 },
+    { "Colon", "\xe2\x88\xb7", 5 },
+    { "boxV", "\xe2\x95\x91", 4 },
+    { 0 },
+    { "curlywedge", "\xe2\x8b\x8f", 10 },
+    { 0 },
+    { "andd", "\xe2\xa9\x9c", 4 },
+    { "sol", "/", 3 },
+    { "thkap", "\xe2\x89\x88", 5 },
+    { "Gg", "\xe2\x8b\x99", 2 },
+    { "plankv", "\xe2\x84\x8f", 6 },
+    { "LeftUpTeeVector", "\xe2\xa5\xa0", 15 },
+    { "eth", "\xc3\xb0", 3 },
+    { "Vbar", "\xe2\xab\xab", 4 },
+    { "nrtri", "\xe2\x8b\xab", 5 },
+    { "supset", "\xe2\x8a\x83", 6 },
+    { 0 },
+    { "Alpha", "\xce\x91", 5 },
+    { "theta", "\xce\xb8", 5 },
+    { "female", "\xe2\x99\x80", 6 },
+    { 0 },
+    { "CloseCurlyDoubleQuote", "\xe2\x80\x9d", 21 },
+    { "ltquest", "\xe2\xa9\xbb", 7 },
+    { 0 },
+    { "Zdot", "\xc5\xbb", 4 },
+    { 0 },
+    { "rpar", ")", 4 },
+    { "nle", "\xe2\x89\xb0", 3 },
+    { "iocy", "\xd1\x91", 4 },
+    { "ccupssm", "\xe2\xa9\x90", 7 },
+    { 0 },
+    { "dsol", "\xe2\xa7\xb6", 4 },
+    { "dtri", "\xe2\x96\xbf", 4 },
+    { "ReverseUpEquilibrium", "\xe2\xa5\xaf", 20 },
+    { "lfr", "\xf0\x9d\x94\xa9", 3 },
+    { "shortparallel", "\xe2\x88\xa5", 13 },
+    { "bnequiv", "\xe2\x89\xa1\xe2\x83\xa5", 7 },
+    { 0 },
+    { "nLeftrightarrow", "\xe2\x87\x8e", 15 },
+    { "lesges", "\xe2\xaa\x93", 6 },
+    { "ccaron", "\xc4\x8d", 6 },
+    { "angrtvbd", "\xe2\xa6\x9d", 8 },
+    { "frac15", "\xe2\x85\x95", 6 },
+    { "trianglelefteq", "\xe2\x8a\xb4", 14 },
+    { "esim", "\xe2\x89\x82", 4 },
+    { "hybull", "\xe2\x81\x83", 6 },
+    { "sdote", "\xe2\xa9\xa6", 5 },
+    { "NotTildeTilde", "\xe2\x89\x89", 13 },
+    { "zeta", "\xce\xb6", 4 },
+    { "thicksim", "\xe2\x88\xbc", 8 },
+    { "gla", "\xe2\xaa\xa5", 3 },
+    { "Scedil", "\xc5\x9e", 6 },
+    { "seArr", "\xe2\x87\x98", 5 },
+    { "upharpoonleft", "\xe2\x86\xbf", 13 },
+    { "gtrless", "\xe2\x89\xb7", 7 },
+    { "Yuml", "\xc5\xb8", 4 },
+    { "wedgeq", "\xe2\x89\x99", 6 },
+    { "sce", "\xe2\xaa\xb0", 3 },
+    { 0 },
+    { "awconint", "\xe2\x88\xb3", 8 },
+    { "rmoustache", "\xe2\x8e\xb1", 10 },
+    { "yucy", "\xd1\x8e", 4 },
+    { "Ufr", "\xf0\x9d\x94\x98", 3 },
+    { 0 },
+    { "Ccaron", "\xc4\x8c", 6 },
+    { "cirscir", "\xe2\xa7\x82", 7 },
+    { 0 },
+    { "dharr", "\xe2\x87\x82", 5 },
+    { "Ecirc", "\xc3\x8a", 5 },
+    { 0 },
+    { 0 },
+    { "wopf", "\xf0\x9d\x95\xa8", 4 },
+    { "Therefore", "\xe2\x88\xb4", 9 },
+    { 0 },
+    { "Zfr", "\xe2\x84\xa8", 3 },
+    { "nsqsube", "\xe2\x8b\xa2", 7 },
+    { "ClockwiseContourIntegral", "\xe2\x88\xb2", 24 },
+    { "duhar", "\xe2\xa5\xaf", 5 },
+    { "subseteq", "\xe2\x8a\x86", 8 },
+    { "downharpoonleft", "\xe2\x87\x83", 15 },
+    { "khcy", "\xd1\x85", 4 },
+    { "Gammad", "\xcf\x9c", 6 },
+    { "ccups", "\xe2\xa9\x8c", 5 },
+    { "divonx", "\xe2\x8b\x87", 6 },
+    { "tscr", "\xf0\x9d\x93\x89", 4 },
+    { "ge", "\xe2\x89\xa5", 2 },
+    { "NegativeThickSpace", "\xe2\x80\x8b", 18 },
+    { "loang", "\xe2\x9f\xac", 5 },
+    { 0 },
+    { "vDash", "\xe2\x8a\xa8", 5 },
+    { "vnsup", "\xe2\x8a\x83\xe2\x83\x92", 5 },
+    { "nsupseteq", "\xe2\x8a\x89", 9 },
+    { "supseteqq", "\xe2\xab\x86", 9 },
+    { "laquo", "\xc2\xab", 5 },
+    { "Sum", "\xe2\x88\x91", 3 },
+    { "ordm", "\xc2\xba", 4 },
+    { 0 },
+    { "vartriangleright", "\xe2\x8a\xb3", 16 },
+    { 0 },
+    { "boxhu", "\xe2\x94\xb4", 5 },
+    { "DownRightTeeVector", "\xe2\xa5\x9f", 18 },
+    { 0 },
+    { "gopf", "\xf0\x9d\x95\x98", 4 },
+    { 0 },
+    { "gap", "\xe2\xaa\x86", 3 },
+    { "Udblac", "\xc5\xb0", 6 },
+    { "nltrie", "\xe2\x8b\xac", 6 },
+    { "ffr", "\xf0\x9d\x94\xa3", 3 },
+    { "icirc", "\xc3\xae", 5 },
+    { "LeftArrowRightArrow", "\xe2\x87\x86", 19 },
+    { "Lopf", "\xf0\x9d\x95\x83", 4 },
+    { "upharpoonright", "\xe2\x86\xbe", 14 },
+    { "GreaterFullEqual", "\xe2\x89\xa7", 16 },
+    { "DownArrow", "\xe2\x86\x93", 9 },
+    { "precnsim", "\xe2\x8b\xa8", 8 },
+    { "frasl", "\xe2\x81\x84", 5 },
+    { "filig", "\xef\xac\x81", 5 },
+    { "Upsilon", "\xce\xa5", 7 },
+    { "DownLeftTeeVector", "\xe2\xa5\x9e", 17 },
+    { 0 },
+    { "cirE", "\xe2\xa7\x83", 4 },
+    { 0 },
+    { "vsupnE", "\xe2\xab\x8c\xef\xb8\x80", 6 },
+    { "gsim", "\xe2\x89\xb3", 4 },
+    { "frac35", "\xe2\x85\x97", 6 },
+    { "cudarrl", "\xe2\xa4\xb8", 7 },
+    { "upsilon", "\xcf\x85", 7 },
+    { "rarr", "\xe2\x86\x92", 4 },
+    { "cularrp", "\xe2\xa4\xbd", 7 },
+    { "mp", "\xe2\x88\x93", 2 },
+    { "fllig", "\xef\xac\x82", 5 },
+    { "barwed", "\xe2\x8c\x85", 6 },
+    { "Bernoullis", "\xe2\x84\xac", 10 },
+    { "gneqq", "\xe2\x89\xa9", 5 },
+    { "Cscr", "\xf0\x9d\x92\x9e", 4 },
+    { 0 },
+    { "tau", "\xcf\x84", 3 },
+    { "dcaron", "\xc4\x8f", 6 },
+    { 0 },
+    { "nprcue", "\xe2\x8b\xa0", 6 },
+    { "scedil", "\xc5\x9f", 6 },
+    { "frac58", "\xe2\x85\x9d", 6 },
+    { "leftharpoonup", "\xe2\x86\xbc", 13 },
+    { "capdot", "\xe2\xa9\x80", 6 },
+    { "comma", ",", 5 },
+    { 0 },
+    { "le", "\xe2\x89\xa4", 2 },
+    { "sscr", "\xf0\x9d\x93\x88", 4 },
+    { "dlcorn", "\xe2\x8c\x9e", 6 },
+    { "kappa", "\xce\xba", 5 },
+    { "precneqq", "\xe2\xaa\xb5", 8 },
+    { "Vdashl", "\xe2\xab\xa6", 6 },
+    { "Hstrok", "\xc4\xa6", 6 },
+    { "UnderBrace", "\xe2\x8f\x9f", 10 },
+    { "tfr", "\xf0\x9d\x94\xb1", 3 },
+    { "Dagger", "\xe2\x80\xa1", 6 },
+    { "GreaterEqual", "\xe2\x89\xa5", 12 },
+    { "equest", "\xe2\x89\x9f", 6 },
+    { 0 },
+    { "boxvL", "\xe2\x95\xa1", 5 },
+    { "bdquo", "\xe2\x80\x9e", 5 },
+    { 0 },
+    { 0 },
+    { "zacute", "\xc5\xba", 6 },
+    { "rthree", "\xe2\x8b\x8c", 6 },
+    { "DoubleLeftRightArrow", "\xe2\x87\x94", 20 },
+    { "cupcup", "\xe2\xa9\x8a", 6 },
+    { "sqcap", "\xe2\x8a\x93", 5 },
+    { "Mopf", "\xf0\x9d\x95\x84", 4 },
+    { "nshortparallel", "\xe2\x88\xa6", 14 },
+    { "Or", "\xe2\xa9\x94", 2 },
+    { "smeparsl", "\xe2\xa7\xa4", 8 },
+    { 0 },
+    { "Acy", "\xd0\x90", 3 },
+    { 0 },
+    { "epsilon", "\xce\xb5", 7 },
+    { "sbquo", "\xe2\x80\x9a", 5 },
+    { "xharr", "\xe2\x9f\xb7", 5 },
+    { "Ucy", "\xd0\xa3", 3 },
+    { "ncaron", "\xc5\x88", 6 },
+    { "oS", "\xe2\x93\x88", 2 },
+    { "mdash", "\xe2\x80\x94", 5 },
+    { "ofr", "\xf0\x9d\x94\xac", 3 },
+    { 0 },
+    { "supE", "\xe2\xab\x86", 4 },
+    { "Iogon", "\xc4\xae", 5 },
+    { "iecy", "\xd0\xb5", 4 },
+    { "CounterClockwiseContourIntegral", "\xe2\x88\xb3", 31 },
+    { "supsup", "\xe2\xab\x96", 6 },
+    { "ngE", "\xe2\x89\xa7\xcc\xb8", 3 },
+    { "apE", "\xe2\xa9\xb0", 3 },
+    { "Breve", "\xcb\x98", 5 },
+    { 0 },
+    { 0 },
+    { "gtrdot", "\xe2\x8b\x97", 6 },
+    { "ntgl", "\xe2\x89\xb9", 4 },
+    { "kopf", "\xf0\x9d\x95\x9c", 4 },
+    { 0 },
+    { "Longleftarrow", "\xe2\x9f\xb8", 13 },
+    { "spadesuit", "\xe2\x99\xa0", 9 },
+    { 0 },
+    { 0 },
+    { "nles", "\xe2\xa9\xbd\xcc\xb8", 4 },
+    { 0 },
+    { "nrArr", "\xe2\x87\x8f", 5 },
+    { "frac12", "\xc2\xbd", 6 },
+    { "yuml", "\xc3\xbf", 4 },
+    { "prec", "\xe2\x89\xba", 4 },
+    { "SHcy", "\xd0\xa8", 4 },
+    { "ycirc", "\xc5\xb7", 5 },
+    { 0 },
+    { "angmsd", "\xe2\x88\xa1", 6 },
+    { "NotSquareSuperset", "\xe2\x8a\x90\xcc\xb8", 17 },
+    { "nvlt", "<\xe2\x83\x92", 4 },
+    { "zscr", "\xf0\x9d\x93\x8f", 4 },
+    { 0 },
+    { "ulcrop", "\xe2\x8c\x8f", 6 },
+    { "NotDoubleVerticalBar", "\xe2\x88\xa6", 20 },
+    { 0 },
+    { "Rarr", "\xe2\x86\xa0", 4 },
+    { "rarrlp", "\xe2\x86\xac", 6 },
+    { "cuesc", "\xe2\x8b\x9f", 5 },
+    { 0 },
+    { "Aopf", "\xf0\x9d\x94\xb8", 4 },
+    { 0 },
+    { "dbkarow", "\xe2\xa4\x8f", 7 },
+    { "lltri", "\xe2\x97\xba", 5 },
+    { "cfr", "\xf0\x9d\x94\xa0", 3 },
+    { "oscr", "\xe2\x84\xb4", 4 },
+    { "nvinfin", "\xe2\xa7\x9e", 7 },
+    { 0 },
+    { "lopf", "\xf0\x9d\x95\x9d", 4 },
+    { "Mfr", "\xf0\x9d\x94\x90", 3 },
+    { "nmid", "\xe2\x88\xa4", 4 },
+    { "nVDash", "\xe2\x8a\xaf", 6 },
+    { "veeeq", "\xe2\x89\x9a", 5 },
+    { "Zscr", "\xf0\x9d\x92\xb5", 4 },
+    { "RightTeeVector", "\xe2\xa5\x9b", 14 },
+    { "cap", "\xe2\x88\xa9", 3 },
+    { "circledS", "\xe2\x93\x88", 8 },
+    { "popf", "\xf0\x9d\x95\xa1", 4 },
+    { "varsigma", "\xcf\x82", 8 },
+    { 0 },
+    { "trade", "\xe2\x84\xa2", 5 },
+    { "drcrop", "\xe2\x8c\x8c", 6 },
+    { 0 },
+    { "Bumpeq", "\xe2\x89\x8e", 6 },
+    { 0 },
+    { "DoubleUpArrow", "\xe2\x87\x91", 13 },
+    { "nlsim", "\xe2\x89\xb4", 5 },
+    { 0 },
+    { "boxuR", "\xe2\x95\x98", 5 },
+    { "lsime", "\xe2\xaa\x8d", 5 },
+    { "vArr", "\xe2\x87\x95", 4 },
+    { "Uscr", "\xf0\x9d\x92\xb0", 4 },
+    { "circeq", "\xe2\x89\x97", 6 },
+    { 0 },
+    { "jcirc", "\xc4\xb5", 5 },
+    { 0 },
+    { "ell", "\xe2\x84\x93", 3 },
+    { "Mcy", "\xd0\x9c", 3 },
+    { "pcy", "\xd0\xbf", 3 },
+    { 0 },
+    { "lsim", "\xe2\x89\xb2", 4 },
+    { "ascr", "\xf0\x9d\x92\xb6", 4 },
+    { "uring", "\xc5\xaf", 5 },
+    { "dfisht", "\xe2\xa5\xbf", 6 },
+    { "gtlPar", "\xe2\xa6\x95", 6 },
+    { "rarrb", "\xe2\x87\xa5", 5 },
+    { "rhard", "\xe2\x87\x81", 5 },
+    { "llhard", "\xe2\xa5\xab", 6 },
+    { "lopar", "\xe2\xa6\x85", 5 },
+    { "oacute", "\xc3\xb3", 6 },
+    { 0 },
+    { 0 },
+    { "lstrok", "\xc5\x82", 6 },
+    { "ocy", "\xd0\xbe", 3 },
+    { "rharu", "\xe2\x87\x80", 5 },
+    { "longmapsto", "\xe2\x9f\xbc", 10 },
+    { "nGtv", "\xe2\x89\xab\xcc\xb8", 4 },
+    { "tcedil", "\xc5\xa3", 6 },
+    { "sup3", "\xc2\xb3", 4 },
+    { "Scaron", "\xc5\xa0", 6 },
+    { "NotGreaterFullEqual", "\xe2\x89\xa7\xcc\xb8", 19 },
+    { "raemptyv", "\xe2\xa6\xb3", 8 },
+    { "Updownarrow", "\xe2\x87\x95", 11 },
+    { "suphsol", "\xe2\x9f\x89", 7 },
+    { "egsdot", "\xe2\xaa\x98", 6 },
+    { "lcaron", "\xc4\xbe", 6 },
+    { "boxUL", "\xe2\x95\x9d", 5 },
+    { "Nfr", "\xf0\x9d\x94\x91", 3 },
+    { "Sc", "\xe2\xaa\xbc", 2 },
+    { "EmptySmallSquare", "\xe2\x97\xbb", 16 },
+    { "precsim", "\xe2\x89\xbe", 7 },
+    { "lotimes", "\xe2\xa8\xb4", 7 },
+    { "DiacriticalDot", "\xcb\x99", 14 },
+    { "RightTee", "\xe2\x8a\xa2", 8 },
+    { "cwint", "\xe2\x88\xb1", 5 },
+    { "nprec", "\xe2\x8a\x80", 5 },
+    { "zigrarr", "\xe2\x87\x9d", 7 },
+    { "napprox", "\xe2\x89\x89", 7 },
+    { "rarrsim", "\xe2\xa5\xb4", 7 },
+    { "nwArr", "\xe2\x87\x96", 5 },
+    { "nvdash", "\xe2\x8a\xac", 6 },
+    { 0 },
+    { 0 },
+    { "UpArrow", "\xe2\x86\x91", 7 },
+    { "ncong", "\xe2\x89\x87", 5 },
+    { "wscr", "\xf0\x9d\x93\x8c", 4 },
+    { 0 },
+    { "NotSubsetEqual", "\xe2\x8a\x88", 14 },
+    { 0 },
+    { "ntilde", "\xc3\xb1", 6 },
+    { "lambda", "\xce\xbb", 6 },
+    { "bigotimes", "\xe2\xa8\x82", 9 },
+    { "OverParenthesis", "\xe2\x8f\x9c", 15 },
+    { "Uopf", "\xf0\x9d\x95\x8c", 4 },
+    { "boxUl", "\xe2\x95\x9c", 5 },
+    { "origof", "\xe2\x8a\xb6", 6 },
+    { "ll", "\xe2\x89\xaa", 2 },
+    { "amalg", "\xe2\xa8\xbf", 5 },
+    { "vltri", "\xe2\x8a\xb2", 5 },
+    { "angrt", "\xe2\x88\x9f", 5 },
+    { "hbar", "\xe2\x84\x8f", 4 },
+    { "imof", "\xe2\x8a\xb7", 4 },
+    { "Ocy", "\xd0\x9e", 3 },
+    { "succeq", "\xe2\xaa\xb0", 6 },
+    { "cup", "\xe2\x88\xaa", 3 },
+    { "exponentiale", "\xe2\x85\x87", 12 },
+    { "numsp", "\xe2\x80\x87", 5 },
+    { 0 },
+    { "uarr", "\xe2\x86\x91", 4 },
+    { "langle", "\xe2\x9f\xa8", 6 },
+    { "DoubleLeftTee", "\xe2\xab\xa4", 13 },
+    { 0 },
+    { "RightDownTeeVector", "\xe2\xa5\x9d", 18 },
+    { 0 },
+    { "bsol", "\x5c", 4 },
+    { 0 },
+    { "fcy", "\xd1\x84", 3 },
+    { "simgE", "\xe2\xaa\xa0", 5 },
+    { "Tcaron", "\xc5\xa4", 6 },
+    { "rscr", "\xf0\x9d\x93\x87", 4 },
+    { "ntriangleright", "\xe2\x8b\xab", 14 },
+    { "rx", "\xe2\x84\x9e", 2 },
+    { "curarr", "\xe2\x86\xb7", 6 },
+    { "ncy", "\xd0\xbd", 3 },
+    { "nang", "\xe2\x88\xa0\xe2\x83\x92", 4 },
+    { "utri", "\xe2\x96\xb5", 4 },
+    { "KJcy", "\xd0\x8c", 4 },
+    { "GreaterTilde", "\xe2\x89\xb3", 12 },
+    { 0 },
+    { "lne", "\xe2\xaa\x87", 3 },
+    { 0 },
+    { "ForAll", "\xe2\x88\x80", 6 },
+    { "blacktriangledown", "\xe2\x96\xbe", 17 },
+    { "Psi", "\xce\xa8", 3 },
+    { "blacktriangleleft", "\xe2\x97\x82", 17 },
+    { "topbot", "\xe2\x8c\xb6", 6 },
+    { "gnE", "\xe2\x89\xa9", 3 },
+    { "subE", "\xe2\xab\x85", 4 },
+    { "part", "\xe2\x88\x82", 4 },
+    { "DotEqual", "\xe2\x89\x90", 8 },
+    { "dfr", "\xf0\x9d\x94\xa1", 3 },
+    { "Equilibrium", "\xe2\x87\x8c", 11 },
+    { "barwedge", "\xe2\x8c\x85", 8 },
+    { "succnsim", "\xe2\x8b\xa9", 8 },
+    { "Dopf", "\xf0\x9d\x94\xbb", 4 },
+    { "nsce", "\xe2\xaa\xb0\xcc\xb8", 4 },
+    { 0 },
+    { "DZcy", "\xd0\x8f", 4 },
+    { "andslope", "\xe2\xa9\x98", 8 },
+    { "boxuL", "\xe2\x95\x9b", 5 },
+    { "RightArrow", "\xe2\x86\x92", 10 },
+    { "lbrack", "[", 6 },
+    { "LeftDownVectorBar", "\xe2\xa5\x99", 17 },
+    { "xutri", "\xe2\x96\xb3", 5 },
+    { 0 },
+    { "breve", "\xcb\x98", 5 },
+    { "ntrianglelefteq", "\xe2\x8b\xac", 15 },
+    { "Zopf", "\xe2\x84\xa4", 4 },
+    { 0 },
+    { "iinfin", "\xe2\xa7\x9c", 6 },
+    { "smtes", "\xe2\xaa\xac\xef\xb8\x80", 5 },
+    { "lneqq", "\xe2\x89\xa8", 5 },
+    { "LessGreater", "\xe2\x89\xb6", 11 },
+    { "napE", "\xe2\xa9\xb0\xcc\xb8", 4 },
+    { "gvnE", "\xe2\x89\xa9\xef\xb8\x80", 4 },
+    { "boxvh", "\xe2\x94\xbc", 5 },
+    { "napid", "\xe2\x89\x8b\xcc\xb8", 5 },
+    { "disin", "\xe2\x8b\xb2", 5 },
+    { "aring", "\xc3\xa5", 5 },
+    { "uwangle", "\xe2\xa6\xa7", 7 },
+    { "rbrke", "\xe2\xa6\x8c", 5 },
+    { "Eogon", "\xc4\x98", 5 },
+    { "OpenCurlyDoubleQuote", "\xe2\x80\x9c", 20 },
+    { "Conint", "\xe2\x88\xaf", 6 },
+    { "gE", "\xe2\x89\xa7", 2 },
+    { "lessdot", "\xe2\x8b\x96", 7 },
+    { "nges", "\xe2\xa9\xbe\xcc\xb8", 4 },
+    { "Superset", "\xe2\x8a\x83", 8 },
+    { "Ntilde", "\xc3\x91", 6 },
+    { "apacir", "\xe2\xa9\xaf", 6 },
+    { "boxdr", "\xe2\x94\x8c", 5 },
+    { "wcirc", "\xc5\xb5", 5 },
+    { 0 },
+    { "subsim", "\xe2\xab\x87", 6 },
+    { 0 },
+    { "omid", "\xe2\xa6\xb6", 4 },
+    { "varsupsetneqq", "\xe2\xab\x8c\xef\xb8\x80", 13 },
+    { "urcorn", "\xe2\x8c\x9d", 6 },
+    { "oopf", "\xf0\x9d\x95\xa0", 4 },
+    { "sqsupset", "\xe2\x8a\x90", 8 },
+    { "emptyset", "\xe2\x88\x85", 8 },
+    { "Cedilla", "\xc2\xb8", 7 },
+    { "Supset", "\xe2\x8b\x91", 6 },
+    { 0 },
+    { "Uring", "\xc5\xae", 5 },
+    { "vzigzag", "\xe2\xa6\x9a", 7 },
+    { "lesseqgtr", "\xe2\x8b\x9a", 9 },
+    { "CircleMinus", "\xe2\x8a\x96", 11 },
+    { "Star", "\xe2\x8b\x86", 4 },
+    { "LeftUpVector", "\xe2\x86\xbf", 12 },
+    { "edot", "\xc4\x97", 4 },
+    { "icy", "\xd0\xb8", 3 },
+    { "bbrk", "\xe2\x8e\xb5", 4 },
+    { "nsqsupe", "\xe2\x8b\xa3", 7 },
+    { "plussim", "\xe2\xa8\xa6", 7 },
+    { "bernou", "\xe2\x84\xac", 6 },
+    { "hfr", "\xf0\x9d\x94\xa5", 3 },
+    { 0 },
+    { "ncup", "\xe2\xa9\x82", 4 },
+    { "imacr", "\xc4\xab", 5 },
+    { "bigvee", "\xe2\x8b\x81", 6 },
+    { "rfisht", "\xe2\xa5\xbd", 6 },
+    { "ncap", "\xe2\xa9\x83", 4 },
+    { "Cross", "\xe2\xa8\xaf", 5 },
+    { "Lfr", "\xf0\x9d\x94\x8f", 3 },
+    { "odsold", "\xe2\xa6\xbc", 6 },
+    { "NotSquareSubsetEqual", "\xe2\x8b\xa2", 20 },
+    { 0 },
+    { "yacy", "\xd1\x8f", 4 },
+    { 0 },
+    { 0 },
+    { "mcy", "\xd0\xbc", 3 },
+    { 0 },
+    { 0 },
+    { 0 },
+    { "Uarrocir", "\xe2\xa5\x89", 8 },
+    { "spar", "\xe2\x88\xa5", 4 },
+    { 0 },
+    { 0 },
+    { 0 },
+    { "nvrtrie", "\xe2\x8a\xb5\xe2\x83\x92", 7 },
+    { "isin", "\xe2\x88\x88", 4 },
+    { "LeftTeeVector", "\xe2\xa5\x9a", 13 },
+    { "ijlig", "\xc4\xb3", 5 },
+    { "mscr", "\xf0\x9d\x93\x82", 4 },
+    { "xrArr", "\xe2\x9f\xb9", 5 },
+    { "loplus", "\xe2\xa8\xad", 6 },
+    { "parsim", "\xe2\xab\xb3", 6 },
+    { "delta", "\xce\xb4", 5 },
+    { "frac14", "\xc2\xbc", 6 },
+    { "gacute", "\xc7\xb5", 6 },
+    { "xoplus", "\xe2\xa8\x81", 6 },
+    { "olcross", "\xe2\xa6\xbb", 7 },
+    { "veebar", "\xe2\x8a\xbb", 6 },
+    { "angst", "\xc3\x85", 5 },
+    { 0 },
+    { "Rarrtl", "\xe2\xa4\x96", 6 },
+    { "isinE", "\xe2\x8b\xb9", 5 },
+    { "Vcy", "\xd0\x92", 3 },
+    { "HumpDownHump", "\xe2\x89\x8e", 12 },
+    { "SquareSuperset", "\xe2\x8a\x90", 14 },
+    { "Int", "\xe2\x88\xac", 3 },
+    { "ffilig", "\xef\xac\x83", 6 },
+    { 0 },
+    { "PrecedesEqual", "\xe2\xaa\xaf", 13 },
+    { "rrarr", "\xe2\x87\x89", 5 },
+    { "eplus", "\xe2\xa9\xb1", 5 },
+    { "LT", "<", 2 },
+    { "cylcty", "\xe2\x8c\xad", 6 },
+    { "lgE", "\xe2\xaa\x91", 3 },
+    { "ltrie", "\xe2\x8a\xb4", 5 },
+    { 0 },
+    { "swArr", "\xe2\x87\x99", 5 },
+    { "shchcy", "\xd1\x89", 6 },
+    { "InvisibleComma", "\xe2\x81\xa3", 14 },
+    { "egrave", "\xc3\xa8", 6 },
+    { "Hat", "^", 3 },
+    { "pre", "\xe2\xaa\xaf", 3 },
+    { "Sopf", "\xf0\x9d\x95\x8a", 4 },
+    { "midast", "*", 6 },
+    { "Qscr", "\xf0\x9d\x92\xac", 4 },
+    { "risingdotseq", "\xe2\x89\x93", 12 },
+    { "solb", "\xe2\xa7\x84", 4 },
+    { "gimel", "\xe2\x84\xb7", 5 },
+    { "And", "\xe2\xa9\x93", 3 },
+    { "gbreve", "\xc4\x9f", 6 },
+    { "angmsdad", "\xe2\xa6\xab", 8 },
+    { "fflig", "\xef\xac\x80", 5 },
+    { "vsubne", "\xe2\x8a\x8a\xef\xb8\x80", 6 },
+    { "gesl", "\xe2\x8b\x9b\xef\xb8\x80", 4 },
+    { "supdsub", "\xe2\xab\x98", 7 },
+    { "zhcy", "\xd0\xb6", 4 },
+    { "osol", "\xe2\x8a\x98", 4 },
+    { "lsquor", "\xe2\x80\x9a", 6 },
+    { "awint", "\xe2\xa8\x91", 5 },
+    { "supsetneqq", "\xe2\xab\x8c", 10 },
+    { "notinE", "\xe2\x8b\xb9\xcc\xb8", 6 },
+    { 0 },
+    { "rang", "\xe2\x9f\xa9", 4 },
+    { "Zacute", "\xc5\xb9", 6 },
+    { "utrif", "\xe2\x96\xb4", 5 },
+    { 0 },
+    { "lhblk", "\xe2\x96\x84", 5 },
+    { "NotEqualTilde", "\xe2\x89\x82\xcc\xb8", 13 },
+    { "Esim", "\xe2\xa9\xb3", 4 },
+    { 0 },
+    { "nacute", "\xc5\x84", 6 },
+    { 0 },
+    { "ldrdhar", "\xe2\xa5\xa7", 7 },
+    { "ngeq", "\xe2\x89\xb1", 4 },
+    { "caron", "\xcb\x87", 5 },
+    { "ltrPar", "\xe2\xa6\x96", 6 },
+    { "boxVL", "\xe2\x95\xa3", 5 },
+    { "isinsv", "\xe2\x8b\xb3", 6 },
+    { "Ccedil", "\xc3\x87", 6 },
+    { "boxH", "\xe2\x95\x90", 4 },
+    { "Precedes", "\xe2\x89\xba", 8 },
+    { "wreath", "\xe2\x89\x80", 6 },
+    { "Nu", "\xce\x9d", 2 },
+    { "nsubseteq", "\xe2\x8a\x88", 9 },
+    { "bigwedge", "\xe2\x8b\x80", 8 },
+    { 0 },
+    { "minusd", "\xe2\x88\xb8", 6 },
+    { "num", "#", 3 },
+    { "mldr", "\xe2\x80\xa6", 4 },
+    { "zwj", "\xe2\x80\x8d", 3 },
+    { "primes", "\xe2\x84\x99", 6 },
+    { "ratail", "\xe2\xa4\x9a", 6 },
+    { "subedot", "\xe2\xab\x83", 7 },
+    { "frac34", "\xc2\xbe", 6 },
+    { "scap", "\xe2\xaa\xb8", 4 },
+    { "Omicron", "\xce\x9f", 7 },
+    { "demptyv", "\xe2\xa6\xb1", 7 },
+    { "boxVr", "\xe2\x95\x9f", 5 },
+    { "approx", "\xe2\x89\x88", 6 },
+    { 0 },
+    { "NotSucceedsEqual", "\xe2\xaa\xb0\xcc\xb8", 16 },
+    { "Rcy", "\xd0\xa0", 3 },
+    { "integers", "\xe2\x84\xa4", 8 },
+    { "xcap", "\xe2\x8b\x82", 4 },
+    { "Barv", "\xe2\xab\xa7", 4 },
+    { "YUcy", "\xd0\xae", 4 },
+    { "zcy", "\xd0\xb7", 3 },
+    { "opar", "\xe2\xa6\xb7", 4 },
+    { "HorizontalLine", "\xe2\x94\x80", 14 },
+    { "bsemi", "\xe2\x81\x8f", 5 },
+    { "para", "\xc2\xb6", 4 },
+    { "homtht", "\xe2\x88\xbb", 6 },
+    { "supmult", "\xe2\xab\x82", 7 },
+    { "LeftTeeArrow", "\xe2\x86\xa4", 12 },
+    { "ovbar", "\xe2\x8c\xbd", 5 },
+    { "acE", "\xe2\x88\xbe\xcc\xb3", 3 },
+    { 0 },
+    { "NotSquareSupersetEqual", "\xe2\x8b\xa3", 22 },
+    { "Eacute", "\xc3\x89", 6 },
+    { "deg", "\xc2\xb0", 3 },
+    { "Verbar", "\xe2\x80\x96", 6 },
+    { "dHar", "\xe2\xa5\xa5", 4 },
+    { "tcy", "\xd1\x82", 3 },
+    { "lArr", "\xe2\x87\x90", 4 },
+    { "Ffr", "\xf0\x9d\x94\x89", 3 },
+    { "looparrowright", "\xe2\x86\xac", 14 },
+    { "subdot", "\xe2\xaa\xbd", 6 },
+    { "mu", "\xce\xbc", 2 },
+    { "larrfs", "\xe2\xa4\x9d", 6 },
+    { 0 },
+    { "psi", "\xcf\x88", 3 },
+    { "NJcy", "\xd0\x8a", 4 },
+    { "there4", "\xe2\x88\xb4", 6 },
+    { "vprop", "\xe2\x88\x9d", 5 },
+    { 0 },
+    { "SucceedsEqual", "\xe2\xaa\xb0", 13 },
+    { 0 },
+    { "pfr", "\xf0\x9d\x94\xad", 3 },
+    { "prap", "\xe2\xaa\xb7", 4 },
+    { "ecaron", "\xc4\x9b", 6 },
+    { 0 },
+};
+
+/* Names also recognized without the closing ';' (sorted, for bsearch) */
+static const char *const html_entity_legacy[HTML_ENTITY_LEGACY] = {
+    "AElig", "AMP", "Aacute", "Acirc", "Agrave", "Aring", "Atilde", "Auml",
+    "COPY", "Ccedil", "ETH", "Eacute", "Ecirc", "Egrave", "Euml", "GT",
+    "Iacute", "Icirc", "Igrave", "Iuml", "LT", "Ntilde", "Oacute", "Ocirc",
+    "Ograve", "Oslash", "Otilde", "Ouml", "QUOT", "REG", "THORN", "Uacute",
+    "Ucirc", "Ugrave", "Uuml", "Yacute", "aacute", "acirc", "acute", "aelig",
+    "agrave", "amp", "aring", "atilde", "auml", "brvbar", "ccedil", "cedil",
+    "cent", "copy", "curren", "deg", "divide", "eacute", "ecirc", "egrave",
+    "eth", "euml", "frac12", "frac14", "frac34", "gt", "iacute", "icirc",
+    "iexcl", "igrave", "iquest", "iuml", "laquo", "lt", "macr", "micro",
+    "middot", "nbsp", "not", "ntilde", "oacute", "ocirc", "ograve", "ordf",
+    "ordm", "oslash", "otilde", "ouml", "para", "plusmn", "pound", "quot",
+    "raquo", "reg", "sect", "shy", "sup1", "sup2", "sup3", "szlig",
+    "thorn", "times", "uacute", "ucirc", "ugrave", "uml", "uuml", "yacute",
+    "yen", "yuml",
+};
+
+#endif /* HTML_ENTITIES_H */
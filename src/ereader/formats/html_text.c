@@ -0,0 +1,546 @@
+/*
+ * html_text.c - Streaming HTML to Plain Text Conversion
+ *
+ * One state machine over the raw markup bytes. Runs of plain text are
+ * found through a byte class table and copied with a single memcpy; tags
+ * are only examined for their name; character references are looked up in
+ * the generated perfect hash table (html_entities.h).
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include "html_text.h"
+#include "html_entities.h"
+#include "charset.h"
+#include "../rendering/utf8.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Parser states */
+enum {
+    STATE_TEXT = 0,     /* Character data */
+    STATE_TAG_OPEN,     /* Just after '<' */
+    STATE_TAG_NAME,     /* Inside the tag name */
+    STATE_TAG,          /* Inside the tag, after its name */
+    STATE_QUOTE,        /* Inside a quoted attribute value */
+    STATE_COMMENT,      /* Inside <!-- --> */
+    STATE_RAW,          /* Skipping script/style/title content */
+    STATE_REF           /* Inside a character reference, after '&' */
+};
+
+/* Byte classes */
+enum {
+    CLASS_PLAIN = 0,
+    CLASS_SPACE,
+    CLASS_LT,
+    CLASS_AMP,
+    CLASS_CR
+};
+
+static const uint8_t text_class[256] = {
+    [' '] = CLASS_SPACE, ['\t'] = CLASS_SPACE, ['\n'] = CLASS_SPACE, ['\f'] = CLASS_SPACE,
+    ['\r'] = CLASS_CR, ['<'] = CLASS_LT, ['&'] = CLASS_AMP
+};
+
+/* Bytes that matter inside a tag: 1 after its name, 2 only ending the name */
+static const uint8_t tag_class[256] = {
+    ['>'] = 1, ['"'] = 1, ['\''] = 1, ['/'] = 1,
+    [' '] = 2, ['\t'] = 2, ['\n'] = 2, ['\r'] = 2, ['\f'] = 2
+};
+
+/* What an element does to the text */
+enum {
+    TAG_BLOCK = 1,      /* Starts and ends a line */
+    TAG_BREAK,          /* <br>: ends a line */
+    TAG_CELL,           /* Table cell: separates words */
+    TAG_PRE,            /* Block that keeps its whitespace */
+    TAG_RAW             /* Content is not text */
+};
+
+typedef struct {
+    const char *name;
+    uint8_t action;
+} tag_action_t;
+
+/* Sorted, for bsearch */
+static const tag_action_t tag_actions[] = {
+    { "address", TAG_BLOCK }, { "article", TAG_BLOCK }, { "aside", TAG_BLOCK },
+    { "blockquote", TAG_BLOCK }, { "body", TAG_BLOCK }, { "br", TAG_BREAK },
+    { "caption", TAG_BLOCK }, { "dd", TAG_BLOCK }, { "div", TAG_BLOCK },
+    { "dl", TAG_BLOCK }, { "dt", TAG_BLOCK }, { "figcaption", TAG_BLOCK },
+    { "figure", TAG_BLOCK }, { "footer", TAG_BLOCK }, { "h1", TAG_BLOCK },
+    { "h2", TAG_BLOCK }, { "h3", TAG_BLOCK }, { "h4", TAG_BLOCK },
+    { "h5", TAG_BLOCK }, { "h6", TAG_BLOCK }, { "header", TAG_BLOCK },
+    { "hr", TAG_BLOCK }, { "li", TAG_BLOCK }, { "main", TAG_BLOCK },
+    { "nav", TAG_BLOCK }, { "ol", TAG_BLOCK }, { "p", TAG_BLOCK },
+    { "pre", TAG_PRE }, { "script", TAG_RAW }, { "section", TAG_BLOCK },
+    { "style", TAG_RAW }, { "table", TAG_BLOCK }, { "td", TAG_CELL },
+    { "th", TAG_CELL }, { "title", TAG_RAW }, { "tr", TAG_BLOCK },
+    { "ul", TAG_BLOCK }
+};
+
+#define TAG_ACTION_COUNT (sizeof(tag_actions) / sizeof(tag_actions[0]))
+
+/*
+ * Output
+ */
+
+/* Append bytes, dropping whatever does not fit */
+static void put(html_text_t *ht, const char *text, size_t length) {
+    size_t room = ht->capacity - ht->length;
+    if (length > room) {
+        length = room;
+        ht->truncated = true;
+    }
+    memcpy(ht->out + ht->length, text, length);
+    ht->length += length;
+}
+
+/* Append text, preceded by one space if whitespace came before it */
+static void put_text(html_text_t *ht, const char *text, size_t length) {
+    if (ht->pending_space) {
+        ht->pending_space = false;
+        if (ht->length > 0 && ht->out[ht->length - 1] != '\n') {
+            put(ht, " ", 1);
+        }
+    }
+    put(ht, text, length);
+}
+
+/* End the current line (never leaves an empty line behind) */
+static void put_break(html_text_t *ht) {
+    ht->pending_space = false;
+    if (ht->length > 0 && ht->out[ht->length - 1] != '\n') {
+        put(ht, "\n", 1);
+    }
+}
+
+static void put_codepoint(html_text_t *ht, uint32_t cp) {
+    char buf[4];
+
+    if (cp == 0xAD) {
+        return;                     /* Soft hyphen: the renderer wraps on its own */
+    }
+    if (cp == 0xA0) {
+        cp = ' ';                   /* No-break space: the font has no glyph */
+    }
+    put_text(ht, buf, utf8_encode(cp, buf));
+}
+
+static void put_entity(html_text_t *ht, const html_entity_t *entity) {
+    const char *utf8 = entity->utf8;
+
+    /* Same treatment as the numeric forms for &nbsp; and &shy; */
+    if (utf8[0] == '\xc2' && (utf8[1] == '\xa0' || utf8[1] == '\xad') && utf8[2] == '\0') {
+        put_codepoint(ht, (unsigned char)utf8[1]);
+    } else {
+        put_text(ht, utf8, strlen(utf8));
+    }
+}
+
+/*
+ * Tags
+ */
+
+static int compare_tag_action(const void *key, const void *entry) {
+    return strcmp((const char *)key, ((const tag_action_t *)entry)->name);
+}
+
+/* Act on a complete tag name */
+static void tag_named(html_text_t *ht) {
+    ht->tag[ht->tag_length] = '\0';
+    const tag_action_t *tag = bsearch(ht->tag, tag_actions, TAG_ACTION_COUNT,
+                                      sizeof(tag_actions[0]), compare_tag_action);
+    if (!tag) {
+        return;
+    }
+
+    switch (tag->action) {
+    case TAG_BLOCK:
+    case TAG_BREAK:
+        put_break(ht);
+        break;
+    case TAG_CELL:
+        ht->pending_space = true;
+        break;
+    case TAG_PRE:
+        put_break(ht);
+        if (ht->end_tag) {
+            if (ht->pre_depth > 0) {
+                ht->pre_depth--;
+            }
+        } else {
+            ht->pre_depth++;
+        }
+        break;
+    case TAG_RAW:
+        if (!ht->end_tag) {
+            ht->raw_end = tag->name;
+            ht->raw_match = 0;
+        }
+        break;
+    }
+}
+
+/* The tag's '>' was reached */
+static void tag_closed(html_text_t *ht) {
+    if (ht->raw_end && !ht->self_closing) {
+        ht->state = STATE_RAW;      /* Skip to the matching close tag */
+        return;
+    }
+    ht->raw_end = NULL;
+    ht->state = STATE_TEXT;
+}
+
+/*
+ * Character References
+ */
+
+static uint32_t html_entity_hash(const char *name, size_t length, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+    for (size_t i = 0; i < length; i++) {
+        h ^= (unsigned char)name[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static const html_entity_t* html_entity_lookup(const char *name, size_t length) {
+    if (length == 0 || length > HTML_ENTITY_NAME_MAX) {
+        return NULL;
+    }
+
+    uint32_t bucket = html_entity_hash(name, length, 0) % HTML_ENTITY_BUCKETS;
+    uint32_t slot = html_entity_hash(name, length, html_entity_displacement[bucket]) %
+                    HTML_ENTITY_SLOTS;
+    const html_entity_t *entity = &html_entity_table[slot];
+
+    if (entity->name && entity->name_length == length &&
+        memcmp(entity->name, name, length) == 0) {
+        return entity;
+    }
+    return NULL;
+}
+
+static int compare_legacy(const void *key, const void *entry) {
+    return strcmp((const char *)key, *(const char *const *)entry);
+}
+
+/* Length of the longest name valid without ';' that prefixes ref, or 0 */
+static size_t legacy_prefix(const char *ref, size_t length) {
+    char name[HTML_TEXT_REF_MAX + 1];
+
+    /* Legacy names are at most 6 bytes ("frac12", "curren") */
+    for (size_t n = length < 6 ? length : 6; n >= 2; n--) {
+        memcpy(name, ref, n);
+        name[n] = '\0';
+        if (bsearch(name, html_entity_legacy, HTML_ENTITY_LEGACY,
+                    sizeof(html_entity_legacy[0]), compare_legacy)) {
+            return n;
+        }
+    }
+    return 0;
+}
+
+/* Numeric reference to codepoint, per HTML5 (returns bytes of ref used, 0 if none) */
+static size_t parse_numeric(const char *ref, size_t length, uint32_t *out_cp) {
+    size_t i = 1;                   /* Past '#' */
+    int base = 10;
+    uint32_t value = 0;
+
+    if (i < length && (ref[i] == 'x' || ref[i] == 'X')) {
+        base = 16;
+        i++;
+    }
+
+    size_t digits_start = i;
+    for (; i < length; i++) {
+        char c = ref[i];
+        int digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (base == 16 && c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if (base == 16 && c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            break;
+        }
+        if (value <= 0x10FFFF) {
+            value = value * base + digit;
+        }
+    }
+    if (i == digits_start) {
+        return 0;
+    }
+
+    if (value == 0 || value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF)) {
+        value = 0xFFFD;
+    } else if (value >= 0x80 && value <= 0x9F) {
+        value = charset_decode_cp1252((unsigned char)value);
+    }
+
+    *out_cp = value;
+    return i;
+}
+
+/* Decode the collected reference; terminated says whether ';' ended it */
+static void resolve_ref(html_text_t *ht, bool terminated) {
+    const char *ref = ht->ref;
+    size_t length = ht->ref_length;
+    size_t used = 0;
+
+    ht->state = STATE_TEXT;
+
+    if (length > 0 && ref[0] == '#') {
+        uint32_t cp;
+        used = parse_numeric(ref, length, &cp);
+        if (used > 0) {
+            put_codepoint(ht, cp);
+        }
+    } else {
+        const html_entity_t *entity = terminated ? html_entity_lookup(ref, length) : NULL;
+        if (entity) {
+            put_entity(ht, entity);
+            return;
+        }
+
+        /* Legacy names also match as a prefix ("&copy2024" is "(c)2024") */
+        used = legacy_prefix(ref, length);
+        entity = used > 0 ? html_entity_lookup(ref, used) : NULL;
+        if (entity) {
+            put_entity(ht, entity);
+        } else {
+            used = 0;
+        }
+    }
+
+    /* Whatever was not part of a reference is ordinary text */
+    if (used == 0) {
+        put_text(ht, "&", 1);
+    }
+    if (used < length) {
+        put_text(ht, ref + used, length - used);
+    }
+    if (terminated && (used == 0 || used < length)) {
+        put_text(ht, ";", 1);
+    }
+}
+
+static bool is_ref_char(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+/*
+ * Conversion
+ */
+
+void html_text_init(html_text_t *ht, char *out, size_t capacity) {
+    memset(ht, 0, sizeof(*ht));
+    ht->out = out;
+    ht->capacity = capacity;
+    ht->state = STATE_TEXT;
+}
+
+void html_text_feed(html_text_t *ht, const char *data, size_t length) {
+    size_t i = 0;
+
+    while (i < length) {
+        unsigned char c = (unsigned char)data[i];
+
+        switch (ht->state) {
+        case STATE_TEXT: {
+            /* Copy the run of plain bytes in one go */
+            size_t start = i;
+            while (i < length && text_class[(unsigned char)data[i]] == CLASS_PLAIN) {
+                i++;
+            }
+            if (i > start) {
+                put_text(ht, data + start, i - start);
+                if (i == length) {
+                    break;
+                }
+                c = (unsigned char)data[i];
+            }
+            i++;
+
+            switch (text_class[c]) {
+            case CLASS_SPACE:
+                if (ht->pre_depth == 0) {
+                    ht->pending_space = true;
+                } else if (c == '\n') {
+                    put(ht, "\n", 1);
+                } else {
+                    put_text(ht, " ", 1);
+                }
+                break;
+            case CLASS_LT:
+                ht->state = STATE_TAG_OPEN;
+                break;
+            case CLASS_AMP:
+                ht->ref_length = 0;
+                ht->state = STATE_REF;
+                break;
+            default:
+                break;              /* '\r' never reaches the text */
+            }
+            break;
+        }
+
+        case STATE_TAG_OPEN:
+            ht->tag_length = 0;
+            ht->end_tag = false;
+            ht->self_closing = false;
+            if (c == '/') {
+                ht->end_tag = true;
+                ht->state = STATE_TAG_NAME;
+                i++;
+            } else if (c == '!' || (unsigned)((c | 0x20) - 'a') < 26u) {
+                ht->state = STATE_TAG_NAME;
+            } else if (c == '?') {
+                ht->state = STATE_TAG;
+                i++;
+            } else {
+                /* A lone '<' is text */
+                put_text(ht, "<", 1);
+                ht->state = STATE_TEXT;
+            }
+            break;
+
+        case STATE_TAG_NAME:
+            if (tag_class[c] == 2 || c == '>' || c == '/') {
+                tag_named(ht);
+                ht->state = STATE_TAG;
+                break;              /* Reprocess in STATE_TAG */
+            }
+            if (ht->tag_length < HTML_TEXT_TAG_MAX) {
+                ht->tag[ht->tag_length++] = (c >= 'A' && c <= 'Z') ? c + 32 : c;
+            } else {
+                ht->tag[0] = '\0';  /* Too long to be anything we know */
+            }
+            i++;
+            if (ht->tag_length == 3 && memcmp(ht->tag, "!--", 3) == 0) {
+                ht->dashes = 0;
+                ht->state = STATE_COMMENT;
+            }
+            break;
+
+        case STATE_TAG: {
+            /* Skip attribute bytes that cannot end the tag */
+            size_t start = i;
+            while (i < length && tag_class[(unsigned char)data[i]] != 1) {
+                i++;
+            }
+            if (i > start) {
+                ht->self_closing = false;
+            }
+            if (i == length) {
+                break;
+            }
+            c = (unsigned char)data[i++];
+            if (c == '>') {
+                tag_closed(ht);
+            } else if (c == '"' || c == '\'') {
+                ht->quote = c;
+                ht->self_closing = false;
+                ht->state = STATE_QUOTE;
+            } else if (c == '/') {
+                ht->self_closing = true;
+            }
+            break;
+        }
+
+        case STATE_QUOTE: {
+            const char *end = memchr(data + i, ht->quote, length - i);
+            if (!end) {
+                i = length;
+            } else {
+                i = end - data + 1;
+                ht->state = STATE_TAG;
+            }
+            break;
+        }
+
+        case STATE_COMMENT:
+            i++;
+            if (c == '-') {
+                ht->dashes++;
+            } else if (c == '>' && ht->dashes >= 2) {
+                ht->state = STATE_TEXT;
+            } else {
+                ht->dashes = 0;
+            }
+            break;
+
+        case STATE_RAW: {
+            /* raw_end is the tag name; match "</name" case-insensitively */
+            char want = ht->raw_match == 0 ? '<' :
+                        ht->raw_match == 1 ? '/' : ht->raw_end[ht->raw_match - 2];
+            char got = (c >= 'A' && c <= 'Z') ? c + 32 : c;
+
+            if (got == want) {
+                ht->raw_match++;
+                i++;
+                if (ht->raw_match > 2 && ht->raw_end[ht->raw_match - 2] == '\0') {
+                    /* Whole close tag name matched; the rest is ordinary tag */
+                    ht->raw_end = NULL;
+                    ht->end_tag = true;
+                    ht->self_closing = false;
+                    ht->state = STATE_TAG;
+                }
+            } else if (ht->raw_match > 0) {
+                ht->raw_match = 0;  /* Reprocess: this byte may start a new "</" */
+            } else {
+                i++;
+            }
+            break;
+        }
+
+        case STATE_REF:
+            if (c == ';') {
+                i++;
+                resolve_ref(ht, true);
+            } else if ((is_ref_char(c) || (c == '#' && ht->ref_length == 0)) &&
+                       ht->ref_length < HTML_TEXT_REF_MAX) {
+                ht->ref[ht->ref_length++] = c;
+                i++;
+            } else {
+                resolve_ref(ht, false);     /* Reprocess c as text */
+            }
+            break;
+        }
+    }
+}
+
+size_t html_text_finish(html_text_t *ht) {
+    if (ht->state == STATE_REF) {
+        resolve_ref(ht, false);
+    } else if (ht->state == STATE_TAG_OPEN) {
+        put_text(ht, "<", 1);
+    }
+    ht->state = STATE_TEXT;
+
+    /* Drop the trailing line break */
+    while (ht->length > 0 && ht->out[ht->length - 1] == '\n') {
+        ht->length--;
+    }
+    return ht->length;
+}
@@ -0,0 +1,97 @@
+/*
+ * html_text.h - Streaming HTML to Plain Text Conversion
+ *
+ * Converts XHTML chapter markup to the plain UTF-8 text the renderer lays
+ * out, in one pass over the input: tags are stripped, script/style/title
+ * content is skipped, block elements become line breaks, whitespace runs
+ * collapse to one space (except inside <pre>), and character references,
+ * including the full HTML5 named set, are decoded.
+ *
+ * Input is fed in pieces of any size (as it comes out of zip_fread), and
+ * the text is written straight into a caller-supplied buffer, so no copy
+ * of the markup is ever held in memory.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef HTML_TEXT_H
+#define HTML_TEXT_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#define HTML_TEXT_TAG_MAX     15   /* Tag name bytes kept (longer names are never special) */
+#define HTML_TEXT_REF_MAX     32   /* Character reference bytes kept after '&' */
+
+/*
+ * Converter State
+ * Treat as opaque; initialize with html_text_init()
+ */
+typedef struct {
+    /* Output */
+    char *out;                         /* Output buffer */
+    size_t length;                     /* Bytes written to out */
+    size_t capacity;                   /* Size of out */
+    bool truncated;                    /* Output did not fit in capacity */
+
+    /* Parser */
+    int state;                         /* Current parser state */
+    bool pending_space;                /* Whitespace seen since the last text */
+    int pre_depth;                     /* Open <pre> elements */
+    char tag[HTML_TEXT_TAG_MAX + 1];   /* Tag name so far (lowercase) */
+    int tag_length;
+    bool end_tag;                      /* Tag is a closing tag */
+    bool self_closing;                 /* Tag so far ends with '/' */
+    char quote;                        /* Quote character of the attribute value being skipped */
+    int dashes;                        /* Consecutive '-' seen inside a comment */
+    const char *raw_end;               /* Element whose close tag ends skipped content */
+    int raw_match;                     /* Bytes of "</" + raw_end matched so far */
+    char ref[HTML_TEXT_REF_MAX + 1];   /* Character reference so far (after '&') */
+    int ref_length;
+} html_text_t;
+
+/**
+ * Start a conversion
+ * @param ht: Converter state
+ * @param out: Output buffer
+ * @param capacity: Size of out in bytes
+ * @note: Text never comes out longer than its markup, apart from two rare
+ *        entities (&nGt; and &nLt;), so a buffer the size of the input
+ *        always fits in practice; anything past capacity is dropped
+ */
+void html_text_init(html_text_t *ht, char *out, size_t capacity);
+
+/**
+ * Convert the next piece of markup
+ * Pieces may split tags, entities and UTF-8 sequences anywhere.
+ * @param ht: Converter state
+ * @param data: Markup bytes
+ * @param length: Number of bytes
+ */
+void html_text_feed(html_text_t *ht, const char *data, size_t length);
+
+/**
+ * Finish a conversion, flushing any character reference cut off by the end
+ * @param ht: Converter state
+ * @return: Length of the text written to the output buffer (not terminated)
+ */
+size_t html_text_finish(html_text_t *ht);
+
+#endif /* HTML_TEXT_H */
@@ -0,0 +1,261 @@
+/*
+ * pdf_glyphs.h - PDF Font Encoding Tables
+ *
+ * Unicode values for the simple font encodings a PDF can name (StandardEncoding,
+ * MacRomanEncoding; WinAnsiEncoding is charset_decode_cp1252()), for
+ * PDFDocEncoding text strings, and for the Adobe Glyph List names of the
+ * Latin, Greek and punctuation characters, which /Differences arrays use.
+ * Only pdf_native.c includes this file.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef PDF_GLYPHS_H
+#define PDF_GLYPHS_H
+
+#include <stdint.h>
+
+#define PDF_GLYPH_NAMES 576
+
+typedef struct {
+    const char *name;
+    uint16_t unicode;
+} pdf_glyph_name_t;
+
+/* StandardEncoding, codes 0x80-0xFF (0 = undefined; below 0x80 it is ASCII except 0x27 and 0x60) */
+static const uint16_t pdf_standard_encoding[128] = {
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x00A1, 0x00A2, 0x00A3, 0x2044, 0x00A5, 0x0192, 0x00A7,
+    0x00A4, 0x0027, 0x201C, 0x00AB, 0x2039, 0x203A, 0xFB01, 0xFB02,
+    0x0000, 0x2013, 0x2020, 0x2021, 0x00B7, 0x0000, 0x00B6, 0x2022,
+    0x201A, 0x201E, 0x201D, 0x00BB, 0x2026, 0x2030, 0x0000, 0x00BF,
+    0x0000, 0x0060, 0x00B4, 0x02C6, 0x02DC, 0x00AF, 0x02D8, 0x02D9,
+    0x00A8, 0x0000, 0x02DA, 0x00B8, 0x0000, 0x02DD, 0x02DB, 0x02C7,
+    0x2014, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x00C6, 0x0000, 0x00AA, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0141, 0x00D8, 0x0152, 0x00BA, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x00E6, 0x0000, 0x0000, 0x0000, 0x0131, 0x0000, 0x0000,
+    0x0142, 0x00F8, 0x0153, 0x00DF, 0x0000, 0x0000, 0x0000, 0x0000,
+};
+
+/* MacRomanEncoding, codes 0x80-0xFF (below 0x80 it is ASCII) */
+static const uint16_t pdf_mac_roman_encoding[128] = {
+    0x00C4, 0x00C5, 0x00C7, 0x00C9, 0x00D1, 0x00D6, 0x00DC, 0x00E1,
+    0x00E0, 0x00E2, 0x00E4, 0x00E3, 0x00E5, 0x00E7, 0x00E9, 0x00E8,
+    0x00EA, 0x00EB, 0x00ED, 0x00EC, 0x00EE, 0x00EF, 0x00F1, 0x00F3,
+    0x00F2, 0x00F4, 0x00F6, 0x00F5, 0x00FA, 0x00F9, 0x00FB, 0x00FC,
+    0x2020, 0x00B0, 0x00A2, 0x00A3, 0x00A7, 0x2022, 0x00B6, 0x00DF,
+    0x00AE, 0x00A9, 0x2122, 0x00B4, 0x00A8, 0x2260, 0x00C6, 0x00D8,
+    0x221E, 0x00B1, 0x2264, 0x2265, 0x00A5, 0x00B5, 0x2202, 0x2211,
+    0x220F, 0x03C0, 0x222B, 0x00AA, 0x00BA, 0x03A9, 0x00E6, 0x00F8,
+    0x00BF, 0x00A1, 0x00AC, 0x221A, 0x0192, 0x2248, 0x2206, 0x00AB,
+    0x00BB, 0x2026, 0x00A0, 0x00C0, 0x00C3, 0x00D5, 0x0152, 0x0153,
+    0x2013, 0x2014, 0x201C, 0x201D, 0x2018, 0x2019, 0x00F7, 0x25CA,
+    0x00FF, 0x0178, 0x2044, 0x20AC, 0x2039, 0x203A, 0xFB01, 0xFB02,
+    0x2021, 0x00B7, 0x201A, 0x201E, 0x2030, 0x00C2, 0x00CA, 0x00C1,
+    0x00CB, 0x00C8, 0x00CD, 0x00CE, 0x00CF, 0x00CC, 0x00D3, 0x00D4,
+    0xF8FF, 0x00D2, 0x00DA, 0x00DB, 0x00D9, 0x0131, 0x02C6, 0x02DC,
+    0x00AF, 0x02D8, 0x02D9, 0x02DA, 0x00B8, 0x02DD, 0x02DB, 0x02C7,
+};
+
+/* PDFDocEncoding, codes 0x80-0x9F (elsewhere it is Latin-1) */
+static const uint16_t pdf_doc_encoding[32] = {
+    0x2022, 0x2020, 0x2021, 0x2026, 0x2014, 0x2013, 0x0192, 0x2044,
+    0x2039, 0x203A, 0x2212, 0x2030, 0x201E, 0x201C, 0x201D, 0x2018,
+    0x2019, 0x201A, 0x2122, 0xFB01, 0xFB02, 0x0141, 0x0152, 0x0160,
+    0x0178, 0x017D, 0x0131, 0x0142, 0x0153, 0x0161, 0x017E, 0x0000,
+};
+
+/* Glyph names (sorted, for bsearch) */
+static const pdf_glyph_name_t pdf_glyph_names[PDF_GLYPH_NAMES] = {
+    { "A", 0x0041 }, { "AE", 0x00C6 }, { "Aacute", 0x00C1 }, { "Abreve", 0x0102 },
+    { "Acircumflex", 0x00C2 }, { "Adieresis", 0x00C4 }, { "Agrave", 0x00C0 },
+    { "Alpha", 0x0391 }, { "Amacron", 0x0100 }, { "Aogonek", 0x0104 }, { "Aring", 0x00C5 },
+    { "Atilde", 0x00C3 }, { "B", 0x0042 }, { "Beta", 0x0392 }, { "C", 0x0043 },
+    { "Cacute", 0x0106 }, { "Ccaron", 0x010C }, { "Ccedilla", 0x00C7 },
+    { "Ccircumflex", 0x0108 }, { "Cdot", 0x010A }, { "Cdotaccent", 0x010A }, { "Chi", 0x03A7 },
+    { "D", 0x0044 }, { "Dbar", 0x0110 }, { "Dcaron", 0x010E }, { "Dcroat", 0x0110 },
+    { "Delta", 0x2206 }, { "Deltagreek", 0x0394 }, { "Dslash", 0x0110 }, { "E", 0x0045 },
+    { "Eacute", 0x00C9 }, { "Ebreve", 0x0114 }, { "Ecaron", 0x011A }, { "Ecircumflex", 0x00CA },
+    { "Edieresis", 0x00CB }, { "Edot", 0x0116 }, { "Edotaccent", 0x0116 }, { "Egrave", 0x00C8 },
+    { "Emacron", 0x0112 }, { "Eng", 0x014A }, { "Eogonek", 0x0118 }, { "Epsilon", 0x0395 },
+    { "Eta", 0x0397 }, { "Eth", 0x00D0 }, { "Euro", 0x20AC }, { "F", 0x0046 }, { "G", 0x0047 },
+    { "Gamma", 0x0393 }, { "Gbreve", 0x011E }, { "Gcedilla", 0x0122 },
+    { "Gcircumflex", 0x011C }, { "Gcommaaccent", 0x0122 }, { "Gdot", 0x0120 },
+    { "Gdotaccent", 0x0120 }, { "H", 0x0048 }, { "Hbar", 0x0126 }, { "Hcircumflex", 0x0124 },
+    { "I", 0x0049 }, { "IJ", 0x0132 }, { "Iacute", 0x00CD }, { "Ibreve", 0x012C },
+    { "Icircumflex", 0x00CE }, { "Idieresis", 0x00CF }, { "Idot", 0x0130 },
+    { "Idotaccent", 0x0130 }, { "Igrave", 0x00CC }, { "Imacron", 0x012A },
+    { "Iogonek", 0x012E }, { "Iota", 0x0399 }, { "Iotadieresis", 0x03AA }, { "Itilde", 0x0128 },
+    { "J", 0x004A }, { "Jcircumflex", 0x0134 }, { "K", 0x004B }, { "Kappa", 0x039A },
+    { "Kcedilla", 0x0136 }, { "Kcommaaccent", 0x0136 }, { "L", 0x004C }, { "Lacute", 0x0139 },
+    { "Lambda", 0x039B }, { "Lcaron", 0x013D }, { "Lcedilla", 0x013B },
+    { "Lcommaaccent", 0x013B }, { "Ldot", 0x013F }, { "Ldotaccent", 0x013F },
+    { "Lslash", 0x0141 }, { "M", 0x004D }, { "Mu", 0x039C }, { "N", 0x004E },
+    { "Nacute", 0x0143 }, { "Ncaron", 0x0147 }, { "Ncedilla", 0x0145 },
+    { "Ncommaaccent", 0x0145 }, { "Ntilde", 0x00D1 }, { "Nu", 0x039D }, { "O", 0x004F },
+    { "OE", 0x0152 }, { "Oacute", 0x00D3 }, { "Obreve", 0x014E }, { "Ocircumflex", 0x00D4 },
+    { "Odblacute", 0x0150 }, { "Odieresis", 0x00D6 }, { "Ograve", 0x00D2 },
+    { "Ohungarumlaut", 0x0150 }, { "Omacron", 0x014C }, { "Omegagreek", 0x03A9 },
+    { "Omicron", 0x039F }, { "Oslash", 0x00D8 }, { "Otilde", 0x00D5 }, { "P", 0x0050 },
+    { "Phi", 0x03A6 }, { "Pi", 0x03A0 }, { "Psi", 0x03A8 }, { "Q", 0x0051 }, { "R", 0x0052 },
+    { "Racute", 0x0154 }, { "Rcaron", 0x0158 }, { "Rcedilla", 0x0156 },
+    { "Rcommaaccent", 0x0156 }, { "Rho", 0x03A1 }, { "S", 0x0053 }, { "Sacute", 0x015A },
+    { "Scaron", 0x0160 }, { "Scedilla", 0x015E }, { "Scircumflex", 0x015C },
+    { "Sigma", 0x03A3 }, { "T", 0x0054 }, { "Tau", 0x03A4 }, { "Tbar", 0x0166 },
+    { "Tcaron", 0x0164 }, { "Tcedilla", 0x0162 }, { "Tcommaaccent", 0x0162 },
+    { "Theta", 0x0398 }, { "Thorn", 0x00DE }, { "Togonek", 0x0162 }, { "U", 0x0055 },
+    { "Uacute", 0x00DA }, { "Ubreve", 0x016C }, { "Ucircumflex", 0x00DB },
+    { "Udblacute", 0x0170 }, { "Udieresis", 0x00DC }, { "Ugrave", 0x00D9 },
+    { "Uhungarumlaut", 0x0170 }, { "Umacron", 0x016A }, { "Uogonek", 0x0172 },
+    { "Upsilon", 0x03A5 }, { "Upsilondieresis", 0x03AB }, { "Uring", 0x016E },
+    { "Utilde", 0x0168 }, { "V", 0x0056 }, { "W", 0x0057 }, { "Wcircumflex", 0x0174 },
+    { "X", 0x0058 }, { "Xi", 0x039E }, { "Y", 0x0059 }, { "Yacute", 0x00DD },
+    { "Ycircumflex", 0x0176 }, { "Ydieresis", 0x0178 }, { "Yen", 0x00A5 }, { "Z", 0x005A },
+    { "Zacute", 0x0179 }, { "Zcaron", 0x017D }, { "Zdot", 0x017B }, { "Zdotaccent", 0x017B },
+    { "Zeta", 0x0396 }, { "a", 0x0061 }, { "aacute", 0x00E1 }, { "abreve", 0x0103 },
+    { "acircumflex", 0x00E2 }, { "acute", 0x00B4 }, { "adieresis", 0x00E4 }, { "ae", 0x00E6 },
+    { "agrave", 0x00E0 }, { "alpha", 0x03B1 }, { "alphatonos", 0x03AC }, { "amacron", 0x0101 },
+    { "ampersand", 0x0026 }, { "aogonek", 0x0105 }, { "apple", 0xF8FF },
+    { "approxequal", 0x2248 }, { "aring", 0x00E5 }, { "arrowleft", 0x2190 },
+    { "arrowright", 0x2192 }, { "asciicircum", 0x005E }, { "asciitilde", 0x007E },
+    { "asterisk", 0x002A }, { "at", 0x0040 }, { "atilde", 0x00E3 }, { "b", 0x0062 },
+    { "backslash", 0x005C }, { "backslashBig", 0x005C }, { "backslashBigg", 0x005C },
+    { "backslashbig", 0x005C }, { "backslashbigg", 0x005C }, { "bar", 0x007C },
+    { "beta", 0x03B2 }, { "braceleft", 0x007B }, { "braceleftBig", 0x007B },
+    { "braceleftBigg", 0x007B }, { "braceleftbig", 0x007B }, { "braceleftbigg", 0x007B },
+    { "braceright", 0x007D }, { "bracerightBig", 0x007D }, { "bracerightBigg", 0x007D },
+    { "bracerightbig", 0x007D }, { "bracerightbigg", 0x007D }, { "bracketleft", 0x005B },
+    { "bracketleftBig", 0x005B }, { "bracketleftBigg", 0x005B }, { "bracketleftbig", 0x005B },
+    { "bracketleftbigg", 0x005B }, { "bracketleftmid", 0x005B }, { "bracketright", 0x005D },
+    { "bracketrightBig", 0x005D }, { "bracketrightBigg", 0x005D },
+    { "bracketrightbig", 0x005D }, { "bracketrightbigg", 0x005D },
+    { "bracketrightmid", 0x005D }, { "breve", 0x02D8 }, { "brokenbar", 0x00A6 },
+    { "bullet", 0x2022 }, { "c", 0x0063 }, { "cacute", 0x0107 }, { "caron", 0x02C7 },
+    { "ccaron", 0x010D }, { "ccedilla", 0x00E7 }, { "ccircumflex", 0x0109 }, { "cdot", 0x010B },
+    { "cdotaccent", 0x010B }, { "cedilla", 0x00B8 }, { "cent", 0x00A2 }, { "chi", 0x03C7 },
+    { "circlecopyrt", 0x00A9 }, { "circumflex", 0x02C6 }, { "circumflexWide", 0x005E },
+    { "circumflexWider", 0x005E }, { "circumflexWidest", 0x005E }, { "colon", 0x003A },
+    { "comma", 0x002C }, { "controlACK", 0x0006 }, { "controlBEL", 0x0007 },
+    { "controlBS", 0x0008 }, { "controlCAN", 0x0018 }, { "controlCR", 0x000D },
+    { "controlDEL", 0x007F }, { "controlDLE", 0x0010 }, { "controlEM", 0x0019 },
+    { "controlENQ", 0x0005 }, { "controlEOT", 0x0004 }, { "controlESC", 0x001B },
+    { "controlETB", 0x0017 }, { "controlETX", 0x0003 }, { "controlFF", 0x000C },
+    { "controlFS", 0x001C }, { "controlGS", 0x001D }, { "controlHT", 0x0009 },
+    { "controlLF", 0x000A }, { "controlNAK", 0x0015 }, { "controlRS", 0x001E },
+    { "controlSI", 0x000F }, { "controlSO", 0x000E }, { "controlSOT", 0x0002 },
+    { "controlSTX", 0x0001 }, { "controlSUB", 0x001A }, { "controlSYN", 0x0016 },
+    { "controlUS", 0x001F }, { "controlVT", 0x000B }, { "copyright", 0x00A9 },
+    { "currency", 0x00A4 }, { "d", 0x0064 }, { "dagger", 0x2020 }, { "daggerdbl", 0x2021 },
+    { "dbar", 0x0111 }, { "dcaron", 0x010F }, { "dcroat", 0x0111 }, { "degree", 0x00B0 },
+    { "delta", 0x03B4 }, { "dieresis", 0x00A8 }, { "divide", 0x00F7 }, { "dmacron", 0x0111 },
+    { "dollar", 0x0024 }, { "dotaccent", 0x02D9 }, { "dotlessi", 0x0131 }, { "e", 0x0065 },
+    { "eacute", 0x00E9 }, { "ebreve", 0x0115 }, { "ecaron", 0x011B }, { "ecircumflex", 0x00EA },
+    { "edieresis", 0x00EB }, { "edot", 0x0117 }, { "edotaccent", 0x0117 }, { "egrave", 0x00E8 },
+    { "eight", 0x0038 }, { "ellipsis", 0x2026 }, { "emacron", 0x0113 }, { "emdash", 0x2014 },
+    { "endash", 0x2013 }, { "eng", 0x014B }, { "eogonek", 0x0119 }, { "epsilon", 0x03B5 },
+    { "epsilontonos", 0x03AD }, { "equal", 0x003D }, { "eta", 0x03B7 }, { "etatonos", 0x03AE },
+    { "eth", 0x00F0 }, { "euro", 0x20AC }, { "exclam", 0x0021 }, { "exclamdown", 0x00A1 },
+    { "f", 0x0066 }, { "ff", 0xFB00 }, { "ffi", 0xFB03 }, { "ffl", 0xFB04 },
+    { "fhook", 0x0192 }, { "fi", 0xFB01 }, { "finalsigma", 0x03C2 }, { "five", 0x0035 },
+    { "fl", 0xFB02 }, { "florin", 0x0192 }, { "four", 0x0034 }, { "fraction", 0x2044 },
+    { "g", 0x0067 }, { "gamma", 0x03B3 }, { "gbreve", 0x011F }, { "gcedilla", 0x0123 },
+    { "gcircumflex", 0x011D }, { "gcommaaccent", 0x0123 }, { "gdot", 0x0121 },
+    { "gdotaccent", 0x0121 }, { "germandbls", 0x00DF }, { "grave", 0x0060 },
+    { "greater", 0x003E }, { "greaterequal", 0x2265 }, { "guillemetleft", 0x00AB },
+    { "guillemetright", 0x00BB }, { "guillemotleft", 0x00AB }, { "guillemotright", 0x00BB },
+    { "guilsinglleft", 0x2039 }, { "guilsinglright", 0x203A }, { "h", 0x0068 },
+    { "hatwide", 0x02C6 }, { "hatwider", 0x02C6 }, { "hatwidest", 0x02C6 }, { "hbar", 0x0127 },
+    { "hcircumflex", 0x0125 }, { "hungarumlaut", 0x02DD }, { "hyphen", 0x002D },
+    { "hyphenchar", 0x002D }, { "hyphenminus", 0x002D }, { "hyphensoft", 0x00AD },
+    { "i", 0x0069 }, { "iacute", 0x00ED }, { "ibreve", 0x012D }, { "icircumflex", 0x00EE },
+    { "idieresis", 0x00EF }, { "igrave", 0x00EC }, { "ij", 0x0133 }, { "ilde", 0x02DC },
+    { "imacron", 0x012B }, { "increment", 0x2206 }, { "infinity", 0x221E },
+    { "integral", 0x222B }, { "integraldisplay", 0x222B }, { "integraldisplaystyle", 0x222B },
+    { "integraltext", 0x222B }, { "integraltextstyle", 0x222B }, { "iogonek", 0x012F },
+    { "iota", 0x03B9 }, { "iotatonos", 0x03AF }, { "itilde", 0x0129 }, { "j", 0x006A },
+    { "jcircumflex", 0x0135 }, { "k", 0x006B }, { "kappa", 0x03BA }, { "kcedilla", 0x0137 },
+    { "kcommaaccent", 0x0137 }, { "kgreenlandic", 0x0138 }, { "kra", 0x0138 }, { "l", 0x006C },
+    { "lacute", 0x013A }, { "lambda", 0x03BB }, { "lcaron", 0x013E }, { "lcedilla", 0x013C },
+    { "lcommaaccent", 0x013C }, { "ldot", 0x0140 }, { "ldotaccent", 0x0140 },
+    { "less", 0x003C }, { "lessequal", 0x2264 }, { "logicalnot", 0x00AC }, { "longs", 0x017F },
+    { "lozenge", 0x25CA }, { "lslash", 0x0142 }, { "m", 0x006D }, { "macron", 0x00AF },
+    { "middot", 0x00B7 }, { "minus", 0x2212 }, { "minute", 0x2032 }, { "mu", 0x00B5 },
+    { "mugreek", 0x03BC }, { "multiply", 0x00D7 }, { "n", 0x006E }, { "nacute", 0x0144 },
+    { "napostrophe", 0x0149 }, { "nbspace", 0x00A0 }, { "ncaron", 0x0148 },
+    { "ncedilla", 0x0146 }, { "ncommaaccent", 0x0146 }, { "negationslash", 0x2044 },
+    { "nine", 0x0039 }, { "nonbreakingspace", 0x00A0 }, { "notequal", 0x2260 },
+    { "ntilde", 0x00F1 }, { "nu", 0x03BD }, { "numbersign", 0x0023 }, { "o", 0x006F },
+    { "oacute", 0x00F3 }, { "obreve", 0x014F }, { "ocircumflex", 0x00F4 },
+    { "odblacute", 0x0151 }, { "odieresis", 0x00F6 }, { "oe", 0x0153 }, { "ogonek", 0x02DB },
+    { "ograve", 0x00F2 }, { "ohungarumlaut", 0x0151 }, { "omacron", 0x014D },
+    { "omega", 0x03C9 }, { "omicron", 0x03BF }, { "one", 0x0031 }, { "onehalf", 0x00BD },
+    { "onequarter", 0x00BC }, { "onesuperior", 0x00B9 }, { "ordfeminine", 0x00AA },
+    { "ordmasculine", 0x00BA }, { "oslash", 0x00F8 }, { "otilde", 0x00F5 },
+    { "overscore", 0x00AF }, { "p", 0x0070 }, { "paragraph", 0x00B6 }, { "parenleft", 0x0028 },
+    { "parenleftBig", 0x0028 }, { "parenleftBigg", 0x0028 }, { "parenleftbig", 0x0028 },
+    { "parenleftbigg", 0x0028 }, { "parenleftmid", 0x0028 }, { "parenright", 0x0029 },
+    { "parenrightBig", 0x0029 }, { "parenrightBigg", 0x0029 }, { "parenrightbig", 0x0029 },
+    { "parenrightbigg", 0x0029 }, { "parenrightmid", 0x0029 }, { "partialdiff", 0x2202 },
+    { "percent", 0x0025 }, { "period", 0x002E }, { "periodcentered", 0x00B7 },
+    { "perthousand", 0x2030 }, { "phi", 0x03C6 }, { "pi", 0x03C0 }, { "plus", 0x002B },
+    { "plusminus", 0x00B1 }, { "prime", 0x2032 }, { "product", 0x220F },
+    { "productdisplay", 0x220F }, { "productdisplaystyle", 0x220F }, { "producttext", 0x220F },
+    { "producttextstyle", 0x220F }, { "psi", 0x03C8 }, { "punctdash", 0x2014 }, { "q", 0x0071 },
+    { "question", 0x003F }, { "questiondown", 0x00BF }, { "quotedbl", 0x0022 },
+    { "quotedblbase", 0x201E }, { "quotedblleft", 0x201C }, { "quotedblright", 0x201D },
+    { "quoteleft", 0x2018 }, { "quoteright", 0x2019 }, { "quoterightn", 0x0149 },
+    { "quotesinglbase", 0x201A }, { "quotesingle", 0x0027 }, { "r", 0x0072 },
+    { "racute", 0x0155 }, { "radical", 0x221A }, { "radicalBig", 0x221A },
+    { "radicalBigg", 0x221A }, { "radicalbig", 0x221A }, { "radicalbigg", 0x221A },
+    { "radicalbt", 0x221A }, { "rangedash", 0x2013 }, { "rcaron", 0x0159 },
+    { "rcedilla", 0x0157 }, { "rcommaaccent", 0x0157 }, { "registered", 0x00AE },
+    { "rho", 0x03C1 }, { "ring", 0x02DA }, { "s", 0x0073 }, { "sacute", 0x015B },
+    { "scaron", 0x0161 }, { "scedilla", 0x015F }, { "scircumflex", 0x015D },
+    { "second", 0x2033 }, { "section", 0x00A7 }, { "semicolon", 0x003B }, { "seven", 0x0037 },
+    { "sfthyphen", 0x00AD }, { "sigma", 0x03C3 }, { "sigmafinal", 0x03C2 }, { "six", 0x0036 },
+    { "slash", 0x002F }, { "slashBig", 0x002F }, { "slashBigg", 0x002F },
+    { "slashbig", 0x002F }, { "slashbigg", 0x002F }, { "slong", 0x017F },
+    { "softhyphen", 0x00AD }, { "space", 0x0020 }, { "spacehackarabic", 0x0020 },
+    { "sterling", 0x00A3 }, { "summation", 0x2211 }, { "summationdisplay", 0x2211 },
+    { "summationdisplaystyle", 0x2211 }, { "summationtext", 0x2211 },
+    { "summationtextstyle", 0x2211 }, { "t", 0x0074 }, { "tau", 0x03C4 }, { "tbar", 0x0167 },
+    { "tcaron", 0x0165 }, { "tcedilla", 0x0163 }, { "tcommaaccent", 0x0163 },
+    { "theta", 0x03B8 }, { "thorn", 0x00FE }, { "three", 0x0033 }, { "threequarters", 0x00BE },
+    { "threesuperior", 0x00B3 }, { "tilde", 0x02DC }, { "tildeWide", 0x02DC },
+    { "tildeWider", 0x02DC }, { "tildeWidest", 0x02DC }, { "tildewide", 0x007E },
+    { "tildewider", 0x007E }, { "tildewidest", 0x007E }, { "trademark", 0x2122 },
+    { "triangle", 0x2206 }, { "two", 0x0032 }, { "twosuperior", 0x00B2 }, { "u", 0x0075 },
+    { "uacute", 0x00FA }, { "ubreve", 0x016D }, { "ucircumflex", 0x00FB },
+    { "udblacute", 0x0171 }, { "udieresis", 0x00FC }, { "ugrave", 0x00F9 },
+    { "uhungarumlaut", 0x0171 }, { "umacron", 0x016B }, { "underscore", 0x005F },
+    { "uogonek", 0x0173 }, { "upsilon", 0x03C5 }, { "upsilondieresistonos", 0x03B0 },
+    { "uring", 0x016F }, { "utilde", 0x0169 }, { "v", 0x0076 }, { "verticalbar", 0x007C },
+    { "w", 0x0077 }, { "wcircumflex", 0x0175 }, { "x", 0x0078 }, { "xi", 0x03BE },
+    { "y", 0x0079 }, { "yacute", 0x00FD }, { "ycircumflex", 0x0177 }, { "ydieresis", 0x00FF },
+    { "yen", 0x00A5 }, { "z", 0x007A }, { "zacute", 0x017A }, { "zcaron", 0x017E },
+    { "zdot", 0x017C }, { "zdotaccent", 0x017C }, { "zero", 0x0030 }, { "zeta", 0x03B6 },
+};
+
+#endif /* PDF_GLYPHS_H */
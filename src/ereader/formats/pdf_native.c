@@ -0,0 +1,2693 @@
+/*
+ * pdf_native.c - Native PDF Text Extraction
+ *
+ * A small PDF reader that only goes as far as text needs: objects are
+ * parsed lazily through the cross-reference data and cached for the life of
+ * the document, streams are decoded on demand (Flate with PNG predictors,
+ * LZW, ASCIIHex and ASCII85), and page content is run through an
+ * interpreter that tracks just the matrices, the text state and the glyphs
+ * it places.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include "pdf_native.h"
+#include "pdf_glyphs.h"
+#include "charset.h"
+#include "../rendering/utf8.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <zlib.h>
+
+#define NATIVE_MAX_DEPTH         32                 /* Nesting of objects and of the page tree */
+#define NATIVE_MAX_XREF_SECTIONS 64                 /* Incremental updates followed */
+#define NATIVE_MAX_OBJECTS       (8 * 1024 * 1024)  /* Largest object number accepted */
+#define NATIVE_MAX_STREAM        (64 * 1024 * 1024) /* Decoded stream size limit */
+#define NATIVE_MAX_OPERANDS      64
+#define NATIVE_MAX_SAVE          32                 /* q/Q nesting kept */
+#define NATIVE_MAX_FORM_DEPTH    8                  /* Form XObjects within form XObjects */
+#define NATIVE_MAX_CMAP_ENTRIES  200000
+#define NATIVE_ARENA_BLOCK       (64 * 1024)
+#define NATIVE_TAIL_SCAN         2048               /* Bytes at the end searched for startxref */
+
+/*
+ * Arena Allocator
+ * Parsed objects and fonts live until the document is closed; content
+ * stream operands are released after every operator.
+ */
+
+typedef struct arena_block {
+    struct arena_block *next;
+    size_t used;
+    size_t size;
+    char data[];
+} arena_block_t;
+
+typedef struct {
+    arena_block_t *head;
+} arena_t;
+
+typedef struct {
+    arena_block_t *block;
+    size_t used;
+} arena_mark_t;
+
+static void* arena_alloc(arena_t *arena, size_t size) {
+    arena_block_t *block = arena->head;
+
+    size = (size + 7) & ~(size_t)7;
+    if (!block || block->size - block->used < size) {
+        size_t block_size = size > NATIVE_ARENA_BLOCK ? size : NATIVE_ARENA_BLOCK;
+        block = malloc(sizeof(arena_block_t) + block_size);
+        if (!block) {
+            return NULL;
+        }
+        block->next = arena->head;
+        block->used = 0;
+        block->size = block_size;
+        arena->head = block;
+    }
+
+    void *p = block->data + block->used;
+    block->used += size;
+    return p;
+}
+
+static arena_mark_t arena_mark(const arena_t *arena) {
+    arena_mark_t mark = { arena->head, arena->head ? arena->head->used : 0 };
+    return mark;
+}
+
+/* Free everything allocated since mark */
+static void arena_release(arena_t *arena, arena_mark_t mark) {
+    while (arena->head && arena->head != mark.block) {
+        arena_block_t *next = arena->head->next;
+        free(arena->head);
+        arena->head = next;
+    }
+    if (arena->head) {
+        arena->head->used = mark.used;
+    }
+}
+
+static void arena_free(arena_t *arena) {
+    arena_mark_t none = { NULL, 0 };
+    arena_release(arena, none);
+}
+
+/*
+ * Growable Byte Buffer
+ */
+
+typedef struct {
+    unsigned char *data;
+    size_t length;
+    size_t capacity;
+} buffer_t;
+
+static int buffer_reserve(buffer_t *buffer, size_t extra) {
+    if (buffer->capacity - buffer->length >= extra) {
+        return 0;
+    }
+    if (buffer->length + extra > NATIVE_MAX_STREAM) {
+        return -1;
+    }
+
+    size_t capacity = buffer->capacity ? buffer->capacity * 2 : 4096;
+    while (capacity < buffer->length + extra) {
+        capacity *= 2;
+    }
+    if (capacity > NATIVE_MAX_STREAM) {
+        capacity = NATIVE_MAX_STREAM;
+    }
+
+    unsigned char *grown = realloc(buffer->data, capacity);
+    if (!grown) {
+        return -1;
+    }
+    buffer->data = grown;
+    buffer->capacity = capacity;
+    return 0;
+}
+
+static int buffer_append(buffer_t *buffer, const void *data, size_t length) {
+    if (buffer_reserve(buffer, length) != 0) {
+        return -1;
+    }
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+    return 0;
+}
+
+/*
+ * Objects
+ */
+
+typedef enum {
+    OBJ_NULL,
+    OBJ_BOOL,
+    OBJ_NUMBER,
+    OBJ_NAME,
+    OBJ_STRING,
+    OBJ_ARRAY,
+    OBJ_DICT,
+    OBJ_REF,
+    OBJ_STREAM,
+    OBJ_KEYWORD                        /* Bare word: a content stream operator */
+} obj_type_t;
+
+typedef struct obj obj_t;
+
+struct obj {
+    obj_type_t type;
+    int count;                         /* Name/string/keyword bytes, array items, dict entries */
+    union {
+        int boolean;
+        double number;
+        const char *text;              /* Name, string or keyword (null-terminated) */
+        const obj_t **items;           /* Array items; dict keys and values, alternating */
+        struct {
+            int num;
+            int gen;
+        } ref;
+        struct {
+            const obj_t *dict;
+            const unsigned char *data; /* Encoded data, in the file or an object stream */
+            size_t length;
+        } stream;
+    } u;
+};
+
+static const obj_t null_object = { OBJ_NULL, 0, { 0 } };
+
+/* Object list being parsed, kept on the stack until it outgrows it */
+typedef struct {
+    const obj_t *inline_items[16];
+    const obj_t **items;
+    int count;
+    int capacity;
+} obj_list_t;
+
+static void obj_list_init(obj_list_t *list) {
+    list->items = list->inline_items;
+    list->count = 0;
+    list->capacity = 16;
+}
+
+static int obj_list_push(obj_list_t *list, const obj_t *item) {
+    if (list->count == list->capacity) {
+        int capacity = list->capacity * 2;
+        const obj_t **grown;
+        if (list->items == list->inline_items) {
+            grown = malloc(capacity * sizeof(obj_t *));
+            if (grown) {
+                memcpy(grown, list->items, list->count * sizeof(obj_t *));
+            }
+        } else {
+            grown = realloc(list->items, capacity * sizeof(obj_t *));
+        }
+        if (!grown) {
+            return -1;
+        }
+        list->items = grown;
+        list->capacity = capacity;
+    }
+    list->items[list->count++] = item;
+    return 0;
+}
+
+/* Move a finished list into the arena */
+static const obj_t** obj_list_finish(obj_list_t *list, arena_t *arena) {
+    const obj_t **items = arena_alloc(arena, (list->count ? list->count : 1) * sizeof(obj_t *));
+    if (items) {
+        memcpy(items, list->items, list->count * sizeof(obj_t *));
+    }
+    if (list->items != list->inline_items) {
+        free(list->items);
+    }
+    return items;
+}
+
+static obj_t* new_object(arena_t *arena, obj_type_t type) {
+    obj_t *obj = arena_alloc(arena, sizeof(obj_t));
+    if (obj) {
+        memset(obj, 0, sizeof(obj_t));
+        obj->type = type;
+    }
+    return obj;
+}
+
+/*
+ * Lexer
+ */
+
+typedef struct {
+    const unsigned char *p;
+    const unsigned char *end;
+    int refs;                          /* Recognize "num gen R" references */
+} lexer_t;
+
+static inline int is_space(int c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == 0;
+}
+
+static inline int is_delimiter(int c) {
+    return c == '(' || c == ')' || c == '<' || c == '>' || c == '[' || c == ']' ||
+           c == '{' || c == '}' || c == '/' || c == '%';
+}
+
+static inline int is_regular(int c) {
+    return !is_space(c) && !is_delimiter(c);
+}
+
+static inline int hex_value(int c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/* Skip whitespace and comments */
+static void lex_skip_space(lexer_t *lex) {
+    while (lex->p < lex->end) {
+        if (is_space(*lex->p)) {
+            lex->p++;
+        } else if (*lex->p == '%') {
+            while (lex->p < lex->end && *lex->p != '\n' && *lex->p != '\r') {
+                lex->p++;
+            }
+        } else {
+            break;
+        }
+    }
+}
+
+/* Consume the next token if it is the given keyword */
+static int lex_keyword(lexer_t *lex, const char *word) {
+    size_t length = strlen(word);
+
+    lex_skip_space(lex);
+    if ((size_t)(lex->end - lex->p) < length || memcmp(lex->p, word, length) != 0) {
+        return 0;
+    }
+    if (lex->p + length < lex->end && is_regular(lex->p[length])) {
+        return 0;
+    }
+    lex->p += length;
+    return 1;
+}
+
+/* Consume the next token if it is an integer */
+static int lex_int(lexer_t *lex, long long *out) {
+    const unsigned char *p;
+    long long value = 0;
+    int negative = 0;
+
+    lex_skip_space(lex);
+    p = lex->p;
+    if (p < lex->end && (*p == '+' || *p == '-')) {
+        negative = (*p == '-');
+        p++;
+    }
+    if (p >= lex->end || !isdigit(*p)) {
+        return 0;
+    }
+    while (p < lex->end && isdigit(*p)) {
+        if (value < 100000000000000LL) {
+            value = value * 10 + (*p - '0');
+        }
+        p++;
+    }
+    if (p < lex->end && is_regular(*p)) {
+        return 0;  /* "12.5" or "12abc" */
+    }
+
+    lex->p = p;
+    *out = negative ? -value : value;
+    return 1;
+}
+
+/*
+ * Object Parser
+ */
+
+static const obj_t* parse_object(arena_t *arena, lexer_t *lex, int depth);
+
+/* Copy bytes into the arena as a null-terminated string object */
+static const obj_t* make_text(arena_t *arena, obj_type_t type, const void *data, size_t length) {
+    obj_t *obj = new_object(arena, type);
+    char *text = arena_alloc(arena, length + 1);
+    if (!obj || !text) {
+        return NULL;
+    }
+    memcpy(text, data, length);
+    text[length] = '\0';
+    obj->u.text = text;
+    obj->count = (int)length;
+    return obj;
+}
+
+static const obj_t* parse_name(arena_t *arena, lexer_t *lex) {
+    const unsigned char *start = ++lex->p;
+
+    while (lex->p < lex->end && is_regular(*lex->p)) {
+        lex->p++;
+    }
+
+    size_t span = lex->p - start;
+    obj_t *obj = new_object(arena, OBJ_NAME);
+    char *text = arena_alloc(arena, span + 1);
+    if (!obj || !text) {
+        return NULL;
+    }
+
+    /* Decode #xx escapes */
+    size_t length = 0;
+    for (size_t i = 0; i < span; i++) {
+        if (start[i] == '#' && i + 2 < span &&
+            hex_value(start[i + 1]) >= 0 && hex_value(start[i + 2]) >= 0) {
+            text[length++] = (char)(hex_value(start[i + 1]) * 16 + hex_value(start[i + 2]));
+            i += 2;
+        } else {
+            text[length++] = (char)start[i];
+        }
+    }
+    text[length] = '\0';
+    obj->u.text = text;
+    obj->count = (int)length;
+    return obj;
+}
+
+static const obj_t* parse_literal_string(arena_t *arena, lexer_t *lex) {
+    const unsigned char *start = ++lex->p;
+    int nesting = 1;
+
+    /* Find the closing parenthesis first, so the arena copy can be sized */
+    while (lex->p < lex->end) {
+        unsigned char c = *lex->p++;
+        if (c == '\\') {
+            if (lex->p < lex->end) lex->p++;
+        } else if (c == '(') {
+            nesting++;
+        } else if (c == ')' && --nesting == 0) {
+            break;
+        }
+    }
+    const unsigned char *stop = nesting == 0 ? lex->p - 1 : lex->p;
+
+    obj_t *obj = new_object(arena, OBJ_STRING);
+    char *text = arena_alloc(arena, (stop - start) + 1);
+    if (!obj || !text) {
+        return NULL;
+    }
+
+    size_t length = 0;
+    for (const unsigned char *p = start; p < stop; p++) {
+        if (*p == '\r') {
+            /* Any end of line reads as a single newline */
+            text[length++] = '\n';
+            if (p + 1 < stop && p[1] == '\n') p++;
+        } else if (*p != '\\' || p + 1 >= stop) {
+            text[length++] = (char)*p;
+        } else {
+            p++;
+            switch (*p) {
+                case 'n': text[length++] = '\n'; break;
+                case 'r': text[length++] = '\r'; break;
+                case 't': text[length++] = '\t'; break;
+                case 'b': text[length++] = '\b'; break;
+                case 'f': text[length++] = '\f'; break;
+                case '\r':
+                    if (p + 1 < stop && p[1] == '\n') p++;
+                    break;  /* Line continuation */
+                case '\n':
+                    break;
+                default:
+                    if (*p >= '0' && *p <= '7') {
+                        int value = 0;
+                        for (int i = 0; i < 3 && p < stop && *p >= '0' && *p <= '7'; i++, p++) {
+                            value = value * 8 + (*p - '0');
+                        }
+                        p--;
+                        text[length++] = (char)value;
+                    } else {
+                        text[length++] = (char)*p;  /* \( \) \\ and unknown escapes */
+                    }
+                    break;
+            }
+        }
+    }
+    text[length] = '\0';
+    obj->u.text = text;
+    obj->count = (int)length;
+    return obj;
+}
+
+static const obj_t* parse_hex_string(arena_t *arena, lexer_t *lex) {
+    const unsigned char *start = ++lex->p;
+
+    while (lex->p < lex->end && *lex->p != '>') {
+        lex->p++;
+    }
+    const unsigned char *stop = lex->p;
+    if (lex->p < lex->end) {
+        lex->p++;
+    }
+
+    obj_t *obj = new_object(arena, OBJ_STRING);
+    char *text = arena_alloc(arena, (stop - start) / 2 + 2);
+    if (!obj || !text) {
+        return NULL;
+    }
+
+    size_t length = 0;
+    int high = -1;
+    for (const unsigned char *p = start; p < stop; p++) {
+        int v = hex_value(*p);
+        if (v < 0) {
+            continue;
+        }
+        if (high < 0) {
+            high = v;
+        } else {
+            text[length++] = (char)(high * 16 + v);
+            high = -1;
+        }
+    }
+    if (high >= 0) {
+        text[length++] = (char)(high * 16);  /* Odd digit count: last digit is followed by 0 */
+    }
+    text[length] = '\0';
+    obj->u.text = text;
+    obj->count = (int)length;
+    return obj;
+}
+
+static const obj_t* parse_number(arena_t *arena, lexer_t *lex) {
+    const unsigned char *p = lex->p;
+    const unsigned char *digits_start;
+    double value = 0;
+    int negative = 0;
+    int is_integer = 1;
+
+    while (p < lex->end && (*p == '+' || *p == '-')) {
+        negative ^= (*p == '-');
+        p++;
+    }
+    digits_start = p;
+    while (p < lex->end && isdigit(*p)) {
+        value = value * 10 + (*p - '0');
+        p++;
+    }
+    if (p < lex->end && *p == '.') {
+        double scale = 0.1;
+        is_integer = 0;
+        for (p++; p < lex->end && isdigit(*p); p++) {
+            value += (*p - '0') * scale;
+            scale *= 0.1;
+        }
+    }
+    /* Junk such as "1.2.3" or "--" still ends the token */
+    while (p < lex->end && is_regular(*p)) {
+        p++;
+    }
+    lex->p = p;
+
+    obj_t *obj = new_object(arena, OBJ_NUMBER);
+    if (!obj) {
+        return NULL;
+    }
+    obj->u.number = negative ? -value : value;
+
+    /* "num gen R" */
+    if (lex->refs && is_integer && p > digits_start && !negative && value <= NATIVE_MAX_OBJECTS) {
+        const unsigned char *save = lex->p;
+        long long gen;
+        if (lex_int(lex, &gen) && gen >= 0 && lex_keyword(lex, "R")) {
+            obj->type = OBJ_REF;
+            obj->u.ref.num = (int)value;
+            obj->u.ref.gen = (int)gen;
+        } else {
+            lex->p = save;
+        }
+    }
+    return obj;
+}
+
+static const obj_t* parse_array(arena_t *arena, lexer_t *lex, int depth) {
+    obj_list_t list;
+    obj_t *obj = new_object(arena, OBJ_ARRAY);
+
+    if (!obj) {
+        return NULL;
+    }
+    lex->p++;
+    obj_list_init(&list);
+
+    for (;;) {
+        lex_skip_space(lex);
+        if (lex->p >= lex->end) {
+            break;
+        }
+        if (*lex->p == ']') {
+            lex->p++;
+            break;
+        }
+        const unsigned char *before = lex->p;
+        const obj_t *item = parse_object(arena, lex, depth + 1);
+        if (!item) {
+            if (lex->p == before) lex->p++;  /* Stray delimiter */
+            continue;
+        }
+        obj_list_push(&list, item);
+    }
+
+    obj->count = list.count;
+    obj->u.items = obj_list_finish(&list, arena);
+    return obj->u.items ? obj : NULL;
+}
+
+static const obj_t* parse_dict(arena_t *arena, lexer_t *lex, int depth) {
+    obj_list_t list;
+    obj_t *obj = new_object(arena, OBJ_DICT);
+
+    if (!obj) {
+        return NULL;
+    }
+    lex->p += 2;
+    obj_list_init(&list);
+
+    for (;;) {
+        lex_skip_space(lex);
+        if (lex->p >= lex->end) {
+            break;
+        }
+        if (*lex->p == '>') {
+            lex->p += (lex->p + 1 < lex->end && lex->p[1] == '>') ? 2 : 1;
+            break;
+        }
+        const unsigned char *before = lex->p;
+        const obj_t *key = parse_object(arena, lex, depth + 1);
+        if (!key) {
+            if (lex->p == before) lex->p++;
+            continue;
+        }
+        if (key->type != OBJ_NAME) {
+            continue;  /* Not a key: skip it */
+        }
+
+        /* A missing value (key right before ">>") reads as null */
+        lex_skip_space(lex);
+        const obj_t *value = NULL;
+        if (lex->p < lex->end && *lex->p != '>') {
+            value = parse_object(arena, lex, depth + 1);
+        }
+        obj_list_push(&list, key);
+        obj_list_push(&list, value ? value : &null_object);
+    }
+
+    obj->count = list.count / 2;
+    obj->u.items = obj_list_finish(&list, arena);
+    return obj->u.items ? obj : NULL;
+}
+
+/*
+ * Parse one object
+ * Returns NULL at the end of input, on a closing delimiter, or when out of memory.
+ */
+static const obj_t* parse_object(arena_t *arena, lexer_t *lex, int depth) {
+    lex_skip_space(lex);
+    if (lex->p >= lex->end || depth > NATIVE_MAX_DEPTH) {
+        return NULL;
+    }
+
+    int c = *lex->p;
+    switch (c) {
+        case '/':
+            return parse_name(arena, lex);
+        case '(':
+            return parse_literal_string(arena, lex);
+        case '<':
+            if (lex->p + 1 < lex->end && lex->p[1] == '<') {
+                return parse_dict(arena, lex, depth);
+            }
+            return parse_hex_string(arena, lex);
+        case '[':
+            return parse_array(arena, lex, depth);
+        case ']':
+        case '>':
+        case ')':
+            return NULL;
+        case '{':
+        case '}':
+            lex->p++;
+            return make_text(arena, OBJ_KEYWORD, lex->p - 1, 1);
+        default:
+            break;
+    }
+
+    if (isdigit(c) || c == '+' || c == '-' || c == '.') {
+        return parse_number(arena, lex);
+    }
+
+    const unsigned char *start = lex->p;
+    while (lex->p < lex->end && is_regular(*lex->p)) {
+        lex->p++;
+    }
+    size_t length = lex->p - start;
+
+    if (length == 4 && memcmp(start, "true", 4) == 0) {
+        obj_t *obj = new_object(arena, OBJ_BOOL);
+        if (obj) obj->u.boolean = 1;
+        return obj;
+    }
+    if (length == 5 && memcmp(start, "false", 5) == 0) {
+        return new_object(arena, OBJ_BOOL);
+    }
+    if (length == 4 && memcmp(start, "null", 4) == 0) {
+        return &null_object;
+    }
+    return make_text(arena, OBJ_KEYWORD, start, length);
+}
+
+/*
+ * Document
+ */
+
+typedef struct {
+    long long offset;                  /* Type 1: file offset; type 2: object stream number */
+    int index;                         /* Type 2: index in the object stream */
+    uint8_t type;                      /* 0 free, 1 in the file, 2 in an object stream */
+    uint8_t loading;                   /* Being parsed (breaks reference cycles) */
+    int section;                       /* Xref section that set it (0 = none; newest is 1) */
+    const obj_t *obj;                  /* Parsed object, once loaded */
+    unsigned char *decoded;            /* Object streams: decoded data, once loaded */
+    size_t decoded_length;
+} xref_entry_t;
+
+typedef struct {
+    uint32_t lo, hi;                   /* Code range */
+    uint32_t unicode[3];               /* Text of lo; its last character counts up through the range */
+    uint8_t count;                     /* Characters in unicode */
+} cmap_entry_t;
+
+typedef struct {
+    uint32_t lo, hi;                   /* CID range */
+    float width;
+} width_entry_t;
+
+typedef struct {
+    int code_bytes;                    /* Bytes per character code: 1 for simple fonts, 2 for Type0 */
+    uint32_t simple_unicode[256];      /* Simple fonts: code to Unicode from the encoding (0 = none) */
+    float simple_width[256];           /* Simple fonts: glyph widths in 1/1000 text space units */
+    cmap_entry_t *to_unicode;          /* ToUnicode CMap, sorted by lo */
+    int to_unicode_count;
+    width_entry_t *widths;             /* Type0: /W ranges, sorted by lo */
+    int width_count;
+    float default_width;               /* Type0: /DW */
+} font_t;
+
+typedef struct {
+    const obj_t *dict;                 /* Page dictionary */
+    const obj_t *resources;            /* Resources, inherited if not on the page */
+} native_page_t;
+
+typedef struct {
+    const obj_t *key;                  /* Font dictionary */
+    font_t *font;
+} font_cache_entry_t;
+
+struct pdf_native {
+    const unsigned char *data;         /* Whole file, mapped */
+    size_t size;
+    xref_entry_t *xref;
+    int xref_count;
+    const obj_t *trailer;
+    native_page_t *pages;
+    int page_count;
+    int page_capacity;
+    font_cache_entry_t *fonts;
+    int font_count;
+    int font_capacity;
+    arena_t arena;                     /* Objects and fonts */
+};
+
+static const obj_t* load_object(pdf_native_t *pdf, int num);
+static unsigned char* decode_stream(pdf_native_t *pdf, const obj_t *stream, size_t *out_length);
+
+static const obj_t* resolve(pdf_native_t *pdf, const obj_t *obj) {
+    for (int i = 0; obj && obj->type == OBJ_REF && i < 4; i++) {
+        obj = load_object(pdf, obj->u.ref.num);
+    }
+    return (obj && obj->type != OBJ_REF) ? obj : &null_object;
+}
+
+/* Look up a key without resolving the value */
+static const obj_t* dict_find(const obj_t *dict, const char *key) {
+    if (dict && dict->type == OBJ_STREAM) {
+        dict = dict->u.stream.dict;
+    }
+    if (!dict || dict->type != OBJ_DICT) {
+        return &null_object;
+    }
+    for (int i = 0; i < dict->count; i++) {
+        if (strcmp(dict->u.items[2 * i]->u.text, key) == 0) {
+            return dict->u.items[2 * i + 1];
+        }
+    }
+    return &null_object;
+}
+
+static const obj_t* dict_get(pdf_native_t *pdf, const obj_t *dict, const char *key) {
+    return resolve(pdf, dict_find(dict, key));
+}
+
+static double obj_number(const obj_t *obj, double fallback) {
+    return obj->type == OBJ_NUMBER ? obj->u.number : fallback;
+}
+
+static long long obj_int(const obj_t *obj, long long fallback) {
+    if (obj->type != OBJ_NUMBER || obj->u.number < -1e15 || obj->u.number > 1e15) {
+        return fallback;
+    }
+    return (long long)obj->u.number;
+}
+
+static int obj_is_name(const obj_t *obj, const char *name) {
+    return obj->type == OBJ_NAME && strcmp(obj->u.text, name) == 0;
+}
+
+/*
+ * Cross-Reference Data
+ */
+
+static int xref_reserve(pdf_native_t *pdf, long long count) {
+    if (count <= pdf->xref_count) {
+        return 0;
+    }
+    if (count > NATIVE_MAX_OBJECTS) {
+        return -1;
+    }
+
+    int capacity = pdf->xref_count ? pdf->xref_count : 64;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+    xref_entry_t *grown = realloc(pdf->xref, capacity * sizeof(xref_entry_t));
+    if (!grown) {
+        return -1;
+    }
+    memset(grown + pdf->xref_count, 0, (capacity - pdf->xref_count) * sizeof(xref_entry_t));
+    pdf->xref = grown;
+    pdf->xref_count = capacity;
+    return 0;
+}
+
+/* Record where an object is, unless a newer section already did */
+static void xref_set(pdf_native_t *pdf, long long num, int type, long long offset, int index,
+                     int section) {
+    if (num <= 0 || xref_reserve(pdf, num + 1) != 0) {
+        return;
+    }
+
+    xref_entry_t *entry = &pdf->xref[num];
+    /* A hybrid file's XRefStm fills in entries its own table left free */
+    if (entry->section && !(entry->section == section && entry->type == 0)) {
+        return;
+    }
+    entry->section = section;
+    entry->type = (uint8_t)type;
+    entry->offset = offset;
+    entry->index = index;
+}
+
+static void xref_reset(pdf_native_t *pdf) {
+    for (int i = 0; i < pdf->xref_count; i++) {
+        free(pdf->xref[i].decoded);
+    }
+    free(pdf->xref);
+    pdf->xref = NULL;
+    pdf->xref_count = 0;
+    pdf->trailer = NULL;
+}
+
+/* First occurrence of word in data, or NULL */
+static const unsigned char* find_bytes(const unsigned char *data, size_t size, const char *word) {
+    size_t length = strlen(word);
+
+    while (size >= length) {
+        const unsigned char *p = memchr(data, word[0], size - length + 1);
+        if (!p) {
+            return NULL;
+        }
+        if (memcmp(p, word, length) == 0) {
+            return p;
+        }
+        size -= (p + 1) - data;
+        data = p + 1;
+    }
+    return NULL;
+}
+
+/* Check for "endstream" at p, after optional whitespace */
+static int endstream_at(const unsigned char *p, const unsigned char *end) {
+    while (p < end && is_space(*p)) {
+        p++;
+    }
+    return (size_t)(end - p) >= 9 && memcmp(p, "endstream", 9) == 0;
+}
+
+/* Parse "num gen obj ... [stream ... endstream]" at a file offset */
+static const obj_t* parse_indirect(pdf_native_t *pdf, long long offset, int expected_num) {
+    if (offset < 0 || (size_t)offset >= pdf->size) {
+        return NULL;
+    }
+
+    lexer_t lex = { pdf->data + offset, pdf->data + pdf->size, 1 };
+    long long num, gen;
+    if (!lex_int(&lex, &num) || !lex_int(&lex, &gen) || !lex_keyword(&lex, "obj")) {
+        return NULL;
+    }
+    if (expected_num >= 0 && num != expected_num) {
+        return NULL;
+    }
+
+    const obj_t *obj = parse_object(&pdf->arena, &lex, 0);
+    if (!obj || obj->type != OBJ_DICT || !lex_keyword(&lex, "stream")) {
+        return obj;
+    }
+
+    /* Stream data starts after the end of line following "stream" */
+    const unsigned char *data = lex.p;
+    if (data < lex.end && *data == '\r') data++;
+    if (data < lex.end && *data == '\n') data++;
+    size_t avail = lex.end - data;
+
+    long long length = obj_int(dict_get(pdf, obj, "Length"), -1);
+    if (length < 0 || (size_t)length > avail || !endstream_at(data + length, lex.end)) {
+        /* Wrong /Length: the data runs to "endstream" */
+        const unsigned char *stop = find_bytes(data, avail, "endstream");
+        length = stop ? stop - data : (long long)avail;
+        if (length > 0 && data[length - 1] == '\n') length--;
+        if (length > 0 && data[length - 1] == '\r') length--;
+    }
+
+    obj_t *stream = new_object(&pdf->arena, OBJ_STREAM);
+    if (!stream) {
+        return NULL;
+    }
+    stream->u.stream.dict = obj;
+    stream->u.stream.data = data;
+    stream->u.stream.length = (size_t)length;
+    return stream;
+}
+
+/* Parse object num, stored at the given index of object stream stream_num */
+static const obj_t* parse_compressed(pdf_native_t *pdf, long long stream_num, int num, int index) {
+    if (stream_num <= 0 || stream_num >= pdf->xref_count) {
+        return NULL;
+    }
+
+    const obj_t *stream = load_object(pdf, (int)stream_num);
+    xref_entry_t *container = &pdf->xref[stream_num];
+    if (stream->type != OBJ_STREAM) {
+        return NULL;
+    }
+    if (!container->decoded) {
+        container->decoded = decode_stream(pdf, stream, &container->decoded_length);
+        if (!container->decoded) {
+            return NULL;
+        }
+    }
+
+    /* Header: N pairs of "object-number offset", then objects from /First */
+    long long count = obj_int(dict_get(pdf, stream, "N"), 0);
+    long long first = obj_int(dict_get(pdf, stream, "First"), -1);
+    if (first < 0 || (size_t)first >= container->decoded_length) {
+        return NULL;
+    }
+
+    lexer_t header = { container->decoded, container->decoded + first, 0 };
+    long long offset = -1;
+    for (long long i = 0; i < count; i++) {
+        long long object_num, object_offset;
+        if (!lex_int(&header, &object_num) || !lex_int(&header, &object_offset)) {
+            break;
+        }
+        if (object_num == num) {
+            offset = object_offset;
+            if (i == index) break;
+        }
+    }
+    if (offset < 0 || (size_t)(first + offset) >= container->decoded_length) {
+        return NULL;
+    }
+
+    lexer_t lex = { container->decoded + first + offset,
+                    container->decoded + container->decoded_length, 1 };
+    return parse_object(&pdf->arena, &lex, 0);
+}
+
+static const obj_t* load_object(pdf_native_t *pdf, int num) {
+    if (num <= 0 || num >= pdf->xref_count) {
+        return &null_object;
+    }
+
+    xref_entry_t *entry = &pdf->xref[num];
+    if (entry->obj) {
+        return entry->obj;
+    }
+    if (entry->loading || entry->type == 0) {
+        return &null_object;
+    }
+
+    entry->loading = 1;
+    const obj_t *obj = entry->type == 1 ? parse_indirect(pdf, entry->offset, num)
+                                        : parse_compressed(pdf, entry->offset, num, entry->index);
+    entry = &pdf->xref[num];  /* Loading may have grown the table */
+    entry->loading = 0;
+    entry->obj = obj ? obj : &null_object;
+    return entry->obj;
+}
+
+/* Find the last occurrence of word in the final window bytes of the file */
+static const unsigned char* find_last(const unsigned char *data, size_t size, const char *word,
+                                      size_t window) {
+    size_t length = strlen(word);
+    size_t start = size > window ? size - window : 0;
+
+    for (size_t i = size >= length ? size - length + 1 : 0; i-- > start; ) {
+        if (memcmp(data + i, word, length) == 0) {
+            return data + i;
+        }
+    }
+    return NULL;
+}
+
+/* Classic table: "start count" subsections of "offset gen n|f" lines, then the trailer */
+static int read_xref_table(pdf_native_t *pdf, lexer_t *lex, int section, const obj_t **trailer) {
+    for (;;) {
+        if (lex_keyword(lex, "trailer")) {
+            *trailer = parse_object(&pdf->arena, lex, 0);
+            return (*trailer && (*trailer)->type == OBJ_DICT) ? 0 : -1;
+        }
+
+        long long start, count;
+        if (!lex_int(lex, &start) || !lex_int(lex, &count) || start < 0 || count < 0) {
+            return -1;
+        }
+        for (long long i = 0; i < count; i++) {
+            long long offset, gen;
+            if (!lex_int(lex, &offset) || !lex_int(lex, &gen)) {
+                return -1;
+            }
+            lex_skip_space(lex);
+            if (lex->p >= lex->end || (*lex->p != 'n' && *lex->p != 'f')) {
+                return -1;
+            }
+            xref_set(pdf, start + i, *lex->p == 'n' ? 1 : 0, offset, 0, section);
+            lex->p++;
+        }
+    }
+}
+
+/* Cross-reference stream (PDF 1.5): binary entries of /W field widths */
+static int read_xref_stream(pdf_native_t *pdf, long long offset, int section,
+                            const obj_t **trailer) {
+    const obj_t *stream = parse_indirect(pdf, offset, -1);
+    if (!stream || stream->type != OBJ_STREAM) {
+        return -1;
+    }
+
+    const obj_t *w = dict_get(pdf, stream, "W");
+    if (w->type != OBJ_ARRAY || w->count < 3) {
+        return -1;
+    }
+    int widths[3];
+    for (int i = 0; i < 3; i++) {
+        widths[i] = (int)obj_int(resolve(pdf, w->u.items[i]), -1);
+        if (widths[i] < 0 || widths[i] > 8) {
+            return -1;
+        }
+    }
+
+    size_t length;
+    unsigned char *data = decode_stream(pdf, stream, &length);
+    if (!data) {
+        return -1;
+    }
+
+    long long size = obj_int(dict_get(pdf, stream, "Size"), 0);
+    const obj_t *index = dict_get(pdf, stream, "Index");
+    int ranges = index->type == OBJ_ARRAY ? index->count / 2 : 1;
+    size_t entry_size = widths[0] + widths[1] + widths[2];
+    size_t pos = 0;
+
+    for (int r = 0; r < ranges && entry_size > 0; r++) {
+        long long start = 0, count = size;
+        if (index->type == OBJ_ARRAY) {
+            start = obj_int(resolve(pdf, index->u.items[2 * r]), 0);
+            count = obj_int(resolve(pdf, index->u.items[2 * r + 1]), 0);
+        }
+        for (long long i = 0; i < count && pos + entry_size <= length; i++) {
+            long long fields[3];
+            for (int f = 0; f < 3; f++) {
+                long long value = 0;
+                for (int b = 0; b < widths[f]; b++) {
+                    value = (value << 8) | data[pos++];
+                }
+                fields[f] = value;
+            }
+            if (widths[0] == 0) {
+                fields[0] = 1;  /* Type defaults to 1 */
+            }
+            if (fields[0] <= 2) {
+                xref_set(pdf, start + i, (int)fields[0], fields[1], (int)fields[2], section);
+            }
+        }
+    }
+
+    free(data);
+    *trailer = stream->u.stream.dict;
+    return 0;
+}
+
+/* Follow startxref and the /Prev chain, newest section first */
+static int load_xref(pdf_native_t *pdf) {
+    const unsigned char *startxref = find_last(pdf->data, pdf->size, "startxref", NATIVE_TAIL_SCAN);
+    if (!startxref) {
+        return -1;
+    }
+
+    lexer_t lex = { startxref + 9, pdf->data + pdf->size, 0 };
+    long long offset;
+    if (!lex_int(&lex, &offset)) {
+        return -1;
+    }
+
+    for (int section = 1; section <= NATIVE_MAX_XREF_SECTIONS; section++) {
+        const obj_t *trailer = NULL;
+
+        if (offset <= 0 || (size_t)offset >= pdf->size) {
+            return -1;
+        }
+
+        lexer_t at = { pdf->data + offset, pdf->data + pdf->size, 1 };
+        if (lex_keyword(&at, "xref")) {
+            if (read_xref_table(pdf, &at, section, &trailer) != 0) {
+                return -1;
+            }
+            /* Hybrid file: the compressed objects of this section are in a stream */
+            const obj_t *xref_stream = dict_find(trailer, "XRefStm");
+            if (xref_stream->type == OBJ_NUMBER) {
+                const obj_t *ignored;
+                read_xref_stream(pdf, (long long)xref_stream->u.number, section, &ignored);
+            }
+        } else if (read_xref_stream(pdf, offset, section, &trailer) != 0) {
+            return -1;
+        }
+
+        if (!pdf->trailer) {
+            pdf->trailer = trailer;
+        }
+
+        const obj_t *prev = dict_find(trailer, "Prev");
+        if (prev->type != OBJ_NUMBER || (long long)prev->u.number == offset) {
+            break;
+        }
+        offset = (long long)prev->u.number;
+    }
+
+    return dict_find(pdf->trailer, "Root")->type == OBJ_REF ? 0 : -1;
+}
+
+/* Register the contents of an object stream found while repairing */
+static void register_object_stream(pdf_native_t *pdf, int stream_num, const obj_t *stream) {
+    size_t length;
+    unsigned char *data = decode_stream(pdf, stream, &length);
+    if (!data) {
+        return;
+    }
+
+    long long count = obj_int(dict_get(pdf, stream, "N"), 0);
+    long long first = obj_int(dict_get(pdf, stream, "First"), 0);
+    lexer_t lex = { data, data + (first > 0 && (size_t)first <= length ? (size_t)first : length), 0 };
+    for (long long i = 0; i < count; i++) {
+        long long num, offset;
+        if (!lex_int(&lex, &num) || !lex_int(&lex, &offset)) {
+            break;
+        }
+        /* Objects written out in full win over compressed copies */
+        if (num > 0 && (num >= pdf->xref_count || pdf->xref[num].type == 0)) {
+            xref_set(pdf, num, 2, stream_num, (int)i, 2);
+        }
+    }
+    free(data);
+}
+
+/* Rebuild the cross-reference data of a damaged file by scanning it for objects */
+static int reconstruct_xref(pdf_native_t *pdf) {
+    const unsigned char *data = pdf->data;
+    const unsigned char *end = data + pdf->size;
+    const obj_t *trailer = NULL;
+
+    fprintf(stderr, "pdf_native: Damaged cross-reference data, scanning for objects\n");
+    xref_reset(pdf);
+
+    /* "num gen obj" headers; a later definition of an object replaces an earlier one */
+    for (const unsigned char *p = data; (p = find_bytes(p, end - p, "obj")) != NULL; p += 3) {
+        if (p + 3 < end && is_regular(p[3])) continue;
+        const unsigned char *q = p;
+        while (q > data && is_space(q[-1])) q--;
+        const unsigned char *gen_end = q;
+        while (q > data && isdigit(q[-1])) q--;
+        if (q == gen_end) continue;
+        while (q > data && is_space(q[-1])) q--;
+        const unsigned char *num_end = q;
+        while (q > data && isdigit(q[-1])) q--;
+        if (q == num_end || (q > data && is_regular(q[-1]))) continue;
+
+        long long num = strtoll((const char *)q, NULL, 10);
+        if (num > 0 && xref_reserve(pdf, num + 1) == 0) {
+            pdf->xref[num].section = 1;
+            pdf->xref[num].type = 1;
+            pdf->xref[num].offset = q - data;
+        }
+    }
+
+    /* The last trailer dictionary naming a catalog */
+    for (const unsigned char *p = data; (p = find_bytes(p, end - p, "trailer")) != NULL; p += 7) {
+        lexer_t lex = { p + 7, end, 1 };
+        const obj_t *dict = parse_object(&pdf->arena, &lex, 0);
+        if (dict && dict->type == OBJ_DICT && dict_find(dict, "Root")->type == OBJ_REF) {
+            trailer = dict;
+        }
+    }
+
+    /* Object streams, and cross-reference streams standing in for the trailer */
+    int count = pdf->xref_count;
+    for (int num = 1; num < count; num++) {
+        if (pdf->xref[num].type != 1) continue;
+        const obj_t *obj = load_object(pdf, num);
+        if (obj->type != OBJ_STREAM) continue;
+        const obj_t *type = dict_get(pdf, obj, "Type");
+        if (obj_is_name(type, "ObjStm")) {
+            register_object_stream(pdf, num, obj);
+        } else if (!trailer && obj_is_name(type, "XRef") &&
+                   dict_find(obj, "Root")->type == OBJ_REF) {
+            trailer = obj->u.stream.dict;
+        }
+    }
+
+    /* No trailer at all: make one pointing at the catalog */
+    for (int num = 1; !trailer && num < pdf->xref_count; num++) {
+        if (pdf->xref[num].type == 0) continue;
+        const obj_t *obj = load_object(pdf, num);
+        if (obj->type == OBJ_DICT && obj_is_name(dict_get(pdf, obj, "Type"), "Catalog")) {
+            obj_t *dict = new_object(&pdf->arena, OBJ_DICT);
+            obj_t *ref = new_object(&pdf->arena, OBJ_REF);
+            const obj_t *key = make_text(&pdf->arena, OBJ_NAME, "Root", 4);
+            const obj_t **items = arena_alloc(&pdf->arena, 2 * sizeof(obj_t *));
+            if (!dict || !ref || !key || !items) {
+                return -1;
+            }
+            ref->u.ref.num = num;
+            items[0] = key;
+            items[1] = ref;
+            dict->u.items = items;
+            dict->count = 1;
+            trailer = dict;
+        }
+    }
+
+    pdf->trailer = trailer;
+    return trailer ? 0 : -1;
+}
+
+/*
+ * Stream Filters
+ */
+
+static int inflate_data(const unsigned char *in, size_t in_length, buffer_t *out) {
+    z_stream zs;
+    int ret;
+
+    memset(&zs, 0, sizeof(zs));
+    if (inflateInit(&zs) != Z_OK) {
+        return -1;
+    }
+    zs.next_in = (Bytef *)in;
+    zs.avail_in = (uInt)in_length;
+
+    do {
+        if (buffer_reserve(out, 64 * 1024) != 0) {
+            inflateEnd(&zs);
+            return -1;
+        }
+        zs.next_out = out->data + out->length;
+        zs.avail_out = (uInt)(out->capacity - out->length);
+        ret = inflate(&zs, Z_NO_FLUSH);
+        out->length = out->capacity - zs.avail_out;
+    } while (ret == Z_OK);
+
+    inflateEnd(&zs);
+
+    /* A damaged or truncated stream still gives what came before the damage */
+    return (ret == Z_STREAM_END || out->length > 0) ? 0 : -1;
+}
+
+static int paeth(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    return (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+}
+
+/* Undo a /Predictor applied before compression (in place) */
+static int apply_predictor(pdf_native_t *pdf, const obj_t *parms, buffer_t *buffer) {
+    long long predictor = obj_int(dict_get(pdf, parms, "Predictor"), 1);
+    if (predictor < 2) {
+        return 0;
+    }
+
+    long long colors = obj_int(dict_get(pdf, parms, "Colors"), 1);
+    long long bits = obj_int(dict_get(pdf, parms, "BitsPerComponent"), 8);
+    long long columns = obj_int(dict_get(pdf, parms, "Columns"), 1);
+    if (colors < 1 || colors > 32 || bits < 1 || bits > 16 || columns < 1 || columns > 1 << 20) {
+        return -1;
+    }
+    size_t bpp = (size_t)((colors * bits + 7) / 8);
+    size_t row = (size_t)((colors * bits * columns + 7) / 8);
+    unsigned char *data = buffer->data;
+
+    if (predictor == 2) {
+        /* TIFF predictor 2, 8-bit components only */
+        if (bits != 8) {
+            return -1;
+        }
+        for (size_t start = 0; start + row <= buffer->length; start += row) {
+            for (size_t i = bpp; i < row; i++) {
+                data[start + i] += data[start + i - bpp];
+            }
+        }
+        return 0;
+    }
+
+    /* PNG predictors: every row starts with its filter type; rows shrink in place */
+    size_t rows = buffer->length / (row + 1);
+    for (size_t r = 0; r < rows; r++) {
+        const unsigned char *in = data + r * (row + 1);
+        int type = in[0];
+        unsigned char *cur = data + r * row;
+        const unsigned char *prev = r > 0 ? cur - row : NULL;
+
+        for (size_t i = 0; i < row; i++) {
+            int x = in[1 + i];
+            int a = i >= bpp ? cur[i - bpp] : 0;
+            int b = prev ? prev[i] : 0;
+            int c = (prev && i >= bpp) ? prev[i - bpp] : 0;
+            switch (type) {
+                case 1: x += a; break;
+                case 2: x += b; break;
+                case 3: x += (a + b) / 2; break;
+                case 4: x += paeth(a, b, c); break;
+                default: break;
+            }
+            cur[i] = (unsigned char)x;
+        }
+    }
+    buffer->length = rows * row;
+    return 0;
+}
+
+static int lzw_decode(const unsigned char *in, size_t in_length, int early_change, buffer_t *out) {
+    uint16_t prefix[4096];
+    unsigned char suffix[4096];
+    unsigned char first[4096];
+    uint16_t lengths[4096];
+    uint32_t bit_buffer = 0;
+    int bit_count = 0;
+    int code_bits = 9;
+    int next = 258;
+    int prev = -1;
+    size_t pos = 0;
+
+    for (int i = 0; i < 256; i++) {
+        suffix[i] = first[i] = (unsigned char)i;
+        lengths[i] = 1;
+    }
+
+    for (;;) {
+        while (bit_count < code_bits && pos < in_length) {
+            bit_buffer = (bit_buffer << 8) | in[pos++];
+            bit_count += 8;
+        }
+        if (bit_count < code_bits) {
+            break;
+        }
+        int code = (bit_buffer >> (bit_count - code_bits)) & ((1 << code_bits) - 1);
+        bit_count -= code_bits;
+
+        if (code == 256) {
+            code_bits = 9;
+            next = 258;
+            prev = -1;
+            continue;
+        }
+        if (code == 257) {
+            break;
+        }
+
+        if (prev >= 0) {
+            if (code > next || (code == next && next >= 4096)) {
+                break;  /* Corrupt */
+            }
+            if (next < 4096) {
+                prefix[next] = (uint16_t)prev;
+                suffix[next] = code == next ? first[prev] : first[code];
+                first[next] = first[prev];
+                lengths[next] = lengths[prev] + 1;
+                next++;
+            }
+            if (next + early_change >= (1 << code_bits) && code_bits < 12) {
+                code_bits++;
+            }
+        } else if (code > 255) {
+            break;
+        }
+
+        /* Write the code's bytes back to front */
+        size_t length = lengths[code];
+        if (buffer_reserve(out, length) != 0) {
+            return -1;
+        }
+        unsigned char *p = out->data + out->length + length;
+        for (int c = code; ; c = prefix[c]) {
+            *--p = suffix[c];
+            if (c < 256) break;
+        }
+        out->length += length;
+        prev = code;
+    }
+    return 0;
+}
+
+static int ascii_hex_decode(const unsigned char *in, size_t in_length, buffer_t *out) {
+    int high = -1;
+
+    for (size_t i = 0; i < in_length && in[i] != '>'; i++) {
+        int v = hex_value(in[i]);
+        if (v < 0) continue;
+        if (high < 0) {
+            high = v;
+        } else {
+            unsigned char byte = (unsigned char)(high * 16 + v);
+            if (buffer_append(out, &byte, 1) != 0) return -1;
+            high = -1;
+        }
+    }
+    if (high >= 0) {
+        unsigned char byte = (unsigned char)(high * 16);
+        return buffer_append(out, &byte, 1);
+    }
+    return 0;
+}
+
+static int ascii85_decode(const unsigned char *in, size_t in_length, buffer_t *out) {
+    uint32_t value = 0;
+    int count = 0;
+
+    for (size_t i = 0; i < in_length; i++) {
+        unsigned char c = in[i];
+        if (c == '~') break;
+        if (is_space(c)) continue;
+        if (c == 'z' && count == 0) {
+            static const unsigned char zeros[4] = { 0 };
+            if (buffer_append(out, zeros, 4) != 0) return -1;
+            continue;
+        }
+        if (c < '!' || c > 'u') return -1;
+        value = value * 85 + (c - '!');
+        if (++count == 5) {
+            unsigned char bytes[4] = { value >> 24, value >> 16, value >> 8, value };
+            if (buffer_append(out, bytes, 4) != 0) return -1;
+            value = 0;
+            count = 0;
+        }
+    }
+    if (count > 1) {
+        for (int i = count; i < 5; i++) {
+            value = value * 85 + 84;
+        }
+        unsigned char bytes[4] = { value >> 24, value >> 16, value >> 8, value };
+        return buffer_append(out, bytes, count - 1);
+    }
+    return 0;
+}
+
+/*
+ * Decode a stream through its filters
+ * Returns the data null-terminated (caller frees), or NULL for filters
+ * that are not supported (image codecs) or damaged data.
+ */
+static unsigned char* decode_stream(pdf_native_t *pdf, const obj_t *stream, size_t *out_length) {
+    const obj_t *filters = dict_get(pdf, stream, "Filter");
+    const obj_t *parms = dict_get(pdf, stream, "DecodeParms");
+    const unsigned char *in = stream->u.stream.data;
+    size_t in_length = stream->u.stream.length;
+    buffer_t current = { 0 };
+    int count;
+
+    if (filters->type == OBJ_NULL) {
+        filters = dict_get(pdf, stream, "F");
+    }
+    if (parms->type == OBJ_NULL) {
+        parms = dict_get(pdf, stream, "DP");
+    }
+    count = filters->type == OBJ_ARRAY ? filters->count : filters->type == OBJ_NAME ? 1 : 0;
+
+    for (int i = 0; i < count; i++) {
+        const obj_t *filter = filters->type == OBJ_ARRAY ? resolve(pdf, filters->u.items[i]) : filters;
+        const obj_t *parm = parms->type == OBJ_ARRAY ?
+                            (i < parms->count ? resolve(pdf, parms->u.items[i]) : &null_object) : parms;
+        buffer_t next = { 0 };
+        int ok;
+
+        if (obj_is_name(filter, "FlateDecode") || obj_is_name(filter, "Fl")) {
+            ok = inflate_data(in, in_length, &next) == 0 && apply_predictor(pdf, parm, &next) == 0;
+        } else if (obj_is_name(filter, "LZWDecode") || obj_is_name(filter, "LZW")) {
+            int early_change = (int)obj_int(dict_get(pdf, parm, "EarlyChange"), 1);
+            ok = lzw_decode(in, in_length, early_change ? 1 : 0, &next) == 0 &&
+                 apply_predictor(pdf, parm, &next) == 0;
+        } else if (obj_is_name(filter, "ASCIIHexDecode") || obj_is_name(filter, "AHx")) {
+            ok = ascii_hex_decode(in, in_length, &next) == 0;
+        } else if (obj_is_name(filter, "ASCII85Decode") || obj_is_name(filter, "A85")) {
+            ok = ascii85_decode(in, in_length, &next) == 0;
+        } else {
+            ok = 0;
+        }
+
+        free(current.data);
+        current = next;
+        if (!ok) {
+            free(current.data);
+            return NULL;
+        }
+        in = current.data;
+        in_length = current.length;
+    }
+
+    if (count == 0 && buffer_append(&current, in, in_length) != 0) {
+        free(current.data);
+        return NULL;
+    }
+    if (buffer_reserve(&current, 1) != 0) {
+        free(current.data);
+        return NULL;
+    }
+    current.data[current.length] = '\0';
+    *out_length = current.length;
+    return current.data;
+}
+
+/*
+ * Page Tree
+ */
+
+static int add_pages(pdf_native_t *pdf, const obj_t *node, const obj_t *resources, int depth) {
+    if (node->type != OBJ_DICT || depth > NATIVE_MAX_DEPTH) {
+        return -1;
+    }
+
+    const obj_t *own_resources = dict_get(pdf, node, "Resources");
+    if (own_resources->type == OBJ_DICT) {
+        resources = own_resources;
+    }
+
+    const obj_t *kids = dict_get(pdf, node, "Kids");
+    if (kids->type == OBJ_ARRAY && !obj_is_name(dict_get(pdf, node, "Type"), "Page")) {
+        for (int i = 0; i < kids->count; i++) {
+            const obj_t *kid = resolve(pdf, kids->u.items[i]);
+            if (kid == node || kid->type != OBJ_DICT) {
+                continue;
+            }
+            if (add_pages(pdf, kid, resources, depth + 1) != 0) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    if (pdf->page_count >= PDF_MAX_PAGES) {
+        return -1;
+    }
+    if (pdf->page_count == pdf->page_capacity) {
+        int capacity = pdf->page_capacity ? pdf->page_capacity * 2 : 64;
+        native_page_t *grown = realloc(pdf->pages, capacity * sizeof(native_page_t));
+        if (!grown) {
+            return -1;
+        }
+        pdf->pages = grown;
+        pdf->page_capacity = capacity;
+    }
+    pdf->pages[pdf->page_count].dict = node;
+    pdf->pages[pdf->page_count].resources = resources;
+    pdf->page_count++;
+    return 0;
+}
+
+static int load_page_tree(pdf_native_t *pdf) {
+    const obj_t *root = dict_get(pdf, pdf->trailer, "Root");
+    const obj_t *pages = dict_get(pdf, root, "Pages");
+
+    pdf->page_count = 0;
+    if (add_pages(pdf, pages, &null_object, 0) != 0) {
+        return -1;
+    }
+    return pdf->page_count > 0 ? 0 : -1;
+}
+
+/*
+ * Fonts
+ */
+
+/* Unicode value of a glyph name: the glyph list, then uniXXXX / uXXXX[XX] forms */
+static uint32_t glyph_unicode(const char *name) {
+    char base[64];
+    size_t length = 0;
+
+    /* "fi.alt" -> "fi"; "f_f_i" -> "ffi" */
+    for (const char *p = name; *p && *p != '.' && length < sizeof(base) - 1; p++) {
+        if (*p != '_') base[length++] = *p;
+    }
+    base[length] = '\0';
+
+    int lo = 0, hi = PDF_GLYPH_NAMES - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        int cmp = strcmp(base, pdf_glyph_names[mid].name);
+        if (cmp == 0) return pdf_glyph_names[mid].unicode;
+        if (cmp < 0) hi = mid - 1; else lo = mid + 1;
+    }
+
+    const char *hex = NULL;
+    size_t digits = 0;
+    if (strncmp(base, "uni", 3) == 0 && length >= 7) {
+        hex = base + 3;
+        digits = 4;
+    } else if (base[0] == 'u' && length >= 5 && length <= 7) {
+        hex = base + 1;
+        digits = length - 1;
+    }
+    if (hex) {
+        uint32_t value = 0;
+        for (size_t i = 0; i < digits; i++) {
+            int v = hex_value(hex[i]);
+            if (v < 0) return 0;
+            value = value * 16 + v;
+        }
+        return value;
+    }
+    return 0;
+}
+
+static void build_simple_encoding(pdf_native_t *pdf, font_t *font, const obj_t *font_dict,
+                                  const obj_t *subtype) {
+    const obj_t *encoding = dict_get(pdf, font_dict, "Encoding");
+    const obj_t *base = encoding->type == OBJ_DICT ? dict_get(pdf, encoding, "BaseEncoding") : encoding;
+    int standard = obj_is_name(base, "StandardEncoding") ||
+                   (base->type != OBJ_NAME && obj_is_name(subtype, "Type1"));
+    int mac = obj_is_name(base, "MacRomanEncoding");
+
+    for (int c = 0; c < 256; c++) {
+        uint32_t u;
+        if (c < 0x20) {
+            u = 0;
+        } else if (c < 0x80) {
+            u = c;
+            if (standard && c == 0x27) u = 0x2019;
+            if (standard && c == 0x60) u = 0x2018;
+        } else if (standard) {
+            u = pdf_standard_encoding[c - 0x80];
+        } else if (mac) {
+            u = pdf_mac_roman_encoding[c - 0x80];
+        } else {
+            u = charset_decode_cp1252((unsigned char)c);
+        }
+        font->simple_unicode[c] = u;
+    }
+
+    /* /Differences [code /name /name ... code /name ...] */
+    const obj_t *differences = dict_get(pdf, encoding, "Differences");
+    if (differences->type == OBJ_ARRAY) {
+        long long code = 0;
+        for (int i = 0; i < differences->count; i++) {
+            const obj_t *item = resolve(pdf, differences->u.items[i]);
+            if (item->type == OBJ_NUMBER) {
+                code = obj_int(item, 0);
+            } else if (item->type == OBJ_NAME) {
+                if (code >= 0 && code < 256) {
+                    font->simple_unicode[code] = glyph_unicode(item->u.text);
+                }
+                code++;
+            }
+        }
+    }
+}
+
+static int compare_cmap_entries(const void *a, const void *b) {
+    uint32_t la = ((const cmap_entry_t *)a)->lo, lb = ((const cmap_entry_t *)b)->lo;
+    return (la > lb) - (la < lb);
+}
+
+static int compare_width_entries(const void *a, const void *b) {
+    uint32_t la = ((const width_entry_t *)a)->lo, lb = ((const width_entry_t *)b)->lo;
+    return (la > lb) - (la < lb);
+}
+
+/* Big-endian code from a CMap source string */
+static uint32_t string_code(const obj_t *string) {
+    uint32_t code = 0;
+    for (int i = 0; i < string->count && i < 4; i++) {
+        code = (code << 8) | (unsigned char)string->u.text[i];
+    }
+    return code;
+}
+
+/* Add a ToUnicode mapping of codes lo..hi to a UTF-16BE destination string (or glyph name) */
+static void cmap_add(buffer_t *entries, uint32_t lo, uint32_t hi, const obj_t *dst) {
+    cmap_entry_t entry;
+
+    if (hi < lo || hi - lo > 0xFFFF ||
+        entries->length / sizeof(cmap_entry_t) >= NATIVE_MAX_CMAP_ENTRIES) {
+        return;
+    }
+    memset(&entry, 0, sizeof(entry));
+    entry.lo = lo;
+    entry.hi = hi;
+
+    if (dst->type == OBJ_NAME) {
+        entry.unicode[0] = glyph_unicode(dst->u.text);
+        entry.count = entry.unicode[0] ? 1 : 0;
+    } else if (dst->type == OBJ_STRING) {
+        const unsigned char *s = (const unsigned char *)dst->u.text;
+        for (int i = 0; i + 1 < dst->count && entry.count < 3; i += 2) {
+            uint32_t u = (s[i] << 8) | s[i + 1];
+            if (u >= 0xD800 && u <= 0xDBFF && i + 3 < dst->count) {
+                uint32_t low = (s[i + 2] << 8) | s[i + 3];
+                if (low >= 0xDC00 && low <= 0xDFFF) {
+                    u = 0x10000 + ((u - 0xD800) << 10) + (low - 0xDC00);
+                    i += 2;
+                }
+            }
+            entry.unicode[entry.count++] = u;
+        }
+    }
+    if (entry.count > 0) {
+        buffer_append(entries, &entry, sizeof(entry));
+    }
+}
+
+/* Read bfchar/bfrange mappings (and the code width) from a ToUnicode CMap */
+static void parse_to_unicode(pdf_native_t *pdf, font_t *font, const obj_t *stream) {
+    size_t length;
+    unsigned char *data = decode_stream(pdf, stream, &length);
+    if (!data) {
+        return;
+    }
+
+    arena_t scratch = { NULL };
+    buffer_t entries = { 0 };
+    lexer_t lex = { data, data + length, 0 };
+    int code_bytes = 0;
+
+    arena_alloc(&scratch, 1);
+    arena_mark_t mark = arena_mark(&scratch);
+
+    while (lex.p < lex.end) {
+        const unsigned char *before = lex.p;
+        const obj_t *token = parse_object(&scratch, &lex, 0);
+        if (!token) {
+            if (lex.p == before) lex.p++;
+            continue;
+        }
+        if (token->type != OBJ_KEYWORD) {
+            arena_release(&scratch, mark);
+            continue;
+        }
+
+        if (strcmp(token->u.text, "begincodespacerange") == 0) {
+            for (;;) {
+                const obj_t *lo = parse_object(&scratch, &lex, 0);
+                const obj_t *hi = lo && lo->type == OBJ_STRING ? parse_object(&scratch, &lex, 0) : NULL;
+                if (!hi) break;
+                if (lo->count > code_bytes) code_bytes = lo->count;
+            }
+        } else if (strcmp(token->u.text, "beginbfchar") == 0) {
+            for (;;) {
+                const obj_t *src = parse_object(&scratch, &lex, 0);
+                const obj_t *dst = src && src->type == OBJ_STRING ? parse_object(&scratch, &lex, 0) : NULL;
+                if (!dst) break;
+                uint32_t code = string_code(src);
+                cmap_add(&entries, code, code, dst);
+            }
+        } else if (strcmp(token->u.text, "beginbfrange") == 0) {
+            for (;;) {
+                const obj_t *lo = parse_object(&scratch, &lex, 0);
+                const obj_t *hi = lo && lo->type == OBJ_STRING ? parse_object(&scratch, &lex, 0) : NULL;
+                const obj_t *dst = hi && hi->type == OBJ_STRING ? parse_object(&scratch, &lex, 0) : NULL;
+                if (!dst) break;
+                uint32_t code_lo = string_code(lo), code_hi = string_code(hi);
+                if (dst->type == OBJ_ARRAY) {
+                    for (int i = 0; i < dst->count && code_lo + i <= code_hi; i++) {
+                        cmap_add(&entries, code_lo + i, code_lo + i, dst->u.items[i]);
+                    }
+                } else {
+                    cmap_add(&entries, code_lo, code_hi, dst);
+                }
+            }
+        }
+        arena_release(&scratch, mark);
+    }
+
+    arena_free(&scratch);
+    free(data);
+
+    int count = (int)(entries.length / sizeof(cmap_entry_t));
+    if (count > 0) {
+        qsort(entries.data, count, sizeof(cmap_entry_t), compare_cmap_entries);
+        font->to_unicode = arena_alloc(&pdf->arena, entries.length);
+        if (font->to_unicode) {
+            memcpy(font->to_unicode, entries.data, entries.length);
+            font->to_unicode_count = count;
+        }
+    }
+    free(entries.data);
+
+    if (font->code_bytes == 2 && code_bytes == 1) {
+        font->code_bytes = 1;
+    }
+}
+
+/* Read a CID font's /W array: "c [w1 w2 ...]" and "c_first c_last w" groups */
+static void parse_cid_widths(pdf_native_t *pdf, font_t *font, const obj_t *w) {
+    buffer_t entries = { 0 };
+
+    for (int i = 0; w->type == OBJ_ARRAY && i + 1 < w->count; ) {
+        const obj_t *first = resolve(pdf, w->u.items[i]);
+        const obj_t *next = resolve(pdf, w->u.items[i + 1]);
+        uint32_t c = (uint32_t)obj_int(first, 0);
+
+        if (next->type == OBJ_ARRAY) {
+            for (int k = 0; k < next->count; k++) {
+                width_entry_t entry = { c + k, c + k, (float)obj_number(resolve(pdf, next->u.items[k]), 0) };
+                buffer_append(&entries, &entry, sizeof(entry));
+            }
+            i += 2;
+        } else if (i + 2 < w->count) {
+            width_entry_t entry = { c, (uint32_t)obj_int(next, 0),
+                                    (float)obj_number(resolve(pdf, w->u.items[i + 2]), 0) };
+            buffer_append(&entries, &entry, sizeof(entry));
+            i += 3;
+        } else {
+            break;
+        }
+    }
+
+    int count = (int)(entries.length / sizeof(width_entry_t));
+    if (count > 0) {
+        qsort(entries.data, count, sizeof(width_entry_t), compare_width_entries);
+        font->widths = arena_alloc(&pdf->arena, entries.length);
+        if (font->widths) {
+            memcpy(font->widths, entries.data, entries.length);
+            font->width_count = count;
+        }
+    }
+    free(entries.data);
+}
+
+static font_t* load_font(pdf_native_t *pdf, const obj_t *font_dict) {
+    for (int i = 0; i < pdf->font_count; i++) {
+        if (pdf->fonts[i].key == font_dict) {
+            return pdf->fonts[i].font;
+        }
+    }
+
+    font_t *font = arena_alloc(&pdf->arena, sizeof(font_t));
+    if (!font) {
+        return NULL;
+    }
+    memset(font, 0, sizeof(font_t));
+
+    const obj_t *subtype = dict_get(pdf, font_dict, "Subtype");
+    if (obj_is_name(subtype, "Type0")) {
+        const obj_t *descendants = dict_get(pdf, font_dict, "DescendantFonts");
+        const obj_t *cid_font = descendants->type == OBJ_ARRAY && descendants->count > 0 ?
+                                resolve(pdf, descendants->u.items[0]) : &null_object;
+        font->code_bytes = 2;
+        font->default_width = (float)obj_number(dict_get(pdf, cid_font, "DW"), 1000);
+        parse_cid_widths(pdf, font, dict_get(pdf, cid_font, "W"));
+    } else {
+        font->code_bytes = 1;
+        build_simple_encoding(pdf, font, font_dict, subtype);
+
+        /* Widths; Type 3 glyph space is scaled by the font matrix */
+        const obj_t *widths = dict_get(pdf, font_dict, "Widths");
+        long long first_char = obj_int(dict_get(pdf, font_dict, "FirstChar"), 0);
+        const obj_t *descriptor = dict_get(pdf, font_dict, "FontDescriptor");
+        double missing = obj_number(dict_get(pdf, descriptor, "MissingWidth"), 0);
+        double scale = 1.0;
+        if (obj_is_name(subtype, "Type3")) {
+            const obj_t *matrix = dict_get(pdf, font_dict, "FontMatrix");
+            if (matrix->type == OBJ_ARRAY && matrix->count >= 1) {
+                scale = obj_number(resolve(pdf, matrix->u.items[0]), 0.001) * 1000;
+            }
+        }
+        for (int c = 0; c < 256; c++) {
+            long long i = c - first_char;
+            double width = (widths->type == OBJ_ARRAY && i >= 0 && i < widths->count) ?
+                           obj_number(resolve(pdf, widths->u.items[i]), missing) : missing;
+            /* The standard 14 fonts may have no widths at all */
+            font->simple_width[c] = (float)(widths->type == OBJ_ARRAY ? width * scale : 500);
+        }
+    }
+
+    const obj_t *to_unicode = dict_get(pdf, font_dict, "ToUnicode");
+    if (to_unicode->type == OBJ_STREAM) {
+        parse_to_unicode(pdf, font, to_unicode);
+    }
+
+    if (pdf->font_count == pdf->font_capacity) {
+        int capacity = pdf->font_capacity ? pdf->font_capacity * 2 : 16;
+        font_cache_entry_t *grown = realloc(pdf->fonts, capacity * sizeof(font_cache_entry_t));
+        if (!grown) {
+            return font;
+        }
+        pdf->fonts = grown;
+        pdf->font_capacity = capacity;
+    }
+    pdf->fonts[pdf->font_count].key = font_dict;
+    pdf->fonts[pdf->font_count].font = font;
+    pdf->font_count++;
+    return font;
+}
+
+/* Text of a character code (up to 3 characters) */
+static int font_unicode(const font_t *font, uint32_t code, uint32_t out[3]) {
+    int lo = 0, hi = font->to_unicode_count - 1;
+
+    /* Last entry starting at or before code */
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (font->to_unicode[mid].lo <= code) lo = mid; else hi = mid - 1;
+    }
+    if (font->to_unicode_count > 0 && font->to_unicode[lo].lo <= code &&
+        code <= font->to_unicode[lo].hi) {
+        const cmap_entry_t *entry = &font->to_unicode[lo];
+        for (int i = 0; i < entry->count; i++) {
+            out[i] = entry->unicode[i];
+        }
+        out[entry->count - 1] += code - entry->lo;
+        return entry->count;
+    }
+
+    if (font->code_bytes == 1 && font->simple_unicode[code & 0xFF]) {
+        out[0] = font->simple_unicode[code & 0xFF];
+        return 1;
+    }
+    return 0;
+}
+
+/* Glyph width in 1/1000 text space units */
+static float font_width(const font_t *font, uint32_t code) {
+    if (font->code_bytes == 1) {
+        return font->simple_width[code & 0xFF];
+    }
+
+    int lo = 0, hi = font->width_count - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (font->widths[mid].lo <= code) lo = mid; else hi = mid - 1;
+    }
+    if (font->width_count > 0 && font->widths[lo].lo <= code && code <= font->widths[lo].hi) {
+        return font->widths[lo].width;
+    }
+    return font->default_width;
+}
+
+/*
+ * Content Interpreter
+ */
+
+typedef struct {
+    double a, b, c, d, e, f;
+} matrix_t;
+
+static const matrix_t identity_matrix = { 1, 0, 0, 1, 0, 0 };
+
+/* m × n */
+static matrix_t matrix_multiply(matrix_t m, matrix_t n) {
+    matrix_t r;
+    r.a = m.a * n.a + m.b * n.c;
+    r.b = m.a * n.b + m.b * n.d;
+    r.c = m.c * n.a + m.d * n.c;
+    r.d = m.c * n.b + m.d * n.d;
+    r.e = m.e * n.a + m.f * n.c + n.e;
+    r.f = m.e * n.b + m.f * n.d + n.f;
+    return r;
+}
+
+/* Graphics state, as far as text placement goes */
+typedef struct {
+    matrix_t ctm;
+    font_t *font;
+    double font_size;
+    double char_spacing;
+    double word_spacing;
+    double scale;                      /* Horizontal scaling (Tz / 100) */
+    double leading;
+    double rise;
+} gstate_t;
+
+typedef struct {
+    float x, y;                        /* Glyph origin on the page */
+    float x_end;                       /* Where the next glyph would start */
+    float size;                        /* Font size on the page */
+    uint32_t text;                     /* Offset of its UTF-8 in the page's text buffer */
+    uint8_t length;                    /* UTF-8 bytes */
+} glyph_t;
+
+typedef struct {
+    pdf_native_t *pdf;
+    arena_t arena;                     /* Operands, released after each operator */
+    gstate_t gs;
+    gstate_t saved[NATIVE_MAX_SAVE];
+    int save_depth;
+    matrix_t tm;                       /* Text matrix */
+    matrix_t tlm;                      /* Text line matrix */
+    int form_depth;
+    glyph_t *glyphs;
+    int glyph_count;
+    int glyph_capacity;
+    buffer_t text;                     /* UTF-8 of all glyphs */
+    int failed;                        /* Out of memory */
+} content_t;
+
+static void append_codepoint(buffer_t *text, uint32_t cp) {
+    char utf8[UTF8_MAX_BYTES];
+    buffer_append(text, utf8, utf8_encode(cp, utf8));
+}
+
+/* Record one glyph and its text */
+static void emit_glyph(content_t *ct, const uint32_t *unicode, int count,
+                       float x, float y, float x_end, float size) {
+    size_t start = ct->text.length;
+
+    for (int i = 0; i < count; i++) {
+        uint32_t cp = unicode[i];
+        if (cp >= 0xFB00 && cp <= 0xFB06) {
+            /* Ligatures: the reader's fonts have the letters, not the ligature glyphs */
+            static const char *const ligatures[] = { "ff", "fi", "fl", "ffi", "ffl", "st", "st" };
+            buffer_append(&ct->text, ligatures[cp - 0xFB00], strlen(ligatures[cp - 0xFB00]));
+        } else if (cp == 0xA0 || cp == '\t') {
+            append_codepoint(&ct->text, ' ');
+        } else if (cp >= 0x20 && cp != 0xAD && cp <= UTF8_MAX_CODEPOINT &&
+                   !(cp >= 0xD800 && cp <= 0xDFFF) && cp != 0xFFFD) {
+            append_codepoint(&ct->text, cp);
+        }
+    }
+    if (ct->text.length == start) {
+        return;
+    }
+
+    if (ct->glyph_count == ct->glyph_capacity) {
+        int capacity = ct->glyph_capacity ? ct->glyph_capacity * 2 : 1024;
+        glyph_t *grown = realloc(ct->glyphs, capacity * sizeof(glyph_t));
+        if (!grown) {
+            ct->failed = 1;
+            return;
+        }
+        ct->glyphs = grown;
+        ct->glyph_capacity = capacity;
+    }
+
+    glyph_t *glyph = &ct->glyphs[ct->glyph_count++];
+    glyph->x = x;
+    glyph->y = y;
+    glyph->x_end = x_end;
+    glyph->size = size;
+    glyph->text = (uint32_t)start;
+    glyph->length = (uint8_t)(ct->text.length - start);
+}
+
+/* Show a string (Tj): place each glyph and advance the text matrix */
+static void show_text(content_t *ct, const obj_t *string) {
+    const unsigned char *s = (const unsigned char *)string->u.text;
+    const font_t *font = ct->gs.font;
+    int code_bytes = font ? font->code_bytes : 1;
+
+    if (string->type != OBJ_STRING) {
+        return;
+    }
+
+    for (int i = 0; i + code_bytes <= string->count; i += code_bytes) {
+        uint32_t code = s[i];
+        if (code_bytes == 2) {
+            code = (code << 8) | s[i + 1];
+        }
+
+        uint32_t unicode[3];
+        int count;
+        float width;
+        if (font) {
+            count = font_unicode(font, code, unicode);
+            width = font_width(font, code) / 1000.0f;
+        } else {
+            unicode[0] = code >= 0x20 ? charset_decode_cp1252((unsigned char)code) : 0;
+            count = unicode[0] ? 1 : 0;
+            width = 0.5f;
+        }
+
+        matrix_t m = matrix_multiply(ct->tm, ct->gs.ctm);
+        double x = m.c * ct->gs.rise + m.e;
+        double y = m.d * ct->gs.rise + m.f;
+        double size = fabs(ct->gs.font_size) * hypot(m.c, m.d);
+        double tx = (width * ct->gs.font_size + ct->gs.char_spacing +
+                     (code_bytes == 1 && code == ' ' ? ct->gs.word_spacing : 0)) * ct->gs.scale;
+
+        emit_glyph(ct, unicode, count, (float)x, (float)y, (float)(x + m.a * tx),
+                   (float)(size > 0.1 ? size : 0.1));
+
+        ct->tm.e += tx * ct->tm.a;
+        ct->tm.f += tx * ct->tm.b;
+    }
+}
+
+static void text_move(content_t *ct, double tx, double ty) {
+    matrix_t move = { 1, 0, 0, 1, tx, ty };
+    ct->tlm = matrix_multiply(move, ct->tlm);
+    ct->tm = ct->tlm;
+}
+
+static void run_content(content_t *ct, const unsigned char *data, size_t length,
+                        const obj_t *resources);
+
+/* Draw a form XObject (Do): its content runs with its own matrix and resources */
+static void draw_xobject(content_t *ct, const obj_t *name, const obj_t *resources) {
+    pdf_native_t *pdf = ct->pdf;
+
+    if (name->type != OBJ_NAME || ct->form_depth >= NATIVE_MAX_FORM_DEPTH) {
+        return;
+    }
+    const obj_t *xobject = dict_get(pdf, dict_get(pdf, resources, "XObject"), name->u.text);
+    if (xobject->type != OBJ_STREAM || !obj_is_name(dict_get(pdf, xobject, "Subtype"), "Form")) {
+        return;  /* Images */
+    }
+
+    size_t length;
+    unsigned char *data = decode_stream(pdf, xobject, &length);
+    if (!data) {
+        return;
+    }
+
+    gstate_t saved = ct->gs;
+    matrix_t saved_tm = ct->tm, saved_tlm = ct->tlm;
+    const obj_t *matrix = dict_get(pdf, xobject, "Matrix");
+    if (matrix->type == OBJ_ARRAY && matrix->count >= 6) {
+        matrix_t m;
+        m.a = obj_number(resolve(pdf, matrix->u.items[0]), 1);
+        m.b = obj_number(resolve(pdf, matrix->u.items[1]), 0);
+        m.c = obj_number(resolve(pdf, matrix->u.items[2]), 0);
+        m.d = obj_number(resolve(pdf, matrix->u.items[3]), 1);
+        m.e = obj_number(resolve(pdf, matrix->u.items[4]), 0);
+        m.f = obj_number(resolve(pdf, matrix->u.items[5]), 0);
+        ct->gs.ctm = matrix_multiply(m, ct->gs.ctm);
+    }
+    const obj_t *form_resources = dict_get(pdf, xobject, "Resources");
+
+    ct->form_depth++;
+    run_content(ct, data, length, form_resources->type == OBJ_DICT ? form_resources : resources);
+    ct->form_depth--;
+
+    ct->gs = saved;
+    ct->tm = saved_tm;
+    ct->tlm = saved_tlm;
+    free(data);
+}
+
+/* Skip an inline image: BI <dict> ID <binary data> EI */
+static void skip_inline_image(content_t *ct, lexer_t *lex) {
+    for (;;) {
+        const unsigned char *before = lex->p;
+        const obj_t *token = parse_object(&ct->arena, lex, 0);
+        if (!token) {
+            if (lex->p >= lex->end) return;
+            if (lex->p == before) lex->p++;
+            continue;
+        }
+        if (token->type == OBJ_KEYWORD && strcmp(token->u.text, "ID") == 0) {
+            break;
+        }
+    }
+
+    for (const unsigned char *p = lex->p + 1; p + 2 <= lex->end; p++) {
+        if (p[0] == 'E' && p[1] == 'I' && is_space(p[-1]) && (p + 2 == lex->end || is_space(p[2]))) {
+            lex->p = p + 2;
+            return;
+        }
+    }
+    lex->p = lex->end;
+}
+
+static double operand(const obj_t **ops, int n, int count, int i) {
+    return obj_number(ops[n - count + i], 0);
+}
+
+static void execute(content_t *ct, const char *op, const obj_t **ops, int n,
+                    const obj_t *resources, lexer_t *lex) {
+    gstate_t *gs = &ct->gs;
+
+    switch (op[0]) {
+        case 'q':
+            if (op[1] == '\0' && ct->save_depth < NATIVE_MAX_SAVE) {
+                ct->saved[ct->save_depth++] = *gs;
+            }
+            return;
+        case 'Q':
+            if (op[1] == '\0' && ct->save_depth > 0) {
+                *gs = ct->saved[--ct->save_depth];
+            }
+            return;
+        case 'c':
+            if (strcmp(op, "cm") == 0 && n >= 6) {
+                matrix_t m = { operand(ops, n, 6, 0), operand(ops, n, 6, 1), operand(ops, n, 6, 2),
+                               operand(ops, n, 6, 3), operand(ops, n, 6, 4), operand(ops, n, 6, 5) };
+                gs->ctm = matrix_multiply(m, gs->ctm);
+            }
+            return;
+        case 'B':
+            if (strcmp(op, "BT") == 0) {
+                ct->tm = ct->tlm = identity_matrix;
+            } else if (strcmp(op, "BI") == 0) {
+                skip_inline_image(ct, lex);
+            }
+            return;
+        case 'D':
+            if (strcmp(op, "Do") == 0 && n >= 1) {
+                draw_xobject(ct, ops[n - 1], resources);
+            }
+            return;
+        case '\'':
+            text_move(ct, 0, -gs->leading);
+            if (n >= 1) show_text(ct, ops[n - 1]);
+            return;
+        case '"':
+            if (n >= 3) {
+                gs->word_spacing = operand(ops, n, 3, 0);
+                gs->char_spacing = operand(ops, n, 3, 1);
+                text_move(ct, 0, -gs->leading);
+                show_text(ct, ops[n - 1]);
+            }
+            return;
+        case 'T':
+            break;
+        default:
+            return;
+    }
+
+    /* Text operators */
+    if (op[1] == '\0' || op[2] != '\0') {
+        return;
+    }
+    switch (op[1]) {
+        case 'j':
+            if (n >= 1) show_text(ct, ops[n - 1]);
+            break;
+        case 'J':
+            if (n >= 1 && ops[n - 1]->type == OBJ_ARRAY) {
+                const obj_t *array = ops[n - 1];
+                for (int i = 0; i < array->count; i++) {
+                    const obj_t *item = array->u.items[i];
+                    if (item->type == OBJ_STRING) {
+                        show_text(ct, item);
+                    } else if (item->type == OBJ_NUMBER) {
+                        double tx = -item->u.number / 1000.0 * gs->font_size * gs->scale;
+                        ct->tm.e += tx * ct->tm.a;
+                        ct->tm.f += tx * ct->tm.b;
+                    }
+                }
+            }
+            break;
+        case 'f':
+            if (n >= 2) {
+                const obj_t *name = ops[n - 2];
+                const obj_t *font_dict = name->type == OBJ_NAME ?
+                    dict_get(ct->pdf, dict_get(ct->pdf, resources, "Font"), name->u.text) : &null_object;
+                gs->font = font_dict->type == OBJ_DICT ? load_font(ct->pdf, font_dict) : NULL;
+                gs->font_size = operand(ops, n, 2, 1);
+            }
+            break;
+        case 'd':
+            if (n >= 2) text_move(ct, operand(ops, n, 2, 0), operand(ops, n, 2, 1));
+            break;
+        case 'D':
+            if (n >= 2) {
+                gs->leading = -operand(ops, n, 2, 1);
+                text_move(ct, operand(ops, n, 2, 0), operand(ops, n, 2, 1));
+            }
+            break;
+        case 'm':
+            if (n >= 6) {
+                matrix_t m = { operand(ops, n, 6, 0), operand(ops, n, 6, 1), operand(ops, n, 6, 2),
+                               operand(ops, n, 6, 3), operand(ops, n, 6, 4), operand(ops, n, 6, 5) };
+                ct->tm = ct->tlm = m;
+            }
+            break;
+        case '*':
+            text_move(ct, 0, -gs->leading);
+            break;
+        case 'c':
+            if (n >= 1) gs->char_spacing = operand(ops, n, 1, 0);
+            break;
+        case 'w':
+            if (n >= 1) gs->word_spacing = operand(ops, n, 1, 0);
+            break;
+        case 'z':
+            if (n >= 1) gs->scale = operand(ops, n, 1, 0) / 100.0;
+            break;
+        case 'L':
+            if (n >= 1) gs->leading = operand(ops, n, 1, 0);
+            break;
+        case 's':
+            if (n >= 1) gs->rise = operand(ops, n, 1, 0);
+            break;
+        default:
+            break;
+    }
+}
+
+static void run_content(content_t *ct, const unsigned char *data, size_t length,
+                        const obj_t *resources) {
+    lexer_t lex = { data, data + length, 0 };
+    const obj_t *ops[NATIVE_MAX_OPERANDS];
+    int n = 0;
+    arena_mark_t mark = arena_mark(&ct->arena);
+
+    while (!ct->failed) {
+        lex_skip_space(&lex);
+        if (lex.p >= lex.end) {
+            break;
+        }
+
+        const unsigned char *before = lex.p;
+        const obj_t *obj = parse_object(&ct->arena, &lex, 0);
+        if (!obj) {
+            if (lex.p == before) lex.p++;
+            continue;
+        }
+        if (obj->type != OBJ_KEYWORD) {
+            if (n < NATIVE_MAX_OPERANDS) ops[n++] = obj;
+            continue;
+        }
+
+        execute(ct, obj->u.text, ops, n, resources, &lex);
+        n = 0;
+        arena_release(&ct->arena, mark);
+    }
+    arena_release(&ct->arena, mark);
+}
+
+/*
+ * Reading Order
+ * Glyphs drawn one after another on the same baseline form fragments;
+ * fragments on the same baseline (a word drawn later in bold, say) are
+ * gathered into lines, which come out in the order they were started.
+ */
+
+typedef struct {
+    int first, last;                   /* Glyphs, consecutive in drawing order */
+    float x0, x1, y, size;
+    int line;
+} fragment_t;
+
+typedef struct {
+    float y, size, x0, x1;
+} line_t;
+
+static int compare_fragments(const void *a, const void *b) {
+    const fragment_t *fa = a, *fb = b;
+    if (fa->line != fb->line) return fa->line - fb->line;
+    return (fa->x0 > fb->x0) - (fa->x0 < fb->x0);
+}
+
+static void trim_spaces(buffer_t *out) {
+    while (out->length > 0 && out->data[out->length - 1] == ' ') {
+        out->length--;
+    }
+}
+
+static int build_text(content_t *ct, buffer_t *out) {
+    int count = ct->glyph_count;
+    fragment_t *fragments = malloc((count ? count : 1) * sizeof(fragment_t));
+    line_t *lines = malloc((count ? count : 1) * sizeof(line_t));
+    int fragment_count = 0, line_count = 0;
+
+    if (!fragments || !lines) {
+        free(fragments);
+        free(lines);
+        return -1;
+    }
+
+    /* Fragments */
+    for (int i = 0; i < count; i++) {
+        const glyph_t *g = &ct->glyphs[i];
+        fragment_t *f = fragment_count ? &fragments[fragment_count - 1] : NULL;
+        float size = f && f->size > g->size ? f->size : g->size;
+
+        if (f && fabsf(g->y - f->y) <= 0.3f * size && g->x >= ct->glyphs[f->last].x_end - 0.5f * size) {
+            f->last = i;
+            if (g->x_end > f->x1) f->x1 = g->x_end;
+            if (g->size > f->size) f->size = g->size;
+            continue;
+        }
+        f = &fragments[fragment_count++];
+        f->first = f->last = i;
+        f->x0 = g->x;
+        f->x1 = g->x_end;
+        f->y = g->y;
+        f->size = g->size;
+    }
+
+    /* Lines: a fragment joins one of the last few lines on its baseline, if it does not overlap */
+    for (int i = 0; i < fragment_count; i++) {
+        fragment_t *f = &fragments[i];
+        int joined = -1;
+
+        for (int l = line_count - 1; l >= 0 && l >= line_count - 4; l--) {
+            line_t *line = &lines[l];
+            float size = line->size > f->size ? line->size : f->size;
+            if (fabsf(line->y - f->y) <= 0.4f * size &&
+                (f->x0 >= line->x1 - 0.5f * size || f->x1 <= line->x0 + 0.5f * size)) {
+                joined = l;
+                break;
+            }
+        }
+        if (joined < 0) {
+            joined = line_count++;
+            lines[joined].y = f->y;
+            lines[joined].size = f->size;
+            lines[joined].x0 = f->x0;
+            lines[joined].x1 = f->x1;
+        } else {
+            line_t *line = &lines[joined];
+            if (f->x0 < line->x0) line->x0 = f->x0;
+            if (f->x1 > line->x1) line->x1 = f->x1;
+            if (f->size > line->size) line->size = f->size;
+        }
+        f->line = joined;
+    }
+
+    qsort(fragments, fragment_count, sizeof(fragment_t), compare_fragments);
+
+    /* Text: spaces where glyphs leave a gap, newlines between lines, a blank line at big jumps */
+    int current_line = -1;
+    const glyph_t *prev = NULL;
+    for (int i = 0; i < fragment_count; i++) {
+        const fragment_t *f = &fragments[i];
+
+        if (f->line != current_line) {
+            if (current_line >= 0) {
+                const line_t *a = &lines[current_line], *b = &lines[f->line];
+                float height = a->size > b->size ? a->size : b->size;
+                float drop = a->y - b->y;
+                trim_spaces(out);
+                buffer_append(out, "\n", 1);
+                if (drop > 1.8f * height || drop < -height) {
+                    buffer_append(out, "\n", 1);
+                }
+            }
+            current_line = f->line;
+            prev = NULL;
+        }
+
+        for (int k = f->first; k <= f->last; k++) {
+            const glyph_t *g = &ct->glyphs[k];
+            const char *text = (const char *)ct->text.data + g->text;
+
+            if (prev) {
+                float gap = g->x - prev->x_end;
+                /* Fake bold: the same glyph drawn twice, slightly offset */
+                if (g->length == prev->length && fabsf(g->x - prev->x) < 0.1f * g->size &&
+                    fabsf(g->y - prev->y) < 0.1f * g->size &&
+                    memcmp(text, ct->text.data + prev->text, g->length) == 0) {
+                    continue;
+                }
+                if (gap > 0.15f * g->size && out->length > 0 && out->data[out->length - 1] != ' ' &&
+                    text[0] != ' ') {
+                    buffer_append(out, " ", 1);
+                }
+            }
+            buffer_append(out, text, g->length);
+            prev = g;
+        }
+    }
+    trim_spaces(out);
+    if (out->length > 0) {
+        buffer_append(out, "\n", 1);
+    }
+
+    free(fragments);
+    free(lines);
+    return 0;
+}
+
+/*
+ * Text Strings (Info dictionary)
+ */
+
+static void copy_text_string(const obj_t *string, char *out, size_t size) {
+    const unsigned char *s = (const unsigned char *)string->u.text;
+    size_t length = 0;
+
+    out[0] = '\0';
+    if (string->type != OBJ_STRING || size == 0) {
+        return;
+    }
+
+    for (int i = 0; i < string->count; ) {
+        uint32_t cp;
+        if (string->count >= 2 && s[0] == 0xFE && s[1] == 0xFF) {
+            /* UTF-16BE */
+            if (i == 0) i = 2;
+            if (i + 1 >= string->count) break;
+            cp = (s[i] << 8) | s[i + 1];
+            i += 2;
+            if (cp >= 0xD800 && cp <= 0xDBFF && i + 1 < string->count) {
+                uint32_t low = (s[i] << 8) | s[i + 1];
+                if (low >= 0xDC00 && low <= 0xDFFF) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    i += 2;
+                }
+            }
+        } else if (string->count >= 3 && s[0] == 0xEF && s[1] == 0xBB && s[2] == 0xBF) {
+            /* UTF-8 (PDF 2.0) */
+            if (i == 0) i = 3;
+            if (i >= string->count) break;
+            i += (int)utf8_decode((const char *)s + i, string->count - i, &cp);
+        } else {
+            /* PDFDocEncoding */
+            unsigned char c = s[i++];
+            cp = (c >= 0x80 && c < 0xA0) ? pdf_doc_encoding[c - 0x80] : c;
+        }
+
+        if (cp < 0x20) {
+            cp = ' ';
+        }
+        if (cp >= 0xD800 && cp <= 0xDFFF) {
+            continue;
+        }
+        if (length + utf8_encoded_length(cp) >= size) {
+            break;
+        }
+        length += utf8_encode(cp, out + length);
+    }
+
+    while (length > 0 && out[length - 1] == ' ') {
+        length--;
+    }
+    out[length] = '\0';
+}
+
+/*
+ * Public API
+ */
+
+pdf_native_t* pdf_native_open(const char *filepath) {
+    struct stat st;
+    int fd;
+
+    if (!filepath) {
+        return NULL;
+    }
+
+    fd = open(filepath, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size < 8) {
+        close(fd);
+        return NULL;
+    }
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+
+    pdf_native_t *pdf = calloc(1, sizeof(pdf_native_t));
+    if (!pdf) {
+        munmap(map, (size_t)st.st_size);
+        return NULL;
+    }
+    pdf->data = map;
+    pdf->size = (size_t)st.st_size;
+
+    /* Missing or damaged cross-reference data is rebuilt by scanning the file */
+    int repaired = 0;
+    if (load_xref(pdf) != 0) {
+        if (reconstruct_xref(pdf) != 0) {
+            goto fail;
+        }
+        repaired = 1;
+    }
+
+    if (dict_find(pdf->trailer, "Encrypt")->type != OBJ_NULL) {
+        fprintf(stderr, "pdf_native: %s is encrypted\n", filepath);
+        goto fail;
+    }
+
+    if (load_page_tree(pdf) != 0) {
+        if (repaired || reconstruct_xref(pdf) != 0 || load_page_tree(pdf) != 0) {
+            goto fail;
+        }
+    }
+
+    return pdf;
+
+fail:
+    pdf_native_close(pdf);
+    return NULL;
+}
+
+void pdf_native_close(pdf_native_t *pdf) {
+    if (!pdf) {
+        return;
+    }
+
+    xref_reset(pdf);
+    free(pdf->pages);
+    free(pdf->fonts);
+    arena_free(&pdf->arena);
+    munmap((void *)pdf->data, pdf->size);
+    free(pdf);
+}
+
+int pdf_native_page_count(const pdf_native_t *pdf) {
+    return pdf ? pdf->page_count : 0;
+}
+
+void pdf_native_metadata(pdf_native_t *pdf, pdf_metadata_t *metadata) {
+    memset(metadata, 0, sizeof(pdf_metadata_t));
+    if (!pdf) {
+        return;
+    }
+
+    const obj_t *info = dict_get(pdf, pdf->trailer, "Info");
+    copy_text_string(dict_get(pdf, info, "Title"), metadata->title, sizeof(metadata->title));
+    copy_text_string(dict_get(pdf, info, "Author"), metadata->author, sizeof(metadata->author));
+    copy_text_string(dict_get(pdf, info, "Subject"), metadata->subject, sizeof(metadata->subject));
+    copy_text_string(dict_get(pdf, info, "Creator"), metadata->creator, sizeof(metadata->creator));
+}
+
+int pdf_native_page_text(pdf_native_t *pdf, int page_index, char **out_text, size_t *out_length) {
+    if (!pdf || !out_text || !out_length || page_index < 0 || page_index >= pdf->page_count) {
+        return PDF_ERROR_NOT_FOUND;
+    }
+
+    const native_page_t *page = &pdf->pages[page_index];
+    const obj_t *contents = dict_get(pdf, page->dict, "Contents");
+    int count = contents->type == OBJ_ARRAY ? contents->count : 1;
+    buffer_t content = { 0 };
+
+    /* A page's content streams run as one (operators may straddle them) */
+    for (int i = 0; i < count; i++) {
+        const obj_t *stream = contents->type == OBJ_ARRAY ? resolve(pdf, contents->u.items[i]) : contents;
+        if (stream->type != OBJ_STREAM) {
+            continue;
+        }
+        size_t length;
+        unsigned char *data = decode_stream(pdf, stream, &length);
+        if (!data) {
+            free(content.data);
+            return PDF_ERROR_UNSUPPORTED;
+        }
+        int failed = buffer_append(&content, data, length) != 0 || buffer_append(&content, "\n", 1) != 0;
+        free(data);
+        if (failed) {
+            free(content.data);
+            return PDF_ERROR_TOO_LARGE;
+        }
+    }
+
+    content_t ct;
+    memset(&ct, 0, sizeof(ct));
+    ct.pdf = pdf;
+    ct.gs.ctm = identity_matrix;
+    ct.gs.scale = 1.0;
+    ct.tm = ct.tlm = identity_matrix;
+    arena_alloc(&ct.arena, 1);
+
+    run_content(&ct, content.data, content.length, page->resources);
+    free(content.data);
+    arena_free(&ct.arena);
+
+    buffer_t out = { 0 };
+    int result = (!ct.failed && build_text(&ct, &out) == 0 && buffer_reserve(&out, 1) == 0) ?
+                 PDF_SUCCESS : PDF_ERROR_OUT_OF_MEMORY;
+    free(ct.glyphs);
+    free(ct.text.data);
+
+    if (result != PDF_SUCCESS) {
+        free(out.data);
+        return result;
+    }
+
+    out.data[out.length] = '\0';
+    *out_text = (char *)out.data;
+    *out_length = out.length;
+    return PDF_SUCCESS;
+}
@@ -0,0 +1,84 @@
+/*
+ * pdf_native.h - Native PDF Text Extraction
+ *
+ * Reads the text of a PDF in-process, without the Poppler helpers: the
+ * cross-reference table (or stream) is parsed at open, and each page's
+ * content streams are inflated with zlib and run through a text-only
+ * interpreter when the page is asked for. Glyphs are mapped to Unicode
+ * through the font's ToUnicode CMap or its encoding, positioned with the
+ * text and graphics matrices, and put back together into reading-order
+ * lines.
+ *
+ * Files this cannot read (encrypted, unsupported stream filters, damaged
+ * beyond repair) make pdf_native_open() or pdf_native_page_text() fail, and
+ * pdf_reader.c falls back to pdftotext.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef PDF_NATIVE_H
+#define PDF_NATIVE_H
+
+#include <stddef.h>
+#include "pdf_reader.h"
+
+/* Open native document (opaque) */
+typedef struct pdf_native pdf_native_t;
+
+/**
+ * Open a PDF and read its cross-reference data and page tree
+ * @param filepath: Path to PDF file
+ * @return: Document, or NULL if it cannot be read natively
+ * @note: Caller must free with pdf_native_close()
+ */
+pdf_native_t* pdf_native_open(const char *filepath);
+
+/**
+ * Close a document
+ * @param pdf: Document (NULL is ignored)
+ */
+void pdf_native_close(pdf_native_t *pdf);
+
+/**
+ * Get the number of pages
+ * @param pdf: Document
+ * @return: Page count
+ */
+int pdf_native_page_count(const pdf_native_t *pdf);
+
+/**
+ * Read the document Info dictionary
+ * @param pdf: Document
+ * @param metadata: Output metadata (fields missing from the file are empty)
+ */
+void pdf_native_metadata(pdf_native_t *pdf, pdf_metadata_t *metadata);
+
+/**
+ * Extract the text of one page
+ * @param pdf: Document
+ * @param page_index: Page index (0-based)
+ * @param out_text: Output text, UTF-8 and null-terminated (caller frees)
+ * @param out_length: Output text length in bytes
+ * @return: PDF_SUCCESS on success, PDF_ERROR_UNSUPPORTED if the page uses
+ *          something this extractor does not handle, other error code otherwise
+ */
+int pdf_native_page_text(pdf_native_t *pdf, int page_index, char **out_text, size_t *out_length);
+
+#endif /* PDF_NATIVE_H */
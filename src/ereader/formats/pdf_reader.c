@@ -26,12 +26,20 @@
  * Author: E-Reader Project
  */
 
+#define _GNU_SOURCE  /* pipe2() */
+
 #include "pdf_reader.h"
+#include "pdf_native.h"
+#include "text_cache.h"
+#include "../rendering/utf8.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <strings.h>
 #include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <spawn.h>
 #include <unistd.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
@@ -41,8 +49,9 @@
  */
 #define PDFTOTEXT_CMD "/usr/bin/pdftotext"
 #define PDFINFO_CMD "/usr/bin/pdfinfo"
-#define TEMP_FILE_TEMPLATE "/tmp/pdf_extract_XXXXXX"
-#define MAX_COMMAND_LENGTH 1024
+#define HELPER_READ_CHUNK (64 * 1024)
+
+extern char **environ;
 
 /*
  * Internal Helper Functions
@@ -54,76 +63,142 @@ static int file_exists(const char *filepath) {
     return (stat(filepath, &st) == 0);
 }
 
-/* Read entire file into memory */
-static char* read_file_to_string(const char *filepath, size_t *out_size) {
-    FILE *file;
-    char *buffer;
-    size_t file_size;
-    size_t bytes_read;
-
-    file = fopen(filepath, "rb");
+/* Check the "%PDF" magic number */
+static int has_pdf_magic(const char *filepath) {
+    char magic[4];
+    FILE *file = fopen(filepath, "rb");
     if (!file) {
-        fprintf(stderr, "pdf: Failed to open file: %s\n", filepath);
-        return NULL;
+        return 0;
     }
 
-    /* Get file size */
-    fseek(file, 0, SEEK_END);
-    file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
+    size_t read = fread(magic, 1, sizeof(magic), file);
+    fclose(file);
 
-    /* Check size limit */
-    if (file_size > PDF_MAX_TEXT_SIZE) {
-        fprintf(stderr, "pdf: File too large: %zu bytes (max %d)\n",
-                file_size, PDF_MAX_TEXT_SIZE);
-        fclose(file);
-        return NULL;
-    }
+    return read == sizeof(magic) && memcmp(magic, "%PDF", 4) == 0;
+}
 
-    /* Allocate buffer */
-    buffer = malloc(file_size + 1);
-    if (!buffer) {
-        fprintf(stderr, "pdf: Out of memory allocating %zu bytes\n", file_size);
-        fclose(file);
+/*
+ * Run a helper program and collect its standard output
+ * The program is started directly with posix_spawn() (no shell), its stdout
+ * is a pipe read into a growing buffer, and its stderr goes to /dev/null.
+ * Returns the null-terminated output (caller frees), or NULL if the program
+ * could not run, failed, or printed more than PDF_MAX_TEXT_SIZE bytes.
+ */
+static char* run_helper(char *const argv[], size_t *out_size) {
+    posix_spawn_file_actions_t actions;
+    int pipe_fds[2];
+    pid_t pid;
+
+    /* Close-on-exec from the start, so helpers spawned by other scan
+     * workers meanwhile never inherit the write end */
+    if (pipe2(pipe_fds, O_CLOEXEC) != 0) {
+        fprintf(stderr, "pdf: pipe failed: %s\n", strerror(errno));
         return NULL;
     }
 
-    /* Read file */
-    bytes_read = fread(buffer, 1, file_size, file);
-    fclose(file);
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, pipe_fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
 
-    if (bytes_read != file_size) {
-        fprintf(stderr, "pdf: Read error: expected %zu bytes, got %zu\n",
-                file_size, bytes_read);
-        free(buffer);
+    int spawn_error = posix_spawn(&pid, argv[0], &actions, NULL, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(pipe_fds[1]);
+
+    if (spawn_error != 0) {
+        fprintf(stderr, "pdf: Failed to run %s: %s\n", argv[0], strerror(spawn_error));
+        close(pipe_fds[0]);
         return NULL;
     }
 
-    /* Null-terminate */
-    buffer[file_size] = '\0';
-    if (out_size) {
-        *out_size = file_size;
+    /* Drain the pipe until the helper closes it */
+    char *buffer = NULL;
+    size_t size = 0;
+    size_t capacity = 0;
+    int failed = 0;
+
+    for (;;) {
+        if (capacity - size < HELPER_READ_CHUNK) {
+            size_t new_capacity = capacity ? capacity * 2 : HELPER_READ_CHUNK + 1;
+            char *grown = realloc(buffer, new_capacity);
+            if (!grown) {
+                failed = 1;
+                break;
+            }
+            buffer = grown;
+            capacity = new_capacity;
+        }
+
+        ssize_t n = read(pipe_fds[0], buffer + size, capacity - size - 1);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            failed = (n < 0);
+            break;
+        }
+
+        size += (size_t)n;
+        if (size > PDF_MAX_TEXT_SIZE) {
+            fprintf(stderr, "pdf: Output of %s too large (max %d)\n", argv[0], PDF_MAX_TEXT_SIZE);
+            failed = 1;
+            break;
+        }
     }
 
-    return buffer;
-}
+    /* An early stop leaves the helper to die of SIGPIPE */
+    close(pipe_fds[0]);
 
-/* Execute command and return exit code */
-static int execute_command(const char *command) {
     int status;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+            status = -1;
+            break;
+        }
+    }
 
-    status = system(command);
-
-    if (status == -1) {
-        fprintf(stderr, "pdf: Failed to execute command\n");
-        return -1;
+    if (failed || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        free(buffer);
+        return NULL;
     }
 
-    if (WIFEXITED(status)) {
-        return WEXITSTATUS(status);
+    buffer[size] = '\0';
+    if (out_size) {
+        *out_size = size;
     }
+    return buffer;
+}
 
-    return -1;
+/* Run pdfinfo on a file; its output holds the metadata and the page count */
+static char* run_pdfinfo(const char *filepath) {
+    char *argv[] = { PDFINFO_CMD, (char *)filepath, NULL };
+    return run_helper(argv, NULL);
+}
+
+/* Run pdftotext on pages first..last (0 for the whole document), text to stdout */
+static char* run_pdftotext(const char *filepath, int first, int last, int page_breaks,
+                           size_t *out_size) {
+    char first_arg[16], last_arg[16];
+    char *argv[12];
+    int argc = 0;
+
+    argv[argc++] = PDFTOTEXT_CMD;
+    if (first > 0) {
+        snprintf(first_arg, sizeof(first_arg), "%d", first);
+        snprintf(last_arg, sizeof(last_arg), "%d", last);
+        argv[argc++] = "-f";
+        argv[argc++] = first_arg;
+        argv[argc++] = "-l";
+        argv[argc++] = last_arg;
+    }
+    if (!page_breaks) {
+        argv[argc++] = "-nopgbrk";
+    }
+    argv[argc++] = "-q";
+    argv[argc++] = (char *)filepath;
+    argv[argc++] = "-";
+    argv[argc] = NULL;
+
+    return run_helper(argv, out_size);
 }
 
 /* Parse pdfinfo output for metadata */
@@ -193,14 +268,85 @@ static int parse_page_count(const char *output) {
     return page_count;
 }
 
+/* Store a page's text, cut only if it outgrows the span; takes ownership of text */
+static int store_page_text(const pdf_document_t *doc, pdf_page_t *page, char *text, size_t length) {
+    if (length > doc->page_span) {
+        /* Cut at the last line break that fits, else at a character boundary */
+        size_t cut = doc->page_span;
+        while (cut > 0 && text[cut - 1] != '\n') {
+            cut--;
+        }
+        if (cut == 0) {
+            cut = doc->page_span;
+            while (cut > doc->page_span - 3 && utf8_is_continuation(text[cut])) {
+                cut--;
+            }
+        }
+        fprintf(stderr, "pdf: Text of page %d cut short to %zu bytes\n", page->page_number, cut);
+        length = cut;
+    }
+
+    char *stored = realloc(text, length + 1);
+    if (!stored) {
+        free(text);
+        return PDF_ERROR_OUT_OF_MEMORY;
+    }
+    stored[length] = '\0';
+
+    page->text = stored;
+    page->text_length = length;
+    return PDF_SUCCESS;
+}
+
+/* Concatenate the text of all pages with the native extractor (NULL if a page fails) */
+static char* extract_native_text(pdf_document_t *doc, size_t *out_size) {
+    size_t size = 0, capacity = HELPER_READ_CHUNK;
+    char *text = malloc(capacity);
+
+    for (int i = 0; text && i < doc->page_count; i++) {
+        char *page_text = doc->pages[i].text;
+        size_t length = doc->pages[i].text_length;
+
+        if (!page_text && pdf_native_page_text((pdf_native_t *)doc->native, i, &page_text,
+                                               &length) != PDF_SUCCESS) {
+            free(text);
+            return NULL;
+        }
+
+        if (size + length + 1 > PDF_MAX_TEXT_SIZE) {
+            length = 0;  /* Keep what fits */
+        }
+        if (size + length + 1 > capacity) {
+            while (size + length + 1 > capacity) {
+                capacity *= 2;
+            }
+            char *grown = realloc(text, capacity);
+            if (!grown) {
+                free(text);
+            }
+            text = grown;
+        }
+        if (text) {
+            memcpy(text + size, page_text, length);
+            size += length;
+        }
+        if (page_text != doc->pages[i].text) {
+            free(page_text);
+        }
+    }
+
+    if (text) {
+        text[size] = '\0';
+        *out_size = size;
+    }
+    return text;
+}
+
 /*
  * Public API Functions
  */
 
 int pdf_validate(const char *filepath) {
-    char command[MAX_COMMAND_LENGTH];
-    int result;
-
     if (!filepath) {
         return PDF_ERROR_NOT_FOUND;
     }
@@ -211,69 +357,47 @@ int pdf_validate(const char *filepath) {
     }
 
     /* Check if file has PDF magic number */
-    FILE *file = fopen(filepath, "rb");
-    if (!file) {
-        return PDF_ERROR_NOT_FOUND;
+    if (!has_pdf_magic(filepath)) {
+        return PDF_ERROR_INVALID_FORMAT;
     }
 
-    char magic[5] = {0};
-    size_t read = fread(magic, 1, 4, file);
-    fclose(file);
-
-    if (read != 4 || memcmp(magic, "%PDF", 4) != 0) {
-        return PDF_ERROR_INVALID_FORMAT;
+    /* Readable natively: no need to start pdfinfo */
+    pdf_native_t *native = pdf_native_open(filepath);
+    if (native) {
+        pdf_native_close(native);
+        return PDF_SUCCESS;
     }
 
     /* Try to get info (validates PDF structure) */
-    snprintf(command, sizeof(command), "%s \"%s\" > /dev/null 2>&1",
-             PDFINFO_CMD, filepath);
-
-    result = execute_command(command);
-
-    if (result != 0) {
+    char *output = run_pdfinfo(filepath);
+    if (!output) {
         return PDF_ERROR_CORRUPT_FILE;
     }
+    free(output);
 
     return PDF_SUCCESS;
 }
 
 int pdf_extract_metadata(const char *filepath, pdf_metadata_t *metadata) {
-    char command[MAX_COMMAND_LENGTH];
-    char temp_file[] = TEMP_FILE_TEMPLATE;
-    int fd;
     char *output;
-    size_t output_size;
     int result;
 
     if (!filepath || !metadata) {
         return PDF_ERROR_NOT_FOUND;
     }
 
-    /* Create temporary file */
-    fd = mkstemp(temp_file);
-    if (fd == -1) {
-        fprintf(stderr, "pdf: Failed to create temporary file\n");
-        return PDF_ERROR_READ_FAILED;
+    /* Info dictionary, read natively */
+    pdf_native_t *native = pdf_native_open(filepath);
+    if (native) {
+        pdf_native_metadata(native, metadata);
+        pdf_native_close(native);
+        return PDF_SUCCESS;
     }
-    close(fd);
 
     /* Run pdfinfo */
-    snprintf(command, sizeof(command), "%s \"%s\" > \"%s\" 2>/dev/null",
-             PDFINFO_CMD, filepath, temp_file);
-
-    result = execute_command(command);
-
-    if (result != 0) {
-        unlink(temp_file);
-        return PDF_ERROR_EXTRACTION_FAILED;
-    }
-
-    /* Read output */
-    output = read_file_to_string(temp_file, &output_size);
-    unlink(temp_file);
-
+    output = run_pdfinfo(filepath);
     if (!output) {
-        return PDF_ERROR_READ_FAILED;
+        return PDF_ERROR_EXTRACTION_FAILED;
     }
 
     /* Parse metadata */
@@ -285,12 +409,8 @@ int pdf_extract_metadata(const char *filepath, pdf_metadata_t *metadata) {
 
 pdf_document_t* pdf_open(const char *filepath) {
     pdf_document_t *doc;
-    char command[MAX_COMMAND_LENGTH];
-    char temp_file[] = TEMP_FILE_TEMPLATE;
-    int fd;
-    char *output;
-    size_t output_size;
-    int result;
+    pdf_native_t *native;
+    char *output = NULL;
     int page_count;
 
     if (!filepath) {
@@ -298,70 +418,68 @@ pdf_document_t* pdf_open(const char *filepath) {
         return NULL;
     }
 
-    /* Validate PDF */
-    result = pdf_validate(filepath);
-    if (result != PDF_SUCCESS) {
-        fprintf(stderr, "pdf: Validation failed: %s\n", pdf_error_string(result));
+    /* Cheap checks first; the native parser or pdfinfo below validates the structure */
+    if (!file_exists(filepath) || !has_pdf_magic(filepath)) {
+        fprintf(stderr, "pdf: Validation failed: %s\n",
+                pdf_error_string(file_exists(filepath) ? PDF_ERROR_INVALID_FORMAT
+                                                       : PDF_ERROR_NOT_FOUND));
         return NULL;
     }
 
+    /* Parse the file in-process; otherwise one pdfinfo run gives the metadata and page count */
+    native = pdf_native_open(filepath);
+    if (!native) {
+        output = run_pdfinfo(filepath);
+        if (!output) {
+            fprintf(stderr, "pdf: Validation failed: %s\n", pdf_error_string(PDF_ERROR_CORRUPT_FILE));
+            return NULL;
+        }
+    }
+
     /* Allocate document structure */
     doc = calloc(1, sizeof(pdf_document_t));
     if (!doc) {
         fprintf(stderr, "pdf: Out of memory\n");
+        pdf_native_close(native);
+        free(output);
         return NULL;
     }
 
     /* Copy filepath */
     strncpy(doc->filepath, filepath, sizeof(doc->filepath) - 1);
 
-    /* Extract metadata */
-    pdf_extract_metadata(filepath, &doc->metadata);
-
-    /* Get page count */
-    fd = mkstemp(temp_file);
-    if (fd == -1) {
-        fprintf(stderr, "pdf: Failed to create temporary file\n");
-        free(doc);
-        return NULL;
-    }
-    close(fd);
-
-    snprintf(command, sizeof(command), "%s \"%s\" > \"%s\" 2>/dev/null",
-             PDFINFO_CMD, filepath, temp_file);
-
-    result = execute_command(command);
-
-    if (result != 0) {
-        unlink(temp_file);
-        free(doc);
-        fprintf(stderr, "pdf: Failed to get page count\n");
-        return NULL;
+    /* Extract metadata and page count */
+    if (native) {
+        doc->native = native;
+        pdf_native_metadata(native, &doc->metadata);
+        page_count = pdf_native_page_count(native);
+    } else {
+        parse_pdfinfo_output(output, &doc->metadata);
+        page_count = parse_page_count(output);
+        free(output);
     }
 
-    output = read_file_to_string(temp_file, &output_size);
-    unlink(temp_file);
-
-    if (!output) {
-        free(doc);
-        return NULL;
-    }
-
-    page_count = parse_page_count(output);
-    free(output);
-
     if (page_count <= 0 || page_count > PDF_MAX_PAGES) {
         fprintf(stderr, "pdf: Invalid page count: %d\n", page_count);
+        pdf_native_close(native);
         free(doc);
         return NULL;
     }
 
     doc->page_count = page_count;
 
+    /* The widest span all pages fit in: a page's text is only cut past it */
+    size_t span = PDF_TEXT_SPACE / (size_t)page_count;
+    if (span > PDF_MAX_TEXT_SIZE) {
+        span = PDF_MAX_TEXT_SIZE;
+    }
+    doc->page_span = span - span % PDF_PAGE_SPAN;
+
     /* Allocate pages array */
     doc->pages = calloc(page_count, sizeof(pdf_page_t));
     if (!doc->pages) {
         fprintf(stderr, "pdf: Out of memory allocating pages\n");
+        pdf_native_close(native);
         free(doc);
         return NULL;
     }
@@ -370,6 +488,8 @@ pdf_document_t* pdf_open(const char *filepath) {
     for (int i = 0; i < page_count; i++) {
         doc->pages[i].page_number = i + 1;
     }
+    doc->window_page = -1;
+    doc->window_direction = 1;
 
     return doc;
 }
@@ -387,8 +507,14 @@ void pdf_close(pdf_document_t *doc) {
         free(doc->pages);
     }
 
-    /* Free full text */
-    free(doc->full_text);
+    /* Free full text, or unmap it if it came from the text cache */
+    if (doc->text_cache) {
+        text_cache_close((text_cache_t *)doc->text_cache);
+    } else {
+        free(doc->full_text);
+    }
+
+    pdf_native_close((pdf_native_t *)doc->native);
 
     /* Free document */
     free(doc);
@@ -403,12 +529,8 @@ int pdf_get_page_count(pdf_document_t *doc) {
 }
 
 int pdf_extract_page(pdf_document_t *doc, int page_number) {
-    char command[MAX_COMMAND_LENGTH];
-    char temp_file[] = TEMP_FILE_TEMPLATE;
-    int fd;
     char *text;
     size_t text_size;
-    int result;
 
     if (!doc) {
         return PDF_ERROR_NOT_FOUND;
@@ -427,50 +549,104 @@ int pdf_extract_page(pdf_document_t *doc, int page_number) {
         return PDF_SUCCESS;
     }
 
-    /* Create temporary file */
-    fd = mkstemp(temp_file);
-    if (fd == -1) {
-        fprintf(stderr, "pdf: Failed to create temporary file\n");
-        return PDF_ERROR_READ_FAILED;
+    /* In-process; pages it cannot read go to pdftotext */
+    if (doc->native &&
+        pdf_native_page_text((pdf_native_t *)doc->native, page_index, &text, &text_size) == PDF_SUCCESS) {
+        return store_page_text(doc, &doc->pages[page_index], text, text_size);
     }
-    close(fd);
-
-    /* Extract single page using pdftotext */
-    snprintf(command, sizeof(command),
-             "%s -f %d -l %d -nopgbrk -q \"%s\" \"%s\" 2>/dev/null",
-             PDFTOTEXT_CMD, page_number, page_number,
-             doc->filepath, temp_file);
 
-    result = execute_command(command);
+    /* Take the following pages in the same pdftotext run, up to one already extracted */
+    int last_page = page_number;
+    while (last_page < doc->page_count && last_page - page_number + 1 < PDF_PAGE_BATCH &&
+           !doc->pages[last_page].text) {
+        last_page++;
+    }
 
-    if (result != 0) {
-        unlink(temp_file);
+    /* Extract with page breaks: pdftotext ends every page with '\f' */
+    text = run_pdftotext(doc->filepath, page_number, last_page, 1, &text_size);
+    if (!text) {
         fprintf(stderr, "pdf: Text extraction failed for page %d\n", page_number);
         return PDF_ERROR_EXTRACTION_FAILED;
     }
 
-    /* Read extracted text */
-    text = read_file_to_string(temp_file, &text_size);
-    unlink(temp_file);
+    /* Store each page's text in its page structure */
+    const char *segment = text;
+    const char *text_end = text + text_size;
+    for (int page = page_number; page <= last_page && segment <= text_end; page++) {
+        const char *brk = memchr(segment, '\f', text_end - segment);
+        size_t length = brk ? (size_t)(brk - segment) : (size_t)(text_end - segment);
 
-    if (!text) {
-        return PDF_ERROR_READ_FAILED;
+        char *page_text = malloc(length + 1);
+        if (!page_text) {
+            break;
+        }
+        memcpy(page_text, segment, length);
+        if (store_page_text(doc, &doc->pages[page - 1], page_text, length) != PDF_SUCCESS) {
+            break;
+        }
+        segment += length + 1;
+    }
+    free(text);
+
+    return doc->pages[page_index].text ? PDF_SUCCESS : PDF_ERROR_OUT_OF_MEMORY;
+}
+
+int pdf_load_page(pdf_document_t *doc, int page_number) {
+    if (!doc) {
+        return PDF_ERROR_NOT_FOUND;
+    }
+
+    int result = pdf_extract_page(doc, page_number);
+    if (result != PDF_SUCCESS) {
+        return result;
+    }
+
+    int current = page_number - 1;
+    if (doc->window_page >= 0 && current != doc->window_page) {
+        doc->window_direction = current > doc->window_page ? 1 : -1;
+    }
+    doc->window_page = current;
+
+    /* Prefetch: the next pages in the reading direction (failures wait until they are read) */
+    for (int i = 1; i <= PDF_PAGE_PREFETCH; i++) {
+        int page = current + i * doc->window_direction;
+        if (page < 0 || page >= doc->page_count) {
+            break;
+        }
+        if (!doc->pages[page].text) {
+            pdf_extract_page(doc, page + 1);
+        }
     }
 
-    /* Store in page structure */
-    doc->pages[page_index].text = text;
-    doc->pages[page_index].text_length = text_size;
+    /* Evict: the page farthest from the current one, counting pages behind as twice as far */
+    for (;;) {
+        int loaded = 0, victim = -1, victim_distance = 0;
+        for (int i = 0; i < doc->page_count; i++) {
+            if (!doc->pages[i].text) {
+                continue;
+            }
+            loaded++;
+            int ahead = (i - current) * doc->window_direction;
+            int distance = ahead >= 0 ? ahead : -2 * ahead;
+            if (distance > victim_distance) {
+                victim = i;
+                victim_distance = distance;
+            }
+        }
+        if (loaded <= PDF_PAGE_WINDOW || victim < 0) {
+            break;
+        }
+        free(doc->pages[victim].text);
+        doc->pages[victim].text = NULL;
+        doc->pages[victim].text_length = 0;
+    }
 
     return PDF_SUCCESS;
 }
 
 int pdf_extract_text(pdf_document_t *doc) {
-    char command[MAX_COMMAND_LENGTH];
-    char temp_file[] = TEMP_FILE_TEMPLATE;
-    int fd;
     char *text;
     size_t text_size;
-    int result;
 
     if (!doc) {
         return PDF_ERROR_NOT_FOUND;
@@ -481,35 +657,27 @@ int pdf_extract_text(pdf_document_t *doc) {
         return PDF_SUCCESS;
     }
 
-    /* Create temporary file */
-    fd = mkstemp(temp_file);
-    if (fd == -1) {
-        fprintf(stderr, "pdf: Failed to create temporary file\n");
-        return PDF_ERROR_READ_FAILED;
+    /* Extracted on an earlier open: map it instead of running pdftotext */
+    text_cache_t *cache = text_cache_open(doc->filepath);
+    const char *cached = text_cache_text(cache, &text_size);
+    if (cached && text_size > 0) {
+        doc->full_text = (char *)cached;
+        doc->full_text_length = text_size;
+        doc->text_cache = cache;
+        return PDF_SUCCESS;
     }
-    close(fd);
-
-    /* Extract all pages using pdftotext */
-    /* -nopgbrk: Don't insert page breaks between pages */
-    /* -q: Quiet mode (no messages) */
-    snprintf(command, sizeof(command),
-             "%s -nopgbrk -q \"%s\" \"%s\" 2>/dev/null",
-             PDFTOTEXT_CMD, doc->filepath, temp_file);
+    text_cache_close(cache);
 
-    result = execute_command(command);
+    /* All pages natively, each ending in a newline; any page it cannot read means pdftotext */
+    text = doc->native ? extract_native_text(doc, &text_size) : NULL;
 
-    if (result != 0) {
-        unlink(temp_file);
-        fprintf(stderr, "pdf: Text extraction failed\n");
-        return PDF_ERROR_EXTRACTION_FAILED;
+    /* Extract all pages using pdftotext, without page breaks */
+    if (!text) {
+        text = run_pdftotext(doc->filepath, 0, 0, 0, &text_size);
     }
-
-    /* Read extracted text */
-    text = read_file_to_string(temp_file, &text_size);
-    unlink(temp_file);
-
     if (!text) {
-        return PDF_ERROR_READ_FAILED;
+        fprintf(stderr, "pdf: Text extraction failed\n");
+        return PDF_ERROR_EXTRACTION_FAILED;
     }
 
     /* Check for empty content */
@@ -518,9 +686,10 @@ int pdf_extract_text(pdf_document_t *doc) {
         return PDF_ERROR_NO_CONTENT;
     }
 
-    /* Store in document */
+    /* Store in document, and in the text cache for next time */
     doc->full_text = text;
     doc->full_text_length = text_size;
+    text_cache_store(doc->filepath, text, text_size);
 
     return PDF_SUCCESS;
 }
@@ -689,6 +858,49 @@ static int pdf_interface_get_page_count(format_handle_t handle) {
     return doc->page_count;
 }
 
+static int pdf_interface_get_length(format_handle_t handle, size_t *out_length) {
+    pdf_document_t *doc = (pdf_document_t*)handle;
+
+    if (!doc || !out_length) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    *out_length = (size_t)doc->page_count * doc->page_span;
+    return FORMAT_SUCCESS;
+}
+
+/* A page's text is one chunk and the rest of its span a blank one, extracted through the page window */
+static int pdf_interface_chunk_at(format_handle_t handle, size_t offset, format_chunk_t *chunk) {
+    pdf_document_t *doc = (pdf_document_t*)handle;
+
+    if (!doc || !chunk) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    size_t index = offset / doc->page_span;
+    if (index >= (size_t)doc->page_count) {
+        return FORMAT_ERROR_NO_CONTENT;
+    }
+
+    int result = pdf_load_page(doc, (int)index + 1);
+    if (result != PDF_SUCCESS) {
+        return pdf_to_format_error(result);
+    }
+
+    const pdf_page_t *page = &doc->pages[index];
+    size_t start = index * doc->page_span;
+    if (offset - start < page->text_length) {
+        chunk->text = page->text;
+        chunk->offset = start;
+        chunk->length = page->text_length;
+    } else {
+        chunk->text = NULL;
+        chunk->offset = start + page->text_length;
+        chunk->length = doc->page_span - page->text_length;
+    }
+    return FORMAT_SUCCESS;
+}
+
 /*
  * Format Interface Definition
  */
@@ -702,5 +914,7 @@ const book_format_interface_t pdf_format_interface = {
     .extract_text = pdf_interface_extract_text,
     .get_text = pdf_interface_get_text,
     .get_metadata = pdf_interface_get_metadata,
-    .get_page_count = pdf_interface_get_page_count
+    .get_page_count = pdf_interface_get_page_count,
+    .get_length = pdf_interface_get_length,
+    .chunk_at = pdf_interface_chunk_at
 };
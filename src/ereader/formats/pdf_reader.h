@@ -38,6 +38,11 @@
 #define PDF_MAX_PATH_LENGTH 512
 #define PDF_MAX_TEXT_SIZE (50 * 1024 * 1024)  /* 50MB max extracted text */
 #define PDF_MAX_PAGES 10000
+#define PDF_PAGE_BATCH 16                     /* Pages pdftotext extracts per run in pdf_extract_page() */
+#define PDF_PAGE_SPAN (16 * 1024)             /* Unit of the book text reserved for each page */
+#define PDF_TEXT_SPACE (1 << 30)              /* Book text offsets all pages' spans share */
+#define PDF_PAGE_WINDOW (PDF_PAGE_BATCH + 8)  /* Extracted pages kept around the reading position */
+#define PDF_PAGE_PREFETCH 2                   /* Pages extracted ahead in the reading direction */
 
 /*
  * Error Codes
@@ -58,10 +63,15 @@ typedef enum {
 /*
  * PDF Page Structure
  * Represents a single page in the PDF
+ *
+ * Page i owns page_span bytes of the book text, starting at
+ * i * page_span, so the page holding any offset is known without
+ * extracting the pages before it. The span is as large as the document's
+ * page count allows; the room a page's text leaves in it is blank.
  */
 typedef struct {
     int page_number;                   /* Page number (1-indexed) */
-    char *text;                        /* Extracted plain text (NULL until extracted) */
+    char *text;                        /* Extracted text (NULL until extracted) */
     size_t text_length;                /* Length of extracted text */
 } pdf_page_t;
 
@@ -85,8 +95,13 @@ typedef struct {
     pdf_metadata_t metadata;            /* Document metadata */
     pdf_page_t *pages;                  /* Array of pages (lazy loaded) */
     int page_count;                     /* Number of pages */
+    size_t page_span;                   /* Bytes of book text each page owns */
     char *full_text;                    /* All extracted text concatenated */
     size_t full_text_length;            /* Total text length */
+    void *text_cache;                   /* Internal: text_cache_t full_text is mapped from (or NULL) */
+    void *native;                       /* Internal: pdf_native_t pages are read with (NULL: pdftotext) */
+    int window_page;                    /* Page the window was last moved to (0-based, -1 if none) */
+    int window_direction;               /* Reading direction: 1 forwards, -1 backwards */
 } pdf_document_t;
 
 /*
@@ -126,10 +141,25 @@ int pdf_get_page_count(pdf_document_t *doc);
  * @param doc: PDF document structure
  * @param page_number: Page number (1-indexed)
  * @return: PDF_SUCCESS on success, error code on failure
- * @note: Text stored in doc->pages[page_number-1].text
+ * @note: Text stored in doc->pages[page_number-1].text, at most
+ *        doc->page_span bytes. Read in-process by
+ *        pdf_native.c when it can; otherwise the pages after it, up to
+ *        PDF_PAGE_BATCH in all, are extracted by the same pdftotext run
  */
 int pdf_extract_page(pdf_document_t *doc, int page_number);
 
+/**
+ * Move the page window to a page
+ * Extracts the page if needed, then up to PDF_PAGE_PREFETCH pages after it
+ * in the reading direction (from the previous call), and frees extracted
+ * pages once more than PDF_PAGE_WINDOW are held, those behind the reading
+ * direction first.
+ * @param doc: PDF document structure
+ * @param page_number: Page number (1-indexed)
+ * @return: PDF_SUCCESS on success, error code on failure
+ */
+int pdf_load_page(pdf_document_t *doc, int page_number);
+
 /**
  * Extract all text from PDF document
  * Extracts text from all pages and concatenates into doc->full_text
@@ -175,7 +205,7 @@ const char* pdf_error_string(pdf_error_t error);
 int pdf_is_pdf_file(const char *filename);
 
 /**
- * Extract metadata from PDF using pdfinfo
+ * Extract metadata from PDF (Info dictionary, or pdfinfo as a fallback)
  * @param filepath: Path to PDF file
  * @param metadata: Output metadata structure
  * @return: PDF_SUCCESS on success, error code on failure
@@ -0,0 +1,455 @@
+/*
+ * text_cache.c - Persistent Extracted-Text Cache
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include "text_cache.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define CACHE_MAGIC     "ERTXTCAC"
+#define CACHE_VERSION   1
+#define CACHE_SUFFIX    ".cache"
+#define CACHE_PATH_MAX  512
+
+/*
+ * On-Disk Layout (native byte order; the cache never leaves the device)
+ */
+
+typedef struct {
+    char magic[8];                     /* CACHE_MAGIC */
+    uint32_t version;                  /* CACHE_VERSION */
+    uint32_t chunk_count;
+    uint64_t source_size;              /* Book file size when cached */
+    int64_t source_mtime;              /* Book file mtime when cached */
+    int64_t source_mtime_nsec;
+    uint64_t text_length;              /* Sum of chunk lengths */
+    uint64_t reserved;
+    char source_path[CACHE_PATH_MAX];  /* Book path (tells hash collisions apart) */
+} cache_header_t;
+
+typedef struct {
+    uint64_t offset;                   /* Offset in the text */
+    uint64_t length;                   /* Chunk length */
+    uint64_t used;                     /* Bytes of real text (the rest is padding) */
+    uint32_t filled;                   /* Text has been written */
+    uint32_t reserved;
+} cache_chunk_t;
+
+struct text_cache {
+    int fd;
+    char *map;                         /* Whole file, read-only */
+    size_t map_size;
+    const cache_header_t *header;
+    const cache_chunk_t *chunks;
+    const char *text;
+    int dirty;                         /* Written since opened */
+};
+
+/*
+ * Internal Helpers
+ */
+
+/* Cache file of a book: a hash of its path under TEXT_CACHE_DIR */
+static void cache_file_path(const char *source_path, char *out, size_t out_size) {
+    uint64_t h = 14695981039346656037ULL;
+    for (const unsigned char *p = (const unsigned char *)source_path; *p; p++) {
+        h ^= *p;
+        h *= 1099511628211ULL;
+    }
+    snprintf(out, out_size, "%s/%016llx%s", TEXT_CACHE_DIR, (unsigned long long)h, CACHE_SUFFIX);
+}
+
+/* Create TEXT_CACHE_DIR and any missing parents */
+static int cache_make_dir(void) {
+    char path[CACHE_PATH_MAX];
+
+    strncpy(path, TEXT_CACHE_DIR, sizeof(path) - 1);
+    path[sizeof(path) - 1] = '\0';
+
+    for (char *p = path + 1; ; p++) {
+        if (*p == '/' || *p == '\0') {
+            char saved = *p;
+            *p = '\0';
+            if (mkdir(path, 0755) != 0 && errno != EEXIST) {
+                return -1;
+            }
+            *p = saved;
+            if (saved == '\0') {
+                break;
+            }
+        }
+    }
+    return 0;
+}
+
+static int write_all(int fd, const void *data, size_t length, off_t offset) {
+    const char *p = data;
+    while (length > 0) {
+        ssize_t n = pwrite(fd, p, length, offset);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        p += n;
+        length -= (size_t)n;
+        offset += n;
+    }
+    return 0;
+}
+
+static size_t cache_text_start(uint32_t chunk_count) {
+    return sizeof(cache_header_t) + (size_t)chunk_count * sizeof(cache_chunk_t);
+}
+
+/* Map an open cache file and check that its layout is sound */
+static text_cache_t* cache_map(int fd) {
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(cache_header_t)) {
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    char *map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+
+    const cache_header_t *header = (const cache_header_t *)map;
+    int valid = memcmp(header->magic, CACHE_MAGIC, sizeof(header->magic)) == 0 &&
+                header->version == CACHE_VERSION &&
+                header->chunk_count > 0 && header->chunk_count <= TEXT_CACHE_MAX_CHUNKS &&
+                header->text_length < size &&
+                cache_text_start(header->chunk_count) + header->text_length + 1 == size;
+
+    const cache_chunk_t *chunks = (const cache_chunk_t *)(map + sizeof(cache_header_t));
+    uint64_t offset = 0;
+    for (uint32_t i = 0; valid && i < header->chunk_count; i++) {
+        valid = chunks[i].offset == offset && chunks[i].used <= chunks[i].length;
+        offset += chunks[i].length;
+    }
+    if (!valid || offset != header->text_length) {
+        munmap(map, size);
+        return NULL;
+    }
+
+    text_cache_t *cache = calloc(1, sizeof(text_cache_t));
+    if (!cache) {
+        munmap(map, size);
+        return NULL;
+    }
+    cache->fd = fd;
+    cache->map = map;
+    cache->map_size = size;
+    cache->header = header;
+    cache->chunks = chunks;
+    cache->text = map + cache_text_start(header->chunk_count);
+    return cache;
+}
+
+typedef struct {
+    char name[64];
+    off_t size;
+    time_t mtime;
+} cache_file_t;
+
+static int compare_cache_age(const void *a, const void *b) {
+    time_t ta = ((const cache_file_t *)a)->mtime;
+    time_t tb = ((const cache_file_t *)b)->mtime;
+    return (ta > tb) - (ta < tb);
+}
+
+/* Delete least recently opened entries until incoming more bytes fit the budget */
+static void cache_evict(const char *replacing, size_t incoming) {
+    DIR *dir = opendir(TEXT_CACHE_DIR);
+    if (!dir) {
+        return;
+    }
+
+    const char *replacing_name = strrchr(replacing, '/');
+    replacing_name = replacing_name ? replacing_name + 1 : replacing;
+
+    cache_file_t *files = NULL;
+    int count = 0, capacity = 0;
+    uint64_t total = 0;
+    struct dirent *entry;
+
+    while ((entry = readdir(dir)) != NULL) {
+        size_t len = strlen(entry->d_name);
+        if (len <= strlen(CACHE_SUFFIX) || len >= sizeof(files[0].name) ||
+            strcmp(entry->d_name + len - strlen(CACHE_SUFFIX), CACHE_SUFFIX) != 0 ||
+            strcmp(entry->d_name, replacing_name) == 0) {
+            continue;
+        }
+
+        char path[CACHE_PATH_MAX + 64];
+        struct stat st;
+        snprintf(path, sizeof(path), "%s/%s", TEXT_CACHE_DIR, entry->d_name);
+        if (stat(path, &st) != 0) {
+            continue;
+        }
+
+        if (count == capacity) {
+            int new_capacity = capacity ? capacity * 2 : 32;
+            cache_file_t *grown = realloc(files, new_capacity * sizeof(cache_file_t));
+            if (!grown) {
+                break;
+            }
+            files = grown;
+            capacity = new_capacity;
+        }
+        strcpy(files[count].name, entry->d_name);
+        files[count].size = st.st_size;
+        files[count].mtime = st.st_mtime;
+        total += (uint64_t)st.st_size;
+        count++;
+    }
+    closedir(dir);
+
+    if (count > 1) {
+        qsort(files, count, sizeof(cache_file_t), compare_cache_age);
+    }
+    for (int i = 0; i < count && total + incoming > TEXT_CACHE_BUDGET; i++) {
+        char path[CACHE_PATH_MAX + 64];
+        snprintf(path, sizeof(path), "%s/%s", TEXT_CACHE_DIR, files[i].name);
+        if (unlink(path) == 0) {
+            total -= (uint64_t)files[i].size;
+        }
+    }
+
+    free(files);
+}
+
+/*
+ * Public API
+ */
+
+text_cache_t* text_cache_open(const char *source_path) {
+    char path[CACHE_PATH_MAX + 64];
+    struct stat src;
+
+    if (!source_path || stat(source_path, &src) != 0) {
+        return NULL;
+    }
+
+    cache_file_path(source_path, path, sizeof(path));
+    int fd = open(path, O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    text_cache_t *cache = cache_map(fd);
+    if (!cache) {
+        fprintf(stderr, "text_cache: Discarding damaged cache file %s\n", path);
+        close(fd);
+        unlink(path);
+        return NULL;
+    }
+
+    const cache_header_t *header = cache->header;
+    if (header->source_size != (uint64_t)src.st_size ||
+        header->source_mtime != (int64_t)src.st_mtim.tv_sec ||
+        header->source_mtime_nsec != (int64_t)src.st_mtim.tv_nsec ||
+        strncmp(header->source_path, source_path, CACHE_PATH_MAX) != 0) {
+        text_cache_close(cache);
+        return NULL;
+    }
+
+    /* The file mtime is the LRU stamp */
+    futimens(fd, NULL);
+    return cache;
+}
+
+text_cache_t* text_cache_create(const char *source_path, const size_t *chunk_lengths,
+                                int chunk_count) {
+    char path[CACHE_PATH_MAX + 64];
+    char temp_path[CACHE_PATH_MAX + 72];
+    struct stat src;
+    cache_header_t header;
+
+    if (!source_path || !chunk_lengths || chunk_count <= 0 ||
+        chunk_count > TEXT_CACHE_MAX_CHUNKS || strlen(source_path) >= CACHE_PATH_MAX ||
+        stat(source_path, &src) != 0) {
+        return NULL;
+    }
+
+    cache_chunk_t *chunks = calloc(chunk_count, sizeof(cache_chunk_t));
+    if (!chunks) {
+        return NULL;
+    }
+
+    uint64_t text_length = 0;
+    for (int i = 0; i < chunk_count; i++) {
+        chunks[i].offset = text_length;
+        chunks[i].length = chunk_lengths[i];
+        chunks[i].filled = (chunk_lengths[i] == 0);
+        text_length += chunk_lengths[i];
+    }
+
+    /* An entry bigger than the whole budget would only flush everything else */
+    size_t index_size = (size_t)chunk_count * sizeof(cache_chunk_t);
+    uint64_t file_size = sizeof(cache_header_t) + index_size + text_length + 1;
+    if (file_size > TEXT_CACHE_BUDGET || cache_make_dir() != 0) {
+        free(chunks);
+        return NULL;
+    }
+
+    cache_file_path(source_path, path, sizeof(path));
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+    cache_evict(path, (size_t)file_size);
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.version = CACHE_VERSION;
+    header.chunk_count = (uint32_t)chunk_count;
+    header.source_size = (uint64_t)src.st_size;
+    header.source_mtime = (int64_t)src.st_mtim.tv_sec;
+    header.source_mtime_nsec = (int64_t)src.st_mtim.tv_nsec;
+    header.text_length = text_length;
+    strncpy(header.source_path, source_path, CACHE_PATH_MAX - 1);
+
+    /* Build the empty entry aside and rename it over any old one */
+    int fd = open(temp_path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        free(chunks);
+        return NULL;
+    }
+    int ok = write_all(fd, &header, sizeof(header), 0) == 0 &&
+             write_all(fd, chunks, index_size, sizeof(header)) == 0 &&
+             ftruncate(fd, (off_t)file_size) == 0 &&
+             rename(temp_path, path) == 0;
+    free(chunks);
+
+    text_cache_t *cache = ok ? cache_map(fd) : NULL;
+    if (!cache) {
+        fprintf(stderr, "text_cache: Cannot create cache file %s: %s\n", path, strerror(errno));
+        close(fd);
+        unlink(ok ? path : temp_path);
+        return NULL;
+    }
+
+    cache->dirty = 1;
+    return cache;
+}
+
+void text_cache_close(text_cache_t *cache) {
+    if (!cache) {
+        return;
+    }
+
+    /* Make what was written survive a power cut before the next open */
+    if (cache->dirty) {
+        fdatasync(cache->fd);
+    }
+    munmap(cache->map, cache->map_size);
+    close(cache->fd);
+    free(cache);
+}
+
+int text_cache_chunk_count(const text_cache_t *cache) {
+    return cache ? (int)cache->header->chunk_count : 0;
+}
+
+size_t text_cache_chunk_length(const text_cache_t *cache, int index) {
+    if (!cache || index < 0 || index >= (int)cache->header->chunk_count) {
+        return 0;
+    }
+    return (size_t)cache->chunks[index].length;
+}
+
+const char* text_cache_chunk(const text_cache_t *cache, int index, size_t *out_used) {
+    if (!cache || index < 0 || index >= (int)cache->header->chunk_count ||
+        !cache->chunks[index].filled) {
+        return NULL;
+    }
+
+    if (out_used) {
+        *out_used = (size_t)cache->chunks[index].used;
+    }
+    return cache->text + cache->chunks[index].offset;
+}
+
+int text_cache_fill(text_cache_t *cache, int index, const char *text, size_t used) {
+    if (!cache || !text || index < 0 || index >= (int)cache->header->chunk_count) {
+        return -1;
+    }
+
+    const cache_chunk_t *chunk = &cache->chunks[index];
+    if (chunk->filled) {
+        return 0;
+    }
+    if (used > chunk->length) {
+        return -1;
+    }
+
+    /* Text first, then the index entry that vouches for it */
+    cache_chunk_t updated = *chunk;
+    updated.used = used;
+    updated.filled = 1;
+
+    off_t text_pos = (off_t)(cache_text_start(cache->header->chunk_count) + chunk->offset);
+    off_t entry_pos = (off_t)(sizeof(cache_header_t) + (size_t)index * sizeof(cache_chunk_t));
+    cache->dirty = 1;
+    if (write_all(cache->fd, text, (size_t)chunk->length, text_pos) != 0 ||
+        write_all(cache->fd, &updated, sizeof(updated), entry_pos) != 0) {
+        fprintf(stderr, "text_cache: Write failed: %s\n", strerror(errno));
+        return -1;
+    }
+
+    return 0;
+}
+
+const char* text_cache_text(const text_cache_t *cache, size_t *out_length) {
+    if (!cache || !out_length) {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < cache->header->chunk_count; i++) {
+        if (!cache->chunks[i].filled) {
+            return NULL;
+        }
+    }
+
+    *out_length = (size_t)cache->header->text_length;
+    return cache->text;
+}
+
+int text_cache_store(const char *source_path, const char *text, size_t length) {
+    text_cache_t *cache = text_cache_create(source_path, &length, 1);
+    if (!cache) {
+        return -1;
+    }
+
+    int result = text_cache_fill(cache, 0, text, length);
+    text_cache_close(cache);
+    return result;
+}
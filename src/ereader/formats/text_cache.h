@@ -0,0 +1,130 @@
+/*
+ * text_cache.h - Persistent Extracted-Text Cache
+ *
+ * Keeps the plain text extracted from EPUB and PDF books on disk, so that
+ * reopening a book maps the text back in instead of inflating and parsing
+ * it again. Each book gets one cache file:
+ *
+ *   header       magic, version, source path/size/mtime, text length
+ *   chunk index  offset, length and fill state of every chunk
+ *   text         the book text, chunks back to back, then one '\0'
+ *
+ * The file is mapped read-only; chunks are written with pwrite() as they
+ * are extracted, so a book read halfway is cached halfway. Entries are
+ * keyed by source path, size and mtime (a changed book is simply a miss),
+ * and the directory is kept under TEXT_CACHE_BUDGET bytes by deleting the
+ * least recently opened entries.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef TEXT_CACHE_H
+#define TEXT_CACHE_H
+
+#include <stddef.h>
+
+#ifndef TEXT_CACHE_DIR
+#define TEXT_CACHE_DIR      "/etc/ereader/cache"   /* Beside bookmarks.txt */
+#endif
+#ifndef TEXT_CACHE_BUDGET
+#define TEXT_CACHE_BUDGET   (64 * 1024 * 1024)     /* Total size of all cache files */
+#endif
+#define TEXT_CACHE_MAX_CHUNKS 100000
+
+/* Open cache entry (opaque) */
+typedef struct text_cache text_cache_t;
+
+/**
+ * Open the cache entry of a book
+ * @param source_path: Path to the book file
+ * @return: Entry, or NULL if there is none for the book as it is now
+ * @note: Marks the entry as recently used
+ */
+text_cache_t* text_cache_open(const char *source_path);
+
+/**
+ * Start a new, empty cache entry for a book (replacing any old one)
+ * Evicts least recently used entries until the new one fits the budget.
+ * @param source_path: Path to the book file
+ * @param chunk_lengths: Length of each chunk; chunks tile the text in order
+ * @param chunk_count: Number of chunks
+ * @return: Entry, or NULL if it cannot be created (no space, read-only disk)
+ */
+text_cache_t* text_cache_create(const char *source_path, const size_t *chunk_lengths,
+                                int chunk_count);
+
+/**
+ * Close an entry, flushing what was written to it
+ * @param cache: Entry (NULL is ignored)
+ */
+void text_cache_close(text_cache_t *cache);
+
+/**
+ * Get the number of chunks of an entry
+ * @param cache: Entry
+ * @return: Chunk count
+ */
+int text_cache_chunk_count(const text_cache_t *cache);
+
+/**
+ * Get the length of one chunk
+ * @param cache: Entry
+ * @param index: Chunk index
+ * @return: Chunk length in bytes (0 for a bad index)
+ */
+size_t text_cache_chunk_length(const text_cache_t *cache, int index);
+
+/**
+ * Get the text of a filled chunk
+ * @param cache: Entry
+ * @param index: Chunk index
+ * @param out_used: Output bytes of real text at the start of the chunk (may be NULL)
+ * @return: Mapped chunk text (valid until close), or NULL if not filled yet
+ */
+const char* text_cache_chunk(const text_cache_t *cache, int index, size_t *out_used);
+
+/**
+ * Write the text of one chunk
+ * @param cache: Entry
+ * @param index: Chunk index
+ * @param text: Exactly text_cache_chunk_length() bytes
+ * @param used: Bytes of real text at the start of text (the rest is padding)
+ * @return: 0 on success, -1 on failure
+ */
+int text_cache_fill(text_cache_t *cache, int index, const char *text, size_t used);
+
+/**
+ * Get the whole text of a completely filled entry
+ * @param cache: Entry
+ * @param out_length: Output text length in bytes
+ * @return: Mapped text, null-terminated (valid until close), or NULL if any chunk is missing
+ */
+const char* text_cache_text(const text_cache_t *cache, size_t *out_length);
+
+/**
+ * Cache a book's whole text as a single chunk
+ * @param source_path: Path to the book file
+ * @param text: Extracted text
+ * @param length: Text length in bytes
+ * @return: 0 on success, -1 on failure
+ */
+int text_cache_store(const char *source_path, const char *text, size_t length);
+
+#endif /* TEXT_CACHE_H */
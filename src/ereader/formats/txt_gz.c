@@ -0,0 +1,403 @@
+/*
+ * txt_gz.c - Seekable Compressed Plain Text Implementation
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include "txt_gz.h"
+#include "format_interface.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+/*
+ * Index member: 10-byte gzip header, XLEN, subfield header, entries, then
+ * (count, magic) and an empty deflate block with CRC and ISIZE of zero
+ */
+#define INDEX_HEADER_SIZE   (10 + 2 + 4)
+#define INDEX_TAIL_SIZE     (4 + 4 + 2 + 4 + 4)
+
+/* Largest compressed block accepted (deflate can grow incompressible text slightly) */
+#define MAX_BLOCK_COMPRESSED (2 * TXT_GZ_BLOCK_SIZE)
+
+/* Inflated block */
+typedef struct {
+    int block;                 /* Block index, or -1 if the slot is free */
+    unsigned long used;        /* Use counter value at the last access */
+    char *text;                /* TXT_GZ_BLOCK_SIZE bytes */
+} block_slot_t;
+
+struct txt_gz {
+    int fd;
+    int block_count;
+    off_t *file_offsets;       /* block_count + 1 compressed offsets */
+    size_t *text_offsets;      /* block_count + 1 text offsets */
+    unsigned char *input;      /* Compressed block buffer */
+    block_slot_t slots[TXT_GZ_CACHE_BLOCKS];
+    unsigned long use_counter;
+};
+
+/*
+ * Helpers
+ */
+
+static uint32_t read_le32(const unsigned char *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int read_full(int fd, void *buffer, size_t length, off_t offset) {
+    unsigned char *p = buffer;
+    while (length > 0) {
+        ssize_t n = pread(fd, p, length, offset);
+        if (n <= 0) {
+            return -1;
+        }
+        p += n;
+        length -= (size_t)n;
+        offset += n;
+    }
+    return 0;
+}
+
+/*
+ * Read and check the block index at the end of the file
+ */
+static int load_index(txt_gz_t *gz, off_t file_size) {
+    unsigned char tail[INDEX_TAIL_SIZE];
+    static const unsigned char empty_member_end[10] = { 0x03, 0x00 };
+
+    if (file_size < INDEX_HEADER_SIZE + INDEX_TAIL_SIZE ||
+        read_full(gz->fd, tail, sizeof(tail), file_size - INDEX_TAIL_SIZE) != 0) {
+        return -1;
+    }
+    if (memcmp(tail + 4, TXT_GZ_MAGIC, 4) != 0 ||
+        memcmp(tail + 8, empty_member_end, sizeof(empty_member_end)) != 0) {
+        return -1;
+    }
+
+    uint32_t count = read_le32(tail);
+    if (count == 0 || count > TXT_GZ_MAX_BLOCKS) {
+        return -1;
+    }
+
+    size_t entries_size = (size_t)count * TXT_GZ_ENTRY_SIZE;
+    off_t member = file_size - INDEX_TAIL_SIZE - (off_t)entries_size - INDEX_HEADER_SIZE;
+    if (member < 0) {
+        return -1;
+    }
+
+    /* One read for the member header and the entries */
+    unsigned char *index = malloc(INDEX_HEADER_SIZE + entries_size);
+    if (!index) {
+        return -1;
+    }
+    if (read_full(gz->fd, index, INDEX_HEADER_SIZE + entries_size, member) != 0) {
+        free(index);
+        return -1;
+    }
+
+    const unsigned char *header = index;
+    size_t subfield = entries_size + 8;
+    if (header[0] != 0x1f || header[1] != 0x8b || header[2] != 8 || !(header[3] & 0x04) ||
+        (size_t)(header[10] | (header[11] << 8)) != subfield + 4 ||
+        header[12] != TXT_GZ_INDEX_ID1 || header[13] != TXT_GZ_INDEX_ID2 ||
+        (size_t)(header[14] | (header[15] << 8)) != subfield) {
+        free(index);
+        return -1;
+    }
+
+    gz->file_offsets = malloc((count + 1) * sizeof(off_t));
+    gz->text_offsets = malloc((count + 1) * sizeof(size_t));
+    if (!gz->file_offsets || !gz->text_offsets) {
+        free(index);
+        return -1;
+    }
+
+    /* Blocks must tile the file up to the index and each hold some text */
+    const unsigned char *entry = index + INDEX_HEADER_SIZE;
+    gz->file_offsets[0] = 0;
+    gz->text_offsets[0] = 0;
+    for (uint32_t i = 0; i < count; i++, entry += TXT_GZ_ENTRY_SIZE) {
+        uint32_t compressed = read_le32(entry);
+        uint32_t text = read_le32(entry + 4);
+        if (compressed < 18 || compressed > MAX_BLOCK_COMPRESSED ||
+            text == 0 || text > TXT_GZ_BLOCK_SIZE) {
+            free(index);
+            return -1;
+        }
+        gz->file_offsets[i + 1] = gz->file_offsets[i] + compressed;
+        gz->text_offsets[i + 1] = gz->text_offsets[i] + text;
+    }
+    free(index);
+
+    if (gz->file_offsets[count] != member) {
+        return -1;
+    }
+
+    gz->block_count = (int)count;
+    return 0;
+}
+
+/*
+ * Inflate one block into a slot
+ */
+static int inflate_block(txt_gz_t *gz, int block, char *out) {
+    size_t compressed = (size_t)(gz->file_offsets[block + 1] - gz->file_offsets[block]);
+    size_t length = gz->text_offsets[block + 1] - gz->text_offsets[block];
+    z_stream stream;
+    int result;
+
+    if (read_full(gz->fd, gz->input, compressed, gz->file_offsets[block]) != 0) {
+        fprintf(stderr, "txt_gz_block_at: Failed to read block %d\n", block);
+        return FORMAT_ERROR_READ_FAILED;
+    }
+
+    /* The gzip wrapper checks the member's CRC and length */
+    memset(&stream, 0, sizeof(stream));
+    if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) {
+        return FORMAT_ERROR_OUT_OF_MEMORY;
+    }
+    stream.next_in = gz->input;
+    stream.avail_in = (uInt)compressed;
+    stream.next_out = (Bytef*)out;
+    stream.avail_out = (uInt)length;
+    result = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+
+    if (result != Z_STREAM_END || stream.total_out != length) {
+        fprintf(stderr, "txt_gz_block_at: Block %d is corrupt\n", block);
+        return FORMAT_ERROR_CORRUPT_FILE;
+    }
+    return FORMAT_SUCCESS;
+}
+
+/*
+ * Public Functions
+ */
+
+int txt_gz_is_gz_file(const char *filename) {
+    if (!filename) {
+        return 0;
+    }
+
+    size_t len = strlen(filename);
+    if (len < 8) {  /* Minimum: "a.txt.gz" */
+        return 0;
+    }
+
+    /* Check for .txt.gz extension (case-insensitive) */
+    return (strcasecmp(filename + len - 7, ".txt.gz") == 0);
+}
+
+txt_gz_t* txt_gz_open(const char *filepath) {
+    struct stat st;
+
+    if (!filepath) {
+        return NULL;
+    }
+
+    txt_gz_t *gz = calloc(1, sizeof(txt_gz_t));
+    if (!gz) {
+        return NULL;
+    }
+
+    gz->fd = open(filepath, O_RDONLY | O_CLOEXEC);
+    if (gz->fd < 0) {
+        free(gz);
+        return NULL;
+    }
+
+    if (fstat(gz->fd, &st) != 0 || load_index(gz, st.st_size) != 0) {
+        txt_gz_close(gz);
+        return NULL;
+    }
+
+    gz->input = malloc(MAX_BLOCK_COMPRESSED);
+    if (!gz->input) {
+        txt_gz_close(gz);
+        return NULL;
+    }
+    for (int i = 0; i < TXT_GZ_CACHE_BLOCKS; i++) {
+        gz->slots[i].block = -1;
+    }
+
+    return gz;
+}
+
+void txt_gz_close(txt_gz_t *gz) {
+    if (!gz) {
+        return;
+    }
+
+    if (gz->fd >= 0) {
+        close(gz->fd);
+    }
+    for (int i = 0; i < TXT_GZ_CACHE_BLOCKS; i++) {
+        free(gz->slots[i].text);
+    }
+    free(gz->input);
+    free(gz->file_offsets);
+    free(gz->text_offsets);
+    free(gz);
+}
+
+size_t txt_gz_length(const txt_gz_t *gz) {
+    return gz ? gz->text_offsets[gz->block_count] : 0;
+}
+
+int txt_gz_block_at(txt_gz_t *gz, size_t offset, const char **out_text,
+                    size_t *out_offset, size_t *out_length) {
+    if (!gz || !out_text || !out_offset || !out_length) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+    if (offset >= gz->text_offsets[gz->block_count]) {
+        return FORMAT_ERROR_NO_CONTENT;
+    }
+
+    /* Binary search for the block containing offset */
+    int low = 0, high = gz->block_count - 1;
+    while (low < high) {
+        int mid = (low + high + 1) / 2;
+        if (gz->text_offsets[mid] <= offset) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    int block = low;
+
+    /* Already inflated, or else reuse the least recently used slot */
+    block_slot_t *slot = &gz->slots[0];
+    for (int i = 0; i < TXT_GZ_CACHE_BLOCKS; i++) {
+        if (gz->slots[i].block == block) {
+            slot = &gz->slots[i];
+            break;
+        }
+        if (gz->slots[i].used < slot->used) {
+            slot = &gz->slots[i];
+        }
+    }
+
+    if (slot->block != block) {
+        if (!slot->text) {
+            slot->text = malloc(TXT_GZ_BLOCK_SIZE);
+            if (!slot->text) {
+                return FORMAT_ERROR_OUT_OF_MEMORY;
+            }
+        }
+        slot->block = -1;
+        int result = inflate_block(gz, block, slot->text);
+        if (result != FORMAT_SUCCESS) {
+            return result;
+        }
+        slot->block = block;
+    }
+    slot->used = ++gz->use_counter;
+
+    *out_text = slot->text;
+    *out_offset = gz->text_offsets[block];
+    *out_length = gz->text_offsets[block + 1] - gz->text_offsets[block];
+    return FORMAT_SUCCESS;
+}
+
+int txt_gz_load(const char *filepath, charset_text_t *out) {
+    char *data = NULL;
+    size_t length = 0, capacity = 0, bom;
+    gzFile file;
+
+    if (!filepath || !out) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+    memset(out, 0, sizeof(charset_text_t));
+
+    file = gzopen(filepath, "rb");
+    if (!file) {
+        return (access(filepath, F_OK) != 0) ? FORMAT_ERROR_NOT_FOUND : FORMAT_ERROR_READ_FAILED;
+    }
+
+    /* Inflate every member (a packed file's index member adds no data) */
+    for (;;) {
+        if (length == capacity) {
+            if (capacity >= TXT_GZ_MAX_TEXT_SIZE) {
+                free(data);
+                gzclose(file);
+                return FORMAT_ERROR_TOO_LARGE;
+            }
+            capacity = capacity ? capacity * 2 : TXT_GZ_BLOCK_SIZE;
+            char *grown = realloc(data, capacity + 1);
+            if (!grown) {
+                free(data);
+                gzclose(file);
+                return FORMAT_ERROR_OUT_OF_MEMORY;
+            }
+            data = grown;
+        }
+
+        int n = gzread(file, data + length, (unsigned)(capacity - length));
+        if (n < 0) {
+            fprintf(stderr, "txt_gz_load: Failed to inflate %s\n", filepath);
+            free(data);
+            gzclose(file);
+            return FORMAT_ERROR_CORRUPT_FILE;
+        }
+        if (n == 0) {
+            break;
+        }
+        length += (size_t)n;
+    }
+    gzclose(file);
+
+    out->charset = charset_detect(data, length, &bom);
+
+    if (out->charset == CHARSET_UTF8) {
+        /* Use the inflated buffer as is, minus any BOM */
+        memmove(data, data + bom, length - bom);
+        length -= bom;
+        data[length] = '\0';
+        out->buffer = data;
+    } else {
+        size_t size = charset_to_utf8(out->charset, data + bom, length - bom, NULL);
+        out->buffer = malloc(size + 1);
+        if (!out->buffer) {
+            free(data);
+            return FORMAT_ERROR_OUT_OF_MEMORY;
+        }
+        charset_to_utf8(out->charset, data + bom, length - bom, out->buffer);
+        out->buffer[size] = '\0';
+        free(data);
+        length = size;
+    }
+
+    out->text = out->buffer;
+    out->length = length;
+
+    if (out->length == 0) {
+        charset_text_free(out);
+        return FORMAT_ERROR_NO_CONTENT;
+    }
+
+    return FORMAT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+/*
+ * txt_gz.h - Seekable Compressed Plain Text (.txt.gz)
+ *
+ * Plain-text books can be stored gzip-compressed. A file packed with
+ * tools/txtpack is a series of gzip members, one per block of at most
+ * TXT_GZ_BLOCK_SIZE bytes of UTF-8 text cut at a line break, followed by
+ * an empty member whose extra field indexes the blocks:
+ *
+ *   block 0 .. n-1   gzip member each (deflated text)
+ *   index            gzip member, no data, extra subfield 'T','X':
+ *                      compressed size, text size   (le32 each, per block)
+ *                      block count                  (le32)
+ *                      TXT_GZ_MAGIC                 (4 bytes)
+ *
+ * The index sits at a fixed distance from the end of the file, so opening
+ * a book costs two small reads, and each block is inflated only when the
+ * reader reaches it. To gzip, the file is an ordinary multi-member
+ * stream: "gzip -dc book.txt.gz" prints the text.
+ *
+ * A .txt.gz without the index (made with plain gzip) is inflated whole at
+ * open instead, and converted to UTF-8 like an uncompressed file.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef TXT_GZ_H
+#define TXT_GZ_H
+
+#include <stddef.h>
+#include "charset.h"
+
+/* File layout (shared with tools/txtpack.c) */
+#define TXT_GZ_BLOCK_SIZE   (64 * 1024)   /* Maximum text bytes per block */
+#define TXT_GZ_INDEX_ID1    'T'           /* Extra subfield ID of the index */
+#define TXT_GZ_INDEX_ID2    'X'
+#define TXT_GZ_MAGIC        "TXIX"        /* Last 4 bytes of the index subfield */
+#define TXT_GZ_ENTRY_SIZE   8             /* Bytes per block in the index */
+#define TXT_GZ_MAX_BLOCKS   ((65535 - 4 - 8) / TXT_GZ_ENTRY_SIZE)  /* Extra field holds at most 64 KB */
+
+/* Inflated blocks kept per open book */
+#define TXT_GZ_CACHE_BLOCKS 3
+
+/* Largest text inflated whole from a file without an index */
+#define TXT_GZ_MAX_TEXT_SIZE (50 * 1024 * 1024)
+
+/* Open indexed file (opaque) */
+typedef struct txt_gz txt_gz_t;
+
+/**
+ * Check if a filename has the .txt.gz extension
+ * @param filename: Filename to check
+ * @return: 1 if .txt.gz file, 0 otherwise
+ */
+int txt_gz_is_gz_file(const char *filename);
+
+/**
+ * Open a packed .txt.gz file by its block index
+ * @param filepath: Path to file
+ * @return: Open file, or NULL if it has no valid index (use txt_gz_load())
+ * @note: Caller must free with txt_gz_close()
+ */
+txt_gz_t* txt_gz_open(const char *filepath);
+
+/**
+ * Close a packed file and free its inflated blocks
+ * @param gz: Open file (NULL is ignored)
+ */
+void txt_gz_close(txt_gz_t *gz);
+
+/**
+ * Get the length of the whole text
+ * @param gz: Open file
+ * @return: Text length in bytes
+ */
+size_t txt_gz_length(const txt_gz_t *gz);
+
+/**
+ * Get the block containing an offset, inflating it if needed
+ * @param gz: Open file
+ * @param offset: Byte offset within the text
+ * @param out_text: Output block text (valid until TXT_GZ_CACHE_BLOCKS further calls or close)
+ * @param out_offset: Output offset of the block within the text
+ * @param out_length: Output length of the block in bytes
+ * @return: FORMAT_SUCCESS on success, FORMAT_ERROR_NO_CONTENT past the end,
+ *          other error code otherwise
+ */
+int txt_gz_block_at(txt_gz_t *gz, size_t offset, const char **out_text,
+                    size_t *out_offset, size_t *out_length);
+
+/**
+ * Inflate a whole .txt.gz file (packed or not) as UTF-8 text
+ * @param filepath: Path to file
+ * @param out: Output text in a heap buffer (release with charset_text_free())
+ * @return: FORMAT_SUCCESS on success, format error code otherwise
+ */
+int txt_gz_load(const char *filepath, charset_text_t *out);
+
+#endif /* TXT_GZ_H */
@@ -30,10 +30,6 @@
 #include <strings.h>
 #include <sys/stat.h>
 #include <unistd.h>
-#include <errno.h>
-
-/* Configuration */
-#define MAX_TXT_SIZE (10 * 1024 * 1024)  /* 10MB limit for TXT files */
 
 /*
  * Internal helper to extract title from filename
@@ -51,8 +47,12 @@ static void extract_title(const char *filepath, char *title, size_t title_size)
     strncpy(title, basename, title_size - 1);
     title[title_size - 1] = '\0';
 
-    /* Remove .txt extension */
+    /* Remove .txt (or .txt.gz) extension */
     char *ext = strrchr(title, '.');
+    if (ext && strcasecmp(ext, ".gz") == 0) {
+        *ext = '\0';
+        ext = strrchr(title, '.');
+    }
     if (ext && strcasecmp(ext, ".txt") == 0) {
         *ext = '\0';
     }
@@ -89,40 +89,19 @@ int txt_validate(const char *filepath) {
         return FORMAT_ERROR_NO_CONTENT;
     }
 
-    if (st.st_size > MAX_TXT_SIZE) {
-        return FORMAT_ERROR_TOO_LARGE;
-    }
-
     return FORMAT_SUCCESS;
 }
 
 txt_book_t* txt_open(const char *filepath) {
-    FILE *f;
     txt_book_t *book;
     struct stat st;
-    size_t bytes_read;
-    int validation_result;
+    int result;
 
     /* Validate file */
-    validation_result = txt_validate(filepath);
-    if (validation_result != FORMAT_SUCCESS) {
+    result = txt_validate(filepath);
+    if (result != FORMAT_SUCCESS) {
         fprintf(stderr, "txt_open: Validation failed for %s: %s\n",
-                filepath, format_error_string(validation_result));
-        return NULL;
-    }
-
-    /* Get file size */
-    if (stat(filepath, &st) != 0) {
-        fprintf(stderr, "txt_open: stat failed for %s: %s\n",
-                filepath, strerror(errno));
-        return NULL;
-    }
-
-    /* Open file */
-    f = fopen(filepath, "r");
-    if (!f) {
-        fprintf(stderr, "txt_open: Failed to open %s: %s\n",
-                filepath, strerror(errno));
+                filepath, format_error_string(result));
         return NULL;
     }
 
@@ -130,7 +109,6 @@ txt_book_t* txt_open(const char *filepath) {
     book = malloc(sizeof(txt_book_t));
     if (!book) {
         fprintf(stderr, "txt_open: Failed to allocate book structure\n");
-        fclose(f);
         return NULL;
     }
 
@@ -138,42 +116,46 @@ txt_book_t* txt_open(const char *filepath) {
     memset(book, 0, sizeof(txt_book_t));
     strncpy(book->filepath, filepath, sizeof(book->filepath) - 1);
     book->filepath[sizeof(book->filepath) - 1] = '\0';
-    book->file_size = st.st_size;
 
     /* Extract title from filename */
     extract_title(filepath, book->title, sizeof(book->title));
 
-    /* Allocate text buffer */
-    book->text = malloc(st.st_size + 1);
-    if (!book->text) {
-        fprintf(stderr, "txt_open: Failed to allocate %ld bytes for text\n", st.st_size);
-        free(book);
-        fclose(f);
-        return NULL;
+    if (txt_gz_is_gz_file(filepath)) {
+        /* Packed: read the block index now, inflate blocks as they are reached */
+        book->packed = txt_gz_open(filepath);
+        if (book->packed) {
+            book->text_length = txt_gz_length(book->packed);
+            result = FORMAT_SUCCESS;
+        } else {
+            result = txt_gz_load(filepath, &book->source);
+        }
+    } else {
+        /* Map file content, converting it to UTF-8 only if needed */
+        result = charset_load_file(filepath, &book->source);
     }
-
-    /* Read file content */
-    bytes_read = fread(book->text, 1, st.st_size, f);
-    fclose(f);
-
-    if (bytes_read != (size_t)st.st_size) {
-        fprintf(stderr, "txt_open: Read error: expected %ld bytes, got %zu\n",
-                st.st_size, bytes_read);
-        free(book->text);
+    if (result != FORMAT_SUCCESS) {
+        fprintf(stderr, "txt_open: Failed to load %s: %s\n",
+                filepath, format_error_string(result));
         free(book);
         return NULL;
     }
+    if (!book->packed) {
+        book->text = book->source.text;
+        book->text_length = book->source.length;
+    }
 
-    /* Null-terminate */
-    book->text[st.st_size] = '\0';
-    book->text_length = st.st_size;
+    /* Original size, before any conversion */
+    if (stat(filepath, &st) == 0) {
+        book->file_size = st.st_size;
+    }
 
     return book;
 }
 
 void txt_close(txt_book_t *book) {
     if (book) {
-        free(book->text);
+        txt_gz_close(book->packed);
+        charset_text_free(&book->source);
         free(book);
     }
 }
@@ -191,6 +173,16 @@ int txt_get_text(txt_book_t *book, const char **out_text, size_t *out_length) {
         return FORMAT_ERROR_INVALID_FORMAT;
     }
 
+    if (!book->text && book->packed) {
+        /* Whole text wanted: inflate every block at once */
+        int result = txt_gz_load(book->filepath, &book->source);
+        if (result != FORMAT_SUCCESS) {
+            return result;
+        }
+        book->text = book->source.text;
+        book->text_length = book->source.length;
+    }
+
     if (!book->text) {
         return FORMAT_ERROR_NO_CONTENT;
     }
@@ -236,7 +228,7 @@ int txt_is_txt_file(const char *filename) {
 
     /* Check for .txt extension (case-insensitive) */
     const char *ext = filename + len - 4;
-    return (strcasecmp(ext, ".txt") == 0);
+    return (strcasecmp(ext, ".txt") == 0) || txt_gz_is_gz_file(filename);
 }
 
 /*
@@ -274,6 +266,40 @@ static int txt_interface_get_page_count(format_handle_t handle) {
     return -1;
 }
 
+static int txt_interface_get_length(format_handle_t handle, size_t *out_length) {
+    txt_book_t *book = (txt_book_t*)handle;
+
+    if (!book || !out_length) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    *out_length = book->text_length;
+    return FORMAT_SUCCESS;
+}
+
+static int txt_interface_chunk_at(format_handle_t handle, size_t offset, format_chunk_t *chunk) {
+    txt_book_t *book = (txt_book_t*)handle;
+
+    if (!book || !chunk) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+    if (offset >= book->text_length) {
+        return FORMAT_ERROR_NO_CONTENT;
+    }
+
+    if (book->packed) {
+        /* One compressed block per chunk */
+        return txt_gz_block_at(book->packed, offset, &chunk->text,
+                               &chunk->offset, &chunk->length);
+    }
+
+    /* The mapped (or converted) text is a single chunk */
+    chunk->text = book->text;
+    chunk->offset = 0;
+    chunk->length = book->text_length;
+    return FORMAT_SUCCESS;
+}
+
 /*
  * Format Interface Definition
  */
@@ -287,5 +313,7 @@ const book_format_interface_t txt_format_interface = {
     .extract_text = txt_interface_extract_text,
     .get_text = txt_interface_get_text,
     .get_metadata = txt_interface_get_metadata,
-    .get_page_count = txt_interface_get_page_count
+    .get_page_count = txt_interface_get_page_count,
+    .get_length = txt_interface_get_length,
+    .chunk_at = txt_interface_chunk_at
 };
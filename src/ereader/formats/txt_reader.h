@@ -33,6 +33,8 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "format_interface.h"
+#include "charset.h"
+#include "txt_gz.h"
 
 /*
  * TXT Book Structure
@@ -41,8 +43,10 @@
 typedef struct {
     char filepath[512];        /* Path to TXT file */
     char title[256];           /* Title (derived from filename) */
-    char *text;                /* Full text content (null-terminated) */
+    const char *text;          /* Full text content (UTF-8, null-terminated) */
     size_t text_length;        /* Length of text in bytes */
+    charset_text_t source;     /* Mapped or converted storage behind text */
+    txt_gz_t *packed;          /* Indexed .txt.gz read block by block (text NULL until needed) */
     long file_size;            /* Original file size */
 } txt_book_t;
 
@@ -58,7 +62,9 @@ typedef struct {
 int txt_validate(const char *filepath);
 
 /**
- * Open and load a TXT file
+ * Open a TXT file, mapping its text and converting it to UTF-8 if needed
+ * A .txt.gz file with a block index is opened by its index only; other
+ * .txt.gz files are inflated whole.
  * @param filepath: Path to TXT file
  * @return: Pointer to txt_book_t structure, or NULL on error
  * @note: Caller must free with txt_close()
@@ -66,7 +72,7 @@ int txt_validate(const char *filepath);
 txt_book_t* txt_open(const char *filepath);
 
 /**
- * Close TXT book and free all associated memory
+ * Close TXT book, release its text and free all associated memory
  * @param book: TXT book structure to free
  */
 void txt_close(txt_book_t *book);
@@ -96,9 +102,9 @@ int txt_get_text(txt_book_t *book, const char **out_text, size_t *out_length);
 int txt_get_metadata(txt_book_t *book, format_metadata_t *metadata);
 
 /**
- * Check if a file has .txt extension
+ * Check if a file has .txt or .txt.gz extension
  * @param filename: Filename to check
- * @return: 1 if .txt file, 0 otherwise
+ * @return: 1 if .txt or .txt.gz file, 0 otherwise
  */
 int txt_is_txt_file(const char *filename);
 
@@ -35,12 +35,14 @@
 #include <unistd.h>
 #include <errno.h>
 #include <sys/stat.h>
+#include <sys/select.h>
 #include <sys/types.h>
 
 #include "ereader.h"
 #include "rendering/framebuffer.h"
 #include "rendering/text_renderer.h"
 #include "books/book_manager.h"
+#include "books/library_watch.h"
 #include "formats/format_interface.h"
 #include "ui/menu.h"
 #include "ui/reader.h"
@@ -61,6 +63,8 @@ static int ensure_directories_exist(void);
 static int app_render_startup(app_context_t *ctx);
 static int app_render_empty(app_context_t *ctx);
 static int app_render_error(app_context_t *ctx);
+static int app_wait_event(app_context_t *ctx, button_event_t *event, int timeout_ms);
+static void app_library_changed(app_context_t *ctx);
 
 /*
  * Signal handler for graceful shutdown
@@ -162,6 +166,10 @@ app_context_t* app_init(void) {
         return NULL;
     }
 
+    /* Load fonts (missing installed fonts fall back to the built-in ones) */
+    printf("Loading fonts...\n");
+    text_renderer_init();
+
     /* Initialize button input */
     printf("Initializing button input...\n");
     ctx->button_ctx = button_input_init();
@@ -214,6 +222,7 @@ app_context_t* app_init(void) {
     }
 
     bookmark_list_load(ctx->bookmarks, EREADER_BOOKMARKS_FILE);
+    book_list_apply_bookmarks(ctx->book_list, ctx->bookmarks);
 
     /* Load settings */
     printf("Loading settings...\n");
@@ -236,6 +245,8 @@ app_context_t* app_init(void) {
         fprintf(stderr, "Warning: Failed to load settings: %s\n",
                 settings_error_to_string(settings_err));
     }
+    book_list_sort(ctx->book_list,
+                   (book_sort_key_t)settings_get_library_sort((settings_t*)ctx->settings));
 
     /* Initialize menu state */
     printf("Initializing menu...\n");
@@ -267,6 +278,12 @@ app_context_t* app_init(void) {
     }
     loading_screen_init((loading_screen_t*)ctx->loading_screen);
 
+    /* Follow books being added and removed from now on (optional) */
+    ctx->library_watch = library_watch_create(EREADER_BOOKS_DIR);
+    if (ctx->library_watch == NULL) {
+        fprintf(stderr, "Warning: Library will only update on rescan\n");
+    }
+
     printf("Initialization complete\n");
     return ctx;
 }
@@ -329,6 +346,12 @@ void app_cleanup(app_context_t *ctx) {
         ctx->bookmarks = NULL;
     }
 
+    /* Cleanup library watch */
+    if (ctx->library_watch != NULL) {
+        library_watch_free(ctx->library_watch);
+        ctx->library_watch = NULL;
+    }
+
     /* Cleanup book list */
     if (ctx->book_list != NULL) {
         book_list_free(ctx->book_list);
@@ -341,6 +364,9 @@ void app_cleanup(app_context_t *ctx) {
         ctx->button_ctx = NULL;
     }
 
+    /* Unmap installed fonts */
+    text_renderer_cleanup();
+
     /* Cleanup framebuffer */
     if (ctx->framebuffer != NULL) {
         fb_free(ctx->framebuffer);
@@ -450,21 +476,16 @@ int app_handle_button_event(app_context_t *ctx, void *button_event_ptr) {
             break;
 
         case STATE_MENU_LIBRARY: {
-            /* Check for MENU button to open settings */
-            if (event->button == BUTTON_MENU && event->event_type == BUTTON_EVENT_PRESS) {
-                app_change_state(ctx, STATE_SETTINGS);
-                break;
-            }
-
             menu_action_t action = menu_handle_event(ctx->menu_state, event);
 
             switch (action) {
                 case MENU_ACTION_SELECT_BOOK: {
                     /* Get selected book */
-                    book_metadata_t *metadata = menu_get_selected_book(ctx->menu_state);
-                    if (metadata == NULL) {
+                    book_metadata_t selected;
+                    if (!menu_get_selected_book(ctx->menu_state, &selected)) {
                         break;
                     }
+                    book_metadata_t *metadata = &selected;
 
                     /* Load book */
                     /* Show loading screen */
@@ -500,7 +521,8 @@ int app_handle_button_event(app_context_t *ctx, void *button_event_ptr) {
                     }
 
                     /* Create reader state */
-                    ctx->reader_state = reader_create(ctx->current_book, metadata, ctx->bookmarks, initial_page);
+                    ctx->reader_state = reader_create(ctx->current_book, metadata, ctx->bookmarks, initial_page,
+                                                      (settings_t*)ctx->settings);
                     if (ctx->reader_state == NULL) {
                         book_free(ctx->current_book);
                         ctx->current_book = NULL;
@@ -509,6 +531,9 @@ int app_handle_button_event(app_context_t *ctx, void *button_event_ptr) {
                         break;
                     }
 
+                    /* Moves the book up the last read order */
+                    book_list_set_last_read(ctx->book_list, metadata->filename, time(NULL));
+
                     /* Complete loading screen */
                     loading_screen_complete(loading);
                     loading_screen_reset(loading);
@@ -518,6 +543,10 @@ int app_handle_button_event(app_context_t *ctx, void *button_event_ptr) {
                     break;
                 }
 
+                case MENU_ACTION_OPEN_SETTINGS:
+                    app_change_state(ctx, STATE_SETTINGS);
+                    break;
+
                 case MENU_ACTION_EXIT:
                     app_request_shutdown(ctx);
                     break;
@@ -580,6 +609,8 @@ int app_handle_button_event(app_context_t *ctx, void *button_event_ptr) {
                         }
                         printf("Settings saved\n");
                     }
+                    book_list_sort(ctx->book_list,
+                                   (book_sort_key_t)settings_get_library_sort((settings_t*)ctx->settings));
                     app_change_state(ctx, STATE_MENU_LIBRARY);
                     break;
 
@@ -808,6 +839,75 @@ void app_request_shutdown(app_context_t *ctx) {
     }
 }
 
+/*
+ * Wait for a button event, applying library changes as they arrive
+ * The library is only updated while it is shown (or empty): the reader
+ * and other screens may hold pointers into the book list, so changes made
+ * meanwhile stay queued until the user returns to it.
+ * Returns 1 if an event was read, 0 on timeout or library change, -1 on error
+ */
+static int app_wait_event(app_context_t *ctx, button_event_t *event, int timeout_ms) {
+    int watch_fd = -1;
+    if (ctx->state == STATE_MENU_LIBRARY || ctx->state == STATE_EMPTY) {
+        watch_fd = library_watch_get_fd(ctx->library_watch);
+    }
+    if (watch_fd < 0) {
+        return button_input_read_event_timeout(ctx->button_ctx, event, timeout_ms);
+    }
+
+    int button_fd = button_input_get_fd(ctx->button_ctx);
+    fd_set readfds;
+    struct timeval timeout;
+
+    FD_ZERO(&readfds);
+    FD_SET(button_fd, &readfds);
+    FD_SET(watch_fd, &readfds);
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_usec = (timeout_ms % 1000) * 1000;
+
+    int ret = select((button_fd > watch_fd ? button_fd : watch_fd) + 1, &readfds, NULL, NULL,
+                     &timeout);
+    if (ret <= 0) {
+        return ret;
+    }
+
+    if (FD_ISSET(watch_fd, &readfds)) {
+        app_library_changed(ctx);
+    }
+    if (FD_ISSET(button_fd, &readfds)) {
+        return button_input_read_event(ctx->button_ctx, event) == 0 ? 1 : -1;
+    }
+    return 0;
+}
+
+/*
+ * Apply pending library changes and update the menu (or empty screen)
+ */
+static void app_library_changed(app_context_t *ctx) {
+    char selected[MAX_FILENAME_LENGTH] = "";
+
+    /* Entries move as books come and go; remember the selection by name */
+    int index = ctx->menu_state ? menu_get_selected_index(ctx->menu_state) : -1;
+    if (index >= 0) {
+        strncpy(selected, book_list_get_filename(ctx->book_list, index), sizeof(selected) - 1);
+    }
+
+    if (library_watch_process(ctx->library_watch, ctx->book_list) == 0) {
+        return;
+    }
+
+    int book_count = book_list_get_count(ctx->book_list);
+    printf("Library changed: %d book(s)\n", book_count);
+    if (ctx->state == STATE_MENU_LIBRARY && book_count == 0) {
+        app_change_state(ctx, STATE_EMPTY);
+    } else if (ctx->state == STATE_EMPTY && book_count > 0) {
+        app_change_state(ctx, STATE_MENU_LIBRARY);
+    } else if (ctx->menu_state) {
+        menu_books_changed(ctx->menu_state, selected);
+        ctx->needs_redraw = true;
+    }
+}
+
 /*
  * Run the main application loop
  */
@@ -842,9 +942,9 @@ int app_run(app_context_t *ctx) {
             ctx->needs_redraw = false;
         }
 
-        /* Wait for button event with timeout */
+        /* Wait for button event (or library change) with timeout */
         button_event_t event;
-        int ret = button_input_read_event_timeout(ctx->button_ctx, &event, 1000);
+        int ret = app_wait_event(ctx, &event, 1000);
 
         if (ret > 0) {
             /* Event received */
@@ -857,8 +957,12 @@ int app_run(app_context_t *ctx) {
             /* Error reading button event */
             fprintf(stderr, "Error reading button event: %s\n", strerror(errno));
             /* Continue anyway, don't exit on button read error */
+        } else if (ctx->state == STATE_READING && ctx->reader_state != NULL) {
+            /* ret == 0 means timeout: finish laying out the book in the background */
+            if (reader_idle(ctx->reader_state)) {
+                ctx->needs_redraw = true;
+            }
         }
-        /* ret == 0 means timeout, which is normal */
     }
 
     /* Shutdown state */
@@ -0,0 +1,487 @@
+/*
+ * font.c - Bitmap Font Loading and Glyph Lookup Implementation
+ *
+ * Installed fonts are mmap()ed read-only: the kernel pages glyph bitmaps
+ * in as they are drawn and can drop them again under memory pressure, and
+ * loading a font costs one open/mmap regardless of its size.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "font.h"
+#include "font_data.h"
+
+/* Built-in fonts, in order small, medium, large */
+#define BUILTIN_FONT_COUNT  3
+#define BUILTIN_FIRST_CHAR  32
+#define BUILTIN_GLYPHS      95
+
+static font_t builtin_fonts[BUILTIN_FONT_COUNT];
+static font_range_t builtin_range = { BUILTIN_FIRST_CHAR, BUILTIN_GLYPHS, 0 };
+static bool builtin_ready = false;
+
+/* Medium glyphs: the 8x16 set plus glyphs composed from the 6x12 set */
+static uint8_t medium_glyphs[BUILTIN_GLYPHS][FONT_MEDIUM_HEIGHT];
+
+/* Installed fonts */
+static font_t installed_fonts[FONT_MAX_INSTALLED];
+static int installed_count = 0;
+
+/*
+ * Helpers
+ */
+
+static uint16_t read_le16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t read_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* Stand-ins for accented Latin-1 letters (U+00C0-U+00FF) */
+static const char latin1_fallback[] =
+    "AAAAAAACEEEEIIIIDNOOOOOxOUUUUYPs"
+    "aaaaaaaceeeeiiiidnooooo:ouuuuypy";
+
+/**
+ * Find the glyph for a codepoint in the range table
+ * @return: Glyph index, or UINT32_MAX if not covered
+ */
+static uint32_t font_range_lookup(const font_t *font, uint32_t codepoint) {
+    uint32_t lo = 0;
+    uint32_t hi = font->range_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        const font_range_t *range = &font->ranges[mid];
+        if (codepoint < range->first) {
+            hi = mid;
+        } else if (codepoint - range->first >= range->count) {
+            lo = mid + 1;
+        } else {
+            return range->glyph + (codepoint - range->first);
+        }
+    }
+    return UINT32_MAX;
+}
+
+/**
+ * Get an ASCII look-alike for a codepoint
+ * @return: ASCII character, or 0 if there is none
+ */
+static uint32_t font_fallback_codepoint(uint32_t codepoint) {
+    if (codepoint >= 0xC0 && codepoint <= 0xFF) {
+        return (uint32_t)latin1_fallback[codepoint - 0xC0];
+    }
+
+    switch (codepoint) {
+        case 0x00A0: case 0x2002: case 0x2003: case 0x2009:
+        case 0x200A: case 0x202F: case 0x3000:
+            return ' ';
+        case 0x00AB: case 0x00BB: case 0x201C: case 0x201D:
+        case 0x201E: case 0x201F: case 0x2033:
+            return '"';
+        case 0x2018: case 0x2019: case 0x201A: case 0x201B:
+        case 0x2032:
+            return '\'';
+        case 0x2010: case 0x2011: case 0x2012: case 0x2013:
+        case 0x2014: case 0x2015: case 0x2212:
+            return '-';
+        case 0x2039: return '<';
+        case 0x203A: return '>';
+        case 0x2022: return '*';
+        case 0x00B7: return '.';
+        case 0xFFFD: return '?';
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Resolve a codepoint without the page table
+ */
+static uint32_t font_resolve(const font_t *font, uint32_t codepoint) {
+    uint32_t glyph = font_range_lookup(font, codepoint);
+    if (glyph != UINT32_MAX) return glyph;
+
+    uint32_t fallback = font_fallback_codepoint(codepoint);
+    if (fallback) {
+        glyph = font_range_lookup(font, fallback);
+        if (glyph != UINT32_MAX) return glyph;
+    }
+
+    return font->missing_glyph;
+}
+
+/**
+ * Build the glyph block for one page of codepoints
+ *
+ * Pages the font has no glyphs in (and no look-alikes for) share
+ * font->blank_page, so scattered codepoints cost one block, not one each.
+ *
+ * @return: Block, or NULL if out of memory
+ */
+static uint16_t* font_build_page(font_t *font, uint32_t page) {
+    uint16_t block[FONT_PAGE_SIZE];
+    uint32_t base = page << FONT_PAGE_SHIFT;
+    bool blank = true;
+
+    for (uint32_t i = 0; i < FONT_PAGE_SIZE; i++) {
+        block[i] = (uint16_t)font_resolve(font, base + i);
+        if (block[i] != font->missing_glyph) blank = false;
+    }
+
+    uint16_t **slot = blank ? &font->blank_page : &font->pages[page];
+    if (!*slot) {
+        *slot = malloc(sizeof(block));
+        if (!*slot) return NULL;
+        memcpy(*slot, block, sizeof(block));
+    }
+
+    font->pages[page] = *slot;
+    return *slot;
+}
+
+/**
+ * Pick the missing glyph and build the ASCII/Latin-1 block
+ * @return: 0 on success, -1 if the font has no space glyph or out of memory
+ */
+static int font_init_pages(font_t *font) {
+    memset(font->pages, 0, sizeof(font->pages));
+    font->blank_page = NULL;
+
+    uint32_t space = font_range_lookup(font, ' ');
+    if (space == UINT32_MAX) return -1;
+    font->missing_glyph = space;
+
+    return font_build_page(font, 0) ? 0 : -1;
+}
+
+/**
+ * Free the glyph blocks of a font
+ */
+static void font_free_pages(font_t *font) {
+    for (int i = 0; i < FONT_PAGE_COUNT; i++) {
+        if (font->pages[i] != font->blank_page) free(font->pages[i]);
+        font->pages[i] = NULL;
+    }
+    free(font->blank_page);
+    font->blank_page = NULL;
+}
+
+/**
+ * Set up the built-in fonts (once)
+ *
+ * The 8x16 data stops at 'Z'; the remaining printable ASCII glyphs are
+ * taken from the 6x12 font, centred in the 8x16 cell, so lowercase text is
+ * not blank at the medium size. The 10x20 data has 10 rows of 2 bytes,
+ * which are drawn twice each.
+ */
+static void font_builtin_init(void) {
+    if (builtin_ready) return;
+
+    for (int g = 0; g < BUILTIN_GLYPHS; g++) {
+        if (g < FONT_MEDIUM_GLYPHS) {
+            memcpy(medium_glyphs[g], font_8x16_data[g], FONT_MEDIUM_HEIGHT);
+        } else {
+            memset(medium_glyphs[g], 0, FONT_MEDIUM_HEIGHT);
+            for (int row = 0; row < FONT_SMALL_HEIGHT; row++) {
+                medium_glyphs[g][row + 2] = font_6x12_data[g][row] >> 1;
+            }
+        }
+    }
+
+    static const struct {
+        int width, rows, y_scale, row_bytes;
+        const uint8_t *bitmaps;
+    } specs[BUILTIN_FONT_COUNT] = {
+        { FONT_SMALL_WIDTH,  FONT_SMALL_HEIGHT,      1, 1, &font_6x12_data[0][0] },
+        { FONT_MEDIUM_WIDTH, FONT_MEDIUM_HEIGHT,     1, 1, &medium_glyphs[0][0] },
+        { FONT_LARGE_WIDTH,  FONT_LARGE_HEIGHT / 2,  2, 2, &font_10x20_data[0][0] },
+    };
+
+    for (int i = 0; i < BUILTIN_FONT_COUNT; i++) {
+        font_t *font = &builtin_fonts[i];
+        memset(font, 0, sizeof(*font));
+        strncpy(font->family, FONT_FAMILY_BUILTIN, sizeof(font->family) - 1);
+        font->width = specs[i].width;
+        font->rows = specs[i].rows;
+        font->y_scale = specs[i].y_scale;
+        font->height = specs[i].rows * specs[i].y_scale;
+        font->ascent = font->height - font->height / 4;
+        font->row_bytes = specs[i].row_bytes;
+        font->glyph_stride = specs[i].rows * specs[i].row_bytes;
+        font->monospace = true;
+        font->glyph_count = BUILTIN_GLYPHS;
+        font->ranges = &builtin_range;
+        font->range_count = 1;
+        font->advances = NULL;
+        font->bitmaps = specs[i].bitmaps;
+        font_init_pages(font);
+    }
+
+    builtin_ready = true;
+}
+
+/*
+ * Font Files
+ */
+
+/**
+ * Load a single font file with mmap()
+ */
+int font_load_file(const char *path, font_t *font) {
+    if (!path || !font) return -1;
+
+    memset(font, 0, sizeof(*font));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "font_load_file: Cannot open %s\n", path);
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        st.st_size < FONT_FILE_HEADER_SIZE + FONT_FILE_FAMILY_SIZE) {
+        fprintf(stderr, "font_load_file: %s is too small\n", path);
+        close(fd);
+        return -1;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "font_load_file: mmap failed for %s\n", path);
+        return -1;
+    }
+
+    const uint8_t *p = map;
+    if (memcmp(p, FONT_FILE_MAGIC, 4) != 0 || read_le16(p + 4) != FONT_FILE_VERSION) {
+        fprintf(stderr, "font_load_file: %s is not a version %d font file\n",
+                path, FONT_FILE_VERSION);
+        munmap(map, size);
+        return -1;
+    }
+
+    uint16_t flags = read_le16(p + 6);
+    int width = p[8];
+    int height = p[9];
+    int ascent = p[10];
+    int row_bytes = p[11];
+    uint32_t glyph_count = read_le32(p + 12);
+    uint32_t range_count = read_le32(p + 16);
+    uint32_t ranges_offset = read_le32(p + 20);
+    uint32_t advances_offset = read_le32(p + 24);
+    uint32_t bitmaps_offset = read_le32(p + 28);
+
+    /* Validate geometry and that every table lies inside the file */
+    size_t glyph_stride = (size_t)height * row_bytes;
+    if (width == 0 || height == 0 || height > FONT_MAX_HEIGHT ||
+        row_bytes == 0 || row_bytes > FONT_MAX_ROW_BYTES ||
+        glyph_count == 0 || glyph_count > UINT16_MAX ||
+        ranges_offset > size || (size - ranges_offset) / FONT_FILE_RANGE_SIZE < range_count ||
+        advances_offset > size || size - advances_offset < glyph_count ||
+        bitmaps_offset > size || (size - bitmaps_offset) / glyph_stride < glyph_count) {
+        fprintf(stderr, "font_load_file: %s is corrupt\n", path);
+        munmap(map, size);
+        return -1;
+    }
+
+    font->ranges = malloc(sizeof(font_range_t) * (range_count ? range_count : 1));
+    if (!font->ranges) {
+        munmap(map, size);
+        return -1;
+    }
+
+    for (uint32_t r = 0; r < range_count; r++) {
+        const uint8_t *entry = p + ranges_offset + r * FONT_FILE_RANGE_SIZE;
+        font_range_t *range = &font->ranges[r];
+        range->first = read_le32(entry);
+        range->count = read_le32(entry + 4);
+        range->glyph = read_le32(entry + 8);
+        if (range->glyph > glyph_count || glyph_count - range->glyph < range->count) {
+            fprintf(stderr, "font_load_file: %s has a bad range table\n", path);
+            free(font->ranges);
+            munmap(map, size);
+            return -1;
+        }
+    }
+
+    memcpy(font->family, p + FONT_FILE_HEADER_SIZE, FONT_FILE_FAMILY_SIZE);
+    font->family[FONT_FILE_FAMILY_SIZE - 1] = '\0';
+    font->width = width;
+    font->height = height;
+    font->ascent = ascent;
+    font->rows = height;
+    font->y_scale = 1;
+    font->row_bytes = row_bytes;
+    font->glyph_stride = (int)glyph_stride;
+    font->monospace = (flags & FONT_FLAG_MONOSPACE) != 0;
+    font->glyph_count = glyph_count;
+    font->range_count = range_count;
+    font->advances = p + advances_offset;
+    font->bitmaps = p + bitmaps_offset;
+    font->map = map;
+    font->map_size = size;
+
+    /* The space glyph stands in for uncovered codepoints */
+    if (font_init_pages(font) != 0) {
+        fprintf(stderr, "font_load_file: %s has no space glyph\n", path);
+        font_unload(font);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Release a font loaded by font_load_file
+ */
+void font_unload(font_t *font) {
+    if (!font || !font->map) return;
+
+    munmap(font->map, font->map_size);
+    font_free_pages(font);
+    free(font->ranges);
+    memset(font, 0, sizeof(*font));
+}
+
+/*
+ * Registry
+ */
+
+static int compare_names(const void *a, const void *b) {
+    return strcmp((const char *)a, (const char *)b);
+}
+
+/**
+ * Load installed fonts from a directory
+ */
+int font_registry_init(const char *dir) {
+    font_builtin_init();
+    font_registry_cleanup();
+
+    if (!dir) dir = FONT_DIR;
+
+    DIR *d = opendir(dir);
+    if (!d) {
+        /* No installed fonts is normal: the built-in fonts are used */
+        return 0;
+    }
+
+    /* Sort entries so the font picked for a size does not depend on readdir order */
+    char names[FONT_MAX_INSTALLED][256];
+    int name_count = 0;
+    struct dirent *entry;
+    size_t ext_len = strlen(FONT_FILE_EXTENSION);
+
+    while ((entry = readdir(d)) != NULL && name_count < FONT_MAX_INSTALLED) {
+        size_t len = strlen(entry->d_name);
+        if (len <= ext_len || len >= sizeof(names[0]) ||
+            strcmp(entry->d_name + len - ext_len, FONT_FILE_EXTENSION) != 0) {
+            continue;
+        }
+        strcpy(names[name_count++], entry->d_name);
+    }
+    closedir(d);
+
+    qsort(names, name_count, sizeof(names[0]), compare_names);
+
+    for (int i = 0; i < name_count; i++) {
+        char path[512];
+        int len = snprintf(path, sizeof(path), "%s/%s", dir, names[i]);
+        if (len < 0 || (size_t)len >= sizeof(path)) {
+            continue;
+        }
+        if (font_load_file(path, &installed_fonts[installed_count]) == 0) {
+            printf("Loaded font %s (%s, %dx%d)\n", names[i],
+                   installed_fonts[installed_count].family,
+                   installed_fonts[installed_count].width,
+                   installed_fonts[installed_count].height);
+            installed_count++;
+        }
+    }
+
+    return installed_count;
+}
+
+/**
+ * Unmap all installed fonts
+ */
+void font_registry_cleanup(void) {
+    for (int i = 0; i < installed_count; i++) {
+        font_unload(&installed_fonts[i]);
+    }
+    installed_count = 0;
+}
+
+/**
+ * Find a font by family and cell height
+ */
+const font_t* font_find(const char *family, int height) {
+    font_builtin_init();
+
+    bool any_family = (!family || family[0] == '\0');
+
+    for (int i = 0; i < installed_count; i++) {
+        const font_t *font = &installed_fonts[i];
+        if (font->height == height &&
+            (any_family || strcmp(font->family, family) == 0)) {
+            return font;
+        }
+    }
+
+    /* Built-in font closest in height */
+    const font_t *best = &builtin_fonts[0];
+    for (int i = 1; i < BUILTIN_FONT_COUNT; i++) {
+        if (abs(builtin_fonts[i].height - height) < abs(best->height - height)) {
+            best = &builtin_fonts[i];
+        }
+    }
+    return best;
+}
+
+/**
+ * Look up the glyph for a codepoint outside the built glyph blocks
+ *
+ * Fonts are shared through const pointers, but the page table is a cache
+ * filled on demand; the font objects themselves are never const.
+ */
+uint32_t font_glyph_lookup(const font_t *font, uint32_t codepoint) {
+    if (codepoint < FONT_PAGED_LIMIT) {
+        uint16_t *block = font_build_page((font_t *)font, codepoint >> FONT_PAGE_SHIFT);
+        if (block) {
+            return block[codepoint & (FONT_PAGE_SIZE - 1)];
+        }
+    }
+
+    return font_resolve(font, codepoint);
+}
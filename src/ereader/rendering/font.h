@@ -0,0 +1,216 @@
+/*
+ * font.h - Bitmap Font Loading and Glyph Lookup
+ *
+ * Fonts are stored in a compact binary format (.erf) that is mapped into
+ * memory with mmap() rather than read, so installing more typefaces and
+ * sizes in FONT_DIR costs neither binary size nor startup time. The three
+ * built-in fonts from font_data.h are always available as a fallback.
+ *
+ * File format (all integers little-endian):
+ *
+ *   Header (32 bytes)
+ *     char     magic[4]         "ERF1"
+ *     uint16   version          FONT_FILE_VERSION
+ *     uint16   flags            FONT_FLAG_*
+ *     uint8    width            Cell width / largest advance in pixels
+ *     uint8    height           Cell height in pixels
+ *     uint8    ascent           Baseline, in pixels from the top of the cell
+ *     uint8    row_bytes        Bytes per bitmap row
+ *     uint32   glyph_count
+ *     uint32   range_count
+ *     uint32   ranges_offset    Offset of the range table
+ *     uint32   advances_offset  Offset of the advance table
+ *     uint32   bitmaps_offset   Offset of the glyph bitmaps
+ *     char     family[32]       NUL-padded family name (follows the header)
+ *
+ *   Range table: range_count x { uint32 first, uint32 count, uint32 glyph }
+ *     Codepoints first..first+count-1 map to glyphs glyph..glyph+count-1.
+ *     Sorted by first, non-overlapping.
+ *   Advance table: glyph_count x uint8 advance in pixels
+ *   Bitmaps: glyph_count x height x row_bytes, one row after another,
+ *     bit 7 of the first byte is the leftmost pixel and unused low bits
+ *     are zero - the framebuffer's own layout, so rows can be shifted into
+ *     place a byte at a time.
+ *
+ * Fonts are produced on the host by tools/bdf2erf from BDF files (PCF
+ * fonts can be converted to BDF with pcf2bdf first).
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef FONT_H
+#define FONT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Directory scanned for installed fonts */
+#define FONT_DIR                "/usr/share/ereader/fonts"
+#define FONT_FILE_EXTENSION     ".erf"
+
+/* File format constants */
+#define FONT_FILE_MAGIC         "ERF1"
+#define FONT_FILE_VERSION       1
+#define FONT_FILE_HEADER_SIZE   32
+#define FONT_FILE_FAMILY_SIZE   32
+#define FONT_FILE_RANGE_SIZE    12
+#define FONT_FLAG_MONOSPACE     0x0001   /* All advances equal width */
+
+/* Limits */
+#define FONT_MAX_INSTALLED      16
+#define FONT_MAX_ROW_BYTES      4        /* Glyphs up to 32 pixels wide */
+#define FONT_MAX_HEIGHT         64
+#define FONT_FAMILY_BUILTIN     "builtin"
+
+/* Glyph page table: codepoints below FONT_PAGED_LIMIT are resolved through
+ * blocks of FONT_PAGE_SIZE glyph indexes, each built the first time a
+ * codepoint in it is drawn; the few codepoints above use the range table */
+#define FONT_PAGE_SHIFT         8
+#define FONT_PAGE_SIZE          (1 << FONT_PAGE_SHIFT)
+#define FONT_PAGED_LIMIT        0x10000  /* Basic Multilingual Plane */
+#define FONT_PAGE_COUNT         (FONT_PAGED_LIMIT >> FONT_PAGE_SHIFT)
+
+/* Nominal cell heights of the three reading sizes */
+#define FONT_SIZE_SMALL_HEIGHT  12
+#define FONT_SIZE_MEDIUM_HEIGHT 16
+#define FONT_SIZE_LARGE_HEIGHT  20
+
+/* Codepoint range (decoded from the file's range table) */
+typedef struct {
+    uint32_t first;              /* First codepoint in range */
+    uint32_t count;              /* Number of codepoints */
+    uint32_t glyph;              /* Glyph index of first codepoint */
+} font_range_t;
+
+/* Loaded font */
+typedef struct {
+    char family[FONT_FILE_FAMILY_SIZE];  /* Family name */
+    int width;                   /* Cell width / largest advance in pixels */
+    int height;                  /* Cell height in pixels (rows * y_scale) */
+    int ascent;                  /* Baseline from top of cell */
+    int rows;                    /* Bitmap rows per glyph */
+    int y_scale;                 /* Pixel rows drawn per bitmap row */
+    int row_bytes;               /* Bytes per bitmap row */
+    int glyph_stride;            /* Bytes per glyph bitmap (rows * row_bytes) */
+    bool monospace;              /* All advances equal width */
+
+    uint32_t glyph_count;        /* Number of glyphs */
+    font_range_t *ranges;        /* Codepoint ranges (owned) */
+    uint32_t range_count;        /* Number of ranges */
+    const uint8_t *advances;     /* Advance per glyph, NULL if monospace built-in */
+    const uint8_t *bitmaps;      /* Glyph bitmaps */
+    uint32_t missing_glyph;      /* Glyph drawn for uncovered codepoints (space) */
+    uint16_t *pages[FONT_PAGE_COUNT];  /* Glyph blocks by codepoint >> 8, NULL until used */
+    uint16_t *blank_page;        /* Block shared by pages the font has no glyphs in */
+
+    void *map;                   /* mmap()ed file, NULL for built-in fonts */
+    size_t map_size;             /* Size of mapping */
+} font_t;
+
+/**
+ * Load installed fonts from a directory
+ * Built-in fonts are always available, whether or not this is called.
+ * @param dir: Directory to scan for FONT_FILE_EXTENSION files (NULL = FONT_DIR)
+ * @return: Number of installed fonts loaded (0 if none or no directory)
+ */
+int font_registry_init(const char *dir);
+
+/**
+ * Unmap all installed fonts
+ */
+void font_registry_cleanup(void);
+
+/**
+ * Find a font by family and cell height
+ * Installed fonts are preferred; with no installed match, the built-in font
+ * closest in height is returned.
+ * @param family: Family name, or NULL/"" for any family
+ * @param height: Cell height in pixels
+ * @return: Font (never NULL)
+ */
+const font_t* font_find(const char *family, int height);
+
+/**
+ * Load a single font file with mmap()
+ * @param path: Path to .erf file
+ * @param font: Output font (release with font_unload)
+ * @return: 0 on success, -1 on error
+ */
+int font_load_file(const char *path, font_t *font);
+
+/**
+ * Release a font loaded by font_load_file
+ * @param font: Font to release
+ */
+void font_unload(font_t *font);
+
+/**
+ * Look up the glyph for a codepoint outside the built glyph blocks
+ * Builds the codepoint's block if it is in the paged range. Use
+ * font_glyph_index() instead.
+ * @param font: Font
+ * @param codepoint: Unicode codepoint
+ * @return: Glyph index
+ */
+uint32_t font_glyph_lookup(const font_t *font, uint32_t codepoint);
+
+/**
+ * Look up the glyph for a codepoint
+ *
+ * Codepoints the font lacks get a look-alike where there is an obvious one
+ * (accented Latin-1 letters, typographic quotes and dashes), and
+ * font->missing_glyph otherwise.
+ *
+ * @param font: Font
+ * @param codepoint: Unicode codepoint
+ * @return: Glyph index
+ */
+static inline uint32_t font_glyph_index(const font_t *font, uint32_t codepoint) {
+    if (codepoint < FONT_PAGED_LIMIT) {
+        const uint16_t *block = font->pages[codepoint >> FONT_PAGE_SHIFT];
+        if (block) {
+            return block[codepoint & (FONT_PAGE_SIZE - 1)];
+        }
+    }
+    return font_glyph_lookup(font, codepoint);
+}
+
+/**
+ * Get the bitmap of a glyph
+ * @param font: Font
+ * @param glyph: Glyph index
+ * @return: Pointer to rows * row_bytes bytes
+ */
+static inline const uint8_t* font_glyph_bitmap(const font_t *font, uint32_t glyph) {
+    return font->bitmaps + (size_t)glyph * font->glyph_stride;
+}
+
+/**
+ * Get the advance width of a glyph
+ * @param font: Font
+ * @param glyph: Glyph index
+ * @return: Advance in pixels
+ */
+static inline int font_glyph_advance(const font_t *font, uint32_t glyph) {
+    return font->advances ? font->advances[glyph] : font->width;
+}
+
+#endif /* FONT_H */
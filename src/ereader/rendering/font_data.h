@@ -9,6 +9,9 @@
  * Each font covers ASCII characters 32-126
  * Bit 7 is leftmost pixel, bit 0 is rightmost pixel
  *
+ * These are the built-in fallback fonts; only font.c includes this file.
+ * Fonts installed in FONT_DIR (see font.h) take precedence.
+ *
  * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
  *
  * This file is part of the Open Source E-Reader project.
@@ -165,17 +168,157 @@ static const uint8_t font_6x12_data[][12] = {
 };
 
 /* =============================================================================
- * MEDIUM FONT: 8x16 pixels (existing font from text_renderer.c)
+ * MEDIUM FONT: 8x16 pixels
  * Balanced between readability and density
  * Approx 47 chars/line, 14 lines/page on 400x300 display
- * This will reference the existing font_8x16 array in text_renderer.c
  * ============================================================================= */
 
 #define FONT_MEDIUM_WIDTH   8
 #define FONT_MEDIUM_HEIGHT  16
+#define FONT_MEDIUM_GLYPHS  59   /* Glyphs drawn for this size (32-90) */
 
-/* Medium font is the existing 8x16 font - declared extern */
-extern const uint8_t font_8x16[][16];
+/* Medium 8x16 font data - ASCII 32-90; 91-126 are composed from the small
+ * font at load time (see font.c) */
+static const uint8_t font_8x16_data[][16] = {
+    /* Space (32) */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    /* ! (33) */
+    {0x00, 0x00, 0x18, 0x3C, 0x3C, 0x3C, 0x18, 0x18,
+     0x18, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00},
+    /* " (34) */
+    {0x00, 0x66, 0x66, 0x66, 0x24, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    /* # (35) */
+    {0x00, 0x00, 0x00, 0x6C, 0x6C, 0xFE, 0x6C, 0x6C,
+     0x6C, 0xFE, 0x6C, 0x6C, 0x00, 0x00, 0x00, 0x00},
+    /* $ (36) */
+    {0x18, 0x18, 0x7C, 0xC6, 0xC2, 0xC0, 0x7C, 0x06,
+     0x06, 0x86, 0xC6, 0x7C, 0x18, 0x18, 0x00, 0x00},
+    /* % (37) */
+    {0x00, 0x00, 0x00, 0x00, 0xC2, 0xC6, 0x0C, 0x18,
+     0x30, 0x60, 0xC6, 0x86, 0x00, 0x00, 0x00, 0x00},
+    /* & (38) */
+    {0x00, 0x00, 0x38, 0x6C, 0x6C, 0x38, 0x76, 0xDC,
+     0xCC, 0xCC, 0xCC, 0x76, 0x00, 0x00, 0x00, 0x00},
+    /* ' (39) */
+    {0x00, 0x30, 0x30, 0x30, 0x60, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    /* ( (40) */
+    {0x00, 0x00, 0x0C, 0x18, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x18, 0x0C, 0x00, 0x00, 0x00, 0x00},
+    /* ) (41) */
+    {0x00, 0x00, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x0C,
+     0x0C, 0x0C, 0x18, 0x30, 0x00, 0x00, 0x00, 0x00},
+    /* * (42) */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x66, 0x3C, 0xFF,
+     0x3C, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    /* + (43) */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x7E,
+     0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    /* , (44) */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x18, 0x18, 0x18, 0x30, 0x00, 0x00, 0x00},
+    /* - (45) */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    /* . (46) */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00},
+    /* / (47) */
+    {0x00, 0x00, 0x00, 0x00, 0x02, 0x06, 0x0C, 0x18,
+     0x30, 0x60, 0xC0, 0x80, 0x00, 0x00, 0x00, 0x00},
+    /* 0-9 (48-57) */
+    {0x00, 0x00, 0x7C, 0xC6, 0xC6, 0xCE, 0xDE, 0xF6,
+     0xE6, 0xC6, 0xC6, 0x7C, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x18, 0x38, 0x78, 0x18, 0x18, 0x18,
+     0x18, 0x18, 0x18, 0x7E, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x7C, 0xC6, 0x06, 0x0C, 0x18, 0x30,
+     0x60, 0xC0, 0xC6, 0xFE, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x7C, 0xC6, 0x06, 0x06, 0x3C, 0x06,
+     0x06, 0x06, 0xC6, 0x7C, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x0C, 0x1C, 0x3C, 0x6C, 0xCC, 0xFE,
+     0x0C, 0x0C, 0x0C, 0x1E, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xFE, 0xC0, 0xC0, 0xC0, 0xFC, 0x06,
+     0x06, 0x06, 0xC6, 0x7C, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x38, 0x60, 0xC0, 0xC0, 0xFC, 0xC6,
+     0xC6, 0xC6, 0xC6, 0x7C, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xFE, 0xC6, 0x06, 0x06, 0x0C, 0x18,
+     0x30, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x7C, 0xC6, 0xC6, 0xC6, 0x7C, 0xC6,
+     0xC6, 0xC6, 0xC6, 0x7C, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x7C, 0xC6, 0xC6, 0xC6, 0x7E, 0x06,
+     0x06, 0x06, 0x0C, 0x78, 0x00, 0x00, 0x00, 0x00},
+    /* : ; < = > ? @ (58-64) */
+    {0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00,
+     0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00,
+     0x00, 0x18, 0x18, 0x30, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x06, 0x0C, 0x18, 0x30, 0x60,
+     0x30, 0x18, 0x0C, 0x06, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x00,
+     0x7E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x60, 0x30, 0x18, 0x0C, 0x06,
+     0x0C, 0x18, 0x30, 0x60, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x7C, 0xC6, 0xC6, 0x0C, 0x18, 0x18,
+     0x18, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x7C, 0xC6, 0xC6, 0xDE, 0xDE, 0xDE,
+     0xDC, 0xC0, 0xC1, 0x7E, 0x00, 0x00, 0x00, 0x00},
+    /* A-Z (65-90) */
+    {0x00, 0x00, 0x10, 0x38, 0x6C, 0xC6, 0xC6, 0xFE,
+     0xC6, 0xC6, 0xC6, 0xC6, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xFC, 0x66, 0x66, 0x66, 0x7C, 0x66,
+     0x66, 0x66, 0x66, 0xFC, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x3C, 0x66, 0xC2, 0xC0, 0xC0, 0xC0,
+     0xC0, 0xC2, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xF8, 0x6C, 0x66, 0x66, 0x66, 0x66,
+     0x66, 0x66, 0x6C, 0xF8, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xFE, 0x66, 0x62, 0x68, 0x78, 0x68,
+     0x60, 0x62, 0x66, 0xFE, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xFE, 0x66, 0x62, 0x68, 0x78, 0x68,
+     0x60, 0x60, 0x60, 0xF0, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x3C, 0x66, 0xC2, 0xC0, 0xC0, 0xDE,
+     0xC6, 0xC6, 0x66, 0x3A, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xC6, 0xC6, 0xC6, 0xC6, 0xFE, 0xC6,
+     0xC6, 0xC6, 0xC6, 0xC6, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x3C, 0x18, 0x18, 0x18, 0x18, 0x18,
+     0x18, 0x18, 0x18, 0x3C, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C,
+     0xCC, 0xCC, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xE6, 0x66, 0x6C, 0x6C, 0x78, 0x78,
+     0x6C, 0x66, 0x66, 0xE6, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xF0, 0x60, 0x60, 0x60, 0x60, 0x60,
+     0x60, 0x62, 0x66, 0xFE, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xC6, 0xEE, 0xFE, 0xFE, 0xD6, 0xC6,
+     0xC6, 0xC6, 0xC6, 0xC6, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xC6, 0xE6, 0xF6, 0xFE, 0xDE, 0xCE,
+     0xC6, 0xC6, 0xC6, 0xC6, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x38, 0x6C, 0xC6, 0xC6, 0xC6, 0xC6,
+     0xC6, 0xC6, 0x6C, 0x38, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xFC, 0x66, 0x66, 0x66, 0x7C, 0x60,
+     0x60, 0x60, 0x60, 0xF0, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x7C, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6,
+     0xC6, 0xD6, 0xDE, 0x7C, 0x0C, 0x0E, 0x00, 0x00},
+    {0x00, 0x00, 0xFC, 0x66, 0x66, 0x66, 0x7C, 0x6C,
+     0x66, 0x66, 0x66, 0xE6, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x7C, 0xC6, 0xC6, 0x60, 0x38, 0x0C,
+     0x06, 0xC6, 0xC6, 0x7C, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x7E, 0x7E, 0x5A, 0x18, 0x18, 0x18,
+     0x18, 0x18, 0x18, 0x3C, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6,
+     0xC6, 0xC6, 0xC6, 0x7C, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6,
+     0xC6, 0x6C, 0x38, 0x10, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xC6, 0xC6, 0xC6, 0xC6, 0xD6, 0xD6,
+     0xD6, 0xFE, 0xEE, 0x6C, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xC6, 0xC6, 0x6C, 0x6C, 0x38, 0x38,
+     0x6C, 0x6C, 0xC6, 0xC6, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x3C, 0x18,
+     0x18, 0x18, 0x18, 0x3C, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xFE, 0xC6, 0x86, 0x0C, 0x18, 0x30,
+     0x60, 0xC2, 0xC6, 0xFE, 0x00, 0x00, 0x00, 0x00},
+    /* Characters 91-126: Use space for now (can be extended later) */
+};
 
 /* =============================================================================
  * LARGE FONT: 10x20 pixels
@@ -186,7 +329,8 @@ extern const uint8_t font_8x16[][16];
 #define FONT_LARGE_WIDTH   10
 #define FONT_LARGE_HEIGHT  20
 
-/* Large 10x20 font data - scaled up from medium for better readability */
+/* Large 10x20 font data - scaled up from medium for better readability
+ * 10 bitmap rows of 2 bytes (10 bits used); each row is drawn twice */
 static const uint8_t font_10x20_data[][20] = {
     /* Space (32) - 10 bits wide stored in uint16_t, but only using 10 bits */
     {0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00},
@@ -307,19 +451,4 @@ static const uint8_t font_10x20_data[][20] = {
     {0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00},
 };
 
-/* Font size enumeration - matches settings_manager.h */
-typedef enum {
-    FONT_SIZE_SMALL = 0,
-    FONT_SIZE_MEDIUM = 1,
-    FONT_SIZE_LARGE = 2
-} font_size_enum_t;
-
-/* Font descriptor structure */
-typedef struct {
-    int width;
-    int height;
-    const uint8_t *data;
-    int char_count;
-} font_descriptor_t;
-
 #endif /* FONT_DATA_H */
@@ -0,0 +1,181 @@
+/*
+ * line_break.c - Line-Break Scanning Kernel Implementation
+ *
+ * SWAR ("SIMD within a register") version: a byte equal to c is found by
+ * XORing a word with c repeated in every byte and testing the result for a
+ * zero byte with the classic (v - 0x01..) & ~v & 0x80.. trick. The test can
+ * flag bytes above a real match, never below it, so on little-endian the
+ * lowest flagged byte is always the first real match.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "line_break.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LINE_BREAK_NEON 1
+#endif
+
+/* Word-at-a-time scanning needs the lowest address in the lowest bits */
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define LINE_BREAK_SWAR 1
+#endif
+
+static inline int is_break(char c) {
+    return c == ' ' || c == '\n' || c == '\t';
+}
+
+static inline int is_stop(char c, int stop_non_ascii) {
+    return is_break(c) || (stop_non_ascii && ((unsigned char)c & 0x80));
+}
+
+#ifdef LINE_BREAK_SWAR
+
+typedef unsigned long word_t;
+
+#define WORD_BYTES  sizeof(word_t)
+#define ONES        ((word_t)-1 / 0xFF)       /* 0x0101...01 */
+#define HIGHS       (ONES * 0x80)             /* 0x8080...80 */
+
+/* Nonzero if any byte of v is zero; lowest flagged byte is the first zero */
+#define HAS_ZERO(v)  (((v) - ONES) & ~(v) & HIGHS)
+
+static inline word_t load_word(const char *p) {
+    word_t w;
+    memcpy(&w, p, sizeof(w));   /* unaligned-safe, compiles to a single load */
+    return w;
+}
+
+/* Byte index of the lowest set bit (mask must be nonzero) */
+static inline size_t first_flagged_byte(word_t mask) {
+    return (size_t)__builtin_ctzl(mask) / 8;
+}
+
+#endif /* LINE_BREAK_SWAR */
+
+/**
+ * Find the next break byte, and optionally the next non-ASCII byte
+ *
+ * stop_non_ascii is a constant at each call site, so the extra test is
+ * compiled out of line_break_find().
+ */
+static inline size_t find_stop(const char *text, size_t pos, size_t length,
+                               int stop_non_ascii) {
+#ifdef LINE_BREAK_NEON
+    const uint8x16_t space = vdupq_n_u8(' ');
+    const uint8x16_t newline = vdupq_n_u8('\n');
+    const uint8x16_t tab = vdupq_n_u8('\t');
+
+    while (pos + 16 <= length) {
+        uint8x16_t v = vld1q_u8((const uint8_t *)text + pos);
+        uint8x16_t eq = vorrq_u8(vorrq_u8(vceqq_u8(v, space), vceqq_u8(v, newline)),
+                                 vceqq_u8(v, tab));
+        if (stop_non_ascii) {
+            eq = vorrq_u8(eq, vtstq_u8(v, vdupq_n_u8(0x80)));
+        }
+
+        /* Narrow each 0x00/0xFF byte to a nibble: one 64-bit mask, 4 bits per byte */
+        uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+        if (mask) {
+            return pos + (size_t)__builtin_ctzll(mask) / 4;
+        }
+        pos += 16;
+    }
+#elif defined(LINE_BREAK_SWAR)
+    while (pos + WORD_BYTES <= length) {
+        word_t w = load_word(text + pos);
+        word_t mask = HAS_ZERO(w ^ (ONES * ' ')) |
+                      HAS_ZERO(w ^ (ONES * '\n')) |
+                      HAS_ZERO(w ^ (ONES * '\t'));
+        if (stop_non_ascii) {
+            /* Bit 7 set exactly on non-ASCII bytes; HAS_ZERO never flags
+             * below the first real match, so the lowest flag still wins */
+            mask |= w & HIGHS;
+        }
+        if (mask) {
+            return pos + first_flagged_byte(mask);
+        }
+        pos += WORD_BYTES;
+    }
+#endif
+
+    /* Tail (and big-endian fallback) */
+    while (pos < length && !is_stop(text[pos], stop_non_ascii)) {
+        pos++;
+    }
+    return pos;
+}
+
+/**
+ * Find the next break byte (' ', '\n' or '\t')
+ */
+size_t line_break_find(const char *text, size_t pos, size_t length) {
+    return find_stop(text, pos, length, 0);
+}
+
+/**
+ * Find the next break byte or non-ASCII byte
+ */
+size_t line_break_find_ascii(const char *text, size_t pos, size_t length) {
+    return find_stop(text, pos, length, 1);
+}
+
+/**
+ * Skip a run of spaces
+ */
+size_t line_break_skip_spaces(const char *text, size_t pos, size_t length) {
+    /* Most runs are a single space: check two bytes before a word scan */
+    if (pos >= length || text[pos] != ' ') return pos;
+    pos++;
+    if (pos >= length || text[pos] != ' ') return pos;
+
+#ifdef LINE_BREAK_SWAR
+    while (pos + WORD_BYTES <= length) {
+        word_t diff = load_word(text + pos) ^ (ONES * ' ');
+        if (diff) {
+            /* The lowest set bit lies in the first non-space byte */
+            return pos + first_flagged_byte(diff);
+        }
+        pos += WORD_BYTES;
+    }
+#endif
+
+    while (pos < length && text[pos] == ' ') {
+        pos++;
+    }
+    return pos;
+}
+
+/**
+ * Get the name of the compiled-in scanning implementation
+ */
+const char* line_break_impl_name(void) {
+#if defined(LINE_BREAK_NEON)
+    return "neon";
+#elif defined(LINE_BREAK_SWAR)
+    return "swar";
+#else
+    return "bytewise";
+#endif
+}
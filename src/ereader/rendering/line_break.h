@@ -0,0 +1,72 @@
+/*
+ * line_break.h - Line-Break Scanning Kernel
+ *
+ * Finds the bytes that matter to line breaking (space, newline, tab) a
+ * machine word at a time instead of a byte at a time. Used by the text
+ * layout code; the scan is the hot loop of a full-book re-layout.
+ *
+ * Implementations:
+ * - NEON (ARMv7 with NEON, AArch64): 16 bytes per step
+ * - SWAR (ARMv6 / Pi Zero, other targets): sizeof(unsigned long) bytes per step
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef LINE_BREAK_H
+#define LINE_BREAK_H
+
+#include <stddef.h>
+
+/**
+ * Find the next break byte (' ', '\n' or '\t')
+ * @param text: Text to scan (need not be NUL-terminated)
+ * @param pos: Offset to start scanning from
+ * @param length: Length of text in bytes
+ * @return: Offset of the first break byte at or after pos, or length if none
+ */
+size_t line_break_find(const char *text, size_t pos, size_t length);
+
+/**
+ * Find the next break byte or non-ASCII byte (>= 0x80)
+ * Lets the caller measure ASCII words from their length alone and decode
+ * UTF-8 only in words that need it.
+ * @param text: Text to scan (need not be NUL-terminated)
+ * @param pos: Offset to start scanning from
+ * @param length: Length of text in bytes
+ * @return: Offset of the first such byte at or after pos, or length if none
+ */
+size_t line_break_find_ascii(const char *text, size_t pos, size_t length);
+
+/**
+ * Skip a run of spaces
+ * @param text: Text to scan (need not be NUL-terminated)
+ * @param pos: Offset to start scanning from
+ * @param length: Length of text in bytes
+ * @return: Offset of the first non-space byte at or after pos, or length if none
+ */
+size_t line_break_skip_spaces(const char *text, size_t pos, size_t length);
+
+/**
+ * Get the name of the compiled-in scanning implementation
+ * @return: "neon" or "swar"
+ */
+const char* line_break_impl_name(void);
+
+#endif /* LINE_BREAK_H */
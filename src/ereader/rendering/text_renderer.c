@@ -29,237 +29,312 @@
 #include <string.h>
 #include <ctype.h>
 #include "text_renderer.h"
-#include "font_data.h"
-
-/* Global state for current font size */
-static text_font_size_t current_font_size = TEXT_FONT_SIZE_MEDIUM;
-
-/* Embedded 8x16 bitmap font - Basic ASCII characters (32-90) */
-/* Each character is 16 bytes (8 pixels wide x 16 pixels tall) */
-/* Bit 7 is leftmost pixel, bit 0 is rightmost pixel */
-static const uint8_t font_8x16[][16] = {
-    /* Space (32) */
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
-    /* ! (33) */
-    {0x00, 0x00, 0x18, 0x3C, 0x3C, 0x3C, 0x18, 0x18,
-     0x18, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00},
-    /* " (34) */
-    {0x00, 0x66, 0x66, 0x66, 0x24, 0x00, 0x00, 0x00,
-     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
-    /* # (35) */
-    {0x00, 0x00, 0x00, 0x6C, 0x6C, 0xFE, 0x6C, 0x6C,
-     0x6C, 0xFE, 0x6C, 0x6C, 0x00, 0x00, 0x00, 0x00},
-    /* $ (36) */
-    {0x18, 0x18, 0x7C, 0xC6, 0xC2, 0xC0, 0x7C, 0x06,
-     0x06, 0x86, 0xC6, 0x7C, 0x18, 0x18, 0x00, 0x00},
-    /* % (37) */
-    {0x00, 0x00, 0x00, 0x00, 0xC2, 0xC6, 0x0C, 0x18,
-     0x30, 0x60, 0xC6, 0x86, 0x00, 0x00, 0x00, 0x00},
-    /* & (38) */
-    {0x00, 0x00, 0x38, 0x6C, 0x6C, 0x38, 0x76, 0xDC,
-     0xCC, 0xCC, 0xCC, 0x76, 0x00, 0x00, 0x00, 0x00},
-    /* ' (39) */
-    {0x00, 0x30, 0x30, 0x30, 0x60, 0x00, 0x00, 0x00,
-     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
-    /* ( (40) */
-    {0x00, 0x00, 0x0C, 0x18, 0x30, 0x30, 0x30, 0x30,
-     0x30, 0x30, 0x18, 0x0C, 0x00, 0x00, 0x00, 0x00},
-    /* ) (41) */
-    {0x00, 0x00, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x0C,
-     0x0C, 0x0C, 0x18, 0x30, 0x00, 0x00, 0x00, 0x00},
-    /* * (42) */
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x66, 0x3C, 0xFF,
-     0x3C, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
-    /* + (43) */
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x7E,
-     0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
-    /* , (44) */
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-     0x00, 0x18, 0x18, 0x18, 0x30, 0x00, 0x00, 0x00},
-    /* - (45) */
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE,
-     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
-    /* . (46) */
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-     0x00, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00},
-    /* / (47) */
-    {0x00, 0x00, 0x00, 0x00, 0x02, 0x06, 0x0C, 0x18,
-     0x30, 0x60, 0xC0, 0x80, 0x00, 0x00, 0x00, 0x00},
-    /* 0-9 (48-57) */
-    {0x00, 0x00, 0x7C, 0xC6, 0xC6, 0xCE, 0xDE, 0xF6,
-     0xE6, 0xC6, 0xC6, 0x7C, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x18, 0x38, 0x78, 0x18, 0x18, 0x18,
-     0x18, 0x18, 0x18, 0x7E, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x7C, 0xC6, 0x06, 0x0C, 0x18, 0x30,
-     0x60, 0xC0, 0xC6, 0xFE, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x7C, 0xC6, 0x06, 0x06, 0x3C, 0x06,
-     0x06, 0x06, 0xC6, 0x7C, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x0C, 0x1C, 0x3C, 0x6C, 0xCC, 0xFE,
-     0x0C, 0x0C, 0x0C, 0x1E, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xFE, 0xC0, 0xC0, 0xC0, 0xFC, 0x06,
-     0x06, 0x06, 0xC6, 0x7C, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x38, 0x60, 0xC0, 0xC0, 0xFC, 0xC6,
-     0xC6, 0xC6, 0xC6, 0x7C, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xFE, 0xC6, 0x06, 0x06, 0x0C, 0x18,
-     0x30, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x7C, 0xC6, 0xC6, 0xC6, 0x7C, 0xC6,
-     0xC6, 0xC6, 0xC6, 0x7C, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x7C, 0xC6, 0xC6, 0xC6, 0x7E, 0x06,
-     0x06, 0x06, 0x0C, 0x78, 0x00, 0x00, 0x00, 0x00},
-    /* : ; < = > ? @ (58-64) */
-    {0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00,
-     0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00,
-     0x00, 0x18, 0x18, 0x30, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x00, 0x06, 0x0C, 0x18, 0x30, 0x60,
-     0x30, 0x18, 0x0C, 0x06, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x00,
-     0x7E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x00, 0x60, 0x30, 0x18, 0x0C, 0x06,
-     0x0C, 0x18, 0x30, 0x60, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x7C, 0xC6, 0xC6, 0x0C, 0x18, 0x18,
-     0x18, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x7C, 0xC6, 0xC6, 0xDE, 0xDE, 0xDE,
-     0xDC, 0xC0, 0xC1, 0x7E, 0x00, 0x00, 0x00, 0x00},
-    /* A-Z (65-90) */
-    {0x00, 0x00, 0x10, 0x38, 0x6C, 0xC6, 0xC6, 0xFE,
-     0xC6, 0xC6, 0xC6, 0xC6, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xFC, 0x66, 0x66, 0x66, 0x7C, 0x66,
-     0x66, 0x66, 0x66, 0xFC, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x3C, 0x66, 0xC2, 0xC0, 0xC0, 0xC0,
-     0xC0, 0xC2, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xF8, 0x6C, 0x66, 0x66, 0x66, 0x66,
-     0x66, 0x66, 0x6C, 0xF8, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xFE, 0x66, 0x62, 0x68, 0x78, 0x68,
-     0x60, 0x62, 0x66, 0xFE, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xFE, 0x66, 0x62, 0x68, 0x78, 0x68,
-     0x60, 0x60, 0x60, 0xF0, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x3C, 0x66, 0xC2, 0xC0, 0xC0, 0xDE,
-     0xC6, 0xC6, 0x66, 0x3A, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xC6, 0xC6, 0xC6, 0xC6, 0xFE, 0xC6,
-     0xC6, 0xC6, 0xC6, 0xC6, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x3C, 0x18, 0x18, 0x18, 0x18, 0x18,
-     0x18, 0x18, 0x18, 0x3C, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C,
-     0xCC, 0xCC, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xE6, 0x66, 0x6C, 0x6C, 0x78, 0x78,
-     0x6C, 0x66, 0x66, 0xE6, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xF0, 0x60, 0x60, 0x60, 0x60, 0x60,
-     0x60, 0x62, 0x66, 0xFE, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xC6, 0xEE, 0xFE, 0xFE, 0xD6, 0xC6,
-     0xC6, 0xC6, 0xC6, 0xC6, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xC6, 0xE6, 0xF6, 0xFE, 0xDE, 0xCE,
-     0xC6, 0xC6, 0xC6, 0xC6, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x38, 0x6C, 0xC6, 0xC6, 0xC6, 0xC6,
-     0xC6, 0xC6, 0x6C, 0x38, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xFC, 0x66, 0x66, 0x66, 0x7C, 0x60,
-     0x60, 0x60, 0x60, 0xF0, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x7C, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6,
-     0xC6, 0xD6, 0xDE, 0x7C, 0x0C, 0x0E, 0x00, 0x00},
-    {0x00, 0x00, 0xFC, 0x66, 0x66, 0x66, 0x7C, 0x6C,
-     0x66, 0x66, 0x66, 0xE6, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x7C, 0xC6, 0xC6, 0x60, 0x38, 0x0C,
-     0x06, 0xC6, 0xC6, 0x7C, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x7E, 0x7E, 0x5A, 0x18, 0x18, 0x18,
-     0x18, 0x18, 0x18, 0x3C, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6,
-     0xC6, 0xC6, 0xC6, 0x7C, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6,
-     0xC6, 0x6C, 0x38, 0x10, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xC6, 0xC6, 0xC6, 0xC6, 0xD6, 0xD6,
-     0xD6, 0xFE, 0xEE, 0x6C, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xC6, 0xC6, 0x6C, 0x6C, 0x38, 0x38,
-     0x6C, 0x6C, 0xC6, 0xC6, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x3C, 0x18,
-     0x18, 0x18, 0x18, 0x3C, 0x00, 0x00, 0x00, 0x00},
-    {0x00, 0x00, 0xFE, 0xC6, 0x86, 0x0C, 0x18, 0x30,
-     0x60, 0xC2, 0xC6, 0xFE, 0x00, 0x00, 0x00, 0x00},
-    /* Characters 91-126: Use space for now (can be extended later) */
+#include "line_break.h"
+#include "utf8.h"
+
+/* Default layout parameters used by the UI (text_render_string, FONT_WIDTH, ...);
+ * metrics are derived on first use, see ui_layout() */
+static layout_params_t ui_params = {
+    .font_size      = TEXT_FONT_SIZE_MEDIUM,
+    .line_spacing   = LINE_SPACING,
+    .margin_top     = MARGIN_TOP,
+    .margin_bottom  = MARGIN_BOTTOM,
+    .margin_left    = MARGIN_LEFT,
+    .margin_right   = MARGIN_RIGHT,
+    .screen_width   = FB_WIDTH,
+    .screen_height  = FB_HEIGHT,
 };
+static bool ui_params_ready = false;
+
+/**
+ * Get the UI layout parameters, deriving their metrics on first use
+ */
+static const layout_params_t* ui_layout(void) {
+    if (!ui_params_ready) {
+        text_layout_params_update(&ui_params);
+        ui_params_ready = true;
+    }
+    return &ui_params;
+}
+
+/**
+ * Advance of a character
+ */
+static inline int char_advance(const layout_params_t *params, uint32_t cp) {
+    if (cp == '\t') return params->tab_width;
+    if (params->monospace) return params->font_width;
+    return font_glyph_advance(params->font, font_glyph_index(params->font, cp));
+}
 
 /**
  * Initialize the text renderer
  */
 int text_renderer_init(void) {
-    /* Font is embedded, no initialization needed */
+    /* Built-in fonts need no setup; map any installed ones */
+    font_registry_init(FONT_DIR);
+
+    /* Re-derive UI metrics now that installed fonts are known */
+    text_layout_params_update(&ui_params);
+    ui_params_ready = true;
+
     return 0;
 }
 
 /**
- * Render a single character to the framebuffer
+ * Release renderer resources (unmaps installed fonts)
  */
-int text_render_char(framebuffer_t *fb, int x, int y, char c, uint8_t color) {
-    if (!fb) return -1;
+void text_renderer_cleanup(void) {
+    /* Fall back to built-in fonts before the installed ones go away */
+    font_registry_cleanup();
+    text_layout_params_update(&ui_params);
+}
 
-    /* Map character to font array index */
-    int char_index;
-    if (c < FONT_FIRST_CHAR || c > FONT_LAST_CHAR) {
-        char_index = 0;  /* Space for unsupported characters */
-    } else {
-        char_index = c - FONT_FIRST_CHAR;
+/* =============================================================================
+ * Layout Parameters
+ * ============================================================================= */
+
+/**
+ * Initialize layout parameters with the default screen geometry
+ */
+void text_layout_params_init(layout_params_t *params, text_font_size_t font_size) {
+    if (!params) return;
+
+    memset(params, 0, sizeof(*params));
+    params->font_size = font_size;
+    params->line_spacing = LINE_SPACING;
+    params->margin_top = MARGIN_TOP;
+    params->margin_bottom = MARGIN_BOTTOM;
+    params->margin_left = MARGIN_LEFT;
+    params->margin_right = MARGIN_RIGHT;
+    params->screen_width = FB_WIDTH;
+    params->screen_height = FB_HEIGHT;
+
+    text_layout_params_update(params);
+}
+
+/**
+ * Initialize layout parameters from user settings
+ */
+void text_layout_params_from_settings(layout_params_t *params, const settings_t *settings) {
+    if (!params) return;
+
+    if (!settings) {
+        text_layout_params_init(params, TEXT_FONT_SIZE_MEDIUM);
+        return;
+    }
+
+    switch (settings->font_size) {
+        case FONT_SIZE_SMALL: text_layout_params_init(params, TEXT_FONT_SIZE_SMALL);  break;
+        case FONT_SIZE_LARGE: text_layout_params_init(params, TEXT_FONT_SIZE_LARGE);  break;
+        default:              text_layout_params_init(params, TEXT_FONT_SIZE_MEDIUM); break;
+    }
+
+    /* Margins: narrow halves and wide doubles the default screen margins */
+    switch (settings->margins) {
+        case MARGINS_NARROW:
+            params->margin_top = MARGIN_TOP / 2;
+            params->margin_bottom = MARGIN_BOTTOM / 2;
+            params->margin_left = MARGIN_LEFT / 2;
+            params->margin_right = MARGIN_RIGHT / 2;
+            break;
+        case MARGINS_WIDE:
+            params->margin_top = MARGIN_TOP * 3 / 2;
+            params->margin_bottom = MARGIN_BOTTOM * 3 / 2;
+            params->margin_left = MARGIN_LEFT * 2;
+            params->margin_right = MARGIN_RIGHT * 2;
+            break;
+        default:
+            break;
     }
 
-    /* Get current font dimensions */
-    int font_width = text_renderer_get_font_width();
-    int font_height = text_renderer_get_font_height();
+    /* Line spacing is relative to the glyph height */
+    switch (settings->line_spacing) {
+        case LINE_SPACING_1_5:    params->line_spacing = params->font_height / 2; break;
+        case LINE_SPACING_DOUBLE: params->line_spacing = params->font_height;     break;
+        default:                  break;
+    }
+
+    text_layout_params_update(params);
+}
+
+/**
+ * Recompute derived metrics after changing the inputs of a parameter set
+ */
+void text_layout_params_update(layout_params_t *params) {
+    if (!params) return;
 
-    /* Render character based on current font size */
-    switch (current_font_size) {
+    int nominal_height;
+    switch (params->font_size) {
         case TEXT_FONT_SIZE_SMALL:
-            /* Small font: 6x12 */
-            for (int row = 0; row < font_height && row < 12; row++) {
-                uint8_t byte = (char_index < 95) ? font_6x12_data[char_index][row] : 0;
-                for (int col = 0; col < font_width && col < 8; col++) {
-                    if (byte & (0x80 >> col)) {
-                        fb_set_pixel(fb, x + col, y + row, color);
-                    }
-                }
-            }
+            nominal_height = FONT_SIZE_SMALL_HEIGHT;
             break;
-
         case TEXT_FONT_SIZE_LARGE:
-            /* Large font: 10x20 - uses 2 bytes per row */
-            for (int row = 0; row < font_height && row < 20; row++) {
-                if (char_index < 95) {
-                    /* Large font uses 2 bytes per row (10 pixels wide) */
-                    uint16_t word = (font_10x20_data[char_index][row * 2] << 8) |
-                                     font_10x20_data[char_index][row * 2 + 1];
-                    for (int col = 0; col < font_width && col < 10; col++) {
-                        if (word & (0x8000 >> col)) {
-                            fb_set_pixel(fb, x + col, y + row, color);
-                        }
-                    }
-                }
-            }
+            nominal_height = FONT_SIZE_LARGE_HEIGHT;
             break;
-
         case TEXT_FONT_SIZE_MEDIUM:
         default:
-            /* Medium font: 8x16 (existing font) */
-            for (int row = 0; row < font_height && row < 16; row++) {
-                uint8_t byte = (char_index <= 58) ? font_8x16[char_index][row] : 0;
-                for (int col = 0; col < font_width && col < 8; col++) {
-                    if (byte & (0x80 >> col)) {
-                        fb_set_pixel(fb, x + col, y + row, color);
+            params->font_size = TEXT_FONT_SIZE_MEDIUM;
+            nominal_height = FONT_SIZE_MEDIUM_HEIGHT;
+            break;
+    }
+
+    params->font = font_find(params->font_family, nominal_height);
+    params->monospace = params->font->monospace;
+    params->font_width = params->font->width;
+    params->font_height = params->font->height;
+
+    params->tab_width = params->font_width * TAB_WIDTH_CHARS;
+    params->area_width = params->screen_width - params->margin_left - params->margin_right;
+    params->area_height = params->screen_height - params->margin_top - params->margin_bottom;
+    if (params->area_width < params->font_width) params->area_width = params->font_width;
+    if (params->area_height < params->font_height) params->area_height = params->font_height;
+
+    params->line_height = params->font_height + params->line_spacing;
+    params->chars_per_line = params->area_width / params->font_width;
+    params->lines_per_page = params->area_height / params->line_height;
+    if (params->lines_per_page > MAX_LINES_IN_PAGE) params->lines_per_page = MAX_LINES_IN_PAGE;
+    if (params->lines_per_page < 1) params->lines_per_page = 1;
+}
+
+/**
+ * FNV-1a over a run of bytes, continuing from h
+ */
+static uint32_t layout_hash(uint32_t h, const void *data, size_t length) {
+    const uint8_t *p = data;
+    for (size_t i = 0; i < length; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * Fingerprint everything that decides where lines and pages break
+ */
+uint32_t text_layout_key(const layout_params_t *params) {
+    if (!params || !params->font) return 0;
+
+    const font_t *font = params->font;
+    int32_t fields[] = {
+        TEXT_LAYOUT_REVISION,
+        font->width, font->height, font->monospace, (int32_t)font->glyph_count,
+        params->area_width, params->line_height, params->lines_per_page, params->tab_width
+    };
+
+    uint32_t h = layout_hash(2166136261u, fields, sizeof(fields));
+    h = layout_hash(h, font->family, strnlen(font->family, sizeof(font->family)));
+
+    /* Glyph widths and the codepoints they belong to */
+    h = layout_hash(h, font->ranges, font->range_count * sizeof(font_range_t));
+    if (font->advances) {
+        h = layout_hash(h, font->advances, font->glyph_count);
+    }
+    return h;
+}
+
+/**
+ * Get the default layout parameters used by the UI
+ */
+const layout_params_t* text_renderer_get_params(void) {
+    return ui_layout();
+}
+
+/* =============================================================================
+ * Rendering
+ * ============================================================================= */
+
+/**
+ * Draw a glyph bitmap with its top-left corner at (x, y)
+ *
+ * Glyph rows are stored in the framebuffer's bit order, so a glyph that
+ * lies fully on screen is drawn by shifting each row into place and
+ * merging it a byte at a time. Glyphs crossing the screen edge are drawn
+ * pixel by pixel, which clips them.
+ */
+static void blit_glyph(framebuffer_t *fb, const font_t *font, const uint8_t *bitmap,
+                       int x, int y, uint8_t color) {
+    const int stride = FB_WIDTH / 8;
+    int shift = x & 7;
+    int nbytes = font->row_bytes + (shift ? 1 : 0);
+
+    if (x < 0 || y < 0 || y + font->height > FB_HEIGHT || (x >> 3) + nbytes > stride) {
+        for (int row = 0; row < font->rows; row++) {
+            const uint8_t *src = bitmap + row * font->row_bytes;
+            for (int col = 0; col < font->row_bytes * 8; col++) {
+                if (src[col >> 3] & (0x80 >> (col & 7))) {
+                    for (int rep = 0; rep < font->y_scale; rep++) {
+                        fb_set_pixel(fb, x + col, y + row * font->y_scale + rep, color);
                     }
                 }
             }
-            break;
+        }
+        return;
     }
 
-    return font_width;
+    uint8_t *dst = fb->data + y * stride + (x >> 3);
+    for (int row = 0; row < font->rows; row++, dst += stride * font->y_scale) {
+        const uint8_t *src = bitmap + row * font->row_bytes;
+
+        /* Row bits left-aligned in 64 bits, then shifted to the pixel column */
+        uint64_t bits = 0;
+        for (int b = 0; b < font->row_bytes; b++) {
+            bits |= (uint64_t)src[b] << (56 - 8 * b);
+        }
+        if (!bits) continue;
+        bits >>= shift;
+
+        for (int rep = 0; rep < font->y_scale; rep++) {
+            uint8_t *d = dst + rep * stride;
+            for (int b = 0; b < nbytes; b++) {
+                uint8_t mask = (uint8_t)(bits >> (56 - 8 * b));
+                if (color == COLOR_BLACK) {
+                    d[b] |= mask;
+                } else {
+                    d[b] &= (uint8_t)~mask;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Render a single character to the framebuffer
+ */
+int text_render_char(framebuffer_t *fb, const layout_params_t *params,
+                     int x, int y, char c, uint8_t color) {
+    return text_render_codepoint(fb, params, x, y, (unsigned char)c, color);
+}
+
+/**
+ * Render a Unicode character to the framebuffer
+ */
+int text_render_codepoint(framebuffer_t *fb, const layout_params_t *params,
+                          int x, int y, uint32_t cp, uint8_t color) {
+    if (!fb || !params || !params->font) return -1;
+
+    const font_t *font = params->font;
+    uint32_t glyph = font_glyph_index(font, cp);
+
+    blit_glyph(fb, font, font_glyph_bitmap(font, glyph), x, y, color);
+
+    return params->monospace ? params->font_width : font_glyph_advance(font, glyph);
 }
 
 /**
  * Render a string to the framebuffer (no word wrapping)
  */
 int text_render_string(framebuffer_t *fb, int x, int y, const char *text, uint8_t color) {
-    if (!fb || !text) return 0;
+    return text_render_line(fb, ui_layout(), x, y, text, color);
+}
+
+/**
+ * Render a string to the framebuffer with explicit layout parameters
+ */
+int text_render_line(framebuffer_t *fb, const layout_params_t *params,
+                     int x, int y, const char *text, uint8_t color) {
+    if (!fb || !params || !text) return 0;
 
-    int font_width = text_renderer_get_font_width();
-    int font_height = text_renderer_get_font_height();
-    int line_height = font_height + LINE_SPACING;
+    int line_height = params->line_height;
 
     int cur_x = x;
     int count = 0;
@@ -269,16 +344,18 @@ int text_render_string(framebuffer_t *fb, int x, int y, const char *text, uint8_
             /* Newline: move to next line */
             cur_x = x;
             y += line_height;
+            text++;
         } else if (*text == '\t') {
-            /* Tab: advance by 4 character widths */
-            cur_x += font_width * 4;
+            /* Tab: advance by TAB_WIDTH_CHARS character widths */
+            cur_x += params->tab_width;
+            text++;
         } else {
-            /* Regular character */
-            text_render_char(fb, cur_x, y, *text, color);
-            cur_x += font_width;
+            /* Regular character (ASCII or a UTF-8 sequence) */
+            uint32_t cp;
+            text += utf8_decode(text, SIZE_MAX, &cp);
+            cur_x += text_render_codepoint(fb, params, cur_x, y, cp, color);
             count++;
         }
-        text++;
     }
 
     return count;
@@ -287,20 +364,19 @@ int text_render_string(framebuffer_t *fb, int x, int y, const char *text, uint8_
 /**
  * Measure the width of a string in pixels
  */
-int text_measure_width(const char *text, int length) {
-    if (!text) return 0;
+int text_measure_width(const layout_params_t *params, const char *text, int length) {
+    if (!params || !text) return 0;
 
-    int font_width = text_renderer_get_font_width();
+    size_t avail = (length < 0) ? SIZE_MAX : (size_t)length;
     int width = 0;
-    int i = 0;
+    size_t i = 0;
 
-    while (text[i] && (length < 0 || i < length)) {
-        if (text[i] == '\t') {
-            width += font_width * 4;
-        } else if (text[i] != '\n') {
-            width += font_width;
+    while (i < avail && text[i]) {
+        uint32_t cp;
+        i += utf8_decode(text + i, avail - i, &cp);
+        if (cp != '\n') {
+            width += char_advance(params, cp);
         }
-        i++;
     }
 
     return width;
@@ -309,39 +385,111 @@ int text_measure_width(const char *text, int length) {
 /**
  * Get the number of characters that fit in a given width
  */
-int text_chars_in_width(const char *text, int max_width) {
-    if (!text) return 0;
+int text_chars_in_width(const layout_params_t *params, const char *text, int max_width) {
+    if (!params || !text) return 0;
 
-    int font_width = text_renderer_get_font_width();
     int width = 0;
-    int count = 0;
+    size_t count = 0;
 
     while (text[count]) {
-        int char_width = (text[count] == '\t') ? (font_width * 4) : font_width;
+        uint32_t cp;
+        size_t len = utf8_decode(text + count, SIZE_MAX, &cp);
+        int char_width = char_advance(params, cp);
         if (width + char_width > max_width) {
             break;
         }
         width += char_width;
-        count++;
+        count += len;
     }
 
-    return count;
+    return (int)count;
+}
+
+/**
+ * Find the end of the word at pos and measure it
+ *
+ * Words end at a space or newline; a tab stays part of its word but is
+ * wider. With a monospace font the width follows from the character count
+ * and tab count, so only the break bytes are looked at (see line_break.c);
+ * characters are counted by decoding only in words with non-ASCII bytes.
+ * A proportional font sums the advance of each character.
+ *
+ * @param params: Layout parameters
+ * @param text: Source text
+ * @param pos: Offset of the first byte of the word
+ * @param limit: Offset to stop scanning at
+ * @param width: Output width of the scanned part of the word in pixels
+ * @return: Offset just past the word (or limit)
+ */
+static size_t scan_word(const layout_params_t *params, const char *text,
+                        size_t pos, size_t limit, int *width) {
+    size_t start = pos;
+    int tabs = 0;
+    bool ascii = true;
+
+    for (;;) {
+        /* Look for non-ASCII bytes only until the first one turns up */
+        pos = ascii ? line_break_find_ascii(text, pos, limit)
+                    : line_break_find(text, pos, limit);
+        if (pos < limit && text[pos] == '\t') {
+            tabs++;
+            pos++;
+            continue;
+        }
+        if (pos < limit && ((unsigned char)text[pos] & 0x80)) {
+            ascii = false;
+            pos++;
+            continue;
+        }
+        break;
+    }
+
+    if (params->monospace) {
+        size_t chars = ascii ? pos - start : utf8_length(text + start, pos - start);
+        *width = (int)chars * params->font_width +
+                 tabs * (params->tab_width - params->font_width);
+    } else {
+        *width = text_measure_width(params, text + start, (int)(pos - start));
+    }
+    return pos;
+}
+
+/**
+ * Render length bytes of text on one line
+ * @return: X coordinate after the last character
+ */
+static int render_run(framebuffer_t *fb, const layout_params_t *params, int x, int y,
+                      const char *text, int length, uint8_t color) {
+    const char *end = text + length;
+
+    while (text < end) {
+        if (*text == '\t') {
+            x += params->tab_width;
+            text++;
+            continue;
+        }
+        uint32_t cp;
+        text += utf8_decode(text, (size_t)(end - text), &cp);
+        x += text_render_codepoint(fb, params, x, y, cp, color);
+    }
+
+    return x;
 }
 
 /**
  * Render a string with word wrapping
  */
-int text_render_wrapped(framebuffer_t *fb, int x, int y, const char *text,
-                       int max_width, uint8_t color) {
-    if (!fb || !text) return 0;
+int text_render_wrapped(framebuffer_t *fb, const layout_params_t *params,
+                        int x, int y, const char *text, int max_width, uint8_t color) {
+    if (!fb || !params || !text) return 0;
 
-    int font_width = text_renderer_get_font_width();
-    int font_height = text_renderer_get_font_height();
-    int line_height = font_height + LINE_SPACING;
+    int line_height = params->line_height;
+    int space_width = char_advance(params, ' ');
 
     int cur_x = x;
     int cur_y = y;
     int line_count = 0;
+    size_t length = strlen(text);
     const char *p = text;
 
     while (*p) {
@@ -361,14 +509,12 @@ int text_render_wrapped(framebuffer_t *fb, int x, int y, const char *text,
             continue;
         }
 
-        /* Find end of current word */
+        /* Find end of current word and measure it */
         const char *word_start = p;
-        while (*p && *p != ' ' && *p != '\n') p++;
+        int word_width;
+        p = text + scan_word(params, text, (size_t)(p - text), length, &word_width);
         int word_len = p - word_start;
 
-        /* Measure word width */
-        int word_width = text_measure_width(word_start, word_len);
-
         /* Check if word fits on current line */
         if (cur_x + word_width > x + max_width) {
             /* Word doesn't fit, wrap to next line */
@@ -379,11 +525,9 @@ int text_render_wrapped(framebuffer_t *fb, int x, int y, const char *text,
                 line_count++;
             } else {
                 /* Word is too long for one line, break it */
-                int chars_fit = text_chars_in_width(word_start, max_width);
-                for (int i = 0; i < chars_fit; i++) {
-                    text_render_char(fb, cur_x, cur_y, word_start[i], color);
-                    cur_x += font_width;
-                }
+                int chars_fit = text_chars_in_width(params, word_start, max_width);
+                if (chars_fit < 1) chars_fit = 1;
+                cur_x = render_run(fb, params, cur_x, cur_y, word_start, chars_fit, color);
                 p = word_start + chars_fit;
                 cur_x = x;
                 cur_y += line_height;
@@ -393,14 +537,11 @@ int text_render_wrapped(framebuffer_t *fb, int x, int y, const char *text,
         }
 
         /* Render the word */
-        for (int i = 0; i < word_len; i++) {
-            text_render_char(fb, cur_x, cur_y, word_start[i], color);
-            cur_x += font_width;
-        }
+        cur_x = render_run(fb, params, cur_x, cur_y, word_start, word_len, color);
 
         /* Skip trailing space */
         if (*p == ' ') {
-            cur_x += font_width;
+            cur_x += space_width;
             p++;
         }
     }
@@ -408,129 +549,517 @@ int text_render_wrapped(framebuffer_t *fb, int x, int y, const char *text,
     return line_count + 1;
 }
 
+/*
+ * Line layout
+ *
+ * Layout works on byte offsets into the source text rather than on
+ * NUL-terminated strings, so a line can be re-laid out from any line start
+ * without touching the rest of the book. A line only depends on the offset
+ * it starts from, which is what makes anchored and lazy pagination possible.
+ */
+
+/**
+ * Lay out one line starting at or after pos
+ *
+ * Leading spaces and empty paragraphs are skipped, words are joined with a
+ * single space, and a word wider than the whole line is broken. A newline
+ * that ends the line is consumed.
+ *
+ * @param params: Layout parameters
+ * @param text: Source text
+ * @param length: Length of source text in bytes
+ * @param pos: Offset to start from
+ * @param max_width: Maximum line width in pixels
+ * @param line_start: Output offset of the first character on the line
+ * @param out: Output buffer of MAX_LINE_LENGTH bytes, or NULL to only measure
+ * @param out_len: Output number of characters on the line (0 at end of text)
+ * @return: Offset where the next line starts
+ */
+static size_t layout_line(const layout_params_t *params, const char *text, size_t length,
+                          size_t pos, int max_width, size_t *line_start,
+                          char *out, int *out_len) {
+    int space_width = char_advance(params, ' ');
+    int line_pos = 0;
+    int line_width = 0;
+
+    /* A word longer than this cannot fit; no need to scan further (glyphs
+     * of a proportional font are at least one pixel wide) */
+    size_t max_word = ((size_t)(max_width / (params->monospace ? params->font_width : 1)) + 2) *
+                      UTF8_MAX_BYTES;
+
+    /* Skip leading spaces and empty paragraphs */
+    for (;;) {
+        pos = line_break_skip_spaces(text, pos, length);
+        if (pos < length && text[pos] == '\n') {
+            pos++;
+            continue;
+        }
+        break;
+    }
+    *line_start = pos;
+
+    while (pos < length && text[pos] != '\n') {
+        /* Find end of word and measure it */
+        size_t word_start = pos;
+        size_t limit = (length - word_start > max_word) ? word_start + max_word : length;
+        int word_width;
+        pos = scan_word(params, text, word_start, limit, &word_width);
+        int word_len = (int)(pos - word_start);
+
+        /* Include the separating space if not first */
+        int sep_width = (line_pos > 0) ? space_width : 0;
+
+        if (line_width + sep_width + word_width > max_width ||
+            line_pos + 1 + word_len >= MAX_LINE_LENGTH) {
+            if (line_pos == 0) {
+                /* Word too long for one line, break it (always make progress) */
+                int chars_fit = text_chars_in_width(params, text + word_start, max_width);
+                if (chars_fit > word_len) chars_fit = word_len;
+                if (chars_fit > MAX_LINE_LENGTH - 1) chars_fit = MAX_LINE_LENGTH - 1;
+                /* Don't split a UTF-8 sequence */
+                while (chars_fit > 0 && word_start + chars_fit < length &&
+                       utf8_is_continuation(text[word_start + chars_fit])) {
+                    chars_fit--;
+                }
+                if (chars_fit < 1) {
+                    /* Always make progress: take one whole character */
+                    uint32_t cp;
+                    chars_fit = (int)utf8_decode(text + word_start, length - word_start, &cp);
+                }
+                if (out) memcpy(out, text + word_start, chars_fit);
+                line_pos = chars_fit;
+                pos = word_start + chars_fit;
+            } else {
+                pos = word_start;
+            }
+            break;
+        }
+
+        /* Add word to line */
+        if (line_pos > 0) {
+            if (out) out[line_pos] = ' ';
+            line_pos++;
+        }
+        if (out) memcpy(out + line_pos, text + word_start, word_len);
+        line_pos += word_len;
+        line_width += sep_width + word_width;
+
+        /* Collapse spaces between words */
+        pos = line_break_skip_spaces(text, pos, length);
+    }
+
+    /* Consume the newline that ended the line */
+    if (pos < length && text[pos] == '\n') pos++;
+
+    if (out) out[line_pos] = '\0';
+    *out_len = line_pos;
+    return pos;
+}
+
 /**
  * Calculate text layout (split text into lines with word wrapping)
  */
-int text_calculate_layout(const char *text, int max_width,
-                         char **lines, int max_lines) {
-    if (!text || !lines) return 0;
+int text_calculate_layout(const layout_params_t *params, const char *text, int max_width,
+                          char **lines, int max_lines) {
+    if (!params || !text || !lines) return 0;
 
+    size_t length = strlen(text);
+    size_t pos = 0;
     int line_count = 0;
-    const char *p = text;
-
-    while (*p && line_count < max_lines) {
-        /* Skip leading spaces */
-        while (*p == ' ') p++;
-        if (*p == '\0') break;
 
-        /* Start new line */
+    while (line_count < max_lines) {
         char line_buffer[MAX_LINE_LENGTH];
-        int line_pos = 0;
-        int line_width = 0;
-
-        while (*p && *p != '\n' && line_count < max_lines) {
-            /* Find end of word */
-            const char *word_start = p;
-            while (*p && *p != ' ' && *p != '\n') p++;
-            int word_len = p - word_start;
-
-            /* Measure word */
-            int word_width = text_measure_width(word_start, word_len);
-
-            /* Check if word fits */
-            if (line_width + word_width > max_width) {
-                if (line_width == 0) {
-                    /* Word too long, break it */
-                    int chars_fit = text_chars_in_width(word_start, max_width);
-                    memcpy(line_buffer + line_pos, word_start, chars_fit);
-                    line_pos += chars_fit;
-                    p = word_start + chars_fit;
+        size_t line_start;
+        int line_len;
+
+        pos = layout_line(params, text, length, pos, max_width, &line_start,
+                          line_buffer, &line_len);
+        if (line_len == 0) break;
+
+        lines[line_count] = malloc(line_len + 1);
+        if (!lines[line_count]) break;
+        memcpy(lines[line_count], line_buffer, line_len + 1);
+        line_count++;
+    }
+
+    return line_count;
+}
+
+/*
+ * Pagination
+ *
+ * A page records only its source offsets and line count. The line strings
+ * are built by text_get_page() when a page is shown and are dropped again
+ * once the page is more than PAGINATION_RESIDENT_PAGES away from the page
+ * being read, so memory use does not grow with the size of the book.
+ *
+ * Text comes from a chunk source. Layout runs on one chunk at a time in the
+ * chunk's own coordinates, so a page ends wherever a chunk does and only the
+ * chunks around the pages being laid out or shown need to be in memory.
+ */
+
+/**
+ * Make pg->chunk the chunk containing pos
+ * @return: 0 on success, -1 if pos is past the end of the text
+ */
+static int pagination_chunk(pagination_t *pg, size_t pos) {
+    text_chunk_t *chunk = &pg->chunk;
+
+    if (chunk->text && pos >= chunk->offset && pos - chunk->offset < chunk->length) {
+        return 0;
+    }
+    if (!pg->fetch || pos >= pg->source_length) {
+        return -1;
+    }
+    if (pg->fetch(pg->source, pos, chunk) != 0 ||
+        pos < chunk->offset || pos - chunk->offset >= chunk->length) {
+        memset(chunk, 0, sizeof(*chunk));
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Get the chunk of paginated text containing an offset
+ */
+int text_pagination_chunk_at(pagination_t *pg, size_t offset, text_chunk_t *chunk) {
+    if (!pg || !chunk) return -1;
+    if (pagination_chunk(pg, offset) != 0) return -1;
+    *chunk = pg->chunk;
+    return 0;
+}
+
+/**
+ * Free the line strings of one page
+ */
+static void page_unload_lines(text_page_t *page) {
+    if (!page->lines_loaded) return;
+
+    for (int i = 0; i < page->line_count; i++) {
+        free(page->lines[i]);
+        page->lines[i] = NULL;
+    }
+    page->lines_loaded = false;
+}
+
+/**
+ * Free the line strings of every page
+ */
+static void pagination_unload_all(pagination_t *pg) {
+    for (int i = 0; i < pg->page_count; i++) {
+        page_unload_lines(&pg->pages[i]);
+    }
+    pg->resident_first = 0;
+    pg->resident_last = -1;
+}
+
+/**
+ * Make room for at least count more pages
+ */
+static int pagination_reserve(pagination_t *pg, int count) {
+    if (pg->page_count + count <= pg->page_capacity) return 0;
+
+    int new_capacity = pg->page_capacity ? pg->page_capacity * 2 : 64;
+    while (new_capacity < pg->page_count + count) new_capacity *= 2;
+
+    text_page_t *pages = realloc(pg->pages, sizeof(text_page_t) * new_capacity);
+    if (!pages) {
+        fprintf(stderr, "pagination_reserve: Out of memory for %d pages\n", new_capacity);
+        return -1;
+    }
+
+    pg->pages = pages;
+    pg->page_capacity = new_capacity;
+    return 0;
+}
+
+/**
+ * Lay out one page starting at pos, which must lie in pg->chunk
+ * @return: Offset where the next page starts; page->line_count is 0 if only
+ *          whitespace is left in the chunk
+ */
+static size_t layout_page(const pagination_t *pg, size_t pos, text_page_t *page) {
+    const text_chunk_t *chunk = &pg->chunk;
+    int lines_per_page = pg->params.lines_per_page;
+    size_t local = pos - chunk->offset;
+
+    memset(page, 0, sizeof(*page));
+
+    while (page->line_count < lines_per_page) {
+        size_t line_start;
+        int line_len;
+        size_t next = layout_line(&pg->params, chunk->text, chunk->length, local,
+                                  pg->params.area_width, &line_start, NULL, &line_len);
+        if (line_len == 0) {
+            local = next;
+            break;
+        }
+        if (page->line_count == 0) {
+            page->start_offset = (int)(chunk->offset + line_start);
+        }
+        page->line_count++;
+        local = next;
+    }
+
+    pos = chunk->offset + local;
+    page->end_offset = (int)pos - 1;
+    return pos;
+}
+
+/**
+ * Append up to max_pages pages after the last laid out page
+ * @return: Number of pages added, or -1 on error
+ */
+static int pagination_extend_forward(pagination_t *pg, int max_pages) {
+    int added = 0;
+    size_t pos = 0;
+    if (pg->page_count > 0) {
+        pos = (size_t)(pg->pages[pg->page_count - 1].end_offset + 1);
+    }
+
+    while (!pg->tail_complete && added < max_pages) {
+        if (pagination_chunk(pg, pos) != 0) {
+            pg->tail_complete = true;
+            break;
+        }
+
+        text_page_t page;
+        size_t next = pg->chunk.text ? layout_page(pg, pos, &page)
+                                     : pg->chunk.offset + pg->chunk.length;
+        pos = next;
+        if (pg->chunk.text && page.line_count > 0) {
+            if (pagination_reserve(pg, 1) != 0) return -1;
+            pg->pages[pg->page_count++] = page;
+            added++;
+        }
+        /* A chunk ending in whitespace leaves nothing to lay out: move to the next */
+
+        if (next >= pg->source_length) {
+            pg->tail_complete = true;
+        }
+    }
+
+    return added;
+}
+
+/**
+ * Find the start of the paragraph containing the byte before pos
+ */
+static size_t paragraph_start(const char *text, size_t pos) {
+    while (pos > 0 && text[pos - 1] != '\n') pos--;
+    return pos;
+}
+
+/**
+ * Prepend up to max_pages pages before the first laid out page
+ *
+ * Line breaks restart at every paragraph, so the lines before the first
+ * page are found by laying out whole paragraphs backwards from it. Full
+ * pages are grouped from the end; a short remainder is kept for a later
+ * call unless it is the start of its chunk.
+ *
+ * @return: Number of pages added, or -1 on error
+ */
+static int pagination_extend_backward(pagination_t *pg, int max_pages) {
+    if (pg->head_complete) return 0;
+
+    int lines_per_page = pg->params.lines_per_page;
+    int wanted = lines_per_page * max_pages;
+    size_t frontier = pg->page_count > 0 ? (size_t)pg->pages[0].start_offset
+                                         : pg->source_length;
+
+    /* Skip back over chunks holding nothing but whitespace */
+    const text_chunk_t *chunk = &pg->chunk;
+    int count;
+    size_t *starts;
+    bool reached_head;
+
+    for (;;) {
+        if (frontier == 0) {
+            pg->head_complete = true;
+            return 0;
+        }
+        if (pagination_chunk(pg, frontier - 1) != 0) return -1;
+        if (!chunk->text) {
+            frontier = chunk->offset;
+            continue;
+        }
+
+        /* Line start offsets before the frontier, in reading order (chunk coordinates) */
+        size_t local_frontier = frontier - chunk->offset;
+        int capacity = wanted + lines_per_page;
+        starts = malloc(sizeof(size_t) * capacity);
+        if (!starts) return -1;
+        count = 0;
+
+        size_t limit = local_frontier;
+        size_t para = paragraph_start(chunk->text, local_frontier);
+        reached_head = false;
+
+        while (count < wanted) {
+            /* Lay out paragraph [para, limit) */
+            size_t para_starts[MAX_LINES_IN_PAGE];
+            size_t *tmp = NULL;
+            int tmp_count = 0, tmp_capacity = MAX_LINES_IN_PAGE;
+            size_t *buf = para_starts;
+            size_t pos = para;
+
+            for (;;) {
+                size_t line_start;
+                int line_len;
+                size_t next = layout_line(&pg->params, chunk->text, chunk->length, pos,
+                                          pg->params.area_width, &line_start, NULL, &line_len);
+                if (line_len == 0 || line_start >= limit) break;
+
+                if (tmp_count == tmp_capacity) {
+                    size_t *grown = malloc(sizeof(size_t) * tmp_capacity * 2);
+                    if (!grown) {
+                        free(tmp);
+                        free(starts);
+                        return -1;
+                    }
+                    memcpy(grown, buf, sizeof(size_t) * tmp_count);
+                    free(tmp);
+                    tmp = buf = grown;
+                    tmp_capacity *= 2;
                 }
-                break;
+                buf[tmp_count++] = line_start;
+                pos = next;
             }
 
-            /* Add word to line */
-            if (line_pos > 0 && line_buffer[line_pos - 1] != ' ') {
-                line_buffer[line_pos++] = ' ';
-                line_width += FONT_WIDTH;
+            /* Prepend this paragraph's lines */
+            if (count + tmp_count > capacity) {
+                int new_capacity = count + tmp_count;
+                size_t *grown = realloc(starts, sizeof(size_t) * new_capacity);
+                if (!grown) {
+                    free(tmp);
+                    free(starts);
+                    return -1;
+                }
+                starts = grown;
+                capacity = new_capacity;
             }
-            memcpy(line_buffer + line_pos, word_start, word_len);
-            line_pos += word_len;
-            line_width += word_width;
+            memmove(starts + tmp_count, starts, sizeof(size_t) * count);
+            memcpy(starts, buf, sizeof(size_t) * tmp_count);
+            count += tmp_count;
+            free(tmp);
 
-            /* Skip space */
-            if (*p == ' ') p++;
+            if (para == 0) {
+                reached_head = true;
+                break;
+            }
+            limit = para;
+            para = paragraph_start(chunk->text, para - 1);
         }
 
-        /* Store line */
-        if (line_pos > 0) {
-            line_buffer[line_pos] = '\0';
-            lines[line_count] = malloc(line_pos + 1);
-            if (lines[line_count]) {
-                strcpy(lines[line_count], line_buffer);
-                line_count++;
-            }
+        if (count > 0 || !reached_head) break;
+
+        free(starts);
+        frontier = chunk->offset;
+    }
+
+    /* Group lines into pages from the end */
+    int full_pages = count / lines_per_page;
+    int remainder = count % lines_per_page;
+    int new_pages = full_pages;
+    if (new_pages > max_pages) {
+        new_pages = max_pages;
+    } else if (reached_head && remainder > 0 && new_pages < max_pages) {
+        new_pages++;
+    }
+
+    if (new_pages > 0) {
+        if (pagination_reserve(pg, new_pages) != 0) {
+            free(starts);
+            return -1;
+        }
+        memmove(pg->pages + new_pages, pg->pages, sizeof(text_page_t) * pg->page_count);
+
+        int line = count;
+        int next_start = (int)frontier;
+        for (int i = new_pages - 1; i >= 0; i--) {
+            int lines = lines_per_page;
+            if (line < lines) lines = line;
+            line -= lines;
+
+            text_page_t *page = &pg->pages[i];
+            memset(page, 0, sizeof(*page));
+            page->start_offset = (int)(chunk->offset + starts[line]);
+            page->end_offset = next_start - 1;
+            page->line_count = lines;
+            next_start = page->start_offset;
         }
 
-        /* Skip newline */
-        if (*p == '\n') p++;
+        pg->page_count += new_pages;
+        pg->current_page += new_pages;
+        pg->resident_first += new_pages;
+        pg->resident_last += new_pages;
     }
 
-    return line_count;
+    if (reached_head && chunk->offset == 0 && new_pages * lines_per_page >= count) {
+        pg->head_complete = true;
+    }
+
+    free(starts);
+    return new_pages;
 }
 
+static int pagination_anchor(pagination_t *pg, size_t anchor);
+
 /**
  * Create pagination context for a text string
  */
-pagination_t* text_create_pagination(const char *text, size_t text_length) {
-    if (!text) return NULL;
+pagination_t* text_create_pagination(const char *text, size_t text_length,
+                                     const layout_params_t *params) {
+    if (!text || !params) return NULL;
 
     pagination_t *pg = calloc(1, sizeof(pagination_t));
     if (!pg) return NULL;
 
-    /* Store reference to source text */
-    pg->source_text = (char *)text;
+    /* The whole string is the one and only chunk */
+    pg->chunk.text = text;
+    pg->chunk.offset = 0;
+    pg->chunk.length = text_length;
     pg->source_length = text_length;
-
-    /* Calculate maximum lines we can store */
-    char **all_lines = malloc(sizeof(char *) * 1000);  /* Temporary storage */
-    if (!all_lines) {
-        free(pg);
+    pg->params = *params;
+    pg->head_complete = true;
+    pg->resident_first = 0;
+    pg->resident_last = -1;
+
+    /* Lay out the whole text (offsets only, lines are built on demand) */
+    if (text_pagination_layout_all(pg, NULL) != 0) {
+        text_free_pagination(pg);
         return NULL;
     }
 
-    /* Split text into lines */
-    int total_lines = text_calculate_layout(text, TEXT_AREA_WIDTH, all_lines, 1000);
+    pg->current_page = 0;
+    return pg;
+}
 
-    /* Calculate number of pages */
-    pg->page_count = (total_lines + LINES_PER_PAGE - 1) / LINES_PER_PAGE;
-    if (pg->page_count == 0) pg->page_count = 1;
+/**
+ * Create pagination context for text supplied in chunks
+ */
+pagination_t* text_create_pagination_chunked(text_chunk_fn fetch, void *source,
+                                             size_t text_length,
+                                             const layout_params_t *params,
+                                             size_t anchor) {
+    if (!fetch || !params) return NULL;
 
-    /* Allocate page structures */
-    pg->pages = calloc(pg->page_count, sizeof(text_page_t));
-    if (!pg->pages) {
-        for (int i = 0; i < total_lines; i++) {
-            free(all_lines[i]);
-        }
-        free(all_lines);
-        free(pg);
-        return NULL;
-    }
+    pagination_t *pg = calloc(1, sizeof(pagination_t));
+    if (!pg) return NULL;
 
-    /* Distribute lines into pages */
-    int line_idx = 0;
-    for (int page = 0; page < pg->page_count; page++) {
-        text_page_t *p = &pg->pages[page];
-        p->line_count = 0;
+    pg->fetch = fetch;
+    pg->source = source;
+    pg->source_length = text_length;
+    pg->params = *params;
+    pg->resident_first = 0;
+    pg->resident_last = -1;
 
-        for (int i = 0; i < LINES_PER_PAGE && line_idx < total_lines; i++) {
-            p->lines[p->line_count++] = all_lines[line_idx++];
-        }
+    if (pagination_anchor(pg, anchor) < 0) {
+        text_free_pagination(pg);
+        return NULL;
     }
 
-    free(all_lines);
-    pg->current_page = 0;
-
     return pg;
 }
 
@@ -541,18 +1070,48 @@ void text_free_pagination(pagination_t *pg) {
     if (!pg) return;
 
     if (pg->pages) {
-        for (int page = 0; page < pg->page_count; page++) {
-            text_page_t *p = &pg->pages[page];
-            for (int i = 0; i < p->line_count; i++) {
-                free(p->lines[i]);
-            }
-        }
+        pagination_unload_all(pg);
         free(pg->pages);
     }
 
     free(pg);
 }
 
+/**
+ * Build the line strings of a page from its source offsets
+ */
+static int page_load_lines(pagination_t *pg, text_page_t *page) {
+    if (page->lines_loaded) return 0;
+
+    if (page->line_count > 0 && pagination_chunk(pg, (size_t)page->start_offset) != 0) {
+        return -1;
+    }
+
+    const text_chunk_t *chunk = &pg->chunk;
+    size_t pos = (size_t)page->start_offset - chunk->offset;
+    for (int i = 0; i < page->line_count; i++) {
+        char line_buffer[MAX_LINE_LENGTH];
+        size_t line_start;
+        int line_len;
+
+        pos = layout_line(&pg->params, chunk->text, chunk->length, pos,
+                          pg->params.area_width, &line_start, line_buffer, &line_len);
+
+        page->lines[i] = malloc(line_len + 1);
+        if (!page->lines[i]) {
+            for (int j = 0; j < i; j++) {
+                free(page->lines[j]);
+                page->lines[j] = NULL;
+            }
+            return -1;
+        }
+        memcpy(page->lines[i], line_buffer, line_len + 1);
+    }
+
+    page->lines_loaded = true;
+    return 0;
+}
+
 /**
  * Get a specific page from pagination context
  */
@@ -560,21 +1119,224 @@ text_page_t* text_get_page(pagination_t *pg, int page_index) {
     if (!pg || !pg->pages) return NULL;
     if (page_index < 0 || page_index >= pg->page_count) return NULL;
 
-    return &pg->pages[page_index];
+    text_page_t *page = &pg->pages[page_index];
+
+    /* Drop line strings of pages that left the resident window */
+    int first = page_index - PAGINATION_RESIDENT_PAGES;
+    int last = page_index + PAGINATION_RESIDENT_PAGES;
+    for (int i = pg->resident_first; i <= pg->resident_last && i < pg->page_count; i++) {
+        if (i >= 0 && (i < first || i > last)) {
+            page_unload_lines(&pg->pages[i]);
+        }
+    }
+    pg->resident_first = first;
+    pg->resident_last = last;
+
+    if (page_load_lines(pg, page) != 0) {
+        fprintf(stderr, "text_get_page: Failed to build page %d\n", page_index);
+        return NULL;
+    }
+
+    return page;
+}
+
+/**
+ * Lay out more pages of a partially laid out pagination context
+ */
+int text_pagination_extend(pagination_t *pg, int max_pages, int *pages_prepended) {
+    if (pages_prepended) *pages_prepended = 0;
+    if (!pg || max_pages <= 0) return -1;
+
+    int added = pagination_extend_forward(pg, max_pages);
+    if (added < 0) return -1;
+
+    if (added < max_pages && !pg->head_complete) {
+        int prepended = pagination_extend_backward(pg, max_pages - added);
+        if (prepended < 0) return -1;
+        if (pages_prepended) *pages_prepended = prepended;
+        added += prepended;
+    }
+
+    /* Always leave at least one (possibly empty) page */
+    if (pg->page_count == 0 && text_pagination_is_complete(pg)) {
+        if (pagination_reserve(pg, 1) != 0) return -1;
+        memset(&pg->pages[0], 0, sizeof(text_page_t));
+        pg->pages[0].end_offset = (int)pg->source_length - 1;
+        pg->page_count = 1;
+    }
+
+    return added;
+}
+
+/**
+ * Lay out pages before the first laid out page only
+ */
+int text_pagination_prepend(pagination_t *pg, int max_pages) {
+    if (!pg || max_pages <= 0) return -1;
+    return pagination_extend_backward(pg, max_pages);
+}
+
+/**
+ * Lay out all remaining pages of a pagination context
+ */
+int text_pagination_layout_all(pagination_t *pg, int *pages_prepended) {
+    if (pages_prepended) *pages_prepended = 0;
+    if (!pg) return -1;
+
+    while (!text_pagination_is_complete(pg)) {
+        int prepended;
+        if (text_pagination_extend(pg, 64, &prepended) < 0) return -1;
+        if (pages_prepended) *pages_prepended += prepended;
+    }
+
+    return 0;
+}
+
+/**
+ * Replace the layout with a precomputed one
+ */
+int text_pagination_set_pages(pagination_t *pg, const uint32_t *table, int page_count) {
+    if (!pg || !table || page_count <= 0) return -1;
+
+    /* Pages must lie in the text, in order, without overlapping */
+    long long previous_end = -1;
+    for (int i = 0; i < page_count; i++) {
+        const uint32_t *row = table + 3 * i;
+        if ((long long)row[0] <= previous_end || row[1] < row[0] ||
+            row[1] >= pg->source_length || row[1] > INT32_MAX ||
+            row[2] == 0 || row[2] > (uint32_t)pg->params.lines_per_page) {
+            return -1;
+        }
+        previous_end = row[1];
+    }
+
+    if (page_count > pg->page_count &&
+        pagination_reserve(pg, page_count - pg->page_count) != 0) {
+        return -1;
+    }
+    pagination_unload_all(pg);
+
+    for (int i = 0; i < page_count; i++) {
+        const uint32_t *row = table + 3 * i;
+        text_page_t *page = &pg->pages[i];
+        memset(page, 0, sizeof(*page));
+        page->start_offset = (int)row[0];
+        page->end_offset = (int)row[1];
+        page->line_count = (int)row[2];
+    }
+
+    pg->page_count = page_count;
+    pg->current_page = 0;
+    pg->head_complete = true;
+    pg->tail_complete = true;
+    return 0;
+}
+
+/**
+ * Check whether every page of the text has been laid out
+ */
+bool text_pagination_is_complete(const pagination_t *pg) {
+    return pg && pg->head_complete && pg->tail_complete;
+}
+
+/**
+ * Find the laid out page containing a source offset (binary search)
+ */
+int text_pagination_find_page(const pagination_t *pg, int offset) {
+    if (!pg || !pg->pages || pg->page_count == 0) return -1;
+    if (offset < pg->pages[0].start_offset && !pg->head_complete) return -1;
+    if (offset > pg->pages[pg->page_count - 1].end_offset && !pg->tail_complete) return -1;
+
+    /* Last page starting at or before offset */
+    int lo = 0;
+    int hi = pg->page_count - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (pg->pages[mid].start_offset <= offset) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    return lo;
+}
+
+/**
+ * Average bytes per laid out page, used to estimate unlaid-out regions
+ */
+static double pagination_bytes_per_page(const pagination_t *pg) {
+    int first = pg->pages[0].start_offset;
+    int last = pg->pages[pg->page_count - 1].end_offset;
+    double bytes = (double)(last - first + 1) / pg->page_count;
+    return bytes > 1.0 ? bytes : 1.0;
+}
+
+/**
+ * Estimate the page number of a laid out page within the whole book
+ */
+int text_pagination_estimate_index(const pagination_t *pg, int page_index) {
+    if (!pg || !pg->pages || pg->page_count == 0) return 0;
+    if (pg->head_complete) return page_index;
+
+    double bytes_per_page = pagination_bytes_per_page(pg);
+    int before = (int)(pg->pages[0].start_offset / bytes_per_page + 0.5);
+
+    return before + page_index;
+}
+
+/**
+ * Estimate the page number of any offset within the whole book
+ */
+int text_pagination_estimate_page(const pagination_t *pg, int offset) {
+    if (!pg || !pg->pages || pg->page_count == 0) return 0;
+
+    int index = text_pagination_find_page(pg, offset);
+    if (index >= 0) return text_pagination_estimate_index(pg, index);
+
+    double bytes_per_page = pagination_bytes_per_page(pg);
+    if (offset < pg->pages[0].start_offset) {
+        return (int)(offset / bytes_per_page);
+    }
+    const text_page_t *last = &pg->pages[pg->page_count - 1];
+    return text_pagination_estimate_index(pg, pg->page_count - 1) + 1 +
+           (int)((offset - (last->end_offset + 1)) / bytes_per_page);
+}
+
+/**
+ * Estimate the total page count of the book
+ */
+int text_pagination_estimate_total(const pagination_t *pg) {
+    if (!pg || !pg->pages || pg->page_count == 0) return 0;
+    if (text_pagination_is_complete(pg)) return pg->page_count;
+
+    double bytes_per_page = pagination_bytes_per_page(pg);
+    int total = pg->page_count;
+
+    if (!pg->head_complete) {
+        total += (int)(pg->pages[0].start_offset / bytes_per_page + 0.5);
+    }
+    if (!pg->tail_complete) {
+        size_t tail = pg->source_length - (size_t)(pg->pages[pg->page_count - 1].end_offset + 1);
+        total += (int)(tail / bytes_per_page + 0.5);
+    }
+
+    return total;
 }
 
 /**
  * Render a page to the framebuffer
  */
-int text_render_page(framebuffer_t *fb, text_page_t *page, uint8_t color) {
-    if (!fb || !page) return -1;
+int text_render_page(framebuffer_t *fb, const layout_params_t *params,
+                     text_page_t *page, uint8_t color) {
+    if (!fb || !params || !page) return -1;
 
-    int y = MARGIN_TOP;
+    int y = params->margin_top;
 
     for (int i = 0; i < page->line_count; i++) {
         if (page->lines[i]) {
-            text_render_string(fb, MARGIN_LEFT, y, page->lines[i], color);
-            y += LINE_HEIGHT;
+            text_render_line(fb, params, params->margin_left, y, page->lines[i], color);
+            y += params->line_height;
         }
     }
 
@@ -586,11 +1348,13 @@ int text_render_page(framebuffer_t *fb, text_page_t *page, uint8_t color) {
  * ============================================================================= */
 
 /**
- * Set the current font size
+ * Set the font size of the default UI layout parameters
  */
 void text_renderer_set_font_size(text_font_size_t size) {
     if (size >= TEXT_FONT_SIZE_SMALL && size <= TEXT_FONT_SIZE_LARGE) {
-        current_font_size = size;
+        ui_params.font_size = size;
+        text_layout_params_update(&ui_params);
+        ui_params_ready = true;
     }
 }
 
@@ -598,123 +1362,103 @@ void text_renderer_set_font_size(text_font_size_t size) {
  * Get the current font size
  */
 text_font_size_t text_renderer_get_font_size(void) {
-    return current_font_size;
+    return ui_layout()->font_size;
 }
 
 /**
  * Get the width of the current font
  */
 int text_renderer_get_font_width(void) {
-    switch (current_font_size) {
-        case TEXT_FONT_SIZE_SMALL:  return FONT_SMALL_WIDTH;   /* 6 pixels */
-        case TEXT_FONT_SIZE_MEDIUM: return FONT_MEDIUM_WIDTH;  /* 8 pixels */
-        case TEXT_FONT_SIZE_LARGE:  return FONT_LARGE_WIDTH;   /* 10 pixels */
-        default:                    return FONT_MEDIUM_WIDTH;
-    }
+    return ui_layout()->font_width;
 }
 
 /**
  * Get the height of the current font
  */
 int text_renderer_get_font_height(void) {
-    switch (current_font_size) {
-        case TEXT_FONT_SIZE_SMALL:  return FONT_SMALL_HEIGHT;   /* 12 pixels */
-        case TEXT_FONT_SIZE_MEDIUM: return FONT_MEDIUM_HEIGHT;  /* 16 pixels */
-        case TEXT_FONT_SIZE_LARGE:  return FONT_LARGE_HEIGHT;   /* 20 pixels */
-        default:                    return FONT_MEDIUM_HEIGHT;
-    }
+    return ui_layout()->font_height;
 }
 
 /**
  * Get the number of characters per line for the current font
  */
 int text_renderer_get_chars_per_line(void) {
-    int text_area_width = FB_WIDTH - MARGIN_LEFT - MARGIN_RIGHT;  /* 380 pixels */
-    int font_width = text_renderer_get_font_width();
-    return text_area_width / font_width;
+    return ui_layout()->chars_per_line;
 }
 
 /**
  * Get the number of lines per page for the current font
  */
 int text_renderer_get_lines_per_page(void) {
-    int text_area_height = FB_HEIGHT - MARGIN_TOP - MARGIN_BOTTOM;  /* 260 pixels */
-    int font_height = text_renderer_get_font_height();
-    int line_height = font_height + LINE_SPACING;
-    return text_area_height / line_height;
+    return ui_layout()->lines_per_page;
 }
 
 /**
- * Re-paginate existing pagination context with new font size
+ * Lay out the page holding anchor in an empty pagination context
+ *
+ * Everything before that page is left for text_pagination_extend().
+ *
+ * @return: Index of the page holding anchor, or -1 on error
  */
-int text_renderer_repaginate(pagination_t *pg, int current_page) {
-    if (!pg || !pg->source_text) return -1;
-
-    /* Calculate current position as percentage through the document */
-    int old_page_count = pg->page_count;
-    if (old_page_count == 0) return 0;
-
-    /* Approximate character offset based on current page */
-    float position_percent = (float)current_page / (float)old_page_count;
+static int pagination_anchor(pagination_t *pg, size_t anchor) {
+    pg->page_count = 0;
+    pg->current_page = 0;
+    pg->head_complete = false;
+    pg->tail_complete = false;
 
-    /* Free existing pagination data but keep source text pointer */
-    char *source_backup = pg->source_text;
-    size_t source_len_backup = pg->source_length;
+    if (anchor >= pg->source_length) {
+        anchor = pg->source_length ? pg->source_length - 1 : 0;
+    }
 
-    if (pg->pages) {
-        for (int page = 0; page < pg->page_count; page++) {
-            text_page_t *p = &pg->pages[page];
-            for (int i = 0; i < p->line_count; i++) {
-                free(p->lines[i]);
+    while (pg->page_count == 0 && pagination_chunk(pg, anchor) == 0) {
+        /* Find the line containing the anchor under the current font */
+        const text_chunk_t *chunk = &pg->chunk;
+        if (!chunk->text) {
+            anchor = chunk->offset + chunk->length;
+            if (anchor >= pg->source_length) {
+                pg->tail_complete = true;
+                break;
             }
+            continue;
         }
-        free(pg->pages);
-        pg->pages = NULL;
-    }
-
-    /* Recalculate layout with new font */
-    int text_area_width = FB_WIDTH - MARGIN_LEFT - MARGIN_RIGHT;
-    char **all_lines = malloc(sizeof(char *) * 1000);
-    if (!all_lines) return -1;
-
-    int total_lines = text_calculate_layout(source_backup, text_area_width, all_lines, 1000);
-    int lines_per_page = text_renderer_get_lines_per_page();
-
-    /* Calculate new page count */
-    pg->page_count = (total_lines + lines_per_page - 1) / lines_per_page;
-    if (pg->page_count == 0) pg->page_count = 1;
-
-    /* Allocate new page structures */
-    pg->pages = calloc(pg->page_count, sizeof(text_page_t));
-    if (!pg->pages) {
-        for (int i = 0; i < total_lines; i++) {
-            free(all_lines[i]);
+        size_t local = anchor - chunk->offset;
+        size_t pos = paragraph_start(chunk->text, local);
+        size_t line_pos = pos;
+        while (pos < chunk->length) {
+            size_t line_start;
+            int line_len;
+            size_t next = layout_line(&pg->params, chunk->text, chunk->length, pos,
+                                      pg->params.area_width, &line_start, NULL, &line_len);
+            if (line_len == 0 || line_start > local) break;
+            line_pos = line_start;
+            if (next > local) break;
+            pos = next;
         }
-        free(all_lines);
-        return -1;
-    }
-
-    /* Distribute lines into pages */
-    int line_idx = 0;
-    for (int page = 0; page < pg->page_count; page++) {
-        text_page_t *p = &pg->pages[page];
-        p->line_count = 0;
 
-        for (int i = 0; i < lines_per_page && line_idx < total_lines; i++) {
-            p->lines[p->line_count++] = all_lines[line_idx++];
+        /* Lay out the page at the anchor; everything before it is pending */
+        text_page_t page;
+        size_t next = layout_page(pg, chunk->offset + line_pos, &page);
+        if (page.line_count > 0) {
+            if (pagination_reserve(pg, 1) != 0) return -1;
+            pg->pages[0] = page;
+            pg->page_count = 1;
+        }
+        if (next >= pg->source_length) {
+            pg->tail_complete = true;
+            break;
         }
-    }
-
-    free(all_lines);
 
-    /* Restore source text references */
-    pg->source_text = source_backup;
-    pg->source_length = source_len_backup;
+        /* Only whitespace after the anchor in this chunk: try the next one */
+        anchor = next;
+    }
 
-    /* Calculate new page position */
-    int new_page = (int)(position_percent * pg->page_count);
-    if (new_page >= pg->page_count) new_page = pg->page_count - 1;
-    if (new_page < 0) new_page = 0;
+    if (pg->page_count == 0) {
+        /* Anchor was in trailing whitespace: fall back to the page before it */
+        pg->tail_complete = true;
+        if (text_pagination_extend(pg, 1, NULL) < 0) return -1;
+        if (pg->page_count == 0) return -1;
+        return pg->page_count - 1;
+    }
 
-    return new_page;
+    return 0;
 }
@@ -3,6 +3,7 @@
  *
  * Provides text rendering capabilities with word wrapping and pagination.
  * Supports multiple font sizes: small (6x12), medium (8x16), large (10x20).
+ * Text is UTF-8; byte offsets and lengths never split a character.
  *
  * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
  *
@@ -27,9 +28,12 @@
 #ifndef TEXT_RENDERER_H
 #define TEXT_RENDERER_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include "framebuffer.h"
+#include "font.h"
+#include "../settings/settings_manager.h"
 
 /* Font size options - matches settings_manager.h */
 typedef enum {
@@ -42,7 +46,7 @@ typedef enum {
 #define FONT_FIRST_CHAR     32   /* First printable ASCII character (space) */
 #define FONT_LAST_CHAR      126  /* Last printable ASCII character (~) */
 
-/* Legacy macros for backward compatibility - now dynamic */
+/* Legacy macros for UI code - metrics of the default (UI) layout parameters */
 #define FONT_WIDTH          text_renderer_get_font_width()
 #define FONT_HEIGHT         text_renderer_get_font_height()
 
@@ -71,82 +75,264 @@ typedef enum {
     ALIGN_RIGHT
 } text_align_t;
 
+/* Tab advance in character widths */
+#define TAB_WIDTH_CHARS     4
+
+/*
+ * Layout Parameters
+ *
+ * Page geometry for layout and rendering. The caller fills the inputs and
+ * text_layout_params_update() derives the metrics once, so layout loops
+ * read plain fields instead of looking up the font on every character.
+ * Nothing here refers to global state: separate contexts can lay out
+ * different books (or the same book at different sizes) concurrently.
+ */
+typedef struct {
+    /* Inputs */
+    text_font_size_t font_size;  /* Font used for layout and rendering */
+    char font_family[FONT_FILE_FAMILY_SIZE];  /* Installed typeface ("" = any) */
+    int line_spacing;            /* Extra pixels between lines */
+    int margin_top;              /* Margins in pixels */
+    int margin_bottom;
+    int margin_left;
+    int margin_right;
+    int screen_width;            /* Size of the area the margins apply to */
+    int screen_height;
+
+    /* Derived by text_layout_params_update() */
+    const font_t *font;          /* Font for font_size and font_family */
+    bool monospace;              /* Every glyph advances font_width */
+    int font_width;              /* Glyph advance in pixels (widest if proportional) */
+    int font_height;             /* Glyph height in pixels */
+    int tab_width;               /* Tab advance in pixels */
+    int area_width;              /* Text area inside the margins */
+    int area_height;
+    int line_height;             /* font_height + line_spacing */
+    int chars_per_line;          /* Characters that fit on one line */
+    int lines_per_page;          /* Lines per page (at most MAX_LINES_IN_PAGE) */
+} layout_params_t;
+
+/* Line breaking revision, part of text_layout_key(); bump it whenever line
+ * or page breaking changes so that stored page tables stop matching */
+#define TEXT_LAYOUT_REVISION       1
+
+/* Number of pages around the last requested page that keep their line strings */
+#define PAGINATION_RESIDENT_PAGES  4
+
 /* Page Structure - represents one screen of text */
 typedef struct {
-    char *lines[MAX_LINES_IN_PAGE];  /* Array of line pointers */
+    char *lines[MAX_LINES_IN_PAGE];  /* Array of line pointers (built on demand by text_get_page) */
     int line_count;                   /* Number of lines in this page */
-    int start_offset;                 /* Character offset in source text where page starts */
-    int end_offset;                   /* Character offset in source text where page ends */
+    int start_offset;                 /* Offset of the first character on the page */
+    int end_offset;                   /* Offset of the last byte consumed by the page (inclusive) */
+    bool lines_loaded;                /* true once lines[] holds the rendered line strings */
 } text_page_t;
 
-/* Pagination Context - manages splitting text into pages */
+/*
+ * Text Chunk - a contiguous piece of the text being paginated
+ *
+ * Books can be supplied a chunk at a time (a chapter, a PDF page) instead
+ * of as one string. Pages never span two chunks. A blank chunk (text NULL)
+ * stands for length bytes of whitespace without holding them, so a source
+ * can reserve room it may not use and layout skips it in one step.
+ */
+typedef struct {
+    const char *text;        /* Chunk bytes, NULL if blank (valid until the next fetch from the same source) */
+    size_t offset;           /* Offset of text[0] within the whole text */
+    size_t length;           /* Length of the chunk in bytes */
+} text_chunk_t;
+
+/**
+ * Fetch the chunk containing an offset
+ * @param source: Source passed to text_create_pagination_chunked()
+ * @param offset: Byte offset within the whole text
+ * @param chunk: Output chunk
+ * @return: 0 on success, -1 if no chunk contains offset
+ */
+typedef int (*text_chunk_fn)(void *source, size_t offset, text_chunk_t *chunk);
+
+/*
+ * Pagination Context - manages splitting text into pages
+ *
+ * Pages are laid out outward from an anchor offset. Until both head_complete
+ * and tail_complete are set, pages[] only covers part of the book and
+ * text_pagination_extend() must be called to lay out the rest.
+ */
 typedef struct {
-    text_page_t *pages;      /* Array of pages */
-    int page_count;          /* Total number of pages */
+    text_page_t *pages;      /* Array of pages laid out so far, in reading order */
+    int page_count;          /* Number of pages laid out so far */
+    int page_capacity;       /* Allocated size of pages array */
     int current_page;        /* Currently displayed page (0-indexed) */
-    char *source_text;       /* Original text being paginated */
-    size_t source_length;    /* Length of source text */
+    layout_params_t params;  /* Geometry the pages were laid out with */
+    text_chunk_fn fetch;     /* Chunk source (NULL when paginating a single string) */
+    void *source;            /* Argument passed to fetch */
+    text_chunk_t chunk;      /* Most recently fetched chunk (the whole string if fetch is NULL) */
+    size_t source_length;    /* Length of the whole text in bytes */
+    bool head_complete;      /* pages[0] is the first page of the text */
+    bool tail_complete;      /* pages[page_count - 1] is the last page of the text */
+    int resident_first;      /* First page that may hold line strings */
+    int resident_last;       /* Last page that may hold line strings */
 } pagination_t;
 
 /**
- * Initialize the text renderer (loads font data)
+ * Initialize the text renderer (maps installed fonts from FONT_DIR)
  * @return: 0 on success, -1 on error
  */
 int text_renderer_init(void);
 
+/**
+ * Release text renderer resources (unmaps installed fonts)
+ */
+void text_renderer_cleanup(void);
+
+/**
+ * Initialize layout parameters with the default screen geometry
+ * (MARGIN_* margins, LINE_SPACING) for a font size
+ * @param params: Parameters to initialize
+ * @param font_size: Font size to lay out with
+ */
+void text_layout_params_init(layout_params_t *params, text_font_size_t font_size);
+
+/**
+ * Initialize layout parameters from user settings
+ * (font size, line spacing and margins)
+ * @param params: Parameters to initialize
+ * @param settings: User settings (NULL for defaults)
+ */
+void text_layout_params_from_settings(layout_params_t *params, const settings_t *settings);
+
+/**
+ * Recompute derived metrics after changing the inputs of a parameter set
+ * @param params: Parameters to update
+ */
+void text_layout_params_update(layout_params_t *params);
+
+/**
+ * Fingerprint everything that decides where lines and pages break
+ * (font and glyph advances, text area, line height, tab width)
+ * Page tables stored in precompiled books are keyed by it.
+ * @param params: Layout parameters (after text_layout_params_update())
+ * @return: 32-bit key
+ */
+uint32_t text_layout_key(const layout_params_t *params);
+
+/**
+ * Get the default layout parameters used by the UI (text_render_string)
+ * @return: Pointer to the default parameters (owned by the renderer)
+ */
+const layout_params_t* text_renderer_get_params(void);
+
 /**
  * Render a single character to the framebuffer
  * @param fb: Pointer to framebuffer
+ * @param params: Layout parameters (selects the font)
+ * @param x: X coordinate (top-left of character)
+ * @param y: Y coordinate (top-left of character)
+ * @param c: Character to render (bytes above 0x7F are taken as Latin-1)
+ * @param color: COLOR_BLACK or COLOR_WHITE
+ * @return: Advance of rendered character in pixels
+ */
+int text_render_char(framebuffer_t *fb, const layout_params_t *params,
+                     int x, int y, char c, uint8_t color);
+
+/**
+ * Render a Unicode character to the framebuffer
+ * @param fb: Pointer to framebuffer
+ * @param params: Layout parameters (selects the font)
  * @param x: X coordinate (top-left of character)
  * @param y: Y coordinate (top-left of character)
- * @param c: Character to render
+ * @param cp: Unicode codepoint
  * @param color: COLOR_BLACK or COLOR_WHITE
- * @return: Width of rendered character (typically FONT_WIDTH)
+ * @return: Advance of rendered character in pixels
  */
-int text_render_char(framebuffer_t *fb, int x, int y, char c, uint8_t color);
+int text_render_codepoint(framebuffer_t *fb, const layout_params_t *params,
+                          int x, int y, uint32_t cp, uint8_t color);
 
 /**
  * Render a string to the framebuffer (no word wrapping)
+ * Uses the default UI layout parameters.
  * @param fb: Pointer to framebuffer
  * @param x: Starting X coordinate
  * @param y: Starting Y coordinate
- * @param text: Null-terminated string to render
+ * @param text: Null-terminated UTF-8 string to render
  * @param color: COLOR_BLACK or COLOR_WHITE
  * @return: Number of characters rendered
  */
 int text_render_string(framebuffer_t *fb, int x, int y, const char *text, uint8_t color);
 
+/**
+ * Render a string to the framebuffer with explicit layout parameters
+ * @param fb: Pointer to framebuffer
+ * @param params: Layout parameters
+ * @param x: Starting X coordinate
+ * @param y: Starting Y coordinate
+ * @param text: Null-terminated UTF-8 string to render
+ * @param color: COLOR_BLACK or COLOR_WHITE
+ * @return: Number of characters rendered
+ */
+int text_render_line(framebuffer_t *fb, const layout_params_t *params,
+                     int x, int y, const char *text, uint8_t color);
+
 /**
  * Render a string with word wrapping
  * @param fb: Pointer to framebuffer
+ * @param params: Layout parameters
  * @param x: Starting X coordinate
  * @param y: Starting Y coordinate
- * @param text: Null-terminated string to render
+ * @param text: Null-terminated UTF-8 string to render
  * @param max_width: Maximum width in pixels (for wrapping)
  * @param color: COLOR_BLACK or COLOR_WHITE
  * @return: Number of lines rendered
  */
-int text_render_wrapped(framebuffer_t *fb, int x, int y, const char *text,
-                       int max_width, uint8_t color);
+int text_render_wrapped(framebuffer_t *fb, const layout_params_t *params,
+                        int x, int y, const char *text, int max_width, uint8_t color);
 
 /**
  * Calculate text layout (split text into lines with word wrapping)
+ * @param params: Layout parameters
  * @param text: Source text to layout
  * @param max_width: Maximum line width in pixels
  * @param lines: Output array of line strings (caller must allocate)
  * @param max_lines: Maximum number of lines to generate
  * @return: Number of lines generated (may be less than max_lines)
  */
-int text_calculate_layout(const char *text, int max_width,
-                         char **lines, int max_lines);
+int text_calculate_layout(const layout_params_t *params, const char *text, int max_width,
+                          char **lines, int max_lines);
 
 /**
  * Create pagination context for a text string
  * @param text: Source text to paginate (must remain valid during pagination lifetime)
  * @param text_length: Length of source text
+ * @param params: Layout parameters (copied into the context)
+ * @return: Pointer to pagination context, or NULL on error
+ */
+pagination_t* text_create_pagination(const char *text, size_t text_length,
+                                     const layout_params_t *params);
+
+/**
+ * Create pagination context for text supplied in chunks
+ * Only the page at anchor is laid out; text_pagination_extend() lays out the
+ * rest, fetching further chunks as it reaches them.
+ * @param fetch: Chunk source; chunks must cover [0, text_length) without gaps
+ * @param source: Argument passed to fetch (must remain valid during pagination lifetime)
+ * @param text_length: Length of the whole text in bytes
+ * @param params: Layout parameters (copied into the context)
+ * @param anchor: Byte offset that must appear on the first page laid out
  * @return: Pointer to pagination context, or NULL on error
  */
-pagination_t* text_create_pagination(const char *text, size_t text_length);
+pagination_t* text_create_pagination_chunked(text_chunk_fn fetch, void *source,
+                                             size_t text_length,
+                                             const layout_params_t *params,
+                                             size_t anchor);
+
+/**
+ * Get the chunk of paginated text containing an offset
+ * @param pg: Pagination context
+ * @param offset: Byte offset within the whole text
+ * @param chunk: Output chunk (valid until the pagination fetches another)
+ * @return: 0 on success, -1 if offset is past the end of the text
+ */
+int text_pagination_chunk_at(pagination_t *pg, size_t offset, text_chunk_t *chunk);
 
 /**
  * Free pagination context and associated memory
@@ -165,32 +351,36 @@ text_page_t* text_get_page(pagination_t *pg, int page_index);
 /**
  * Render a page to the framebuffer
  * @param fb: Pointer to framebuffer
+ * @param params: Layout parameters (margins, line height, font)
  * @param page: Page to render
  * @param color: COLOR_BLACK or COLOR_WHITE
  * @return: 0 on success, -1 on error
  */
-int text_render_page(framebuffer_t *fb, text_page_t *page, uint8_t color);
+int text_render_page(framebuffer_t *fb, const layout_params_t *params,
+                     text_page_t *page, uint8_t color);
 
 /**
  * Measure the width of a string in pixels
+ * @param params: Layout parameters
  * @param text: String to measure
- * @param length: Number of characters to measure (or -1 for entire string)
+ * @param length: Number of bytes to measure (or -1 for entire string)
  * @return: Width in pixels
  */
-int text_measure_width(const char *text, int length);
+int text_measure_width(const layout_params_t *params, const char *text, int length);
 
 /**
  * Get the number of characters that fit in a given width
- * @param text: String to measure
+ * @param params: Layout parameters
+ * @param text: UTF-8 string to measure
  * @param max_width: Maximum width in pixels
- * @return: Number of characters that fit
+ * @return: Number of bytes taken by the whole characters that fit
  */
-int text_chars_in_width(const char *text, int max_width);
+int text_chars_in_width(const layout_params_t *params, const char *text, int max_width);
 
 /**
- * Set the current font size
- * This affects all subsequent rendering operations and pagination calculations.
- * Call this before creating pagination contexts to use the new font size.
+ * Set the font size of the default UI layout parameters
+ * This affects text_render_string() and the FONT_WIDTH/LINE_HEIGHT macros.
+ * Book pagination uses its own layout_params_t.
  * @param size: Font size to use (SMALL, MEDIUM, or LARGE)
  */
 void text_renderer_set_font_size(text_font_size_t size);
@@ -226,13 +416,88 @@ int text_renderer_get_chars_per_line(void);
 int text_renderer_get_lines_per_page(void);
 
 /**
- * Re-paginate existing pagination context with new font size
- * This is useful when the user changes font size while reading.
- * The function attempts to maintain approximate reading position.
- * @param pg: Existing pagination context
- * @param current_page: Current page number (0-indexed)
- * @return: New approximate page number in re-paginated content, or -1 on error
+ * Lay out more pages of a partially laid out pagination context
+ * Pages are added after the last page first, then before the first page.
+ * @param pg: Pagination context
+ * @param max_pages: Maximum number of pages to add in this call
+ * @param pages_prepended: Output number of pages inserted before the
+ *                         previous pages[0] (callers holding a page index
+ *                         must add this to it); may be NULL
+ * @return: Number of pages added (0 once layout is complete), or -1 on error
+ */
+int text_pagination_extend(pagination_t *pg, int max_pages, int *pages_prepended);
+
+/**
+ * Lay out pages before the first laid out page only
+ * Used when paging backwards from the anchor, so the pages before it do
+ * not wait for the rest of the book to be laid out.
+ * @param pg: Pagination context
+ * @param max_pages: Maximum number of pages to add in this call
+ * @return: Number of pages inserted before the previous pages[0] (callers
+ *          holding a page index must add this to it), or -1 on error
+ */
+int text_pagination_prepend(pagination_t *pg, int max_pages);
+
+/**
+ * Lay out all remaining pages of a pagination context
+ * @param pg: Pagination context
+ * @param pages_prepended: Output number of pages inserted before pages[0] (may be NULL)
+ * @return: 0 on success, -1 on error
+ */
+int text_pagination_layout_all(pagination_t *pg, int *pages_prepended);
+
+/**
+ * Replace the layout with a precomputed one
+ * For books that carry page tables (see formats/erb_reader.h). The table
+ * must come from the same text laid out with the same text_layout_key();
+ * it is checked for consistency and rejected otherwise.
+ * @param pg: Pagination context
+ * @param table: page_count rows of (start offset, end offset, line count)
+ * @param page_count: Number of pages
+ * @return: 0 on success, -1 if the table is unusable (pg is left unchanged)
+ */
+int text_pagination_set_pages(pagination_t *pg, const uint32_t *table, int page_count);
+
+/**
+ * Check whether every page of the text has been laid out
+ * @param pg: Pagination context
+ * @return: true if the layout covers the whole text
+ */
+bool text_pagination_is_complete(const pagination_t *pg);
+
+/**
+ * Find the laid out page containing a source offset (binary search)
+ * @param pg: Pagination context
+ * @param offset: Byte offset in source text
+ * @return: Page index, or -1 if the offset is outside the laid out pages
+ */
+int text_pagination_find_page(const pagination_t *pg, int offset);
+
+/**
+ * Estimate the page number of a laid out page within the whole book
+ * Exact once the layout is complete; before that, pages not yet laid out
+ * ahead of pages[0] are estimated from the average bytes per page.
+ * @param pg: Pagination context
+ * @param page_index: Index into pg->pages
+ * @return: Estimated 0-indexed page number
+ */
+int text_pagination_estimate_index(const pagination_t *pg, int page_index);
+
+/**
+ * Estimate the page number of an offset within the whole book
+ * Offsets on laid out pages get that page's estimate; others are placed
+ * from the average bytes per page.
+ * @param pg: Pagination context
+ * @param offset: Byte offset in source text
+ * @return: Estimated 0-indexed page number
+ */
+int text_pagination_estimate_page(const pagination_t *pg, int offset);
+
+/**
+ * Estimate the total page count of the book
+ * @param pg: Pagination context
+ * @return: Exact page count once complete, otherwise an estimate
  */
-int text_renderer_repaginate(pagination_t *pg, int current_page);
+int text_pagination_estimate_total(const pagination_t *pg);
 
 #endif /* TEXT_RENDERER_H */
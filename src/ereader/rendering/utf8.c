@@ -0,0 +1,97 @@
+/*
+ * utf8.c - UTF-8 Decoding Implementation
+ *
+ * utf8_length() skips the ASCII prefix a machine word at a time (no byte
+ * has bit 7 set) and decodes from the first other byte on, so its count
+ * always matches the number of utf8_decode() steps, malformed input
+ * included. utf8_valid_prefix() goes back to word steps after every
+ * multi-byte character, since non-ASCII text is mostly ASCII too.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include <string.h>
+#include "utf8.h"
+
+typedef unsigned long word_t;
+
+#define WORD_BYTES  sizeof(word_t)
+#define HIGHS       ((word_t)-1 / 0xFF * 0x80)    /* 0x8080...80 */
+
+/**
+ * Count the characters in a byte range
+ */
+size_t utf8_length(const char *text, size_t length) {
+    size_t i = 0;
+
+    /* Skip the ASCII prefix; for most words that is the whole range */
+    for (; i + WORD_BYTES <= length; i += WORD_BYTES) {
+        word_t w;
+        memcpy(&w, text + i, WORD_BYTES);
+        if (w & HIGHS) break;
+    }
+    while (i < length && !((unsigned char)text[i] & 0x80)) {
+        i++;
+    }
+    if (i == length) {
+        return length;
+    }
+
+    /* Decode the rest */
+    size_t count = i;
+    while (i < length) {
+        uint32_t cp;
+        i += utf8_decode(text + i, length - i, &cp);
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * Find the end of the valid UTF-8 prefix of a byte range
+ */
+size_t utf8_valid_prefix(const char *text, size_t length) {
+    size_t i = 0;
+
+    while (i < length) {
+        for (; i + WORD_BYTES <= length; i += WORD_BYTES) {
+            word_t w;
+            memcpy(&w, text + i, WORD_BYTES);
+            if (w & HIGHS) break;
+        }
+        while (i < length && !((unsigned char)text[i] & 0x80)) {
+            i++;
+        }
+        if (i == length) {
+            break;
+        }
+
+        /* utf8_decode() consumes a single byte only for ASCII or bad input */
+        uint32_t cp;
+        size_t step = utf8_decode(text + i, length - i, &cp);
+        if (step == 1) {
+            return i;
+        }
+        i += step;
+    }
+
+    return length;
+}
@@ -0,0 +1,170 @@
+/*
+ * utf8.h - UTF-8 Decoding for Text Layout and Rendering
+ *
+ * Book text is UTF-8 (EPUB always, TXT usually). Layout and rendering walk
+ * it a character at a time; ASCII bytes are their own codepoint, so the
+ * decoder is only entered for bytes >= 0x80 and ASCII runs cost no more
+ * than before.
+ *
+ * Malformed input (stray continuation bytes, overlong forms, surrogates,
+ * truncated sequences) decodes to UTF8_REPLACEMENT one byte at a time, so
+ * any byte string can be laid out and the layout always makes progress.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define UTF8_MAX_BYTES      4         /* Longest encoded character */
+#define UTF8_REPLACEMENT    0xFFFD    /* Decoded for malformed input */
+#define UTF8_MAX_CODEPOINT  0x10FFFF
+
+/**
+ * Check whether a byte continues a multi-byte character
+ * @param c: Byte
+ * @return: true for 10xxxxxx bytes
+ */
+static inline bool utf8_is_continuation(char c) {
+    return ((unsigned char)c & 0xC0) == 0x80;
+}
+
+/**
+ * Decode one character
+ *
+ * Bytes are checked one at a time, so a NUL-terminated string can be
+ * passed with avail = SIZE_MAX: the NUL ends any sequence it interrupts.
+ *
+ * @param text: Text at the start of a character
+ * @param avail: Bytes available at text (at least 1)
+ * @param cp: Output codepoint
+ * @return: Number of bytes consumed (1 to UTF8_MAX_BYTES)
+ */
+static inline size_t utf8_decode(const char *text, size_t avail, uint32_t *cp) {
+    const unsigned char *p = (const unsigned char *)text;
+    unsigned char lead = p[0];
+    size_t len;
+    uint32_t c, min;
+
+    if (lead < 0x80) {
+        *cp = lead;
+        return 1;
+    } else if (lead >= 0xC2 && lead <= 0xDF) {
+        len = 2;
+        c = lead & 0x1F;
+        min = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        len = 3;
+        c = lead & 0x0F;
+        min = 0x800;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        len = 4;
+        c = lead & 0x07;
+        min = 0x10000;
+    } else {
+        *cp = UTF8_REPLACEMENT;
+        return 1;
+    }
+
+    for (size_t i = 1; i < len; i++) {
+        if (i >= avail || (p[i] & 0xC0) != 0x80) {
+            *cp = UTF8_REPLACEMENT;
+            return 1;
+        }
+        c = (c << 6) | (p[i] & 0x3F);
+    }
+
+    if (c < min || c > UTF8_MAX_CODEPOINT || (c >= 0xD800 && c <= 0xDFFF)) {
+        *cp = UTF8_REPLACEMENT;
+        return 1;
+    }
+
+    *cp = c;
+    return len;
+}
+
+/**
+ * Get the encoded length of a codepoint
+ * @param cp: Codepoint (at most UTF8_MAX_CODEPOINT)
+ * @return: Number of bytes utf8_encode() writes
+ */
+static inline size_t utf8_encoded_length(uint32_t cp) {
+    return (cp < 0x80) ? 1 : (cp < 0x800) ? 2 : (cp < 0x10000) ? 3 : 4;
+}
+
+/**
+ * Encode one character
+ * @param cp: Codepoint (at most UTF8_MAX_CODEPOINT, not a surrogate)
+ * @param out: Output buffer with room for UTF8_MAX_BYTES
+ * @return: Number of bytes written
+ */
+static inline size_t utf8_encode(uint32_t cp, char *out) {
+    unsigned char *p = (unsigned char *)out;
+
+    if (cp < 0x80) {
+        p[0] = (unsigned char)cp;
+        return 1;
+    } else if (cp < 0x800) {
+        p[0] = 0xC0 | (cp >> 6);
+        p[1] = 0x80 | (cp & 0x3F);
+        return 2;
+    } else if (cp < 0x10000) {
+        p[0] = 0xE0 | (cp >> 12);
+        p[1] = 0x80 | ((cp >> 6) & 0x3F);
+        p[2] = 0x80 | (cp & 0x3F);
+        return 3;
+    }
+    p[0] = 0xF0 | (cp >> 18);
+    p[1] = 0x80 | ((cp >> 12) & 0x3F);
+    p[2] = 0x80 | ((cp >> 6) & 0x3F);
+    p[3] = 0x80 | (cp & 0x3F);
+    return 4;
+}
+
+/**
+ * Count the characters in a byte range
+ *
+ * An ASCII prefix is counted a machine word at a time. The result equals the
+ * number of utf8_decode() steps over the range, malformed input included.
+ *
+ * @param text: Text (need not be NUL-terminated)
+ * @param length: Number of bytes
+ * @return: Number of characters
+ */
+size_t utf8_length(const char *text, size_t length);
+
+/**
+ * Find the end of the valid UTF-8 prefix of a byte range
+ *
+ * ASCII is skipped a machine word at a time, so valid text costs about one
+ * pass over memory. Overlong forms, surrogates and codepoints above
+ * U+10FFFF are invalid, as is a sequence cut off by the end of the range.
+ *
+ * @param text: Text (need not be NUL-terminated)
+ * @param length: Number of bytes
+ * @return: Offset of the first invalid byte, or length if all are valid
+ */
+size_t utf8_valid_prefix(const char *text, size_t length);
+
+#endif /* UTF8_H */
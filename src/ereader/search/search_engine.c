@@ -53,15 +53,17 @@
 #include <ctype.h>
 
 /* Internal helper function prototypes */
-static char* search_to_lowercase(const char *str);
+static char* search_to_lowercase(const char *str, size_t length);
+static const char* search_find(const char *text, size_t text_length,
+                               const char *term, size_t term_length);
 static int search_strstr_case_insensitive(const char *haystack, const char *needle, size_t haystack_len);
 
 /*
  * Search Context Management
  */
 
-search_context_t* search_create(const char *text, size_t text_length, pagination_t *pagination) {
-    if (!text || !pagination) {
+search_context_t* search_create(pagination_t *pagination) {
+    if (!pagination) {
         return NULL;
     }
 
@@ -70,8 +72,6 @@ search_context_t* search_create(const char *text, size_t text_length, pagination
         return NULL;
     }
 
-    ctx->source_text = text;
-    ctx->source_length = text_length;
     ctx->pagination = pagination;
     ctx->current_result = -1;
     ctx->search_active = false;
@@ -122,22 +122,22 @@ void search_clear(search_context_t *ctx) {
  *
  * Algorithm:
  * 1. Validate and store search parameters
- * 2. For case-insensitive search: create lowercase copies of text and term
- * 3. Use strstr() to find all matches (linear scan through text)
- * 4. For each match: calculate offset and map to page number
- * 5. Store results up to MAX_SEARCH_RESULTS limit
- * 6. Clean up temporary buffers and set search active state
+ * 2. Walk the text a chunk at a time through the pagination context
+ * 3. For case-insensitive search: lowercase a copy of the chunk and term
+ * 4. Find all matches in the chunk (memchr on the first byte, then memcmp)
+ * 5. For each match: calculate offset and map to page number if laid out
+ * 6. Store results up to MAX_SEARCH_RESULTS limit
  *
  * Case-Insensitive Search Strategy:
- * - Allocates full lowercase copy of book text (memory-intensive for large books)
- * - Alternative would be character-by-character comparison (slower but less memory)
- * - Current approach prioritizes search speed over memory usage
+ * - Allocates a lowercase copy of one chunk at a time, so memory use is
+ *   bounded by the largest chunk rather than the whole book
+ * - Matches do not span chunks (chunks are chapters or whole files)
  *
  * Offset-to-Page Mapping:
  * - Each match offset is converted to page number via pagination system
  * - Pagination system maintains page boundaries (start_offset, end_offset)
- * - Binary search would be more efficient but linear search is simpler
- *   for small page counts (typically <1000 pages)
+ * - Matches on pages not laid out yet are kept with page_number -1; the
+ *   offset is mapped to a page when the user navigates to the result
  *
  * Parameters:
  *   ctx            - Search context containing text and pagination data
@@ -180,46 +180,55 @@ int search_execute(search_context_t *ctx, const char *term, bool case_sensitive)
     ctx->search_term[MAX_SEARCH_TERM_LENGTH - 1] = '\0';
     ctx->case_sensitive = case_sensitive;
 
-    /* Prepare search strings based on case sensitivity */
-    char *search_text = NULL;
+    /* Prepare search term based on case sensitivity */
     char *search_term = NULL;
-
     if (!case_sensitive) {
-        /* Create lowercase copies for case-insensitive matching */
-        search_text = search_to_lowercase(ctx->source_text);
-        search_term = search_to_lowercase(term);
-        if (!search_text || !search_term) {
-            /* Memory allocation failed */
-            free(search_text);
-            free(search_term);
+        search_term = search_to_lowercase(term, term_len);
+        if (!search_term) {
             return SEARCH_ERROR_OUT_OF_MEMORY;
         }
     }
-
-    /* Select appropriate text buffers for searching */
-    const char *text_to_search = case_sensitive ? ctx->source_text : search_text;
     const char *term_to_search = case_sensitive ? term : search_term;
-    const char *current_pos = text_to_search;
-    const char *text_end = text_to_search + ctx->source_length;
-    int offset = 0;
-
-    /* Search for all occurrences using strstr() */
-    while (current_pos < text_end && ctx->result_count < MAX_SEARCH_RESULTS) {
-        /* Find next occurrence of search term */
-        const char *match = strstr(current_pos, term_to_search);
-        if (!match) {
-            break;  /* No more matches */
+
+    /* Search each chunk of the text in turn */
+    text_chunk_t chunk;
+    size_t chunk_start = 0;
+    while (ctx->result_count < MAX_SEARCH_RESULTS &&
+           text_pagination_chunk_at(ctx->pagination, chunk_start, &chunk) == 0) {
+        if (!chunk.text) {
+            chunk_start = chunk.offset + chunk.length;  /* Blank: nothing to find */
+            continue;
         }
 
-        /* Calculate character offset in original text */
-        offset = (int)(match - text_to_search);
+        char *search_text = NULL;
+        if (!case_sensitive) {
+            /* Lowercase copy of this chunk only */
+            search_text = search_to_lowercase(chunk.text, chunk.length);
+            if (!search_text) {
+                free(search_term);
+                return SEARCH_ERROR_OUT_OF_MEMORY;
+            }
+        }
+
+        const char *text_to_search = case_sensitive ? chunk.text : search_text;
+        const char *current_pos = text_to_search;
+        const char *text_end = text_to_search + chunk.length;
+
+        while (current_pos < text_end && ctx->result_count < MAX_SEARCH_RESULTS) {
+            /* Find next occurrence of search term */
+            const char *match = search_find(current_pos, (size_t)(text_end - current_pos),
+                                            term_to_search, term_len);
+            if (!match) {
+                break;  /* No more matches */
+            }
+
+            /* Calculate character offset in original text */
+            int offset = (int)(chunk.offset + (size_t)(match - text_to_search));
 
-        /* Map offset to page number via pagination system */
-        int page = search_find_page_for_offset(ctx->pagination, offset);
-        if (page >= 0) {
-            /* Store valid result */
+            /* Map offset to page number via pagination system (-1 if not laid out yet) */
             ctx->results[ctx->result_count].offset = offset;
-            ctx->results[ctx->result_count].page_number = page;
+            ctx->results[ctx->result_count].page_number =
+                search_find_page_for_offset(ctx->pagination, offset);
 
             /* Line/character position within page - currently unused but reserved
              * for future features like highlighting search results in text.
@@ -231,19 +240,19 @@ int search_execute(search_context_t *ctx, const char *term, bool case_sensitive)
             ctx->results[ctx->result_count].char_in_line = 0;
 
             ctx->result_count++;
-        }
 
-        /* Move to next character to allow overlapping matches
-         * Example: searching "AA" in "AAAA" finds 3 matches at positions 0, 1, 2 */
-        current_pos = match + 1;
-    }
+            /* Move to next character to allow overlapping matches
+             * Example: searching "AA" in "AAAA" finds 3 matches at positions 0, 1, 2 */
+            current_pos = match + 1;
+        }
 
-    /* Clean up temporary buffers used for case-insensitive search */
-    if (!case_sensitive) {
         free(search_text);
-        free(search_term);
+        chunk_start = chunk.offset + chunk.length;
     }
 
+    /* Clean up temporary buffer used for case-insensitive search */
+    free(search_term);
+
     /* Update search state and return results */
     if (ctx->result_count > 0) {
         ctx->search_active = true;
@@ -344,9 +353,10 @@ const char* search_get_term(search_context_t *ctx) {
  * This is used to navigate to search results and bookmarks.
  *
  * Algorithm:
- * - Linear search through all pages checking offset ranges
- * - Each page has start_offset and end_offset defining its text span
- * - Returns first page whose range contains the offset
+ * - Binary search over the laid out pages (text_pagination_find_page)
+ * - Pages are ordered by start_offset, so the page containing an offset is
+ *   the last page starting at or before it
+ * - Whitespace skipped between pages belongs to the preceding page
  *
  * Example:
  *   Page 0: offsets 0-1000
@@ -354,10 +364,8 @@ const char* search_get_term(search_context_t *ctx) {
  *   Page 2: offsets 2001-3000
  *   search_find_page_for_offset(pagination, 1500) returns 1
  *
- * Optimization Possibilities:
- * - Binary search would be O(log n) instead of O(n) for large page counts
- * - However, typical books have <1000 pages, so linear search is fast enough
- * - Binary search would require pages to be sorted by offset (currently guaranteed)
+ * Page lines are not built here; text_get_page() would lay out every page
+ * it touched.
  *
  * Parameters:
  *   pagination - Pagination structure containing page offset information
@@ -365,33 +373,17 @@ const char* search_get_term(search_context_t *ctx) {
  *
  * Returns:
  *   Page number (0-based index) if offset is found
- *   -1 if offset is invalid or not found in any page
+ *   -1 if offset is invalid or not in a laid out page
  *
  * Performance:
- *   O(n) where n is page count
- *   Typical book with 500 pages: <0.1ms on Pi Zero W
+ *   O(log n) where n is page count
  */
 int search_find_page_for_offset(pagination_t *pagination, int offset) {
     if (!pagination || offset < 0) {
         return -1;
     }
 
-    /* Linear search through pages to find which one contains this offset
-     * Pages are ordered sequentially, so we could optimize with binary search
-     * if performance becomes an issue for very large books */
-    for (int i = 0; i < pagination->page_count; i++) {
-        text_page_t *page = text_get_page(pagination, i);
-        if (!page) {
-            continue;  /* Skip invalid pages */
-        }
-
-        /* Check if offset falls within this page's range (inclusive bounds) */
-        if (offset >= page->start_offset && offset <= page->end_offset) {
-            return i;  /* Found the page */
-        }
-    }
-
-    return -1;  /* Offset not found in any page (invalid offset or pagination error) */
+    return text_pagination_find_page(pagination, offset);
 }
 
 const char* search_error_string(search_error_t error) {
@@ -418,26 +410,54 @@ const char* search_error_string(search_error_t error) {
  */
 
 /**
- * Convert a string to lowercase (allocates new string)
+ * Convert a byte range to lowercase (allocates new string)
  *
- * @param str: String to convert
+ * @param str: Text to convert (need not be null-terminated)
+ * @param length: Number of bytes to convert
  * @return: Newly allocated lowercase string, or NULL on error (caller must free)
  */
-static char* search_to_lowercase(const char *str) {
+static char* search_to_lowercase(const char *str, size_t length) {
     if (!str) {
         return NULL;
     }
 
-    size_t len = strlen(str);
-    char *result = (char*)malloc(len + 1);
+    char *result = (char*)malloc(length + 1);
     if (!result) {
         return NULL;
     }
 
-    for (size_t i = 0; i < len; i++) {
+    for (size_t i = 0; i < length; i++) {
         result[i] = tolower((unsigned char)str[i]);
     }
-    result[len] = '\0';
+    result[length] = '\0';
 
     return result;
 }
+
+/**
+ * Find the first occurrence of a term in a byte range
+ * Unlike strstr(), the text need not be null-terminated.
+ *
+ * @param text: Text to search
+ * @param text_length: Number of bytes in text
+ * @param term: Term to find
+ * @param term_length: Number of bytes in term (must be > 0)
+ * @return: Pointer to the match within text, or NULL if not found
+ */
+static const char* search_find(const char *text, size_t text_length,
+                               const char *term, size_t term_length) {
+    const char *end = text + text_length;
+
+    while ((size_t)(end - text) >= term_length) {
+        const char *hit = memchr(text, term[0], (size_t)(end - text) - term_length + 1);
+        if (!hit) {
+            return NULL;
+        }
+        if (memcmp(hit, term, term_length) == 0) {
+            return hit;
+        }
+        text = hit + 1;
+    }
+
+    return NULL;
+}
@@ -46,7 +46,7 @@
  */
 typedef struct {
     int offset;              /* Character offset in source text */
-    int page_number;         /* Page number where match occurs (0-based) */
+    int page_number;         /* Page index when searched (0-based), -1 if not laid out yet */
     int line_in_page;        /* Line number within the page (0-based) */
     int char_in_line;        /* Character position within the line */
 } search_result_t;
@@ -63,9 +63,7 @@ typedef struct {
     int result_count;                           /* Number of results found */
     int current_result;                         /* Current result index (-1 if none) */
 
-    const char *source_text;                    /* Pointer to text being searched (not owned) */
-    size_t source_length;                       /* Length of source text */
-    pagination_t *pagination;                   /* Pagination context (not owned) */
+    pagination_t *pagination;                   /* Pagination context supplying the text (not owned) */
 
     bool search_active;                         /* Whether a search is currently active */
 } search_context_t;
@@ -89,12 +87,14 @@ typedef enum {
 /**
  * Create a new search context
  *
- * @param text: Source text to search (must remain valid during search context lifetime)
- * @param text_length: Length of source text in bytes
- * @param pagination: Pagination context for mapping offsets to pages (must remain valid)
+ * The text is read a chunk at a time through the pagination context, so a
+ * book supplied in chunks never has to be in memory all at once.
+ *
+ * @param pagination: Pagination context supplying the text and mapping offsets
+ *                    to pages (must remain valid)
  * @return: Pointer to search context, or NULL on error
  */
-search_context_t* search_create(const char *text, size_t text_length, pagination_t *pagination);
+search_context_t* search_create(pagination_t *pagination);
 
 /**
  * Free search context and associated resources
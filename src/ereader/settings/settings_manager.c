@@ -67,6 +67,7 @@ void settings_init_defaults(settings_t *settings) {
     settings->margins = MARGINS_DEFAULT;
     settings->display_mode = DISPLAY_MODE_DEFAULT;
     settings->auto_sleep_minutes = AUTO_SLEEP_DEFAULT;
+    settings->library_sort = LIBRARY_SORT_DEFAULT;
 }
 
 /*
@@ -157,6 +158,14 @@ settings_error_t settings_load(settings_t *settings, const char *filepath) {
                 fprintf(stderr, "Settings: Invalid auto_sleep_minutes value: %s\n", value);
                 had_errors = true;
             }
+        } else if (strcmp(key, "library_sort") == 0) {
+            library_sort_t sort;
+            if (settings_library_sort_from_string(value, &sort)) {
+                settings->library_sort = sort;
+            } else {
+                fprintf(stderr, "Settings: Invalid library_sort value: %s\n", value);
+                had_errors = true;
+            }
         } else {
             fprintf(stderr, "Settings: Unknown setting: %s\n", key);
             had_errors = true;
@@ -194,6 +203,7 @@ settings_error_t settings_save(const settings_t *settings, const char *filepath)
     fprintf(fp, "margins=%s\n", settings_margins_to_string(settings->margins));
     fprintf(fp, "display_mode=%s\n", settings_display_mode_to_string(settings->display_mode));
     fprintf(fp, "auto_sleep_minutes=%s\n", settings_auto_sleep_to_string(settings->auto_sleep_minutes));
+    fprintf(fp, "library_sort=%s\n", settings_library_sort_to_string(settings->library_sort));
 
     fclose(fp);
     return SETTINGS_SUCCESS;
@@ -222,6 +232,10 @@ auto_sleep_t settings_get_auto_sleep(const settings_t *settings) {
     return settings ? settings->auto_sleep_minutes : AUTO_SLEEP_DEFAULT;
 }
 
+library_sort_t settings_get_library_sort(const settings_t *settings) {
+    return settings ? settings->library_sort : LIBRARY_SORT_DEFAULT;
+}
+
 /*
  * Setters
  */
@@ -245,6 +259,10 @@ void settings_set_auto_sleep(settings_t *settings, auto_sleep_t minutes) {
     if (settings) settings->auto_sleep_minutes = minutes;
 }
 
+void settings_set_library_sort(settings_t *settings, library_sort_t sort) {
+    if (settings) settings->library_sort = sort;
+}
+
 /*
  * Convert settings values to strings
  */
@@ -292,6 +310,17 @@ const char* settings_auto_sleep_to_string(auto_sleep_t minutes) {
     return buffer;
 }
 
+const char* settings_library_sort_to_string(library_sort_t sort) {
+    switch (sort) {
+        case LIBRARY_SORT_TITLE:     return "title";
+        case LIBRARY_SORT_AUTHOR:    return "author";
+        case LIBRARY_SORT_ADDED:     return "added";
+        case LIBRARY_SORT_LAST_READ: return "last_read";
+        case LIBRARY_SORT_FORMAT:    return "format";
+        default:                     return "title";
+    }
+}
+
 /*
  * Convert strings to settings values
  */
@@ -373,6 +402,28 @@ bool settings_auto_sleep_from_string(const char *str, auto_sleep_t *minutes) {
     return false;
 }
 
+bool settings_library_sort_from_string(const char *str, library_sort_t *sort) {
+    if (str == NULL || sort == NULL) return false;
+
+    if (strcmp(str, "title") == 0) {
+        *sort = LIBRARY_SORT_TITLE;
+        return true;
+    } else if (strcmp(str, "author") == 0) {
+        *sort = LIBRARY_SORT_AUTHOR;
+        return true;
+    } else if (strcmp(str, "added") == 0) {
+        *sort = LIBRARY_SORT_ADDED;
+        return true;
+    } else if (strcmp(str, "last_read") == 0) {
+        *sort = LIBRARY_SORT_LAST_READ;
+        return true;
+    } else if (strcmp(str, "format") == 0) {
+        *sort = LIBRARY_SORT_FORMAT;
+        return true;
+    }
+    return false;
+}
+
 /*
  * Convert error code to string
  */
@@ -92,6 +92,19 @@ typedef enum {
     AUTO_SLEEP_DEFAULT = AUTO_SLEEP_15_MIN
 } auto_sleep_t;
 
+/*
+ * Library sort options
+ * Same order as book_sort_key_t, so one converts to the other by cast
+ */
+typedef enum {
+    LIBRARY_SORT_TITLE = 0,
+    LIBRARY_SORT_AUTHOR = 1,
+    LIBRARY_SORT_ADDED = 2,
+    LIBRARY_SORT_LAST_READ = 3,
+    LIBRARY_SORT_FORMAT = 4,
+    LIBRARY_SORT_DEFAULT = LIBRARY_SORT_TITLE
+} library_sort_t;
+
 /*
  * Settings structure
  *
@@ -103,6 +116,7 @@ typedef struct {
     margins_t margins;
     display_mode_t display_mode;
     auto_sleep_t auto_sleep_minutes;
+    library_sort_t library_sort;
 } settings_t;
 
 /*
@@ -161,6 +175,7 @@ line_spacing_t settings_get_line_spacing(const settings_t *settings);
 margins_t settings_get_margins(const settings_t *settings);
 display_mode_t settings_get_display_mode(const settings_t *settings);
 auto_sleep_t settings_get_auto_sleep(const settings_t *settings);
+library_sort_t settings_get_library_sort(const settings_t *settings);
 
 /*
  * Setters for individual settings
@@ -170,6 +185,7 @@ void settings_set_line_spacing(settings_t *settings, line_spacing_t spacing);
 void settings_set_margins(settings_t *settings, margins_t margins);
 void settings_set_display_mode(settings_t *settings, display_mode_t mode);
 void settings_set_auto_sleep(settings_t *settings, auto_sleep_t minutes);
+void settings_set_library_sort(settings_t *settings, library_sort_t sort);
 
 /*
  * Convert settings values to human-readable strings
@@ -179,6 +195,7 @@ const char* settings_line_spacing_to_string(line_spacing_t spacing);
 const char* settings_margins_to_string(margins_t margins);
 const char* settings_display_mode_to_string(display_mode_t mode);
 const char* settings_auto_sleep_to_string(auto_sleep_t minutes);
+const char* settings_library_sort_to_string(library_sort_t sort);
 
 /*
  * Convert strings to settings values
@@ -192,6 +209,7 @@ bool settings_line_spacing_from_string(const char *str, line_spacing_t *spacing)
 bool settings_margins_from_string(const char *str, margins_t *margins);
 bool settings_display_mode_from_string(const char *str, display_mode_t *mode);
 bool settings_auto_sleep_from_string(const char *str, auto_sleep_t *minutes);
+bool settings_library_sort_from_string(const char *str, library_sort_t *sort);
 
 /*
  * Convert error code to string
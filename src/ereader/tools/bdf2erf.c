@@ -0,0 +1,433 @@
+/*
+ * bdf2erf.c - Convert BDF Bitmap Fonts to the E-Reader Font Format
+ *
+ * Host tool that turns a BDF font into an .erf file (see rendering/font.h)
+ * for installation in FONT_DIR. Glyphs are placed in a fixed cell of the
+ * font's ascent + descent rows so the device can blit them without any
+ * per-glyph offsets. PCF fonts can be converted with pcf2bdf first.
+ *
+ * Usage: bdf2erf [-f family] [-r first-last] input.bdf output.erf
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "../rendering/font.h"
+
+#define LINE_MAX_LEN 1024
+
+/* Glyph as parsed from the BDF file */
+typedef struct {
+    uint32_t codepoint;
+    int advance;
+    uint8_t *bitmap;             /* height x row_bytes, cell-aligned */
+} glyph_t;
+
+/* Font as parsed from the BDF file */
+typedef struct {
+    char family[FONT_FILE_FAMILY_SIZE];
+    int bbox_width;
+    int bbox_height;
+    int bbox_yoff;
+    int ascent;
+    int descent;
+    int width;
+    int height;
+    int row_bytes;
+    glyph_t *glyphs;
+    int glyph_count;
+    int glyph_capacity;
+} bdf_font_t;
+
+/* Raw glyph bitmap rows (BBX-sized) collected before placing in the cell */
+typedef struct {
+    uint32_t rows[FONT_MAX_HEIGHT * 2];
+    int row_count;
+    int bbx_width;
+    int bbx_height;
+    int bbx_xoff;
+    int bbx_yoff;
+} raw_glyph_t;
+
+/*
+ * Helpers
+ */
+
+static void write_le16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void write_le32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static int starts_with(const char *line, const char *keyword) {
+    size_t len = strlen(keyword);
+    return strncmp(line, keyword, len) == 0 && (line[len] == ' ' || line[len] == '\n' ||
+                                                 line[len] == '\r' || line[len] == '\0');
+}
+
+static int compare_glyphs(const void *a, const void *b) {
+    uint32_t ca = ((const glyph_t *)a)->codepoint;
+    uint32_t cb = ((const glyph_t *)b)->codepoint;
+    return (ca > cb) - (ca < cb);
+}
+
+/**
+ * Copy a quoted or bare property value into dest
+ */
+static void parse_string_property(const char *line, char *dest, size_t size) {
+    const char *value = strchr(line, ' ');
+    if (!value) return;
+    while (*value == ' ') value++;
+    if (*value == '"') value++;
+
+    size_t len = 0;
+    while (value[len] && value[len] != '"' && value[len] != '\n' && value[len] != '\r' &&
+           len < size - 1) {
+        len++;
+    }
+    memcpy(dest, value, len);
+    dest[len] = '\0';
+}
+
+/*
+ * Parsing
+ */
+
+/**
+ * Place a BBX-sized bitmap into the font cell
+ *
+ * Pixels that fall outside the cell are dropped.
+ */
+static void place_glyph(const bdf_font_t *font, const raw_glyph_t *raw, uint8_t *bitmap) {
+    int top = font->ascent - (raw->bbx_yoff + raw->bbx_height);
+    int row_bits = ((raw->bbx_width + 7) / 8) * 8;
+
+    for (int j = 0; j < raw->row_count; j++) {
+        int row = top + j;
+        if (row < 0 || row >= font->height) continue;
+
+        for (int i = 0; i < raw->bbx_width; i++) {
+            int col = raw->bbx_xoff + i;
+            if (col < 0 || col >= font->width) continue;
+            if (raw->rows[j] & (1u << (row_bits - 1 - i))) {
+                bitmap[row * font->row_bytes + col / 8] |= (uint8_t)(0x80 >> (col % 8));
+            }
+        }
+    }
+}
+
+/**
+ * Add a glyph to the font
+ */
+static int add_glyph(bdf_font_t *font, uint32_t codepoint, int advance, const raw_glyph_t *raw) {
+    if (font->glyph_count == font->glyph_capacity) {
+        int capacity = font->glyph_capacity ? font->glyph_capacity * 2 : 256;
+        glyph_t *glyphs = realloc(font->glyphs, sizeof(glyph_t) * capacity);
+        if (!glyphs) return -1;
+        font->glyphs = glyphs;
+        font->glyph_capacity = capacity;
+    }
+
+    uint8_t *bitmap = calloc(font->height, font->row_bytes);
+    if (!bitmap) return -1;
+    place_glyph(font, raw, bitmap);
+
+    glyph_t *glyph = &font->glyphs[font->glyph_count++];
+    glyph->codepoint = codepoint;
+    glyph->advance = advance;
+    glyph->bitmap = bitmap;
+    return 0;
+}
+
+/**
+ * Parse a BDF file
+ *
+ * The header must give the cell geometry (FONTBOUNDINGBOX, and
+ * FONT_ASCENT/FONT_DESCENT if present) before the first glyph.
+ */
+static int parse_bdf(FILE *f, bdf_font_t *font, uint32_t range_first, uint32_t range_last) {
+    char line[LINE_MAX_LEN];
+    raw_glyph_t raw;
+    long encoding = -1;
+    int advance = 0;
+    int in_bitmap = 0;
+    int have_bbox = 0;
+    int geometry_ready = 0;
+
+    font->ascent = -1;
+    font->descent = -1;
+
+    while (fgets(line, sizeof(line), f)) {
+        if (in_bitmap) {
+            if (starts_with(line, "ENDCHAR")) {
+                in_bitmap = 0;
+                /* Space is always kept: the device draws it for missing glyphs */
+                if (encoding < 0 || (encoding != ' ' && ((uint32_t)encoding < range_first ||
+                                                         (uint32_t)encoding > range_last))) {
+                    continue;
+                }
+                if (add_glyph(font, (uint32_t)encoding, advance, &raw) != 0) {
+                    fprintf(stderr, "bdf2erf: Out of memory\n");
+                    return -1;
+                }
+            } else if (raw.row_count < (int)(sizeof(raw.rows) / sizeof(raw.rows[0]))) {
+                raw.rows[raw.row_count++] = (uint32_t)strtoul(line, NULL, 16);
+            }
+            continue;
+        }
+
+        if (starts_with(line, "FONTBOUNDINGBOX")) {
+            int xoff;
+            if (sscanf(line, "FONTBOUNDINGBOX %d %d %d %d", &font->bbox_width,
+                       &font->bbox_height, &xoff, &font->bbox_yoff) == 4) {
+                have_bbox = 1;
+            }
+        } else if (starts_with(line, "FONT_ASCENT")) {
+            sscanf(line, "FONT_ASCENT %d", &font->ascent);
+        } else if (starts_with(line, "FONT_DESCENT")) {
+            sscanf(line, "FONT_DESCENT %d", &font->descent);
+        } else if (starts_with(line, "FAMILY_NAME")) {
+            if (font->family[0] == '\0') {
+                parse_string_property(line, font->family, sizeof(font->family));
+            }
+        } else if (starts_with(line, "STARTCHAR")) {
+            if (!geometry_ready) {
+                if (!have_bbox) {
+                    fprintf(stderr, "bdf2erf: Missing FONTBOUNDINGBOX\n");
+                    return -1;
+                }
+                if (font->ascent < 0) font->ascent = font->bbox_height + font->bbox_yoff;
+                if (font->descent < 0) font->descent = -font->bbox_yoff;
+                font->width = font->bbox_width;
+                font->height = font->ascent + font->descent;
+                font->row_bytes = (font->width + 7) / 8;
+                if (font->width <= 0 || font->height <= 0 || font->height > FONT_MAX_HEIGHT ||
+                    font->row_bytes > FONT_MAX_ROW_BYTES) {
+                    fprintf(stderr, "bdf2erf: Unsupported cell size %dx%d (max %dx%d)\n",
+                            font->width, font->height, FONT_MAX_ROW_BYTES * 8, FONT_MAX_HEIGHT);
+                    return -1;
+                }
+                geometry_ready = 1;
+            }
+            memset(&raw, 0, sizeof(raw));
+            encoding = -1;
+            advance = font->width;
+        } else if (starts_with(line, "ENCODING")) {
+            /* "ENCODING -1 n" marks a glyph without a standard codepoint */
+            encoding = strtol(line + 8, NULL, 10);
+        } else if (starts_with(line, "DWIDTH")) {
+            sscanf(line, "DWIDTH %d", &advance);
+        } else if (starts_with(line, "BBX")) {
+            sscanf(line, "BBX %d %d %d %d", &raw.bbx_width, &raw.bbx_height,
+                   &raw.bbx_xoff, &raw.bbx_yoff);
+            if (raw.bbx_width > 32) raw.bbx_width = 32;
+        } else if (starts_with(line, "BITMAP")) {
+            in_bitmap = 1;
+        }
+    }
+
+    if (font->glyph_count == 0) {
+        fprintf(stderr, "bdf2erf: No glyphs found\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * Output
+ */
+
+/**
+ * Write the font in .erf format
+ */
+static int write_erf(bdf_font_t *font, const char *path) {
+    /* Sort by codepoint and drop duplicates (first definition wins) */
+    qsort(font->glyphs, font->glyph_count, sizeof(glyph_t), compare_glyphs);
+    int count = 0;
+    for (int i = 0; i < font->glyph_count; i++) {
+        if (count > 0 && font->glyphs[count - 1].codepoint == font->glyphs[i].codepoint) {
+            free(font->glyphs[i].bitmap);
+            continue;
+        }
+        font->glyphs[count++] = font->glyphs[i];
+    }
+    font->glyph_count = count;
+
+    /* Contiguous codepoints form one range */
+    int range_count = 0;
+    int monospace = 1;
+    for (int i = 0; i < count; i++) {
+        if (i == 0 || font->glyphs[i].codepoint != font->glyphs[i - 1].codepoint + 1) {
+            range_count++;
+        }
+        if (font->glyphs[i].advance != font->glyphs[0].advance) monospace = 0;
+    }
+
+    int max_advance = font->width;
+    for (int i = 0; i < count; i++) {
+        if (font->glyphs[i].advance > max_advance) max_advance = font->glyphs[i].advance;
+    }
+    if (max_advance > 255) max_advance = 255;
+
+    size_t glyph_stride = (size_t)font->height * font->row_bytes;
+    uint32_t ranges_offset = FONT_FILE_HEADER_SIZE + FONT_FILE_FAMILY_SIZE;
+    uint32_t advances_offset = ranges_offset + (uint32_t)range_count * FONT_FILE_RANGE_SIZE;
+    uint32_t bitmaps_offset = advances_offset + (uint32_t)count;
+    size_t size = bitmaps_offset + glyph_stride * count;
+
+    uint8_t *out = calloc(1, size);
+    if (!out) {
+        fprintf(stderr, "bdf2erf: Out of memory\n");
+        return -1;
+    }
+
+    memcpy(out, FONT_FILE_MAGIC, 4);
+    write_le16(out + 4, FONT_FILE_VERSION);
+    write_le16(out + 6, monospace ? FONT_FLAG_MONOSPACE : 0);
+    out[8] = (uint8_t)max_advance;
+    out[9] = (uint8_t)font->height;
+    out[10] = (uint8_t)font->ascent;
+    out[11] = (uint8_t)font->row_bytes;
+    write_le32(out + 12, (uint32_t)count);
+    write_le32(out + 16, (uint32_t)range_count);
+    write_le32(out + 20, ranges_offset);
+    write_le32(out + 24, advances_offset);
+    write_le32(out + 28, bitmaps_offset);
+    memcpy(out + FONT_FILE_HEADER_SIZE, font->family, strlen(font->family));
+
+    uint8_t *range = out + ranges_offset - FONT_FILE_RANGE_SIZE;
+    int range_start = 0;
+    for (int i = 0; i < count; i++) {
+        const glyph_t *glyph = &font->glyphs[i];
+        if (i == 0 || glyph->codepoint != font->glyphs[i - 1].codepoint + 1) {
+            range += FONT_FILE_RANGE_SIZE;
+            range_start = i;
+            write_le32(range, glyph->codepoint);
+            write_le32(range + 8, (uint32_t)i);
+        }
+        write_le32(range + 4, (uint32_t)(i - range_start + 1));
+
+        int advance = glyph->advance;
+        if (advance < 0) advance = 0;
+        if (advance > 255) advance = 255;
+        out[advances_offset + i] = (uint8_t)advance;
+        memcpy(out + bitmaps_offset + glyph_stride * i, glyph->bitmap, glyph_stride);
+    }
+
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        fprintf(stderr, "bdf2erf: Cannot create %s\n", path);
+        free(out);
+        return -1;
+    }
+    int ok = fwrite(out, 1, size, f) == size;
+    ok = (fclose(f) == 0) && ok;
+    free(out);
+
+    if (!ok) {
+        fprintf(stderr, "bdf2erf: Failed to write %s\n", path);
+        return -1;
+    }
+
+    printf("%s: %s %dx%d, %d glyphs in %d ranges, %s, %zu bytes\n",
+           path, font->family, max_advance, font->height, count, range_count,
+           monospace ? "monospace" : "proportional", size);
+    return 0;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-f family] [-r first-last] input.bdf output.erf\n", prog);
+    fprintf(stderr, "  -f family       Family name (default: FAMILY_NAME from the BDF)\n");
+    fprintf(stderr, "  -r first-last   Only keep codepoints in range (e.g. 0x20-0x24F)\n");
+}
+
+int main(int argc, char *argv[]) {
+    bdf_font_t font;
+    uint32_t range_first = 0;
+    uint32_t range_last = UINT32_MAX;
+    const char *family = NULL;
+    int opt;
+
+    memset(&font, 0, sizeof(font));
+
+    while ((opt = getopt(argc, argv, "f:r:h")) != -1) {
+        switch (opt) {
+            case 'f':
+                family = optarg;
+                break;
+            case 'r': {
+                char *end;
+                range_first = (uint32_t)strtoul(optarg, &end, 0);
+                if (*end != '-') {
+                    usage(argv[0]);
+                    return 1;
+                }
+                range_last = (uint32_t)strtoul(end + 1, NULL, 0);
+                break;
+            }
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (argc - optind != 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (family) {
+        strncpy(font.family, family, sizeof(font.family) - 1);
+    }
+
+    FILE *f = fopen(argv[optind], "r");
+    if (!f) {
+        fprintf(stderr, "bdf2erf: Cannot open %s\n", argv[optind]);
+        return 1;
+    }
+    int result = parse_bdf(f, &font, range_first, range_last);
+    fclose(f);
+
+    if (result == 0) {
+        if (font.family[0] == '\0') {
+            strncpy(font.family, "unknown", sizeof(font.family) - 1);
+        }
+        result = write_erf(&font, argv[optind + 1]);
+    }
+
+    for (int i = 0; i < font.glyph_count; i++) {
+        free(font.glyphs[i].bitmap);
+    }
+    free(font.glyphs);
+
+    return result == 0 ? 0 : 1;
+}
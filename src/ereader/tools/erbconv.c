@@ -0,0 +1,792 @@
+/*
+ * erbconv.c - Convert Books into Precompiled .erb Files
+ *
+ * Host tool that turns TXT, EPUB and PDF books into the .erb layout
+ * described in formats/erb_reader.h. Each book is opened with the same
+ * format readers the device uses, its text normalized and split into
+ * chapters, and laid out with the device's text renderer for the standard
+ * reader geometries. The device then opens the book with one mmap() and
+ * turns to any page without extracting or laying out anything.
+ *
+ * Books are converted in parallel, one per worker thread. The output is
+ * written beside each book (or into -o outdir) with .erb appended, and a
+ * book whose output is newer than it is skipped unless -f is given.
+ *
+ * Usage: erbconv [-j jobs] [-a] [-f] [-F fontdir] [-o outdir] book|dir...
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <libxml/parser.h>
+
+#include "../formats/format_interface.h"
+#include "../formats/erb_reader.h"
+#include "../rendering/text_renderer.h"
+#include "../rendering/font.h"
+#include "../rendering/utf8.h"
+#include "../ui/reader_layout.h"
+
+#define ERBCONV_MAX_LAYOUTS  27      /* Every font size, line spacing and margin */
+#define ERBCONV_MAX_JOBS     64
+
+/* Reader geometry a page table is built for */
+typedef struct {
+    settings_t settings;
+    layout_params_t params;
+    uint32_t key;
+} conv_layout_t;
+
+/* Growable byte buffer */
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} buffer_t;
+
+/* Book being converted */
+typedef struct {
+    book_format_type_t format;
+    buffer_t text;
+    buffer_t strings;
+    erb_chapter_t *chapters;
+    uint32_t chapter_count;
+    uint32_t chapter_capacity;
+    erb_layout_t layouts[ERBCONV_MAX_LAYOUTS];
+    uint32_t *tables[ERBCONV_MAX_LAYOUTS];
+    int layout_count;
+    uint32_t title, author, language, source_name;   /* String table offsets */
+} conv_book_t;
+
+/* Shared by the worker threads */
+static conv_layout_t layouts[ERBCONV_MAX_LAYOUTS];
+static int layout_count = 0;
+static char **inputs = NULL;
+static int input_count = 0;
+static int next_input = 0;
+static const char *output_dir = NULL;
+static bool force = false;
+static int converted = 0, skipped = 0, failed = 0;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Buffers
+ */
+
+static int buffer_reserve(buffer_t *buf, size_t extra) {
+    if (extra > SIZE_MAX - buf->length) {
+        return -1;
+    }
+    if (buf->length + extra <= buf->capacity) {
+        return 0;
+    }
+
+    size_t capacity = buf->capacity ? buf->capacity : 64 * 1024;
+    while (capacity < buf->length + extra) {
+        capacity *= 2;
+    }
+    char *grown = realloc(buf->data, capacity);
+    if (!grown) {
+        return -1;
+    }
+    buf->data = grown;
+    buf->capacity = capacity;
+    return 0;
+}
+
+static int buffer_append(buffer_t *buf, const void *data, size_t length) {
+    if (buffer_reserve(buf, length) != 0) {
+        return -1;
+    }
+    memcpy(buf->data + buf->length, data, length);
+    buf->length += length;
+    return 0;
+}
+
+/**
+ * Add a string to the string table
+ * @return: Offset of the string, or 0 ("") on failure
+ */
+static uint32_t add_string(conv_book_t *book, const char *text, size_t length) {
+    if (length == 0 || book->strings.length > UINT32_MAX - length - 1) {
+        return 0;
+    }
+    uint32_t offset = (uint32_t)book->strings.length;
+    if (buffer_reserve(&book->strings, length + 1) != 0) {
+        return 0;
+    }
+    buffer_append(&book->strings, text, length);
+    buffer_append(&book->strings, "", 1);
+    return offset;
+}
+
+static void conv_book_free(conv_book_t *book) {
+    free(book->text.data);
+    free(book->strings.data);
+    free(book->chapters);
+    for (int i = 0; i < book->layout_count; i++) {
+        free(book->tables[i]);
+    }
+}
+
+/*
+ * Text
+ */
+
+/**
+ * Append a chunk of book text as UTF-8 with LF line ends
+ * Carriage returns become line feeds, NULs are dropped and malformed
+ * sequences become U+FFFD, so the device never meets them.
+ */
+static int append_normalized(buffer_t *text, const char *chunk, size_t length) {
+    /* One more byte for the line feed finish_chapter() may add */
+    if (buffer_reserve(text, length + 1) != 0) {
+        return -1;
+    }
+
+    size_t i = 0;
+    while (i < length) {
+        unsigned char c = (unsigned char)chunk[i];
+        if (c == '\r') {
+            i += (i + 1 < length && chunk[i + 1] == '\n') ? 1 : 0;
+            c = '\n';
+        }
+        if (c < 0x80) {
+            if (c != '\0') {
+                text->data[text->length++] = (char)c;
+            }
+            i++;
+            continue;
+        }
+
+        uint32_t cp;
+        size_t n = utf8_decode(chunk + i, length - i, &cp);
+        if (cp == UTF8_REPLACEMENT && n == 1) {
+            /* Three bytes replace one; make room for the rest */
+            if (buffer_reserve(text, UTF8_MAX_BYTES + length - i + 1) != 0) {
+                return -1;
+            }
+            text->length += utf8_encode(cp, text->data + text->length);
+        } else {
+            memcpy(text->data + text->length, chunk + i, n);
+            text->length += n;
+        }
+        i += n;
+    }
+    return 0;
+}
+
+/**
+ * Drop trailing blank lines and spaces back to start, then end the text
+ * with one line feed
+ * @return: Length of the text from start (0 if it was all blank)
+ */
+static size_t finish_chapter(buffer_t *text, size_t start) {
+    while (text->length > start) {
+        char c = text->data[text->length - 1];
+        if (c != '\n' && c != ' ' && c != '\t') {
+            break;
+        }
+        text->length--;
+    }
+    if (text->length > start) {
+        text->data[text->length++] = '\n';  /* Reserved by append_normalized() */
+    }
+    return text->length - start;
+}
+
+/**
+ * Title of a chapter: its first non-blank line, cut at ERB_TITLE_MAX bytes
+ */
+static uint32_t chapter_title(conv_book_t *book, const char *text, size_t length) {
+    size_t start = 0;
+    while (start < length && (text[start] == '\n' || text[start] == ' ' || text[start] == '\t')) {
+        start++;
+    }
+    size_t end = start;
+    while (end < length && text[end] != '\n') {
+        end++;
+    }
+    while (end > start && (text[end - 1] == ' ' || text[end - 1] == '\t')) {
+        end--;
+    }
+    if (end - start > ERB_TITLE_MAX) {
+        end = start + ERB_TITLE_MAX;
+        while (end > start && ((unsigned char)text[end] & 0xC0) == 0x80) {
+            end--;
+        }
+    }
+    return add_string(book, text + start, end - start);
+}
+
+static int add_chapter(conv_book_t *book, size_t offset, size_t length) {
+    if (book->chapter_count == book->chapter_capacity) {
+        uint32_t capacity = book->chapter_capacity ? book->chapter_capacity * 2 : 64;
+        erb_chapter_t *grown = realloc(book->chapters, capacity * sizeof(erb_chapter_t));
+        if (!grown) {
+            return -1;
+        }
+        book->chapters = grown;
+        book->chapter_capacity = capacity;
+    }
+
+    erb_chapter_t *chapter = &book->chapters[book->chapter_count];
+    chapter->text_offset = (uint32_t)offset;
+    chapter->text_length = (uint32_t)length;
+    if (book->format == BOOK_FORMAT_PDF) {
+        char title[32];
+        int n = snprintf(title, sizeof(title), "Page %u", book->chapter_count + 1);
+        chapter->title = add_string(book, title, (size_t)n);
+    } else {
+        chapter->title = chapter_title(book, book->text.data + offset, length);
+    }
+    book->chapter_count++;
+    return 0;
+}
+
+/**
+ * Read the whole text of an open book into chapters
+ * EPUB spine items and PDF pages become chapters; plain text is one
+ * chapter however its reader chunks it.
+ */
+static int read_chapters(conv_book_t *book, const book_format_interface_t *interface,
+                         format_handle_t handle) {
+    size_t length;
+    format_chunk_t chunk;
+    bool single = (book->format == BOOK_FORMAT_TXT);
+
+    int result = format_get_length(interface, handle, &length);
+    if (result != FORMAT_SUCCESS) {
+        return result;
+    }
+
+    size_t start = 0;
+    for (size_t offset = 0; offset < length; offset = chunk.offset + chunk.length) {
+        result = format_chunk_at(interface, handle, offset, &chunk);
+        if (result != FORMAT_SUCCESS) {
+            return result;
+        }
+        if (chunk.length == 0 || chunk.offset + chunk.length <= offset) {
+            return FORMAT_ERROR_CORRUPT_FILE;
+        }
+        if (!chunk.text) {
+            continue;  /* Blank room after a PDF page's text */
+        }
+        if (append_normalized(&book->text, chunk.text, chunk.length) != 0) {
+            return FORMAT_ERROR_OUT_OF_MEMORY;
+        }
+        if (book->text.length > ERB_MAX_TEXT_SIZE) {
+            return FORMAT_ERROR_TOO_LARGE;
+        }
+
+        if (!single) {
+            size_t chapter_length = finish_chapter(&book->text, start);
+            if (chapter_length > 0 && add_chapter(book, start, chapter_length) != 0) {
+                return FORMAT_ERROR_OUT_OF_MEMORY;
+            }
+            start = book->text.length;
+        }
+    }
+
+    if (single) {
+        size_t chapter_length = finish_chapter(&book->text, 0);
+        if (chapter_length > 0 && add_chapter(book, 0, chapter_length) != 0) {
+            return FORMAT_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (book->text.length == 0 || book->text.length > ERB_MAX_TEXT_SIZE) {
+        return book->text.length ? FORMAT_ERROR_TOO_LARGE : FORMAT_ERROR_NO_CONTENT;
+    }
+    return FORMAT_SUCCESS;
+}
+
+/*
+ * Layout
+ */
+
+/**
+ * Chunk source for pagination: the chapter containing offset, as the
+ * device's erb_reader serves it
+ */
+static int fetch_chapter(void *source, size_t offset, text_chunk_t *chunk) {
+    conv_book_t *book = (conv_book_t*)source;
+    if (offset >= book->text.length || book->chapter_count == 0) {
+        return -1;
+    }
+
+    uint32_t low = 0, high = book->chapter_count - 1;
+    while (low < high) {
+        uint32_t mid = low + (high - low + 1) / 2;
+        if (book->chapters[mid].text_offset <= offset) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+
+    chunk->text = book->text.data + book->chapters[low].text_offset;
+    chunk->offset = book->chapters[low].text_offset;
+    chunk->length = book->chapters[low].text_length;
+    return 0;
+}
+
+/**
+ * Lay out the book for every geometry and keep the page tables
+ */
+static int build_layouts(conv_book_t *book) {
+    for (int i = 0; i < layout_count; i++) {
+        pagination_t *pg = text_create_pagination_chunked(fetch_chapter, book, book->text.length,
+                                                          &layouts[i].params, 0);
+        if (!pg) {
+            return FORMAT_ERROR_OUT_OF_MEMORY;
+        }
+        if (text_pagination_layout_all(pg, NULL) != 0 || pg->page_count <= 0) {
+            text_free_pagination(pg);
+            return FORMAT_ERROR_OUT_OF_MEMORY;
+        }
+
+        uint32_t *table = malloc((size_t)pg->page_count * 3 * sizeof(uint32_t));
+        if (!table) {
+            text_free_pagination(pg);
+            return FORMAT_ERROR_OUT_OF_MEMORY;
+        }
+        for (int p = 0; p < pg->page_count; p++) {
+            table[3 * p] = (uint32_t)pg->pages[p].start_offset;
+            table[3 * p + 1] = (uint32_t)pg->pages[p].end_offset;
+            table[3 * p + 2] = (uint32_t)pg->pages[p].line_count;
+        }
+
+        erb_layout_t *layout = &book->layouts[book->layout_count];
+        memset(layout, 0, sizeof(*layout));
+        layout->key = layouts[i].key;
+        layout->page_count = (uint32_t)pg->page_count;
+        layout->font_size = (uint8_t)layouts[i].settings.font_size;
+        layout->line_spacing = (uint8_t)layouts[i].settings.line_spacing;
+        layout->margins = (uint8_t)layouts[i].settings.margins;
+        book->tables[book->layout_count++] = table;
+
+        text_free_pagination(pg);
+    }
+    return FORMAT_SUCCESS;
+}
+
+/*
+ * Output
+ */
+
+static size_t align4(size_t offset) {
+    return (offset + 3) & ~(size_t)3;
+}
+
+static int write_padded(FILE *out, const void *data, size_t length, size_t *offset) {
+    static const char zeros[4] = { 0 };
+    size_t padding = align4(*offset + length) - (*offset + length);
+
+    if ((length > 0 && fwrite(data, 1, length, out) != length) ||
+        (padding > 0 && fwrite(zeros, 1, padding, out) != padding)) {
+        return -1;
+    }
+    *offset += length + padding;
+    return 0;
+}
+
+/**
+ * Write the book as an .erb file (through a temporary file)
+ */
+static int write_erb(conv_book_t *book, const char *path) {
+    erb_header_t header;
+
+    /* Section offsets */
+    memset(&header, 0, sizeof(header));
+    size_t offset = align4(sizeof(header));
+    header.chapter_offset = (uint32_t)offset;
+    header.chapter_count = book->chapter_count;
+    offset = align4(offset + (size_t)book->chapter_count * sizeof(erb_chapter_t));
+    header.layout_offset = (uint32_t)offset;
+    header.layout_count = (uint32_t)book->layout_count;
+    offset = align4(offset + (size_t)book->layout_count * sizeof(erb_layout_t));
+    for (int i = 0; i < book->layout_count; i++) {
+        book->layouts[i].table_offset = (uint32_t)offset;
+        offset += (size_t)book->layouts[i].page_count * 3 * sizeof(uint32_t);
+    }
+    header.string_offset = (uint32_t)offset;
+    header.string_size = (uint32_t)book->strings.length;
+    offset = align4(offset + book->strings.length);
+    header.text_offset = (uint32_t)offset;
+    header.text_length = (uint32_t)book->text.length;
+    offset += book->text.length + 1;
+    if (offset > UINT32_MAX) {
+        return FORMAT_ERROR_TOO_LARGE;
+    }
+
+    memcpy(header.magic, ERB_MAGIC, sizeof(header.magic));
+    header.version = ERB_VERSION;
+    header.file_size = (uint32_t)offset;
+    header.source_format = (uint32_t)book->format;
+
+    header.title = book->title;
+    header.author = book->author;
+    header.language = book->language;
+    header.source_name = book->source_name;
+
+    char temp_path[4096 + 8];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+    FILE *out = fopen(temp_path, "wb");
+    if (!out) {
+        return FORMAT_ERROR_READ_FAILED;
+    }
+
+    size_t written = 0;
+    int result = write_padded(out, &header, sizeof(header), &written);
+    if (result == 0) {
+        result = write_padded(out, book->chapters,
+                              (size_t)book->chapter_count * sizeof(erb_chapter_t), &written);
+    }
+    if (result == 0) {
+        result = write_padded(out, book->layouts,
+                              (size_t)book->layout_count * sizeof(erb_layout_t), &written);
+    }
+    for (int i = 0; i < book->layout_count && result == 0; i++) {
+        result = write_padded(out, book->tables[i],
+                              (size_t)book->layouts[i].page_count * 3 * sizeof(uint32_t), &written);
+    }
+    if (result == 0) {
+        result = write_padded(out, book->strings.data, book->strings.length, &written);
+    }
+    if (result == 0) {
+        result = (fwrite(book->text.data, 1, book->text.length, out) == book->text.length &&
+                  fputc('\0', out) != EOF) ? 0 : -1;
+    }
+    if (fclose(out) != 0) {
+        result = -1;
+    }
+
+    if (result != 0 || rename(temp_path, path) != 0) {
+        unlink(temp_path);
+        return FORMAT_ERROR_READ_FAILED;
+    }
+    return FORMAT_SUCCESS;
+}
+
+/*
+ * Conversion
+ */
+
+/**
+ * Output path of a book: its file name with .erb appended
+ */
+static int output_path(const char *input, char *path, size_t size) {
+    int n;
+    if (output_dir) {
+        const char *name = strrchr(input, '/');
+        n = snprintf(path, size, "%s/%s%s", output_dir, name ? name + 1 : input, ERB_EXTENSION);
+    } else {
+        n = snprintf(path, size, "%s%s", input, ERB_EXTENSION);
+    }
+    return (n > 0 && (size_t)n < size) ? 0 : -1;
+}
+
+/**
+ * Convert one book
+ * @param input: Path to the book
+ * @param output: Path of the .erb file
+ * @param summary: Output one-line result for the progress log
+ * @return: FORMAT_SUCCESS on success, format error code otherwise
+ */
+static int convert_book(const char *input, const char *output, char *summary, size_t size) {
+    conv_book_t book;
+    format_metadata_t metadata;
+
+    memset(&book, 0, sizeof(book));
+    book.format = format_detect_type(input);
+    const book_format_interface_t *interface = format_get_interface(book.format);
+    if (!interface || book.format == BOOK_FORMAT_ERB) {
+        return FORMAT_ERROR_UNSUPPORTED;
+    }
+
+    format_handle_t handle = interface->open(input);
+    if (!handle) {
+        return FORMAT_ERROR_INVALID_FORMAT;
+    }
+
+    int result = buffer_append(&book.strings, "", 1) == 0 ? FORMAT_SUCCESS
+                                                          : FORMAT_ERROR_OUT_OF_MEMORY;
+    if (result == FORMAT_SUCCESS && interface->get_metadata(handle, &metadata) == FORMAT_SUCCESS) {
+        const char *name = strrchr(input, '/');
+        name = name ? name + 1 : input;
+        if (metadata.title[0] == '\0') {
+            /* Untitled books are listed by file name, as on the device */
+            const char *ext = strchr(name, '.');
+            book.title = add_string(&book, name, ext ? (size_t)(ext - name) : strlen(name));
+        } else {
+            book.title = add_string(&book, metadata.title, strlen(metadata.title));
+        }
+        book.author = add_string(&book, metadata.author, strlen(metadata.author));
+        book.language = add_string(&book, metadata.language, strlen(metadata.language));
+        book.source_name = add_string(&book, name, strlen(name));
+    }
+    if (result == FORMAT_SUCCESS) {
+        result = read_chapters(&book, interface, handle);
+    }
+    interface->close(handle);
+
+    if (result == FORMAT_SUCCESS) {
+        result = build_layouts(&book);
+    }
+    if (result == FORMAT_SUCCESS) {
+        result = write_erb(&book, output);
+    }
+    if (result == FORMAT_SUCCESS) {
+        uint32_t fewest = UINT32_MAX, most = 0;
+        for (int i = 0; i < book.layout_count; i++) {
+            fewest = book.layouts[i].page_count < fewest ? book.layouts[i].page_count : fewest;
+            most = book.layouts[i].page_count > most ? book.layouts[i].page_count : most;
+        }
+        snprintf(summary, size, "%zu bytes, %u chapters, %u-%u pages", book.text.length,
+                 book.chapter_count, fewest, most);
+    }
+
+    conv_book_free(&book);
+    return result;
+}
+
+/**
+ * Worker thread: convert books until none are left
+ */
+static void* convert_worker(void *arg) {
+    char output[4096];
+    char summary[128];
+    struct stat in, out;
+
+    (void)arg;
+    for (;;) {
+        pthread_mutex_lock(&lock);
+        int index = next_input < input_count ? next_input++ : -1;
+        pthread_mutex_unlock(&lock);
+        if (index < 0) {
+            break;
+        }
+
+        const char *input = inputs[index];
+        int result;
+        bool up_to_date = false;
+        if (output_path(input, output, sizeof(output)) != 0) {
+            result = FORMAT_ERROR_TOO_LARGE;
+        } else if (stat(input, &in) != 0) {
+            result = FORMAT_ERROR_NOT_FOUND;
+        } else {
+            up_to_date = !force && stat(output, &out) == 0 && out.st_mtime >= in.st_mtime;
+            result = up_to_date ? FORMAT_SUCCESS
+                                : convert_book(input, output, summary, sizeof(summary));
+        }
+
+        pthread_mutex_lock(&lock);
+        if (up_to_date) {
+            skipped++;
+        } else if (result == FORMAT_SUCCESS) {
+            converted++;
+            printf("%s: %s\n", output, summary);
+        } else {
+            failed++;
+            fprintf(stderr, "erbconv: %s: %s\n", input, format_error_string(result));
+        }
+        pthread_mutex_unlock(&lock);
+    }
+    return NULL;
+}
+
+/*
+ * Setup
+ */
+
+static int add_input(const char *path) {
+    char **grown = realloc(inputs, (size_t)(input_count + 1) * sizeof(char*));
+    if (!grown) {
+        return -1;
+    }
+    inputs = grown;
+    inputs[input_count] = strdup(path);
+    return inputs[input_count] ? (input_count++, 0) : -1;
+}
+
+/**
+ * Add a book, or every book directly inside a directory
+ */
+static int collect_inputs(const char *path) {
+    struct stat st;
+    char child[4096];
+
+    if (stat(path, &st) != 0) {
+        fprintf(stderr, "erbconv: Cannot open %s\n", path);
+        return -1;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        return add_input(path);
+    }
+
+    DIR *dir = opendir(path);
+    if (!dir) {
+        fprintf(stderr, "erbconv: Cannot open %s\n", path);
+        return -1;
+    }
+    struct dirent *entry;
+    int result = 0;
+    while (result == 0 && (entry = readdir(dir)) != NULL) {
+        book_format_type_t format = format_detect_type(entry->d_name);
+        if (entry->d_name[0] == '.' || format == BOOK_FORMAT_UNKNOWN ||
+            format == BOOK_FORMAT_ERB) {
+            continue;
+        }
+        if (snprintf(child, sizeof(child), "%s/%s", path, entry->d_name) < (int)sizeof(child) &&
+            stat(child, &st) == 0 && S_ISREG(st.st_mode)) {
+            result = add_input(child);
+        }
+    }
+    closedir(dir);
+    return result;
+}
+
+/**
+ * Work out the geometries to build page tables for
+ * The glyph pages of each font are built here too: they are filled in on
+ * first use, and the workers must only read them.
+ */
+static void init_layouts(bool all_spacings) {
+    int spacings = all_spacings ? 3 : 1;
+
+    for (int size = FONT_SIZE_SMALL; size <= FONT_SIZE_LARGE; size++) {
+        for (int spacing = LINE_SPACING_SINGLE; spacing < spacings; spacing++) {
+            for (int margins = MARGINS_NARROW; margins <= MARGINS_WIDE; margins++) {
+                conv_layout_t *layout = &layouts[layout_count];
+                memset(layout, 0, sizeof(*layout));
+                layout->settings.font_size = (font_size_t)size;
+                layout->settings.line_spacing = (line_spacing_t)spacing;
+                layout->settings.margins = (margins_t)margins;
+                reader_layout_params(&layout->params, &layout->settings);
+                layout->key = text_layout_key(&layout->params);
+
+                for (uint32_t cp = 0; cp < FONT_PAGED_LIMIT; cp += FONT_PAGE_SIZE) {
+                    font_glyph_lookup(layout->params.font, cp);
+                }
+                layout_count++;
+            }
+        }
+    }
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-j jobs] [-a] [-f] [-F fontdir] [-o outdir] book|dir...\n", prog);
+    fprintf(stderr, "  -j jobs         Books converted at once (default: one per CPU)\n");
+    fprintf(stderr, "  -a              Page tables for every line spacing (default: single)\n");
+    fprintf(stderr, "  -f              Convert books whose .erb is up to date too\n");
+    fprintf(stderr, "  -F fontdir      Fonts installed on the device (default: built-in only)\n");
+    fprintf(stderr, "  -o outdir       Write .erb files to outdir (default: beside each book)\n");
+}
+
+int main(int argc, char *argv[]) {
+    long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    bool all_spacings = false;
+    const char *font_dir = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "j:afF:o:h")) != -1) {
+        switch (opt) {
+            case 'j':
+                jobs = atol(optarg);
+                if (jobs < 1) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'a': all_spacings = true; break;
+            case 'f': force = true;        break;
+            case 'F': font_dir = optarg;   break;
+            case 'o': output_dir = optarg; break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind >= argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    /* Files are written in host byte order; the device is little-endian */
+    const uint16_t probe = 1;
+    if (*(const uint8_t*)&probe != 1) {
+        fprintf(stderr, "erbconv: Big-endian hosts are not supported\n");
+        return 1;
+    }
+
+    /* Everything initialized on first use is set up before the workers start */
+    xmlInitParser();
+    format_init();
+    if (font_dir && font_registry_init(font_dir) <= 0) {
+        fprintf(stderr, "erbconv: No fonts found in %s\n", font_dir);
+        return 1;
+    }
+    text_renderer_get_params();
+    init_layouts(all_spacings);
+
+    for (int i = optind; i < argc; i++) {
+        if (collect_inputs(argv[i]) != 0) {
+            return 1;
+        }
+    }
+
+    if (jobs > ERBCONV_MAX_JOBS) {
+        jobs = ERBCONV_MAX_JOBS;
+    }
+    if (jobs > input_count) {
+        jobs = input_count > 0 ? input_count : 1;
+    }
+
+    pthread_t threads[ERBCONV_MAX_JOBS];
+    int started = 0;
+    while (started < jobs &&
+           pthread_create(&threads[started], NULL, convert_worker, NULL) == 0) {
+        started++;
+    }
+    if (started == 0) {
+        convert_worker(NULL);
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    printf("%d converted, %d up to date, %d failed\n", converted, skipped, failed);
+
+    for (int i = 0; i < input_count; i++) {
+        free(inputs[i]);
+    }
+    free(inputs);
+    xmlCleanupParser();
+    return failed > 0 ? 1 : 0;
+}
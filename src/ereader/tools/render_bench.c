@@ -0,0 +1,519 @@
+/*
+ * render_bench.c - Rendering Micro-Benchmarks
+ *
+ * Host benchmark for the framebuffer and text kernels, and for the EPUB
+ * HTML-to-text converter that feeds them. Each benchmark is
+ * run for a minimum wall time and reported as ns/op, MB/s (bytes of text
+ * or framebuffer touched per op) and heap allocations per op, so a change
+ * to the rendering module can be compared against a baseline run.
+ *
+ * Allocations are counted by linking with -Wl,--wrap=malloc (and calloc,
+ * realloc), which catches every allocation made by the rendering code.
+ *
+ * Usage: render_bench [-t ms] [file.txt | directory] ...
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "../rendering/framebuffer.h"
+#include "../rendering/text_renderer.h"
+#include "../rendering/line_break.h"
+#include "../formats/html_text.h"
+
+#define DEFAULT_CORPUS      "../../board/ereader/rootfs-overlay/books"
+#define DEFAULT_MIN_TIME_MS 200
+#define MAX_LAYOUT_LINES    200000
+#define PAGE_SET            5         /* Pages cycled by the page benchmark */
+
+/*
+ * Allocation counting
+ */
+
+static uint64_t alloc_count = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    alloc_count++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size) {
+    alloc_count++;
+    return __real_calloc(nmemb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    alloc_count++;
+    return __real_realloc(ptr, size);
+}
+
+/*
+ * Benchmark runner
+ */
+
+typedef void (*bench_fn_t)(void *ctx);
+
+typedef struct {
+    const char *name;
+    const char *size;            /* Font size label, "-" for framebuffer ops */
+    bench_fn_t fn;
+    void *ctx;
+    double bytes_per_op;         /* Bytes processed per op (0 = not reported) */
+} bench_t;
+
+static double min_time_ns = DEFAULT_MIN_TIME_MS * 1e6;
+
+/* Results feed this so the compiler cannot drop the work */
+static volatile uint64_t sink;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * Run a benchmark for at least min_time_ns and print one result row
+ *
+ * The iteration count is doubled until a run takes a tenth of the minimum
+ * time, then scaled up to reach it.
+ */
+static void bench_run(const bench_t *b) {
+    uint64_t iters = 1;
+    double elapsed;
+
+    b->fn(b->ctx);  /* Warm up caches and lazily built state */
+
+    for (;;) {
+        double start = now_ns();
+        for (uint64_t i = 0; i < iters; i++) b->fn(b->ctx);
+        elapsed = now_ns() - start;
+        if (elapsed >= min_time_ns / 10 || iters >= (1ULL << 40)) break;
+        iters *= 2;
+    }
+
+    if (elapsed < min_time_ns) {
+        iters = (uint64_t)(iters * (min_time_ns / (elapsed > 1 ? elapsed : 1))) + 1;
+    }
+
+    uint64_t allocs_before = alloc_count;
+    double start = now_ns();
+    for (uint64_t i = 0; i < iters; i++) b->fn(b->ctx);
+    elapsed = now_ns() - start;
+    uint64_t allocs = alloc_count - allocs_before;
+
+    double ns_per_op = elapsed / iters;
+    printf("%-24s %-7s %14.1f ", b->name, b->size, ns_per_op);
+    if (b->bytes_per_op > 0) {
+        printf("%10.1f ", b->bytes_per_op / ns_per_op * 1e3);
+    } else {
+        printf("%10s ", "-");
+    }
+    printf("%11.2f\n", (double)allocs / iters);
+}
+
+/*
+ * Corpus
+ */
+
+typedef struct {
+    char *text;
+    size_t length;
+    size_t capacity;
+    int files;
+} corpus_t;
+
+static int corpus_add_file(corpus_t *c, const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "render_bench: Cannot open %s\n", path);
+        return -1;
+    }
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(f);
+        return -1;
+    }
+
+    /* Files are joined with a blank line, as separate paragraphs */
+    size_t needed = c->length + (size_t)size + 3;
+    if (needed > c->capacity) {
+        size_t capacity = c->capacity ? c->capacity : 65536;
+        while (capacity < needed) capacity *= 2;
+        char *text = realloc(c->text, capacity);
+        if (!text) {
+            fclose(f);
+            return -1;
+        }
+        c->text = text;
+        c->capacity = capacity;
+    }
+
+    size_t got = fread(c->text + c->length, 1, (size_t)size, f);
+    fclose(f);
+    c->length += got;
+    c->text[c->length++] = '\n';
+    c->text[c->length++] = '\n';
+    c->text[c->length] = '\0';
+    c->files++;
+    return 0;
+}
+
+static int compare_paths(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/**
+ * Add a file, or every .txt file in a directory (in name order)
+ */
+static int corpus_add(corpus_t *c, const char *path) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        fprintf(stderr, "render_bench: Cannot stat %s\n", path);
+        return -1;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        return corpus_add_file(c, path);
+    }
+
+    DIR *d = opendir(path);
+    if (!d) return -1;
+
+    char *names[256];
+    int count = 0;
+    struct dirent *entry;
+    while ((entry = readdir(d)) != NULL && count < 256) {
+        size_t len = strlen(entry->d_name);
+        if (len > 4 && strcmp(entry->d_name + len - 4, ".txt") == 0) {
+            names[count++] = strdup(entry->d_name);
+        }
+    }
+    closedir(d);
+
+    qsort(names, count, sizeof(names[0]), compare_paths);
+    for (int i = 0; i < count; i++) {
+        char file[1024];
+        snprintf(file, sizeof(file), "%s/%s", path, names[i]);
+        corpus_add_file(c, file);
+        free(names[i]);
+    }
+    return 0;
+}
+
+/*
+ * Benchmarks
+ */
+
+typedef struct {
+    framebuffer_t *fb;
+    const char *text;
+    size_t length;
+    layout_params_t params;
+    text_font_size_t size;
+    char **lines;
+    pagination_t *pg;
+    text_page_t *pages[PAGE_SET];
+    int page_count;
+    int next_page;
+} bench_ctx_t;
+
+static void bench_fb_clear(void *arg) {
+    bench_ctx_t *ctx = arg;
+    fb_clear(ctx->fb, COLOR_WHITE);
+    sink += ctx->fb->data[0];
+}
+
+static void bench_fb_draw_rect(void *arg) {
+    bench_ctx_t *ctx = arg;
+    fb_draw_rect(ctx->fb, 50, 50, 300, 200, COLOR_BLACK);
+    sink += ctx->fb->data[FB_BUFFER_SIZE / 2];
+}
+
+static void bench_fb_invert_region(void *arg) {
+    bench_ctx_t *ctx = arg;
+    /* A menu highlight bar */
+    fb_invert_region(ctx->fb, 0, 100, FB_WIDTH, 24);
+    sink += ctx->fb->data[FB_BUFFER_SIZE / 2];
+}
+
+static void bench_text_render_string(void *arg) {
+    bench_ctx_t *ctx = arg;
+    sink += text_render_string(ctx->fb, 10, 10, ctx->text, COLOR_BLACK);
+}
+
+static void bench_text_render_page(void *arg) {
+    bench_ctx_t *ctx = arg;
+    text_page_t *page = ctx->pages[ctx->next_page];
+    ctx->next_page = (ctx->next_page + 1) % ctx->page_count;
+    sink += text_render_page(ctx->fb, &ctx->params, page, COLOR_BLACK);
+}
+
+static void bench_text_calculate_layout(void *arg) {
+    bench_ctx_t *ctx = arg;
+    int count = text_calculate_layout(&ctx->params, ctx->text, ctx->params.area_width,
+                                      ctx->lines, MAX_LAYOUT_LINES);
+    for (int i = 0; i < count; i++) free(ctx->lines[i]);
+    sink += count;
+}
+
+static void bench_text_create_pagination(void *arg) {
+    bench_ctx_t *ctx = arg;
+    int prepended;
+    pagination_t *pg = text_create_pagination(ctx->text, ctx->length, &ctx->params);
+    if (!pg) return;
+    text_pagination_layout_all(pg, &prepended);
+    sink += pg->page_count;
+    text_free_pagination(pg);
+}
+
+static const char *size_names[] = { "small", "medium", "large" };
+
+/*
+ * HTML conversion
+ */
+
+typedef struct {
+    char *markup;
+    size_t length;
+    char *out;
+} html_ctx_t;
+
+/* Append a string to a markup buffer sized by the caller */
+static size_t markup_put(char *markup, size_t pos, const char *s) {
+    size_t n = strlen(s);
+    memcpy(markup + pos, s, n);
+    return pos + n;
+}
+
+/**
+ * Dress the corpus up as an EPUB chapter: paragraphs become <p> elements,
+ * markup characters and typographic punctuation become entity references
+ */
+static char *corpus_to_xhtml(const corpus_t *corpus, size_t *out_length) {
+    static const char head[] =
+        "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        "<html xmlns=\"http://www.w3.org/1999/xhtml\"><head><title>Bench</title>"
+        "<style>p { text-indent: 1em; }</style></head><body>\n<p class=\"x\">";
+    static const char tail[] = "</p>\n</body></html>\n";
+
+    /* No byte expands past the 16 of a paragraph break */
+    char *markup = malloc(sizeof(head) + corpus->length * 16 + sizeof(tail));
+    if (!markup) return NULL;
+
+    size_t pos = markup_put(markup, 0, head);
+    const char *text = corpus->text;
+    for (size_t i = 0; i < corpus->length; i++) {
+        if (text[i] == '\n' && i + 1 < corpus->length && text[i + 1] == '\n') {
+            pos = markup_put(markup, pos, "</p>\n<p class=\"x\">");
+            while (i + 1 < corpus->length && text[i + 1] == '\n') i++;
+        } else if (text[i] == '&') {
+            pos = markup_put(markup, pos, "&amp;");
+        } else if (text[i] == '<') {
+            pos = markup_put(markup, pos, "&lt;");
+        } else if (text[i] == '>') {
+            pos = markup_put(markup, pos, "&gt;");
+        } else if (strncmp(text + i, "\xe2\x80\x94", 3) == 0) {
+            pos = markup_put(markup, pos, "&mdash;");
+            i += 2;
+        } else if (strncmp(text + i, "\xe2\x80\x9c", 3) == 0) {
+            pos = markup_put(markup, pos, "&ldquo;");
+            i += 2;
+        } else if (strncmp(text + i, "\xe2\x80\x9d", 3) == 0) {
+            pos = markup_put(markup, pos, "&rdquo;");
+            i += 2;
+        } else if (strncmp(text + i, "\xe2\x80\x99", 3) == 0) {
+            pos = markup_put(markup, pos, "&#8217;");
+            i += 2;
+        } else {
+            markup[pos++] = text[i];
+        }
+    }
+    pos = markup_put(markup, pos, tail);
+
+    *out_length = pos;
+    return markup;
+}
+
+static void bench_html_text_convert(void *arg) {
+    html_ctx_t *ctx = arg;
+    html_text_t converter;
+
+    /* Fed in zip_fread-sized pieces, as the EPUB reader does */
+    html_text_init(&converter, ctx->out, ctx->length);
+    for (size_t i = 0; i < ctx->length; i += 16384) {
+        size_t n = ctx->length - i < 16384 ? ctx->length - i : 16384;
+        html_text_feed(&converter, ctx->markup + i, n);
+    }
+    sink += html_text_finish(&converter);
+}
+
+/**
+ * Run the text benchmarks at one font size
+ */
+static void bench_text(framebuffer_t *fb, const corpus_t *corpus, text_font_size_t size) {
+    bench_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.fb = fb;
+    ctx.text = corpus->text;
+    ctx.length = corpus->length;
+    ctx.size = size;
+    text_layout_params_init(&ctx.params, size);
+
+    /* text_render_string draws with the UI font size */
+    static char line[64];
+    strncpy(line, corpus->text, 48);
+    for (char *p = line; *p; p++) {
+        if (*p == '\n' || *p == '\t') *p = ' ';
+    }
+    text_renderer_set_font_size(size);
+    bench_ctx_t string_ctx = ctx;
+    string_ctx.text = line;
+    bench_t render_string = { "text_render_string", size_names[size],
+                              bench_text_render_string, &string_ctx, (double)strlen(line) };
+    bench_run(&render_string);
+
+    /* Pages from the middle of the corpus, materialized up front so the
+     * benchmark measures drawing rather than line allocation */
+    int prepended;
+    ctx.pg = text_create_pagination(corpus->text, corpus->length, &ctx.params);
+    if (ctx.pg && text_pagination_layout_all(ctx.pg, &prepended) == 0) {
+        int first = ctx.pg->page_count / 2 - PAGE_SET / 2;
+        if (first < 0) first = 0;
+        size_t page_bytes = 0;
+        for (int i = first; i < ctx.pg->page_count && ctx.page_count < PAGE_SET; i++) {
+            text_page_t *page = text_get_page(ctx.pg, i);
+            if (!page) break;
+            ctx.pages[ctx.page_count++] = page;
+            page_bytes += page->end_offset - page->start_offset + 1;
+        }
+        if (ctx.page_count > 0) {
+            bench_t render_page = { "text_render_page", size_names[size],
+                                    bench_text_render_page, &ctx,
+                                    (double)page_bytes / ctx.page_count };
+            bench_run(&render_page);
+        }
+    }
+
+    ctx.lines = malloc(sizeof(char *) * MAX_LAYOUT_LINES);
+    if (ctx.lines) {
+        bench_t layout = { "text_calculate_layout", size_names[size],
+                           bench_text_calculate_layout, &ctx, (double)corpus->length };
+        bench_run(&layout);
+        free(ctx.lines);
+    }
+
+    bench_t paginate = { "text_create_pagination", size_names[size],
+                         bench_text_create_pagination, &ctx, (double)corpus->length };
+    bench_run(&paginate);
+
+    if (ctx.pg) text_free_pagination(ctx.pg);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-t ms] [file.txt | directory] ...\n", prog);
+    fprintf(stderr, "  -t ms   Minimum time per benchmark (default %d)\n", DEFAULT_MIN_TIME_MS);
+    fprintf(stderr, "  Default corpus: %s\n", DEFAULT_CORPUS);
+}
+
+int main(int argc, char *argv[]) {
+    corpus_t corpus;
+    int opt;
+
+    memset(&corpus, 0, sizeof(corpus));
+
+    while ((opt = getopt(argc, argv, "t:h")) != -1) {
+        switch (opt) {
+            case 't':
+                min_time_ns = atof(optarg) * 1e6;
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (optind < argc) {
+        for (int i = optind; i < argc; i++) corpus_add(&corpus, argv[i]);
+    } else {
+        corpus_add(&corpus, DEFAULT_CORPUS);
+    }
+
+    if (corpus.length == 0) {
+        fprintf(stderr, "render_bench: Empty corpus\n");
+        return 1;
+    }
+
+    text_renderer_init();
+
+    static framebuffer_t fb;
+    fb_init(&fb);
+
+    printf("Corpus: %d file(s), %zu bytes; line break scan: %s\n\n",
+           corpus.files, corpus.length, line_break_impl_name());
+    printf("%-24s %-7s %14s %10s %11s\n", "benchmark", "size", "ns/op", "MB/s", "allocs/op");
+
+    bench_ctx_t fb_ctx;
+    memset(&fb_ctx, 0, sizeof(fb_ctx));
+    fb_ctx.fb = &fb;
+
+    bench_t fb_benches[] = {
+        { "fb_clear",         "-", bench_fb_clear,         &fb_ctx, FB_BUFFER_SIZE },
+        { "fb_draw_rect",     "-", bench_fb_draw_rect,     &fb_ctx, 300.0 * 200 / 8 },
+        { "fb_invert_region", "-", bench_fb_invert_region, &fb_ctx, FB_WIDTH * 24.0 / 8 },
+    };
+    for (size_t i = 0; i < sizeof(fb_benches) / sizeof(fb_benches[0]); i++) {
+        bench_run(&fb_benches[i]);
+    }
+
+    html_ctx_t html_ctx;
+    html_ctx.markup = corpus_to_xhtml(&corpus, &html_ctx.length);
+    html_ctx.out = html_ctx.markup ? malloc(html_ctx.length) : NULL;
+    if (html_ctx.out) {
+        bench_t convert = { "html_text_convert", "-", bench_html_text_convert,
+                            &html_ctx, (double)html_ctx.length };
+        bench_run(&convert);
+    }
+    free(html_ctx.out);
+    free(html_ctx.markup);
+
+    for (int size = TEXT_FONT_SIZE_SMALL; size <= TEXT_FONT_SIZE_LARGE; size++) {
+        bench_text(&fb, &corpus, (text_font_size_t)size);
+    }
+
+    text_renderer_set_font_size(TEXT_FONT_SIZE_MEDIUM);
+    text_renderer_cleanup();
+    free(corpus.text);
+    return 0;
+}
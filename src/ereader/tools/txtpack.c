@@ -0,0 +1,315 @@
+/*
+ * txtpack.c - Pack Plain-Text Books into Seekable .txt.gz Files
+ *
+ * Host tool that compresses a UTF-8 text file into the indexed .txt.gz
+ * layout described in formats/txt_gz.h: one gzip member per block of at
+ * most TXT_GZ_BLOCK_SIZE bytes, cut at a paragraph or line break, then an
+ * empty member holding the block index. The device opens such a book by
+ * its index and inflates only the blocks being read. The output is still
+ * plain gzip to every other tool.
+ *
+ * Text in other encodings must be converted first, for example with
+ * iconv -f CP1252 -t UTF-8.
+ *
+ * Usage: txtpack [-l level] input.txt [output.txt.gz]
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "../formats/txt_gz.h"
+#include "../rendering/utf8.h"
+
+/*
+ * Helpers
+ */
+
+static void write_le16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void write_le32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/*
+ * Read a whole file into memory
+ */
+static char* read_file(const char *path, size_t *out_length) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "txtpack: Cannot open %s\n", path);
+        return NULL;
+    }
+
+    char *data = NULL;
+    size_t length = 0, capacity = 0;
+    for (;;) {
+        if (length == capacity) {
+            capacity = capacity ? capacity * 2 : 1024 * 1024;
+            char *grown = realloc(data, capacity);
+            if (!grown) {
+                fprintf(stderr, "txtpack: Out of memory\n");
+                free(data);
+                fclose(f);
+                return NULL;
+            }
+            data = grown;
+        }
+        size_t n = fread(data + length, 1, capacity - length, f);
+        if (n == 0) {
+            break;
+        }
+        length += n;
+    }
+
+    if (ferror(f)) {
+        fprintf(stderr, "txtpack: Failed to read %s\n", path);
+        free(data);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+
+    *out_length = length;
+    return data;
+}
+
+/*
+ * End of the block starting at start: the last paragraph break in the
+ * second half of the block, else the last line break, else the last
+ * character boundary
+ */
+static size_t block_end(const char *text, size_t length, size_t start) {
+    size_t end = start + TXT_GZ_BLOCK_SIZE;
+    if (end >= length) {
+        return length;
+    }
+
+    for (size_t i = end - 1; i > start + TXT_GZ_BLOCK_SIZE / 2; i--) {
+        if (text[i] == '\n' && text[i - 1] == '\n') {
+            return i + 1;
+        }
+    }
+    for (size_t i = end - 1; i > start; i--) {
+        if (text[i] == '\n') {
+            return i + 1;
+        }
+    }
+    while (end > start + 1 && ((unsigned char)text[end] & 0xC0) == 0x80) {
+        end--;
+    }
+    return end;
+}
+
+/*
+ * Deflate one block as a gzip member
+ * @return: Member size, or 0 on failure
+ */
+static size_t compress_block(const char *text, size_t length, int level,
+                             unsigned char *out, size_t out_size) {
+    z_stream stream;
+
+    memset(&stream, 0, sizeof(stream));
+    if (deflateInit2(&stream, level, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return 0;
+    }
+    stream.next_in = (Bytef*)text;
+    stream.avail_in = (uInt)length;
+    stream.next_out = out;
+    stream.avail_out = (uInt)out_size;
+    int result = deflate(&stream, Z_FINISH);
+    size_t size = stream.total_out;
+    deflateEnd(&stream);
+
+    return result == Z_STREAM_END ? size : 0;
+}
+
+/*
+ * Write the empty gzip member that carries the block index
+ */
+static int write_index(FILE *out, const uint32_t *sizes, int block_count) {
+    size_t subfield = (size_t)block_count * TXT_GZ_ENTRY_SIZE + 8;
+    size_t member_size = 10 + 2 + 4 + subfield + 2 + 8;
+    uint8_t *member = calloc(1, member_size);
+    if (!member) {
+        return -1;
+    }
+
+    /* Header: deflate, FEXTRA, no mtime, unknown OS */
+    member[0] = 0x1f;
+    member[1] = 0x8b;
+    member[2] = 8;
+    member[3] = 0x04;
+    member[9] = 0xff;
+    write_le16(member + 10, (uint16_t)(subfield + 4));
+    member[12] = TXT_GZ_INDEX_ID1;
+    member[13] = TXT_GZ_INDEX_ID2;
+    write_le16(member + 14, (uint16_t)subfield);
+
+    uint8_t *p = member + 16;
+    for (int i = 0; i < block_count; i++, p += TXT_GZ_ENTRY_SIZE) {
+        write_le32(p, sizes[2 * i]);
+        write_le32(p + 4, sizes[2 * i + 1]);
+    }
+    write_le32(p, (uint32_t)block_count);
+    memcpy(p + 4, TXT_GZ_MAGIC, 4);
+
+    /* Empty final deflate block; CRC and ISIZE stay zero */
+    p[8] = 0x03;
+
+    int result = fwrite(member, 1, member_size, out) == member_size ? 0 : -1;
+    free(member);
+    return result;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-l level] input.txt [output.txt.gz]\n", prog);
+    fprintf(stderr, "  -l level        Compression level 1-9 (default: 9)\n");
+    fprintf(stderr, "  output defaults to input with .gz appended\n");
+}
+
+int main(int argc, char *argv[]) {
+    int level = 9;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "l:h")) != -1) {
+        switch (opt) {
+            case 'l':
+                level = atoi(optarg);
+                if (level < 1 || level > 9) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (argc - optind != 1 && argc - optind != 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const char *input = argv[optind];
+    char default_output[4096];
+    const char *output = argv[optind + 1];
+    if (!output) {
+        snprintf(default_output, sizeof(default_output), "%s.gz", input);
+        output = default_output;
+    }
+
+    size_t length;
+    char *data = read_file(input, &length);
+    if (!data) {
+        return 1;
+    }
+
+    /* The device uses block text as is, so it must already be UTF-8 */
+    const char *text = data;
+    if (length >= 3 && memcmp(text, "\xEF\xBB\xBF", 3) == 0) {
+        text += 3;
+        length -= 3;
+    }
+    size_t valid = utf8_valid_prefix(text, length);
+    if (valid != length) {
+        fprintf(stderr, "txtpack: %s is not UTF-8 (invalid byte at %zu); "
+                "convert it first, e.g. iconv -f CP1252 -t UTF-8\n", input, valid);
+        free(data);
+        return 1;
+    }
+    if (length == 0) {
+        fprintf(stderr, "txtpack: %s is empty\n", input);
+        free(data);
+        return 1;
+    }
+
+    uint32_t *sizes = malloc(2 * TXT_GZ_MAX_BLOCKS * sizeof(uint32_t));
+    size_t bound = compressBound(TXT_GZ_BLOCK_SIZE) + 32;
+    unsigned char *member = malloc(bound);
+    FILE *out = fopen(output, "wb");
+    if (!sizes || !member || !out) {
+        fprintf(stderr, "txtpack: Cannot create %s\n", output);
+        free(sizes);
+        free(member);
+        free(data);
+        if (out) {
+            fclose(out);
+        }
+        return 1;
+    }
+
+    int block_count = 0;
+    size_t total = 0;
+    int result = 0;
+    for (size_t start = 0; start < length; ) {
+        if (block_count == TXT_GZ_MAX_BLOCKS) {
+            fprintf(stderr, "txtpack: %s is too large (more than %d blocks)\n",
+                    input, TXT_GZ_MAX_BLOCKS);
+            result = -1;
+            break;
+        }
+
+        size_t end = block_end(text, length, start);
+        size_t size = compress_block(text + start, end - start, level, member, bound);
+        if (size == 0 || fwrite(member, 1, size, out) != size) {
+            fprintf(stderr, "txtpack: Failed to write %s\n", output);
+            result = -1;
+            break;
+        }
+
+        sizes[2 * block_count] = (uint32_t)size;
+        sizes[2 * block_count + 1] = (uint32_t)(end - start);
+        block_count++;
+        total += size;
+        start = end;
+    }
+
+    if (result == 0) {
+        result = write_index(out, sizes, block_count);
+    }
+    if (fclose(out) != 0) {
+        result = -1;
+    }
+
+    if (result == 0) {
+        printf("%s: %zu bytes in %d blocks -> %zu bytes (%.1f%%)\n", output, length,
+               block_count, total, 100.0 * (double)total / (double)length);
+    } else {
+        unlink(output);
+    }
+
+    free(sizes);
+    free(member);
+    free(data);
+    return result == 0 ? 0 : 1;
+}
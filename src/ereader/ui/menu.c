@@ -37,6 +37,11 @@
 static void menu_draw_separator_line(framebuffer_t *fb, int line_number);
 static void menu_format_page_indicator(menu_state_t *menu, char *buffer, size_t buffer_size);
 static int menu_calculate_total_pages(int total_items, int items_per_page);
+static int menu_item_count(const menu_state_t *menu);
+static int menu_item_book(const menu_state_t *menu, int item);
+static bool menu_apply_filter(menu_state_t *menu, const char *text, bool narrower);
+static void menu_clear_filter(menu_state_t *menu);
+static menu_action_t menu_handle_filter_input(menu_state_t *menu, const button_event_t *event);
 
 /*
  * Menu Initialization and Cleanup
@@ -66,6 +71,8 @@ menu_state_t* menu_create(book_list_t *book_list, bookmark_list_t *bookmarks) {
 void menu_free(menu_state_t *menu) {
     if (menu) {
         /* Note: We don't free book_list or bookmarks as they're not owned by menu */
+        text_input_free(menu->filter_input);
+        free(menu->filter);
         free(menu);
     }
 }
@@ -75,12 +82,62 @@ void menu_reset(menu_state_t *menu) {
         return;
     }
 
+    menu_clear_filter(menu);
+    menu->menu_held = false;
     menu->selected_index = 0;
     menu->scroll_offset = 0;
     menu->needs_redraw = true;
     menu->refresh_counter = 0;
 }
 
+void menu_books_changed(menu_state_t *menu, const char *selected_filename) {
+    if (!menu || !menu->book_list) {
+        return;
+    }
+
+    /* Positions moved: match the whole list again */
+    if (menu->filter_text[0]) {
+        char text[LIBRARY_FILTER_QUERY_MAX];
+        int selected = menu->selected_index;
+
+        snprintf(text, sizeof(text), "%s", menu->filter_text);
+        if (!menu_apply_filter(menu, text, false)) {
+            menu_clear_filter(menu);
+        }
+        menu->selected_index = selected;
+    }
+
+    int total_books = menu_item_count(menu);
+    int index = selected_filename ? book_list_find(menu->book_list, selected_filename) : -1;
+    if (index >= 0 && menu->filter_text[0]) {
+        int item = -1;
+        for (int i = 0; i < menu->filter_count && item < 0; i++) {
+            if (menu->filter[i] == index) {
+                item = i;
+            }
+        }
+        index = item;
+    }
+    if (index >= 0) {
+        menu->selected_index = index;
+    } else if (menu->selected_index >= total_books) {
+        menu->selected_index = total_books > 0 ? total_books - 1 : 0;
+    }
+
+    /* Keep the selection visible and the last page full */
+    if (menu->selected_index < menu->scroll_offset) {
+        menu->scroll_offset = menu->selected_index;
+    } else if (menu->selected_index >= menu->scroll_offset + menu->visible_items) {
+        menu->scroll_offset = menu->selected_index - menu->visible_items + 1;
+    }
+    if (menu->scroll_offset > total_books - menu->visible_items) {
+        menu->scroll_offset = (total_books > menu->visible_items) ?
+                              (total_books - menu->visible_items) : 0;
+    }
+
+    menu->needs_redraw = true;
+}
+
 /*
  * Menu Rendering
  */
@@ -115,7 +172,7 @@ int menu_render(menu_state_t *menu, framebuffer_t *fb) {
     menu_draw_separator_line(fb, MENU_SEPARATOR_2_LINE);
 
     /* Render control hints */
-    if (menu_render_hints(fb) != MENU_SUCCESS) {
+    if (menu_render_hints(menu, fb) != MENU_SUCCESS) {
         return MENU_ERROR_RENDER_FAILED;
     }
 
@@ -131,13 +188,25 @@ int menu_render_status_bar(menu_state_t *menu, framebuffer_t *fb) {
     }
 
     char status_bar[MAX_LINE_LENGTH];
+    char title[MAX_LINE_LENGTH];
     char page_indicator[32];
 
     /* Format page indicator [current/total] */
     menu_format_page_indicator(menu, page_indicator, sizeof(page_indicator));
 
-    /* Create status bar: "E-Reader Library         [1/3]" */
-    int title_len = strlen(MENU_TITLE);
+    /* Create status bar: "E-Reader Library (Title)         [1/3]",
+     * or "Find: jane_ (12)                 [1/1]" while filtering */
+    if (menu->filter_input) {
+        snprintf(title, sizeof(title), "%s: %s_ (%d)", MENU_FILTER_TITLE,
+                 text_input_get_text(menu->filter_input), menu_item_count(menu));
+    } else if (menu->filter_text[0]) {
+        snprintf(title, sizeof(title), "%s: %s (%d)", MENU_FILTER_TITLE,
+                 menu->filter_text, menu->filter_count);
+    } else {
+        snprintf(title, sizeof(title), "%s (%s)", MENU_TITLE,
+                 book_sort_key_name(menu->book_list ? menu->book_list->sort_key : BOOK_SORT_TITLE));
+    }
+    int title_len = strlen(title);
     int indicator_len = strlen(page_indicator);
     int padding_spaces = CHARS_PER_LINE - title_len - indicator_len;
 
@@ -146,7 +215,7 @@ int menu_render_status_bar(menu_state_t *menu, framebuffer_t *fb) {
     }
 
     snprintf(status_bar, sizeof(status_bar), "%s%*s%s",
-             MENU_TITLE, padding_spaces, "", page_indicator);
+             title, padding_spaces, "", page_indicator);
 
     /* Render to framebuffer at line 0 */
     int x = MARGIN_LEFT;
@@ -161,7 +230,12 @@ int menu_render_items(menu_state_t *menu, framebuffer_t *fb) {
         return MENU_ERROR_NULL_POINTER;
     }
 
-    int total_books = menu->book_list->count;
+    int total_books = menu_item_count(menu);
+    if (total_books == 0 && menu->filter_text[0]) {
+        int y = MARGIN_TOP + (MENU_FIRST_ITEM_LINE * LINE_HEIGHT);
+        text_render_string(fb, MARGIN_LEFT, y, MENU_FILTER_EMPTY, COLOR_BLACK);
+        return MENU_SUCCESS;
+    }
     if (total_books == 0) {
         return MENU_ERROR_NO_BOOKS;
     }
@@ -177,15 +251,11 @@ int menu_render_items(menu_state_t *menu, framebuffer_t *fb) {
 
     /* Render visible items */
     for (int i = 0; i < menu->visible_items && (menu->scroll_offset + i) < total_books; i++) {
-        int book_index = menu->scroll_offset + i;
-        book_metadata_t *book = book_list_get(menu->book_list, book_index);
-
-        if (!book) {
-            continue;
-        }
+        int item = menu->scroll_offset + i;
+        int book_index = menu_item_book(menu, item);
 
         /* Determine if this item is selected */
-        bool is_selected = (book_index == menu->selected_index);
+        bool is_selected = (item == menu->selected_index);
 
         /* Calculate line position */
         int line_number = MENU_FIRST_ITEM_LINE + i;
@@ -197,10 +267,14 @@ int menu_render_items(menu_state_t *menu, framebuffer_t *fb) {
         char truncated_title[MENU_MAX_TITLE_LENGTH + 1];
 
         /* Get format indicator character */
-        char format_indicator = format_get_type_indicator(book->format);
+        char format_indicator =
+            format_get_type_indicator(book_list_get_format(menu->book_list, book_index));
 
         /* Use title if available, otherwise use filename */
-        const char *display_name = (book->title[0] != '\0') ? book->title : book->filename;
+        const char *display_name = book_list_get_title(menu->book_list, book_index);
+        if (display_name[0] == '\0') {
+            display_name = book_list_get_filename(menu->book_list, book_index);
+        }
 
         /* Truncate title to fit (accounting for selection marker and format indicator) */
         /* Format: "> [F] title" or "  [F] title" where F is format indicator */
@@ -234,15 +308,31 @@ int menu_render_items(menu_state_t *menu, framebuffer_t *fb) {
     return MENU_SUCCESS;
 }
 
-int menu_render_hints(framebuffer_t *fb) {
-    if (!fb) {
+int menu_render_hints(menu_state_t *menu, framebuffer_t *fb) {
+    if (!menu || !fb) {
         return MENU_ERROR_NULL_POINTER;
     }
 
     int x = MARGIN_LEFT;
     int y = MARGIN_TOP + (MENU_HINTS_LINE * LINE_HEIGHT);
 
-    text_render_string(fb, x, y, MENU_CONTROL_HINTS, COLOR_BLACK);
+    if (menu->filter_input) {
+        /* "[J] UP/DOWN:Letter ..." with the letter ENTER would add */
+        char hints[MAX_LINE_LENGTH];
+        char letter = menu->filter_input->current_char;
+        const char *name = text_input_get_char_name(letter);
+
+        if (name) {
+            snprintf(hints, sizeof(hints), "[%s] %s", name, MENU_FILTER_HINTS);
+        } else {
+            snprintf(hints, sizeof(hints), "[%c] %s", letter, MENU_FILTER_HINTS);
+        }
+        text_render_string(fb, x, y, hints, COLOR_BLACK);
+    } else if (menu->filter_text[0]) {
+        text_render_string(fb, x, y, MENU_FILTERED_HINTS, COLOR_BLACK);
+    } else {
+        text_render_string(fb, x, y, MENU_CONTROL_HINTS, COLOR_BLACK);
+    }
 
     return MENU_SUCCESS;
 }
@@ -286,6 +376,41 @@ menu_action_t menu_handle_event(menu_state_t *menu, const button_event_t *event)
         return MENU_ACTION_NONE;
     }
 
+    /* A query being typed takes the buttons */
+    if (menu->filter_input) {
+        return menu_handle_filter_input(menu, event);
+    }
+
+    /* MENU held starts a query, a short press opens the settings. Acted on
+     * at release, and only for a press made here (not the one that closed
+     * the settings). */
+    if (event->button == BUTTON_MENU) {
+        if (event->event_type == BUTTON_EVENT_PRESS) {
+            menu->menu_held = true;
+            menu->menu_pressed = event->timestamp;
+            return MENU_ACTION_NONE;
+        }
+        if (event->event_type != BUTTON_EVENT_RELEASE || !menu->menu_held) {
+            return MENU_ACTION_NONE;
+        }
+        menu->menu_held = false;
+
+        long held_ms = (event->timestamp.tv_sec - menu->menu_pressed.tv_sec) * 1000L +
+                       (event->timestamp.tv_usec - menu->menu_pressed.tv_usec) / 1000L;
+        if (held_ms < MENU_HOLD_MS || !menu->book_list || menu->book_list->count == 0) {
+            return MENU_ACTION_OPEN_SETTINGS;
+        }
+
+        menu_clear_filter(menu);
+        menu->filter_input = text_input_create(MENU_FILTER_TITLE, TEXT_INPUT_MODE_NORMAL, 0,
+                                               LIBRARY_FILTER_QUERY_MAX - 1);
+        if (!menu->filter_input) {
+            return MENU_ACTION_NONE;
+        }
+        menu->needs_redraw = true;
+        return MENU_ACTION_REDRAW;
+    }
+
     /* Only handle button press events (not release or repeat) */
     if (event->event_type != BUTTON_EVENT_PRESS) {
         return MENU_ACTION_NONE;
@@ -323,12 +448,16 @@ menu_action_t menu_handle_event(menu_state_t *menu, const button_event_t *event)
             break;
 
         case BUTTON_BACK:
-            /* Return to previous menu or exit */
-            action = MENU_ACTION_EXIT;
-            break;
-
-        case BUTTON_MENU:
-            /* Reserved for future use (settings menu) */
+            /* Back to all books, otherwise exit */
+            if (menu->filter_text[0]) {
+                menu_clear_filter(menu);
+                menu->selected_index = 0;
+                menu->scroll_offset = 0;
+                menu->needs_redraw = true;
+                action = MENU_ACTION_REDRAW;
+            } else {
+                action = MENU_ACTION_EXIT;
+            }
             break;
 
         default:
@@ -339,11 +468,11 @@ menu_action_t menu_handle_event(menu_state_t *menu, const button_event_t *event)
 }
 
 bool menu_move_up(menu_state_t *menu) {
-    if (!menu || !menu->book_list || menu->book_list->count == 0) {
+    if (!menu || !menu->book_list || menu_item_count(menu) == 0) {
         return false;
     }
 
-    int total_books = menu->book_list->count;
+    int total_books = menu_item_count(menu);
     int old_index = menu->selected_index;
 
     /* Move selection up */
@@ -367,11 +496,11 @@ bool menu_move_up(menu_state_t *menu) {
 }
 
 bool menu_move_down(menu_state_t *menu) {
-    if (!menu || !menu->book_list || menu->book_list->count == 0) {
+    if (!menu || !menu->book_list || menu_item_count(menu) == 0) {
         return false;
     }
 
-    int total_books = menu->book_list->count;
+    int total_books = menu_item_count(menu);
     int old_index = menu->selected_index;
 
     /* Move selection down */
@@ -394,7 +523,7 @@ bool menu_move_down(menu_state_t *menu) {
 }
 
 bool menu_page_up(menu_state_t *menu) {
-    if (!menu || !menu->book_list || menu->book_list->count == 0) {
+    if (!menu || !menu->book_list || menu_item_count(menu) == 0) {
         return false;
     }
 
@@ -416,11 +545,11 @@ bool menu_page_up(menu_state_t *menu) {
 }
 
 bool menu_page_down(menu_state_t *menu) {
-    if (!menu || !menu->book_list || menu->book_list->count == 0) {
+    if (!menu || !menu->book_list || menu_item_count(menu) == 0) {
         return false;
     }
 
-    int total_books = menu->book_list->count;
+    int total_books = menu_item_count(menu);
     int old_index = menu->selected_index;
 
     /* Move selection down by one page */
@@ -442,24 +571,28 @@ bool menu_page_down(menu_state_t *menu) {
     return (menu->selected_index != old_index);
 }
 
-book_metadata_t* menu_get_selected_book(menu_state_t *menu) {
+bool menu_get_selected_book(menu_state_t *menu, book_metadata_t *out) {
     if (!menu || !menu->book_list || menu->book_list->count == 0) {
-        return NULL;
+        return false;
     }
 
-    if (menu->selected_index < 0 || menu->selected_index >= menu->book_list->count) {
-        return NULL;
+    if (menu->selected_index < 0 || menu->selected_index >= menu_item_count(menu)) {
+        return false;
     }
 
-    return book_list_get(menu->book_list, menu->selected_index);
+    return book_list_get(menu->book_list, menu_item_book(menu, menu->selected_index),
+                         out) == BOOK_SUCCESS;
 }
 
 int menu_get_selected_index(menu_state_t *menu) {
-    if (!menu || !menu->book_list || menu->book_list->count == 0) {
+    if (!menu || !menu->book_list || menu_item_count(menu) == 0) {
         return -1;
     }
 
-    return menu->selected_index;
+    if (menu->selected_index < 0 || menu->selected_index >= menu_item_count(menu)) {
+        return -1;
+    }
+    return menu_item_book(menu, menu->selected_index);
 }
 
 /*
@@ -480,7 +613,7 @@ void menu_clear_redraw_flag(menu_state_t *menu) {
 }
 
 int menu_get_current_page(menu_state_t *menu) {
-    if (!menu || !menu->book_list || menu->book_list->count == 0) {
+    if (!menu || !menu->book_list || menu_item_count(menu) == 0) {
         return 1;
     }
 
@@ -489,11 +622,11 @@ int menu_get_current_page(menu_state_t *menu) {
 }
 
 int menu_get_total_pages(menu_state_t *menu) {
-    if (!menu || !menu->book_list || menu->book_list->count == 0) {
+    if (!menu || !menu->book_list || menu_item_count(menu) == 0) {
         return 1;
     }
 
-    return menu_calculate_total_pages(menu->book_list->count, menu->visible_items);
+    return menu_calculate_total_pages(menu_item_count(menu), menu->visible_items);
 }
 
 /*
@@ -576,3 +709,96 @@ static int menu_calculate_total_pages(int total_items, int items_per_page) {
     /* Calculate pages: ceiling division */
     return (total_items + items_per_page - 1) / items_per_page;
 }
+
+/**
+ * Number of items listed: the matching books while filtered, else all books
+ */
+static int menu_item_count(const menu_state_t *menu) {
+    return menu->filter_text[0] ? menu->filter_count : menu->book_list->count;
+}
+
+/**
+ * Book list position of an item
+ */
+static int menu_item_book(const menu_state_t *menu, int item) {
+    return menu->filter_text[0] ? menu->filter[item] : item;
+}
+
+/**
+ * Filter the items by a query and select the first match
+ * @param text: Query ("" lists all books)
+ * @param narrower: text extends the query applied, so only its matches are looked among
+ * @return: false if out of memory (the filter is unchanged)
+ */
+static bool menu_apply_filter(menu_state_t *menu, const char *text, bool narrower) {
+    book_list_t *list = menu->book_list;
+
+    if (menu->filter_capacity < list->count) {
+        int *filter = (int*)realloc(menu->filter, (size_t)list->count * sizeof(int));
+        if (!filter) {
+            fprintf(stderr, "menu_apply_filter: out of memory\n");
+            return false;
+        }
+        menu->filter = filter;
+        menu->filter_capacity = list->count;
+    }
+
+    if (text[0] == '\0') {
+        menu->filter_count = 0;
+    } else if (narrower && menu->filter_text[0]) {
+        menu->filter_count = library_filter_query(list, text, menu->filter,
+                                                  menu->filter_count, menu->filter);
+    } else {
+        menu->filter_count = library_filter_query(list, text, NULL, 0, menu->filter);
+    }
+    snprintf(menu->filter_text, sizeof(menu->filter_text), "%s", text);
+
+    menu->selected_index = 0;
+    menu->scroll_offset = 0;
+    menu->needs_redraw = true;
+    return true;
+}
+
+/**
+ * Stop typing and list all books again
+ */
+static void menu_clear_filter(menu_state_t *menu) {
+    text_input_free(menu->filter_input);
+    menu->filter_input = NULL;
+    menu->filter_text[0] = '\0';
+    menu->filter_count = 0;
+}
+
+/**
+ * Handle a button while a query is typed
+ * Each letter added or removed filters the list again. DONE keeps the
+ * matches listed to choose from; CANCEL and BACK list all books again.
+ */
+static menu_action_t menu_handle_filter_input(menu_state_t *menu, const button_event_t *event) {
+    if (event->event_type != BUTTON_EVENT_PRESS) {
+        return MENU_ACTION_NONE;
+    }
+
+    text_input_handle_button(menu->filter_input, event->button);
+
+    const char *text = text_input_get_text(menu->filter_input);
+    if (strcmp(text, menu->filter_text) != 0) {
+        size_t applied = strlen(menu->filter_text);
+        bool narrower = strlen(text) > applied && strncmp(text, menu->filter_text, applied) == 0;
+        menu_apply_filter(menu, text, narrower);
+    }
+
+    if (text_input_is_done(menu->filter_input)) {
+        if (text_input_get_result(menu->filter_input) == TEXT_INPUT_RESULT_DONE) {
+            text_input_free(menu->filter_input);
+            menu->filter_input = NULL;
+        } else {
+            menu_clear_filter(menu);
+            menu->selected_index = 0;
+            menu->scroll_offset = 0;
+        }
+    }
+
+    menu->needs_redraw = true;
+    return MENU_ACTION_REDRAW;
+}
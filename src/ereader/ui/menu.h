@@ -34,13 +34,20 @@
 #include <stdbool.h>
 #include "../rendering/framebuffer.h"
 #include "../books/book_manager.h"
+#include "../books/library_filter.h"
 #include "../../button-test/button_input.h"
+#include "text_input.h"
 
 /*
  * Menu Configuration Constants
  */
 #define MENU_TITLE              "E-Reader Library"
 #define MENU_CONTROL_HINTS      "UP/DOWN:Select  ENTER:Open"
+#define MENU_FILTER_TITLE       "Find"
+#define MENU_FILTER_HINTS       "UP/DOWN:Letter ENTER:Add MENU:Del"
+#define MENU_FILTERED_HINTS     "UP/DOWN:Select  ENTER:Open  BACK:All"
+#define MENU_FILTER_EMPTY       "No matching books."
+#define MENU_HOLD_MS            600     /* MENU held this long starts a query */
 #define MENU_EMPTY_MESSAGE      "No books found."
 #define MENU_EMPTY_HINT         "Copy books (.txt/.epub/.pdf) to /books/"
 
@@ -73,22 +80,34 @@ typedef enum {
     MENU_ACTION_NONE,           /* No action taken */
     MENU_ACTION_REDRAW,         /* Menu needs to be redrawn */
     MENU_ACTION_SELECT_BOOK,    /* User selected a book to open */
+    MENU_ACTION_OPEN_SETTINGS,  /* User pressed MENU briefly */
     MENU_ACTION_EXIT            /* User wants to exit menu */
 } menu_action_t;
 
 /*
  * Menu State Structure
  *
- * Maintains current menu state including book list, selection, and scroll position
+ * Maintains current menu state including book list, selection, and scroll position.
+ * While a filter is applied the items are the matching books only, and
+ * selected_index and scroll_offset count those.
  */
 typedef struct {
     book_list_t *book_list;         /* Pointer to book list (not owned by menu) */
     bookmark_list_t *bookmarks;     /* Pointer to bookmarks (not owned by menu) */
 
-    int selected_index;             /* Currently highlighted book (0-based, global index) */
+    int selected_index;             /* Currently highlighted item (0-based) */
     int scroll_offset;              /* First visible item index (0-based) */
     int visible_items;              /* Number of items that fit on screen (14) */
 
+    /* Find as you type (hold MENU) */
+    text_input_state_t *filter_input;   /* Query being typed, NULL when not typing */
+    char filter_text[LIBRARY_FILTER_QUERY_MAX]; /* Query the items match ("" = all books) */
+    int *filter;                    /* List positions of the matching books */
+    int filter_count;               /* Number of matching books */
+    int filter_capacity;            /* Positions filter has room for */
+    bool menu_held;                 /* MENU pressed in the menu and not yet released */
+    struct timeval menu_pressed;    /* When it was pressed */
+
     bool needs_redraw;              /* Flag indicating full redraw is needed */
     int refresh_counter;            /* Counter for forcing full refresh (prevent ghosting) */
 } menu_state_t;
@@ -120,6 +139,16 @@ void menu_free(menu_state_t *menu);
  */
 void menu_reset(menu_state_t *menu);
 
+/**
+ * Follow changes to the book list while the menu is shown
+ * Applies the filter again, keeps the selection on the same book if it is
+ * still listed, otherwise on the same position, and keeps it on screen.
+ *
+ * @param menu: Menu state
+ * @param selected_filename: Filename of the book selected before the change ("" if none)
+ */
+void menu_books_changed(menu_state_t *menu, const char *selected_filename);
+
 /*
  * Menu Rendering
  */
@@ -155,11 +184,13 @@ int menu_render_items(menu_state_t *menu, framebuffer_t *fb);
 
 /**
  * Render control hints at bottom of screen
+ * While a query is typed, shows the letter UP/DOWN has reached.
  *
+ * @param menu: Menu state
  * @param fb: Framebuffer to render to
  * @return: 0 on success, negative error code on failure
  */
-int menu_render_hints(framebuffer_t *fb);
+int menu_render_hints(menu_state_t *menu, framebuffer_t *fb);
 
 /**
  * Render empty state message (when no books found)
@@ -175,6 +206,8 @@ int menu_render_empty(framebuffer_t *fb);
 
 /**
  * Handle button event and update menu state
+ * Holding MENU for MENU_HOLD_MS starts typing a query that narrows the
+ * list as it grows; a shorter press asks for the settings.
  *
  * @param menu: Menu state
  * @param event: Button event to handle
@@ -218,15 +251,16 @@ bool menu_page_down(menu_state_t *menu);
  * Get currently selected book
  *
  * @param menu: Menu state
- * @return: Pointer to selected book metadata, or NULL if none selected
+ * @param out: Filled with a copy of the selected book's metadata
+ * @return: true if a book is selected, false otherwise
  */
-book_metadata_t* menu_get_selected_book(menu_state_t *menu);
+bool menu_get_selected_book(menu_state_t *menu, book_metadata_t *out);
 
 /**
  * Get index of currently selected book
  *
  * @param menu: Menu state
- * @return: Selected index (0-based), or -1 if no selection
+ * @return: Selected book's position in the book list (0-based), or -1 if no selection
  */
 int menu_get_selected_index(menu_state_t *menu);
 
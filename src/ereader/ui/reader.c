@@ -35,13 +35,21 @@
 
 /* Internal helper function prototypes */
 static void reader_draw_separator_line(framebuffer_t *fb, int line_number);
+static int reader_extend_layout(reader_state_t *reader, int max_pages);
+static int reader_extend_back(reader_state_t *reader, int max_pages);
+static int reader_fetch_chunk(void *source, size_t offset, text_chunk_t *chunk);
+static int reader_fetch_text(void *source, size_t offset, text_chunk_t *chunk);
+static int reader_book_page(reader_state_t *reader);
+static long reader_page_offset(reader_state_t *reader);
+static bool reader_use_page_table(reader_state_t *reader);
 
 /*
  * Reader Initialization and Cleanup
  */
 
-reader_state_t* reader_create(book_t *book, book_metadata_t *metadata, bookmark_list_t *bookmarks, int initial_page) {
-    if (!book || !book->text) {
+reader_state_t* reader_create(book_t *book, const book_metadata_t *metadata, bookmark_list_t *bookmarks,
+                              int initial_page, const settings_t *settings) {
+    if (!book || !metadata || (!book->text && !book->handle)) {
         return NULL;
     }
 
@@ -51,34 +59,63 @@ reader_state_t* reader_create(book_t *book, book_metadata_t *metadata, bookmark_
     }
 
     reader->book = book;
-    reader->metadata = metadata;
+    reader->metadata = *metadata;
     reader->bookmarks = bookmarks;
     reader->needs_redraw = true;
     reader->refresh_counter = 0;
 
-    /* Create pagination for the book */
-    reader->pagination = text_create_pagination(book->text, book->text_length);
+    /* A bookmark's text offset survives font changes; its page number may not */
+    long bookmark_offset = -1;
+    if (initial_page == -1 && bookmarks) {
+        bookmark_offset = bookmark_get_offset(bookmarks, metadata->filename);
+        if (bookmark_offset >= (long)book->text_length) {
+            bookmark_offset = -1;
+        }
+    }
+
+    /* Create pagination for the book. Only the page at the bookmark is laid
+     * out, so opening costs one chunk (an EPUB chapter) rather than the whole
+     * book; a TXT book is a single chunk that is already in memory */
+    reader_layout_params(&reader->layout, settings);
+    size_t anchor = bookmark_offset >= 0 ? (size_t)bookmark_offset : 0;
+    reader->pagination = text_create_pagination_chunked(book->handle ? reader_fetch_chunk
+                                                                     : reader_fetch_text,
+                                                        book, book->text_length,
+                                                        &reader->layout, anchor);
     if (!reader->pagination) {
         free(reader);
         return NULL;
     }
 
+    /* Precompiled books may carry the whole layout for this geometry */
+    bool laid_out = reader_use_page_table(reader);
+
     reader->total_pages = reader->pagination->page_count;
 
     /* Determine initial page */
+    if (bookmark_offset >= 0 && !laid_out) {
+        /* The anchor page is the only page laid out */
+        reader->current_page = 0;
+        return reader;
+    }
+    if (bookmark_offset >= 0) {
+        int page = text_pagination_find_page(reader->pagination, (int)bookmark_offset);
+        reader->current_page = page >= 0 ? page : 0;
+        return reader;
+    }
     if (initial_page == -1) {
-        /* Use bookmark if available */
-        if (bookmarks) {
-            int bookmark_page = bookmark_get(bookmarks, book->filename);
-            if (bookmark_page >= 0 && bookmark_page < reader->total_pages) {
-                reader->current_page = bookmark_page;
-            } else {
-                reader->current_page = 0;
-            }
-        } else {
-            reader->current_page = 0;
+        /* Use bookmark page if available */
+        initial_page = bookmarks ? bookmark_get(bookmarks, metadata->filename) : -1;
+    }
+
+    /* Pages laid out from the start reach a page-number bookmark */
+    while (initial_page >= reader->total_pages && !reader->pagination->tail_complete) {
+        if (reader_extend_layout(reader, initial_page + 1 - reader->total_pages) <= 0) {
+            break;
         }
-    } else if (initial_page >= 0 && initial_page < reader->total_pages) {
+    }
+
+    if (initial_page >= 0 && initial_page < reader->total_pages) {
         reader->current_page = initial_page;
     } else {
         reader->current_page = 0;
@@ -153,7 +190,7 @@ int reader_render(reader_state_t *reader, framebuffer_t *fb) {
 }
 
 int reader_render_status_bar(reader_state_t *reader, framebuffer_t *fb) {
-    if (!reader || !fb || !reader->book || !reader->metadata) {
+    if (!reader || !fb || !reader->book) {
         return READER_ERROR_NULL_POINTER;
     }
 
@@ -164,15 +201,17 @@ int reader_render_status_bar(reader_state_t *reader, framebuffer_t *fb) {
     char format_indicator;
 
     /* Get format indicator character */
-    format_indicator = format_get_type_indicator(reader->metadata->format);
+    format_indicator = format_get_type_indicator(reader->metadata.format);
 
     /* Format page indicator [current/total] - 1-based for user display */
-    reader_format_page_indicator(reader->current_page + 1, reader->total_pages,
+    reader->shown_page = reader_book_page(reader) + 1;
+    reader->shown_total = text_pagination_estimate_total(reader->pagination);
+    reader_format_page_indicator(reader->shown_page, reader->shown_total,
                                   page_indicator, sizeof(page_indicator));
 
     /* Use book title from metadata (or filename if title is empty) */
-    const char *display_title = (reader->metadata->title[0] != '\0') 
-                                 ? reader->metadata->title 
+    const char *display_title = (reader->metadata.title[0] != '\0') 
+                                 ? reader->metadata.title 
                                  : reader->book->filename;
 
     /* Create title with format indicator: [F] Title */
@@ -218,14 +257,16 @@ int reader_render_page(reader_state_t *reader, framebuffer_t *fb) {
         return READER_ERROR_PAGINATION_FAILED;
     }
 
-    /* Render page text starting at line 2 */
-    int x = MARGIN_LEFT;
-    int y = MARGIN_TOP + (READER_FIRST_TEXT_LINE * LINE_HEIGHT);
+    /* Render page text below the status bar (the layout reserves its rows) */
+    const layout_params_t *layout = &reader->layout;
+    int x = layout->margin_left;
+    int y = layout->margin_top;
 
     /* Render each line of the page */
-    for (int i = 0; i < page->line_count && i < READER_TEXT_LINES; i++) {
+    for (int i = 0; i < page->line_count; i++) {
         if (page->lines[i]) {
-            text_render_string(fb, x, y + (i * LINE_HEIGHT), page->lines[i], COLOR_BLACK);
+            text_render_line(fb, layout, x, y + (i * layout->line_height),
+                             page->lines[i], COLOR_BLACK);
         }
     }
 
@@ -311,6 +352,12 @@ bool reader_next_page(reader_state_t *reader) {
         return false;
     }
 
+    /* Lay out the next page first if the layout stops here */
+    if (reader->current_page >= reader->total_pages - 1 &&
+        !reader->pagination->tail_complete) {
+        reader_extend_layout(reader, 1);
+    }
+
     /* Check if already at last page */
     if (reader->current_page >= reader->total_pages - 1) {
         return false;
@@ -321,7 +368,8 @@ bool reader_next_page(reader_state_t *reader) {
 
     /* Auto-save bookmark on page change */
     if (reader->bookmarks && reader->book) {
-        bookmark_update(reader->bookmarks, reader->book->filename, reader->current_page);
+        bookmark_update(reader->bookmarks, reader->metadata.filename, reader_book_page(reader),
+                        reader_page_offset(reader));
         bookmark_list_save(reader->bookmarks, BOOKMARKS_FILE);
     }
 
@@ -333,6 +381,11 @@ bool reader_prev_page(reader_state_t *reader) {
         return false;
     }
 
+    /* Lay out the previous page first if the layout starts here */
+    while (reader->current_page <= 0 && !reader->pagination->head_complete) {
+        if (reader_extend_back(reader, 1) <= 0) break;
+    }
+
     /* Check if already at first page */
     if (reader->current_page <= 0) {
         return false;
@@ -343,7 +396,8 @@ bool reader_prev_page(reader_state_t *reader) {
 
     /* Auto-save bookmark on page change */
     if (reader->bookmarks && reader->book) {
-        bookmark_update(reader->bookmarks, reader->book->filename, reader->current_page);
+        bookmark_update(reader->bookmarks, reader->metadata.filename, reader_book_page(reader),
+                        reader_page_offset(reader));
         bookmark_list_save(reader->bookmarks, BOOKMARKS_FILE);
     }
 
@@ -370,13 +424,33 @@ bool reader_goto_page(reader_state_t *reader, int page) {
 
     /* Auto-save bookmark on page change */
     if (reader->bookmarks && reader->book) {
-        bookmark_update(reader->bookmarks, reader->book->filename, reader->current_page);
+        bookmark_update(reader->bookmarks, reader->metadata.filename, reader_book_page(reader),
+                        reader_page_offset(reader));
         bookmark_list_save(reader->bookmarks, BOOKMARKS_FILE);
     }
 
     return true;
 }
 
+bool reader_goto_offset(reader_state_t *reader, int offset) {
+    if (!reader || offset < 0 || (size_t)offset >= reader->pagination->source_length) {
+        return false;
+    }
+
+    /* Lay out towards the offset until a page holds it */
+    int page;
+    while ((page = text_pagination_find_page(reader->pagination, offset)) < 0) {
+        int added = offset < reader->pagination->pages[0].start_offset
+            ? reader_extend_back(reader, READER_IDLE_LAYOUT_PAGES)
+            : reader_extend_layout(reader, READER_IDLE_LAYOUT_PAGES);
+        if (added <= 0) {
+            return false;
+        }
+    }
+
+    return reader_goto_page(reader, page);
+}
+
 int reader_get_current_page(reader_state_t *reader) {
     if (!reader) {
         return -1;
@@ -391,13 +465,39 @@ int reader_get_total_pages(reader_state_t *reader) {
     return reader->total_pages;
 }
 
+bool reader_idle(reader_state_t *reader) {
+    if (!reader || !reader->pagination) {
+        return false;
+    }
+    if (text_pagination_is_complete(reader->pagination)) {
+        return false;
+    }
+
+    /* Have the page before the current one ready first (at the start of an
+     * EPUB chapter, this extracts the previous chapter), then go forwards */
+    if (reader->current_page == 0 && !reader->pagination->head_complete) {
+        reader_extend_back(reader, 1);
+    } else {
+        reader_extend_layout(reader, READER_IDLE_LAYOUT_PAGES);
+    }
+
+    /* The estimated page numbers shift with every pass, and each redraw is a
+     * full e-paper refresh: only redraw once, for the exact numbers */
+    if (!text_pagination_is_complete(reader->pagination)) {
+        return false;
+    }
+    return reader_book_page(reader) + 1 != reader->shown_page ||
+           text_pagination_estimate_total(reader->pagination) != reader->shown_total;
+}
+
 int reader_save_bookmark(reader_state_t *reader) {
     if (!reader || !reader->book || !reader->bookmarks) {
         return READER_ERROR_NULL_POINTER;
     }
 
     /* Save current page as bookmark */
-    int result = bookmark_update(reader->bookmarks, reader->book->filename, reader->current_page);
+    int result = bookmark_update(reader->bookmarks, reader->metadata.filename,
+                                 reader_book_page(reader), reader_page_offset(reader));
     if (result != BOOK_SUCCESS) {
         return READER_ERROR_INVALID_STATE;
     }
@@ -432,14 +532,15 @@ bool reader_is_first_page(reader_state_t *reader) {
     if (!reader) {
         return false;
     }
-    return reader->current_page == 0;
+    return reader->current_page == 0 && reader->pagination->head_complete;
 }
 
 bool reader_is_last_page(reader_state_t *reader) {
     if (!reader) {
         return false;
     }
-    return reader->current_page >= reader->total_pages - 1;
+    return reader->current_page >= reader->total_pages - 1 &&
+           reader->pagination->tail_complete;
 }
 
 bool reader_is_empty(reader_state_t *reader) {
@@ -526,3 +627,112 @@ static void reader_draw_separator_line(framebuffer_t *fb, int line_number) {
     int y = MARGIN_TOP + (line_number * LINE_HEIGHT) + (LINE_HEIGHT / 2);
     fb_draw_hline(fb, MARGIN_LEFT, y, FB_WIDTH - MARGIN_LEFT - MARGIN_RIGHT, COLOR_BLACK);
 }
+
+/*
+ * Lay out more pages and keep current_page pointing at the same page
+ */
+static int reader_extend_layout(reader_state_t *reader, int max_pages) {
+    int prepended = 0;
+    int added = text_pagination_extend(reader->pagination, max_pages, &prepended);
+    if (added < 0) {
+        fprintf(stderr, "reader_extend_layout: Failed to lay out more pages\n");
+        return READER_ERROR_PAGINATION_FAILED;
+    }
+
+    reader->current_page += prepended;
+    reader->total_pages = reader->pagination->page_count;
+
+    return added;
+}
+
+/*
+ * Lay out pages before the first one only and keep current_page pointing
+ * at the same page
+ */
+static int reader_extend_back(reader_state_t *reader, int max_pages) {
+    int prepended = text_pagination_prepend(reader->pagination, max_pages);
+    if (prepended < 0) {
+        fprintf(stderr, "reader_extend_back: Failed to lay out more pages\n");
+        return READER_ERROR_PAGINATION_FAILED;
+    }
+
+    reader->current_page += prepended;
+    reader->total_pages = reader->pagination->page_count;
+
+    return prepended;
+}
+
+/*
+ * Replace the layout with the book's own page table for the current
+ * geometry, if it carries one (precompiled .erb books)
+ * @return: true if the whole layout was loaded
+ */
+static bool reader_use_page_table(reader_state_t *reader) {
+    book_t *book = reader->book;
+    const uint32_t *table;
+    int page_count;
+
+    if (!book->handle ||
+        format_get_page_table(book->format, book->handle, text_layout_key(&reader->layout),
+                              &table, &page_count) != FORMAT_SUCCESS) {
+        return false;
+    }
+    if (text_pagination_set_pages(reader->pagination, table, page_count) != 0) {
+        fprintf(stderr, "reader_use_page_table: Ignoring inconsistent page table\n");
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Chunk source for books read through their format (book_t.handle)
+ */
+static int reader_fetch_chunk(void *source, size_t offset, text_chunk_t *chunk) {
+    book_t *book = (book_t*)source;
+    format_chunk_t format_chunk;
+
+    if (format_chunk_at(book->format, book->handle, offset, &format_chunk) != FORMAT_SUCCESS) {
+        return -1;
+    }
+
+    chunk->text = format_chunk.text;
+    chunk->offset = format_chunk.offset;
+    chunk->length = format_chunk.length;
+    return 0;
+}
+
+/*
+ * Chunk source for books held in memory as one string (book_t.text)
+ */
+static int reader_fetch_text(void *source, size_t offset, text_chunk_t *chunk) {
+    book_t *book = (book_t*)source;
+
+    if (offset >= book->text_length) {
+        return -1;
+    }
+
+    chunk->text = book->text;
+    chunk->offset = 0;
+    chunk->length = book->text_length;
+    return 0;
+}
+
+/*
+ * Text offset of the first character on the current page (for bookmarks)
+ */
+static long reader_page_offset(reader_state_t *reader) {
+    pagination_t *pg = reader->pagination;
+    if (reader->current_page < 0 || reader->current_page >= pg->page_count ||
+        pg->pages[reader->current_page].line_count == 0) {
+        return -1;
+    }
+    return (long)pg->pages[reader->current_page].start_offset;
+}
+
+/*
+ * Page number of the current page within the whole book (for display and
+ * bookmarks); estimated while the layout is still incomplete
+ */
+static int reader_book_page(reader_state_t *reader) {
+    return text_pagination_estimate_index(reader->pagination, reader->current_page);
+}
@@ -36,6 +36,8 @@
 #include "../rendering/text_renderer.h"
 #include "../books/book_manager.h"
 #include "../formats/format_interface.h"
+#include "../settings/settings_manager.h"
+#include "reader_layout.h"
 #include "../../button-test/button_input.h"
 
 /*
@@ -43,15 +45,7 @@
  */
 #define READER_CONTROL_HINTS    "UP:Prev  DOWN:Next  BACK:Exit"
 
-/* Layout Constants (based on 400x300 display, 8x16 font) */
-#define READER_STATUS_BAR_LINE   0       /* Line 0: Status bar with title and page */
-#define READER_SEPARATOR_LINE    1       /* Line 1: Separator */
-#define READER_FIRST_TEXT_LINE   2       /* Line 2: First line of text */
-#define READER_LAST_TEXT_LINE    15      /* Line 15: Last line of text */
-#define READER_SEPARATOR_2_LINE  16      /* Line 16: Separator */
-#define READER_HINTS_LINE        17      /* Line 17: Control hints */
-
-#define READER_TEXT_LINES        14      /* Number of text lines (lines 2-15) */
+#define READER_IDLE_LAYOUT_PAGES 16      /* Pages laid out per idle tick after opening */
 
 /* Error codes */
 typedef enum {
@@ -80,11 +74,14 @@ typedef enum {
 typedef struct {
     book_t *book;                   /* Currently loaded book (not owned by reader) */
     pagination_t *pagination;       /* Pagination context for current book (owned) */
+    layout_params_t layout;         /* Page geometry from settings, minus status bar and hints */
     bookmark_list_t *bookmarks;     /* Pointer to bookmarks (not owned by reader) */
-    book_metadata_t *metadata;      /* Book metadata (not owned by reader) */
+    book_metadata_t metadata;       /* Copy of the book's library entry */
 
     int current_page;               /* Current page number (0-based) */
     int total_pages;                /* Total number of pages in book */
+    int shown_page;                 /* Page number in the status bar last drawn (1-based) */
+    int shown_total;                /* Page total in the status bar last drawn */
 
     bool needs_redraw;              /* Flag indicating full redraw is needed */
     int refresh_counter;            /* Counter for forcing full refresh (prevent ghosting) */
@@ -98,11 +95,14 @@ typedef struct {
  * Create and initialize a new reader state
  *
  * @param book: Pointer to loaded book (must remain valid during reader lifetime)
+ * @param metadata: Library entry of the book (copied); its filename keys the bookmark
  * @param bookmarks: Pointer to bookmarks (must remain valid during reader lifetime)
  * @param initial_page: Page to start reading at (0-based, -1 = use bookmark)
+ * @param settings: Font size, line spacing and margins to lay out with (NULL = defaults)
  * @return: Pointer to reader state, or NULL on error
  */
-reader_state_t* reader_create(book_t *book, book_metadata_t *metadata, bookmark_list_t *bookmarks, int initial_page);
+reader_state_t* reader_create(book_t *book, const book_metadata_t *metadata, bookmark_list_t *bookmarks,
+                              int initial_page, const settings_t *settings);
 
 /**
  * Free reader state and associated resources
@@ -205,6 +205,15 @@ bool reader_prev_page(reader_state_t *reader);
  */
 bool reader_goto_page(reader_state_t *reader, int page);
 
+/**
+ * Go to the page holding a text offset, laying it out first if needed
+ *
+ * @param reader: Reader state
+ * @param offset: Byte offset in the book text (e.g. a search result)
+ * @return: true if page changed, false if invalid offset or already there
+ */
+bool reader_goto_offset(reader_state_t *reader, int offset);
+
 /**
  * Get current page number
  *
@@ -221,6 +230,15 @@ int reader_get_current_page(reader_state_t *reader);
  */
 int reader_get_total_pages(reader_state_t *reader);
 
+/**
+ * Continue background layout while waiting for input
+ *
+ * @param reader: Reader state
+ * @return: true if the layout just completed and the status bar's page
+ *          numbers changed (screen should be redrawn)
+ */
+bool reader_idle(reader_state_t *reader);
+
 /**
  * Save current reading position as bookmark
  *
@@ -0,0 +1,60 @@
+/*
+ * reader_layout.h - E-Reader Reading View Geometry
+ *
+ * Screen lines used by the reading view and the text layout derived from
+ * them. Kept apart from reader.h so that host tools (tools/erbconv) lay
+ * out books with exactly the geometry the reader uses.
+ *
+ * Copyright (C) 2024-2026 Open Source E-Reader Project Contributors
+ *
+ * This file is part of the Open Source E-Reader project.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: E-Reader Project
+ */
+
+#ifndef READER_LAYOUT_H
+#define READER_LAYOUT_H
+
+#include "../rendering/text_renderer.h"
+#include "../settings/settings_manager.h"
+
+/* Layout Constants (based on 400x300 display, 8x16 font) */
+#define READER_STATUS_BAR_LINE   0       /* Line 0: Status bar with title and page */
+#define READER_SEPARATOR_LINE    1       /* Line 1: Separator */
+#define READER_FIRST_TEXT_LINE   2       /* Line 2: First line of text */
+#define READER_LAST_TEXT_LINE    15      /* Line 15: Last line of text */
+#define READER_SEPARATOR_2_LINE  16      /* Line 16: Separator */
+#define READER_HINTS_LINE        17      /* Line 17: Control hints */
+
+#define READER_TEXT_LINES        14      /* Number of text lines (lines 2-15) */
+
+/**
+ * Get the layout of the book text in the reading view
+ * The user's margins are widened to keep the text clear of the status bar
+ * above and the control hints below, which use the UI font.
+ * @param layout: Output layout parameters
+ * @param settings: User settings (NULL for defaults)
+ */
+static inline void reader_layout_params(layout_params_t *layout, const settings_t *settings) {
+    const layout_params_t *ui = text_renderer_get_params();
+
+    text_layout_params_from_settings(layout, settings);
+    layout->margin_top += READER_FIRST_TEXT_LINE * ui->line_height;
+    layout->margin_bottom += (READER_HINTS_LINE - READER_LAST_TEXT_LINE) * ui->line_height;
+    text_layout_params_update(layout);
+}
+
+#endif /* READER_LAYOUT_H */
@@ -40,10 +40,9 @@ static void search_ui_render_hints(framebuffer_t *fb, const char *hints);
  * Search UI Initialization and Cleanup
  */
 
-search_ui_state_t* search_ui_create(const char *text, size_t text_length,
-                                    pagination_t *pagination,
+search_ui_state_t* search_ui_create(pagination_t *pagination,
                                     const char **predefined_terms, int term_count) {
-    if (!text || !pagination || term_count < 0 || term_count > SEARCH_UI_MAX_PREDEFINED_TERMS) {
+    if (!pagination || term_count < 0 || term_count > SEARCH_UI_MAX_PREDEFINED_TERMS) {
         return NULL;
     }
 
@@ -53,7 +52,7 @@ search_ui_state_t* search_ui_create(const char *text, size_t text_length,
     }
 
     /* Create search engine context */
-    ui->search_ctx = search_create(text, text_length, pagination);
+    ui->search_ctx = search_create(pagination);
     if (!ui->search_ctx) {
         free(ui);
         return NULL;
@@ -222,32 +221,41 @@ int search_ui_render_results(search_ui_state_t *ui, framebuffer_t *fb) {
     /* Get current result */
     search_result_t *result = search_get_current_result(ctx);
     if (result) {
-        /* Show page number */
+        /* Show page number (estimated if its page is not laid out yet) */
         char page_info[64];
-        snprintf(page_info, sizeof(page_info), "Page: %d", result->page_number + 1);
+        snprintf(page_info, sizeof(page_info), "Page: %d",
+                 text_pagination_estimate_page(ctx->pagination, result->offset) + 1);
         text_render_string(fb, 10, y, page_info, COLOR_BLACK);
         y += 24;
 
-        /* Show context around the match */
-        const char *text = ctx->source_text;
-        int offset = result->offset;
-        int term_len = strlen(search_get_term(ctx));
-
-        /* Calculate context window */
-        int context_before = 30;
-        int context_after = 30;
-        int start = (offset - context_before < 0) ? 0 : offset - context_before;
-        int end = offset + term_len + context_after;
-        if (end > (int)ctx->source_length) {
-            end = ctx->source_length;
+        /* Show context around the match (matches never span chunks) */
+        text_chunk_t chunk;
+        int ctx_len = 0;
+        char context[256];
+
+        if (text_pagination_chunk_at(ctx->pagination, (size_t)result->offset, &chunk) == 0 &&
+            chunk.text) {
+            int offset = result->offset - (int)chunk.offset;
+            int term_len = strlen(search_get_term(ctx));
+
+            /* Calculate context window */
+            int context_before = 30;
+            int context_after = 30;
+            int start = (offset - context_before < 0) ? 0 : offset - context_before;
+            int end = offset + term_len + context_after;
+            if (end > (int)chunk.length) {
+                end = chunk.length;
+            }
+
+            /* Extract context */
+            ctx_len = end - start;
+            if (ctx_len > 0 && ctx_len < (int)sizeof(context) - 1) {
+                memcpy(context, chunk.text + start, ctx_len);
+                context[ctx_len] = '\0';
+            }
         }
 
-        /* Extract context */
-        char context[256];
-        int ctx_len = end - start;
         if (ctx_len > 0 && ctx_len < (int)sizeof(context) - 1) {
-            strncpy(context, text + start, ctx_len);
-            context[ctx_len] = '\0';
 
             /* Replace newlines with spaces for display */
             for (int i = 0; i < ctx_len; i++) {
@@ -455,9 +463,23 @@ int search_ui_get_target_page(search_ui_state_t *ui) {
         return -1;
     }
 
+    /* Map now: laying out more pages since the search shifts page indices */
+    search_result_t *result = search_get_current_result(ui->search_ctx);
+    if (result) {
+        return search_find_page_for_offset(ui->search_ctx->pagination, result->offset);
+    }
+
+    return -1;
+}
+
+int search_ui_get_target_offset(search_ui_state_t *ui) {
+    if (!ui || !ui->search_ctx) {
+        return -1;
+    }
+
     search_result_t *result = search_get_current_result(ui->search_ctx);
     if (result) {
-        return result->page_number;
+        return result->offset;
     }
 
     return -1;
@@ -86,15 +86,12 @@ typedef enum {
 /**
  * Create a new search UI state
  *
- * @param text: Text to search (must remain valid during search UI lifetime)
- * @param text_length: Length of text
- * @param pagination: Pagination context (must remain valid)
+ * @param pagination: Pagination context supplying the text (must remain valid)
  * @param predefined_terms: Array of predefined search terms (copied internally)
  * @param term_count: Number of predefined terms
  * @return: Pointer to search UI state, or NULL on error
  */
-search_ui_state_t* search_ui_create(const char *text, size_t text_length,
-                                    pagination_t *pagination,
+search_ui_state_t* search_ui_create(pagination_t *pagination,
                                     const char **predefined_terms, int term_count);
 
 /**
@@ -174,10 +171,22 @@ search_ui_action_t search_ui_handle_event(search_ui_state_t *ui, const button_ev
  * Get the page number to navigate to (if action is NAVIGATE)
  *
  * @param ui: Search UI state
- * @return: Page number (0-based), or -1 if not applicable
+ * @return: Page number (0-based), or -1 if not applicable or the page is not
+ *          laid out yet (see search_ui_get_target_offset())
  */
 int search_ui_get_target_page(search_ui_state_t *ui);
 
+/**
+ * Get the text offset to navigate to (if action is NAVIGATE)
+ *
+ * Pass it to reader_goto_offset(), which lays out the result's page first
+ * if needed.
+ *
+ * @param ui: Search UI state
+ * @return: Byte offset of the match in the book text, or -1 if not applicable
+ */
+int search_ui_get_target_offset(search_ui_state_t *ui);
+
 /**
  * Check if UI needs redraw
  *
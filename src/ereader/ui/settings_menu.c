@@ -363,6 +363,26 @@ bool settings_menu_cycle_value(settings_menu_state_t *menu) {
             return true;
         }
 
+        case SETTING_ITEM_LIBRARY_SORT: {
+            library_sort_t current = settings_get_library_sort(menu->settings);
+            library_sort_t next;
+
+            if (current == LIBRARY_SORT_TITLE) {
+                next = LIBRARY_SORT_AUTHOR;
+            } else if (current == LIBRARY_SORT_AUTHOR) {
+                next = LIBRARY_SORT_ADDED;
+            } else if (current == LIBRARY_SORT_ADDED) {
+                next = LIBRARY_SORT_LAST_READ;
+            } else if (current == LIBRARY_SORT_LAST_READ) {
+                next = LIBRARY_SORT_FORMAT;
+            } else {
+                next = LIBRARY_SORT_TITLE;
+            }
+
+            settings_set_library_sort(menu->settings, next);
+            return true;
+        }
+
         case SETTING_ITEM_WIFI:
             /* WiFi is handled specially - doesn't cycle, opens WiFi menu */
             /* This will be caught by the caller to transition to WiFi state */
@@ -444,6 +464,8 @@ const char* settings_menu_get_setting_name(setting_item_t item) {
             return "Display Mode";
         case SETTING_ITEM_AUTO_SLEEP:
             return "Auto Sleep";
+        case SETTING_ITEM_LIBRARY_SORT:
+            return "Library Sort";
         case SETTING_ITEM_WIFI:
             return "WiFi Settings";
         case SETTING_ITEM_ONLINE_LIBRARY:
@@ -480,6 +502,9 @@ void settings_menu_get_value_string(settings_menu_state_t *menu, setting_item_t
         case SETTING_ITEM_AUTO_SLEEP:
             value_str = settings_auto_sleep_to_string(settings_get_auto_sleep(menu->settings));
             break;
+        case SETTING_ITEM_LIBRARY_SORT:
+            value_str = settings_library_sort_to_string(settings_get_library_sort(menu->settings));
+            break;
         case SETTING_ITEM_WIFI:
             value_str = "Configure >";
             break;
@@ -62,6 +62,7 @@ typedef enum {
     SETTING_ITEM_MARGINS,
     SETTING_ITEM_DISPLAY_MODE,
     SETTING_ITEM_AUTO_SLEEP,
+    SETTING_ITEM_LIBRARY_SORT,  /* Order of the library list */
     SETTING_ITEM_WIFI,          /* WiFi settings */
     SETTING_ITEM_ONLINE_LIBRARY, /* Online library browser */
     SETTING_ITEM_COUNT          /* Total number of settings */
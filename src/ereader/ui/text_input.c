@@ -55,18 +55,18 @@ static const char TEXT_INPUT_CHARSET[] = {
     /* Digits (52-61) */
     '0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
 
-    /* Common symbols (62-89) */
+    /* Common symbols (62-93) */
     '!', '@', '#', '$', '%', '^', '&', '*', '(', ')', '-', '_', '=', '+',
     '[', ']', '{', '}', '\\', '|', ';', ':', '\'', '"', '<', '>', ',', '.',
     '/', '?', '~', '`',
 
-    /* Space (90) */
+    /* Space (94) */
     ' ',
 
-    /* Special control characters (91-93) - represented as special values */
-    '\x08',  /* BACKSPACE (91) */
-    '\x0D',  /* DONE (92) - using carriage return as marker */
-    '\x1B'   /* CANCEL (93) - using escape as marker */
+    /* Special control characters (95-97) - represented as special values */
+    '\x08',  /* BACKSPACE (95) */
+    '\x0D',  /* DONE (96) - using carriage return as marker */
+    '\x1B'   /* CANCEL (97) - using escape as marker */
 };
 
 /* Display names for special characters */
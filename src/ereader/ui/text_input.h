@@ -52,15 +52,15 @@
 #define TEXT_INPUT_MIN_LENGTH   0       /* Minimum text length (0 for optional) */
 
 /* Character set for sequential navigation */
-#define TEXT_INPUT_CHARSET_SIZE 93      /* Total number of selectable characters */
+#define TEXT_INPUT_CHARSET_SIZE 98      /* Total number of selectable characters */
 
 /*
  * Special character indices in the character set
  */
 typedef enum {
-    TEXT_INPUT_CHAR_BACKSPACE = 90,     /* Index of backspace in charset */
-    TEXT_INPUT_CHAR_DONE = 91,          /* Index of done in charset */
-    TEXT_INPUT_CHAR_CANCEL = 92         /* Index of cancel in charset */
+    TEXT_INPUT_CHAR_BACKSPACE = 95,     /* Index of backspace in charset */
+    TEXT_INPUT_CHAR_DONE = 96,          /* Index of done in charset */
+    TEXT_INPUT_CHAR_CANCEL = 97         /* Index of cancel in charset */
 } text_input_special_char_t;
 
 /*
@@ -91,7 +91,7 @@ typedef struct {
     int min_length;                     /* Minimum required length */
 
     /* Character selection */
-    int current_char_index;             /* Current character in charset (0-92) */
+    int current_char_index;             /* Current character in charset (0-97) */
     char current_char;                  /* Currently selected character */
 
     /* Display configuration */
@@ -229,7 +229,7 @@ void text_input_update_animation(text_input_state_t *input);
 /**
  * Get character at index in character set
  *
- * @param index: Character index (0-92)
+ * @param index: Character index (0-97)
  * @return: Character at that index
  */
 char text_input_get_char_at_index(int index);